@@ -14,6 +14,17 @@ local magical_reg_objs = {
 	"Node",
 }
 
+-- fixed-size value types, allocated from LuaValuePool instead of the heap
+local magical_value_types = {
+	"AxisAngle",
+	"EulerAngles",
+	"Matrix4",
+	"Quaternion",
+	"Vector2",
+	"Vector3",
+	"Vector4",
+}
+
 local magical_enum_class = {
 	{ "Space", "Self" },
 	{ "Space", "Parent" },
@@ -114,6 +125,35 @@ function post_output_hook(package)
 		);
 	end
 
+	size = table.getn(magical_value_types);
+	for i=1,size do
+		replace(
+			[[Mtolua_new((]] .. magical_value_types[i] .. [[)]],
+			[[Mtolua_pool_new((]] .. magical_value_types[i] .. [[)]] );
+
+		-- __gc collector
+		replace(
+		magical_value_types[i] .. [[* self = (]] .. magical_value_types[i] .. [[*) tolua_tousertype(tolua_S,1,0);
+	Mtolua_delete(self);]],
+		magical_value_types[i] .. [[* self = (]] .. magical_value_types[i] .. [[*) tolua_tousertype(tolua_S,1,0);
+	Mtolua_pool_delete(self);]]
+		);
+
+		-- obj:delete()
+		replace(
+		magical_value_types[i] .. [[* self = (]] .. magical_value_types[i] .. [[*)  tolua_tousertype(tolua_S,1,0);
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'delete'", NULL);
+#endif
+  Mtolua_delete(self);]],
+		magical_value_types[i] .. [[* self = (]] .. magical_value_types[i] .. [[*)  tolua_tousertype(tolua_S,1,0);
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'delete'", NULL);
+#endif
+  Mtolua_pool_delete(self);]]
+		);
+	end
+
 	size = table.getn(magical_enum_class);
 	for i=1,size do
 		replace( 
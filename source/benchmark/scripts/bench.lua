@@ -0,0 +1,41 @@
+-- 脚本层数学类型的性能测试
+--
+--   script-benchmark bench.lua [table|tolua|ffi] [count]
+--   luajit bench.lua [ffi|table] [count]
+--   lua bench.lua [count]
+--
+-- ffi使用引擎MAGICAL_USING_LUAJIT下加载的ffimath.lua，table使用同接口的纯Lua实现tablemath.lua，
+-- tolua使用script-benchmark注册的toluamath，即引擎BindMath绑定的类型（userdata）；
+-- 标准Lua没有FFI，对比几种方式时用相同的count
+
+local dir = ( arg and arg[0] or "" ):match( "^(.*[/\\])" ) or "./"
+package.path = dir .. "?.lua;" .. dir .. "../../demo/assets/standard/scripts/?.lua;" .. package.path
+
+local binding = ( jit and "ffi" ) or "table"
+local count = 1000000
+for _, v in ipairs( arg or {} ) do
+	if tonumber( v ) then
+		count = tonumber( v )
+	else
+		binding = v
+	end
+end
+
+local modules = { ffi = "ffimath", table = "tablemath", tolua = "toluamath" }
+local types = require( assert( modules[ binding ], "unknown binding " .. binding ) )
+local workloads = {
+	{ "vector_math", require( "vector_math" ) },
+	{ "entity_update", require( "entity_update" ) },
+}
+
+print( string.format( "%s, %s, count %d", jit and jit.version or _VERSION, binding, count ) )
+for _, workload in ipairs( workloads ) do
+	local name, run = workload[1], workload[2]
+	collectgarbage( "collect" )
+	local memory = collectgarbage( "count" )
+	local start = os.clock()
+	local checksum = run( types, count )
+	local elapsed = os.clock() - start
+	print( string.format( "%-16s %10.2f ms %12.0f ops/s %10.0f KB  checksum %.4f",
+		name, elapsed * 1000, count / elapsed, collectgarbage( "count" ) - memory, checksum ) )
+end
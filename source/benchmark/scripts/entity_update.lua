@@ -0,0 +1,46 @@
+-- 逐实体的脚本更新：每个实体有位置、速度和朝向，每帧调用一次onUpdate
+
+return function( types, count )
+	local Vector3, Quaternion, Matrix4 = types.Vector3, types.Quaternion, types.Matrix4
+
+	local Entity = {}
+	Entity.__index = Entity
+
+	function Entity:onUpdate( dt, spin )
+		self.velocity = self.velocity + self.gravity * dt
+		self.position = self.position + self.velocity * dt
+		if self.position.y < 0 then
+			self.position.y = 0
+			self.velocity.y = -self.velocity.y * 0.5
+		end
+		self.rotation = self.rotation * spin
+		self.rotation:normalize()
+		self.world = self.rotation * self.forward + self.position
+	end
+
+	local entities = {}
+	for i = 1, 1000 do
+		entities[i] = setmetatable( {
+			position = Vector3( i, 10 + i % 7, -i ),
+			velocity = Vector3( 1, 0, 0.5 ),
+			gravity = Vector3( 0, -9.8, 0 ),
+			forward = Vector3( 0, 0, 1 ),
+			rotation = Quaternion():identity(),
+			world = Vector3(),
+		}, Entity )
+	end
+
+	local spin = Quaternion( 0, 0.0087265, 0, 0.9999619 )
+	local frames = math.max( 1, math.floor( count / #entities ) )
+	for frame = 1, frames do
+		for i = 1, #entities do
+			entities[i]:onUpdate( 1 / 60, spin )
+		end
+	end
+
+	local sum = 0
+	for i = 1, #entities do
+		sum = sum + entities[i].world:length()
+	end
+	return sum
+end
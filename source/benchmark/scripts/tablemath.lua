@@ -0,0 +1,232 @@
+-- 与ffimath.lua接口相同的纯Lua实现，每个值是一个带元表的table
+-- 在标准Lua 5.1上代替FFI，作为对照组：每次运算都分配新对象，与tolua的userdata一样由GC回收
+
+local sqrt = math.sqrt
+local format = string.format
+local setmetatable = setmetatable
+local getmetatable = getmetatable
+
+local vector3_mt, quaternion_mt, matrix4_mt = {}, {}, {}
+
+local function Vector3( x, y, z )
+	return setmetatable( { x = x or 0, y = y or 0, z = z or 0 }, vector3_mt )
+end
+
+local function Quaternion( x, y, z, w )
+	return setmetatable( { x = x or 0, y = y or 0, z = z or 0, w = w or 0 }, quaternion_mt )
+end
+
+local function Matrix4()
+	local m = {}
+	for i = 0, 15 do m[i] = 0 end
+	return setmetatable( { m = m }, matrix4_mt )
+end
+
+local vector3 = {}
+
+function vector3:set( x, y, z )
+	self.x, self.y, self.z = x, y, z
+	return self
+end
+
+function vector3:dot( v )
+	return self.x * v.x + self.y * v.y + self.z * v.z
+end
+
+function vector3:cross( v )
+	return Vector3( self.y * v.z - self.z * v.y, self.z * v.x - self.x * v.z, self.x * v.y - self.y * v.x )
+end
+
+function vector3:lengthSq()
+	return self.x * self.x + self.y * self.y + self.z * self.z
+end
+
+function vector3:length()
+	return sqrt( self.x * self.x + self.y * self.y + self.z * self.z )
+end
+
+function vector3:normalize()
+	local n = sqrt( self.x * self.x + self.y * self.y + self.z * self.z )
+	if n > 1e-6 then
+		n = 1 / n
+		self.x, self.y, self.z = self.x * n, self.y * n, self.z * n
+	end
+	return self
+end
+
+function vector3:lerp( v, t )
+	return Vector3( self.x + ( v.x - self.x ) * t, self.y + ( v.y - self.y ) * t, self.z + ( v.z - self.z ) * t )
+end
+
+function vector3:transform( m )
+	local x, y, z, m = self.x, self.y, self.z, m.m
+	return Vector3(
+		x * m[0] + y * m[4] + z * m[8] + m[12],
+		x * m[1] + y * m[5] + z * m[9] + m[13],
+		x * m[2] + y * m[6] + z * m[10] + m[14] )
+end
+
+vector3_mt.__index = vector3
+
+vector3_mt.__add = function( a, b )
+	if type( b ) == "number" then return Vector3( a.x + b, a.y + b, a.z + b ) end
+	return Vector3( a.x + b.x, a.y + b.y, a.z + b.z )
+end
+
+vector3_mt.__sub = function( a, b )
+	if type( b ) == "number" then return Vector3( a.x - b, a.y - b, a.z - b ) end
+	return Vector3( a.x - b.x, a.y - b.y, a.z - b.z )
+end
+
+vector3_mt.__mul = function( a, b )
+	if type( a ) == "number" then return Vector3( b.x * a, b.y * a, b.z * a ) end
+	if type( b ) == "number" then return Vector3( a.x * b, a.y * b, a.z * b ) end
+	if getmetatable( b ) == matrix4_mt then return a:transform( b ) end
+	return Vector3( a.x * b.x, a.y * b.y, a.z * b.z )
+end
+
+vector3_mt.__div = function( a, b )
+	if type( b ) == "number" then return Vector3( a.x / b, a.y / b, a.z / b ) end
+	return Vector3( a.x / b.x, a.y / b.y, a.z / b.z )
+end
+
+vector3_mt.__unm = function( a )
+	return Vector3( -a.x, -a.y, -a.z )
+end
+
+vector3_mt.__eq = function( a, b )
+	return a.x == b.x and a.y == b.y and a.z == b.z
+end
+
+vector3_mt.__tostring = function( a )
+	return format( "Vector3(%g, %g, %g)", a.x, a.y, a.z )
+end
+
+local quaternion = {}
+
+function quaternion:set( x, y, z, w )
+	self.x, self.y, self.z, self.w = x, y, z, w
+	return self
+end
+
+function quaternion:identity()
+	self.x, self.y, self.z, self.w = 0, 0, 0, 1
+	return self
+end
+
+function quaternion:dot( q )
+	return self.x * q.x + self.y * q.y + self.z * q.z + self.w * q.w
+end
+
+function quaternion:length()
+	return sqrt( self.x * self.x + self.y * self.y + self.z * self.z + self.w * self.w )
+end
+
+function quaternion:normalize()
+	local n = sqrt( self.x * self.x + self.y * self.y + self.z * self.z + self.w * self.w )
+	if n > 1e-6 then
+		n = 1 / n
+		self.x, self.y, self.z, self.w = self.x * n, self.y * n, self.z * n, self.w * n
+	end
+	return self
+end
+
+function quaternion:conjugate()
+	return Quaternion( -self.x, -self.y, -self.z, self.w )
+end
+
+function quaternion:rotate( v )
+	local qx, qy, qz, w2 = self.x, self.y, self.z, self.w * 2
+	local ux, uy, uz = qy * v.z - qz * v.y, qz * v.x - qx * v.z, qx * v.y - qy * v.x
+	local uux, uuy, uuz = qy * uz - qz * uy, qz * ux - qx * uz, qx * uy - qy * ux
+	return Vector3( v.x + ux * w2 + uux * 2, v.y + uy * w2 + uuy * 2, v.z + uz * w2 + uuz * 2 )
+end
+
+quaternion_mt.__index = quaternion
+
+quaternion_mt.__add = function( a, b )
+	return Quaternion( a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w )
+end
+
+quaternion_mt.__sub = function( a, b )
+	return Quaternion( a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w )
+end
+
+quaternion_mt.__mul = function( a, b )
+	if type( b ) == "number" then return Quaternion( a.x * b, a.y * b, a.z * b, a.w * b ) end
+	if getmetatable( b ) == vector3_mt then return a:rotate( b ) end
+	return Quaternion(
+		a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+		a.w * b.y + a.y * b.w + a.z * b.x - a.x * b.z,
+		a.w * b.z + a.z * b.w + a.x * b.y - a.y * b.x,
+		a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z )
+end
+
+quaternion_mt.__unm = function( a )
+	return Quaternion( -a.x, -a.y, -a.z, -a.w )
+end
+
+quaternion_mt.__eq = function( a, b )
+	return a.x == b.x and a.y == b.y and a.z == b.z and a.w == b.w
+end
+
+quaternion_mt.__tostring = function( a )
+	return format( "Quaternion(%g, %g, %g, %g)", a.x, a.y, a.z, a.w )
+end
+
+local matrix4 = {}
+
+function matrix4:identity()
+	local m = self.m
+	for i = 0, 15 do m[i] = 0 end
+	m[0], m[5], m[10], m[15] = 1, 1, 1, 1
+	return self
+end
+
+function matrix4:transpose()
+	local m = self.m
+	for r = 0, 3 do
+		for c = r + 1, 3 do
+			m[r * 4 + c], m[c * 4 + r] = m[c * 4 + r], m[r * 4 + c]
+		end
+	end
+	return self
+end
+
+function matrix4:setTranslation( x, y, z )
+	local m = self.m
+	m[12], m[13], m[14] = x, y, z
+	return self
+end
+
+function matrix4:mul( b, out )
+	out = out or Matrix4()
+	local x, y, o = self.m, b.m, out.m
+	for r = 0, 12, 4 do
+		local a1, a2, a3, a4 = x[r], x[r + 1], x[r + 2], x[r + 3]
+		for c = 0, 3 do
+			o[r + c] = a1 * y[c] + a2 * y[c + 4] + a3 * y[c + 8] + a4 * y[c + 12]
+		end
+	end
+	return out
+end
+
+matrix4_mt.__index = matrix4
+
+matrix4_mt.__mul = function( a, b )
+	if type( b ) == "number" then
+		local out = Matrix4()
+		for i = 0, 15 do out.m[i] = a.m[i] * b end
+		return out
+	end
+	return a:mul( b )
+end
+
+matrix4_mt.__eq = function( a, b )
+	for i = 0, 15 do
+		if a.m[i] ~= b.m[i] then return false end
+	end
+	return true
+end
+
+return { Vector3 = Vector3, Quaternion = Quaternion, Matrix4 = Matrix4 }
\ No newline at end of file
@@ -0,0 +1,21 @@
+-- 向量和矩阵运算的紧密循环，每次迭代都产生临时值
+
+return function( types, count )
+	local Vector3, Quaternion, Matrix4 = types.Vector3, types.Quaternion, types.Matrix4
+
+	local a = Vector3( 1, 2, 3 )
+	local b = Vector3( 0.5, -1, 0.25 )
+	local q = Quaternion( 0, 0.3826834, 0, 0.9238795 )
+	local m = Matrix4():identity():setTranslation( 1, 2, 3 )
+
+	local sum = 0
+	for i = 1, count do
+		local c = a:cross( b ) + a * 0.5
+		c:normalize()
+		local d = q * c
+		local e = d * m
+		sum = sum + e:dot( b ) + c:lerp( e, 0.25 ):length()
+		a.x = a.x + 1e-4
+	end
+	return sum
+end
@@ -0,0 +1,25 @@
+-- LuaWorkers的批处理函数：每条输入是一个实体的位置和速度，在工作线程中模拟steps步后返回新的位置
+-- 由benchmark的workers场景加载，工作线程的状态中只有标准库和数学类型
+
+function update( input, shared )
+	local x, y, z = input[1], input[2], input[3]
+	local vx, vy, vz = input[4], input[5], input[6]
+	local dt, steps = shared.dt, shared.steps
+	local sqrt = math.sqrt
+
+	for i = 1, steps do
+		-- 朝原点转向，速度限制在max_speed以内
+		local len = sqrt( x * x + y * y + z * z ) + 1e-6
+		vx = vx - x / len * dt
+		vy = vy - y / len * dt
+		vz = vz - z / len * dt
+		local speed = sqrt( vx * vx + vy * vy + vz * vz )
+		if speed > shared.max_speed then
+			local s = shared.max_speed / speed
+			vx, vy, vz = vx * s, vy * s, vz * s
+		end
+		x, y, z = x + vx * dt, y + vy * dt, z + vz * dt
+	end
+
+	return { x, y, z }
+end
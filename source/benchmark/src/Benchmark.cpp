@@ -0,0 +1,1454 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "Benchmark.h"
+#include "SpatialHash2.h"
+#include "Assets.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <malloc.h>
+#include <algorithm>
+#include <thread>
+
+#ifdef MAGICAL_BENCHMARK_SCRIPT
+#include "LuaSystem.h"
+#include "LuaScheduler.h"
+#include "LuaWorkers.h"
+#include "LuaObject.h"
+#endif
+
+/*
+每个实体同一类型的behaviour只能挂一个，用模板参数区分出多个类型
+*/
+template< int N >
+class Spinner : public Behaviour<Entity>
+{
+public:
+	virtual void onUpdate( void ) override
+	{
+		object->rotate( Quaternion::createRotationY( Math::rad( (float)( N + 1 ) ) ), Space::Self );
+	}
+};
+
+template< int N >
+class Ticker : public Behaviour<Entity>
+{
+public:
+	virtual void onUpdate( void ) override
+	{
+		m_value = m_value * 1664525u + 1013904223u + N;
+	}
+
+private:
+	unsigned int m_value = 0;
+};
+
+/*
+沿x轴来回移动，每帧的位移是包围盒外扩量的一半，实体大约每两帧离开一次外扩的包围盒
+*/
+class Mover : public Behaviour<Entity>
+{
+public:
+	virtual void onUpdate( void ) override
+	{
+		object->translate( ( m_frame ++ / 20 ) % 2 ? -0.05f : 0.05f, 0.0f, 0.0f );
+	}
+
+private:
+	unsigned int m_frame = 0;
+};
+
+/*
+挂上TBehaviour<0>到TBehaviour<count - 1>，count不超过MaxBehaviours（parseArgs中检查）
+*/
+template< template< int > class TBehaviour >
+static void addBehaviours( Entity* entity, int count )
+{
+	if( count > 7 ) entity->addComponent< TBehaviour<7> >();
+	if( count > 6 ) entity->addComponent< TBehaviour<6> >();
+	if( count > 5 ) entity->addComponent< TBehaviour<5> >();
+	if( count > 4 ) entity->addComponent< TBehaviour<4> >();
+	if( count > 3 ) entity->addComponent< TBehaviour<3> >();
+	if( count > 2 ) entity->addComponent< TBehaviour<2> >();
+	if( count > 1 ) entity->addComponent< TBehaviour<1> >();
+	if( count > 0 ) entity->addComponent< TBehaviour<0> >();
+}
+
+/*
+查询在FrameEnd钩子中执行，只统计测量期间的次数和耗时
+*/
+static int _s_queries = 0;
+static bool _s_measuring = false;
+static int64_t _s_operations = 0;
+static int64_t _s_operations_ns = 0;
+static uint32_t _s_seed = 1;
+static float _s_grid_x = 0.0f;
+static float _s_grid_z = 0.0f;
+
+static float randomRange( float lo, float hi )
+{
+	_s_seed = _s_seed * 1664525u + 1013904223u;
+	return lo + ( hi - lo ) * ( _s_seed >> 8 ) * ( 1.0f / 16777216.0f );
+}
+
+static void raycastQueries( void )
+{
+	MAGICAL_PROFILE_SCOPE( "Benchmark::raycast" );
+
+	Scene* scene = Director::getRunningScene();
+	int64_t begin = Profiler::now();
+	float distance;
+	for( int i = 0; i < _s_queries; ++i )
+	{
+		Vector3 target( randomRange( 0.0f, _s_grid_x ), 0.0f, randomRange( 0.0f, _s_grid_z ) );
+		if( i & 1 )
+		{
+			// 竖直向下
+			Ray ray( Vector3( target.x, 10.0f, target.z ), Vector3( 0.0f, -1.0f, 0.0f ) );
+			scene->raycast( distance, ray );
+		}
+		else
+		{
+			// 从场景上方斜穿，路径上的节点更多
+			Vector3 origin( randomRange( 0.0f, _s_grid_x ), 5.0f, randomRange( 0.0f, _s_grid_z ) );
+			Ray ray( origin, Vector3::normalize( target - origin ) );
+			scene->raycast( distance, ray );
+		}
+	}
+
+	if( _s_measuring )
+	{
+		_s_operations += _s_queries;
+		_s_operations_ns += Profiler::now() - begin;
+	}
+}
+
+/*
+用SceneFile生成与transform场景相同层级的entities个节点，每个节点挂behaviours个Ticker，
+每帧由SceneLoader在budget微秒内实例化，整个场景实例化完后移除并重新开始；
+operations为实例化的节点数，耗时只统计SceneLoader::update，解析文件的耗时见Benchmark::sceneParse阶段
+*/
+static Ptr<Data> _s_scene_data;
+static Ptr<SceneLoader> _s_loader;
+static Ptr<Object> _s_loader_root;
+static Scene* _s_loader_scene = nullptr;
+static int64_t _s_loader_budget = 0;
+
+static void addSceneSubtree( const BenchmarkConfig& config, SceneFile* file, int parent, int level, int& remaining )
+{
+	for( int i = 0; i < config.fanout && remaining > 0; ++i )
+	{
+		size_t node = file->addNode( parent, ObjectType::Entity, "Entity", Vector3( 1.0f, 0, 0 ), Quaternion::Identity, Vector3::One );
+		for( int b = 0; b < config.behaviours; ++b )
+			file->addBehaviour( node, System::format( "Ticker%d", b ).c_str() );
+		-- remaining;
+
+		if( level + 1 < config.depth )
+			addSceneSubtree( config, file, (int) node, level + 1, remaining );
+	}
+}
+
+template< int N >
+static void registerTicker( void )
+{
+	SceneLoader::registerBehaviour< Ticker<N> >( System::format( "Ticker%d", N ).c_str() );
+}
+
+static void restartLoader( void )
+{
+	if( _s_loader_root )
+		_s_loader_root->removeSelf();
+
+	Ptr<SceneFile> file;
+	{
+		MAGICAL_PROFILE_SCOPE( "Benchmark::sceneParse" );
+		file = SceneFile::create();
+		file->load( _s_scene_data.get() );
+	}
+
+	_s_loader_root = Object::create();
+	_s_loader_scene->addChild( _s_loader_root );
+	_s_loader = SceneLoader::create( file.get(), _s_loader_root.get() );
+}
+
+static void startLoader( const BenchmarkConfig& config, Scene* scene )
+{
+	registerTicker<0>(); registerTicker<1>(); registerTicker<2>(); registerTicker<3>();
+	registerTicker<4>(); registerTicker<5>(); registerTicker<6>(); registerTicker<7>();
+
+	// 顶层节点排成一层，每个顶层节点下是一棵完整的子树
+	Ptr<SceneFile> file = SceneFile::create();
+	int remaining = config.entities;
+	while( remaining > 0 )
+	{
+		size_t root = file->addNode( -1, ObjectType::Entity, "Root", Vector3::Zero, Quaternion::Identity, Vector3::One );
+		-- remaining;
+		if( config.depth > 1 )
+			addSceneSubtree( config, file.get(), (int) root, 1, remaining );
+	}
+
+	_s_scene_data = file->save();
+	_s_loader_budget = config.budget;
+	_s_loader_scene = scene;
+	restartLoader();
+}
+
+static void loaderSteps( void )
+{
+	if( _s_loader->isDone() )
+		restartLoader();
+
+	size_t before = _s_loader->getInstantiatedCount();
+	int64_t begin = Profiler::now();
+	{
+		MAGICAL_PROFILE_SCOPE( "Benchmark::sceneLoad" );
+		_s_loader->update( _s_loader_budget );
+	}
+
+	if( _s_measuring )
+	{
+		_s_operations += (int64_t)( _s_loader->getInstantiatedCount() - before );
+		_s_operations_ns += Profiler::now() - begin;
+	}
+}
+
+/*
+entities个半径0.5的圆在正方形区域内匀速运动，碰到边界反弹，平均每个单位面积0.3个圆；
+每帧移动全部的圆并update，再用findContacts求出所有相交的圆对，operations为步数；
+单元边长取圆直径的2倍，桶数与圆的数量相同
+*/
+static SpatialHash2* _s_hash = nullptr;
+static Vector<Circle> _s_circles;
+static Vector<Vector2> _s_velocities;
+static Vector<SpatialHash2::Pair> _s_contacts;
+static float _s_world_size = 0.0f;
+
+static void startBroadphase( const BenchmarkConfig& config )
+{
+	_s_world_size = sqrtf( config.entities / 0.3f );
+	_s_hash = new SpatialHash2( 2.0f, (size_t) config.entities );
+	_s_circles.resize( config.entities );
+	_s_velocities.resize( config.entities );
+	for( int i = 0; i < config.entities; ++i )
+	{
+		_s_circles[i] = Circle( randomRange( 0.0f, _s_world_size ), randomRange( 0.0f, _s_world_size ), 0.5f );
+		_s_velocities[i] = Vector2( randomRange( -5.0f, 5.0f ), randomRange( -5.0f, 5.0f ) );
+		_s_hash->insert( _s_circles[i] );
+	}
+}
+
+static void broadphaseStep( void )
+{
+	float dt = Director::getFixedDeltaTime();
+	int64_t begin = Profiler::now();
+	{
+		MAGICAL_PROFILE_SCOPE( "Benchmark::broadphaseUpdate" );
+		for( int i = 0; i < (int) _s_circles.size(); ++i )
+		{
+			Circle& circle = _s_circles[i];
+			Vector2& velocity = _s_velocities[i];
+			circle.x += velocity.x * dt;
+			circle.y += velocity.y * dt;
+			if( circle.x < 0.0f || circle.x > _s_world_size ) velocity.x = -velocity.x;
+			if( circle.y < 0.0f || circle.y > _s_world_size ) velocity.y = -velocity.y;
+			_s_hash->update( i );
+		}
+	}
+	{
+		MAGICAL_PROFILE_SCOPE( "Benchmark::broadphaseContacts" );
+		_s_contacts.clear();
+		_s_hash->findContacts( _s_contacts );
+	}
+
+	if( _s_measuring )
+	{
+		_s_operations += 1;
+		_s_operations_ns += Profiler::now() - begin;
+	}
+}
+
+/*
+entities个角色共用一个fanout条轨道的片段（默认500个角色、60根骨骼），骨骼按二叉树挂在角色下，
+每帧在FrameEnd钩子中由各自的Animator采样并写入骨骼的局部变换，operations为采样的骨骼数；
+片段逐条addTrack构建，构建耗时在结束时输出
+*/
+static Ptr<AnimationClip> _s_clip;
+static Vector<Ptr<Animator>> _s_animators;
+static int64_t _s_clip_build_ns = 0;
+
+static void startAnimation( const BenchmarkConfig& config, Scene* scene )
+{
+	// 2秒的片段：根骨骼平移，其余骨骼的旋转各自按不同的频率摆动，缩放不变
+	size_t frames = 61;
+	Vector<Vector3> translations( frames );
+	Vector<Quaternion> rotations( frames );
+	Vector<Vector3> scales( frames, Vector3::One );
+
+	int64_t begin = Profiler::now();
+	_s_clip = AnimationClip::create( AnimationClip::DefaultFrameRate, frames );
+	for( int bone = 0; bone < config.fanout; ++bone )
+	{
+		for( size_t f = 0; f < frames; ++f )
+		{
+			float phase = f * ( 2.0f * Math::PI / ( frames - 1 ) );
+			translations[f] = bone == 0 ? Vector3( 0.0f, 0.1f * sinf( phase * 2.0f ), 0.0f ) : Vector3( 0.0f, 0.2f, 0.0f );
+			rotations[f] = Quaternion::createRotation( Vector3( 1.0f, 0.0f, 0.0f ), 0.5f * sinf( phase + bone ) );
+		}
+		_s_clip->addTrack( System::format( "bone%d", bone ).c_str(), translations.data(), rotations.data(), scales.data() );
+	}
+	_s_clip_build_ns = Profiler::now() - begin;
+
+	for( int i = 0; i < config.entities; ++i )
+	{
+		Ptr<Entity> character = Entity::create();
+		character->setPosition( ( i % 100 ) * 2.0f, 0, ( i / 100 ) * 2.0f );
+		scene->addChild( character );
+
+		Vector<Entity*> bones;
+		for( int bone = 0; bone < config.fanout; ++bone )
+		{
+			Ptr<Entity> entity = Entity::create( System::format( "bone%d", bone ).c_str() );
+			( bone == 0 ? character.get() : bones[ ( bone - 1 ) / 2 ] )->addChild( entity );
+			bones.push_back( entity.get() );
+		}
+
+		Ptr<Animator> animator = Animator::create( _s_clip.get(), character.get() );
+		animator->setTime( randomRange( 0.0f, _s_clip->getDuration() ) );
+		_s_animators.push_back( animator );
+	}
+}
+
+static void animationSteps( void )
+{
+	float dt = Director::getFixedDeltaTime();
+	int64_t begin = Profiler::now();
+	{
+		MAGICAL_PROFILE_SCOPE( "Benchmark::animationUpdate" );
+		for( auto& animator : _s_animators )
+			animator->update( dt );
+	}
+
+	if( _s_measuring )
+	{
+		_s_operations += (int64_t) _s_animators.size() * _s_clip->trackCount();
+		_s_operations_ns += Profiler::now() - begin;
+	}
+}
+
+/*
+每帧写entities条带三个参数的二进制日志，operations只统计MAGICAL_BLOG调用本身；
+帧末等待后台线程取走队列中的记录，每帧都从空队列开始，entities不超过队列容量时不会丢弃，
+丢弃的条数在结束时输出；单核机器上超过半个队列（8192条）会唤醒后台线程，其写文件的耗时会计入测量
+*/
+static const char* _s_blog_file = "benchmark.blog";
+static int _s_blog_calls = 0;
+
+static void binaryLogWrites( void )
+{
+	int64_t begin = Profiler::now();
+	{
+		MAGICAL_PROFILE_SCOPE( "Benchmark::blog" );
+		for( int i = 0; i < _s_blog_calls; ++i )
+			MAGICAL_BLOGD( "entity %d moved to %.3f (%s)", i, i * 0.5, "benchmark" );
+	}
+
+	if( _s_measuring )
+	{
+		_s_operations += _s_blog_calls;
+		_s_operations_ns += Profiler::now() - begin;
+	}
+
+	MAGICAL_PROFILE_SCOPE( "Benchmark::blogFlush" );
+	BinaryLog::flush();
+}
+
+/*
+每帧由workers个线程共写entities行文本日志，再由Log::flush等待全部写入文件，
+operations为行数，耗时包括写文件；队列满时阻塞等待，不会丢弃
+*/
+static int _s_log_lines = 0;
+static int _s_log_threads = 0;
+
+static void writeLogLines( int count )
+{
+	for( int i = 0; i < count; ++i )
+		MAGICAL_LOGD( "benchmark log line, a typical message of about sixty bytes." );
+}
+
+static void logWrites( void )
+{
+	MAGICAL_PROFILE_SCOPE( "Benchmark::log" );
+
+	int64_t begin = Profiler::now();
+	Vector<std::thread> threads;
+	for( int i = 1; i < _s_log_threads; ++i )
+		threads.push_back( std::thread( writeLogLines, _s_log_lines / _s_log_threads ) );
+	writeLogLines( _s_log_lines - _s_log_lines / _s_log_threads * ( _s_log_threads - 1 ) );
+	for( auto& thread : threads )
+		thread.join();
+	Log::flush();
+
+	if( _s_measuring )
+	{
+		_s_operations += _s_log_lines;
+		_s_operations_ns += Profiler::now() - begin;
+	}
+}
+
+#ifdef MAGICAL_BENCHMARK_SCRIPT
+/*
+两个参数一个返回值的脚本函数，operations只统计call<double>，每帧依次测量四种调用方式：
+call      LuaFunction::call<double>，按handler一次lua_rawgeti取函数，直接转换返回值
+object    LuaFunction::operator()，取函数方式相同，返回值包装为LuaObject
+baseline  改动前的方式：经过注册表中按字符串查找的映射表取函数（两次查找加lua_remove），
+          返回值包装为带两个std::string和LuaFunction、LuaTable成员的旧LuaObject
+pinned    LuaFunction::Pinned，函数缓存在栈上的槽位中，每次调用只lua_pushvalue
+*/
+static LuaFunction* _s_function = nullptr;
+static int _s_calls = 0;
+static double _s_call_sum = 0.0;
+static int _s_baseline_handler = 0;
+static int64_t _s_call_ns[4] = { 0 };
+static const char* _s_mapping_key = "MAPPINGFUNCTION";
+
+// 改动前LuaObject的成员，数值结果也要构造和析构全部成员
+struct BaselineObject
+{
+	LuaT type = LuaT::Nil;
+	std::string string;
+	bool boolean = false;
+	double number = 0.0;
+	void* userdata = nullptr;
+	std::string usertype;
+	bool is_gc = false;
+	LuaFunction function;
+	LuaTable table;
+};
+
+static BaselineObject baselineCall( lua_State* L, int i )
+{
+	lua_pushstring( L, _s_mapping_key );
+	lua_rawget( L, LUA_REGISTRYINDEX );
+	lua_rawgeti( L, -1, _s_baseline_handler );
+	lua_remove( L, -2 );
+	lua_pushinteger( L, i );
+	lua_pushnumber( L, 0.5 );
+
+	BaselineObject obj;
+	if( lua_pcall( L, 2, 1, 0 ) == 0 )
+	{
+		obj.type = LuaT::Number;
+		obj.number = lua_tonumber( L, -1 );
+	}
+	lua_pop( L, 1 );
+	return obj;
+}
+
+static void scriptCalls( void )
+{
+	const LuaFunction& lf = *_s_function;
+	lua_State* L = Lua::sharedLuaState().cPtr();
+	int64_t times[5];
+
+	times[0] = Profiler::now();
+	{
+		MAGICAL_PROFILE_SCOPE( "Benchmark::call" );
+		for( int i = 0; i < _s_calls; ++i )
+			_s_call_sum += lf.call<double>( i, 0.5 );
+	}
+
+	times[1] = Profiler::now();
+	{
+		MAGICAL_PROFILE_SCOPE( "Benchmark::callObject" );
+		for( int i = 0; i < _s_calls; ++i )
+			_s_call_sum += lf( i, 0.5 ).toDouble();
+	}
+
+	times[2] = Profiler::now();
+	{
+		MAGICAL_PROFILE_SCOPE( "Benchmark::callBaseline" );
+		for( int i = 0; i < _s_calls; ++i )
+			_s_call_sum += baselineCall( L, i ).number;
+	}
+
+	times[3] = Profiler::now();
+	{
+		MAGICAL_PROFILE_SCOPE( "Benchmark::callPinned" );
+		LuaFunction::Pinned pinned( lf );
+		for( int i = 0; i < _s_calls; ++i )
+			_s_call_sum += pinned.call<double>( i, 0.5 );
+	}
+	times[4] = Profiler::now();
+
+	if( _s_measuring )
+	{
+		_s_operations += _s_calls;
+		_s_operations_ns += times[1] - times[0];
+		for( int i = 0; i < 4; ++i )
+			_s_call_ns[i] += times[ i + 1 ] - times[i];
+	}
+}
+
+static void startCalls( const BenchmarkConfig& config )
+{
+	Lua::init();
+	LuaState& L = Lua::sharedLuaState();
+	L.runScript( "function add( a, b ) return a + b end" );
+
+	_s_function = new LuaFunction( L[ "add" ].toLuaFunction() );
+	_s_calls = config.entities;
+
+	// 按改动前的方式建立映射表并登记同一个函数
+	lua_State* ls = L.cPtr();
+	lua_pushstring( ls, _s_mapping_key );
+	lua_createtable( ls, 255, 0 );
+	lua_rawset( ls, LUA_REGISTRYINDEX );
+	lua_pushstring( ls, _s_mapping_key );
+	lua_rawget( ls, LUA_REGISTRYINDEX );
+	lua_getglobal( ls, "add" );
+	_s_baseline_handler = luaL_ref( ls, -2 );
+	lua_pop( ls, 1 );
+	Director::addHook( Director::FrameEnd, scriptCalls );
+}
+
+/*
+每帧把整批输入交给工作线程，主线程阻塞到全部完成，operations为调用次数
+*/
+static LuaBatch* _s_batch = nullptr;
+
+static void workerBatches( void )
+{
+	MAGICAL_PROFILE_SCOPE( "Benchmark::workers" );
+
+	int64_t begin = Profiler::now();
+	size_t succeeded = LuaWorkers::run( *_s_batch );
+	MAGICAL_ASSERT( succeeded == _s_batch->size(), "LuaWorkers::run() failed" );
+
+	if( _s_measuring )
+	{
+		_s_operations += (int64_t) succeeded;
+		_s_operations_ns += Profiler::now() - begin;
+	}
+}
+
+static void startWorkers( const BenchmarkConfig& config )
+{
+	Lua::init();
+	if( !LuaWorkers::start( (size_t) config.workers, config.script.c_str() ) )
+		return;
+
+	_s_batch = new LuaBatch( "update" );
+	LuaMessage& shared = _s_batch->shared();
+	shared.beginTable();
+	shared.writeString( "dt" );
+	shared.writeNumber( 1.0 / 60.0 );
+	shared.writeString( "steps" );
+	shared.writeNumber( 64 );
+	shared.writeString( "max_speed" );
+	shared.writeNumber( 5.0 );
+	shared.endTable();
+
+	// 输入为{ x, y, z, vx, vy, vz }
+	LuaMessage input;
+	for( int i = 0; i < config.entities; ++i )
+	{
+		input.clear();
+		input.beginTable();
+		for( int k = 1; k <= 6; ++k )
+		{
+			float range = k <= 3 ? 100.0f : 1.0f;
+			input.writeNumber( k );
+			input.writeNumber( randomRange( -range, range ) );
+		}
+		input.endTable();
+		_s_batch->add( input );
+	}
+
+	Director::addHook( Director::FrameEnd, workerBatches );
+}
+#endif
+
+/*
+常驻内存，shared为其中由文件映射的部分（与页缓存共享）
+*/
+static size_t readRssKb( size_t* shared = nullptr )
+{
+	FILE* fp = fopen( "/proc/self/statm", "r" );
+	if( fp == nullptr )
+		return 0;
+
+	unsigned long size = 0, resident = 0, file = 0;
+	if( fscanf( fp, "%lu %lu %lu", &size, &resident, &file ) != 3 )
+		resident = file = 0;
+	fclose( fp );
+
+	size_t page_kb = (size_t) sysconf( _SC_PAGESIZE ) / 1024;
+	if( shared )
+		*shared = (size_t) file * page_kb;
+	return (size_t) resident * page_kb;
+}
+
+static size_t readPeakRssKb( void )
+{
+	FILE* fp = fopen( "/proc/self/status", "r" );
+	if( fp == nullptr )
+		return 0;
+
+	char line[ 256 ];
+	size_t peak = 0;
+	while( fgets( line, sizeof( line ), fp ) )
+	{
+		if( strncmp( line, "VmHWM:", 6 ) == 0 )
+		{
+			peak = (size_t) strtoul( line + 6, nullptr, 10 );
+			break;
+		}
+	}
+	fclose( fp );
+	return peak;
+}
+
+/*
+entities个file_kb大小的文件写在临时目录中，每帧用Assets::loadFile全部加载，按页读取一个字节使其全部驻留，再全部释放；
+偶数帧按映射阈值加载（大于阈值的文件映射），奇数帧把阈值设为最大值全部读取到堆上，
+operations为加载的文件数，耗时只统计loadFile；
+rss为加载后、逐页读取后相对于本帧开始时常驻内存的增量，取各帧的最大值，file为其中文件映射的部分；
+文件在写入后已经在页缓存中，测量的是热缓存下的加载
+*/
+static char _s_assets_directory[] = "/tmp/benchmark-assets.XXXXXX";
+static Vector<std::string> _s_assets_files;
+static Vector<Ptr<Data>> _s_assets_loaded;
+static size_t _s_assets_map_threshold = 0;
+static int _s_assets_frame = 0;
+static int64_t _s_assets_load_ns[2] = { 0 };
+static int64_t _s_assets_touch_ns[2] = { 0 };
+static int _s_assets_frames[2] = { 0 };
+static size_t _s_assets_load_kb[2] = { 0 };
+static size_t _s_assets_touch_kb[2] = { 0 };
+static size_t _s_assets_file_kb[2] = { 0 };
+static uint64_t _s_assets_checksum = 0;
+
+static bool startAssets( const BenchmarkConfig& config )
+{
+	if( mkdtemp( _s_assets_directory ) == nullptr )
+	{
+		MAGICAL_SET_LAST_ERROR( "create assets directory failed!" );
+		MAGICAL_LOG_LAST_ERROR();
+		return false;
+	}
+
+	// 每个文件开头写入序号，其余内容相同
+	Vector<char> chunk( 1024 * 1024 );
+	for( auto& c : chunk )
+		c = (char)( randomRange( 0.0f, 256.0f ) );
+
+	for( int i = 0; i < config.entities; ++i )
+	{
+		std::string file = System::format( "%s/asset%04d.bin", _s_assets_directory, i );
+		FILE* fp = fopen( file.c_str(), "wb" );
+		if( fp == nullptr )
+		{
+			MAGICAL_SET_LAST_ERROR( System::format( "open file(%s) failed!", file.c_str() ).c_str() );
+			MAGICAL_LOG_LAST_ERROR();
+			return false;
+		}
+
+		memcpy( chunk.data(), &i, sizeof( i ) );
+		size_t remaining = (size_t) config.file_kb * 1024;
+		while( remaining > 0 )
+		{
+			size_t count = std::min( remaining, chunk.size() );
+			fwrite( chunk.data(), 1, count, fp );
+			remaining -= count;
+		}
+		fclose( fp );
+		_s_assets_files.push_back( file );
+	}
+
+	_s_assets_map_threshold = Assets::getMapThreshold();
+	return true;
+}
+
+static void assetsLoads( void )
+{
+	int mode = _s_assets_frame ++ % 2;
+	Assets::setMapThreshold( mode == 0 ? _s_assets_map_threshold : (size_t) -1 );
+
+	size_t file_before = 0, file_loaded = 0, file_touched = 0;
+	size_t before = readRssKb( &file_before );
+
+	int64_t begin = Profiler::now();
+	{
+		MAGICAL_PROFILE_SCOPE( mode == 0 ? "Benchmark::assetsMap" : "Benchmark::assetsRead" );
+		for( const auto& file : _s_assets_files )
+			_s_assets_loaded.push_back( Assets::loadFile( file.c_str() ) );
+	}
+	int64_t loaded = Profiler::now();
+	size_t after_load = readRssKb( &file_loaded );
+
+	{
+		MAGICAL_PROFILE_SCOPE( "Benchmark::assetsTouch" );
+		uint64_t sum = 0;
+		for( const auto& data : _s_assets_loaded )
+		{
+			if( !data )
+				continue;
+			const char* bytes = data->cPtr();
+			for( size_t i = 0; i < data->size(); i += 4096 )
+				sum += (unsigned char) bytes[i];
+		}
+		_s_assets_checksum += sum;
+	}
+	int64_t touched = Profiler::now();
+	size_t after_touch = readRssKb( &file_touched );
+
+	{
+		// 读取方式的缓冲区由malloc分配，归还给系统后下一帧才能测到增量
+		MAGICAL_PROFILE_SCOPE( "Benchmark::assetsRelease" );
+		_s_assets_loaded.clear();
+		malloc_trim( 0 );
+	}
+
+	if( _s_measuring )
+	{
+		_s_operations += (int64_t) _s_assets_files.size();
+		_s_operations_ns += loaded - begin;
+		_s_assets_load_ns[ mode ] += loaded - begin;
+		_s_assets_touch_ns[ mode ] += touched - loaded;
+		_s_assets_frames[ mode ] += 1;
+		_s_assets_load_kb[ mode ] = std::max( _s_assets_load_kb[ mode ], after_load > before ? after_load - before : 0 );
+		_s_assets_touch_kb[ mode ] = std::max( _s_assets_touch_kb[ mode ], after_touch > before ? after_touch - before : 0 );
+		_s_assets_file_kb[ mode ] = std::max( _s_assets_file_kb[ mode ], file_touched > file_before ? file_touched - file_before : 0 );
+	}
+}
+
+static void releaseAssets( const BenchmarkConfig& config )
+{
+	static const char* modes[2] = { "map", "read" };
+	for( int mode = 0; mode < 2; ++mode )
+	{
+		int frames = _s_assets_frames[ mode ];
+		if( frames == 0 )
+			continue;
+		printf( "  assets     %-4s load %.3f ms  touch %.3f ms  rss +%u KB loaded, +%u KB touched (file %u KB)\n",
+			modes[ mode ], _s_assets_load_ns[ mode ] / 1000000.0 / frames, _s_assets_touch_ns[ mode ] / 1000000.0 / frames,
+			(unsigned int) _s_assets_load_kb[ mode ], (unsigned int) _s_assets_touch_kb[ mode ], (unsigned int) _s_assets_file_kb[ mode ] );
+	}
+	printf( "  assets     %d files x %d KB, map threshold %u bytes, checksum %llu\n", config.entities, config.file_kb,
+		(unsigned int) _s_assets_map_threshold, (unsigned long long) _s_assets_checksum );
+
+	Assets::setMapThreshold( _s_assets_map_threshold );
+	for( const auto& file : _s_assets_files )
+		unlink( file.c_str() );
+	rmdir( _s_assets_directory );
+	_s_assets_files.clear();
+	_s_assets_loaded.clear();
+}
+
+/*
+entities个大小为file_kb的1/8到1倍的文件，没有未完成的请求时一次提交全部文件的loadFileAsync（优先级0到3），
+每16个请求在提交后立即取消一个；回调必须在主线程、每个请求最多一次、已取消的请求不能回调，数据与文件内容一致；
+每帧执行回调的预算为budget微秒，operations为测量期间执行的回调数，耗时为测量期间的总时间；
+结束时等待剩余的请求全部回调，出现错误时设置last error，benchmark返回-1
+*/
+enum : uint8_t { AsyncIdle, AsyncPending, AsyncCancelled, AsyncDone };
+
+static char _s_async_directory[] = "/tmp/benchmark-async.XXXXXX";
+static Vector<std::string> _s_async_files;
+static Vector<size_t> _s_async_sizes;
+static Vector<uint8_t> _s_async_states;
+static std::thread::id _s_async_thread;
+static int _s_async_outstanding = 0;
+static int _s_async_rounds = 0;
+static int64_t _s_async_delivered = 0;
+static int64_t _s_async_cancelled = 0;
+static int64_t _s_async_errors = 0;
+static int64_t _s_async_last = 0;
+static size_t _s_async_max_queued = 0;
+
+static bool startAsync( const BenchmarkConfig& config )
+{
+	if( mkdtemp( _s_async_directory ) == nullptr )
+	{
+		MAGICAL_SET_LAST_ERROR( "create async directory failed!" );
+		MAGICAL_LOG_LAST_ERROR();
+		return false;
+	}
+
+	// 文件开头是序号，其余字节为序号的低8位
+	Vector<char> buffer( (size_t) config.file_kb * 1024 );
+	for( int i = 0; i < config.entities; ++i )
+	{
+		std::string file = System::format( "%s/async%05d.bin", _s_async_directory, i );
+		size_t size = ( i % 8 + 1 ) * buffer.size() / 8;
+		memset( buffer.data(), i & 0xff, size );
+		memcpy( buffer.data(), &i, sizeof( i ) );
+
+		FILE* fp = fopen( file.c_str(), "wb" );
+		if( fp == nullptr )
+		{
+			MAGICAL_SET_LAST_ERROR( System::format( "open file(%s) failed!", file.c_str() ).c_str() );
+			MAGICAL_LOG_LAST_ERROR();
+			return false;
+		}
+		fwrite( buffer.data(), 1, size, fp );
+		fclose( fp );
+
+		_s_async_files.push_back( file );
+		_s_async_sizes.push_back( size );
+	}
+
+	_s_async_states.resize( config.entities, AsyncIdle );
+	_s_async_thread = std::this_thread::get_id();
+	Assets::setAsyncCallbackBudget( config.budget );
+	return true;
+}
+
+static void asyncLoaded( int index, const Ptr<Data>& data )
+{
+	-- _s_async_outstanding;
+	++ _s_async_delivered;
+	if( _s_measuring )
+		++ _s_operations;
+
+	// 读取到的Data末尾多一个0
+	bool ok = std::this_thread::get_id() == _s_async_thread && _s_async_states[ index ] == AsyncPending &&
+		data && data->size() == _s_async_sizes[ index ] + 1 && memcmp( data->cPtr(), &index, sizeof( index ) ) == 0 &&
+		(unsigned char) data->cPtr()[ _s_async_sizes[ index ] - 1 ] == ( index & 0xff );
+	if( !ok )
+		++ _s_async_errors;
+	_s_async_states[ index ] = AsyncDone;
+}
+
+static void asyncLoads( void )
+{
+	int64_t now = Profiler::now();
+	if( _s_measuring && _s_async_last > 0 )
+		_s_operations_ns += now - _s_async_last;
+	_s_async_last = now;
+
+	_s_async_max_queued = std::max( _s_async_max_queued, Assets::getAsyncLoadStats().queued );
+	if( _s_async_outstanding > 0 )
+		return;
+
+	MAGICAL_PROFILE_SCOPE( "Benchmark::asyncSubmit" );
+	++ _s_async_rounds;
+	for( int i = 0; i < (int) _s_async_files.size(); ++i )
+	{
+		_s_async_states[i] = AsyncPending;
+		uint32_t id = Assets::loadFileAsync( _s_async_files[i].c_str(), [i]( const Ptr<Data>& data ){ asyncLoaded( i, data ); }, i % 4 );
+		if( i % 16 == 15 && Assets::cancelLoad( id ) )
+		{
+			_s_async_states[i] = AsyncCancelled;
+			++ _s_async_cancelled;
+			continue;
+		}
+		++ _s_async_outstanding;
+	}
+}
+
+static void releaseAsync( void )
+{
+	// 剩余的请求全部回调之后才检查结果
+	int64_t deadline = Profiler::now() + 30 * 1000000000LL;
+	while( _s_async_outstanding > 0 && Profiler::now() < deadline )
+	{
+		Assets::dispatchLoadCallbacks();
+		std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+	}
+	_s_async_errors += _s_async_outstanding;
+
+	AssetsLoadStats stats = Assets::getAsyncLoadStats();
+	printf( "  async      %d rounds, %lld callbacks, %lld cancelled, %lld errors, max queued %u\n",
+		_s_async_rounds, (long long) _s_async_delivered, (long long) _s_async_cancelled, (long long) _s_async_errors,
+		(unsigned int) _s_async_max_queued );
+	printf( "  async      latency p50 %.3f ms  p95 %.3f ms  p99 %.3f ms  %.1f MB/s\n",
+		stats.latency_p50 / 1000.0, stats.latency_p95 / 1000.0, stats.latency_p99 / 1000.0, stats.bytes_per_second / ( 1024.0 * 1024.0 ) );
+
+	Assets::setAsyncCallbackBudget( 2000 );
+	for( const auto& file : _s_async_files )
+		unlink( file.c_str() );
+	rmdir( _s_async_directory );
+	_s_async_files.clear();
+
+	if( _s_async_errors > 0 )
+	{
+		MAGICAL_SET_LAST_ERROR( System::format( "async loads: %lld errors", (long long) _s_async_errors ).c_str() );
+		MAGICAL_LOG_LAST_ERROR();
+	}
+}
+
+bool Benchmark::parseArgs( int argc, char* argv[], BenchmarkConfig& config )
+{
+	for( int i = 1; i < argc; ++i )
+	{
+		const char* arg = argv[i];
+		const char* value = i + 1 < argc ? argv[ i + 1 ] : nullptr;
+
+		if( strcmp( arg, "--help" ) == 0 || value == nullptr )
+			return false;
+
+		if( strcmp( arg, "--scenario" ) == 0 ) config.scenario = value;
+		else if( strcmp( arg, "--entities" ) == 0 ) config.entities = atoi( value );
+		else if( strcmp( arg, "--depth" ) == 0 ) config.depth = atoi( value );
+		else if( strcmp( arg, "--fanout" ) == 0 ) config.fanout = atoi( value );
+		else if( strcmp( arg, "--behaviours" ) == 0 ) config.behaviours = atoi( value );
+		else if( strcmp( arg, "--frames" ) == 0 ) config.frames = atoi( value );
+		else if( strcmp( arg, "--warmup" ) == 0 ) config.warmup = atoi( value );
+		else if( strcmp( arg, "--dt" ) == 0 ) config.dt = (float) atof( value );
+		else if( strcmp( arg, "--queries" ) == 0 ) config.queries = atoi( value );
+		else if( strcmp( arg, "--budget" ) == 0 ) config.budget = atoi( value );
+		else if( strcmp( arg, "--workers" ) == 0 ) config.workers = atoi( value );
+		else if( strcmp( arg, "--file-kb" ) == 0 ) config.file_kb = atoi( value );
+		else if( strcmp( arg, "--script" ) == 0 ) config.script = value;
+		else if( strcmp( arg, "--output" ) == 0 ) config.output = value;
+		else
+		{
+			fprintf( stderr, "unknown option: %s\n", arg );
+			return false;
+		}
+		++i;
+	}
+
+	if( config.scenario == "transform" )
+	{
+		if( config.depth <= 0 ) config.depth = 4;
+		if( config.fanout <= 0 ) config.fanout = 8;
+		if( config.entities <= 0 ) config.entities = 4681;
+		if( config.behaviours < 0 ) config.behaviours = 1;
+	}
+	else if( config.scenario == "update" )
+	{
+		if( config.depth <= 0 ) config.depth = 1;
+		if( config.fanout <= 0 ) config.fanout = 1;
+		if( config.entities <= 0 ) config.entities = 10000;
+		if( config.behaviours < 0 ) config.behaviours = 4;
+	}
+	else if( config.scenario == "submit" )
+	{
+		if( config.depth <= 0 ) config.depth = 1;
+		if( config.fanout <= 0 ) config.fanout = 1;
+		if( config.entities <= 0 ) config.entities = 10000;
+		if( config.behaviours < 0 ) config.behaviours = 0;
+	}
+	else if( config.scenario == "raycast" )
+	{
+		if( config.depth <= 0 ) config.depth = 1;
+		if( config.fanout <= 0 ) config.fanout = 1;
+		if( config.entities <= 0 ) config.entities = 100000;
+		if( config.behaviours < 0 ) config.behaviours = 0;
+		if( config.queries < 0 ) config.queries = 1000;
+	}
+	else if( config.scenario == "blog" )
+	{
+		if( config.depth <= 0 ) config.depth = 1;
+		if( config.fanout <= 0 ) config.fanout = 1;
+		if( config.entities <= 0 ) config.entities = 1000;
+		if( config.behaviours < 0 ) config.behaviours = 0;
+	}
+	else if( config.scenario == "loader" )
+	{
+		if( config.depth <= 0 ) config.depth = 4;
+		if( config.fanout <= 0 ) config.fanout = 8;
+		if( config.entities <= 0 ) config.entities = 100000;
+		if( config.behaviours < 0 ) config.behaviours = 1;
+	}
+	else if( config.scenario == "broadphase" )
+	{
+		if( config.depth <= 0 ) config.depth = 1;
+		if( config.fanout <= 0 ) config.fanout = 1;
+		if( config.entities <= 0 ) config.entities = 50000;
+		if( config.behaviours < 0 ) config.behaviours = 0;
+	}
+	else if( config.scenario == "animation" )
+	{
+		if( config.depth <= 0 ) config.depth = 1;
+		if( config.fanout <= 0 ) config.fanout = 60;
+		if( config.entities <= 0 ) config.entities = 500;
+		if( config.behaviours < 0 ) config.behaviours = 0;
+	}
+	else if( config.scenario == "log" )
+	{
+		if( config.depth <= 0 ) config.depth = 1;
+		if( config.fanout <= 0 ) config.fanout = 1;
+		if( config.entities <= 0 ) config.entities = 10000;
+		if( config.behaviours < 0 ) config.behaviours = 0;
+		if( config.workers <= 0 ) config.workers = (int) std::max( 1u, std::thread::hardware_concurrency() );
+	}
+	else if( config.scenario == "assets" )
+	{
+		if( config.depth <= 0 ) config.depth = 1;
+		if( config.fanout <= 0 ) config.fanout = 1;
+		if( config.entities <= 0 ) config.entities = 256;
+		if( config.behaviours < 0 ) config.behaviours = 0;
+		if( config.file_kb <= 0 ) config.file_kb = 4096;
+	}
+	else if( config.scenario == "async" )
+	{
+		if( config.depth <= 0 ) config.depth = 1;
+		if( config.fanout <= 0 ) config.fanout = 1;
+		if( config.entities <= 0 ) config.entities = 10000;
+		if( config.behaviours < 0 ) config.behaviours = 0;
+		if( config.file_kb <= 0 ) config.file_kb = 16;
+	}
+#ifdef MAGICAL_BENCHMARK_SCRIPT
+	else if( config.scenario == "coroutines" )
+	{
+		if( config.depth <= 0 ) config.depth = 1;
+		if( config.fanout <= 0 ) config.fanout = 1;
+		if( config.entities <= 0 ) config.entities = 100000;
+		if( config.behaviours < 0 ) config.behaviours = 0;
+	}
+	else if( config.scenario == "calls" )
+	{
+		if( config.depth <= 0 ) config.depth = 1;
+		if( config.fanout <= 0 ) config.fanout = 1;
+		if( config.entities <= 0 ) config.entities = 100000;
+		if( config.behaviours < 0 ) config.behaviours = 0;
+	}
+	else if( config.scenario == "workers" )
+	{
+		if( config.depth <= 0 ) config.depth = 1;
+		if( config.fanout <= 0 ) config.fanout = 1;
+		if( config.entities <= 0 ) config.entities = 10000;
+		if( config.behaviours < 0 ) config.behaviours = 0;
+		if( config.workers <= 0 ) config.workers = (int) std::max( 1u, std::thread::hardware_concurrency() );
+		if( config.script.empty() )
+		{
+			fprintf( stderr, "workers scenario needs --script\n" );
+			return false;
+		}
+	}
+#endif
+	else
+	{
+		fprintf( stderr, "unknown scenario: %s\n", config.scenario.c_str() );
+		return false;
+	}
+
+	if( config.behaviours > MaxBehaviours || config.frames <= 0 || config.warmup < 0 || config.dt <= 0.0f || config.budget <= 0 )
+	{
+		fprintf( stderr, "invalid options\n" );
+		return false;
+	}
+	return true;
+}
+
+void Benchmark::printUsage( void )
+{
+	fprintf( stderr,
+		"usage: benchmark [options]\n"
+		"  --scenario transform|update|submit|coroutines|raycast|calls|workers|blog|log|broadphase|loader|assets|async|animation\n"
+		"  --entities <n>      total entity count, circle count for broadphase, coroutine count for coroutines, calls or lines per frame for calls/workers/blog/log, file count for assets/async, character count for animation\n"
+		"  --depth <n>         hierarchy depth, 1 for a flat scene\n"
+		"  --fanout <n>        children per entity, bones per character for animation (default 60)\n"
+		"  --behaviours <0-8>  behaviours per entity\n"
+		"  --frames <n>        measured frames (default 300)\n"
+		"  --warmup <n>        frames before measuring (default 30)\n"
+		"  --dt <seconds>      simulated frame time (default 1/60)\n"
+		"  --queries <n>       queries per frame for raycast\n"
+		"  --budget <us>       SceneLoader::update budget per frame for loader, callback budget for async (default 2000)\n"
+		"  --workers <n>       lua worker threads for workers, writer threads for log (default hardware threads)\n"
+		"  --file-kb <n>       file size for assets (default 4096, 256 files make 1 GB), largest file size for async (default 16)\n"
+		"  --script <file>     batch script for workers (benchmark/scripts/workers.lua)\n"
+		"  --output <file>     save results as json\n" );
+}
+
+/*
+创建一棵深度为depth的子树，entities用完时提前结束
+*/
+static void createSubtree( const BenchmarkConfig& config, Object* parent, int level, int& remaining )
+{
+	for( int i = 0; i < config.fanout && remaining > 0; ++i )
+	{
+		Ptr<Entity> entity = Entity::create();
+		entity->setPosition( 1.0f, 0, 0 );
+		parent->addChild( entity );
+		-- remaining;
+
+		if( config.scenario == "update" )
+			addBehaviours<Ticker>( entity, config.behaviours );
+
+		if( level + 1 < config.depth )
+			createSubtree( config, entity, level + 1, remaining );
+	}
+}
+
+#ifdef MAGICAL_BENCHMARK_SCRIPT
+/*
+每个协程循环等待0.5到2.5秒的随机时间，绝大多数时间处于休眠，
+平均1.5秒到期一次，dt为1/60时每帧约有count / 90个协程到期；
+每帧只恢复到期的协程，LuaScheduler::update的耗时取决于到期的数量而不是协程总数
+*/
+static void spawnCoroutines( int count )
+{
+	Lua::init();
+	Lua::sharedLuaState().runScript( System::format(
+		"local random = math.random\n"
+		"for i = 1, %d do\n"
+		"	Scheduler.spawn( function()\n"
+		"		local ticks = 0\n"
+		"		while true do\n"
+		"			wait( 0.5 + random() * 2 )\n"
+		"			ticks = ticks + 1\n"
+		"		end\n"
+		"	end )\n"
+		"end\n", count ).c_str() );
+}
+#endif
+
+void Benchmark::buildScene( const BenchmarkConfig& config, BenchmarkResult& result )
+{
+	result.rss_before_kb = readRssKb();
+	result.entities = config.entities;
+	Director::setFixedDeltaTime( config.dt );
+
+	Director::getViewChannel( ViewChannel::Default )->setEnabled( true );
+	Director::getViewChannel( ViewChannel::Default )->setArea( 0, 0, 1, 1 );
+
+	Ptr<Scene> scene = Scene::create();
+	Director::runScene( scene );
+
+	Ptr<Camera> camera = Camera::create( "Main Camera" );
+	camera->bindViewChannel( ViewChannel::Default );
+	camera->setNearClipDistance( 0.3f );
+	camera->setPosition( 0, 0, -5 );
+	camera->lookAt( 0, 0, -10 );
+	camera->setParent( scene );
+
+	if( config.scenario == "blog" )
+	{
+		if( !BinaryLog::open( _s_blog_file ) )
+			return;
+
+		_s_blog_calls = config.entities;
+		Director::addHook( Director::FrameEnd, binaryLogWrites );
+		return;
+	}
+
+	if( config.scenario == "loader" )
+	{
+		startLoader( config, scene.get() );
+		Director::addHook( Director::FrameEnd, loaderSteps );
+		return;
+	}
+
+	if( config.scenario == "broadphase" )
+	{
+		startBroadphase( config );
+		Director::addHook( Director::FrameEnd, broadphaseStep );
+		return;
+	}
+
+	if( config.scenario == "animation" )
+	{
+		startAnimation( config, scene.get() );
+		Director::addHook( Director::FrameEnd, animationSteps );
+		return;
+	}
+
+	if( config.scenario == "log" )
+	{
+		_s_log_lines = config.entities;
+		_s_log_threads = config.workers;
+		Log::setOverflow( Log::Overflow::Block );
+		Director::addHook( Director::FrameEnd, logWrites );
+		return;
+	}
+
+	if( config.scenario == "async" )
+	{
+		if( startAsync( config ) )
+			Director::addHook( Director::FrameEnd, asyncLoads );
+		return;
+	}
+
+	if( config.scenario == "assets" )
+	{
+		if( startAssets( config ) )
+			Director::addHook( Director::FrameEnd, assetsLoads );
+		return;
+	}
+
+#ifdef MAGICAL_BENCHMARK_SCRIPT
+	if( config.scenario == "coroutines" )
+	{
+		spawnCoroutines( config.entities );
+		return;
+	}
+	if( config.scenario == "calls" )
+	{
+		startCalls( config );
+		return;
+	}
+	if( config.scenario == "workers" )
+	{
+		startWorkers( config );
+		return;
+	}
+#endif
+
+	// 顶层节点排成网格，每个顶层节点下是一棵完整的子树
+	int remaining = config.entities;
+	for( int i = 0; remaining > 0; ++i )
+	{
+		Ptr<Entity> root = Entity::create();
+		root->setPosition( ( i % 100 ) * 2.0f, 0, ( i / 100 ) * 2.0f );
+		scene->addChild( root );
+		-- remaining;
+
+		if( config.scenario == "transform" )
+			addBehaviours<Spinner>( root, config.behaviours );
+		else if( config.scenario == "update" )
+			addBehaviours<Ticker>( root, config.behaviours );
+		else if( config.scenario == "raycast" )
+			root->addComponent<Mover>();
+
+		if( config.depth > 1 )
+			createSubtree( config, root, 1, remaining );
+	}
+
+	if( config.scenario == "raycast" )
+	{
+		_s_queries = config.queries;
+		_s_grid_x = 200.0f;
+		_s_grid_z = ( config.entities + 99 ) / 100 * 2.0f;
+		Director::addHook( Director::FrameEnd, raycastQueries );
+	}
+}
+
+void Benchmark::run( const BenchmarkConfig& config, BenchmarkResult& result )
+{
+	for( int i = 0; i < config.warmup; ++i )
+		Director::mainLoop();
+
+	Profiler::setFrameCapacity( (size_t) config.frames );
+	Profiler::setSpikeThreshold( 0 );
+	Profiler::setEnabled( true );
+
+	Vector<double> frame_times;
+	frame_times.reserve( config.frames );
+
+	_s_operations = 0;
+	_s_operations_ns = 0;
+	_s_measuring = true;
+
+	int64_t begin = Profiler::now();
+	for( int i = 0; i < config.frames; ++i )
+	{
+		int64_t frame_begin = Profiler::now();
+		Director::mainLoop();
+		frame_times.push_back( ( Profiler::now() - frame_begin ) / 1000000.0 );
+	}
+	result.total_ms = ( Profiler::now() - begin ) / 1000000.0;
+
+	_s_measuring = false;
+	result.operations = _s_operations;
+	result.operations_ms = _s_operations_ns / 1000000.0;
+
+	// 最后一帧在下一次newFrame时才会收集
+	Profiler::newFrame();
+	Profiler::summarize( result.phases );
+	Profiler::setEnabled( false );
+
+	std::sort( frame_times.begin(), frame_times.end() );
+	result.min_frame_ms = frame_times.front();
+	result.max_frame_ms = frame_times.back();
+	result.median_frame_ms = frame_times[ frame_times.size() / 2 ];
+	result.p95_frame_ms = frame_times[ std::min( frame_times.size() - 1, frame_times.size() * 95 / 100 ) ];
+
+	Vector<Stat*> stats;
+	Stats::getAll( stats );
+	for( auto stat : stats )
+		result.stats.push_back( std::make_pair( stat->getName(), stat->getLastValue() ) );
+
+	result.rss_after_kb = readRssKb();
+	result.peak_rss_kb = readPeakRssKb();
+}
+
+void Benchmark::release( const BenchmarkConfig& config )
+{
+	Director::setFixedDeltaTime( 0.0f );
+
+	if( config.scenario == "raycast" )
+		Director::removeHook( Director::FrameEnd, raycastQueries );
+
+	if( config.scenario == "blog" )
+	{
+		Director::removeHook( Director::FrameEnd, binaryLogWrites );
+		BinaryLog::close();
+		printf( "  blog       %s, %u records dropped\n", _s_blog_file, (unsigned int) BinaryLog::getDroppedCount() );
+	}
+
+	if( config.scenario == "loader" )
+	{
+		Director::removeHook( Director::FrameEnd, loaderSteps );
+		if( _s_operations_ns > 0 )
+			printf( "  loader     %.1f nodes/ms, budget %d us\n", _s_operations * 1000000.0 / _s_operations_ns, config.budget );
+		_s_loader->cancel();
+		_s_loader = nullptr;
+		_s_loader_root = nullptr;
+		_s_loader_scene = nullptr;
+		_s_scene_data = nullptr;
+		for( int i = 0; i < MaxBehaviours; ++i )
+			SceneLoader::unregisterBehaviour( System::format( "Ticker%d", i ).c_str() );
+	}
+
+	if( config.scenario == "broadphase" )
+	{
+		Director::removeHook( Director::FrameEnd, broadphaseStep );
+		delete _s_hash;
+		_s_hash = nullptr;
+		_s_circles.clear();
+		_s_velocities.clear();
+		_s_contacts.clear();
+	}
+
+	if( config.scenario == "animation" )
+	{
+		Director::removeHook( Director::FrameEnd, animationSteps );
+		printf( "  animation  clip with %d tracks built in %.3f ms\n", config.fanout, _s_clip_build_ns / 1000000.0 );
+		_s_animators.clear();
+		_s_clip = nullptr;
+	}
+
+	if( config.scenario == "log" )
+	{
+		Director::removeHook( Director::FrameEnd, logWrites );
+		Log::setOverflow( Log::Overflow::Count );
+	}
+
+	if( config.scenario == "assets" )
+	{
+		Director::removeHook( Director::FrameEnd, assetsLoads );
+		releaseAssets( config );
+	}
+
+	if( config.scenario == "async" )
+	{
+		Director::removeHook( Director::FrameEnd, asyncLoads );
+		releaseAsync();
+	}
+
+#ifdef MAGICAL_BENCHMARK_SCRIPT
+	if( config.scenario == "coroutines" )
+		Lua::delc();
+
+	if( config.scenario == "calls" )
+	{
+		Director::removeHook( Director::FrameEnd, scriptCalls );
+		if( _s_operations > 0 )
+		{
+			printf( "  calls      ns/call: call<double> %.1f, operator() %.1f, baseline %.1f, pinned %.1f\n",
+				(double) _s_call_ns[0] / _s_operations, (double) _s_call_ns[1] / _s_operations,
+				(double) _s_call_ns[2] / _s_operations, (double) _s_call_ns[3] / _s_operations );
+		}
+		delete _s_function;
+		_s_function = nullptr;
+		Lua::delc();
+	}
+
+	if( config.scenario == "workers" )
+	{
+		Director::removeHook( Director::FrameEnd, workerBatches );
+		delete _s_batch;
+		_s_batch = nullptr;
+		Lua::delc();
+	}
+#endif
+}
+
+void Benchmark::print( const BenchmarkConfig& config, const BenchmarkResult& result )
+{
+	double seconds = result.total_ms / 1000.0;
+
+	printf( "scenario %s: %d entities, depth %d, fanout %d, %d behaviours, %d frames\n",
+		config.scenario.c_str(), result.entities, config.depth, config.fanout, config.behaviours, config.frames );
+	if( config.workers > 0 )
+		printf( "  workers    %d threads\n", config.workers );
+	printf( "  frame ms   avg %.3f  min %.3f  median %.3f  p95 %.3f  max %.3f\n",
+		result.total_ms / config.frames, result.min_frame_ms, result.median_frame_ms, result.p95_frame_ms, result.max_frame_ms );
+	printf( "  throughput %.1f frames/s  %.0f entities/s\n",
+		config.frames / seconds, (double) result.entities * config.frames / seconds );
+	printf( "  memory     rss %u KB -> %u KB  peak %u KB\n",
+		(unsigned int) result.rss_before_kb, (unsigned int) result.rss_after_kb, (unsigned int) result.peak_rss_kb );
+	if( result.operations > 0 )
+	{
+		printf( "  operations %lld in %.3f ms  %.0f ops/s  %.3f us/op\n", (long long) result.operations, result.operations_ms,
+			result.operations / ( result.operations_ms / 1000.0 ), result.operations_ms * 1000.0 / result.operations );
+	}
+
+	printf( "  %-32s %8s %12s %12s %12s\n", "phase", "count", "total ms", "avg ms", "max ms" );
+	for( auto& phase : result.phases )
+	{
+		printf( "  %-32s %8u %12.3f %12.4f %12.4f\n",
+			phase.name, (unsigned int) phase.count, phase.total_ms, phase.total_ms / phase.count, phase.max_ms );
+	}
+}
+
+bool Benchmark::writeJson( const char* file, const BenchmarkConfig& config, const BenchmarkResult& result )
+{
+	MAGICAL_ASSERT( file, "should not be nullptr." );
+
+	FILE* fp = fopen( file, "wb" );
+	if( fp == nullptr )
+	{
+		MAGICAL_SET_LAST_ERROR( System::format( "open file(%s) failed!", file ).c_str() );
+		MAGICAL_LOG_LAST_ERROR();
+		return false;
+	}
+
+	double seconds = result.total_ms / 1000.0;
+
+	fprintf( fp, "{\n" );
+	fprintf( fp, "  \"scenario\": \"%s\",\n", config.scenario.c_str() );
+	fprintf( fp, "  \"config\": { \"entities\": %d, \"depth\": %d, \"fanout\": %d, \"behaviours\": %d, \"frames\": %d, \"warmup\": %d, \"workers\": %d, \"dt\": %.6f, \"budget\": %d, \"file_kb\": %d },\n",
+		result.entities, config.depth, config.fanout, config.behaviours, config.frames, config.warmup, config.workers, config.dt, config.budget, config.file_kb );
+	fprintf( fp, "  \"frame_ms\": { \"avg\": %.4f, \"min\": %.4f, \"median\": %.4f, \"p95\": %.4f, \"max\": %.4f },\n",
+		result.total_ms / config.frames, result.min_frame_ms, result.median_frame_ms, result.p95_frame_ms, result.max_frame_ms );
+	fprintf( fp, "  \"throughput\": { \"frames_per_second\": %.2f, \"entities_per_second\": %.0f },\n",
+		config.frames / seconds, (double) result.entities * config.frames / seconds );
+	fprintf( fp, "  \"memory_kb\": { \"rss_before\": %u, \"rss_after\": %u, \"peak_rss\": %u },\n",
+		(unsigned int) result.rss_before_kb, (unsigned int) result.rss_after_kb, (unsigned int) result.peak_rss_kb );
+	fprintf( fp, "  \"operations\": { \"count\": %lld, \"total_ms\": %.4f },\n",
+		(long long) result.operations, result.operations_ms );
+
+	fprintf( fp, "  \"phases\": [" );
+	for( size_t i = 0; i < result.phases.size(); ++i )
+	{
+		const ProfileScopeSummary& phase = result.phases[i];
+		fprintf( fp, "%s\n    { \"name\": \"%s\", \"count\": %u, \"total_ms\": %.4f, \"avg_ms\": %.5f, \"max_ms\": %.4f }",
+			i ? "," : "", phase.name, (unsigned int) phase.count, phase.total_ms, phase.total_ms / phase.count, phase.max_ms );
+	}
+	fprintf( fp, "\n  ],\n" );
+
+	fprintf( fp, "  \"stats\": {" );
+	for( size_t i = 0; i < result.stats.size(); ++i )
+		fprintf( fp, "%s\n    \"%s\": %lld", i ? "," : "", result.stats[i].first, (long long) result.stats[i].second );
+	fprintf( fp, "\n  }\n}\n" );
+
+	fclose( fp );
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __BENCHMARK_H__
+#define __BENCHMARK_H__
+
+#include "magical-engine.h"
+
+USING_NS_MAGICAL;
+
+/*
+无窗口性能测试
+
+构建层级为depth、每个节点fanout个子节点的合成场景，直接驱动Director::mainLoop，
+通过Profiler汇总各阶段耗时，结果保存为JSON以便对比不同版本
+
+场景：
+	transform  顶层节点上的behaviour每帧旋转，整棵子树的变换都需要重新计算
+	update     平铺的场景，每个实体挂多个behaviour，主要开销在update
+	submit     平铺的可见实体，没有behaviour，主要开销在visit和渲染命令提交
+	coroutines 定义MAGICAL_BENCHMARK_SCRIPT时可用，entities个休眠中的脚本协程，主要开销在LuaScheduler::update
+	raycast    平铺的实体来回移动，每帧queries次射线查询，测试包围盒树的刷新(Scene::updateBounds)和查询
+	calls      定义MAGICAL_BENCHMARK_SCRIPT时可用，每帧从C++调用entities次脚本函数，
+	           分别测量LuaFunction::call<double>和返回LuaObject的operator()
+	workers    定义MAGICAL_BENCHMARK_SCRIPT时可用，每帧由workers个LuaWorkers线程执行entities次script中的update，
+	           改变workers对比多核的扩展性
+	blog       每帧写entities条MAGICAL_BLOG，测量热路径每次调用的耗时，文件写入benchmark.blog（blog-decode可解码）
+	loader     用SceneFile保存的entities个节点（层级同transform）由SceneLoader每帧在budget微秒内实例化，测量每毫秒实例化的节点数
+	broadphase entities个运动的圆，每帧更新SpatialHash2并求出所有相交的圆对，operations为步数
+	animation  entities个角色（默认500个）各有fanout根骨骼（默认60根），共用一个AnimationClip，
+	           每帧由各自的Animator采样并写入骨骼，operations为采样的骨骼数
+	log        每帧由workers个线程共写entities行文本日志并等待写入文件，测量Log的端到端吞吐
+	assets     entities个file-kb大小的文件（默认256个4 MB，共1 GB），每帧用Assets::loadFile全部加载、逐页读取一遍再释放，
+	           映射和读取两种方式逐帧交替，对比加载耗时和常驻内存；每帧加载全部文件，帧数应取小值（如--frames 8 --warmup 2）
+	async      entities个小文件（默认10000个，不超过file-kb）由Assets::loadFileAsync反复全部加载，主循环照常运行，
+	           检查回调的线程、次数和数据，测量回调吞吐、帧时间和加载延迟；场景中没有其他实体，一帧只有几微秒，
+	           需要较多的帧才能覆盖几轮加载（如--frames 20000）
+
+带查询的场景在FrameEnd钩子中执行查询，operations为测量期间的查询次数
+各场景的帧间隔固定为dt（Director::setFixedDeltaTime），依赖时间的结果（如协程的到期数量）与机器速度无关
+*/
+struct BenchmarkConfig
+{
+	std::string scenario = "transform";
+	int entities = 0;
+	int depth = 0;
+	int fanout = 0;
+	int behaviours = -1;
+	int frames = 300;
+	int warmup = 30;
+	int queries = -1;
+	int workers = 0;
+	int budget = 2000;
+	int file_kb = 0;
+	float dt = 1.0f / 60.0f;
+	std::string script;
+	std::string output;
+};
+
+struct BenchmarkResult
+{
+	int entities = 0;
+	double total_ms = 0.0;
+	double min_frame_ms = 0.0;
+	double max_frame_ms = 0.0;
+	double median_frame_ms = 0.0;
+	double p95_frame_ms = 0.0;
+	int64_t operations = 0;
+	double operations_ms = 0.0;
+	size_t rss_before_kb = 0;
+	size_t rss_after_kb = 0;
+	size_t peak_rss_kb = 0;
+	Vector<ProfileScopeSummary> phases;
+	Vector<std::pair<const char*, int64_t>> stats;
+};
+
+class Benchmark
+{
+public:
+	enum : int { MaxBehaviours = 8 };
+
+public:
+	// 解析命令行，未指定的参数按场景取默认值
+	static bool parseArgs( int argc, char* argv[], BenchmarkConfig& config );
+	static void printUsage( void );
+
+public:
+	static void buildScene( const BenchmarkConfig& config, BenchmarkResult& result );
+	static void run( const BenchmarkConfig& config, BenchmarkResult& result );
+	// 释放场景之外为测试创建的资源，在Application::delc之前调用
+	static void release( const BenchmarkConfig& config );
+	static void print( const BenchmarkConfig& config, const BenchmarkResult& result );
+	static bool writeJson( const char* file, const BenchmarkConfig& config, const BenchmarkResult& result );
+};
+
+#endif //__BENCHMARK_H__
\ No newline at end of file
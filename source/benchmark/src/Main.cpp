@@ -0,0 +1,59 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "Benchmark.h"
+
+/*
+Linux上使用仓库根目录的CMakeLists.txt构建：
+cmake -S . -B build && cmake --build build && ./build/benchmark --scenario transform
+MAGICAL_BUILD_SCRIPT打开时（默认）一起构建脚本层并定义MAGICAL_BENCHMARK_SCRIPT，可以运行coroutines场景
+*/
+int main( int argc, char* argv[] )
+{
+	BenchmarkConfig config;
+	if( !Benchmark::parseArgs( argc, argv, config ) )
+	{
+		Benchmark::printUsage();
+		return -1;
+	}
+
+	Application::init();
+	MAGICAL_RETURN_EXP_IF_ERROR( -1 );
+
+	BenchmarkResult result;
+	Benchmark::buildScene( config, result );
+	MAGICAL_RETURN_EXP_IF_ERROR( -1 );
+
+	Benchmark::run( config, result );
+	MAGICAL_RETURN_EXP_IF_ERROR( -1 );
+
+	Benchmark::print( config, result );
+	if( !config.output.empty() && !Benchmark::writeJson( config.output.c_str(), config, result ) )
+		return -1;
+
+	Benchmark::release( config );
+	Application::delc();
+	MAGICAL_RETURN_EXP_IF_ERROR( -1 );
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "magical-engine.h"
+#include "LuaState.h"
+#include "BindMath.h"
+
+/*
+运行benchmark/scripts下的脚本性能测试：
+script-benchmark <script.lua> [args...]
+
+脚本中的arg与lua解释器相同；BindMath绑定的数学类型同时作为模块toluamath，
+在同一个进程中对比tolua userdata、纯Lua table（和LuaJIT下的FFI cdata）
+*/
+int main( int argc, char* argv[] )
+{
+	if( argc < 2 )
+	{
+		printf( "usage: script-benchmark <script.lua> [args...]\n" );
+		return -1;
+	}
+
+	Application::init();
+	MAGICAL_RETURN_EXP_IF_ERROR( -1 );
+
+	LuaState* L = new LuaState();
+	L->openLibs();
+
+	lua_State* ls = L->cPtr();
+	int top = lua_gettop( ls );
+	luaopen_magical_math( ls );
+	lua_settop( ls, top );
+
+	// BindMath注册的全局类型同时作为require( "toluamath" )的结果
+	static const char* types[] = { "Vector3", "Quaternion", "Matrix4" };
+	lua_getglobal( ls, "package" );
+	lua_getfield( ls, -1, "loaded" );
+	lua_createtable( ls, 0, 3 );
+	for( const char* name : types )
+	{
+		lua_getglobal( ls, name );
+		lua_setfield( ls, -2, name );
+	}
+	lua_setfield( ls, -2, "toluamath" );
+	lua_settop( ls, top );
+
+	lua_createtable( ls, argc - 1, 0 );
+	for( int i = 1; i < argc; ++i )
+	{
+		lua_pushstring( ls, argv[i] );
+		lua_rawseti( ls, -2, i - 1 );
+	}
+	lua_setglobal( ls, "arg" );
+
+	LuaCode code = L->runScriptFile( argv[1] );
+
+	L->release();
+	Application::delc();
+
+	return code == LuaCode::OK ? 0 : -1;
+}
\ No newline at end of file
@@ -0,0 +1,265 @@
+-- LuaJIT FFI下的数学类型，内存布局与引擎的Vector3、Quaternion、Matrix4x4一致
+-- 引擎定义MAGICAL_USING_LUAJIT时由LuaFFI::open加载，C++与脚本之间直接拷贝内存
+-- 通过require( "ffimath" )使用，不替换tolua注册的全局Vector3、Quaternion、Matrix4，
+-- 类型名与tolua绑定一致；传给tolua绑定的函数之前用toEngine()转换为userdata
+
+local ffi = require( "ffi" )
+local sqrt = math.sqrt
+local format = string.format
+
+ffi.cdef[[
+typedef struct { float x, y, z; } Vector3;
+typedef struct { float x, y, z, w; } Quaternion;
+typedef struct {
+	union {
+		float m[16];
+		struct {
+			float m11, m12, m13, m14;
+			float m21, m22, m23, m24;
+			float m31, m32, m33, m34;
+			float m41, m42, m43, m44;
+		};
+	};
+} Matrix4x4;
+]]
+
+local Vector3 = ffi.typeof( "Vector3" )
+local Quaternion = ffi.typeof( "Quaternion" )
+local Matrix4 = ffi.typeof( "Matrix4x4" )
+local istype = ffi.istype
+
+-- LuaFFI::open注册的转换函数，在引擎外单独运行时为nil
+local engine = package.loaded[ "ffimath.engine" ]
+
+local function toEngine( convert, value )
+	assert( engine, "toEngine() needs the engine bindings" )
+	return engine[ convert ]( value )
+end
+
+local vector3 = {}
+
+-- 复制为tolua的Vector3 userdata，传给tolua绑定的函数
+function vector3:toEngine()
+	return toEngine( "vector3", self )
+end
+
+function vector3:set( x, y, z )
+	self.x, self.y, self.z = x, y, z
+	return self
+end
+
+function vector3:dot( v )
+	return self.x * v.x + self.y * v.y + self.z * v.z
+end
+
+function vector3:cross( v )
+	return Vector3( self.y * v.z - self.z * v.y, self.z * v.x - self.x * v.z, self.x * v.y - self.y * v.x )
+end
+
+function vector3:lengthSq()
+	return self.x * self.x + self.y * self.y + self.z * self.z
+end
+
+function vector3:length()
+	return sqrt( self.x * self.x + self.y * self.y + self.z * self.z )
+end
+
+function vector3:normalize()
+	local n = sqrt( self.x * self.x + self.y * self.y + self.z * self.z )
+	if n > 1e-6 then
+		n = 1 / n
+		self.x, self.y, self.z = self.x * n, self.y * n, self.z * n
+	end
+	return self
+end
+
+function vector3:lerp( v, t )
+	return Vector3( self.x + ( v.x - self.x ) * t, self.y + ( v.y - self.y ) * t, self.z + ( v.z - self.z ) * t )
+end
+
+function vector3:transform( m )
+	local x, y, z = self.x, self.y, self.z
+	return Vector3(
+		x * m.m11 + y * m.m21 + z * m.m31 + m.m41,
+		x * m.m12 + y * m.m22 + z * m.m32 + m.m42,
+		x * m.m13 + y * m.m23 + z * m.m33 + m.m43 )
+end
+
+ffi.metatype( Vector3, {
+	__index = vector3,
+	__add = function( a, b )
+		if type( b ) == "number" then return Vector3( a.x + b, a.y + b, a.z + b ) end
+		return Vector3( a.x + b.x, a.y + b.y, a.z + b.z )
+	end,
+	__sub = function( a, b )
+		if type( b ) == "number" then return Vector3( a.x - b, a.y - b, a.z - b ) end
+		return Vector3( a.x - b.x, a.y - b.y, a.z - b.z )
+	end,
+	__mul = function( a, b )
+		if type( a ) == "number" then return Vector3( b.x * a, b.y * a, b.z * a ) end
+		if type( b ) == "number" then return Vector3( a.x * b, a.y * b, a.z * b ) end
+		if istype( Matrix4, b ) then return a:transform( b ) end
+		return Vector3( a.x * b.x, a.y * b.y, a.z * b.z )
+	end,
+	__div = function( a, b )
+		if type( b ) == "number" then return Vector3( a.x / b, a.y / b, a.z / b ) end
+		return Vector3( a.x / b.x, a.y / b.y, a.z / b.z )
+	end,
+	__unm = function( a )
+		return Vector3( -a.x, -a.y, -a.z )
+	end,
+	__eq = function( a, b )
+		return istype( Vector3, a ) and istype( Vector3, b ) and a.x == b.x and a.y == b.y and a.z == b.z
+	end,
+	__tostring = function( a )
+		return format( "Vector3(%g, %g, %g)", a.x, a.y, a.z )
+	end,
+} )
+
+local quaternion = {}
+
+function quaternion:toEngine()
+	return toEngine( "quaternion", self )
+end
+
+function quaternion:set( x, y, z, w )
+	self.x, self.y, self.z, self.w = x, y, z, w
+	return self
+end
+
+function quaternion:identity()
+	self.x, self.y, self.z, self.w = 0, 0, 0, 1
+	return self
+end
+
+function quaternion:dot( q )
+	return self.x * q.x + self.y * q.y + self.z * q.z + self.w * q.w
+end
+
+function quaternion:length()
+	return sqrt( self.x * self.x + self.y * self.y + self.z * self.z + self.w * self.w )
+end
+
+function quaternion:normalize()
+	local n = sqrt( self.x * self.x + self.y * self.y + self.z * self.z + self.w * self.w )
+	if n > 1e-6 then
+		n = 1 / n
+		self.x, self.y, self.z, self.w = self.x * n, self.y * n, self.z * n, self.w * n
+	end
+	return self
+end
+
+function quaternion:conjugate()
+	return Quaternion( -self.x, -self.y, -self.z, self.w )
+end
+
+-- 与Quaternion::mulVector3相同
+function quaternion:rotate( v )
+	local qx, qy, qz, w2 = self.x, self.y, self.z, self.w * 2
+	local ux, uy, uz = qy * v.z - qz * v.y, qz * v.x - qx * v.z, qx * v.y - qy * v.x
+	local uux, uuy, uuz = qy * uz - qz * uy, qz * ux - qx * uz, qx * uy - qy * ux
+	return Vector3( v.x + ux * w2 + uux * 2, v.y + uy * w2 + uuy * 2, v.z + uz * w2 + uuz * 2 )
+end
+
+ffi.metatype( Quaternion, {
+	__index = quaternion,
+	__add = function( a, b )
+		return Quaternion( a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w )
+	end,
+	__sub = function( a, b )
+		return Quaternion( a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w )
+	end,
+	-- 与Quaternion::mul相同，变换顺序由左到右
+	__mul = function( a, b )
+		if type( b ) == "number" then return Quaternion( a.x * b, a.y * b, a.z * b, a.w * b ) end
+		if istype( Vector3, b ) then return a:rotate( b ) end
+		return Quaternion(
+			a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+			a.w * b.y + a.y * b.w + a.z * b.x - a.x * b.z,
+			a.w * b.z + a.z * b.w + a.x * b.y - a.y * b.x,
+			a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z )
+	end,
+	__unm = function( a )
+		return Quaternion( -a.x, -a.y, -a.z, -a.w )
+	end,
+	__eq = function( a, b )
+		return istype( Quaternion, a ) and istype( Quaternion, b ) and a.x == b.x and a.y == b.y and a.z == b.z and a.w == b.w
+	end,
+	__tostring = function( a )
+		return format( "Quaternion(%g, %g, %g, %g)", a.x, a.y, a.z, a.w )
+	end,
+} )
+
+local matrix4 = {}
+
+function matrix4:toEngine()
+	return toEngine( "matrix4", self )
+end
+
+function matrix4:identity()
+	local m = self.m
+	for i = 0, 15 do m[i] = 0 end
+	m[0], m[5], m[10], m[15] = 1, 1, 1, 1
+	return self
+end
+
+function matrix4:transpose()
+	local m = self.m
+	for r = 0, 3 do
+		for c = r + 1, 3 do
+			m[r * 4 + c], m[c * 4 + r] = m[c * 4 + r], m[r * 4 + c]
+		end
+	end
+	return self
+end
+
+function matrix4:setTranslation( x, y, z )
+	local m = self.m
+	m[12], m[13], m[14] = x, y, z
+	return self
+end
+
+-- 与Matrix4x4::mul相同，行主序；out可以是self，不能是b
+function matrix4:mul( b, out )
+	out = out or Matrix4()
+	local x, y, o = self.m, b.m, out.m
+	for r = 0, 12, 4 do
+		local a1, a2, a3, a4 = x[r], x[r + 1], x[r + 2], x[r + 3]
+		for c = 0, 3 do
+			o[r + c] = a1 * y[c] + a2 * y[c + 4] + a3 * y[c + 8] + a4 * y[c + 12]
+		end
+	end
+	return out
+end
+
+ffi.metatype( Matrix4, {
+	__index = matrix4,
+	__mul = function( a, b )
+		if type( b ) == "number" then
+			local out = Matrix4()
+			for i = 0, 15 do out.m[i] = a.m[i] * b end
+			return out
+		end
+		return a:mul( b )
+	end,
+	__eq = function( a, b )
+		if not ( istype( Matrix4, a ) and istype( Matrix4, b ) ) then return false end
+		for i = 0, 15 do
+			if a.m[i] ~= b.m[i] then return false end
+		end
+		return true
+	end,
+	__tostring = function( a )
+		local m = a.m
+		return format( "Matrix4(%g, %g, %g, %g, %g, %g, %g, %g, %g, %g, %g, %g, %g, %g, %g, %g)",
+			m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7], m[8], m[9], m[10], m[11], m[12], m[13], m[14], m[15] )
+	end,
+} )
+
+return {
+	Vector3 = Vector3,
+	Quaternion = Quaternion,
+	Matrix4 = Matrix4,
+	-- tolua的Vector3、Quaternion、Matrix4 userdata复制为对应的cdata
+	fromEngine = engine and engine.fromEngine,
+}
\ No newline at end of file
@@ -28,8 +28,26 @@ SOFTWARE.
 #include "Common.h"
 #include "Data.h"
 
+#include <functional>
+
 NAMESPACE_MAGICAL
 
+/*
+异步加载统计，延迟为从提交请求到回调执行的时间（微秒），取最近完成的请求计算
+*/
+struct AssetsLoadStats
+{
+	size_t queued = 0;
+	size_t loading = 0;
+	size_t completed = 0;
+	size_t cancelled = 0;
+	size_t failed = 0;
+	double bytes_per_second = 0.0;
+	int64_t latency_p50 = 0;
+	int64_t latency_p95 = 0;
+	int64_t latency_p99 = 0;
+};
+
 class Assets
 {
 public:
@@ -43,6 +61,32 @@ public:
 	static std::string getAbsFilename( const char* file );
 	static bool isFileExist( const char* file );
 	static Ptr<Data> loadFile( const char* file );
+	static Ptr<Data> tryLoadFile( const char* file );
+
+public:
+	/*
+	不小于该大小的文件以内存映射方式加载，不支持映射的平台忽略此设置
+	*/
+	static void setMapThreshold( size_t size );
+	static size_t getMapThreshold( void );
+
+public:
+	/*
+	异步加载
+
+	请求按优先级（值大的优先）由后台I/O线程执行，同优先级按提交顺序，
+	回调总是在主线程的Director::mainLoop开始时执行，加载失败时data为nullptr；
+	每帧执行回调的时间不超过预算（至少执行一个），剩余的顺延到下一帧
+	*/
+	typedef std::function< void( const Ptr<Data>& data ) > LoadCallback;
+
+	static uint32_t loadFileAsync( const char* file, const LoadCallback& callback, int priority = 0 );
+	static bool cancelLoad( uint32_t id );
+	static void dispatchLoadCallbacks( void );
+	static void stopAsyncLoads( void );
+	static void setAsyncWorkerCount( size_t count );
+	static void setAsyncCallbackBudget( int64_t microseconds );
+	static AssetsLoadStats getAsyncLoadStats( void );
 };
 
 NAMESPACE_END
@@ -0,0 +1,309 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "Assets.h"
+#include "magical-math.h"
+#include "Utils.h"
+#include "Vector.h"
+#include "Profiler.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <unordered_map>
+
+NAMESPACE_MAGICAL
+
+/*
+请求在各队列间转移时只有一个持有者：等待队列 -> 工作线程 -> 完成队列 -> 主线程，
+除data外的状态都在_mutex下读写，data只由工作线程在请求离开等待队列后写入，
+主线程从完成队列取出后再读取，因此Data的非原子引用计数不会被并发修改
+*/
+struct LoadRequest
+{
+	uint32_t id;
+	int priority;
+	uint64_t sequence;
+	string file;
+	Assets::LoadCallback callback;
+	Ptr<Data> data;
+	int64_t submit_time;
+	bool cancelled;
+};
+
+struct LoadRecord
+{
+	int64_t time;
+	int64_t latency;
+	size_t bytes;
+};
+
+enum : size_t
+{
+	DefaultWorkerCount = 2,
+	RecordCount = 256,
+};
+
+static std::mutex _mutex;
+static std::condition_variable _condition;
+static Vector<std::thread> _workers;
+static Vector<LoadRequest*> _pending;
+static std::deque<LoadRequest*> _completed;
+static std::unordered_map<uint32_t, LoadRequest*> _requests;
+static size_t _worker_count = DefaultWorkerCount;
+static size_t _loading = 0;
+static bool _stopping = false;
+static uint32_t _next_id = 0;
+static uint64_t _next_sequence = 0;
+static int64_t _callback_budget = 2000;
+
+// 以下统计只在主线程读写
+static LoadRecord _records[ RecordCount ];
+static size_t _record_index = 0;
+static size_t _record_count = 0;
+static size_t _completed_count = 0;
+static size_t _cancelled_count = 0;
+static size_t _failed_count = 0;
+
+/*
+等待队列为二叉堆，堆顶为优先级最高、最先提交的请求
+*/
+static bool lowerPriority( const LoadRequest* a, const LoadRequest* b )
+{
+	return a->priority != b->priority ? a->priority < b->priority : a->sequence > b->sequence;
+}
+
+static void workerLoop( void )
+{
+	Profiler::setThreadName( "Assets::worker" );
+
+	std::unique_lock<std::mutex> lock( _mutex );
+	while( true )
+	{
+		_condition.wait( lock, []{ return _stopping || !_pending.empty(); } );
+		if( _stopping )
+			return;
+
+		std::pop_heap( _pending.begin(), _pending.end(), lowerPriority );
+		LoadRequest* request = _pending.back();
+		_pending.pop_back();
+
+		if( request->cancelled )
+		{
+			delete request;
+			continue;
+		}
+
+		++ _loading;
+		lock.unlock();
+		{
+			MAGICAL_PROFILE_SCOPE( "Assets::tryLoadFile" );
+			request->data = Assets::tryLoadFile( request->file.c_str() );
+		}
+		lock.lock();
+		-- _loading;
+
+		_completed.push_back( request );
+	}
+}
+
+static void startWorkers( void )
+{
+	_stopping = false;
+	for( size_t i = 0; i < _worker_count; ++i )
+	{
+		_workers.push_back( std::thread( workerLoop ) );
+	}
+}
+
+static void record( const LoadRequest* request, int64_t now )
+{
+	LoadRecord& r = _records[ _record_index ];
+	r.time = now;
+	r.latency = now - request->submit_time;
+	r.bytes = request->data ? request->data->size() : 0;
+	_record_index = ( _record_index + 1 ) % RecordCount;
+	_record_count = Math::min( _record_count + 1, (size_t) RecordCount );
+}
+
+uint32_t Assets::loadFileAsync( const char* file, const LoadCallback& callback, int priority )
+{
+	MAGICAL_ASSERT( file, "should not be nullptr." );
+
+	LoadRequest* request = new LoadRequest();
+	request->priority = priority;
+	request->file = file;
+	request->callback = callback;
+	request->submit_time = Time::currentMicroseconds();
+	request->cancelled = false;
+
+	std::lock_guard<std::mutex> lock( _mutex );
+	if( _workers.empty() )
+		startWorkers();
+
+	// 0保留为无效id
+	if( ++ _next_id == 0 )
+		++ _next_id;
+	request->id = _next_id;
+	request->sequence = _next_sequence ++;
+
+	_requests[ request->id ] = request;
+	_pending.push_back( request );
+	std::push_heap( _pending.begin(), _pending.end(), lowerPriority );
+	_condition.notify_one();
+	return request->id;
+}
+
+/*
+等待中的请求不会再被加载，正在加载或已完成的请求不会再执行回调
+*/
+bool Assets::cancelLoad( uint32_t id )
+{
+	std::lock_guard<std::mutex> lock( _mutex );
+	auto itr = _requests.find( id );
+	if( itr == _requests.end() )
+		return false;
+
+	itr->second->cancelled = true;
+	_requests.erase( itr );
+	++ _cancelled_count;
+	return true;
+}
+
+void Assets::dispatchLoadCallbacks( void )
+{
+	int64_t start = Time::currentMicroseconds();
+	while( true )
+	{
+		LoadRequest* request;
+		{
+			std::lock_guard<std::mutex> lock( _mutex );
+			if( _completed.empty() )
+				break;
+
+			request = _completed.front();
+			_completed.pop_front();
+			if( !request->cancelled )
+				_requests.erase( request->id );
+		}
+
+		int64_t now = Time::currentMicroseconds();
+		if( !request->cancelled )
+		{
+			record( request, now );
+			++ _completed_count;
+			if( !request->data )
+				++ _failed_count;
+
+			if( request->callback )
+				request->callback( request->data );
+		}
+		delete request;
+
+		if( Time::currentMicroseconds() - start >= _callback_budget )
+			break;
+	}
+}
+
+/*
+等待线程退出，未加载与未回调的请求全部丢弃
+*/
+void Assets::stopAsyncLoads( void )
+{
+	{
+		std::lock_guard<std::mutex> lock( _mutex );
+		_stopping = true;
+	}
+	_condition.notify_all();
+
+	for( auto& worker : _workers )
+	{
+		worker.join();
+	}
+	_workers.clear();
+
+	for( auto request : _pending )
+	{
+		delete request;
+	}
+	for( auto request : _completed )
+	{
+		delete request;
+	}
+	_pending.clear();
+	_completed.clear();
+	_requests.clear();
+}
+
+/*
+线程数在下一次启动工作线程时生效
+*/
+void Assets::setAsyncWorkerCount( size_t count )
+{
+	MAGICAL_ASSERT( count > 0, "count should > 0" );
+	_worker_count = count;
+}
+
+void Assets::setAsyncCallbackBudget( int64_t microseconds )
+{
+	_callback_budget = microseconds;
+}
+
+AssetsLoadStats Assets::getAsyncLoadStats( void )
+{
+	AssetsLoadStats stats;
+	{
+		std::lock_guard<std::mutex> lock( _mutex );
+		stats.queued = _pending.size();
+		stats.loading = _loading;
+	}
+
+	stats.completed = _completed_count;
+	stats.cancelled = _cancelled_count;
+	stats.failed = _failed_count;
+	if( _record_count == 0 )
+		return stats;
+
+	int64_t latencies[ RecordCount ];
+	int64_t oldest = _records[0].time;
+	int64_t newest = _records[0].time;
+	size_t bytes = 0;
+	for( size_t i = 0; i < _record_count; ++i )
+	{
+		latencies[i] = _records[i].latency;
+		oldest = Math::min( oldest, _records[i].time );
+		newest = Math::max( newest, _records[i].time );
+		bytes += _records[i].bytes;
+	}
+
+	// 吞吐量取最近记录覆盖的时间段，记录都在同一帧内完成时按1毫秒计
+	stats.bytes_per_second = bytes * 1000000.0 / Math::max( newest - oldest, (int64_t) 1000 );
+
+	std::sort( latencies, latencies + _record_count );
+	stats.latency_p50 = latencies[ ( _record_count - 1 ) * 50 / 100 ];
+	stats.latency_p95 = latencies[ ( _record_count - 1 ) * 95 / 100 ];
+	stats.latency_p99 = latencies[ ( _record_count - 1 ) * 99 / 100 ];
+	return stats;
+}
+
+NAMESPACE_END
\ No newline at end of file
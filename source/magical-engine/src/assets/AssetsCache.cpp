@@ -0,0 +1,173 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "AssetsCache.h"
+#include "Assets.h"
+#include "AssetsPack.h"
+#include "List.h"
+#include "Map.h"
+
+NAMESPACE_MAGICAL
+
+/*
+缓存条目持有一次Data的引用，引用计数为1时说明已没有外部持有者
+*/
+struct CacheEntry
+{
+	string key;
+	Data* data;
+	size_t size;
+};
+
+static List<CacheEntry> _entries;
+static UnorderedMap<string, List<CacheEntry>::iterator> _index;
+static size_t _budget = AssetsCache::DefaultBudget;
+static size_t _bytes = 0;
+static size_t _hits = 0;
+static size_t _misses = 0;
+static size_t _evictions = 0;
+
+static List<CacheEntry>::iterator eraseEntry( List<CacheEntry>::iterator itr )
+{
+	_bytes -= itr->size;
+	_index.erase( itr->key );
+	itr->data->release();
+	return _entries.erase( itr );
+}
+
+Ptr<Data> AssetsCache::loadFile( const char* file )
+{
+	MAGICAL_ASSERT( file, "should not be nullptr." );
+
+	string key = AssetsPack::normalize( file );
+	auto itr = _index.find( key );
+	if( itr != _index.end() )
+	{
+		// 命中的条目移到链表头部，链表尾部即为最久未使用的条目
+		++ _hits;
+		_entries.splice( _entries.begin(), _entries, itr->second );
+		return Ptr<Data>( itr->second->data );
+	}
+
+	++ _misses;
+	Ptr<Data> data = Assets::loadFile( file );
+	if( !data )
+		return nullptr;
+
+	CacheEntry entry;
+	entry.key = key;
+	entry.data = data.get();
+	entry.size = data->size();
+	entry.data->retain();
+
+	_entries.push_front( entry );
+	_index[ key ] = _entries.begin();
+	_bytes += entry.size;
+
+	trim();
+	return data;
+}
+
+bool AssetsCache::contains( const char* file )
+{
+	MAGICAL_ASSERT( file, "should not be nullptr." );
+
+	return _index.find( AssetsPack::normalize( file ) ) != _index.end();
+}
+
+void AssetsCache::remove( const char* file )
+{
+	MAGICAL_ASSERT( file, "should not be nullptr." );
+
+	auto itr = _index.find( AssetsPack::normalize( file ) );
+	if( itr != _index.end() )
+	{
+		eraseEntry( itr->second );
+	}
+}
+
+/*
+清空缓存，外部仍持有的Data不受影响
+*/
+void AssetsCache::clear( void )
+{
+	for( auto& entry : _entries )
+	{
+		entry.data->release();
+	}
+	_entries.clear();
+	_index.clear();
+	_bytes = 0;
+}
+
+/*
+从最久未使用的一端开始淘汰没有外部引用的条目，直到占用不超过预算
+*/
+void AssetsCache::trim( void )
+{
+	if( _bytes <= _budget )
+		return;
+
+	auto itr = _entries.end();
+	while( itr != _entries.begin() && _bytes > _budget )
+	{
+		-- itr;
+		if( itr->data->retainCount() == 1 )
+		{
+			itr = eraseEntry( itr );
+			++ _evictions;
+		}
+	}
+}
+
+void AssetsCache::setBudget( size_t bytes )
+{
+	_budget = bytes;
+	trim();
+}
+
+size_t AssetsCache::getBudget( void )
+{
+	return _budget;
+}
+
+AssetsCacheStats AssetsCache::getStats( void )
+{
+	AssetsCacheStats stats;
+	stats.hits = _hits;
+	stats.misses = _misses;
+	stats.evictions = _evictions;
+	stats.count = _entries.size();
+	stats.bytes = _bytes;
+	stats.budget = _budget;
+	return stats;
+}
+
+void AssetsCache::resetStats( void )
+{
+	_hits = 0;
+	_misses = 0;
+	_evictions = 0;
+}
+
+NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,85 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __ASSETS_CACHE_H__
+#define __ASSETS_CACHE_H__
+
+#include "magical-macros.h"
+#include "Common.h"
+#include "Data.h"
+
+NAMESPACE_MAGICAL
+
+/*
+资源缓存统计，bytes为当前缓存占用的字节数
+*/
+struct AssetsCacheStats
+{
+	size_t hits = 0;
+	size_t misses = 0;
+	size_t evictions = 0;
+	size_t count = 0;
+	size_t bytes = 0;
+	size_t budget = 0;
+};
+
+/*
+资源缓存
+
+以规范化后的路径为键缓存Assets::loadFile的结果，同一文件的多次请求共享同一个Data，
+调用者只能读取返回的Data，需要修改时应自行拷贝；
+总大小超过预算时按最近最少使用的顺序淘汰，仍被外部持有的条目不会被淘汰，
+因此占用可能暂时超出预算，Director每帧会调用trim回收已不再被引用的条目
+
+引用计数不是线程安全的，只能在主线程使用；
+改变搜索路径时缓存会被清空，挂载资源包后如需让包内文件生效应调用clear
+
+目前着色器源码经过这里；Lua脚本（runScriptFile与require）不经过这里，
+LuaWorkers的线程也会加载脚本，而且脚本只在编译时需要源码，编译结果由LuaBytecodeCache按内容缓存，
+再缓存源码只会多占内存
+*/
+class AssetsCache
+{
+public:
+	enum : size_t
+	{
+		DefaultBudget = 32 * 1024 * 1024,
+	};
+
+public:
+	static Ptr<Data> loadFile( const char* file );
+	static bool contains( const char* file );
+	static void remove( const char* file );
+	static void clear( void );
+	static void trim( void );
+
+public:
+	static void setBudget( size_t bytes );
+	static size_t getBudget( void );
+	static AssetsCacheStats getStats( void );
+	static void resetStats( void );
+};
+
+NAMESPACE_END
+
+#endif //__ASSETS_CACHE_H__
\ No newline at end of file
@@ -0,0 +1,355 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "AssetsPack.h"
+#include "Assets.h"
+#include "Utils.h"
+#include "LZ4.h"
+#include <string.h>
+#include <mutex>
+#include <condition_variable>
+
+NAMESPACE_MAGICAL
+
+static Vector< Ptr<AssetsPack> > _mounted_packs;
+static std::mutex _mounted_mutex;
+static std::condition_variable _mounted_loaded;
+
+AssetsPack::AssetsPack( void )
+{
+
+}
+
+AssetsPack::~AssetsPack( void )
+{
+
+}
+
+Ptr<AssetsPack> AssetsPack::create( void )
+{
+	AssetsPack* ret = new AssetsPack();
+	MAGICAL_ASSERT( ret, "new AssetsPack() failed" );
+	return Ptr<AssetsPack>( Ptrctor<AssetsPack>( ret ) );
+}
+
+Ptr<AssetsPack> AssetsPack::create( const char* file )
+{
+	AssetsPack* ret = new AssetsPack();
+	MAGICAL_ASSERT( ret, "new AssetsPack() failed" );
+	ret->open( file );
+	return Ptr<AssetsPack>( Ptrctor<AssetsPack>( ret ) );
+}
+
+bool AssetsPack::open( const char* file )
+{
+	MAGICAL_ASSERT( file, "should not be nullptr." );
+
+	Ptr<Data> data = Assets::loadFile( file );
+	if( !data )
+		return false;
+
+	// Assets::loadFile返回的数据结尾多出一个0，不属于包的内容
+	if( !open( data, data->size() - 1 ) )
+	{
+		MAGICAL_SET_LAST_ERROR( System::format<512>( "open assets pack failed! file(%s).", file ).c_str() );
+		MAGICAL_LOG_LAST_ERROR();
+		return false;
+	}
+	return true;
+}
+
+bool AssetsPack::open( const Ptr<Data>& data )
+{
+	MAGICAL_ASSERT( data, "should not be nullptr." );
+	return open( data, data->size() );
+}
+
+/*
+size为包的实际大小，所有偏移和长度都以它为界；
+压缩条目解压后的大小不能超过LZ4的最大展开比例，损坏的目录不会导致超大的分配
+*/
+bool AssetsPack::open( const Ptr<Data>& data, size_t size )
+{
+	MAGICAL_ASSERT( data && size <= data->size(), "Invalid data!" );
+	close();
+
+	const char* base = data->cPtr();
+	if( size < sizeof( AssetsPackHeader ) )
+		return false;
+
+	const AssetsPackHeader* header = (const AssetsPackHeader*) base;
+	if( header->magic != Magic || header->version != Version )
+		return false;
+
+	if( header->toc_offset > size || ( size - header->toc_offset ) / sizeof( AssetsPackEntry ) < header->count ||
+		header->names_offset > size || size - header->names_offset < header->names_size )
+		return false;
+
+	const AssetsPackEntry* entries = (const AssetsPackEntry*) ( base + header->toc_offset );
+	for( uint32_t i = 0; i < header->count; ++i )
+	{
+		const AssetsPackEntry& entry = entries[i];
+		if( entry.offset > size || size - entry.offset < entry.packed_size || entry.packed_size > entry.size ||
+			( entry.packed_size < entry.size && entry.size > LZ4::decompressBound( entry.packed_size ) ) ||
+			entry.size >= (uint64_t) SIZE_MAX ||
+			entry.name_offset > header->names_size || header->names_size - entry.name_offset < entry.name_length )
+			return false;
+	}
+
+	// 槽位数取不小于两倍条目数的2的幂，线性探测的平均探测长度保持在很小的常数
+	uint32_t slot_count = 16;
+	while( slot_count < header->count * 2 )
+	{
+		slot_count <<= 1;
+	}
+
+	m_slots.assign( slot_count, -1 );
+	m_slot_mask = slot_count - 1;
+	for( uint32_t i = 0; i < header->count; ++i )
+	{
+		uint32_t slot = (uint32_t) entries[i].hash & m_slot_mask;
+		while( m_slots[ slot ] >= 0 )
+		{
+			slot = ( slot + 1 ) & m_slot_mask;
+		}
+		m_slots[ slot ] = (int32_t) i;
+	}
+
+	m_data = data;
+	m_size = size;
+	m_entries = entries;
+	m_names = base + header->names_offset;
+	m_count = header->count;
+	return true;
+}
+
+void AssetsPack::close( void )
+{
+	m_data = nullptr;
+	m_size = 0;
+	m_entries = nullptr;
+	m_names = nullptr;
+	m_count = 0;
+	m_slots.clear();
+	m_slot_mask = 0;
+}
+
+bool AssetsPack::contains( const char* name ) const
+{
+	MAGICAL_ASSERT( name, "should not be nullptr." );
+
+	string key = normalize( name );
+	return find( key, hash( key ) ) >= 0;
+}
+
+Ptr<Data> AssetsPack::loadFile( const char* name ) const
+{
+	MAGICAL_ASSERT( name, "should not be nullptr." );
+
+	string key = normalize( name );
+	int index = find( key, hash( key ) );
+	if( index < 0 )
+		return nullptr;
+
+	return loadEntry( m_entries[ index ] );
+}
+
+/*
+FNV-1a
+*/
+uint64_t AssetsPack::hash( const string& name )
+{
+	uint64_t h = 14695981039346656037ULL;
+	for( size_t i = 0; i < name.length(); ++i )
+	{
+		h ^= (uint8_t) name[i];
+		h *= 1099511628211ULL;
+	}
+	return h;
+}
+
+string AssetsPack::normalize( const char* name )
+{
+	string key = FileUtils::toUnixPath( name );
+	size_t start = 0;
+	while( key.compare( start, 2, "./" ) == 0 )
+	{
+		start += 2;
+	}
+	return start > 0 ? key.substr( start ) : key;
+}
+
+bool AssetsPack::mount( const char* file )
+{
+	Ptr<AssetsPack> pack = AssetsPack::create();
+	if( !pack->open( file ) )
+		return false;
+
+	mount( pack );
+	return true;
+}
+
+void AssetsPack::mount( const Ptr<AssetsPack>& pack )
+{
+	MAGICAL_ASSERT( pack && pack->isOpen(), "Invalid pack!" );
+	std::lock_guard<std::mutex> lock( _mounted_mutex );
+	_mounted_packs.push_back( pack );
+}
+
+void AssetsPack::unmount( const AssetsPack* pack )
+{
+	Ptr<AssetsPack> removed;
+	std::unique_lock<std::mutex> lock( _mounted_mutex );
+	for( auto itr = _mounted_packs.begin(); itr != _mounted_packs.end(); ++itr )
+	{
+		if( itr->get() == pack )
+		{
+			removed = *itr;
+			_mounted_packs.erase( itr );
+			break;
+		}
+	}
+
+	// 已移出列表，不会再有新的读取，等待锁外还在进行的读取结束
+	if( removed )
+		_mounted_loaded.wait( lock, [ & ](){ return removed->m_loading == 0; } );
+}
+
+void AssetsPack::unmountAll( void )
+{
+	Vector< Ptr<AssetsPack> > removed;
+	std::unique_lock<std::mutex> lock( _mounted_mutex );
+	removed.swap( _mounted_packs );
+	_mounted_loaded.wait( lock, [ & ](){
+		for( const auto& pack : removed )
+		{
+			if( pack->m_loading > 0 )
+				return false;
+		}
+		return true;
+	} );
+}
+
+bool AssetsPack::isMountedFile( const char* name )
+{
+	if( FileUtils::isAbsPath( name ) )
+		return false;
+
+	std::lock_guard<std::mutex> lock( _mounted_mutex );
+	if( _mounted_packs.empty() )
+		return false;
+
+	string key = normalize( name );
+	uint64_t h = hash( key );
+	for( auto itr = _mounted_packs.rbegin(); itr != _mounted_packs.rend(); ++itr )
+	{
+		if( (*itr)->find( key, h ) >= 0 )
+			return true;
+	}
+	return false;
+}
+
+Ptr<Data> AssetsPack::loadMountedFile( const char* name )
+{
+	if( FileUtils::isAbsPath( name ) )
+		return nullptr;
+
+	string key = normalize( name );
+	uint64_t h = hash( key );
+
+	// 锁内只查找并登记读取，复制和解压在锁外进行，不阻塞其它线程的查找和挂载；
+	// 不复制Ptr，包的引用计数只在持有锁的挂载与卸载中修改
+	AssetsPack* pack = nullptr;
+	int index = -1;
+	{
+		std::lock_guard<std::mutex> lock( _mounted_mutex );
+		for( auto itr = _mounted_packs.rbegin(); itr != _mounted_packs.rend(); ++itr )
+		{
+			index = (*itr)->find( key, h );
+			if( index >= 0 )
+			{
+				pack = itr->get();
+				++ pack->m_loading;
+				break;
+			}
+		}
+	}
+
+	if( !pack )
+		return nullptr;
+
+	Ptr<Data> data = pack->loadEntry( pack->m_entries[ index ] );
+	{
+		std::lock_guard<std::mutex> lock( _mounted_mutex );
+		if( -- pack->m_loading == 0 )
+			_mounted_loaded.notify_all();
+	}
+	return data;
+}
+
+int AssetsPack::find( const string& name, uint64_t hash ) const
+{
+	if( m_count == 0 )
+		return -1;
+
+	uint32_t slot = (uint32_t) hash & m_slot_mask;
+	for( int32_t index = m_slots[ slot ]; index >= 0; index = m_slots[ slot ] )
+	{
+		const AssetsPackEntry& entry = m_entries[ index ];
+		if( entry.hash == hash && entry.name_length == name.length() &&
+			memcmp( m_names + entry.name_offset, name.c_str(), name.length() ) == 0 )
+			return index;
+
+		slot = ( slot + 1 ) & m_slot_mask;
+	}
+	return -1;
+}
+
+/*
+与Assets::loadFile一致，返回的数据结尾多出一个0；
+条目的范围与大小已在open时按包的大小检查过
+*/
+Ptr<Data> AssetsPack::loadEntry( const AssetsPackEntry& entry ) const
+{
+	MAGICAL_ASSERT( entry.offset + entry.packed_size <= m_size, "Invalid entry!" );
+	size_t size = (size_t) entry.size;
+	const char* src = m_data->cPtr() + entry.offset;
+
+	Ptr<Data> data = Data::create( size + 1 );
+	if( entry.packed_size == entry.size )
+	{
+		memcpy( data->cPtr(), src, size );
+	}
+	else if( !LZ4::decompress( data->cPtr(), size, src, (size_t) entry.packed_size ) )
+	{
+		MAGICAL_SET_LAST_ERROR( System::format<512>( "decompress assets pack entry failed! file(%.*s).",
+			(int) entry.name_length, m_names + entry.name_offset ).c_str() );
+		MAGICAL_LOG_LAST_ERROR();
+		return nullptr;
+	}
+
+	data->cPtr()[ size ] = 0;
+	return data;
+}
+
+NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,129 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __ASSETS_PACK_H__
+#define __ASSETS_PACK_H__
+
+#include "magical-macros.h"
+#include "Common.h"
+#include "Reference.h"
+#include "Vector.h"
+#include "Data.h"
+
+NAMESPACE_MAGICAL
+
+/*
+资源包文件格式
+
+文件头之后依次为按对齐存放的各文件数据、按名字哈希排序的目录以及名字表，
+名字为相对于资源根目录的unix路径，条目的packed_size小于size时数据以LZ4压缩
+*/
+struct AssetsPackHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t count;
+	uint32_t alignment;
+	uint64_t toc_offset;
+	uint64_t names_offset;
+	uint64_t names_size;
+};
+
+struct AssetsPackEntry
+{
+	uint64_t hash;
+	uint64_t offset;
+	uint64_t size;
+	uint64_t packed_size;
+	uint32_t name_offset;
+	uint32_t name_length;
+};
+
+/*
+只读资源包
+
+打开时整个包通过Assets::loadFile加载（支持的平台上为内存映射），
+并根据目录建立开放寻址的哈希索引，查找文件为O(1)且不需要任何系统调用；
+挂载后Assets::loadFile与Assets::isFileExist对相对路径优先查找已挂载的包，
+后挂载的包优先，包内找不到时再访问文件系统；
+挂载列表由锁保护，后台加载线程可以同时查找，解压在锁外进行；
+Reference的计数不是原子的，加载线程不持有包的Ptr，只在锁内登记正在读取的数量，
+unmount等这些读取结束后才释放包
+*/
+class AssetsPack : public Reference
+{
+public:
+	enum : uint32_t
+	{
+		Magic = 0x4b41504d, // "MPAK"
+		Version = 1,
+	};
+
+public:
+	AssetsPack( void );
+	virtual ~AssetsPack( void );
+	static Ptr<AssetsPack> create( void );
+	static Ptr<AssetsPack> create( const char* file );
+
+public:
+	bool open( const char* file );
+	bool open( const Ptr<Data>& data );
+	bool open( const Ptr<Data>& data, size_t size );
+	void close( void );
+	bool isOpen( void ) const { return m_data != nullptr; }
+
+public:
+	size_t fileCount( void ) const { return m_count; }
+	bool contains( const char* name ) const;
+	Ptr<Data> loadFile( const char* name ) const;
+
+public:
+	static uint64_t hash( const string& name );
+	static string normalize( const char* name );
+
+public:
+	static bool mount( const char* file );
+	static void mount( const Ptr<AssetsPack>& pack );
+	static void unmount( const AssetsPack* pack );
+	static void unmountAll( void );
+	static bool isMountedFile( const char* name );
+	static Ptr<Data> loadMountedFile( const char* name );
+
+private:
+	int find( const string& name, uint64_t hash ) const;
+	Ptr<Data> loadEntry( const AssetsPackEntry& entry ) const;
+
+private:
+	Ptr<Data> m_data;
+	size_t m_size = 0;
+	const AssetsPackEntry* m_entries = nullptr;
+	const char* m_names = nullptr;
+	uint32_t m_count = 0;
+	Vector<int32_t> m_slots;
+	uint32_t m_slot_mask = 0;
+	int m_loading = 0;
+};
+
+NAMESPACE_END
+
+#endif //__ASSETS_PACK_H__
\ No newline at end of file
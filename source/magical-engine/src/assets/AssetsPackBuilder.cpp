@@ -0,0 +1,194 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "AssetsPackBuilder.h"
+#include "LZ4.h"
+#include <string.h>
+#include <stdio.h>
+
+NAMESPACE_MAGICAL
+
+const float AssetsPackBuilder::MaxCompressRatio = 0.9f;
+
+static inline uint64_t alignUp( uint64_t offset, uint64_t alignment )
+{
+	return ( offset + alignment - 1 ) / alignment * alignment;
+}
+
+AssetsPackBuilder::AssetsPackBuilder( void )
+{
+
+}
+
+AssetsPackBuilder::~AssetsPackBuilder( void )
+{
+
+}
+
+void AssetsPackBuilder::setAlignment( uint32_t alignment )
+{
+	MAGICAL_ASSERT( alignment > 0 && ( alignment & ( alignment - 1 ) ) == 0, "alignment should be power of 2." );
+	m_alignment = alignment;
+}
+
+void AssetsPackBuilder::clear( void )
+{
+	m_items.clear();
+}
+
+/*
+同名文件后添加的覆盖先添加的
+*/
+void AssetsPackBuilder::addData( const char* name, const char* data, size_t size, bool compress )
+{
+	MAGICAL_ASSERT( name && ( data || size == 0 ), "should not be nullptr." );
+
+	Item item;
+	item.name = AssetsPack::normalize( name );
+	item.hash = AssetsPack::hash( item.name );
+	item.size = size;
+
+	if( compress && size > 0 )
+	{
+		item.bytes.resize( LZ4::compressBound( size ) );
+		size_t packed_size = LZ4::compress( item.bytes.data(), item.bytes.size(), data, size );
+		if( packed_size > 0 && packed_size <= size * MaxCompressRatio )
+			item.bytes.resize( packed_size );
+		else
+			item.bytes.clear();
+	}
+
+	if( item.bytes.empty() )
+		item.bytes.assign( data, data + size );
+
+	for( auto& old : m_items )
+	{
+		if( old.name == item.name )
+		{
+			old = std::move( item );
+			return;
+		}
+	}
+	m_items.push_back( std::move( item ) );
+}
+
+bool AssetsPackBuilder::addFile( const char* name, const char* file, bool compress )
+{
+	MAGICAL_ASSERT( name && file, "should not be nullptr." );
+
+	FILE* fp = fopen( file, "rb" );
+	if( fp == nullptr )
+	{
+		MAGICAL_SET_LAST_ERROR( System::format<512>( "add file to assets pack failed! file(%s).", file ).c_str() );
+		MAGICAL_LOG_LAST_ERROR();
+		return false;
+	}
+
+	fseek( fp, 0, SEEK_END );
+	size_t size = (size_t) ftell( fp );
+	fseek( fp, 0, SEEK_SET );
+
+	Vector<char> buffer( size );
+	size_t read_size = size > 0 ? fread( buffer.data(), sizeof( char ), size, fp ) : 0;
+	fclose( fp );
+
+	addData( name, buffer.data(), read_size, compress );
+	return true;
+}
+
+Ptr<Data> AssetsPackBuilder::build( void ) const
+{
+	// 目录按哈希排序，相同的输入总是生成相同的包
+	Vector<const Item*> items;
+	items.reserve( m_items.size() );
+	for( const auto& item : m_items )
+	{
+		items.push_back( &item );
+	}
+	std::sort( items.begin(), items.end(), []( const Item* a, const Item* b ) {
+		return a->hash != b->hash ? a->hash < b->hash : a->name < b->name;
+	} );
+
+	Vector<AssetsPackEntry> entries( items.size() );
+	string names;
+	uint64_t offset = alignUp( sizeof( AssetsPackHeader ), m_alignment );
+	for( size_t i = 0; i < items.size(); ++i )
+	{
+		const Item& item = *items[i];
+		AssetsPackEntry& entry = entries[i];
+		entry.hash = item.hash;
+		entry.offset = offset;
+		entry.size = item.size;
+		entry.packed_size = item.bytes.size();
+		entry.name_offset = (uint32_t) names.length();
+		entry.name_length = (uint32_t) item.name.length();
+		names += item.name;
+		offset = alignUp( offset + item.bytes.size(), m_alignment );
+	}
+
+	AssetsPackHeader header;
+	header.magic = AssetsPack::Magic;
+	header.version = AssetsPack::Version;
+	header.count = (uint32_t) entries.size();
+	header.alignment = m_alignment;
+	header.toc_offset = alignUp( offset, 8 );
+	header.names_offset = header.toc_offset + entries.size() * sizeof( AssetsPackEntry );
+	header.names_size = names.length();
+
+	size_t size = (size_t) ( header.names_offset + header.names_size );
+	Ptr<Data> data = Data::create( size );
+	char* dst = data->cPtr();
+	memset( dst, 0, size );
+	memcpy( dst, &header, sizeof( header ) );
+	for( size_t i = 0; i < items.size(); ++i )
+	{
+		if( !items[i]->bytes.empty() )
+			memcpy( dst + entries[i].offset, items[i]->bytes.data(), items[i]->bytes.size() );
+	}
+	if( !entries.empty() )
+		memcpy( dst + header.toc_offset, entries.data(), entries.size() * sizeof( AssetsPackEntry ) );
+	if( !names.empty() )
+		memcpy( dst + header.names_offset, names.data(), names.length() );
+
+	return data;
+}
+
+bool AssetsPackBuilder::save( const char* file ) const
+{
+	MAGICAL_ASSERT( file, "should not be nullptr." );
+
+	Ptr<Data> data = build();
+	FILE* fp = fopen( file, "wb" );
+	if( fp == nullptr )
+	{
+		MAGICAL_SET_LAST_ERROR( System::format<512>( "save assets pack failed! file(%s).", file ).c_str() );
+		MAGICAL_LOG_LAST_ERROR();
+		return false;
+	}
+
+	size_t written = fwrite( data->cPtr(), sizeof( char ), data->size(), fp );
+	fclose( fp );
+	return written == data->size();
+}
+
+NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,80 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __ASSETS_PACK_BUILDER_H__
+#define __ASSETS_PACK_BUILDER_H__
+
+#include "magical-macros.h"
+#include "Common.h"
+#include "Vector.h"
+#include "Data.h"
+#include "AssetsPack.h"
+
+NAMESPACE_MAGICAL
+
+/*
+资源包生成工具
+
+逐个添加文件后调用build生成包数据或save写入文件，
+开启压缩的文件只有在压缩后不大于原大小的MaxCompressRatio时才以压缩形式保存
+*/
+class AssetsPackBuilder
+{
+public:
+	static const float MaxCompressRatio;
+
+public:
+	AssetsPackBuilder( void );
+	~AssetsPackBuilder( void );
+
+public:
+	void setAlignment( uint32_t alignment );
+	uint32_t getAlignment( void ) const { return m_alignment; }
+	size_t fileCount( void ) const { return m_items.size(); }
+	void clear( void );
+
+public:
+	void addData( const char* name, const char* data, size_t size, bool compress = true );
+	bool addFile( const char* name, const char* file, bool compress = true );
+
+public:
+	Ptr<Data> build( void ) const;
+	bool save( const char* file ) const;
+
+private:
+	struct Item
+	{
+		string name;
+		uint64_t hash;
+		uint64_t size;
+		Vector<char> bytes;
+	};
+
+private:
+	uint32_t m_alignment = 16;
+	Vector<Item> m_items;
+};
+
+NAMESPACE_END
+
+#endif //__ASSETS_PACK_BUILDER_H__
\ No newline at end of file
@@ -0,0 +1,227 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "Assets.h"
+#include "AssetsPack.h"
+#include "AssetsCache.h"
+#include "Utils.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <mutex>
+#include <atomic>
+
+NAMESPACE_MAGICAL
+
+// 异步加载的I/O线程也会读取搜索路径和映射阈值
+static std::mutex _search_path_mutex;
+static std::string _search_path;
+static std::atomic<size_t> _map_threshold( 256 * 1024 );
+
+/*
+映射区域按页对齐，长度比文件多出至少一个字节用于结尾的0，
+与读取方式加载的数据保持一致（size包含结尾的0）
+*/
+static size_t mappingLength( size_t size )
+{
+	size_t page = (size_t) sysconf( _SC_PAGESIZE );
+	return ( size + page - 1 ) / page * page;
+}
+
+static void unmapData( char* data, size_t size )
+{
+	munmap( data, mappingLength( size ) );
+}
+
+/*
+先保留一段匿名映射，再把文件私有映射到它的开头，
+文件大小恰好是页大小整数倍时结尾的0落在匿名页上，不会越过文件末尾访问；
+私有映射写入时按页复制，调用者可以像修改读取的数据一样修改它
+*/
+static Ptr<Data> mapFile( int fd, size_t size )
+{
+	size_t length = mappingLength( size + 1 );
+	void* base = mmap( nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+	if( base == MAP_FAILED )
+		return nullptr;
+
+	void* addr = mmap( base, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0 );
+	if( addr == MAP_FAILED )
+	{
+		munmap( base, length );
+		return nullptr;
+	}
+
+	return Data::create( (char*) base, size + 1, unmapData );
+}
+
+static Ptr<Data> readFile( int fd, size_t size )
+{
+	Ptr<Data> data = Data::create( size + 1 );
+	size_t read_size = 0;
+	while( read_size < size )
+	{
+		ssize_t ret = read( fd, data->cPtr() + read_size, size - read_size );
+		if( ret < 0 && errno == EINTR )
+			continue;
+		if( ret <= 0 )
+			break;
+		read_size += (size_t) ret;
+	}
+
+	data->realloc( read_size + 1 );
+	data->cPtr()[ read_size ] = 0;
+	return data;
+}
+
+void Assets::init( void )
+{
+	Assets::setDefaultSearchPath();
+	MAGICAL_RETURN_IF_ERROR();
+}
+
+void Assets::delc( void )
+{
+	Assets::stopAsyncLoads();
+	AssetsCache::clear();
+	AssetsPack::unmountAll();
+}
+
+void Assets::setDefaultSearchPath( void )
+{
+	char directory[ 2048 ] = { 0 };
+	if( getcwd( directory, 2048 ) == nullptr || strlen( directory ) == 0 )
+	{
+		MAGICAL_SET_LAST_ERROR( "result of getcwd is empty." );
+		MAGICAL_LOG_LAST_ERROR();
+		return;
+	}
+	std::lock_guard<std::mutex> lock( _search_path_mutex );
+	_search_path = directory;
+	_search_path += "/";
+}
+
+void Assets::setSearchPath( const char* path )
+{
+	MAGICAL_ASSERT( path, "should not be nullptr." );
+	std::string unix_path = FileUtils::toUnixPath( path );
+	MAGICAL_ASSERT( FileUtils::isAbsPath( unix_path.c_str() ), "should be absolute path." );
+
+	if( unix_path.length() > 0 && unix_path.back() != '/' )
+		unix_path += "/";
+
+	{
+		std::lock_guard<std::mutex> lock( _search_path_mutex );
+		_search_path = unix_path;
+	}
+	AssetsCache::clear();
+}
+
+std::string Assets::getSearchPath( void )
+{
+	std::lock_guard<std::mutex> lock( _search_path_mutex );
+	return _search_path;
+}
+
+std::string Assets::getAbsFilename( const char* file )
+{
+	MAGICAL_ASSERT( file, "should not be nullptr." );
+	if( FileUtils::isAbsPath( file ) )
+		return file;
+
+	std::string unix_path = FileUtils::toUnixPath( file );
+	std::string abs_path = getSearchPath() + unix_path;
+	return abs_path;
+}
+
+bool Assets::isFileExist( const char* file )
+{
+	MAGICAL_ASSERT( file, "should not be nullptr." );
+
+	if( AssetsPack::isMountedFile( file ) )
+		return true;
+
+	std::string abs_path = getAbsFilename( file );
+	struct stat st;
+	return stat( abs_path.c_str(), &st ) == 0;
+}
+
+Ptr<Data> Assets::loadFile( const char* file )
+{
+	MAGICAL_ASSERT( file, "should not be nullptr." );
+
+	Ptr<Data> data = tryLoadFile( file );
+	if( !data )
+	{
+		MAGICAL_SET_LAST_ERROR( System::format<512>( "get assets file data failed! file(%s).", file ).c_str() );
+		MAGICAL_LOG_LAST_ERROR();
+	}
+	return data;
+}
+
+Ptr<Data> Assets::tryLoadFile( const char* file )
+{
+	MAGICAL_ASSERT( file, "should not be nullptr." );
+
+	Ptr<Data> packed = AssetsPack::loadMountedFile( file );
+	if( packed )
+		return packed;
+
+	std::string abs_path = getAbsFilename( file );
+	int fd = open( abs_path.c_str(), O_RDONLY | O_CLOEXEC );
+	if( fd < 0 )
+		return nullptr;
+
+	struct stat st;
+	if( fstat( fd, &st ) != 0 || !S_ISREG( st.st_mode ) )
+	{
+		close( fd );
+		return nullptr;
+	}
+
+	// 映射失败（如文件系统不支持）时退回到读取方式
+	size_t size = (size_t) st.st_size;
+	Ptr<Data> data;
+	if( size > 0 && size >= _map_threshold.load() )
+		data = mapFile( fd, size );
+	if( !data )
+		data = readFile( fd, size );
+
+	close( fd );
+	return data;
+}
+
+void Assets::setMapThreshold( size_t size )
+{
+	_map_threshold.store( size );
+}
+
+size_t Assets::getMapThreshold( void )
+{
+	return _map_threshold.load();
+}
+
+NAMESPACE_END
\ No newline at end of file
@@ -22,12 +22,19 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 *******************************************************************************/
 #include "Assets.h"
+#include "AssetsPack.h"
+#include "AssetsCache.h"
 #include "Utils.h"
 #include <windows.h>
+#include <mutex>
+#include <atomic>
 
 NAMESPACE_MAGICAL
 
+// 异步加载的I/O线程也会读取搜索路径和映射阈值
+static std::mutex _search_path_mutex;
 static std::string _search_path;
+static std::atomic<size_t> _map_threshold( 256 * 1024 );
 
 void Assets::init( void )
 {
@@ -37,7 +44,9 @@ void Assets::init( void )
 
 void Assets::delc( void )
 {
-	
+	Assets::stopAsyncLoads();
+	AssetsCache::clear();
+	AssetsPack::unmountAll();
 }
 
 void Assets::setDefaultSearchPath( void )
@@ -50,6 +59,7 @@ void Assets::setDefaultSearchPath( void )
 		MAGICAL_LOG_LAST_ERROR();
 		return;
 	}
+	std::lock_guard<std::mutex> lock( _search_path_mutex );
 	_search_path = FileUtils::toUnixPath( directory );
 	_search_path += "/";
 }
@@ -63,11 +73,16 @@ void Assets::setSearchPath( const char* path )
 	if( unix_path.length() > 0 && unix_path.back() != '/' )
 		unix_path += "/";
 
-	_search_path = unix_path;
+	{
+		std::lock_guard<std::mutex> lock( _search_path_mutex );
+		_search_path = unix_path;
+	}
+	AssetsCache::clear();
 }
 
 std::string Assets::getSearchPath( void )
 {
+	std::lock_guard<std::mutex> lock( _search_path_mutex );
 	return _search_path;
 }
 
@@ -78,7 +93,7 @@ std::string Assets::getAbsFilename( const char* file )
 		return file;
 
 	std::string unix_path = FileUtils::toUnixPath( file );
-	std::string abs_path = _search_path + unix_path;
+	std::string abs_path = getSearchPath() + unix_path;
 	return abs_path;
 }
 
@@ -86,10 +101,13 @@ bool Assets::isFileExist( const char* file )
 {
 	MAGICAL_ASSERT( file, "should not be nullptr." );
 
+	if( AssetsPack::isMountedFile( file ) )
+		return true;
+
 	std::string file_path = FileUtils::toUnixPath( file );
 	if( FileUtils::isAbsPath( file_path.c_str() ) == false )
 	{
-		std::string abs_path = _search_path + file_path;
+		std::string abs_path = getSearchPath() + file_path;
 		int ret = GetFileAttributesA( abs_path.c_str() );
 		if( ret != -1 )
 		{
@@ -108,16 +126,27 @@ Ptr<Data> Assets::loadFile( const char* file )
 {
 	MAGICAL_ASSERT( file, "should not be nullptr." );
 
-	std::string abs_path = getAbsFilename( file );
-	MAGICAL_ASSERT( !abs_path.empty(), System::format<512>( "get assets file data failed! file(%s) doesn't exist.", file ).c_str() );
-
-	FILE* fp = fopen( abs_path.c_str(), "rb" );
-	if( fp == nullptr )
+	Ptr<Data> data = tryLoadFile( file );
+	if( !data )
 	{
 		MAGICAL_SET_LAST_ERROR( System::format<512>( "get assets file data failed! file(%s).", file ).c_str() );
 		MAGICAL_LOG_LAST_ERROR();
-		return nullptr;
 	}
+	return data;
+}
+
+Ptr<Data> Assets::tryLoadFile( const char* file )
+{
+	MAGICAL_ASSERT( file, "should not be nullptr." );
+
+	Ptr<Data> packed = AssetsPack::loadMountedFile( file );
+	if( packed )
+		return packed;
+
+	std::string abs_path = getAbsFilename( file );
+	FILE* fp = fopen( abs_path.c_str(), "rb" );
+	if( fp == nullptr )
+		return nullptr;
 
 	size_t size, read_size = 0;
 	fseek( fp, 0, SEEK_END );
@@ -133,4 +162,14 @@ Ptr<Data> Assets::loadFile( const char* file )
 	return data;
 }
 
+void Assets::setMapThreshold( size_t size )
+{
+	_map_threshold.store( size );
+}
+
+size_t Assets::getMapThreshold( void )
+{
+	return _map_threshold.load();
+}
+
 NAMESPACE_END
\ No newline at end of file
@@ -37,13 +37,16 @@ struct Area
 		struct {
 			float x;
 			float y;
-			float w;
-			float h;
 		};
+		Vector2 origin;
+	};
+	union
+	{
 		struct {
-			Vector2 origin;
-			Size size;
+			float w;
+			float h;
 		};
+		Size size;
 	};
 	
 public:
@@ -55,6 +58,9 @@ public:
 	inline Area( const Area& area ) : x( area.x ), y( area.y ), w( area.w ), h( area.h ) { }
 	inline Area( void ) { }
 
+public:
+	inline Area& operator=( const Area& area ) { x = area.x; y = area.y; w = area.w; h = area.h; return *this; }
+
 public:
 	inline bool isValid( void ) const
 	{
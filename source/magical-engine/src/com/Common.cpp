@@ -135,6 +135,9 @@ NAMESPACE_END
 
 MAGICALAPI void MAGICAL_ASSERT_IMPL( const char* exp, const char* msg, const char* file, int line )
 {
+	// 弹框或退出之前确保已写入的日志落盘
+	magical::Log::flush();
+
 #ifdef MAGICAL_WIN32
 	std::stringstream stext;
 	stext << file << "\n\nLine: " << line << "\n\n";
@@ -31,6 +31,8 @@ SOFTWARE.
 #include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
 
 #include <string>
 #include <sstream>
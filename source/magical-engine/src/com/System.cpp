@@ -24,6 +24,9 @@ SOFTWARE.
 #include "System.h"
 #ifdef MAGICAL_WIN32
 #include <windows.h>
+#else
+#include <locale>
+#include <codecvt>
 #endif
 
 NAMESPACE_MAGICAL
@@ -48,6 +51,8 @@ std::wstring System::utf8ToUnicode( const std::string& str )
 	result = dst;
 	::free( dst );
 	return result;
+#else
+	return std::wstring_convert< std::codecvt_utf8< wchar_t > >().from_bytes( str );
 #endif
 }
 
@@ -69,6 +74,9 @@ std::wstring System::ansiToUnicode( const std::string& str )
 	result = dst;
 	::free( dst );
 	return result;
+#else
+	// 非Windows平台的本地编码即为utf-8
+	return std::wstring_convert< std::codecvt_utf8< wchar_t > >().from_bytes( str );
 #endif
 }
 
@@ -90,6 +98,8 @@ std::string System::unicodeToUtf8( const std::wstring& str )
 	result = dst;
 	::free( dst );
 	return result;
+#else
+	return std::wstring_convert< std::codecvt_utf8< wchar_t > >().to_bytes( str );
 #endif
 }
 
@@ -111,6 +121,8 @@ std::string System::unicodeToAnsi( const std::wstring& str )
 	result = dst;
 	::free( dst );
 	return result;
+#else
+	return std::wstring_convert< std::codecvt_utf8< wchar_t > >().to_bytes( str );
 #endif
 }
 
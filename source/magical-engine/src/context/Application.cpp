@@ -28,6 +28,8 @@ SOFTWARE.
 #include "Input.h"
 //#include "LuaSystem.h"
 #include "Renderer.h"
+#include "Profiler.h"
+#include "Stats.h"
 
 NAMESPACE_MAGICAL
 
@@ -39,6 +41,8 @@ void Application::init( void )
 	MAGICAL_SHOW_LAST_ERROR();
 	MAGICAL_RETURN_IF_ERROR();
 
+	Profiler::init();
+
 	Assets::init();
 	MAGICAL_SHOW_LAST_ERROR();
 	MAGICAL_RETURN_IF_ERROR();
@@ -117,6 +121,9 @@ void Application::delc( void )
 
 	//magicalEndObjectsListener( kEngineObjectsListener );
 
+	Stats::delc();
+	Profiler::delc();
+
 	Log::delc();
 	MAGICAL_SHOW_LAST_ERROR();
 	MAGICAL_RETURN_IF_ERROR();
@@ -0,0 +1,134 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "Application.h"
+#include "Director.h"
+
+NAMESPACE_MAGICAL
+
+/*
+无窗口的Application实现，配合MAGICAL_USING_NULL_GL用于性能测试和持续集成
+
+run不按interval等待，调用exit前每次循环直接执行一帧
+*/
+static bool _exit = false;
+static double _interval;
+static bool _window_resizable = true;
+static Size _window_size = Size::Zero;
+static std::string _window_title = "magical-engine";
+
+void Application::run( MainDelegate maindelegate )
+{
+	maindelegate();
+	MAGICAL_SHOW_LAST_ERROR();
+	MAGICAL_RETURN_IF_ERROR();
+
+	while( !_exit )
+	{
+		Director::mainLoop();
+
+#ifdef MAGICAL_DEBUG
+		MAGICAL_SHOW_LAST_ERROR();
+		MAGICAL_RETURN_IF_ERROR();
+#endif
+	}
+}
+
+void Application::setInterval( double interval )
+{
+	_interval = interval;
+}
+
+double Application::getInterval( void )
+{
+	return _interval;
+}
+
+void Application::setResizable( bool resizable )
+{
+	_window_resizable = resizable;
+}
+
+bool Application::isResizable( void )
+{
+	return _window_resizable;
+}
+
+void Application::setWindowSize( int width, int height )
+{
+	_window_size.w = width;
+	_window_size.h = height;
+}
+
+void Application::setWindowSize( const Size& size )
+{
+	_window_size = size;
+}
+
+const Size& Application::getWindowSize( void )
+{
+	return _window_size;
+}
+
+void Application::setWindowTitle( const char* title )
+{
+	_window_title = title;
+}
+
+void Application::swapBuffers( void )
+{
+
+}
+
+void Application::exit( void )
+{
+	_exit = true;
+}
+
+void Application::initWindow( void )
+{
+	_exit = false;
+
+	setInterval( 1.0 / 60 );
+	setResizable( true );
+
+	_window_size.w = 1280;
+	_window_size.h = 760;
+}
+
+void Application::delcWindow( void )
+{
+
+}
+
+void Application::initRenderContext( void )
+{
+
+}
+
+void Application::delcRenderContext( void )
+{
+
+}
+
+NAMESPACE_END
\ No newline at end of file
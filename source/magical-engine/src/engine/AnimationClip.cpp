@@ -0,0 +1,416 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "AnimationClip.h"
+#include "Assets.h"
+#include <string.h>
+#include <cmath>
+#include <algorithm>
+
+NAMESPACE_MAGICAL
+
+const float AnimationClip::DefaultFrameRate = 30.0f;
+
+static void decodeRotations( Quaternion* out, const int16_t* keys, size_t count )
+{
+	Snorm16::toFloat( &out->x, keys, count * 4 );
+}
+
+/*
+每行预留stride列，列满时stride加倍后重新排列，逐条添加轨道的总开销与关键帧数量成正比
+*/
+template< class T >
+static void appendColumn( Vector<T>& keys, size_t& stride, size_t columns, size_t rows, const T* column, size_t width )
+{
+	if( columns == stride )
+	{
+		size_t capacity = Math::max( stride * 2, (size_t) 8 );
+		Vector<T> dst( rows * capacity * width );
+		for( size_t r = 0; r < rows; ++r )
+		{
+			const T* src = &keys[ r * stride * width ];
+			std::copy( src, src + columns * width, &dst[ r * capacity * width ] );
+		}
+		keys.swap( dst );
+		stride = capacity;
+	}
+
+	for( size_t r = 0; r < rows; ++r )
+		std::copy( column + r * width, column + ( r + 1 ) * width, &keys[ ( r * stride + columns ) * width ] );
+}
+
+template< class T >
+static bool isConstant( const T* keys, size_t count )
+{
+	for( size_t i = 1; i < count; ++i )
+	{
+		if( keys[i] != keys[0] )
+			return false;
+	}
+	return true;
+}
+
+/*
+二进制读写辅助，所有数据以小端序紧密排列
+*/
+class ClipReader
+{
+public:
+	ClipReader( const char* data, size_t size ) : m_data( data ), m_size( size ) {}
+	bool read( void* dst, size_t size )
+	{
+		if( m_cursor + size > m_size )
+			return false;
+		memcpy( dst, m_data + m_cursor, size );
+		m_cursor += size;
+		return true;
+	}
+	template< class T > bool read( T& dst ) { return read( &dst, sizeof( T ) ); }
+	template< class T > bool read( Vector<T>& dst, uint64_t count )
+	{
+		// 先检查剩余数据，损坏的头部不会导致巨大的分配
+		if( count > ( m_size - m_cursor ) / sizeof( T ) )
+			return false;
+		dst.resize( (size_t) count );
+		return count == 0 || read( dst.data(), sizeof( T ) * (size_t) count );
+	}
+
+private:
+	const char* m_data;
+	size_t m_size;
+	size_t m_cursor = 0;
+};
+
+class ClipWriter
+{
+public:
+	void write( const void* src, size_t size )
+	{
+		const char* bytes = (const char*) src;
+		m_buffer.insert( m_buffer.end(), bytes, bytes + size );
+	}
+	template< class T > void write( const T& src ) { write( &src, sizeof( T ) ); }
+	template< class T > void write( const Vector<T>& src )
+	{
+		if( !src.empty() )
+			write( src.data(), sizeof( T ) * src.size() );
+	}
+	// 只写出每行的前columns列，去掉预留的位置
+	template< class T > void write( const Vector<T>& src, size_t stride, size_t columns, size_t rows, size_t width )
+	{
+		if( stride == columns )
+		{
+			write( src );
+			return;
+		}
+		for( size_t r = 0; r < rows; ++r )
+			write( &src[ r * stride * width ], sizeof( T ) * columns * width );
+	}
+	Vector<char>& buffer( void ) { return m_buffer; }
+
+private:
+	Vector<char> m_buffer;
+};
+
+AnimationClip::AnimationClip( void )
+{
+
+}
+
+AnimationClip::~AnimationClip( void )
+{
+
+}
+
+Ptr<AnimationClip> AnimationClip::create( void )
+{
+	AnimationClip* ret = new AnimationClip();
+	MAGICAL_ASSERT( ret, "new AnimationClip() failed" );
+	return Ptr<AnimationClip>( Ptrctor<AnimationClip>( ret ) );
+}
+
+Ptr<AnimationClip> AnimationClip::create( const char* file )
+{
+	AnimationClip* ret = new AnimationClip();
+	MAGICAL_ASSERT( ret, "new AnimationClip() failed" );
+	Ptr<AnimationClip> clip = Ptr<AnimationClip>( Ptrctor<AnimationClip>( ret ) );
+	if( !clip->load( file ) )
+		return nullptr;
+	return clip;
+}
+
+Ptr<AnimationClip> AnimationClip::create( float frame_rate, size_t frame_count )
+{
+	AnimationClip* ret = new AnimationClip();
+	MAGICAL_ASSERT( ret, "new AnimationClip() failed" );
+	ret->reset( frame_rate, frame_count );
+	return Ptr<AnimationClip>( Ptrctor<AnimationClip>( ret ) );
+}
+
+bool AnimationClip::load( const char* file )
+{
+	MAGICAL_ASSERT( file, "should not be nullptr." );
+
+	Ptr<Data> data = Assets::loadFile( file );
+	if( !data )
+		return false;
+
+	if( !load( data.get() ) )
+	{
+		MAGICAL_SET_LAST_ERROR( System::format<512>( "load animation clip failed! file(%s).", file ).c_str() );
+		MAGICAL_LOG_LAST_ERROR();
+		return false;
+	}
+	return true;
+}
+
+bool AnimationClip::load( const Data* data )
+{
+	MAGICAL_ASSERT( data, "should not be nullptr." );
+
+	// 失败时清空，不保留读了一半的数据
+	if( !parse( data ) )
+	{
+		reset( DefaultFrameRate, 0 );
+		return false;
+	}
+	return true;
+}
+
+bool AnimationClip::parse( const Data* data )
+{
+	ClipReader reader( data->cPtr(), data->size() );
+	uint32_t magic, version, frame_count, track_count, tcount, rcount, scount;
+	float frame_rate;
+
+	if( !reader.read( magic ) || !reader.read( version ) || magic != Magic || version != Version )
+		return false;
+
+	if( !reader.read( frame_rate ) || !reader.read( frame_count ) || !reader.read( track_count ) ||
+		!reader.read( tcount ) || !reader.read( rcount ) || !reader.read( scount ) )
+		return false;
+
+	// 数据来自文件，不能断言
+	if( !( frame_rate > 0.0f ) || !std::isfinite( frame_rate ) )
+		return false;
+
+	// 轨道下标是uint16_t，限制之后关键帧数量的64位乘积不会溢出
+	if( track_count > 0xffff || tcount > track_count || rcount > track_count || scount > track_count )
+		return false;
+
+	reset( frame_rate, frame_count );
+	m_track_names.resize( track_count );
+	for( auto& name : m_track_names )
+	{
+		uint16_t len;
+		if( !reader.read( len ) )
+			return false;
+		name.resize( len );
+		if( len > 0 && !reader.read( &name[0], len ) )
+			return false;
+	}
+
+	if( !reader.read( m_default_translations, track_count ) ||
+		!reader.read( m_default_rotations, track_count ) ||
+		!reader.read( m_default_scales, track_count ) ||
+		!reader.read( m_translation_tracks, tcount ) ||
+		!reader.read( m_rotation_tracks, rcount ) ||
+		!reader.read( m_scale_tracks, scount ) ||
+		!reader.read( m_translation_keys, (uint64_t) frame_count * tcount ) ||
+		!reader.read( m_rotation_keys, (uint64_t) frame_count * rcount * 4 ) ||
+		!reader.read( m_scale_keys, (uint64_t) frame_count * scount ) )
+		return false;
+
+	m_translation_stride = tcount;
+	m_rotation_stride = rcount;
+	m_scale_stride = scount;
+
+	for( auto index : m_translation_tracks ) if( index >= track_count ) return false;
+	for( auto index : m_rotation_tracks ) if( index >= track_count ) return false;
+	for( auto index : m_scale_tracks ) if( index >= track_count ) return false;
+
+	return true;
+}
+
+Ptr<Data> AnimationClip::save( void ) const
+{
+	ClipWriter writer;
+	writer.write( (uint32_t) Magic );
+	writer.write( (uint32_t) Version );
+	writer.write( m_frame_rate );
+	writer.write( (uint32_t) m_frame_count );
+	writer.write( (uint32_t) m_track_names.size() );
+	writer.write( (uint32_t) m_translation_tracks.size() );
+	writer.write( (uint32_t) m_rotation_tracks.size() );
+	writer.write( (uint32_t) m_scale_tracks.size() );
+
+	for( const auto& name : m_track_names )
+	{
+		writer.write( (uint16_t) name.length() );
+		writer.write( name.c_str(), name.length() );
+	}
+
+	writer.write( m_default_translations );
+	writer.write( m_default_rotations );
+	writer.write( m_default_scales );
+	writer.write( m_translation_tracks );
+	writer.write( m_rotation_tracks );
+	writer.write( m_scale_tracks );
+	writer.write( m_translation_keys, m_translation_stride, m_translation_tracks.size(), m_frame_count, 1 );
+	writer.write( m_rotation_keys, m_rotation_stride, m_rotation_tracks.size(), m_frame_count, 4 );
+	writer.write( m_scale_keys, m_scale_stride, m_scale_tracks.size(), m_frame_count, 1 );
+
+	Vector<char>& buffer = writer.buffer();
+	Ptr<Data> data = Data::create( buffer.size() );
+	memcpy( data->cPtr(), buffer.data(), buffer.size() );
+	return data;
+}
+
+void AnimationClip::reset( float frame_rate, size_t frame_count )
+{
+	MAGICAL_ASSERT( frame_rate > 0.0f, "Invalid frame rate!" );
+
+	m_frame_rate = frame_rate;
+	m_frame_count = frame_count;
+	m_track_names.clear();
+	m_default_translations.clear();
+	m_default_rotations.clear();
+	m_default_scales.clear();
+	m_translation_tracks.clear();
+	m_rotation_tracks.clear();
+	m_scale_tracks.clear();
+	m_translation_keys.clear();
+	m_rotation_keys.clear();
+	m_scale_keys.clear();
+	m_translation_stride = 0;
+	m_rotation_stride = 0;
+	m_scale_stride = 0;
+}
+
+size_t AnimationClip::addTrack( const char* name, const Vector3* t, const Quaternion* r, const Vector3* s )
+{
+	MAGICAL_ASSERT( name, "should not be nullptr." );
+	MAGICAL_ASSERT( m_track_names.size() < 0xffff, "Too many tracks!" );
+
+	uint16_t index = (uint16_t) m_track_names.size();
+	m_track_names.push_back( name );
+	m_default_translations.push_back( t && m_frame_count > 0 ? t[0] : Vector3::Zero );
+	m_default_rotations.push_back( r && m_frame_count > 0 ? Quaternion::normalize( r[0] ) : Quaternion::Identity );
+	m_default_scales.push_back( s && m_frame_count > 0 ? s[0] : Vector3::One );
+
+	if( t && !isConstant( t, m_frame_count ) )
+	{
+		appendColumn( m_translation_keys, m_translation_stride, m_translation_tracks.size(), m_frame_count, t, 1 );
+		m_translation_tracks.push_back( index );
+	}
+
+	if( r && !isConstant( r, m_frame_count ) )
+	{
+		Vector<int16_t> column( m_frame_count * 4 );
+		for( size_t i = 0; i < m_frame_count; ++i )
+		{
+			Quaternion q = Quaternion::normalize( r[i] );
+			Snorm16::fromFloat( &column[ i * 4 ], &q.x, 4 );
+		}
+		appendColumn( m_rotation_keys, m_rotation_stride, m_rotation_tracks.size(), m_frame_count, column.data(), 4 );
+		m_rotation_tracks.push_back( index );
+	}
+
+	if( s && !isConstant( s, m_frame_count ) )
+	{
+		appendColumn( m_scale_keys, m_scale_stride, m_scale_tracks.size(), m_frame_count, s, 1 );
+		m_scale_tracks.push_back( index );
+	}
+
+	return index;
+}
+
+float AnimationClip::getDuration( void ) const
+{
+	return m_frame_count > 1 ? ( m_frame_count - 1 ) / m_frame_rate : 0.0f;
+}
+
+const string& AnimationClip::getTrackName( size_t index ) const
+{
+	MAGICAL_ASSERT( index < m_track_names.size(), "Invalid index!" );
+	return m_track_names[ index ];
+}
+
+void AnimationClip::sample( AnimationPose& pose, float time ) const
+{
+	pose.translations = m_default_translations;
+	pose.rotations = m_default_rotations;
+	pose.scales = m_default_scales;
+
+	if( m_frame_count == 0 )
+		return;
+
+	float frame = Math::max( 0.0f, Math::min( time * m_frame_rate, (float)( m_frame_count - 1 ) ) );
+	size_t f0 = (size_t) frame;
+	size_t f1 = Math::min( f0 + 1, m_frame_count - 1 );
+	float t = frame - f0;
+
+	size_t count = m_translation_tracks.size();
+	if( count > 0 )
+	{
+		const Vector3* k0 = &m_translation_keys[ f0 * m_translation_stride ];
+		const Vector3* k1 = &m_translation_keys[ f1 * m_translation_stride ];
+		for( size_t i = 0; i < count; ++i )
+		{
+			Vector3& dst = pose.translations[ m_translation_tracks[i] ];
+			dst.x = k0[i].x + ( k1[i].x - k0[i].x ) * t;
+			dst.y = k0[i].y + ( k1[i].y - k0[i].y ) * t;
+			dst.z = k0[i].z + ( k1[i].z - k0[i].z ) * t;
+		}
+	}
+
+	count = m_rotation_tracks.size();
+	if( count > 0 )
+	{
+		pose.cache.resize( count * 2 );
+		Quaternion* q0 = &pose.cache[ 0 ];
+		Quaternion* q1 = &pose.cache[ count ];
+		decodeRotations( q0, &m_rotation_keys[ f0 * m_rotation_stride * 4 ], count );
+		decodeRotations( q1, &m_rotation_keys[ f1 * m_rotation_stride * 4 ], count );
+		Quaternion::nlerp( q0, q0, q1, t, count );
+
+		for( size_t i = 0; i < count; ++i )
+			pose.rotations[ m_rotation_tracks[i] ] = q0[i];
+	}
+
+	count = m_scale_tracks.size();
+	if( count > 0 )
+	{
+		const Vector3* k0 = &m_scale_keys[ f0 * m_scale_stride ];
+		const Vector3* k1 = &m_scale_keys[ f1 * m_scale_stride ];
+		for( size_t i = 0; i < count; ++i )
+		{
+			Vector3& dst = pose.scales[ m_scale_tracks[i] ];
+			dst.x = k0[i].x + ( k1[i].x - k0[i].x ) * t;
+			dst.y = k0[i].y + ( k1[i].y - k0[i].y ) * t;
+			dst.z = k0[i].z + ( k1[i].z - k0[i].z ) * t;
+		}
+	}
+}
+
+NAMESPACE_END
\ No newline at end of file
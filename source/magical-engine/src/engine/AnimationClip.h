@@ -0,0 +1,113 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __ANIMATION_CLIP_H__
+#define __ANIMATION_CLIP_H__
+
+#include "magical-macros.h"
+#include "magical-math.h"
+#include "Common.h"
+#include "Reference.h"
+#include "Vector.h"
+#include "Data.h"
+
+NAMESPACE_MAGICAL
+
+/*
+采样结果，按轨道索引存放各轨道的局部变换
+cache为采样旋转时使用的临时空间，复用同一个pose可以避免每帧分配内存
+*/
+struct AnimationPose
+{
+	Vector<Vector3> translations;
+	Vector<Quaternion> rotations;
+	Vector<Vector3> scales;
+	Vector<Quaternion> cache;
+};
+
+/*
+按固定帧率均匀采样的动画片段
+
+每条轨道包含平移、旋转、缩放三个通道，所有帧上取值相同的通道只保存一个默认值，
+其余通道的关键帧按帧连续存放（第f帧的所有轨道在一段连续内存中），
+采样时只需读取相邻两帧，旋转以snorm16保存并在采样时批量nlerp；
+每帧预留stride条轨道的位置，addTrack在预留的位置上写入，列满时才按倍数重新排列
+*/
+class AnimationClip : public Reference
+{
+public:
+	enum : uint32_t
+	{
+		Magic = 0x50494c43, // "CLIP"
+		Version = 1,
+	};
+	static const float DefaultFrameRate;
+
+public:
+	AnimationClip( void );
+	virtual ~AnimationClip( void );
+	static Ptr<AnimationClip> create( void );
+	static Ptr<AnimationClip> create( const char* file );
+	static Ptr<AnimationClip> create( float frame_rate, size_t frame_count );
+
+public:
+	bool load( const char* file );
+	bool load( const Data* data );
+	Ptr<Data> save( void ) const;
+	void reset( float frame_rate, size_t frame_count );
+	size_t addTrack( const char* name, const Vector3* t, const Quaternion* r, const Vector3* s );
+
+public:
+	size_t trackCount( void ) const { return m_track_names.size(); }
+	size_t frameCount( void ) const { return m_frame_count; }
+	float getFrameRate( void ) const { return m_frame_rate; }
+	float getDuration( void ) const;
+	const string& getTrackName( size_t index ) const;
+
+public:
+	void sample( AnimationPose& pose, float time ) const;
+
+protected:
+	bool parse( const Data* data );
+
+protected:
+	float m_frame_rate = DefaultFrameRate;
+	size_t m_frame_count = 0;
+	Vector<string> m_track_names;
+	Vector<Vector3> m_default_translations;
+	Vector<Quaternion> m_default_rotations;
+	Vector<Vector3> m_default_scales;
+	Vector<uint16_t> m_translation_tracks;
+	Vector<uint16_t> m_rotation_tracks;
+	Vector<uint16_t> m_scale_tracks;
+	Vector<Vector3> m_translation_keys;
+	Vector<int16_t> m_rotation_keys;
+	Vector<Vector3> m_scale_keys;
+	size_t m_translation_stride = 0;
+	size_t m_rotation_stride = 0;
+	size_t m_scale_stride = 0;
+};
+
+NAMESPACE_END
+
+#endif //__ANIMATION_CLIP_H__
\ No newline at end of file
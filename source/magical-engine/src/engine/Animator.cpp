@@ -0,0 +1,140 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "Animator.h"
+
+NAMESPACE_MAGICAL
+
+static Object* findDescendant( Object* root, const string& name )
+{
+	if( root->getName() == name )
+		return root;
+
+	for( size_t i = 0; i < root->childCount(); ++i )
+	{
+		Object* ret = findDescendant( root->childAtIndex( i ), name );
+		if( ret )
+			return ret;
+	}
+	return nullptr;
+}
+
+Animator::Animator( void )
+{
+
+}
+
+Animator::~Animator( void )
+{
+	unbind();
+	SAFE_RELEASE( m_clip );
+}
+
+Ptr<Animator> Animator::create( AnimationClip* clip, Object* root )
+{
+	Animator* ret = new Animator();
+	MAGICAL_ASSERT( ret, "new Animator() failed" );
+	ret->setClip( clip );
+	ret->bind( root );
+	return Ptr<Animator>( Ptrctor<Animator>( ret ) );
+}
+
+void Animator::setClip( AnimationClip* clip )
+{
+	// 轨道按下标对应绑定的对象，换了片段之后旧的绑定失效，需要重新bind
+	if( clip != m_clip )
+		unbind();
+
+	SAFE_ASSIGN( m_clip, clip );
+	m_time = 0.0f;
+}
+
+void Animator::bind( Object* root )
+{
+	MAGICAL_ASSERT( m_clip, "Invalid clip!" );
+	MAGICAL_ASSERT( root, "Invalid root!" );
+
+	unbind();
+	m_targets.resize( m_clip->trackCount(), nullptr );
+	for( size_t i = 0; i < m_targets.size(); ++i )
+	{
+		Object* target = findDescendant( root, m_clip->getTrackName( i ) );
+		SAFE_RETAIN( target );
+		m_targets[i] = target;
+	}
+}
+
+void Animator::unbind( void )
+{
+	for( auto target : m_targets )
+	{
+		SAFE_RELEASE( target );
+	}
+	m_targets.clear();
+}
+
+void Animator::setTime( float time )
+{
+	MAGICAL_ASSERT( m_clip, "Invalid clip!" );
+
+	float duration = m_clip->getDuration();
+	if( duration <= 0.0f )
+		m_time = 0.0f;
+	else if( m_loop )
+		m_time = Math::max( 0.0f, time - floorf( time / duration ) * duration );
+	else
+		m_time = Math::max( 0.0f, Math::min( time, duration ) );
+}
+
+bool Animator::isFinished( void ) const
+{
+	return !m_loop && m_clip && m_time >= m_clip->getDuration();
+}
+
+void Animator::update( float dt )
+{
+	if( !m_clip )
+		return;
+
+	setTime( m_time + dt * m_speed );
+	apply();
+}
+
+void Animator::apply( void )
+{
+	if( !m_clip )
+		return;
+
+	m_clip->sample( m_pose, m_time );
+
+	// 绑定之后片段可能被重新load，轨道数以采样结果为准
+	size_t count = Math::min( m_targets.size(), m_pose.translations.size() );
+	for( size_t i = 0; i < count; ++i )
+	{
+		Object* target = m_targets[i];
+		if( target )
+			target->setTrs( m_pose.translations[i], m_pose.rotations[i], m_pose.scales[i] );
+	}
+}
+
+NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,77 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __ANIMATOR_H__
+#define __ANIMATOR_H__
+
+#include "magical-macros.h"
+#include "Common.h"
+#include "Reference.h"
+#include "Vector.h"
+#include "AnimationClip.h"
+#include "Object.h"
+
+NAMESPACE_MAGICAL
+
+/*
+播放动画片段，将采样结果写入按轨道名绑定的对象的局部变换
+*/
+class Animator : public Reference
+{
+public:
+	Animator( void );
+	virtual ~Animator( void );
+	static Ptr<Animator> create( AnimationClip* clip, Object* root );
+
+public:
+	// 更换片段会解除绑定
+	void setClip( AnimationClip* clip );
+	AnimationClip* getClip( void ) const { return m_clip; }
+	void bind( Object* root );
+	void unbind( void );
+
+public:
+	void setLoop( bool loop ) { m_loop = loop; }
+	bool isLoop( void ) const { return m_loop; }
+	void setSpeed( float speed ) { m_speed = speed; }
+	float getSpeed( void ) const { return m_speed; }
+	void setTime( float time );
+	float getTime( void ) const { return m_time; }
+	bool isFinished( void ) const;
+
+public:
+	void update( float dt );
+	void apply( void );
+
+protected:
+	AnimationClip* m_clip = nullptr;
+	Vector<Object*> m_targets;
+	AnimationPose m_pose;
+	float m_time = 0.0f;
+	float m_speed = 1.0f;
+	bool m_loop = true;
+};
+
+NAMESPACE_END
+
+#endif //__ANIMATOR_H__
\ No newline at end of file
@@ -0,0 +1,518 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "BoundingVolumeTree.h"
+#include <algorithm>
+
+NAMESPACE_MAGICAL
+
+static const int _sah_bin_count = 12;
+
+BoundingVolumeTree::BoundingVolumeTree( void )
+{
+
+}
+
+BoundingVolumeTree::~BoundingVolumeTree( void )
+{
+
+}
+
+int BoundingVolumeTree::insert( const Box& box, void* user_data )
+{
+	int leaf = allocNode();
+	Node& node = m_nodes[ leaf ];
+	node.box.min = box.min - m_margin;
+	node.box.max = box.max + m_margin;
+	node.user_data = user_data;
+	node.height = 0;
+
+	insertLeaf( leaf );
+	++m_leaf_count;
+	++m_modifications;
+	return leaf;
+}
+
+void BoundingVolumeTree::remove( int proxy )
+{
+	MAGICAL_ASSERT( 0 <= proxy && proxy < (int) m_nodes.size() && m_nodes[ proxy ].isLeaf(), "Invalid proxy!" );
+
+	removeLeaf( proxy );
+	freeNode( proxy );
+	--m_leaf_count;
+	++m_modifications;
+}
+
+bool BoundingVolumeTree::move( int proxy, const Box& box )
+{
+	MAGICAL_ASSERT( 0 <= proxy && proxy < (int) m_nodes.size() && m_nodes[ proxy ].isLeaf(), "Invalid proxy!" );
+
+	Node& node = m_nodes[ proxy ];
+	if( contains( node.box, box ) )
+		return false;
+
+	node.box.min = box.min - m_margin;
+	node.box.max = box.max + m_margin;
+	refitAncestors( node.parent );
+	++m_modifications;
+	return true;
+}
+
+void BoundingVolumeTree::rebuild( void )
+{
+	Vector<int> leaves;
+	leaves.reserve( m_leaf_count );
+
+	for( int i = 0; i < (int) m_nodes.size(); ++i )
+	{
+		Node& node = m_nodes[i];
+		if( node.height < 0 )
+			continue;
+
+		if( node.isLeaf() )
+		{
+			node.parent = NullNode;
+			leaves.push_back( i );
+		}
+		else
+		{
+			freeNode( i );
+		}
+	}
+
+	m_root = NullNode;
+	m_modifications = 0;
+	if( !leaves.empty() )
+	{
+		m_root = buildRange( leaves.data(), leaves.size() );
+		m_nodes[ m_root ].parent = NullNode;
+	}
+}
+
+void BoundingVolumeTree::clear( void )
+{
+	m_nodes.clear();
+	m_root = NullNode;
+	m_free_list = NullNode;
+	m_leaf_count = 0;
+	m_modifications = 0;
+}
+
+void BoundingVolumeTree::QueryStack::grow( void )
+{
+	size_t capacity = m_capacity * 2;
+	int* data = (int*) ::malloc( capacity * sizeof( int ) );
+	MAGICAL_ASSERT( data, "(int*) ::malloc( capacity * sizeof( int ) );" );
+	memcpy( data, m_data, m_size * sizeof( int ) );
+	if( m_data != m_local )
+		::free( m_data );
+	m_data = data;
+	m_capacity = capacity;
+}
+
+int BoundingVolumeTree::getHeight( void ) const
+{
+	return m_root == NullNode ? 0 : m_nodes[ m_root ].height;
+}
+
+float BoundingVolumeTree::getAreaRatio( void ) const
+{
+	if( m_root == NullNode )
+		return 0.0f;
+
+	float root_area = area( m_nodes[ m_root ].box );
+	if( root_area <= 0.0f )
+		return 0.0f;
+
+	float total = 0.0f;
+	for( const auto& node : m_nodes )
+	{
+		if( node.height > 0 )
+			total += area( node.box );
+	}
+	return total / root_area;
+}
+
+void* BoundingVolumeTree::getUserData( int proxy ) const
+{
+	MAGICAL_ASSERT( 0 <= proxy && proxy < (int) m_nodes.size(), "Invalid proxy!" );
+	return m_nodes[ proxy ].user_data;
+}
+
+const Box& BoundingVolumeTree::getFatBox( int proxy ) const
+{
+	MAGICAL_ASSERT( 0 <= proxy && proxy < (int) m_nodes.size(), "Invalid proxy!" );
+	return m_nodes[ proxy ].box;
+}
+
+int BoundingVolumeTree::allocNode( void )
+{
+	int index;
+	if( m_free_list != NullNode )
+	{
+		index = m_free_list;
+		m_free_list = m_nodes[ index ].parent;
+	}
+	else
+	{
+		index = (int) m_nodes.size();
+		m_nodes.push_back( Node() );
+	}
+
+	Node& node = m_nodes[ index ];
+	node.user_data = nullptr;
+	node.parent = NullNode;
+	node.child1 = NullNode;
+	node.child2 = NullNode;
+	node.height = 0;
+	return index;
+}
+
+void BoundingVolumeTree::freeNode( int index )
+{
+	Node& node = m_nodes[ index ];
+	node.parent = m_free_list;
+	node.height = -1;
+	m_free_list = index;
+}
+
+void BoundingVolumeTree::insertLeaf( int leaf )
+{
+	if( m_root == NullNode )
+	{
+		m_root = leaf;
+		m_nodes[ leaf ].parent = NullNode;
+		return;
+	}
+
+	// 自根向下选择使表面积增量最小的兄弟节点
+	Box leaf_box = m_nodes[ leaf ].box;
+	int index = m_root;
+	while( !m_nodes[ index ].isLeaf() )
+	{
+		const Node& node = m_nodes[ index ];
+		const Node& child1 = m_nodes[ node.child1 ];
+		const Node& child2 = m_nodes[ node.child2 ];
+
+		float node_area = area( node.box );
+		float combined_area = area( Box::merge( node.box, leaf_box ) );
+		float cost = 2.0f * combined_area;
+		float inheritance_cost = 2.0f * ( combined_area - node_area );
+
+		float cost1 = area( Box::merge( leaf_box, child1.box ) ) + inheritance_cost;
+		if( !child1.isLeaf() )
+			cost1 -= area( child1.box );
+
+		float cost2 = area( Box::merge( leaf_box, child2.box ) ) + inheritance_cost;
+		if( !child2.isLeaf() )
+			cost2 -= area( child2.box );
+
+		if( cost < cost1 && cost < cost2 )
+			break;
+
+		index = cost1 < cost2 ? node.child1 : node.child2;
+	}
+
+	int sibling = index;
+	int old_parent = m_nodes[ sibling ].parent;
+	int new_parent = allocNode();
+
+	Node& parent = m_nodes[ new_parent ];
+	parent.parent = old_parent;
+	parent.box = Box::merge( leaf_box, m_nodes[ sibling ].box );
+	parent.height = m_nodes[ sibling ].height + 1;
+	parent.child1 = sibling;
+	parent.child2 = leaf;
+
+	if( old_parent != NullNode )
+	{
+		Node& grand = m_nodes[ old_parent ];
+		if( grand.child1 == sibling )
+			grand.child1 = new_parent;
+		else
+			grand.child2 = new_parent;
+	}
+	else
+	{
+		m_root = new_parent;
+	}
+
+	m_nodes[ sibling ].parent = new_parent;
+	m_nodes[ leaf ].parent = new_parent;
+
+	// 兄弟是较高的子树时新的父节点本身就不平衡，从它开始旋转
+	refitAncestors( new_parent );
+}
+
+void BoundingVolumeTree::removeLeaf( int leaf )
+{
+	if( leaf == m_root )
+	{
+		m_root = NullNode;
+		return;
+	}
+
+	int parent = m_nodes[ leaf ].parent;
+	int grand = m_nodes[ parent ].parent;
+	int sibling = m_nodes[ parent ].child1 == leaf ? m_nodes[ parent ].child2 : m_nodes[ parent ].child1;
+
+	if( grand != NullNode )
+	{
+		Node& node = m_nodes[ grand ];
+		if( node.child1 == parent )
+			node.child1 = sibling;
+		else
+			node.child2 = sibling;
+
+		m_nodes[ sibling ].parent = grand;
+		freeNode( parent );
+		refitAncestors( grand );
+	}
+	else
+	{
+		m_root = sibling;
+		m_nodes[ sibling ].parent = NullNode;
+		freeNode( parent );
+	}
+}
+
+void BoundingVolumeTree::refitAncestors( int index )
+{
+	while( index != NullNode )
+	{
+		// 包围盒重叠时SAH选不出更优的兄弟，不旋转的话连续插入会退化成链表
+		index = balance( index );
+
+		Node& node = m_nodes[ index ];
+		const Node& child1 = m_nodes[ node.child1 ];
+		const Node& child2 = m_nodes[ node.child2 ];
+
+		Box::merge( node.box, child1.box, child2.box );
+		node.height = 1 + Math::max( child1.height, child2.height );
+		index = node.parent;
+	}
+}
+
+/*
+子树高度差超过1时把较高的子节点旋转上来，返回该位置上新的子树根
+*/
+int BoundingVolumeTree::balance( int a )
+{
+	Node& node_a = m_nodes[ a ];
+	if( node_a.isLeaf() || node_a.height < 2 )
+		return a;
+
+	int b = node_a.child1;
+	int c = node_a.child2;
+	int diff = m_nodes[ c ].height - m_nodes[ b ].height;
+	if( diff >= -1 && diff <= 1 )
+		return a;
+
+	// 让b为较高的子节点，c为较低的
+	if( diff > 0 )
+		std::swap( b, c );
+
+	Node& node_b = m_nodes[ b ];
+	Node& node_c = m_nodes[ c ];
+	int f = node_b.child1;
+	int g = node_b.child2;
+	if( m_nodes[ f ].height < m_nodes[ g ].height )
+		std::swap( f, g );
+
+	// b取代a的位置，a保留c和b较矮的子节点g，b的子节点为a和f
+	node_b.parent = node_a.parent;
+	if( node_b.parent != NullNode )
+	{
+		Node& parent = m_nodes[ node_b.parent ];
+		if( parent.child1 == a )
+			parent.child1 = b;
+		else
+			parent.child2 = b;
+	}
+	else
+	{
+		m_root = b;
+	}
+
+	node_a.parent = b;
+	node_a.child1 = c;
+	node_a.child2 = g;
+	m_nodes[ g ].parent = a;
+	Box::merge( node_a.box, node_c.box, m_nodes[ g ].box );
+	node_a.height = 1 + Math::max( node_c.height, m_nodes[ g ].height );
+
+	node_b.child1 = a;
+	node_b.child2 = f;
+	m_nodes[ f ].parent = b;
+	Box::merge( node_b.box, node_a.box, m_nodes[ f ].box );
+	node_b.height = 1 + Math::max( node_a.height, m_nodes[ f ].height );
+	return b;
+}
+
+/*
+按叶节点包围盒中心在最长轴上分桶，取SAH代价最小的分割位置
+*/
+int BoundingVolumeTree::buildRange( int* leaves, size_t count )
+{
+	if( count == 1 )
+		return leaves[0];
+
+	Box bounds = m_nodes[ leaves[0] ].box;
+	Box centroids( m_nodes[ leaves[0] ].box.center(), m_nodes[ leaves[0] ].box.center() );
+	for( size_t i = 1; i < count; ++i )
+	{
+		const Box& box = m_nodes[ leaves[i] ].box;
+		bounds.merge( box );
+		centroids.expandBy( box.center() );
+	}
+
+	Vector3 extent = centroids.max - centroids.min;
+	int axis = extent.x > extent.y ? ( extent.x > extent.z ? 0 : 2 ) : ( extent.y > extent.z ? 1 : 2 );
+	float axis_min = centroids.min[ axis ];
+	float axis_extent = extent[ axis ];
+
+	size_t split = count / 2;
+	if( axis_extent > 0.0f )
+	{
+		Box bin_boxes[ _sah_bin_count ];
+		size_t bin_counts[ _sah_bin_count ] = { 0 };
+		float scale = _sah_bin_count / axis_extent;
+
+		for( size_t i = 0; i < count; ++i )
+		{
+			const Box& box = m_nodes[ leaves[i] ].box;
+			int bin = Math::min( (int)( ( box.center()[ axis ] - axis_min ) * scale ), _sah_bin_count - 1 );
+			bin_boxes[ bin ] = bin_counts[ bin ] == 0 ? box : Box::merge( bin_boxes[ bin ], box );
+			++bin_counts[ bin ];
+		}
+
+		// 自右向左累计各分割位置右侧的表面积与数量
+		float right_areas[ _sah_bin_count ];
+		size_t right_count = 0;
+		Box right_box;
+		for( int i = _sah_bin_count - 1; i > 0; --i )
+		{
+			if( bin_counts[i] > 0 )
+			{
+				right_box = right_count == 0 ? bin_boxes[i] : Box::merge( right_box, bin_boxes[i] );
+				right_count += bin_counts[i];
+			}
+			right_areas[i] = right_count * ( right_count > 0 ? area( right_box ) : 0.0f );
+		}
+
+		int best_bin = NullNode;
+		float best_cost = FLT_MAX;
+		size_t left_count = 0;
+		Box left_box;
+		for( int i = 0; i < _sah_bin_count - 1; ++i )
+		{
+			if( bin_counts[i] > 0 )
+			{
+				left_box = left_count == 0 ? bin_boxes[i] : Box::merge( left_box, bin_boxes[i] );
+				left_count += bin_counts[i];
+			}
+
+			if( left_count == 0 || left_count == count )
+				continue;
+
+			float cost = left_count * area( left_box ) + right_areas[ i + 1 ];
+			if( cost < best_cost )
+			{
+				best_cost = cost;
+				best_bin = i;
+			}
+		}
+
+		if( best_bin != NullNode )
+		{
+			int* mid = std::partition( leaves, leaves + count, [ & ]( int leaf ) {
+				int bin = Math::min( (int)( ( m_nodes[ leaf ].box.center()[ axis ] - axis_min ) * scale ), _sah_bin_count - 1 );
+				return bin <= best_bin;
+			} );
+			split = mid - leaves;
+		}
+	}
+
+	int child1 = buildRange( leaves, split );
+	int child2 = buildRange( leaves + split, count - split );
+	int index = allocNode();
+
+	Node& node = m_nodes[ index ];
+	node.child1 = child1;
+	node.child2 = child2;
+	node.height = 1 + Math::max( m_nodes[ child1 ].height, m_nodes[ child2 ].height );
+	node.box = bounds;
+	m_nodes[ child1 ].parent = index;
+	m_nodes[ child2 ].parent = index;
+	return index;
+}
+
+float BoundingVolumeTree::area( const Box& box )
+{
+	float x = box.max.x - box.min.x;
+	float y = box.max.y - box.min.y;
+	float z = box.max.z - box.min.z;
+	return 2.0f * ( x * y + y * z + z * x );
+}
+
+bool BoundingVolumeTree::contains( const Box& outer, const Box& inner )
+{
+	return
+		outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+		outer.max.x >= inner.max.x && outer.max.y >= inner.max.y && outer.max.z >= inner.max.z;
+}
+
+bool BoundingVolumeTree::overlaps( const Box& a, const Box& b )
+{
+	return
+		a.min.x <= b.max.x && a.max.x >= b.min.x &&
+		a.min.y <= b.max.y && a.max.y >= b.min.y &&
+		a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+bool BoundingVolumeTree::raycastBox( float& distance, const Vector3& origin, const Vector3& inv_dir, const Box& box, float max_distance )
+{
+	float t1 = ( box.min.x - origin.x ) * inv_dir.x;
+	float t2 = ( box.max.x - origin.x ) * inv_dir.x;
+	float tmin = Math::min( t1, t2 );
+	float tmax = Math::max( t1, t2 );
+
+	t1 = ( box.min.y - origin.y ) * inv_dir.y;
+	t2 = ( box.max.y - origin.y ) * inv_dir.y;
+	tmin = Math::max( tmin, Math::min( t1, t2 ) );
+	tmax = Math::min( tmax, Math::max( t1, t2 ) );
+
+	t1 = ( box.min.z - origin.z ) * inv_dir.z;
+	t2 = ( box.max.z - origin.z ) * inv_dir.z;
+	tmin = Math::max( tmin, Math::min( t1, t2 ) );
+	tmax = Math::min( tmax, Math::max( t1, t2 ) );
+
+	tmin = Math::max( tmin, 0.0f );
+	if( tmax < tmin || tmin > max_distance )
+		return false;
+
+	distance = tmin;
+	return true;
+}
+
+NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,140 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __BOUNDING_VOLUME_TREE_H__
+#define __BOUNDING_VOLUME_TREE_H__
+
+#include "magical-macros.h"
+#include "magical-math.h"
+#include "Common.h"
+#include "Vector.h"
+
+NAMESPACE_MAGICAL
+
+/*
+动态AABB树
+
+叶节点保存外扩了margin的包围盒，对象在外扩范围内移动时不需要修改树，
+超出范围时只更新叶节点并沿父节点向上重新合并包围盒，合并时按高度旋转保持平衡，
+插入时按表面积启发(SAH)选择兄弟节点，rebuild则按SAH分桶自顶向下重建所有内部节点，
+叶节点的索引即proxy，在重建前后保持不变
+*/
+class BoundingVolumeTree
+{
+public:
+	enum : int { NullNode = -1 };
+
+public:
+	BoundingVolumeTree( void );
+	~BoundingVolumeTree( void );
+
+public:
+	int insert( const Box& box, void* user_data );
+	void remove( int proxy );
+	bool move( int proxy, const Box& box );
+	void rebuild( void );
+	void clear( void );
+
+public:
+	void setMargin( float margin ) { m_margin = margin; }
+	float getMargin( void ) const { return m_margin; }
+	size_t leafCount( void ) const { return m_leaf_count; }
+	size_t modifications( void ) const { return m_modifications; }
+	int getHeight( void ) const;
+	float getAreaRatio( void ) const;
+	void* getUserData( int proxy ) const;
+	const Box& getFatBox( int proxy ) const;
+
+public:
+	template< class TCallback > void queryBox( const Box& box, TCallback callback ) const;
+	template< class TCallback > void querySphere( const Sphere& sphere, TCallback callback ) const;
+	template< class TCallback > void queryFrustum( const Frustum& frustum, TCallback callback ) const;
+	template< class TCallback > void raycast( const Ray& ray, float max_distance, TCallback callback ) const;
+
+private:
+	struct Node
+	{
+		Box box;
+		void* user_data;
+		int parent;
+		int child1;
+		int child2;
+		int height;
+
+		bool isLeaf( void ) const { return child1 == NullNode; }
+	};
+
+	/*
+	遍历用的栈，每次查询各自一个，回调中可以再次查询，多个线程也可以同时查询，
+	深度不超过LocalCapacity时不分配内存
+	*/
+	class QueryStack
+	{
+	public:
+		QueryStack( void ) : m_data( m_local ) {}
+		~QueryStack( void ) { if( m_data != m_local ) ::free( m_data ); }
+		QueryStack( const QueryStack& ) = delete;
+		QueryStack& operator=( const QueryStack& ) = delete;
+
+	public:
+		bool empty( void ) const { return m_size == 0; }
+		void push( int node ) { if( m_size == m_capacity ) grow(); m_data[ m_size ++ ] = node; }
+		int pop( void ) { return m_data[ -- m_size ]; }
+
+	private:
+		void grow( void );
+
+	private:
+		enum : size_t { LocalCapacity = 64 };
+		int m_local[ LocalCapacity ];
+		int* m_data;
+		size_t m_size = 0;
+		size_t m_capacity = LocalCapacity;
+	};
+
+	int allocNode( void );
+	void freeNode( int node );
+	void insertLeaf( int leaf );
+	void removeLeaf( int leaf );
+	void refitAncestors( int node );
+	int balance( int node );
+	int buildRange( int* leaves, size_t count );
+	static float area( const Box& box );
+	static bool contains( const Box& outer, const Box& inner );
+	static bool overlaps( const Box& a, const Box& b );
+	static bool raycastBox( float& distance, const Vector3& origin, const Vector3& inv_dir, const Box& box, float max_distance );
+
+private:
+	Vector<Node> m_nodes;
+	int m_root = NullNode;
+	int m_free_list = NullNode;
+	size_t m_leaf_count = 0;
+	size_t m_modifications = 0;
+	float m_margin = 0.1f;
+};
+
+#include "BoundingVolumeTree.inl"
+
+NAMESPACE_END
+
+#endif //__BOUNDING_VOLUME_TREE_H__
\ No newline at end of file
@@ -0,0 +1,154 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+
+template< class TCallback >
+void BoundingVolumeTree::queryBox( const Box& box, TCallback callback ) const
+{
+	if( m_root == NullNode )
+		return;
+
+	QueryStack stack;
+	stack.push( m_root );
+
+	while( !stack.empty() )
+	{
+		int index = stack.pop();
+		const Node& node = m_nodes[ index ];
+
+		if( !overlaps( node.box, box ) )
+			continue;
+
+		if( node.isLeaf() )
+		{
+			if( !callback( index ) )
+				return;
+		}
+		else
+		{
+			stack.push( node.child1 );
+			stack.push( node.child2 );
+		}
+	}
+}
+
+template< class TCallback >
+void BoundingVolumeTree::querySphere( const Sphere& sphere, TCallback callback ) const
+{
+	if( m_root == NullNode )
+		return;
+
+	QueryStack stack;
+	stack.push( m_root );
+
+	while( !stack.empty() )
+	{
+		int index = stack.pop();
+		const Node& node = m_nodes[ index ];
+
+		if( !sphere.intersects( node.box ) )
+			continue;
+
+		if( node.isLeaf() )
+		{
+			if( !callback( index ) )
+				return;
+		}
+		else
+		{
+			stack.push( node.child1 );
+			stack.push( node.child2 );
+		}
+	}
+}
+
+template< class TCallback >
+void BoundingVolumeTree::queryFrustum( const Frustum& frustum, TCallback callback ) const
+{
+	if( m_root == NullNode )
+		return;
+
+	QueryStack stack;
+	stack.push( m_root );
+
+	while( !stack.empty() )
+	{
+		int index = stack.pop();
+		const Node& node = m_nodes[ index ];
+
+		if( !frustum.containsBox( node.box ) )
+			continue;
+
+		if( node.isLeaf() )
+		{
+			if( !callback( index ) )
+				return;
+		}
+		else
+		{
+			stack.push( node.child1 );
+			stack.push( node.child2 );
+		}
+	}
+}
+
+/*
+callback( proxy, max_distance )返回新的最大距离，返回值小于等于0时结束查询，
+返回原值则继续按原距离查询，返回命中距离则裁剪更远的节点
+*/
+template< class TCallback >
+void BoundingVolumeTree::raycast( const Ray& ray, float max_distance, TCallback callback ) const
+{
+	if( m_root == NullNode )
+		return;
+
+	Vector3 inv_dir(
+		ray.dx != 0.0f ? 1.0f / ray.dx : FLT_MAX,
+		ray.dy != 0.0f ? 1.0f / ray.dy : FLT_MAX,
+		ray.dz != 0.0f ? 1.0f / ray.dz : FLT_MAX );
+
+	QueryStack stack;
+	stack.push( m_root );
+
+	float distance;
+	while( !stack.empty() )
+	{
+		int index = stack.pop();
+		const Node& node = m_nodes[ index ];
+
+		if( !raycastBox( distance, ray.origin, inv_dir, node.box, max_distance ) )
+			continue;
+
+		if( node.isLeaf() )
+		{
+			max_distance = callback( index, max_distance );
+			if( max_distance <= 0.0f )
+				return;
+		}
+		else
+		{
+			stack.push( node.child1 );
+			stack.push( node.child2 );
+		}
+	}
+}
\ No newline at end of file
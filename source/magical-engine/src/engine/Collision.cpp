@@ -0,0 +1,623 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "Collision.h"
+
+#ifdef MAGICAL_SSE2
+#include <emmintrin.h>
+#endif
+
+NAMESPACE_MAGICAL
+
+/*
+边轴的穿透深度需小于最佳面轴的该比例才采用边轴，
+面接触能生成多个接触点，数值上更稳定
+*/
+static const float RelativeTolerance = 0.95f;
+
+/*
+凸体的统一视图
+顶点按分量分开存放并补齐到4的倍数（以第0个顶点填充），便于SIMD投影
+faces为候选分离轴的面法线，edges为单位化的边方向
+多边形除自身法线外还把各边在平面内的外法线作为侧面法线，处理共面的情况
+*/
+struct ConvexView
+{
+	enum : int
+	{
+		MaxVertices = 8,
+		MaxFaces = 1 + Polygon::MaxVertices,
+		MaxEdges = Polygon::MaxVertices,
+	};
+
+	float xs[ MaxVertices ];
+	float ys[ MaxVertices ];
+	float zs[ MaxVertices ];
+	int count;
+	Vector3 faces[ MaxFaces ];
+	int face_count;
+	Vector3 edges[ MaxEdges ];
+	int edge_count;
+	const OrientBox* box;
+	const Polygon* polygon;
+};
+
+/*
+参考面与入射面，顶点绕normal逆时针排列，normal指向面的外侧
+*/
+struct Face
+{
+	Vector3 points[ Polygon::MaxVertices ];
+	Vector3 normal;
+	int count;
+};
+
+static void setVertices( ConvexView& view, const Vector3* vertices, int count )
+{
+	int padded = ( count + 3 ) & ~3;
+	for( int i = 0; i < padded; ++i )
+	{
+		const Vector3& v = vertices[ i < count ? i : 0 ];
+		view.xs[i] = v.x;
+		view.ys[i] = v.y;
+		view.zs[i] = v.z;
+	}
+	view.count = padded;
+}
+
+static void makeView( ConvexView& view, const OrientBox& box )
+{
+	Vector3 vertices[8];
+	box.getVertices( vertices );
+	setVertices( view, vertices, 8 );
+
+	view.faces[0] = view.edges[0] = box.axis_x;
+	view.faces[1] = view.edges[1] = box.axis_y;
+	view.faces[2] = view.edges[2] = box.axis_z;
+	view.face_count = 3;
+	view.edge_count = 3;
+	view.box = &box;
+	view.polygon = nullptr;
+}
+
+static void makeView( ConvexView& view, const Polygon& polygon )
+{
+	debugassert( polygon.isValid(), "Invalid polygon!" );
+	setVertices( view, polygon.vertices, polygon.count );
+
+	view.faces[0] = polygon.normal;
+	for( int i = 0; i < polygon.count; ++i )
+	{
+		Vector3 e = polygon.vertices[ i + 1 < polygon.count ? i + 1 : 0 ] - polygon.vertices[i];
+		e.normalize();
+		view.edges[i] = e;
+		view.faces[ i + 1 ] = Vector3::cross( e, polygon.normal );
+	}
+	view.face_count = 1 + polygon.count;
+	view.edge_count = polygon.count;
+	view.box = nullptr;
+	view.polygon = &polygon;
+}
+
+/*
+顶点在轴上投影区间的最小值与最大值
+*/
+static inline void project( float& min, float& max, const ConvexView& view, const Vector3& axis )
+{
+#ifdef MAGICAL_SSE2
+	const __m128 ax = _mm_set1_ps( axis.x );
+	const __m128 ay = _mm_set1_ps( axis.y );
+	const __m128 az = _mm_set1_ps( axis.z );
+	__m128 vmin = _mm_set1_ps( FLT_MAX );
+	__m128 vmax = _mm_set1_ps( -FLT_MAX );
+
+	for( int i = 0; i < view.count; i += 4 )
+	{
+		__m128 d = _mm_add_ps(
+			_mm_add_ps( _mm_mul_ps( _mm_loadu_ps( view.xs + i ), ax ), _mm_mul_ps( _mm_loadu_ps( view.ys + i ), ay ) ),
+			_mm_mul_ps( _mm_loadu_ps( view.zs + i ), az ) );
+		vmin = _mm_min_ps( vmin, d );
+		vmax = _mm_max_ps( vmax, d );
+	}
+
+	vmin = _mm_min_ps( vmin, _mm_shuffle_ps( vmin, vmin, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+	vmin = _mm_min_ps( vmin, _mm_shuffle_ps( vmin, vmin, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+	vmax = _mm_max_ps( vmax, _mm_shuffle_ps( vmax, vmax, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+	vmax = _mm_max_ps( vmax, _mm_shuffle_ps( vmax, vmax, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+	min = _mm_cvtss_f32( vmin );
+	max = _mm_cvtss_f32( vmax );
+#else
+	min = FLT_MAX;
+	max = -FLT_MAX;
+	for( int i = 0; i < view.count; ++i )
+	{
+		float d = view.xs[i] * axis.x + view.ys[i] * axis.y + view.zs[i] * axis.z;
+		min = Math::min( min, d );
+		max = Math::max( max, d );
+	}
+#endif
+}
+
+/*
+按索引取候选轴，依次为a的面法线、b的面法线、a与b边方向的叉积
+两边接近平行时叉积退化，返回false跳过该轴
+*/
+static inline bool axisAt( Vector3& out, int index, const ConvexView& a, const ConvexView& b )
+{
+	if( index < a.face_count )
+	{
+		out = a.faces[ index ];
+		return true;
+	}
+
+	index -= a.face_count;
+	if( index < b.face_count )
+	{
+		out = b.faces[ index ];
+		return true;
+	}
+
+	index -= b.face_count;
+	out = Vector3::cross( a.edges[ index / b.edge_count ], b.edges[ index % b.edge_count ] );
+
+	float len_sq = out.lengthSq();
+	if( len_sq < Math::VectorEpsilon )
+		return false;
+
+	out *= 1.0f / Math::sqrt( len_sq );
+	return true;
+}
+
+/*
+沿轴的穿透深度，为负表示该轴分离，normal取从a指向b的方向
+*/
+static inline float penetration( Vector3& normal, const ConvexView& a, const ConvexView& b, const Vector3& axis )
+{
+	float min_a, max_a, min_b, max_b;
+	project( min_a, max_a, a, axis );
+	project( min_b, max_b, b, axis );
+
+	float d1 = max_a - min_b;
+	float d2 = max_b - min_a;
+	if( d1 <= d2 )
+	{
+		normal = axis;
+		return d1;
+	}
+
+	normal = -axis;
+	return d2;
+}
+
+/*
+凸体上法线与dir最接近的面
+*/
+static void supportFace( Face& out, const ConvexView& view, const Vector3& dir )
+{
+	if( view.box )
+	{
+		const OrientBox& box = *view.box;
+		const Vector3* axes[3] = { &box.axis_x, &box.axis_y, &box.axis_z };
+		const float extents[3] = { box.extents.x, box.extents.y, box.extents.z };
+
+		int k = 0;
+		float best = ::fabsf( Vector3::dot( dir, *axes[0] ) );
+		for( int i = 1; i < 3; ++i )
+		{
+			float d = ::fabsf( Vector3::dot( dir, *axes[i] ) );
+			if( d > best )
+			{
+				best = d;
+				k = i;
+			}
+		}
+
+		int k1 = ( k + 1 ) % 3;
+		int k2 = ( k + 2 ) % 3;
+		float s = Vector3::dot( dir, *axes[k] ) < 0.0f ? -1.0f : 1.0f;
+		Vector3 c = box.center + *axes[k] * ( s * extents[k] );
+		Vector3 u = *axes[ k1 ] * extents[ k1 ];
+		Vector3 v = *axes[ k2 ] * extents[ k2 ];
+
+		// axes[k1]×axes[k2]=axes[k]，朝向负方向的面需要反转顶点顺序
+		out.normal = *axes[k] * s;
+		out.count = 4;
+		out.points[0] = c + u + v;
+		out.points[2] = c - u - v;
+		out.points[ s > 0.0f ? 1 : 3 ] = c - u + v;
+		out.points[ s > 0.0f ? 3 : 1 ] = c + u - v;
+	}
+	else
+	{
+		const Polygon& polygon = *view.polygon;
+		bool front = Vector3::dot( dir, polygon.normal ) >= 0.0f;
+
+		out.normal = front ? polygon.normal : -polygon.normal;
+		out.count = polygon.count;
+		for( int i = 0; i < polygon.count; ++i )
+		{
+			out.points[i] = polygon.vertices[ front ? i : polygon.count - 1 - i ];
+		}
+	}
+}
+
+/*
+凸体上方向为第index条边、沿dir最远的边
+*/
+static void supportEdge( Vector3& p, Vector3& q, const ConvexView& view, int index, const Vector3& dir )
+{
+	if( view.box )
+	{
+		const OrientBox& box = *view.box;
+		const Vector3* axes[3] = { &box.axis_x, &box.axis_y, &box.axis_z };
+		const float extents[3] = { box.extents.x, box.extents.y, box.extents.z };
+
+		Vector3 c = box.center;
+		for( int i = 0; i < 3; ++i )
+		{
+			if( i != index )
+				c += *axes[i] * ( Vector3::dot( dir, *axes[i] ) < 0.0f ? -extents[i] : extents[i] );
+		}
+
+		p = c - *axes[ index ] * extents[ index ];
+		q = c + *axes[ index ] * extents[ index ];
+	}
+	else
+	{
+		const Polygon& polygon = *view.polygon;
+		p = polygon.vertices[ index ];
+		q = polygon.vertices[ index + 1 < polygon.count ? index + 1 : 0 ];
+	}
+}
+
+/*
+以平面dot(n,p)=offset裁剪凸多边形，保留内侧(dot(n,p)<=offset)部分
+*/
+static int clipPolygon( Vector3* out, const Vector3* in, int count, const Vector3& n, float offset )
+{
+	int out_count = 0;
+	for( int i = 0; i < count; ++i )
+	{
+		const Vector3& p1 = in[i];
+		const Vector3& p2 = in[ i + 1 < count ? i + 1 : 0 ];
+		float d1 = Vector3::dot( n, p1 ) - offset;
+		float d2 = Vector3::dot( n, p2 ) - offset;
+
+		if( d1 <= 0.0f )
+			out[ out_count++ ] = p1;
+		if( ( d1 <= 0.0f ) != ( d2 <= 0.0f ) )
+			out[ out_count++ ] = p1 + ( p2 - p1 ) * ( d1 / ( d1 - d2 ) );
+	}
+	return out_count;
+}
+
+/*
+两线段间的最近点
+*/
+static void closestSegments( Vector3& c1, Vector3& c2, const Vector3& p1, const Vector3& q1, const Vector3& p2, const Vector3& q2 )
+{
+	Vector3 d1 = q1 - p1;
+	Vector3 d2 = q2 - p2;
+	Vector3 r = p1 - p2;
+	float a = Vector3::dot( d1, d1 );
+	float e = Vector3::dot( d2, d2 );
+	float f = Vector3::dot( d2, r );
+	float s = 0.0f;
+	float t = 0.0f;
+
+	if( a > Math::VectorEpsilon && e > Math::VectorEpsilon )
+	{
+		float b = Vector3::dot( d1, d2 );
+		float c = Vector3::dot( d1, r );
+		float denom = a * e - b * b;
+
+		s = denom > Math::VectorEpsilon ? Math::max( 0.0f, Math::min( 1.0f, ( b * f - c * e ) / denom ) ) : 0.0f;
+		t = ( b * s + f ) / e;
+		if( t < 0.0f )
+		{
+			t = 0.0f;
+			s = Math::max( 0.0f, Math::min( 1.0f, -c / a ) );
+		}
+		else if( t > 1.0f )
+		{
+			t = 1.0f;
+			s = Math::max( 0.0f, Math::min( 1.0f, ( b - c ) / a ) );
+		}
+	}
+	else if( e > Math::VectorEpsilon )
+	{
+		t = Math::max( 0.0f, Math::min( 1.0f, f / e ) );
+	}
+	else if( a > Math::VectorEpsilon )
+	{
+		s = Math::max( 0.0f, Math::min( 1.0f, -Vector3::dot( d1, r ) / a ) );
+	}
+
+	c1 = p1 + d1 * s;
+	c2 = p2 + d2 * t;
+}
+
+/*
+接触点多于4个时保留最深的点、离它最远的点，以及在这两点连线两侧围成面积最大的点
+*/
+static int reducePoints( Vector3* points, const float* separations, int count, const Vector3& normal )
+{
+	if( count <= Manifold::MaxPoints )
+		return count;
+
+	int i0 = 0;
+	for( int i = 1; i < count; ++i )
+	{
+		if( separations[i] < separations[ i0 ] )
+			i0 = i;
+	}
+
+	int i1 = i0;
+	float max_dist = 0.0f;
+	for( int i = 0; i < count; ++i )
+	{
+		float d = Vector3::distanceSq( points[i], points[ i0 ] );
+		if( d > max_dist )
+		{
+			max_dist = d;
+			i1 = i;
+		}
+	}
+
+	int i2 = -1;
+	int i3 = -1;
+	float max_area = 0.0f;
+	float min_area = 0.0f;
+	Vector3 e = points[ i1 ] - points[ i0 ];
+	for( int i = 0; i < count; ++i )
+	{
+		float area = Vector3::dot( Vector3::cross( e, points[i] - points[ i0 ] ), normal );
+		if( area > max_area )
+		{
+			max_area = area;
+			i2 = i;
+		}
+		else if( area < min_area )
+		{
+			min_area = area;
+			i3 = i;
+		}
+	}
+
+	Vector3 selected[ Manifold::MaxPoints ];
+	int selected_count = 0;
+	selected[ selected_count++ ] = points[ i0 ];
+	if( i1 != i0 )
+		selected[ selected_count++ ] = points[ i1 ];
+	if( i2 >= 0 )
+		selected[ selected_count++ ] = points[ i2 ];
+	if( i3 >= 0 )
+		selected[ selected_count++ ] = points[ i3 ];
+
+	for( int i = 0; i < selected_count; ++i )
+	{
+		points[i] = selected[i];
+	}
+	return selected_count;
+}
+
+/*
+用参考面的各侧平面裁剪入射面，保留位于参考面内侧的点，
+接触点沿参考面法线移到两表面中间
+*/
+static void faceContact( Manifold& out, const Face& ref, const Face& inc )
+{
+	Vector3 buffer1[ Polygon::MaxVertices * 2 ];
+	Vector3 buffer2[ Polygon::MaxVertices * 2 ];
+	Vector3* input = buffer1;
+	Vector3* output = buffer2;
+
+	int count = inc.count;
+	for( int i = 0; i < count; ++i )
+	{
+		input[i] = inc.points[i];
+	}
+
+	for( int i = 0; i < ref.count && count > 0; ++i )
+	{
+		const Vector3& p = ref.points[i];
+		Vector3 plane = Vector3::cross( ref.points[ i + 1 < ref.count ? i + 1 : 0 ] - p, ref.normal );
+		count = clipPolygon( output, input, count, plane, Vector3::dot( plane, p ) );
+
+		Vector3* temp = input;
+		input = output;
+		output = temp;
+	}
+
+	float offset = Vector3::dot( ref.normal, ref.points[0] );
+	float separations[ Polygon::MaxVertices * 2 ];
+	int kept = 0;
+	for( int i = 0; i < count; ++i )
+	{
+		float s = Vector3::dot( ref.normal, input[i] ) - offset;
+		if( s <= Math::VectorEpsilon )
+		{
+			output[ kept ] = input[i] - ref.normal * ( s * 0.5f );
+			separations[ kept ] = s;
+			++kept;
+		}
+	}
+
+	if( kept == 0 )
+	{
+		// 数值误差导致裁剪结果为空时，退化为入射面上最深的一个顶点
+		int deepest = 0;
+		float min = Vector3::dot( ref.normal, inc.points[0] );
+		for( int i = 1; i < inc.count; ++i )
+		{
+			float d = Vector3::dot( ref.normal, inc.points[i] );
+			if( d < min )
+			{
+				min = d;
+				deepest = i;
+			}
+		}
+
+		out.points[0] = inc.points[ deepest ] - ref.normal * ( ( min - offset ) * 0.5f );
+		out.count = 1;
+		return;
+	}
+
+	kept = reducePoints( output, separations, kept, ref.normal );
+	for( int i = 0; i < kept; ++i )
+	{
+		out.points[i] = output[i];
+	}
+	out.count = kept;
+}
+
+static bool collideConvex( Manifold& out, const ConvexView& a, const ConvexView& b, SatCache* cache )
+{
+	int face_axes = a.face_count + b.face_count;
+	int axis_count = face_axes + a.edge_count * b.edge_count;
+	Vector3 axis, normal;
+
+	// 上一次的分离轴仍然分离时直接返回
+	if( cache && 0 <= cache->axis && cache->axis < axis_count )
+	{
+		if( axisAt( axis, cache->axis, a, b ) && penetration( normal, a, b, axis ) < 0.0f )
+			return false;
+	}
+
+	int face_axis = -1;
+	float face_depth = FLT_MAX;
+	Vector3 face_normal = Vector3::Zero;
+	for( int i = 0; i < face_axes; ++i )
+	{
+		axisAt( axis, i, a, b );
+		float depth = penetration( normal, a, b, axis );
+		if( depth < 0.0f )
+		{
+			if( cache )
+				cache->axis = i;
+			return false;
+		}
+
+		if( depth < face_depth )
+		{
+			face_depth = depth;
+			face_axis = i;
+			face_normal = normal;
+		}
+	}
+
+	int edge_axis = -1;
+	float edge_depth = FLT_MAX;
+	Vector3 edge_normal;
+	for( int i = face_axes; i < axis_count; ++i )
+	{
+		if( !axisAt( axis, i, a, b ) )
+			continue;
+
+		float depth = penetration( normal, a, b, axis );
+		if( depth < 0.0f )
+		{
+			if( cache )
+				cache->axis = i;
+			return false;
+		}
+
+		if( depth < edge_depth )
+		{
+			edge_depth = depth;
+			edge_axis = i;
+			edge_normal = normal;
+		}
+	}
+
+	if( edge_axis >= 0 && edge_depth < RelativeTolerance * face_depth )
+	{
+		if( cache )
+			cache->axis = edge_axis;
+
+		int index = edge_axis - face_axes;
+		Vector3 p1, q1, p2, q2, c1, c2;
+		supportEdge( p1, q1, a, index / b.edge_count, edge_normal );
+		supportEdge( p2, q2, b, index % b.edge_count, -edge_normal );
+		closestSegments( c1, c2, p1, q1, p2, q2 );
+
+		out.normal = edge_normal;
+		out.depth = edge_depth;
+		out.points[0] = ( c1 + c2 ) * 0.5f;
+		out.count = 1;
+		return true;
+	}
+
+	if( cache )
+		cache->axis = face_axis;
+
+	// 多边形的侧面法线没有对应的实际面，此时改以另一方为参考面
+	bool ref_a = face_axis < a.face_count;
+	const ConvexView& owner = ref_a ? a : b;
+	int face = ref_a ? face_axis : face_axis - a.face_count;
+	if( owner.polygon && face > 0 )
+		ref_a = !ref_a;
+
+	Face ref, inc;
+	supportFace( ref, ref_a ? a : b, ref_a ? face_normal : -face_normal );
+	supportFace( inc, ref_a ? b : a, -ref.normal );
+
+	out.normal = face_normal;
+	out.depth = face_depth;
+	faceContact( out, ref, inc );
+	return true;
+}
+
+bool Collision::collide( Manifold& out, const OrientBox& a, const OrientBox& b, SatCache* cache )
+{
+	ConvexView view_a, view_b;
+	makeView( view_a, a );
+	makeView( view_b, b );
+	return collideConvex( out, view_a, view_b, cache );
+}
+
+bool Collision::collide( Manifold& out, const OrientBox& a, const Polygon& b, SatCache* cache )
+{
+	ConvexView view_a, view_b;
+	makeView( view_a, a );
+	makeView( view_b, b );
+	return collideConvex( out, view_a, view_b, cache );
+}
+
+bool Collision::collide( Manifold& out, const Polygon& a, const OrientBox& b, SatCache* cache )
+{
+	ConvexView view_a, view_b;
+	makeView( view_a, a );
+	makeView( view_b, b );
+	return collideConvex( out, view_a, view_b, cache );
+}
+
+bool Collision::collide( Manifold& out, const Polygon& a, const Polygon& b, SatCache* cache )
+{
+	ConvexView view_a, view_b;
+	makeView( view_a, a );
+	makeView( view_b, b );
+	return collideConvex( out, view_a, view_b, cache );
+}
+
+NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,81 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __COLLISION_H__
+#define __COLLISION_H__
+
+#include "magical-macros.h"
+#include "magical-math.h"
+#include "Common.h"
+
+NAMESPACE_MAGICAL
+
+/*
+三维接触流形，normal为从a指向b的单位法线，depth为沿法线的穿透深度，
+接触点取两表面之间的中点，面接触时最多保留4个
+*/
+struct Manifold
+{
+	enum : int { MaxPoints = 4 };
+
+	Vector3 normal;
+	float depth;
+	Vector3 points[ MaxPoints ];
+	int count;
+
+public:
+	Manifold( void ) : normal( Vector3::Zero ), depth( 0.0f ), count( 0 ) {}
+};
+
+/*
+分离轴缓存，记录上一次求得的分离轴（或最小穿透轴）的索引，
+同一对形状在相邻帧间调用时先检查该轴，多数仍分离的情况可以直接返回
+*/
+struct SatCache
+{
+	int axis;
+
+public:
+	SatCache( void ) : axis( -1 ) {}
+	void reset( void ) { axis = -1; }
+};
+
+/*
+三维窄阶段，基于分离轴测试生成接触流形
+
+候选轴依次为a的面法线、b的面法线以及两者边方向的叉积，
+取穿透最小的轴为接触法线，面轴以参考面裁剪入射面求接触点，
+边轴取两条支撑边的最近点，只有边轴明显更优时才采用边轴
+*/
+class Collision
+{
+public:
+	static bool collide( Manifold& out, const OrientBox& a, const OrientBox& b, SatCache* cache = nullptr );
+	static bool collide( Manifold& out, const OrientBox& a, const Polygon& b, SatCache* cache = nullptr );
+	static bool collide( Manifold& out, const Polygon& a, const OrientBox& b, SatCache* cache = nullptr );
+	static bool collide( Manifold& out, const Polygon& a, const Polygon& b, SatCache* cache = nullptr );
+};
+
+NAMESPACE_END
+
+#endif //__COLLISION_H__
\ No newline at end of file
@@ -0,0 +1,426 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "Collision2.h"
+
+#ifdef MAGICAL_SSE2
+#include <emmintrin.h>
+#endif
+
+NAMESPACE_MAGICAL
+
+typedef bool ( *IntersectsFunc )( const void* a, const void* b );
+
+template< class A, class B >
+static bool intersectsThunk( const void* a, const void* b )
+{
+	return static_cast< const A* >( a )->intersects( *static_cast< const B* >( b ) );
+}
+
+/*
+只在一侧实现了相交测试的组合，交换参数后调用另一侧
+*/
+template< class A, class B >
+static bool intersectsSwapThunk( const void* a, const void* b )
+{
+	return static_cast< const B* >( b )->intersects( *static_cast< const A* >( a ) );
+}
+
+static const IntersectsFunc _intersects_table[ (int) Shape2::Type::Count ][ (int) Shape2::Type::Count ] = {
+	{ intersectsThunk<Box2, Box2>, intersectsThunk<Box2, Circle>, intersectsSwapThunk<Box2, OrientBox2>, intersectsSwapThunk<Box2, Polygon2> },
+	{ intersectsThunk<Circle, Box2>, intersectsThunk<Circle, Circle>, intersectsSwapThunk<Circle, OrientBox2>, intersectsSwapThunk<Circle, Polygon2> },
+	{ intersectsThunk<OrientBox2, Box2>, intersectsThunk<OrientBox2, Circle>, intersectsThunk<OrientBox2, OrientBox2>, intersectsSwapThunk<OrientBox2, Polygon2> },
+	{ intersectsThunk<Polygon2, Box2>, intersectsThunk<Polygon2, Circle>, intersectsThunk<Polygon2, OrientBox2>, intersectsThunk<Polygon2, Polygon2> },
+};
+
+/*
+参考边的选择容差，两边分离量相近时优先取a的边，避免参考边在帧间来回切换
+*/
+static const float RelativeTolerance = 0.98f;
+static const float AbsoluteTolerance = 0.001f;
+
+/*
+多边形各顶点在轴上投影的最小值
+SSE2版本每次处理4个顶点，超出count的通道以正无穷屏蔽，
+MaxVertices为8，读取范围不会越过顶点数组
+*/
+static inline float minProjection( const Polygon2& polygon, const Vector2& axis )
+{
+#ifdef MAGICAL_SSE2
+	static_assert( Polygon2::MaxVertices % 4 == 0, "Polygon2::MaxVertices must be a multiple of 4" );
+
+	const __m128 n = _mm_setr_ps( axis.x, axis.y, axis.x, axis.y );
+	const __m128 inf = _mm_set1_ps( FLT_MAX );
+	const __m128i count = _mm_set1_epi32( polygon.count );
+	__m128i index = _mm_setr_epi32( 0, 1, 2, 3 );
+	__m128 result = inf;
+
+	for( int i = 0; i < polygon.count; i += 4 )
+	{
+		__m128 a = _mm_mul_ps( _mm_loadu_ps( &polygon.vertices[ i ].x ), n );
+		__m128 b = _mm_mul_ps( _mm_loadu_ps( &polygon.vertices[ i + 2 ].x ), n );
+		__m128 d = _mm_add_ps(
+			_mm_shuffle_ps( a, b, _MM_SHUFFLE( 2, 0, 2, 0 ) ),
+			_mm_shuffle_ps( a, b, _MM_SHUFFLE( 3, 1, 3, 1 ) ) );
+		__m128 mask = _mm_castsi128_ps( _mm_cmplt_epi32( index, count ) );
+		d = _mm_or_ps( _mm_and_ps( mask, d ), _mm_andnot_ps( mask, inf ) );
+		result = _mm_min_ps( result, d );
+		index = _mm_add_epi32( index, _mm_set1_epi32( 4 ) );
+	}
+
+	result = _mm_min_ps( result, _mm_shuffle_ps( result, result, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+	result = _mm_min_ps( result, _mm_shuffle_ps( result, result, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+	return _mm_cvtss_f32( result );
+#else
+	float min = Vector2::dot( polygon.vertices[0], axis );
+	for( int i = 1; i < polygon.count; ++i )
+	{
+		min = Math::min( min, Vector2::dot( polygon.vertices[i], axis ) );
+	}
+	return min;
+#endif
+}
+
+/*
+b相对a第index条边的分离量，为正时该边法线即为分离轴
+*/
+static inline float edgeSeparation( const Polygon2& a, int index, const Polygon2& b )
+{
+	const Vector2& n = a.normals[ index ];
+	return minProjection( b, n ) - Vector2::dot( n, a.vertices[ index ] );
+}
+
+static float maxSeparation( int& index, const Polygon2& a, const Polygon2& b )
+{
+	float max = -FLT_MAX;
+	for( int i = 0; i < a.count; ++i )
+	{
+		float s = edgeSeparation( a, i, b );
+		if( s > max )
+		{
+			max = s;
+			index = i;
+			if( s > 0.0f )
+				break;
+		}
+	}
+	return max;
+}
+
+/*
+多边形与多边形，分离轴取两者各边的法线，
+相交时以分离量最大的边为参考边，取另一多边形上与之最反向的边为入射边，
+入射边用参考边两端的侧平面裁剪后保留位于参考边内侧的点
+*/
+static bool collidePolygons( Manifold2& out, const Polygon2& a, const Polygon2& b, SatCache2* cache )
+{
+	if( cache && cache->axis >= 0 )
+	{
+		int axis = cache->axis;
+		if( axis < a.count )
+		{
+			if( edgeSeparation( a, axis, b ) > 0.0f )
+				return false;
+		}
+		else if( axis - a.count < b.count )
+		{
+			if( edgeSeparation( b, axis - a.count, a ) > 0.0f )
+				return false;
+		}
+	}
+
+	int edge_a = 0;
+	float separation_a = maxSeparation( edge_a, a, b );
+	if( separation_a > 0.0f )
+	{
+		if( cache )
+			cache->axis = edge_a;
+		return false;
+	}
+
+	int edge_b = 0;
+	float separation_b = maxSeparation( edge_b, b, a );
+	if( separation_b > 0.0f )
+	{
+		if( cache )
+			cache->axis = a.count + edge_b;
+		return false;
+	}
+
+	const Polygon2* ref;
+	const Polygon2* inc;
+	int edge;
+	bool flip;
+	if( separation_b > RelativeTolerance * separation_a + AbsoluteTolerance )
+	{
+		ref = &b;
+		inc = &a;
+		edge = edge_b;
+		flip = true;
+		if( cache )
+			cache->axis = a.count + edge_b;
+	}
+	else
+	{
+		ref = &a;
+		inc = &b;
+		edge = edge_a;
+		flip = false;
+		if( cache )
+			cache->axis = edge_a;
+	}
+
+	const Vector2& n = ref->normals[ edge ];
+	int inc_edge = 0;
+	float min = Vector2::dot( n, inc->normals[0] );
+	for( int i = 1; i < inc->count; ++i )
+	{
+		float d = Vector2::dot( n, inc->normals[i] );
+		if( d < min )
+		{
+			min = d;
+			inc_edge = i;
+		}
+	}
+
+	const Vector2& r1 = ref->vertices[ edge ];
+	const Vector2& r2 = ref->vertices[ edge + 1 < ref->count ? edge + 1 : 0 ];
+	Vector2 clip[2] = {
+		inc->vertices[ inc_edge ],
+		inc->vertices[ inc_edge + 1 < inc->count ? inc_edge + 1 : 0 ],
+	};
+
+	Vector2 t = r2 - r1;
+	t.normalize();
+
+	// 依次以两端侧平面裁剪入射边，线段两端都在外侧时退化为一个点
+	float offsets[2] = { -Vector2::dot( t, r1 ), Vector2::dot( t, r2 ) };
+	Vector2 planes[2] = { -t, t };
+	for( int p = 0; p < 2; ++p )
+	{
+		float d1 = Vector2::dot( planes[p], clip[0] ) - offsets[p];
+		float d2 = Vector2::dot( planes[p], clip[1] ) - offsets[p];
+		if( d1 > 0.0f && d2 > 0.0f )
+		{
+			clip[0] = clip[1] = ( d1 < d2 ) ? clip[0] : clip[1];
+		}
+		else if( d1 > 0.0f )
+		{
+			clip[0] = clip[0] + ( clip[1] - clip[0] ) * ( d1 / ( d1 - d2 ) );
+		}
+		else if( d2 > 0.0f )
+		{
+			clip[1] = clip[0] + ( clip[1] - clip[0] ) * ( d1 / ( d1 - d2 ) );
+		}
+	}
+
+	out.normal = flip ? -n : n;
+	out.depth = -( flip ? separation_b : separation_a );
+	out.count = 0;
+
+	float offset = Vector2::dot( n, r1 );
+	int clip_count = clip[0].equals( clip[1] ) ? 1 : 2;
+	for( int i = 0; i < clip_count; ++i )
+	{
+		float s = Vector2::dot( n, clip[i] ) - offset;
+		if( s <= 0.0f )
+		{
+			out.points[ out.count++ ] = clip[i] - n * ( s * 0.5f );
+		}
+	}
+
+	if( out.count == 0 )
+	{
+		out.points[0] = ( clip[0] + clip[1] ) * 0.5f;
+		out.count = 1;
+	}
+
+	return true;
+}
+
+/*
+多边形与圆，先求圆心相对各边的最大分离量，
+圆心在多边形内时直接取该边法线，否则按圆心落在边的顶点区域还是边区域分别处理
+*/
+static bool collidePolygonCircle( Manifold2& out, const Polygon2& a, const Circle& b, SatCache2* cache )
+{
+	if( cache && cache->axis >= 0 && cache->axis < a.count )
+	{
+		if( Vector2::dot( a.normals[ cache->axis ], b.center - a.vertices[ cache->axis ] ) > b.r )
+			return false;
+	}
+
+	int edge = 0;
+	float separation = -FLT_MAX;
+	for( int i = 0; i < a.count; ++i )
+	{
+		float s = Vector2::dot( a.normals[i], b.center - a.vertices[i] );
+		if( s > b.r )
+		{
+			if( cache )
+				cache->axis = i;
+			return false;
+		}
+		if( s > separation )
+		{
+			separation = s;
+			edge = i;
+		}
+	}
+
+	if( cache )
+		cache->axis = edge;
+
+	const Vector2& v1 = a.vertices[ edge ];
+	const Vector2& v2 = a.vertices[ edge + 1 < a.count ? edge + 1 : 0 ];
+	Vector2 n = a.normals[ edge ];
+
+	if( separation > Math::VectorEpsilon )
+	{
+		const Vector2* v = nullptr;
+		if( Vector2::dot( b.center - v1, v2 - v1 ) <= 0.0f )
+			v = &v1;
+		else if( Vector2::dot( b.center - v2, v1 - v2 ) <= 0.0f )
+			v = &v2;
+
+		if( v )
+		{
+			n = b.center - *v;
+			float dist = n.length();
+			if( dist > b.r )
+				return false;
+
+			n *= 1.0f / dist;
+			separation = dist;
+		}
+	}
+
+	out.normal = n;
+	out.depth = b.r - separation;
+	out.points[0] = b.center - n * ( b.r - out.depth * 0.5f );
+	out.count = 1;
+	return true;
+}
+
+static bool collideCircles( Manifold2& out, const Circle& a, const Circle& b )
+{
+	Vector2 d = b.center - a.center;
+	float rr = a.r + b.r;
+	float dist_sq = Vector2::dot( d, d );
+	if( dist_sq > rr * rr )
+		return false;
+
+	float dist = Math::sqrt( dist_sq );
+	out.normal = dist > Math::VectorEpsilon ? d * ( 1.0f / dist ) : Vector2( 1.0f, 0.0f );
+	out.depth = rr - dist;
+	out.points[0] = a.center + out.normal * ( a.r - out.depth * 0.5f );
+	out.count = 1;
+	return true;
+}
+
+static void toPolygon( Polygon2& out, const Shape2& shape )
+{
+	switch( shape.type )
+	{
+		case Shape2::Type::Box2:
+			out.set( *static_cast< const Box2* >( shape.shape ) );
+			break;
+		case Shape2::Type::OrientBox2:
+			out.set( *static_cast< const OrientBox2* >( shape.shape ) );
+			break;
+		case Shape2::Type::Polygon2:
+			out.set( *static_cast< const Polygon2* >( shape.shape ) );
+			break;
+		default:
+			MAGICAL_ASSERT( false, "Invalid shape!" );
+			break;
+	}
+}
+
+void Collision2::bounds( Box2& out, const Shape2& shape )
+{
+	switch( shape.type )
+	{
+		case Shape2::Type::Box2:
+			out = *static_cast< const Box2* >( shape.shape );
+			break;
+		case Shape2::Type::Circle:
+		{
+			const Circle& circle = *static_cast< const Circle* >( shape.shape );
+			out.min.x = circle.x - circle.r;
+			out.min.y = circle.y - circle.r;
+			out.max.x = circle.x + circle.r;
+			out.max.y = circle.y + circle.r;
+			break;
+		}
+		case Shape2::Type::OrientBox2:
+			static_cast< const OrientBox2* >( shape.shape )->getBounds( out );
+			break;
+		case Shape2::Type::Polygon2:
+			static_cast< const Polygon2* >( shape.shape )->getBounds( out );
+			break;
+		default:
+			MAGICAL_ASSERT( false, "Invalid shape!" );
+			break;
+	}
+}
+
+bool Collision2::intersects( const Shape2& a, const Shape2& b )
+{
+	MAGICAL_ASSERT( a.type < Shape2::Type::Count && b.type < Shape2::Type::Count, "Invalid shape!" );
+	return _intersects_table[ (int) a.type ][ (int) b.type ]( a.shape, b.shape );
+}
+
+bool Collision2::collide( Manifold2& out, const Shape2& a, const Shape2& b, SatCache2* cache )
+{
+	MAGICAL_ASSERT( a.type < Shape2::Type::Count && b.type < Shape2::Type::Count, "Invalid shape!" );
+
+	bool circle_a = a.type == Shape2::Type::Circle;
+	bool circle_b = b.type == Shape2::Type::Circle;
+
+	if( circle_a && circle_b )
+		return collideCircles( out, *static_cast< const Circle* >( a.shape ), *static_cast< const Circle* >( b.shape ) );
+
+	if( circle_a )
+	{
+		Polygon2 polygon;
+		toPolygon( polygon, b );
+		if( !collidePolygonCircle( out, polygon, *static_cast< const Circle* >( a.shape ), cache ) )
+			return false;
+
+		out.normal = -out.normal;
+		return true;
+	}
+
+	Polygon2 polygon_a;
+	toPolygon( polygon_a, a );
+
+	if( circle_b )
+		return collidePolygonCircle( out, polygon_a, *static_cast< const Circle* >( b.shape ), cache );
+
+	Polygon2 polygon_b;
+	toPolygon( polygon_b, b );
+	return collidePolygons( out, polygon_a, polygon_b, cache );
+}
+
+NAMESPACE_END
\ No newline at end of file
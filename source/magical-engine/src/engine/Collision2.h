@@ -0,0 +1,101 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __COLLISION2_H__
+#define __COLLISION2_H__
+
+#include "magical-macros.h"
+#include "magical-math.h"
+#include "Common.h"
+
+NAMESPACE_MAGICAL
+
+/*
+二维形状的类型化引用，不持有形状本身，
+形状移动后调用者只需通知宽阶段重新计算包围盒
+*/
+struct Shape2
+{
+	enum class Type : int
+	{
+		Box2,
+		Circle,
+		OrientBox2,
+		Polygon2,
+		Count,
+	};
+
+	Type type;
+	const void* shape;
+
+public:
+	Shape2( const Box2& box ) : type( Type::Box2 ), shape( &box ) {}
+	Shape2( const Circle& circle ) : type( Type::Circle ), shape( &circle ) {}
+	Shape2( const OrientBox2& box ) : type( Type::OrientBox2 ), shape( &box ) {}
+	Shape2( const Polygon2& polygon ) : type( Type::Polygon2 ), shape( &polygon ) {}
+	Shape2( void ) : type( Type::Count ), shape( nullptr ) {}
+};
+
+/*
+二维接触流形，normal为从a指向b的单位法线，depth为沿法线的穿透深度，
+接触点取两表面之间的中点，最多2个
+*/
+struct Manifold2
+{
+	Vector2 normal;
+	float depth;
+	Vector2 points[2];
+	int count;
+
+public:
+	Manifold2( void ) : normal( Vector2::Zero ), depth( 0.0f ), count( 0 ) {}
+};
+
+/*
+分离轴缓存，记录上一次求得的分离轴（或最小穿透轴）的索引，
+同一对形状在相邻帧间调用时先检查该轴，多数仍分离的情况可以直接返回
+*/
+struct SatCache2
+{
+	int axis;
+
+public:
+	SatCache2( void ) : axis( -1 ) {}
+	void reset( void ) { axis = -1; }
+};
+
+/*
+二维窄阶段，按形状类型分派到各形状自身的相交测试，
+collide在相交时额外生成接触流形，Box2与OrientBox2按多边形处理
+*/
+class Collision2
+{
+public:
+	static void bounds( Box2& out, const Shape2& shape );
+	static bool intersects( const Shape2& a, const Shape2& b );
+	static bool collide( Manifold2& out, const Shape2& a, const Shape2& b, SatCache2* cache = nullptr );
+};
+
+NAMESPACE_END
+
+#endif //__COLLISION2_H__
\ No newline at end of file
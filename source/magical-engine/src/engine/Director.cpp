@@ -25,9 +25,13 @@ SOFTWARE.
 #include "magical-math.h"
 #include "Utils.h"
 #include "Assets.h"
+#include "AssetsCache.h"
 #include "Renderer.h"
 #include "Application.h"
 #include "Object.h"
+#include "Profiler.h"
+#include "Stats.h"
+#include <algorithm>
 
 NAMESPACE_MAGICAL
 
@@ -35,7 +39,9 @@ static Scene* _next_scene = nullptr;
 static Scene* _running_scene = nullptr;
 static long long _last_update_time = 0;
 static double _delta_time = 0.0;
+static double _fixed_delta_time = 0.0;
 static ViewChannel* _view_channels[ ViewChannel::Count ];
+static Vector<Director::Hook> _hooks[ Director::HookPointCount ];
 
 void Director::init( void )
 {
@@ -63,7 +69,16 @@ void Director::delc( void )
 
 void Director::mainLoop( void )
 {
+	Profiler::newFrame();
+	Stats::newFrame();
+	MAGICAL_PROFILE_SCOPE( "Director::mainLoop" );
+
 	calcDeltaTime();
+	{
+		MAGICAL_PROFILE_SCOPE( "Assets::dispatchLoadCallbacks" );
+		Assets::dispatchLoadCallbacks();
+		AssetsCache::trim();
+	}
 
 	if( _next_scene )
 	{
@@ -71,6 +86,7 @@ void Director::mainLoop( void )
 			_running_scene->stop();
 
 		SAFE_MOVE_NULL( _running_scene, _next_scene );
+		runHooks( SceneChanged );
 		_running_scene->start();
 	}
 
@@ -89,12 +105,17 @@ void Director::mainLoop( void )
 			if( camera->isActive() && camera->isVisible() )
 			{
 				_running_scene->setVisitingCamera( camera );
-				_running_scene->visit();
+				{
+					MAGICAL_PROFILE_SCOPE( "Object::visit" );
+					_running_scene->visit();
+				}
 				Renderer::render( i, channel );
 				_running_scene->setVisitingCamera( nullptr );
 			}
 		}
 	}
+
+	runHooks( FrameEnd );
 }
 
 void Director::resize( int w, int h )
@@ -136,6 +157,17 @@ float Director::getDeltaTime( void )
 	return _delta_time;
 }
 
+void Director::setFixedDeltaTime( float dt )
+{
+	MAGICAL_ASSERT( dt >= 0.0f, "Invalid delta time!" );
+	_fixed_delta_time = dt;
+}
+
+float Director::getFixedDeltaTime( void )
+{
+	return (float) _fixed_delta_time;
+}
+
 void Director::bindCameraToViewChannel( Camera* camera )
 {
 	ViewChannel* channel = _view_channels[ camera->getBoundViewChannelIndex() ];
@@ -167,10 +199,35 @@ void Director::unbindCameraFromViewChannel( Camera* camera )
 	channel->removeCamera();
 }
 
+void Director::addHook( HookPoint point, Hook hook )
+{
+	MAGICAL_ASSERT( 0 <= point && point < HookPointCount, "Invalid Hook Point!" );
+	MAGICAL_ASSERT( hook, "should not be nullptr." );
+
+	_hooks[ point ].push_back( hook );
+}
+
+void Director::removeHook( HookPoint point, Hook hook )
+{
+	MAGICAL_ASSERT( 0 <= point && point < HookPointCount, "Invalid Hook Point!" );
+
+	Vector<Hook>& hooks = _hooks[ point ];
+	hooks.erase( std::remove( hooks.begin(), hooks.end(), hook ), hooks.end() );
+}
+
+void Director::runHooks( HookPoint point )
+{
+	for( auto hook : _hooks[ point ] )
+		hook();
+}
+
 void Director::calcDeltaTime( void )
 {
 	long long now = Time::currentMicroseconds();
-	_delta_time = Math::max( 0.0, ( now - _last_update_time ) / 1000000.0 );
+	if( _fixed_delta_time > 0.0 )
+		_delta_time = _fixed_delta_time;
+	else
+		_delta_time = Math::max( 0.0, ( now - _last_update_time ) / 1000000.0 );
 	_last_update_time = now;
 }
 
@@ -32,6 +32,20 @@ NAMESPACE_MAGICAL
 
 class Director
 {
+public:
+	/*
+	主循环的挂接点，脚本层等模块在这里接入每一帧，Director不需要依赖这些模块
+	FrameEnd在一帧的渲染之后调用，SceneChanged在旧场景停止释放之后、新场景开始之前调用
+	*/
+	enum HookPoint
+	{
+		FrameEnd,
+		SceneChanged,
+		HookPointCount,
+	};
+
+	typedef void(*Hook)( void );
+
 public:
 	static void init( void );
 	static void delc( void );
@@ -47,13 +61,21 @@ public:
 public:
 	static ViewChannel* getViewChannel( unsigned int index );
 	static float getDeltaTime( void );
+	// 大于0时每帧的间隔固定为dt秒而不取实际经过的时间，用于性能测试和回放；0恢复实际时间
+	static void setFixedDeltaTime( float dt );
+	static float getFixedDeltaTime( void );
 
 public:
 	static void bindCameraToViewChannel( Camera* camera );
 	static void unbindCameraFromViewChannel( Camera* camera );
 
+public:
+	static void addHook( HookPoint point, Hook hook );
+	static void removeHook( HookPoint point, Hook hook );
+
 private:
 	static void calcDeltaTime( void );
+	static void runHooks( HookPoint point );
 };
 
 NAMESPACE_END
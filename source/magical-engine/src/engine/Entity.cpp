@@ -24,9 +24,13 @@ SOFTWARE.
 #include "Entity.h"
 #include "Scene.h"
 #include "Renderer.h"
+#include "Stats.h"
 
 NAMESPACE_MAGICAL
 
+static Stat _stat_entities_visited( "scene.entities_visited", Stat::Counter );
+static Stat _stat_entities_culled( "scene.entities_culled", Stat::Counter );
+
 Entity::Entity( void )
 {
 	m_feature = Entity::Feature;
@@ -90,7 +94,10 @@ Ptr<Entity> Entity::create( const char* name )
 void Entity::visit( void )
 {
 	if( m_visible == false )
+	{
+		_stat_entities_culled.add();
 		return;
+	}
 
 	// frustum cull check
 	/*if( camera->isFrustumCullEnabled() )
@@ -99,6 +106,7 @@ void Entity::visit( void )
 	}*/
 
 	Renderer::addCommand( &m_command );
+	_stat_entities_visited.add();
 
 	if( !m_children.empty() )
 	{
@@ -125,6 +133,22 @@ void Entity::stop( void )
 	Object::stop();
 }
 
+void Entity::transform( void )
+{
+	if( m_visible && m_ts_dirty && m_bounds_proxy != BoundingVolumeTree::NullNode )
+		m_root_scene->markBoundsDirty( this );
+
+	Object::transform();
+}
+
+void Entity::setLocalBounds( const Box& bounds )
+{
+	m_local_bounds = bounds;
+
+	if( m_bounds_proxy != BoundingVolumeTree::NullNode )
+		m_root_scene->markBoundsDirty( this );
+}
+
 void Entity::prepare( void )
 {
 
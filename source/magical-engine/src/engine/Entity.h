@@ -32,6 +32,7 @@ SOFTWARE.
 #include "Object.h"
 #include "VertexBufferObject.h"
 #include "RenderCommand.h"
+#include "BoundingVolumeTree.h"
 
 NAMESPACE_MAGICAL
 
@@ -39,6 +40,7 @@ class Entity : public Object
 {
 public:
 	enum : int { Feature = 10 };
+	friend class Scene;
 
 public:
 	Entity( void );
@@ -50,10 +52,16 @@ public:
 	template<class TBehaviour> void addComponent( void );
 	template<class TBehaviour> void removeComponent( void );
 
+public:
+	void setLocalBounds( const Box& bounds );
+	const Box& getLocalBounds( void ) const { return m_local_bounds; }
+	const Box& getWorldBounds( void ) const { return m_world_bounds; }
+
 public:
 	virtual void visit( void ) override;
 	virtual void start( void ) override;
 	virtual void stop( void ) override;
+	virtual void transform( void ) override;
 
 public:
 	virtual void prepare( void );
@@ -64,6 +72,11 @@ protected:
 	VertexBufferObject* m_vbo = nullptr;
 	BatchCommand m_command;
 	UnorderedMap<size_t, BehaviourFeature*> m_behaviours;
+	Box m_local_bounds = Box( Vector3( -0.5f ), Vector3( 0.5f ) );
+	Box m_world_bounds = Box( Vector3( -0.5f ), Vector3( 0.5f ) );
+	int m_bounds_proxy = BoundingVolumeTree::NullNode;
+	// 在Scene::m_bounds_dirty中的下标，-1表示不在其中
+	int m_bounds_dirty_index = -1;
 };
 
 #include "Entity.inl"
@@ -457,6 +457,14 @@ const Vector3& Object::getScale( void ) const
 	return m_local_scale;
 }
 
+void Object::setTrs( const Vector3& t, const Quaternion& r, const Vector3& s )
+{
+	m_local_position = t;
+	m_local_rotation = r;
+	m_local_scale = s;
+	transformDirty( kTsTranslationDirty | kTsRotationDirty | kTsScaleDirty );
+}
+
 void Object::link( Object* child )
 {
 	if( m_parent )
@@ -119,6 +119,9 @@ public:
 	void setScale( float x, float y, float z );
 	const Vector3& getScale( void ) const;
 
+public:
+	void setTrs( const Vector3& t, const Quaternion& r, const Vector3& s );
+
 public:
 	virtual void link( Object* child );
 	virtual void unlink( Object* child );
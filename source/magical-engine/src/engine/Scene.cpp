@@ -25,9 +25,13 @@ SOFTWARE.
 #include "Application.h"
 #include "Renderer.h"
 #include "Director.h"
+#include "Profiler.h"
+#include "Stats.h"
 
 NAMESPACE_MAGICAL
 
+static Stat _stat_entities_updated( "scene.entities_updated", Stat::Counter );
+
 Scene::Scene( void )
 {
 	m_root_scene = this;
@@ -66,13 +70,28 @@ Ptr<Scene> Scene::create( void )
 
 void Scene::update( void )
 {
+	MAGICAL_PROFILE_SCOPE( "Scene::update" );
+
 	m_update_queue = m_entities;
+	_stat_entities_updated.add( m_update_queue.size() );
 	for( auto itr : m_update_queue )
 	{
 		itr->update();
 	}
 }
 
+void Scene::transform( void )
+{
+	{
+		MAGICAL_PROFILE_SCOPE( "Object::transform" );
+		Object::transform();
+	}
+	{
+		MAGICAL_PROFILE_SCOPE( "Scene::updateBounds" );
+		updateBounds();
+	}
+}
+
 void Scene::link( Object* child )
 {
 	switch( child->m_feature )
@@ -160,6 +179,9 @@ void Scene::addEntity( Entity* object )
 
 	object->retain();
 	m_entities.insert( object );
+
+	object->m_bounds_proxy = m_bounds_tree.insert( object->m_world_bounds, object );
+	markBoundsDirty( object );
 }
 
 void Scene::removeEntity( Entity* object )
@@ -167,10 +189,105 @@ void Scene::removeEntity( Entity* object )
 	auto itr = m_entities.find( object );
 	MAGICAL_ASSERT( itr != m_entities.end(), "Invalid! isn't exists in scene" );
 
+	int dirty = object->m_bounds_dirty_index;
+	if( dirty >= 0 )
+	{
+		// 与末尾交换后删除，不需要查找
+		Entity* last = m_bounds_dirty.back();
+		m_bounds_dirty[ dirty ] = last;
+		last->m_bounds_dirty_index = dirty;
+		m_bounds_dirty.pop_back();
+		object->m_bounds_dirty_index = -1;
+	}
+
+	m_bounds_tree.remove( object->m_bounds_proxy );
+	object->m_bounds_proxy = BoundingVolumeTree::NullNode;
+
 	m_entities.erase( itr );
 	object->release();
 }
 
+void Scene::markBoundsDirty( Entity* entity )
+{
+	if( entity->m_bounds_dirty_index >= 0 )
+		return;
+
+	entity->m_bounds_dirty_index = (int) m_bounds_dirty.size();
+	m_bounds_dirty.push_back( entity );
+}
+
+/*
+在变换更新之后统一刷新移动过的实体的世界包围盒，
+累计修改次数超过实体数量时按SAH重建，避免树的质量随移动逐渐退化
+*/
+void Scene::updateBounds( void )
+{
+	for( auto entity : m_bounds_dirty )
+	{
+		Box::transform( entity->m_world_bounds, entity->m_local_bounds, entity->getLocalToWorldMatrix() );
+		m_bounds_tree.move( entity->m_bounds_proxy, entity->m_world_bounds );
+		entity->m_bounds_dirty_index = -1;
+	}
+	m_bounds_dirty.clear();
+
+	if( m_bounds_tree.modifications() > m_bounds_tree.leafCount() )
+	{
+		m_bounds_tree.rebuild();
+	}
+}
+
+void Scene::rebuildBounds( void )
+{
+	m_bounds_tree.rebuild();
+}
+
+Entity* Scene::raycast( float& distance, const Ray& ray, float max_distance ) const
+{
+	Entity* ret = nullptr;
+	m_bounds_tree.raycast( ray, max_distance, [ & ]( int proxy, float max ) {
+		Entity* entity = (Entity*) m_bounds_tree.getUserData( proxy );
+		float hit;
+		if( ray.intersects( hit, entity->m_world_bounds ) && hit < max )
+		{
+			ret = entity;
+			distance = hit;
+			return hit;
+		}
+		return max;
+	} );
+	return ret;
+}
+
+void Scene::overlapBox( Vector<Entity*>& out, const Box& box ) const
+{
+	m_bounds_tree.queryBox( box, [ & ]( int proxy ) {
+		Entity* entity = (Entity*) m_bounds_tree.getUserData( proxy );
+		if( entity->m_world_bounds.intersects( box ) )
+			out.push_back( entity );
+		return true;
+	} );
+}
+
+void Scene::overlapSphere( Vector<Entity*>& out, const Sphere& sphere ) const
+{
+	m_bounds_tree.querySphere( sphere, [ & ]( int proxy ) {
+		Entity* entity = (Entity*) m_bounds_tree.getUserData( proxy );
+		if( sphere.intersects( entity->m_world_bounds ) )
+			out.push_back( entity );
+		return true;
+	} );
+}
+
+void Scene::overlapFrustum( Vector<Entity*>& out, const Frustum& frustum ) const
+{
+	m_bounds_tree.queryFrustum( frustum, [ & ]( int proxy ) {
+		Entity* entity = (Entity*) m_bounds_tree.getUserData( proxy );
+		if( frustum.containsBox( entity->m_world_bounds ) )
+			out.push_back( entity );
+		return true;
+	} );
+}
+
 void Scene::setVisitingCamera( Camera* camera )
 {
 	m_visiting_camera = camera;
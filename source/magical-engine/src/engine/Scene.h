@@ -32,6 +32,7 @@ SOFTWARE.
 #include "Entity.h"
 #include "Camera.h"
 #include "ViewChannel.h"
+#include "BoundingVolumeTree.h"
 
 NAMESPACE_MAGICAL
 
@@ -42,6 +43,7 @@ class Entity;
 class Scene : public Object
 {
 	friend class Director;
+	friend class Entity;
 
 public:
 	Scene( void );
@@ -50,9 +52,18 @@ public:
 
 public:
 	virtual void update( void );
+	virtual void transform( void ) override;
 	virtual void link( Object* child ) override;
 	virtual void unlink( Object* child ) override;
 
+public:
+	Entity* raycast( float& distance, const Ray& ray, float max_distance = FLT_MAX ) const;
+	void overlapBox( Vector<Entity*>& out, const Box& box ) const;
+	void overlapSphere( Vector<Entity*>& out, const Sphere& sphere ) const;
+	void overlapFrustum( Vector<Entity*>& out, const Frustum& frustum ) const;
+	void rebuildBounds( void );
+	const BoundingVolumeTree& getBoundsTree( void ) const { return m_bounds_tree; }
+
 public:
 	Camera* getVisitingCamera( void ) const { return m_visiting_camera; }
 
@@ -61,6 +72,8 @@ protected:
 	void removeCamera( Camera* camera );
 	void addEntity( Entity* entity );
 	void removeEntity( Entity* entity );
+	void markBoundsDirty( Entity* entity );
+	void updateBounds( void );
 
 protected:
 	void setVisitingCamera( Camera* camera );
@@ -72,6 +85,8 @@ protected:
 	UnorderedSet<Entity*> m_entities;
 	UnorderedSet<Camera*> m_cameras;
 	UnorderedSet<Entity*> m_update_queue;
+	BoundingVolumeTree m_bounds_tree;
+	Vector<Entity*> m_bounds_dirty;
 };
 
 NAMESPACE_END
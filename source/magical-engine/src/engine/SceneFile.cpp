@@ -0,0 +1,294 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "SceneFile.h"
+#include "Assets.h"
+#include <string.h>
+
+NAMESPACE_MAGICAL
+
+/*
+二进制读写辅助，所有数据以小端序紧密排列
+*/
+class SceneReader
+{
+public:
+	SceneReader( const char* data, size_t size ) : m_data( data ), m_size( size ) {}
+	bool read( void* dst, size_t size )
+	{
+		if( size > m_size - m_cursor )
+			return false;
+		memcpy( dst, m_data + m_cursor, size );
+		m_cursor += size;
+		return true;
+	}
+	template< class T > bool read( T& dst ) { return read( &dst, sizeof( T ) ); }
+	template< class T > bool read( Vector<T>& dst, size_t count )
+	{
+		// 先检查剩余长度，避免损坏的计数导致巨大的分配
+		if( count > ( m_size - m_cursor ) / sizeof( T ) )
+			return false;
+		dst.resize( count );
+		return count == 0 || read( dst.data(), sizeof( T ) * count );
+	}
+
+private:
+	const char* m_data;
+	size_t m_size;
+	size_t m_cursor = 0;
+};
+
+class SceneWriter
+{
+public:
+	void write( const void* src, size_t size )
+	{
+		const char* bytes = (const char*) src;
+		m_buffer.insert( m_buffer.end(), bytes, bytes + size );
+	}
+	template< class T > void write( const T& src ) { write( &src, sizeof( T ) ); }
+	template< class T > void write( const Vector<T>& src )
+	{
+		if( !src.empty() )
+			write( src.data(), sizeof( T ) * src.size() );
+	}
+	Vector<char>& buffer( void ) { return m_buffer; }
+
+private:
+	Vector<char> m_buffer;
+};
+
+SceneFile::SceneFile( void )
+{
+
+}
+
+SceneFile::~SceneFile( void )
+{
+
+}
+
+Ptr<SceneFile> SceneFile::create( void )
+{
+	SceneFile* ret = new SceneFile();
+	MAGICAL_ASSERT( ret, "new SceneFile() failed" );
+	return Ptr<SceneFile>( Ptrctor<SceneFile>( ret ) );
+}
+
+Ptr<SceneFile> SceneFile::create( const char* file )
+{
+	SceneFile* ret = new SceneFile();
+	MAGICAL_ASSERT( ret, "new SceneFile() failed" );
+	Ptr<SceneFile> scene_file = Ptr<SceneFile>( Ptrctor<SceneFile>( ret ) );
+	if( !scene_file->load( file ) )
+		return nullptr;
+	return scene_file;
+}
+
+bool SceneFile::load( const char* file )
+{
+	MAGICAL_ASSERT( file, "should not be nullptr." );
+
+	Ptr<Data> data = Assets::loadFile( file );
+	if( !data )
+		return false;
+
+	if( !load( data.get() ) )
+	{
+		MAGICAL_SET_LAST_ERROR( System::format<512>( "load scene file failed! file(%s).", file ).c_str() );
+		MAGICAL_LOG_LAST_ERROR();
+		return false;
+	}
+	return true;
+}
+
+bool SceneFile::load( const Data* data )
+{
+	MAGICAL_ASSERT( data, "should not be nullptr." );
+
+	clear();
+
+	SceneReader reader( data->cPtr(), data->size() );
+	uint32_t magic, version, node_count, type_count, behaviour_count, names_size;
+
+	if( !reader.read( magic ) || !reader.read( version ) || magic != Magic || version != Version )
+		return false;
+
+	if( !reader.read( node_count ) || !reader.read( type_count ) ||
+		!reader.read( behaviour_count ) || !reader.read( names_size ) )
+		return false;
+
+	if( type_count > UINT16_MAX )
+		return false;
+
+	m_behaviour_types.resize( type_count );
+	for( auto& type_name : m_behaviour_types )
+	{
+		uint16_t len;
+		if( !reader.read( len ) )
+			return false;
+		type_name.resize( len );
+		if( len > 0 && !reader.read( &type_name[0], len ) )
+			return false;
+	}
+
+	if( !reader.read( m_nodes, node_count ) ||
+		!reader.read( m_behaviours, behaviour_count ) ||
+		!reader.read( m_names, names_size ) )
+	{
+		clear();
+		return false;
+	}
+
+	// 校验所有索引，保证实例化时不必再做检查
+	bool valid = true;
+	for( auto index : m_behaviours )
+	{
+		if( index >= type_count )
+			valid = false;
+	}
+
+	for( size_t i = 0; valid && i < m_nodes.size(); ++i )
+	{
+		const SceneNode& node = m_nodes[i];
+		if( node.parent < -1 || node.parent >= (int32_t) i ||
+			node.type > (uint8_t) ObjectType::Light ||
+			node.behaviour_offset > behaviour_count ||
+			node.behaviour_count > behaviour_count - node.behaviour_offset ||
+			node.name_offset > names_size ||
+			node.name_length >= names_size - node.name_offset ||
+			m_names[ node.name_offset + node.name_length ] != 0 )
+			valid = false;
+	}
+
+	if( !valid )
+	{
+		clear();
+		return false;
+	}
+	return true;
+}
+
+Ptr<Data> SceneFile::save( void ) const
+{
+	SceneWriter writer;
+	writer.write( (uint32_t) Magic );
+	writer.write( (uint32_t) Version );
+	writer.write( (uint32_t) m_nodes.size() );
+	writer.write( (uint32_t) m_behaviour_types.size() );
+	writer.write( (uint32_t) m_behaviours.size() );
+	writer.write( (uint32_t) m_names.size() );
+
+	for( const auto& type_name : m_behaviour_types )
+	{
+		writer.write( (uint16_t) type_name.length() );
+		writer.write( type_name.c_str(), type_name.length() );
+	}
+
+	writer.write( m_nodes );
+	writer.write( m_behaviours );
+	writer.write( m_names );
+
+	Vector<char>& buffer = writer.buffer();
+	Ptr<Data> data = Data::create( buffer.size() );
+	memcpy( data->cPtr(), buffer.data(), buffer.size() );
+	return data;
+}
+
+void SceneFile::clear( void )
+{
+	m_nodes.clear();
+	m_behaviours.clear();
+	m_behaviour_types.clear();
+	m_names.clear();
+}
+
+size_t SceneFile::addNode( int parent, ObjectType type, const char* name, const Vector3& t, const Quaternion& r, const Vector3& s )
+{
+	MAGICAL_ASSERT( parent >= -1 && parent < (int) m_nodes.size(), "Invalid parent index!" );
+
+	if( name == nullptr )
+		name = "";
+
+	SceneNode node;
+	node.parent = parent;
+	node.type = (uint8_t) type;
+	node.reserved = 0;
+	node.behaviour_count = 0;
+	node.behaviour_offset = (uint32_t) m_behaviours.size();
+	node.name_offset = (uint32_t) m_names.size();
+	node.name_length = (uint32_t) strlen( name );
+	node.position[0] = t.x; node.position[1] = t.y; node.position[2] = t.z;
+	node.rotation[0] = r.x; node.rotation[1] = r.y; node.rotation[2] = r.z; node.rotation[3] = r.w;
+	node.scale[0] = s.x; node.scale[1] = s.y; node.scale[2] = s.z;
+
+	m_names.insert( m_names.end(), name, name + node.name_length + 1 );
+	m_nodes.push_back( node );
+	return m_nodes.size() - 1;
+}
+
+void SceneFile::addBehaviour( size_t node, const char* type_name )
+{
+	MAGICAL_ASSERT( type_name, "should not be nullptr." );
+	MAGICAL_ASSERT( !m_nodes.empty() && node == m_nodes.size() - 1, "Invalid, behaviours must be added to the last node!" );
+	MAGICAL_ASSERT( m_nodes[node].type != (uint8_t) ObjectType::Object, "Invalid, object can't hold behaviours!" );
+
+	size_t index = 0;
+	while( index < m_behaviour_types.size() && m_behaviour_types[index] != type_name )
+		++ index;
+
+	if( index == m_behaviour_types.size() )
+	{
+		MAGICAL_ASSERT( index < UINT16_MAX, "Too many behaviour types!" );
+		m_behaviour_types.push_back( type_name );
+	}
+
+	m_behaviours.push_back( (uint16_t) index );
+	m_nodes[node].behaviour_count ++;
+}
+
+const SceneNode& SceneFile::getNode( size_t index ) const
+{
+	MAGICAL_ASSERT( index < m_nodes.size(), "Invalid index!" );
+	return m_nodes[index];
+}
+
+const char* SceneFile::getNodeName( size_t index ) const
+{
+	MAGICAL_ASSERT( index < m_nodes.size(), "Invalid index!" );
+	return m_names.data() + m_nodes[index].name_offset;
+}
+
+const string& SceneFile::getBehaviourType( size_t index ) const
+{
+	MAGICAL_ASSERT( index < m_behaviour_types.size(), "Invalid index!" );
+	return m_behaviour_types[index];
+}
+
+size_t SceneFile::getNodeBehaviour( size_t node, size_t i ) const
+{
+	MAGICAL_ASSERT( node < m_nodes.size() && i < m_nodes[node].behaviour_count, "Invalid index!" );
+	return m_behaviours[ m_nodes[node].behaviour_offset + i ];
+}
+
+NAMESPACE_END
\ No newline at end of file
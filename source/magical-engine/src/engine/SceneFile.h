@@ -0,0 +1,108 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __SCENE_FILE_H__
+#define __SCENE_FILE_H__
+
+#include "magical-macros.h"
+#include "magical-math.h"
+#include "Common.h"
+#include "Reference.h"
+#include "Vector.h"
+#include "Data.h"
+#include "ObjectType.h"
+
+NAMESPACE_MAGICAL
+
+/*
+场景文件中的节点记录，定长并按文件中的顺序存放
+父节点总在子节点之前，parent为-1表示挂到加载时指定的根节点下
+*/
+struct SceneNode
+{
+	int32_t parent;
+	uint8_t type;
+	uint8_t reserved;
+	uint16_t behaviour_count;
+	uint32_t behaviour_offset;
+	uint32_t name_offset;
+	uint32_t name_length;
+	float position[3];
+	float rotation[4];
+	float scale[3];
+};
+
+/*
+二进制场景文件
+
+保存Object/Entity层级、局部TRS、名字和挂载的行为类型，
+节点表为定长记录，名字统一存放在以0结尾的字符串区，行为类型以类型表的索引保存，
+加载时只做整块拷贝和越界检查，实例化由SceneLoader分帧完成
+*/
+class SceneFile : public Reference
+{
+public:
+	enum : uint32_t
+	{
+		Magic = 0x454e4353, // "SCNE"
+		Version = 1,
+	};
+
+public:
+	SceneFile( void );
+	virtual ~SceneFile( void );
+	static Ptr<SceneFile> create( void );
+	static Ptr<SceneFile> create( const char* file );
+
+public:
+	bool load( const char* file );
+	bool load( const Data* data );
+	Ptr<Data> save( void ) const;
+	void clear( void );
+
+public:
+	/*
+	添加节点，返回节点索引，parent必须是已添加的节点或-1
+	行为只能添加到最后添加的节点上
+	*/
+	size_t addNode( int parent, ObjectType type, const char* name, const Vector3& t, const Quaternion& r, const Vector3& s );
+	void addBehaviour( size_t node, const char* type_name );
+
+public:
+	size_t nodeCount( void ) const { return m_nodes.size(); }
+	const SceneNode& getNode( size_t index ) const;
+	const char* getNodeName( size_t index ) const;
+	size_t behaviourTypeCount( void ) const { return m_behaviour_types.size(); }
+	const string& getBehaviourType( size_t index ) const;
+	size_t getNodeBehaviour( size_t node, size_t i ) const;
+
+protected:
+	Vector<SceneNode> m_nodes;
+	Vector<uint16_t> m_behaviours;
+	Vector<string> m_behaviour_types;
+	Vector<char> m_names;
+};
+
+NAMESPACE_END
+
+#endif //__SCENE_FILE_H__
\ No newline at end of file
@@ -0,0 +1,244 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "SceneLoader.h"
+#include "Assets.h"
+#include "Camera.h"
+#include "Utils.h"
+
+NAMESPACE_MAGICAL
+
+static UnorderedMap<string, SceneLoader::BehaviourCreator> _behaviour_creators;
+
+SceneLoader::SceneLoader( void )
+{
+
+}
+
+SceneLoader::~SceneLoader( void )
+{
+	if( m_state == State::Reading )
+		Assets::cancelLoad( m_request );
+
+	for( auto node : m_nodes )
+	{
+		node->release();
+	}
+}
+
+Ptr<SceneLoader> SceneLoader::create( const char* file, Object* root, int priority )
+{
+	MAGICAL_ASSERT( file && root, "should not be nullptr." );
+
+	SceneLoader* ret = new SceneLoader();
+	MAGICAL_ASSERT( ret, "new SceneLoader() failed" );
+	ret->m_root = root;
+	ret->m_file_name = file;
+
+	// 加载器析构时会取消请求，回调执行时加载器一定还存在
+	ret->m_request = Assets::loadFileAsync( file, [ret]( const Ptr<Data>& data ){
+		ret->onFileLoaded( data );
+	}, priority );
+	return Ptr<SceneLoader>( Ptrctor<SceneLoader>( ret ) );
+}
+
+Ptr<SceneLoader> SceneLoader::create( SceneFile* scene_file, Object* root )
+{
+	MAGICAL_ASSERT( scene_file && root, "should not be nullptr." );
+
+	SceneLoader* ret = new SceneLoader();
+	MAGICAL_ASSERT( ret, "new SceneLoader() failed" );
+	ret->m_root = root;
+	ret->m_scene_file = scene_file;
+	ret->prepare();
+	return Ptr<SceneLoader>( Ptrctor<SceneLoader>( ret ) );
+}
+
+void SceneLoader::registerBehaviour( const char* name, BehaviourCreator creator )
+{
+	MAGICAL_ASSERT( name && creator, "should not be nullptr." );
+
+	_behaviour_creators[ name ] = creator;
+}
+
+void SceneLoader::unregisterBehaviour( const char* name )
+{
+	MAGICAL_ASSERT( name, "should not be nullptr." );
+
+	_behaviour_creators.erase( name );
+}
+
+bool SceneLoader::update( int64_t budget )
+{
+	if( m_state != State::Instantiating )
+		return isDone();
+
+	int64_t deadline = Time::currentMicroseconds() + budget;
+	size_t count = m_scene_file->nodeCount();
+
+	// 至少实例化一批，保证预算很小时也能推进
+	while( m_next < count )
+	{
+		size_t end = Math::min( m_next + BatchSize, count );
+		for( ; m_next < end; ++ m_next )
+		{
+			instantiate( m_next );
+		}
+
+		if( Time::currentMicroseconds() >= deadline )
+			break;
+	}
+
+	if( m_next == count )
+		finish( State::Done );
+
+	return isDone();
+}
+
+void SceneLoader::cancel( void )
+{
+	if( isDone() )
+		return;
+
+	if( m_state == State::Reading )
+		Assets::cancelLoad( m_request );
+
+	finish( State::Cancelled );
+}
+
+float SceneLoader::getProgress( void ) const
+{
+	if( m_state == State::Done )
+		return 1.0f;
+	if( !m_scene_file || m_scene_file->nodeCount() == 0 )
+		return 0.0f;
+	return (float) m_next / (float) m_scene_file->nodeCount();
+}
+
+Object* SceneLoader::getNode( size_t index ) const
+{
+	MAGICAL_ASSERT( index < m_nodes.size(), "Invalid index, node is not instantiated yet!" );
+	return m_nodes[index];
+}
+
+void SceneLoader::onFileLoaded( const Ptr<Data>& data )
+{
+	if( m_state != State::Reading )
+		return;
+
+	if( !data )
+	{
+		finish( State::Failed );
+		return;
+	}
+
+	m_scene_file = SceneFile::create();
+	if( !m_scene_file->load( data.get() ) )
+	{
+		MAGICAL_SET_LAST_ERROR( System::format<512>( "load scene file failed! file(%s).", m_file_name.c_str() ).c_str() );
+		MAGICAL_LOG_LAST_ERROR();
+		finish( State::Failed );
+		return;
+	}
+
+	prepare();
+}
+
+/*
+实例化之前先把文件中的行为类型名解析为创建函数，避免逐节点查表
+*/
+void SceneLoader::prepare( void )
+{
+	size_t type_count = m_scene_file->behaviourTypeCount();
+	m_creators.resize( type_count );
+	for( size_t i = 0; i < type_count; ++i )
+	{
+		const string& type_name = m_scene_file->getBehaviourType( i );
+		auto itr = _behaviour_creators.find( type_name );
+		if( itr == _behaviour_creators.end() )
+		{
+			m_creators[i] = nullptr;
+			MAGICAL_SET_LAST_ERROR( System::format<512>( "unregistered behaviour type(%s) will be ignored.", type_name.c_str() ).c_str() );
+			MAGICAL_LOG_LAST_ERROR();
+		}
+		else
+		{
+			m_creators[i] = itr->second;
+		}
+	}
+
+	m_nodes.reserve( m_scene_file->nodeCount() );
+	m_state = State::Instantiating;
+}
+
+void SceneLoader::instantiate( size_t index )
+{
+	const SceneNode& node = m_scene_file->getNode( index );
+	const char* name = m_scene_file->getNodeName( index );
+
+	Object* object = nullptr;
+	switch( (ObjectType) node.type )
+	{
+		case ObjectType::Entity:
+			object = Entity::create( name ).take();
+			break;
+		case ObjectType::Camera:
+			object = Camera::create( name ).take();
+			break;
+		default:
+			// 光源暂无对应的实现，以Object占位保留层级
+			object = Object::create( name ).take();
+			break;
+	}
+	m_nodes.push_back( object );
+
+	object->setTrs(
+		Vector3( node.position[0], node.position[1], node.position[2] ),
+		Quaternion( node.rotation[0], node.rotation[1], node.rotation[2], node.rotation[3] ),
+		Vector3( node.scale[0], node.scale[1], node.scale[2] ) );
+
+	// 先挂行为再addChild，使行为的onStart随节点的start一起执行
+	if( node.behaviour_count > 0 && object->getFeature() != Object::Feature )
+	{
+		Entity* entity = static_cast<Entity*>( object );
+		for( size_t i = 0; i < node.behaviour_count; ++i )
+		{
+			BehaviourCreator creator = m_creators[ m_scene_file->getNodeBehaviour( index, i ) ];
+			if( creator )
+				creator( entity );
+		}
+	}
+
+	Object* parent = node.parent < 0 ? m_root.get() : m_nodes[ node.parent ];
+	parent->addChild( object );
+}
+
+void SceneLoader::finish( State state )
+{
+	m_state = state;
+	m_request = 0;
+	m_creators.clear();
+	m_scene_file = nullptr;
+}
+
+NAMESPACE_END
\ No newline at end of file
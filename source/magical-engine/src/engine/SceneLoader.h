@@ -0,0 +1,115 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __SCENE_LOADER_H__
+#define __SCENE_LOADER_H__
+
+#include "magical-macros.h"
+#include "Common.h"
+#include "Reference.h"
+#include "Vector.h"
+#include "Map.h"
+#include "Data.h"
+#include "Object.h"
+#include "Entity.h"
+#include "SceneFile.h"
+
+NAMESPACE_MAGICAL
+
+/*
+流式场景加载器
+
+文件由Assets的后台线程读取，读取完成后每次update在给定的时间预算内
+按文件顺序实例化节点并addChild到父节点上，超出预算的节点顺延到下一次update，
+大场景因此可以分摊到多帧完成而不会卡住主循环
+
+行为类型需要事先以名字注册，文件中未注册的行为类型会被忽略并输出错误
+*/
+class SceneLoader : public Reference
+{
+public:
+	typedef void ( *BehaviourCreator )( Entity* entity );
+
+	enum class State
+	{
+		Reading,
+		Instantiating,
+		Done,
+		Failed,
+		Cancelled,
+	};
+
+	enum : size_t
+	{
+		// 每实例化这么多个节点检查一次时间
+		BatchSize = 64,
+	};
+
+public:
+	SceneLoader( void );
+	virtual ~SceneLoader( void );
+	static Ptr<SceneLoader> create( const char* file, Object* root, int priority = 0 );
+	static Ptr<SceneLoader> create( SceneFile* scene_file, Object* root );
+
+public:
+	template< class TBehaviour > static void registerBehaviour( const char* name );
+	static void registerBehaviour( const char* name, BehaviourCreator creator );
+	static void unregisterBehaviour( const char* name );
+
+public:
+	/*
+	在budget微秒内继续实例化节点，完成（包括失败和取消）后返回true
+	*/
+	bool update( int64_t budget );
+	void cancel( void );
+
+public:
+	State getState( void ) const { return m_state; }
+	bool isDone( void ) const { return m_state != State::Reading && m_state != State::Instantiating; }
+	float getProgress( void ) const;
+	size_t getInstantiatedCount( void ) const { return m_next; }
+	Object* getRoot( void ) const { return m_root.get(); }
+	Object* getNode( size_t index ) const;
+
+protected:
+	void onFileLoaded( const Ptr<Data>& data );
+	void prepare( void );
+	void instantiate( size_t index );
+	void finish( State state );
+
+protected:
+	State m_state = State::Reading;
+	uint32_t m_request = 0;
+	string m_file_name;
+	Ptr<Object> m_root;
+	Ptr<SceneFile> m_scene_file;
+	Vector<BehaviourCreator> m_creators;
+	Vector<Object*> m_nodes;
+	size_t m_next = 0;
+};
+
+#include "SceneLoader.inl"
+
+NAMESPACE_END
+
+#endif //__SCENE_LOADER_H__
\ No newline at end of file
@@ -0,0 +1,295 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "SpatialHash2.h"
+
+NAMESPACE_MAGICAL
+
+static inline bool overlaps( const Box2& a, const Box2& b )
+{
+	return a.min.x <= b.max.x && a.max.x >= b.min.x && a.min.y <= b.max.y && a.max.y >= b.min.y;
+}
+
+/*
+floorf在没有SSE4.1时是函数调用，update中每个对象要算4次，改为截断后修正负数
+*/
+inline int SpatialHash2::cellCoord( float v ) const
+{
+	float f = v * m_inv_cell_size;
+	int i = (int) f;
+	return i - ( f < (float) i );
+}
+
+inline size_t SpatialHash2::bucketIndex( int x, int y ) const
+{
+	return (size_t)( ( (unsigned int) x & m_width_mask ) | ( ( (unsigned int) y & m_height_mask ) << m_width_shift ) );
+}
+
+SpatialHash2::SpatialHash2( float cell_size, size_t bucket_count )
+: m_cell_size( cell_size )
+, m_inv_cell_size( 1.0f / cell_size )
+{
+	MAGICAL_ASSERT( cell_size > 0.0f, "Invalid cell size!" );
+
+	// 桶排成宽高都是2的幂的网格，宽不小于高
+	int bits = 0;
+	while( ( (size_t) 1 << bits ) < bucket_count )
+		++bits;
+
+	m_width_shift = ( bits + 1 ) / 2;
+	m_width_mask = ( 1u << m_width_shift ) - 1;
+	m_height_mask = ( 1u << ( bits / 2 ) ) - 1;
+	m_bucket_count = (size_t) 1 << bits;
+	m_bucket_counts.resize( m_bucket_count );
+	m_bucket_starts.resize( m_bucket_count + 1 );
+}
+
+SpatialHash2::~SpatialHash2( void )
+{
+
+}
+
+int SpatialHash2::insert( const Shape2& shape, void* user_data )
+{
+	int index;
+	if( m_free_list != NullProxy )
+	{
+		index = m_free_list;
+		m_free_list = m_proxies[ index ].next;
+	}
+	else
+	{
+		index = (int) m_proxies.size();
+		m_proxies.push_back( Proxy() );
+		m_query_marks.push_back( 0 );
+	}
+
+	Proxy& proxy = m_proxies[ index ];
+	proxy.shape = shape;
+	proxy.user_data = user_data;
+	proxy.x0 = proxy.y0 = 0;
+	proxy.x1 = proxy.y1 = -1;
+	proxy.next = NullProxy;
+	++m_proxy_count;
+
+	update( index );
+	return index;
+}
+
+void SpatialHash2::remove( int proxy )
+{
+	MAGICAL_ASSERT( 0 <= proxy && proxy < (int) m_proxies.size(), "Invalid proxy!" );
+
+	Proxy& node = m_proxies[ proxy ];
+	countCells( node, -1 );
+	node.shape = Shape2();
+	node.user_data = nullptr;
+	node.next = m_free_list;
+	m_free_list = proxy;
+	--m_proxy_count;
+	m_dirty = true;
+}
+
+void SpatialHash2::update( int proxy )
+{
+	MAGICAL_ASSERT( 0 <= proxy && proxy < (int) m_proxies.size(), "Invalid proxy!" );
+
+	Proxy& node = m_proxies[ proxy ];
+	Collision2::bounds( node.box, node.shape );
+	int x0 = cellCoord( node.box.min.x );
+	int y0 = cellCoord( node.box.min.y );
+	int x1 = cellCoord( node.box.max.x );
+	int y1 = cellCoord( node.box.max.y );
+
+	// 多数情况下对象仍在原来的单元中，只有单元范围变化时才更新各桶的单元项数量
+	if( x0 != node.x0 || y0 != node.y0 || x1 != node.x1 || y1 != node.y1 )
+	{
+		countCells( node, -1 );
+		node.x0 = x0;
+		node.y0 = y0;
+		node.x1 = x1;
+		node.y1 = y1;
+		countCells( node, 1 );
+	}
+	m_dirty = true;
+}
+
+void SpatialHash2::clear( void )
+{
+	m_proxies.clear();
+	m_entries.clear();
+	m_query_marks.clear();
+	std::fill( m_bucket_counts.begin(), m_bucket_counts.end(), 0 );
+	m_free_list = NullProxy;
+	m_proxy_count = 0;
+	m_dirty = true;
+}
+
+void SpatialHash2::findPairs( Vector<Pair>& out ) const
+{
+	build();
+
+	for( size_t b = 0; b < m_bucket_count; ++b )
+	{
+		const Entry* begin = m_entries.data() + m_bucket_starts[ b ];
+		const Entry* end = m_entries.data() + m_bucket_starts[ b + 1 ];
+
+		for( const Entry* e1 = begin; e1 < end; ++e1 )
+		{
+			for( const Entry* e2 = e1 + 1; e2 < end; ++e2 )
+			{
+				// 单元内两者都覆盖该单元，单元列等于两者起始列的较大值，当且仅当它是其中之一的第一列
+				// 各条件的结果难以预测，全部算完再判断一次，避免连续的分支预测失败
+				unsigned int flags = e1->flags | e2->flags;
+				bool hit = ( flags == ( FirstColumn | FirstRow ) ) & ( e1->x == e2->x ) & ( e1->y == e2->y ) &
+					( e1->box.min.x <= e2->box.max.x ) & ( e1->box.max.x >= e2->box.min.x ) &
+					( e1->box.min.y <= e2->box.max.y ) & ( e1->box.max.y >= e2->box.min.y );
+				if( !hit )
+					continue;
+
+				Pair pair = { e1->proxy, e2->proxy };
+				out.push_back( pair );
+			}
+		}
+	}
+}
+
+void SpatialHash2::findContacts( Vector<Pair>& out ) const
+{
+	size_t begin = out.size();
+	findPairs( out );
+
+	size_t end = begin;
+	for( size_t i = begin; i < out.size(); ++i )
+	{
+		const Pair& pair = out[i];
+		if( Collision2::intersects( m_proxies[ pair.proxy1 ].shape, m_proxies[ pair.proxy2 ].shape ) )
+			out[ end++ ] = pair;
+	}
+	out.resize( end );
+}
+
+void SpatialHash2::queryBox( Vector<int>& out, const Box2& box ) const
+{
+	build();
+
+	if( ++m_query_stamp == 0 )
+	{
+		std::fill( m_query_marks.begin(), m_query_marks.end(), 0 );
+		m_query_stamp = 1;
+	}
+
+	int x0 = cellCoord( box.min.x );
+	int y0 = cellCoord( box.min.y );
+	int x1 = cellCoord( box.max.x );
+	int y1 = cellCoord( box.max.y );
+
+	for( int y = y0; y <= y1; ++y )
+	{
+		for( int x = x0; x <= x1; ++x )
+		{
+			size_t b = bucketIndex( x, y );
+			for( unsigned int i = m_bucket_starts[ b ]; i < m_bucket_starts[ b + 1 ]; ++i )
+			{
+				const Entry& entry = m_entries[i];
+				if( entry.x != x || entry.y != y || m_query_marks[ entry.proxy ] == m_query_stamp )
+					continue;
+
+				m_query_marks[ entry.proxy ] = m_query_stamp;
+				if( overlaps( entry.box, box ) )
+					out.push_back( entry.proxy );
+			}
+		}
+	}
+}
+
+void SpatialHash2::countCells( const Proxy& node, int delta )
+{
+	for( int y = node.y0; y <= node.y1; ++y )
+	{
+		for( int x = node.x0; x <= node.x1; ++x )
+			m_bucket_counts[ bucketIndex( x, y ) ] += delta;
+	}
+}
+
+const Shape2& SpatialHash2::getShape( int proxy ) const
+{
+	MAGICAL_ASSERT( 0 <= proxy && proxy < (int) m_proxies.size(), "Invalid proxy!" );
+	return m_proxies[ proxy ].shape;
+}
+
+const Box2& SpatialHash2::getBounds( int proxy ) const
+{
+	MAGICAL_ASSERT( 0 <= proxy && proxy < (int) m_proxies.size(), "Invalid proxy!" );
+	return m_proxies[ proxy ].box;
+}
+
+void* SpatialHash2::getUserData( int proxy ) const
+{
+	MAGICAL_ASSERT( 0 <= proxy && proxy < (int) m_proxies.size(), "Invalid proxy!" );
+	return m_proxies[ proxy ].user_data;
+}
+
+/*
+计数排序：各桶的单元项数量在update中增量维护，按前缀和把单元项散列到连续数组中
+*/
+void SpatialHash2::build( void ) const
+{
+	if( !m_dirty )
+		return;
+
+	m_bucket_starts[ 0 ] = 0;
+	for( size_t b = 0; b < m_bucket_count; ++b )
+		m_bucket_starts[ b + 1 ] = m_bucket_starts[ b ] + m_bucket_counts[ b ];
+
+	size_t entry_count = m_bucket_starts[ m_bucket_count ];
+	m_entries.resize( entry_count );
+	for( int i = 0; i < (int) m_proxies.size(); ++i )
+	{
+		const Proxy& node = m_proxies[i];
+		if( node.shape.type == Shape2::Type::Count )
+			continue;
+
+		for( int y = node.y0; y <= node.y1; ++y )
+		{
+			for( int x = node.x0; x <= node.x1; ++x )
+			{
+				// 借用当前桶的起始位置作为写入游标，散列完成后整体回退一位
+				Entry& entry = m_entries[ m_bucket_starts[ bucketIndex( x, y ) ]++ ];
+				entry.box = node.box;
+				entry.proxy = i;
+				entry.x = x;
+				entry.y = y;
+				entry.flags = ( x == node.x0 ? FirstColumn : 0 ) | ( y == node.y0 ? FirstRow : 0 );
+			}
+		}
+	}
+
+	for( size_t b = m_bucket_count; b > 0; --b )
+		m_bucket_starts[ b ] = m_bucket_starts[ b - 1 ];
+	m_bucket_starts[ 0 ] = 0;
+
+	m_dirty = false;
+}
+
+NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,129 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __SPATIAL_HASH2_H__
+#define __SPATIAL_HASH2_H__
+
+#include "magical-macros.h"
+#include "magical-math.h"
+#include "Common.h"
+#include "Vector.h"
+#include "Collision2.h"
+
+NAMESPACE_MAGICAL
+
+/*
+二维均匀网格宽阶段
+
+对象移动后调用update只重新计算包围盒和所覆盖的单元范围，
+查询前按单元所在的桶对所有单元项做一次计数排序，桶内数据连续存放以减少缓存缺失，
+同一对对象只在两者包围盒重叠区域左下角所在的单元中输出一次，不需要额外去重
+
+单元坐标按桶网格的宽高取模映射到桶，相邻的单元落在相邻的桶中；
+cell_size取对象直径的1.5到2倍较合适，过小时每个对象覆盖的单元太多
+*/
+class SpatialHash2
+{
+public:
+	enum : int { NullProxy = -1 };
+
+	struct Pair
+	{
+		int proxy1;
+		int proxy2;
+	};
+
+public:
+	SpatialHash2( float cell_size = 1.0f, size_t bucket_count = 4096 );
+	~SpatialHash2( void );
+
+public:
+	int insert( const Shape2& shape, void* user_data = nullptr );
+	void remove( int proxy );
+	void update( int proxy );
+	void clear( void );
+
+public:
+	void findPairs( Vector<Pair>& out ) const;
+	void findContacts( Vector<Pair>& out ) const;
+	void queryBox( Vector<int>& out, const Box2& box ) const;
+
+public:
+	float getCellSize( void ) const { return m_cell_size; }
+	size_t proxyCount( void ) const { return m_proxy_count; }
+	const Shape2& getShape( int proxy ) const;
+	const Box2& getBounds( int proxy ) const;
+	void* getUserData( int proxy ) const;
+
+private:
+	struct Proxy
+	{
+		Shape2 shape;
+		void* user_data;
+		Box2 box;
+		int x0, y0, x1, y1;
+		int next;
+	};
+
+	// 单元项是否位于对象所覆盖范围的第一列、第一行，用于判断重叠区域左下角所在的单元
+	enum : unsigned int
+	{
+		FirstColumn = 1,
+		FirstRow = 2,
+	};
+
+	struct Entry
+	{
+		Box2 box;
+		int proxy;
+		int x;
+		int y;
+		unsigned int flags;
+	};
+
+	inline int cellCoord( float v ) const;
+	inline size_t bucketIndex( int x, int y ) const;
+	void countCells( const Proxy& node, int delta );
+	void build( void ) const;
+
+private:
+	float m_cell_size;
+	float m_inv_cell_size;
+	size_t m_bucket_count;
+	int m_width_shift;
+	unsigned int m_width_mask;
+	unsigned int m_height_mask;
+	size_t m_proxy_count = 0;
+	int m_free_list = NullProxy;
+	Vector<Proxy> m_proxies;
+	Vector<unsigned int> m_bucket_counts;
+	mutable bool m_dirty = true;
+	mutable Vector<unsigned int> m_bucket_starts;
+	mutable Vector<Entry> m_entries;
+	mutable Vector<int> m_query_marks;
+	mutable int m_query_stamp = 0;
+};
+
+NAMESPACE_END
+
+#endif //__SPATIAL_HASH2_H__
\ No newline at end of file
@@ -35,12 +35,19 @@ SOFTWARE.
 #include "Object.h"
 #include "Entity.h"
 #include "Camera.h"
+#include "AnimationClip.h"
+#include "Animator.h"
+#include "SceneFile.h"
+#include "SceneLoader.h"
 #include "Director.h"
 #include "Behaviour.h"
 //#include "AssetsSystem.h"
 #include "Log.h"
+#include "BinaryLog.h"
 #include "Input.h"
 #include "Utils.h"
+#include "Profiler.h"
+#include "Stats.h"
 
 //#include "LuaMacros.h"
 //#include "LuaSelector.h"
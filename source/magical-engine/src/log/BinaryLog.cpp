@@ -0,0 +1,335 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "BinaryLog.h"
+#include "LogRing.h"
+#include "Map.h"
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+#ifdef MAGICAL_SSE2
+#ifdef MAGICAL_WIN32
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+NAMESPACE_MAGICAL
+
+/*
+队列中的记录：格式描述地址、相对打开时刻的时钟计数、参数个数、类型标记、参数值
+时钟计数由后台线程换算为纳秒后写入文件
+*/
+enum : size_t
+{
+	RingSlotSize = 64,
+	RingSlotCount = 16384,
+	FormatOffset = 0,
+	TimeOffset = FormatOffset + sizeof( uint64_t ),
+	ArgcOffset = TimeOffset + sizeof( int64_t ),
+	TagsOffset = ArgcOffset + sizeof( uint8_t ),
+	MaxArgc = 32,
+};
+
+static LogRing<RingSlotSize, RingSlotCount> _ring;
+static std::atomic<bool> _enabled( false );
+static std::atomic<bool> _opened( false );
+static std::atomic<size_t> _dropped( 0 );
+static std::atomic<bool> _sleeping( false );
+static std::chrono::steady_clock::time_point _start;
+static int64_t _start_ticks = 0;
+
+static FILE* _file = nullptr;
+static std::thread _worker;
+static std::mutex _mutex;
+static std::condition_variable _wakeup;
+static bool _stopping = false;
+
+static inline int64_t elapsedNanoseconds( void )
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - _start ).count();
+}
+
+/*
+x86上直接读TSC，比steady_clock::now()快得多；要求TSC恒定频率，现代的x86处理器都满足
+*/
+static inline int64_t readTicks( void )
+{
+#ifdef MAGICAL_SSE2
+	return (int64_t) __rdtsc();
+#else
+	return std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+#endif
+}
+
+/*
+每纳秒的时钟计数，用打开以来的总时长校准，后台线程每批记录换算前更新一次
+*/
+static double nanosecondsPerTick( void )
+{
+#ifdef MAGICAL_SSE2
+	int64_t ticks = readTicks() - _start_ticks;
+	int64_t nanoseconds = elapsedNanoseconds();
+	return ticks > 0 ? (double) nanoseconds / ticks : 0.0;
+#else
+	return 1.0;
+#endif
+}
+
+/*
+逐8字节拷贝：GCC会把长度有上限的变长memcpy展开为rep movs，其启动开销比拷贝短字符串本身大得多
+*/
+static inline void copyBytes( char* dst, const char* src, size_t size )
+{
+	for( ; size >= 8; size -= 8, dst += 8, src += 8 )
+		memcpy( dst, src, 8 );
+	for( ; size > 0; -- size )
+		*dst ++ = *src ++;
+}
+
+BinaryLogRecord::BinaryLogRecord( const BinaryLogFormat* format, size_t argc )
+{
+	MAGICAL_ASSERT( argc <= MaxArgc, "Invalid, too many arguments!" );
+
+	uint64_t address = (uint64_t)(uintptr_t) format;
+	int64_t time = readTicks() - _start_ticks;
+	memcpy( m_buffer + FormatOffset, &address, sizeof( address ) );
+	memcpy( m_buffer + TimeOffset, &time, sizeof( time ) );
+	m_buffer[ ArgcOffset ] = (char) argc;
+	m_tag_cursor = TagsOffset;
+	m_size = TagsOffset + argc;
+}
+
+void BinaryLogRecord::putString( const char* v, size_t length )
+{
+	if( m_size + sizeof( uint16_t ) > MaxSize )
+	{
+		m_buffer[ m_tag_cursor ++ ] = (char) Missing;
+		return;
+	}
+
+	size_t space = MaxSize - m_size - sizeof( uint16_t );
+	uint16_t size = (uint16_t)( length < space ? length : space );
+
+	m_buffer[ m_tag_cursor ++ ] = (char) String;
+	memcpy( m_buffer + m_size, &size, sizeof( size ) );
+	m_size += sizeof( size );
+	if( size > 0 )
+	{
+		copyBytes( m_buffer + m_size, v, size );
+		m_size += size;
+	}
+}
+
+bool BinaryLog::open( const char* file )
+{
+	MAGICAL_ASSERT( file, "should not be nullptr." );
+
+	if( _opened.load() )
+		close();
+
+	_file = fopen( file, "wb" );
+	if( _file == nullptr )
+	{
+		MAGICAL_SET_LAST_ERROR( System::format( "open file(%s) failed!", file ).c_str() );
+		MAGICAL_LOG_LAST_ERROR();
+		return false;
+	}
+
+	BinaryLogHeader header;
+	header.magic = Magic;
+	header.version = Version;
+	header.start_time = std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::system_clock::now().time_since_epoch() ).count();
+	fwrite( &header, sizeof( header ), 1, _file );
+
+	_start = std::chrono::steady_clock::now();
+	_start_ticks = readTicks();
+	_ring.reset();
+	_stopping = false;
+	_worker = std::thread( &BinaryLog::workerLoop );
+	_opened.store( true );
+	_enabled.store( true );
+	return true;
+}
+
+/*
+写完队列中剩余的记录后关闭文件
+*/
+void BinaryLog::close( void )
+{
+	if( !_opened.load() )
+		return;
+
+	_enabled.store( false );
+	_opened.store( false );
+	{
+		std::lock_guard<std::mutex> lock( _mutex );
+		_stopping = true;
+		_wakeup.notify_one();
+	}
+	_worker.join();
+
+	fclose( _file );
+	_file = nullptr;
+}
+
+bool BinaryLog::isOpen( void )
+{
+	return _opened.load();
+}
+
+void BinaryLog::setEnabled( bool enabled )
+{
+	_enabled.store( enabled && _opened.load() );
+}
+
+bool BinaryLog::isEnabled( void )
+{
+	return _enabled.load( std::memory_order_acquire );
+}
+
+size_t BinaryLog::getDroppedCount( void )
+{
+	return _dropped.load();
+}
+
+void BinaryLog::flush( void )
+{
+	if( !_opened.load() )
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock( _mutex );
+		_wakeup.notify_one();
+	}
+	while( !_ring.empty() )
+	{
+		std::this_thread::yield();
+	}
+}
+
+void BinaryLog::commit( const BinaryLogRecord& record )
+{
+	if( !_ring.push( nullptr, 0, record.data(), record.size() ) )
+	{
+		_dropped.fetch_add( 1, std::memory_order_relaxed );
+		return;
+	}
+
+	if( _sleeping.load() && _ring.used() >= RingSlotCount / 2 )
+	{
+		std::lock_guard<std::mutex> lock( _mutex );
+		_wakeup.notify_one();
+	}
+}
+
+static void writeString( FILE* file, const char* str )
+{
+	size_t length = str ? strlen( str ) : 0;
+	uint16_t size = (uint16_t)( length < UINT16_MAX ? length : UINT16_MAX );
+	fwrite( &size, sizeof( size ), 1, file );
+	fwrite( str, 1, size, file );
+}
+
+/*
+后台线程把格式描述的地址映射为从0开始的id，描述第一次出现时先写入Format记录
+*/
+void BinaryLog::workerLoop( void )
+{
+	UnorderedMap<uint64_t, uint32_t> ids;
+	string record;
+
+	while( true )
+	{
+		bool stopping;
+		{
+			std::lock_guard<std::mutex> lock( _mutex );
+			stopping = _stopping;
+		}
+
+		bool written = false;
+		double scale = nanosecondsPerTick();
+		while( _ring.pop( record ) )
+		{
+			int64_t time;
+			memcpy( &time, record.data() + TimeOffset, sizeof( time ) );
+			time = (int64_t)( time * scale );
+			memcpy( &record[ TimeOffset ], &time, sizeof( time ) );
+
+			uint64_t address;
+			memcpy( &address, record.data() + FormatOffset, sizeof( address ) );
+
+			uint32_t id;
+			auto itr = ids.find( address );
+			if( itr == ids.end() )
+			{
+				const BinaryLogFormat* format = (const BinaryLogFormat*)(uintptr_t) address;
+				id = (uint32_t) ids.size();
+				ids.insert( std::make_pair( address, id ) );
+
+				uint8_t type = FormatRecord;
+				int32_t level = format->level;
+				int32_t line = format->line;
+				fwrite( &type, sizeof( type ), 1, _file );
+				fwrite( &id, sizeof( id ), 1, _file );
+				fwrite( &level, sizeof( level ), 1, _file );
+				fwrite( &line, sizeof( line ), 1, _file );
+				writeString( _file, format->file );
+				writeString( _file, format->format );
+			}
+			else
+			{
+				id = itr->second;
+			}
+
+			uint8_t type = EventRecord;
+			uint16_t size = (uint16_t)( record.size() - TimeOffset );
+			fwrite( &type, sizeof( type ), 1, _file );
+			fwrite( &id, sizeof( id ), 1, _file );
+			fwrite( &size, sizeof( size ), 1, _file );
+			fwrite( record.data() + TimeOffset, 1, size, _file );
+			written = true;
+		}
+
+		if( written )
+			fflush( _file );
+
+		std::unique_lock<std::mutex> lock( _mutex );
+		if( stopping && _ring.empty() )
+			return;
+
+		if( _stopping || !_ring.empty() )
+			continue;
+
+		// 记录不需要及时落盘，只在队列过半时被唤醒，否则定时批量写入
+		_sleeping.store( true );
+		_wakeup.wait_for( lock, std::chrono::milliseconds( 10 ) );
+		_sleeping.store( false );
+	}
+}
+
+NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,186 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __BINARY_LOG_H__
+#define __BINARY_LOG_H__
+
+#include "magical-macros.h"
+#include "Common.h"
+#include <string.h>
+
+/*
+结构化二进制日志
+
+调用处的格式描述为常量初始化的静态对象，热路径上只记录描述的地址、时间戳和参数的原始字节，
+格式化推迟到离线解码时进行（见BinaryLogDecoder），format使用printf语法
+*/
+#define MAGICAL_BLOG( level, format, ... ) do {                                                       \
+	static const ::magical::BinaryLogFormat _magical_blog_format = { level, __LINE__, format, __FILE__ }; \
+	if( ::magical::BinaryLog::isEnabled() )                                                           \
+		::magical::BinaryLog::write( _magical_blog_format, ##__VA_ARGS__ );                          \
+	} while(0)
+
+#define MAGICAL_BLOGD( format, ... ) MAGICAL_BLOG( ::magical::Log::Debug, format, ##__VA_ARGS__ )
+#define MAGICAL_BLOGW( format, ... ) MAGICAL_BLOG( ::magical::Log::Warning, format, ##__VA_ARGS__ )
+#define MAGICAL_BLOGE( format, ... ) MAGICAL_BLOG( ::magical::Log::Error, format, ##__VA_ARGS__ )
+
+NAMESPACE_MAGICAL
+
+struct BinaryLogFormat
+{
+	int level;
+	int line;
+	const char* format;
+	const char* file;
+};
+
+/*
+二进制日志文件格式
+
+文件头之后为连续的记录，每条记录以1字节的类型开始：
+Format记录在某个格式描述第一次出现时写入，Event记录引用格式描述的id，
+参数的类型标记与值紧随其后
+*/
+struct BinaryLogHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	int64_t start_time;
+};
+
+/*
+单条日志的编码缓冲，参数类型标记放在值之前，字符串超出缓冲时截断
+*/
+class BinaryLogRecord
+{
+public:
+	enum : size_t { MaxSize = 256 };
+
+	// Missing表示缓冲已满，该参数没有被记录
+	enum : uint8_t
+	{
+		Missing = '?',
+		Signed = 'i',
+		Unsigned = 'u',
+		Float = 'f',
+		String = 's',
+		Pointer = 'p',
+	};
+
+public:
+	BinaryLogRecord( const BinaryLogFormat* format, size_t argc );
+	const char* data( void ) const { return m_buffer; }
+	size_t size( void ) const { return m_size; }
+
+public:
+	void put( bool v ) { putValue( Signed, (int64_t) v ); }
+	void put( char v ) { putValue( Signed, (int64_t) v ); }
+	void put( signed char v ) { putValue( Signed, (int64_t) v ); }
+	void put( short v ) { putValue( Signed, (int64_t) v ); }
+	void put( int v ) { putValue( Signed, (int64_t) v ); }
+	void put( long v ) { putValue( Signed, (int64_t) v ); }
+	void put( long long v ) { putValue( Signed, (int64_t) v ); }
+	void put( unsigned char v ) { putValue( Unsigned, (uint64_t) v ); }
+	void put( unsigned short v ) { putValue( Unsigned, (uint64_t) v ); }
+	void put( unsigned int v ) { putValue( Unsigned, (uint64_t) v ); }
+	void put( unsigned long v ) { putValue( Unsigned, (uint64_t) v ); }
+	void put( unsigned long long v ) { putValue( Unsigned, (uint64_t) v ); }
+	void put( float v ) { putValue( Float, (double) v ); }
+	void put( double v ) { putValue( Float, v ); }
+	void put( const char* v ) { putString( v, v ? strlen( v ) : 0 ); }
+	void put( const string& v ) { putString( v.c_str(), v.length() ); }
+	void put( const void* v ) { putValue( Pointer, (uint64_t)(uintptr_t) v ); }
+
+private:
+	template< class T >
+	void putValue( uint8_t tag, T v )
+	{
+		if( m_size + sizeof( T ) > MaxSize )
+		{
+			m_buffer[ m_tag_cursor ++ ] = (char) Missing;
+			return;
+		}
+
+		m_buffer[ m_tag_cursor ++ ] = (char) tag;
+		memcpy( m_buffer + m_size, &v, sizeof( T ) );
+		m_size += sizeof( T );
+	}
+
+	void putString( const char* v, size_t length );
+
+private:
+	char m_buffer[ MaxSize ];
+	size_t m_size;
+	size_t m_tag_cursor;
+};
+
+class BinaryLog
+{
+public:
+	enum : uint32_t
+	{
+		Magic = 0x474c424d, // "MBLG"
+		Version = 1,
+	};
+
+	enum : uint8_t
+	{
+		FormatRecord = 1,
+		EventRecord = 2,
+	};
+
+public:
+	/*
+	打开日志文件并启动后台写入线程，之后isEnabled为true
+	close会写完队列中剩余的记录，调用时不应再有其他线程写入
+	*/
+	static bool open( const char* file );
+	static void close( void );
+	static bool isOpen( void );
+	static void setEnabled( bool enabled );
+	static bool isEnabled( void );
+	static size_t getDroppedCount( void );
+	// 唤醒后台线程并等待它取走队列中已有的记录，不保证已写入磁盘
+	static void flush( void );
+
+public:
+	/*
+	队列满时直接丢弃并计数，调用线程不会等待
+	*/
+	template< class... Args >
+	static void write( const BinaryLogFormat& format, const Args&... args )
+	{
+		BinaryLogRecord record( &format, sizeof...( Args ) );
+		int expand[] = { 0, ( record.put( args ), 0 )... };
+		(void) expand;
+		commit( record );
+	}
+
+private:
+	static void commit( const BinaryLogRecord& record );
+	static void workerLoop( void );
+};
+
+NAMESPACE_END
+
+#endif //__BINARY_LOG_H__
\ No newline at end of file
@@ -0,0 +1,323 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "BinaryLogDecoder.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <ctype.h>
+
+NAMESPACE_MAGICAL
+
+enum : uint32_t
+{
+	Magic = 0x474c424d, // "MBLG"
+	Version = 1,
+	FormatRecord = 1,
+	EventRecord = 2,
+};
+
+class DecoderReader
+{
+public:
+	DecoderReader( const char* data, size_t size ) : m_data( data ), m_size( size ) {}
+	bool eof( void ) const { return m_cursor >= m_size; }
+	bool read( void* dst, size_t size )
+	{
+		if( size > m_size - m_cursor )
+			return false;
+		memcpy( dst, m_data + m_cursor, size );
+		m_cursor += size;
+		return true;
+	}
+	template< class T > bool read( T& dst ) { return read( &dst, sizeof( T ) ); }
+	bool read( std::string& dst )
+	{
+		uint16_t size;
+		if( !read( size ) || size > m_size - m_cursor )
+			return false;
+		dst.assign( m_data + m_cursor, size );
+		m_cursor += size;
+		return true;
+	}
+
+private:
+	const char* m_data;
+	size_t m_size;
+	size_t m_cursor = 0;
+};
+
+static const char* levelName( int level )
+{
+	switch( level )
+	{
+		case 0: return "DEBUG";
+		case 1: return "WARNING";
+		case 2: return "ERROR";
+		default: return "UNKNOWN";
+	}
+}
+
+static void appendFormat( std::string& out, const char* format, ... )
+{
+	char buffer[ 512 ];
+	va_list args;
+	va_start( args, format );
+	int length = vsnprintf( buffer, sizeof( buffer ), format, args );
+	va_end( args );
+
+	if( length < 0 )
+		return;
+
+	if( length < (int) sizeof( buffer ) )
+	{
+		out.append( buffer, length );
+		return;
+	}
+
+	std::vector<char> large( length + 1 );
+	va_start( args, format );
+	vsnprintf( large.data(), large.size(), format, args );
+	va_end( args );
+	out.append( large.data(), length );
+}
+
+bool BinaryLogDecoder::decodeFile( const char* file, std::string& out )
+{
+	FILE* fp = fopen( file, "rb" );
+	if( fp == nullptr )
+	{
+		m_error = std::string( "open file failed: " ) + file;
+		return false;
+	}
+
+	std::vector<char> data;
+	char buffer[ 64 * 1024 ];
+	size_t count;
+	while( ( count = fread( buffer, 1, sizeof( buffer ), fp ) ) > 0 )
+	{
+		data.insert( data.end(), buffer, buffer + count );
+	}
+	fclose( fp );
+
+	return decode( data.data(), data.size(), out );
+}
+
+/*
+文件末尾不完整的记录（进程崩溃时可能出现）被忽略，之前的记录照常输出
+*/
+bool BinaryLogDecoder::decode( const char* data, size_t size, std::string& out )
+{
+	m_formats.clear();
+	m_error.clear();
+
+	DecoderReader reader( data, size );
+	uint32_t magic, version;
+	int64_t start_time;
+	if( !reader.read( magic ) || !reader.read( version ) || !reader.read( start_time ) ||
+		magic != Magic || version != Version )
+	{
+		m_error = "invalid binary log header";
+		return false;
+	}
+
+	std::vector<Argument> args;
+	while( !reader.eof() )
+	{
+		uint8_t type;
+		uint32_t id;
+		if( !reader.read( type ) || !reader.read( id ) )
+			break;
+
+		if( type == FormatRecord )
+		{
+			Format format;
+			int32_t level, line;
+			if( !reader.read( level ) || !reader.read( line ) || !reader.read( format.file ) || !reader.read( format.format ) )
+				break;
+
+			format.level = level;
+			format.line = line;
+			if( id >= m_formats.size() )
+				m_formats.resize( id + 1 );
+			m_formats[id] = format;
+		}
+		else if( type == EventRecord )
+		{
+			uint16_t length;
+			std::string payload;
+			if( !reader.read( length ) || length < sizeof( int64_t ) + sizeof( uint8_t ) )
+				break;
+			payload.resize( length );
+			if( !reader.read( &payload[0], length ) )
+				break;
+
+			if( id >= m_formats.size() )
+			{
+				m_error = "event references unknown format";
+				return false;
+			}
+
+			DecoderReader values( payload.data(), payload.size() );
+			int64_t time;
+			uint8_t argc;
+			values.read( time );
+			values.read( argc );
+
+			std::string tags( argc, 0 );
+			if( argc > 0 && !values.read( &tags[0], argc ) )
+				break;
+
+			// 上一条记录的参数不能残留到这一条，每个参数都从零值开始
+			args.assign( argc, Argument() );
+			bool valid = true;
+			for( size_t i = 0; i < argc; ++i )
+			{
+				Argument& arg = args[i];
+				arg.tag = (uint8_t) tags[i];
+				switch( arg.tag )
+				{
+					case 'i': valid = valid && values.read( arg.i ); arg.u = (uint64_t) arg.i; arg.f = (double) arg.i; break;
+					case 'u': valid = valid && values.read( arg.u ); arg.i = (int64_t) arg.u; arg.f = (double) arg.u; break;
+					case 'p': valid = valid && values.read( arg.u ); arg.i = (int64_t) arg.u; break;
+					case 'f': valid = valid && values.read( arg.f ); arg.i = (int64_t) arg.f; arg.u = (uint64_t) arg.i; break;
+					case 's': valid = valid && values.read( arg.s ); break;
+					// 缓冲已满时写入端不记录值，之后的参数仍然对齐
+					case '?': break;
+					// 未知的类型不知道值的长度，之后的参数都无法读取
+					default: valid = false; break;
+				}
+				if( !valid )
+					arg.tag = '?';
+			}
+
+			const Format& format = m_formats[id];
+			appendFormat( out, "[%14.6f] %-7s ", (double) time / 1e9, levelName( format.level ) );
+			render( out, format.format, args );
+			appendFormat( out, "  (%s:%d)\n", format.file.c_str(), format.line );
+		}
+		else
+		{
+			m_error = "unknown record type";
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+逐个解析printf转换说明，去掉原有的长度修饰并按记录的参数类型重新指定
+*/
+void BinaryLogDecoder::render( std::string& out, const std::string& format, const std::vector<Argument>& args ) const
+{
+	size_t next = 0;
+	size_t i = 0;
+	while( i < format.length() )
+	{
+		char c = format[i];
+		if( c != '%' )
+		{
+			out.push_back( c );
+			++ i;
+			continue;
+		}
+
+		if( i + 1 < format.length() && format[ i + 1 ] == '%' )
+		{
+			out.push_back( '%' );
+			i += 2;
+			continue;
+		}
+
+		std::string spec = "%";
+		++ i;
+		while( i < format.length() && strchr( "-+ #0", format[i] ) )
+			spec.push_back( format[ i ++ ] );
+		while( i < format.length() && ( isdigit( (unsigned char) format[i] ) || format[i] == '.' || format[i] == '*' ) )
+		{
+			// 宽度和精度中的*从参数中取值
+			if( format[i] == '*' )
+			{
+				int value = next < args.size() && ( args[ next ].tag == 'i' || args[ next ].tag == 'u' ) ? (int) args[ next ].i : 0;
+				++ next;
+				spec += std::to_string( value );
+				++ i;
+				continue;
+			}
+			spec.push_back( format[ i ++ ] );
+		}
+		while( i < format.length() && strchr( "hljztLqI", format[i] ) )
+			++ i;
+		if( i >= format.length() )
+			break;
+
+		char conversion = format[ i ++ ];
+		if( next >= args.size() || args[next].tag == '?' )
+		{
+			out += "<?>";
+			++ next;
+			continue;
+		}
+
+		// 参数类型与转换说明不符时（如%d对应字符串）不按错误的类型输出
+		const Argument& arg = args[ next ++ ];
+		bool integer = arg.tag == 'i' || arg.tag == 'u' || arg.tag == 'p';
+		if( conversion != 0 && ( ( strchr( "diuoxXcp", conversion ) && !integer ) || ( strchr( "fFeEgGaA", conversion ) && arg.tag != 'f' ) ) )
+		{
+			out += "<?>";
+			continue;
+		}
+
+		switch( conversion )
+		{
+			case 'd': case 'i':
+				appendFormat( out, ( spec + "lld" ).c_str(), (long long) arg.i );
+				break;
+			case 'u': case 'o': case 'x': case 'X':
+				appendFormat( out, ( spec + "ll" + conversion ).c_str(), (unsigned long long) arg.u );
+				break;
+			case 'c':
+				appendFormat( out, ( spec + "c" ).c_str(), (int) arg.i );
+				break;
+			case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+				appendFormat( out, ( spec + conversion ).c_str(), arg.f );
+				break;
+			case 'p':
+				appendFormat( out, "0x%llx", (unsigned long long) arg.u );
+				break;
+			case 's':
+				if( arg.tag == 's' )
+					appendFormat( out, ( spec + "s" ).c_str(), arg.s.c_str() );
+				else if( arg.tag == 'f' )
+					appendFormat( out, "%g", arg.f );
+				else
+					appendFormat( out, arg.tag == 'i' ? "%lld" : "%llu", arg.i );
+				break;
+			default:
+				out += "<?>";
+				break;
+		}
+	}
+}
+
+NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,76 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __BINARY_LOG_DECODER_H__
+#define __BINARY_LOG_DECODER_H__
+
+#include "magical-macros.h"
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+NAMESPACE_MAGICAL
+
+/*
+离线解码BinaryLog写出的文件，每条记录输出一行：
+相对打开时刻的秒数、级别、按printf语法格式化的内容以及调用处的文件和行号
+
+只依赖标准库，可以脱离引擎单独编译为命令行工具
+*/
+class BinaryLogDecoder
+{
+public:
+	bool decode( const char* data, size_t size, std::string& out );
+	bool decodeFile( const char* file, std::string& out );
+
+public:
+	const std::string& getError( void ) const { return m_error; }
+
+private:
+	struct Format
+	{
+		int level;
+		int line;
+		std::string file;
+		std::string format;
+	};
+
+	struct Argument
+	{
+		uint8_t tag;
+		int64_t i;
+		uint64_t u;
+		double f;
+		std::string s;
+	};
+
+	void render( std::string& out, const std::string& format, const std::vector<Argument>& args ) const;
+
+private:
+	std::vector<Format> m_formats;
+	std::string m_error;
+};
+
+NAMESPACE_END
+
+#endif //__BINARY_LOG_DECODER_H__
\ No newline at end of file
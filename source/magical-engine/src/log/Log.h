@@ -58,13 +58,46 @@ public:
 		Error = 2,
 	};
 
+	/*
+	队列满时的处理方式，Block会等待后台线程腾出空间，
+	Drop直接丢弃，Count丢弃并在日志中记录丢弃的条数
+	*/
+	enum class Overflow : int
+	{
+		Drop,
+		Block,
+		Count,
+	};
+
 public:
 	static void init( void );
 	static void delc( void );
 	
 public:
+	/*
+	日志先写入无锁的多生产者环形队列，由后台线程批量写入文件，调用线程不会等待I/O；
+	后台线程未启动时（init之前和delc之后）直接同步写入
+	*/
 	static void write( Level level, const char* text );
 	static void writeLine( Level level, const char* text );
+	static void flush( void );
+
+public:
+	/*
+	不低于flush level的日志会立即唤醒后台线程并在写入后刷新文件，
+	其余日志最多间隔flush interval（微秒）刷新一次
+	*/
+	static void setFlushLevel( Level level );
+	static void setFlushInterval( int64_t microseconds );
+	static void setOverflow( Overflow overflow );
+	static size_t getDroppedCount( void );
+
+private:
+	static void startWorker( void );
+	static void stopWorker( void );
+	static void workerLoop( void );
+	static void output( Level level, const char* text, size_t length );
+	static void flushOutput( void );
 };
 
 NAMESPACE_END
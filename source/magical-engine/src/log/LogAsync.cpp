@@ -0,0 +1,313 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "Log.h"
+#include "Utils.h"
+#include "LogRing.h"
+#include <string.h>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+NAMESPACE_MAGICAL
+
+struct LogRecordHeader
+{
+	uint16_t level;
+	uint16_t newline;
+};
+
+enum : size_t
+{
+	RingSlotSize = 256,
+	RingSlotCount = 4096,
+};
+
+static LogRing<RingSlotSize, RingSlotCount> _ring;
+static std::atomic<size_t> _dropped( 0 );
+static std::atomic<int> _flush_level( Log::Error );
+static std::atomic<int64_t> _flush_interval( 100000 );
+static std::atomic<int> _overflow( (int) Log::Overflow::Count );
+
+static std::thread _worker;
+static std::mutex _mutex;
+static std::condition_variable _wakeup;
+static std::condition_variable _flushed;
+static std::atomic<bool> _running( false );
+static std::atomic<bool> _sleeping( false );
+// 已看到_running为true、还没有写完的生产者数量
+static std::atomic<int> _producers( 0 );
+static bool _stopping = false;
+static uint64_t _flush_requested = 0;
+static uint64_t _flush_completed = 0;
+
+// 后台线程未启动时多个线程同步写入需要互斥，stopWorker写出队列中剩余的日志时也持有
+static std::mutex _sync_mutex;
+
+static void wakeWorker( void )
+{
+	std::lock_guard<std::mutex> lock( _mutex );
+	_wakeup.notify_one();
+}
+
+/*
+返回false表示后台线程没有运行（或正在停止且队列已满），调用者改为同步写入
+先登记为生产者再检查_running，stopWorker切换为同步写入后会等待登记的生产者全部写完，
+它们写入队列的日志由stopWorker写出，不会丢失
+*/
+static bool enqueue( Log::Level level, const char* text, size_t length, bool newline )
+{
+	_producers.fetch_add( 1 );
+	if( !_running.load() )
+	{
+		_producers.fetch_sub( 1 );
+		return false;
+	}
+
+	size_t max_length = _ring.maxRecordSize() - sizeof( LogRecordHeader );
+	if( length > max_length )
+		length = max_length;
+
+	LogRecordHeader header;
+	header.level = (uint16_t) level;
+	header.newline = newline ? 1 : 0;
+
+	while( !_ring.push( &header, sizeof( header ), text, length ) )
+	{
+		if( _overflow.load( std::memory_order_relaxed ) != (int) Log::Overflow::Block )
+		{
+			_dropped.fetch_add( 1, std::memory_order_relaxed );
+			_producers.fetch_sub( 1 );
+			return true;
+		}
+
+		if( !_running.load() )
+		{
+			_producers.fetch_sub( 1 );
+			return false;
+		}
+
+		if( _sleeping.load() )
+			wakeWorker();
+		std::this_thread::yield();
+	}
+
+	// 只有在需要及时写入或队列过半时才唤醒休眠的后台线程，其余情况等待定时批量写入
+	if( _sleeping.load() )
+	{
+		if( (int) level >= _flush_level.load( std::memory_order_relaxed ) || _ring.used() >= RingSlotCount / 2 )
+			wakeWorker();
+	}
+	_producers.fetch_sub( 1 );
+	return true;
+}
+
+void Log::write( Level level, const char* text )
+{
+	if( !text || *text == 0 )
+		return;
+
+	size_t length = strlen( text );
+	if( enqueue( level, text, length, false ) )
+		return;
+
+	std::lock_guard<std::mutex> lock( _sync_mutex );
+	output( level, text, length );
+	flushOutput();
+}
+
+void Log::writeLine( Level level, const char* text )
+{
+	if( !text ) return;
+
+	size_t length = strlen( text );
+	if( enqueue( level, text, length, true ) )
+		return;
+
+	std::lock_guard<std::mutex> lock( _sync_mutex );
+	output( level, text, length );
+	output( level, "\n", 1 );
+	flushOutput();
+}
+
+/*
+阻塞直到调用之前写入的日志全部写入文件并刷新
+*/
+void Log::flush( void )
+{
+	if( !_running.load() || std::this_thread::get_id() == _worker.get_id() )
+		return;
+
+	std::unique_lock<std::mutex> lock( _mutex );
+	uint64_t ticket = ++ _flush_requested;
+	_wakeup.notify_one();
+	_flushed.wait( lock, [ticket]{ return _flush_completed >= ticket || _stopping; } );
+}
+
+void Log::setFlushLevel( Level level )
+{
+	_flush_level.store( level );
+}
+
+void Log::setFlushInterval( int64_t microseconds )
+{
+	_flush_interval.store( microseconds );
+}
+
+void Log::setOverflow( Overflow overflow )
+{
+	_overflow.store( (int) overflow );
+}
+
+size_t Log::getDroppedCount( void )
+{
+	return _dropped.load();
+}
+
+void Log::workerLoop( void )
+{
+	string record;
+	LogRecordHeader header;
+	size_t reported = 0;
+	int64_t last_flush = Time::currentMicroseconds();
+
+	while( true )
+	{
+		uint64_t requested;
+		bool flush_requested;
+		bool stopping;
+		{
+			std::lock_guard<std::mutex> lock( _mutex );
+			requested = _flush_requested;
+			flush_requested = _flush_requested > _flush_completed;
+			stopping = _stopping;
+		}
+
+		bool urgent = false;
+		bool written = false;
+		while( _ring.pop( record ) )
+		{
+			memcpy( &header, record.data(), sizeof( header ) );
+			Level level = (Level) header.level;
+			output( level, record.data() + sizeof( header ), record.length() - sizeof( header ) );
+			if( header.newline )
+				output( level, "\n", 1 );
+
+			written = true;
+			if( (int) level >= _flush_level.load( std::memory_order_relaxed ) )
+				urgent = true;
+		}
+
+		if( _overflow.load( std::memory_order_relaxed ) == (int) Overflow::Count )
+		{
+			size_t dropped = _dropped.load( std::memory_order_relaxed );
+			if( dropped != reported )
+			{
+				string notice = System::format( "[WARNING]: %u log messages dropped, log queue is full.\n", (unsigned int)( dropped - reported ) );
+				output( Warning, notice.c_str(), notice.length() );
+				reported = dropped;
+				written = true;
+			}
+		}
+
+		int64_t now = Time::currentMicroseconds();
+		if( urgent || flush_requested || stopping || ( written && now - last_flush >= _flush_interval.load( std::memory_order_relaxed ) ) )
+		{
+			flushOutput();
+			last_flush = now;
+		}
+
+		std::unique_lock<std::mutex> lock( _mutex );
+		if( requested > _flush_completed )
+		{
+			_flush_completed = requested;
+			_flushed.notify_all();
+		}
+
+		if( stopping && _ring.empty() )
+			return;
+
+		if( _flush_requested != requested || _stopping || !_ring.empty() )
+			continue;
+
+		// 先标记休眠再检查队列，生产者看到标记时会唤醒，即使错过通知也最多等待一个刷新间隔
+		_sleeping.store( true );
+		if( _ring.empty() )
+			_wakeup.wait_for( lock, std::chrono::microseconds( _flush_interval.load( std::memory_order_relaxed ) ) );
+		_sleeping.store( false );
+	}
+}
+
+void Log::startWorker( void )
+{
+	if( _running.load() )
+		return;
+
+	_ring.reset();
+	_stopping = false;
+	_flush_requested = 0;
+	_flush_completed = 0;
+	_worker = std::thread( &Log::workerLoop );
+	_running.store( true );
+}
+
+/*
+写完队列中剩余的日志后退出后台线程，之后的日志恢复同步写入
+*/
+void Log::stopWorker( void )
+{
+	if( !_running.load() )
+		return;
+
+	// 停止期间同步写入的日志等待队列中的日志写完，不会与之交错
+	std::lock_guard<std::mutex> sync_lock( _sync_mutex );
+
+	_running.store( false );
+	{
+		std::lock_guard<std::mutex> lock( _mutex );
+		_stopping = true;
+		_wakeup.notify_one();
+		_flushed.notify_all();
+	}
+	_worker.join();
+
+	// 切换之前已经开始写入的生产者可能在后台线程退出后才写入队列，等它们写完后由这里写出
+	while( _producers.load() != 0 )
+	{
+		std::this_thread::yield();
+	}
+
+	string record;
+	LogRecordHeader header;
+	while( _ring.pop( record ) )
+	{
+		memcpy( &header, record.data(), sizeof( header ) );
+		output( (Level) header.level, record.data() + sizeof( header ), record.length() - sizeof( header ) );
+		if( header.newline )
+			output( (Level) header.level, "\n", 1 );
+	}
+	flushOutput();
+}
+
+NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,206 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __LOG_RING_H__
+#define __LOG_RING_H__
+
+#include "magical-macros.h"
+#include "Common.h"
+#include <string.h>
+#include <atomic>
+
+NAMESPACE_MAGICAL
+
+/*
+无锁的多生产者单消费者环形队列，保存变长的二进制记录
+
+队列由定长的槽组成，每个槽的sequence等于位置p表示可以写入位置p的数据，
+等于p + 1表示位置p的数据已写好，消费后置为p + SlotCount留给下一圈；
+一条记录占用若干连续的位置，前4个字节为记录长度，跨槽时分段拷贝
+*/
+template< size_t SlotSize, size_t SlotCount >
+class LogRing
+{
+public:
+	enum : size_t
+	{
+		SlotMask = SlotCount - 1,
+		PayloadSize = SlotSize - sizeof( std::atomic<size_t> ),
+		// 单条记录最多占用队列的四分之一
+		MaxSlotsPerRecord = SlotCount / 4,
+	};
+
+public:
+	LogRing( void )
+	{
+		static_assert( ( SlotCount & SlotMask ) == 0, "SlotCount must be power of 2" );
+		reset();
+	}
+
+	/*
+	只能在没有生产者和消费者时调用
+	*/
+	void reset( void )
+	{
+		for( size_t i = 0; i < SlotCount; ++i )
+		{
+			m_slots[i].sequence.store( i, std::memory_order_relaxed );
+		}
+		m_enqueue_pos.store( 0, std::memory_order_relaxed );
+		m_dequeue_pos.store( 0, std::memory_order_relaxed );
+	}
+
+	static size_t maxRecordSize( void )
+	{
+		return MaxSlotsPerRecord * PayloadSize - sizeof( uint32_t );
+	}
+
+	/*
+	写入由head和body两段拼成的一条记录，队列已满时返回false
+	生产者一次CAS预留连续的多个位置，只需检查最后一个位置：
+	消费者按顺序释放，最后一个位置可写时之前的位置必然也已可写
+	*/
+	bool push( const void* head, size_t head_size, const void* body, size_t body_size )
+	{
+		uint32_t size = (uint32_t)( head_size + body_size );
+		MAGICAL_ASSERT( size <= maxRecordSize(), "Invalid, record is too large!" );
+
+		size_t count = ( sizeof( size ) + size + PayloadSize - 1 ) / PayloadSize;
+		size_t pos = m_enqueue_pos.load( std::memory_order_relaxed );
+
+		while( true )
+		{
+			size_t last = pos + count - 1;
+			size_t sequence = m_slots[ last & SlotMask ].sequence.load( std::memory_order_acquire );
+			intptr_t diff = (intptr_t) sequence - (intptr_t) last;
+			if( diff == 0 )
+			{
+				if( m_enqueue_pos.compare_exchange_weak( pos, pos + count, std::memory_order_relaxed ) )
+					break;
+			}
+			else if( diff < 0 )
+			{
+				return false;
+			}
+			else
+			{
+				pos = m_enqueue_pos.load( std::memory_order_relaxed );
+			}
+		}
+
+		copyTo( pos, 0, &size, sizeof( size ) );
+		copyTo( pos, sizeof( size ), head, head_size );
+		copyTo( pos, sizeof( size ) + head_size, body, body_size );
+
+		// 倒序发布，消费者看到第一个槽就绪时其余槽一定已就绪
+		for( size_t i = count; i > 0; --i )
+		{
+			m_slots[ ( pos + i - 1 ) & SlotMask ].sequence.store( pos + i, std::memory_order_release );
+		}
+		return true;
+	}
+
+	/*
+	取出一条记录，只能由唯一的消费者线程调用
+	*/
+	bool pop( string& record )
+	{
+		size_t pos = m_dequeue_pos.load( std::memory_order_relaxed );
+		if( m_slots[ pos & SlotMask ].sequence.load( std::memory_order_acquire ) != pos + 1 )
+			return false;
+
+		uint32_t size;
+		copyFrom( &size, pos, 0, sizeof( size ) );
+		record.resize( size );
+		if( size > 0 )
+			copyFrom( &record[0], pos, sizeof( size ), size );
+
+		size_t count = ( sizeof( size ) + size + PayloadSize - 1 ) / PayloadSize;
+		for( size_t i = 0; i < count; ++i )
+		{
+			m_slots[ ( pos + i ) & SlotMask ].sequence.store( pos + i + SlotCount, std::memory_order_release );
+		}
+		m_dequeue_pos.store( pos + count, std::memory_order_relaxed );
+		return true;
+	}
+
+	bool empty( void ) const
+	{
+		size_t pos = m_dequeue_pos.load( std::memory_order_relaxed );
+		return m_slots[ pos & SlotMask ].sequence.load( std::memory_order_acquire ) != pos + 1;
+	}
+
+	/*
+	已占用的槽数，只是近似值，用于决定是否唤醒消费者
+	*/
+	size_t used( void ) const
+	{
+		return m_enqueue_pos.load( std::memory_order_relaxed ) - m_dequeue_pos.load( std::memory_order_relaxed );
+	}
+
+private:
+	struct Slot
+	{
+		std::atomic<size_t> sequence;
+		char data[ PayloadSize ];
+	};
+
+	void copyTo( size_t pos, size_t offset, const void* src, size_t size )
+	{
+		const char* bytes = (const char*) src;
+		while( size > 0 )
+		{
+			Slot& slot = m_slots[ ( pos + offset / PayloadSize ) & SlotMask ];
+			size_t begin = offset % PayloadSize;
+			size_t count = size < PayloadSize - begin ? size : PayloadSize - begin;
+			memcpy( slot.data + begin, bytes, count );
+			bytes += count;
+			offset += count;
+			size -= count;
+		}
+	}
+
+	void copyFrom( void* dst, size_t pos, size_t offset, size_t size ) const
+	{
+		char* bytes = (char*) dst;
+		while( size > 0 )
+		{
+			const Slot& slot = m_slots[ ( pos + offset / PayloadSize ) & SlotMask ];
+			size_t begin = offset % PayloadSize;
+			size_t count = size < PayloadSize - begin ? size : PayloadSize - begin;
+			memcpy( bytes, slot.data + begin, count );
+			bytes += count;
+			offset += count;
+			size -= count;
+		}
+	}
+
+private:
+	Slot m_slots[ SlotCount ];
+	std::atomic<size_t> m_enqueue_pos;
+	std::atomic<size_t> m_dequeue_pos;
+};
+
+NAMESPACE_END
+
+#endif //__LOG_RING_H__
\ No newline at end of file
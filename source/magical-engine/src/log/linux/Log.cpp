@@ -0,0 +1,136 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "Log.h"
+#include "Utils.h"
+#include <unistd.h>
+
+NAMESPACE_MAGICAL
+
+static FILE* _dfile = nullptr;
+static FILE* _wfile = nullptr;
+static FILE* _efile = nullptr;
+
+/*
+日志文件放在可执行文件所在的目录，取不到时使用当前工作目录
+*/
+static string getLogDirectory( void )
+{
+	char buff[ 2048 ] = { 0 };
+	ssize_t length = readlink( "/proc/self/exe", buff, sizeof( buff ) - 1 );
+	if( length <= 0 )
+	{
+		if( getcwd( buff, sizeof( buff ) ) == nullptr )
+			return "";
+		return string( buff ) + "/";
+	}
+
+	string dir( buff, length );
+	return dir.substr( 0, dir.find_last_of( "/" ) + 1 );
+}
+
+void Log::init( void )
+{
+	string dir, name;
+	dir = getLogDirectory();
+
+	name = dir + MAGICAL_LOG_DEBUG_FILE;
+	_dfile = fopen( name.c_str(), "w" );
+	if( _dfile == nullptr )
+	{
+		MAGICAL_SET_LAST_ERROR( System::format( "open file(%s) failed!", MAGICAL_LOG_DEBUG_FILE ).c_str() );
+		MAGICAL_LOG_LAST_ERROR();
+		return;
+	}
+
+	name = dir + MAGICAL_LOG_WARNING_FILE;
+	_wfile = fopen( name.c_str(), "w" );
+	if( _wfile == nullptr )
+	{
+		MAGICAL_SET_LAST_ERROR( System::format( "open file(%s) failed!", MAGICAL_LOG_WARNING_FILE ).c_str() );
+		MAGICAL_LOG_LAST_ERROR();
+		return;
+	}
+
+	name = dir + MAGICAL_LOG_ERROR_FILE;
+	_efile = fopen( name.c_str(), "w" );
+	if( _efile == nullptr )
+	{
+		MAGICAL_SET_LAST_ERROR( System::format( "open file(%s) failed!", MAGICAL_LOG_ERROR_FILE ).c_str() );
+		MAGICAL_LOG_LAST_ERROR();
+		return;
+	}
+
+	Log::startWorker();
+}
+
+void Log::delc( void )
+{
+	Log::stopWorker();
+
+	if( _dfile ) fclose( _dfile );
+	if( _wfile ) fclose( _wfile );
+	if( _efile ) fclose( _efile );
+	_dfile = nullptr;
+	_wfile = nullptr;
+	_efile = nullptr;
+}
+
+/*
+由后台线程（或未启动后台线程时由调用线程）执行，终端本身就是utf8，调试输出不需要转换编码
+*/
+void Log::output( Level level, const char* text, size_t length )
+{
+#ifdef MAGICAL_DEBUG
+	fwrite( text, 1, length, level == Debug ? stdout : stderr );
+#endif
+
+	FILE* file = nullptr;
+	switch( level )
+	{
+		case Debug:
+			file = _dfile;
+			break;
+		case Warning:
+			file = _wfile;
+			break;
+		case Error:
+			file = _efile;
+			break;
+		default:
+			MAGICAL_ASSERT( false, "Invalid!" );
+			break;
+	}
+
+	if( file )
+		fwrite( text, 1, length, file );
+}
+
+void Log::flushOutput( void )
+{
+	if( _dfile ) fflush( _dfile );
+	if( _wfile ) fflush( _wfile );
+	if( _efile ) fflush( _efile );
+}
+
+NAMESPACE_END
\ No newline at end of file
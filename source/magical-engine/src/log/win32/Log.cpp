@@ -27,7 +27,6 @@ SOFTWARE.
 
 NAMESPACE_MAGICAL
 
-static char _buffer[ MAGICAL_LOG_MAX_LENGTH ];
 static FILE* _dfile = nullptr;
 static FILE* _wfile = nullptr;
 static FILE* _efile = nullptr;
@@ -67,79 +66,61 @@ void Log::init( void )
 		MAGICAL_LOG_LAST_ERROR();
 		return;
 	}
+
+	Log::startWorker();
 }
 
 void Log::delc( void )
 {
-	fclose( _dfile );
-	fclose( _wfile );
-	fclose( _efile );
+	Log::stopWorker();
+
+	if( _dfile ) fclose( _dfile );
+	if( _wfile ) fclose( _wfile );
+	if( _efile ) fclose( _efile );
+	_dfile = nullptr;
+	_wfile = nullptr;
+	_efile = nullptr;
 }
 
-void Log::write( Level level, const char* text )
+/*
+由后台线程（或未启动后台线程时由调用线程）执行，调试输出的编码转换也在这里完成
+*/
+void Log::output( Level level, const char* text, size_t length )
 {
-	if( !text || *text == 0 ) 
-		return;
-
 #ifdef MAGICAL_DEBUG
-	wstring wtext = System::utf8ToUnicode( text );
+	wstring wtext = System::utf8ToUnicode( string( text, length ) );
 	string asnitext = System::unicodeToAnsi( wtext );
 
 	OutputDebugStringW( wtext.c_str() );
-	printf( "%s", asnitext.c_str() );
+	fwrite( asnitext.c_str(), 1, asnitext.length(), stdout );
 #endif
 
+	FILE* file = nullptr;
 	switch( level )
 	{
 		case Debug:
-			fprintf( _dfile, "%s", text );
-			fflush( _dfile );
+			file = _dfile;
 			break;
 		case Warning:
-			fprintf( _wfile, "%s", text );
-			fflush( _wfile );
+			file = _wfile;
 			break;
 		case Error:
-			fprintf( _efile, "%s", text );
-			fflush( _efile );
+			file = _efile;
 			break;
 		default:
 			MAGICAL_ASSERT( false, "Invalid!" );
 			break;
 	}
+
+	if( file )
+		fwrite( text, 1, length, file );
 }
 
-void Log::writeLine( Level level, const char* text )
+void Log::flushOutput( void )
 {
-	if( !text ) return;
-
-#ifdef MAGICAL_DEBUG
-	wstring wtext = System::utf8ToUnicode( text );
-	string asnitext = System::unicodeToAnsi( wtext );
-
-	OutputDebugStringW( wtext.c_str() );
-	OutputDebugStringW( L"\n" );
-	printf( "%s\n", asnitext.c_str() );
-#endif
-
-	switch( level )
-	{
-		case Debug:
-			fprintf( _dfile, "%s\n", text );
-			fflush( _dfile );
-			break;
-		case Warning:
-			fprintf( _wfile, "%s\n", text );
-			fflush( _wfile );
-			break;
-		case Error:
-			fprintf( _efile, "%s\n", text );
-			fflush( _efile );
-			break;
-		default:
-			MAGICAL_ASSERT( false, "Invalid!" );
-			break;
-	}
+	if( _dfile ) fflush( _dfile );
+	if( _wfile ) fflush( _wfile );
+	if( _efile ) fflush( _efile );
 }
 
 NAMESPACE_END
\ No newline at end of file
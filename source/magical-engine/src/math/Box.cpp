@@ -213,8 +213,8 @@ void Box::transform( Box& out, const Box& box, const Matrix4x4& m )
 	Vector3::mul4x4( right_top_back, right_top_back, m );
 	Vector3::mul4x4( right_bottom_back, right_bottom_back, m );
 
-	out.set( Box::Invalid );
-	out.expandBy( left_top_front );
+	// 不依赖Box::Invalid，它与Vector3::One在不同的编译单元中，静态初始化顺序不确定
+	out.set( left_top_front, left_top_front );
 	out.expandBy( left_bottom_front );
 	out.expandBy( right_top_front );
 	out.expandBy( right_bottom_front );
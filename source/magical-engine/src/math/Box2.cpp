@@ -27,6 +27,7 @@ NAMESPACE_MAGICAL
 
 struct Vector2;
 struct Box2;
+struct Circle;
 
 NAMESPACE_END
 
@@ -34,7 +35,9 @@ NAMESPACE_END
 #include "Vector2.inl"
 
 #include "Box2.h"
+#include "Circle.h"
 #include "Box2.inl"
+#include "Circle.inl"
 
 NAMESPACE_MAGICAL
 
@@ -146,6 +149,11 @@ bool Box2::intersects( const Box2& box ) const
 	return true;
 }
 
+bool Box2::intersects( const Circle& circle ) const
+{
+	return Vector2::distanceSq( closest( circle.center ), circle.center ) <= ( circle.r * circle.r );
+}
+
 bool Box2::containsPoint( const Vector2& point ) const
 {
 	return 
@@ -80,6 +80,7 @@ public:
 
 public:
 	bool intersects( const Box2& box ) const;
+	bool intersects( const Circle& circle ) const;
 	bool containsPoint( const Vector2& point ) const;
 };
 
@@ -26,6 +26,7 @@ SOFTWARE.
 NAMESPACE_MAGICAL
 
 struct Vector2;
+struct Box2;
 struct Circle;
 
 NAMESPACE_END
@@ -33,7 +34,9 @@ NAMESPACE_END
 #include "Vector2.h"
 #include "Vector2.inl"
 
+#include "Box2.h"
 #include "Circle.h"
+#include "Box2.inl"
 #include "Circle.inl"
 
 NAMESPACE_MAGICAL
@@ -37,7 +37,7 @@ struct Circle
 			float y;
 			float r;
 		};
-		struct { Vector2 center; float r; };
+		Vector2 center;
 	};
 
 public:
@@ -73,6 +73,8 @@ public:
 	inline Vector2 closest( const Vector2& v );
 
 public:
+	inline bool intersects( const Circle& circle ) const;
+	inline bool intersects( const Box2& box ) const;
 	inline bool containsPoint( const Vector2& point ) const;
 };
 
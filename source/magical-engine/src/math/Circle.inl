@@ -30,13 +30,13 @@ inline Circle::Circle( float x, float y, float r )
 }
 
 inline Circle::Circle( const Vector2& center, float r ) 
-: center( center ), r( r )
+: x( center.x ), y( center.y ), r( r )
 {
 	
 }
 
 inline Circle::Circle( const Circle& circle ) 
-: x( circle.x ), y( circle.y ), r( r )
+: x( circle.x ), y( circle.y ), r( circle.r )
 {
 	
 }
@@ -126,6 +126,16 @@ inline Vector2 Circle::closest( const Vector2& v )
 	return dst;
 }
 
+inline bool Circle::intersects( const Circle& circle ) const
+{
+	return Vector2::distanceSq( center, circle.center ) <= ( r + circle.r ) * ( r + circle.r );
+}
+
+inline bool Circle::intersects( const Box2& box ) const
+{
+	return box.intersects( *this );
+}
+
 inline bool Circle::containsPoint( const Vector2& point ) const
 {
 	float dx = point.x - x;
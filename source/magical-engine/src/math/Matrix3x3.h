@@ -39,11 +39,6 @@ struct Matrix3x3
 			float m21; float m22; float m23;
 			float m31; float m32; float m33;
 		};
-		struct {
-			Vector3 m11m12m13;
-			Vector3 m21m22m23;
-			Vector3 m31m32m33;
-		};
 	};
 
 public:
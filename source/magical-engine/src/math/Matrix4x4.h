@@ -40,18 +40,6 @@ struct Matrix4x4
 			float m31; float m32; float m33; float m34;
 			float m41; float m42; float m43; float m44;
 		};
-		struct {
-			Vector4 m11m12m13m14;
-			Vector4 m21m22m23m24;
-			Vector4 m31m32m33m34;
-			Vector4 m41m42m43m44;
-		};
-		struct {
-			Vector3 m11m12m13; float m14;
-			Vector3 m21m22m23; float m24;
-			Vector3 m31m32m33; float m34;
-			Vector3 m41m42m43; float m44;
-		};
 	};
 
 public:
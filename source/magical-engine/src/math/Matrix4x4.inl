@@ -88,6 +88,7 @@ inline Matrix4x4& Matrix4x4::operator=( float m )
 	m21 = 0.0f; m22 =    m; m23 = 0.0f; m24 = 0.0f;
 	m31 = 0.0f; m32 = 0.0f; m33 =    m; m34 = 0.0f;
 	m41 = 0.0f; m42 = 0.0f; m43 = 0.0f; m44 =    m;
+	return *this;
 }
 
 inline Matrix4x4& Matrix4x4::operator=( const Matrix4x4& m )
@@ -333,70 +334,70 @@ inline void Matrix4x4::set( float m )
 	m41 = 0.0f; m42 = 0.0f; m43 = 0.0f; m44 =    m;
 }
 
-inline Matrix4x4 createLookAt( const Vector3& eye, const Vector3& target, const Vector3& up )
+inline Matrix4x4 Matrix4x4::createLookAt( const Vector3& eye, const Vector3& target, const Vector3& up )
 {
 	Matrix4x4 dst;
 	dst.setLookAt( eye, target, up );
 	return dst;
 }
 
-inline Matrix4x4 createPerspective( float fov, float aspect, float znear, float zfar )
+inline Matrix4x4 Matrix4x4::createPerspective( float fov, float aspect, float znear, float zfar )
 {
 	Matrix4x4 dst;
 	dst.setPerspective( fov, aspect, znear, zfar );
 	return dst;
 }
 
-inline Matrix4x4 createOrtho( float left, float right, float bottom, float top, float znear, float zfar )
+inline Matrix4x4 Matrix4x4::createOrtho( float left, float right, float bottom, float top, float znear, float zfar )
 {
 	Matrix4x4 dst;
 	dst.setOrtho( left, right, bottom, top, znear, zfar );
 	return dst;
 }
 
-inline Matrix4x4 createTrs( const Vector3& t, const Quaternion& r, const Vector3& s )
+inline Matrix4x4 Matrix4x4::createTrs( const Vector3& t, const Quaternion& r, const Vector3& s )
 {
 	Matrix4x4 dst;
 	dst.setTrs( t, r, s );
 	return dst;
 }
 
-inline Matrix4x4 createTranslation( const Vector3& t )
+inline Matrix4x4 Matrix4x4::createTranslation( const Vector3& t )
 {
 	Matrix4x4 dst;
 	dst.setTranslation( t );
 	return dst;
 }
 
-inline Matrix4x4 createScale( const Vector3& s )
+inline Matrix4x4 Matrix4x4::createScale( const Vector3& s )
 {
 	Matrix4x4 dst;
 	dst.setScale( s );
 	return dst;
 }
 
-inline Matrix4x4 createRotation( const Quaternion& q )
+inline Matrix4x4 Matrix4x4::createRotation( const Quaternion& q )
 {
 	Matrix4x4 dst;
 	dst.setRotation( q );
 	return dst;
 }
 
-inline Matrix4x4 createRotationX( float a )
+inline Matrix4x4 Matrix4x4::createRotationX( float a )
 {
 	Matrix4x4 dst;
 	dst.setRotationX( a );
 	return dst;
 }
 
-inline Matrix4x4 createRotationY( float a )
+inline Matrix4x4 Matrix4x4::createRotationY( float a )
 {
 	Matrix4x4 dst;
 	dst.setRotationY( a );
 	return dst;
 }
 
-inline Matrix4x4 createRotationZ( float a )
+inline Matrix4x4 Matrix4x4::createRotationZ( float a )
 {
 	Matrix4x4 dst;
 	dst.setRotationZ( a );
@@ -21,3 +21,207 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 *******************************************************************************/
+#include "MathUtils.h"
+
+NAMESPACE_MAGICAL
+
+struct Vector2;
+struct Vector3;
+struct Vector4;
+struct Rotater;
+struct Quaternion;
+struct Matrix3x3;
+struct Matrix4x4;
+
+struct Ray;
+struct Box;
+struct OrientBox;
+struct Plane;
+struct Sphere;
+
+NAMESPACE_END
+
+#include "Vector2.h"
+#include "Vector3.h"
+#include "Vector4.h"
+#include "Rotater.h"
+#include "Quaternion.h"
+#include "Matrix3x3.h"
+#include "Matrix4x4.h"
+
+#include "Vector2.inl"
+#include "Vector3.inl"
+#include "Vector4.inl"
+#include "Rotater.inl"
+#include "Quaternion.inl"
+#include "Matrix3x3.inl"
+#include "Matrix4x4.inl"
+
+#include "Ray.h"
+#include "Box.h"
+#include "OrientBox.h"
+#include "Plane.h"
+#include "Sphere.h"
+
+#include "Ray.inl"
+#include "Box.inl"
+#include "OrientBox.inl"
+#include "Plane.inl"
+#include "Sphere.inl"
+
+NAMESPACE_MAGICAL
+
+const OrientBox OrientBox::Invalid = OrientBox( Vector3::Zero, -Vector3::One, Quaternion::Identity );
+
+bool OrientBox::equals( const OrientBox& box ) const
+{
+	return
+		center.equals( box.center ) &&
+		axis_x.equals( box.axis_x ) &&
+		axis_y.equals( box.axis_y ) &&
+		axis_z.equals( box.axis_z ) &&
+		extents.equals( box.extents );
+}
+
+void OrientBox::set( const Vector3& center, const Vector3& extents, const Quaternion& rotation )
+{
+	this->center = center;
+	this->extents = extents;
+	axis_x = rotation * Vector3::UnitX;
+	axis_y = rotation * Vector3::UnitY;
+	axis_z = rotation * Vector3::UnitZ;
+}
+
+void OrientBox::set( const Box& box )
+{
+	center = box.center();
+	extents.x = box.width() * 0.5f;
+	extents.y = box.height() * 0.5f;
+	extents.z = box.depth() * 0.5f;
+	axis_x = Vector3::UnitX;
+	axis_y = Vector3::UnitY;
+	axis_z = Vector3::UnitZ;
+}
+
+/*
+顶点i的第0、1、2位分别表示沿x、y、z轴取正方向
+*/
+void OrientBox::getVertices( Vector3* out ) const
+{
+	Vector3 ex = axis_x * extents.x;
+	Vector3 ey = axis_y * extents.y;
+	Vector3 ez = axis_z * extents.z;
+
+	for( int i = 0; i < 8; ++i )
+	{
+		out[i] = center;
+		out[i] += ( i & 1 ) ? ex : -ex;
+		out[i] += ( i & 2 ) ? ey : -ey;
+		out[i] += ( i & 4 ) ? ez : -ez;
+	}
+}
+
+void OrientBox::getBounds( Box& out ) const
+{
+	Vector3 h(
+		projectRadius( Vector3::UnitX ),
+		projectRadius( Vector3::UnitY ),
+		projectRadius( Vector3::UnitZ ) );
+
+	out.min = center - h;
+	out.max = center + h;
+}
+
+void OrientBox::closest( Vector3& out, const OrientBox& box, const Vector3& v )
+{
+	Vector3 d = v - box.center;
+	float dx = Math::max( -box.extents.x, Math::min( box.extents.x, Vector3::dot( d, box.axis_x ) ) );
+	float dy = Math::max( -box.extents.y, Math::min( box.extents.y, Vector3::dot( d, box.axis_y ) ) );
+	float dz = Math::max( -box.extents.z, Math::min( box.extents.z, Vector3::dot( d, box.axis_z ) ) );
+
+	out = box.center + box.axis_x * dx + box.axis_y * dy + box.axis_z * dz;
+}
+
+/*
+分离轴测试，依次检查两个盒子的各3条面法线以及9条边方向的叉积，
+叉积轴的投影半径直接由两盒子轴间的旋转矩阵求得，
+旋转矩阵各元素加上一个小量以避免边平行时叉积退化导致误判
+*/
+bool OrientBox::intersects( const OrientBox& box ) const
+{
+	const Vector3* a[3] = { &axis_x, &axis_y, &axis_z };
+	const Vector3* b[3] = { &box.axis_x, &box.axis_y, &box.axis_z };
+	const float ea[3] = { extents.x, extents.y, extents.z };
+	const float eb[3] = { box.extents.x, box.extents.y, box.extents.z };
+
+	float r[3][3], abs_r[3][3];
+	for( int i = 0; i < 3; ++i )
+	{
+		for( int j = 0; j < 3; ++j )
+		{
+			r[i][j] = Vector3::dot( *a[i], *b[j] );
+			abs_r[i][j] = ::fabsf( r[i][j] ) + Math::VectorEpsilon;
+		}
+	}
+
+	Vector3 d = box.center - center;
+	float t[3] = { Vector3::dot( d, axis_x ), Vector3::dot( d, axis_y ), Vector3::dot( d, axis_z ) };
+	float ra, rb;
+
+	for( int i = 0; i < 3; ++i )
+	{
+		ra = ea[i];
+		rb = eb[0] * abs_r[i][0] + eb[1] * abs_r[i][1] + eb[2] * abs_r[i][2];
+		if( ::fabsf( t[i] ) > ra + rb )
+			return false;
+	}
+
+	for( int j = 0; j < 3; ++j )
+	{
+		ra = ea[0] * abs_r[0][j] + ea[1] * abs_r[1][j] + ea[2] * abs_r[2][j];
+		rb = eb[j];
+		if( ::fabsf( t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j] ) > ra + rb )
+			return false;
+	}
+
+	for( int i = 0; i < 3; ++i )
+	{
+		int i1 = ( i + 1 ) % 3;
+		int i2 = ( i + 2 ) % 3;
+
+		for( int j = 0; j < 3; ++j )
+		{
+			int j1 = ( j + 1 ) % 3;
+			int j2 = ( j + 2 ) % 3;
+
+			ra = ea[ i1 ] * abs_r[ i2 ][j] + ea[ i2 ] * abs_r[ i1 ][j];
+			rb = eb[ j1 ] * abs_r[i][ j2 ] + eb[ j2 ] * abs_r[i][ j1 ];
+			if( ::fabsf( t[ i2 ] * r[ i1 ][j] - t[ i1 ] * r[ i2 ][j] ) > ra + rb )
+				return false;
+		}
+	}
+
+	return true;
+}
+
+bool OrientBox::intersects( const Box& box ) const
+{
+	return intersects( OrientBox( box ) );
+}
+
+bool OrientBox::intersects( const Sphere& sphere ) const
+{
+	return Vector3::distanceSq( closest( sphere.center ), sphere.center ) <= sphere.r * sphere.r;
+}
+
+bool OrientBox::containsPoint( const Vector3& point ) const
+{
+	Vector3 d = point - center;
+
+	return
+		::fabsf( Vector3::dot( d, axis_x ) ) <= extents.x &&
+		::fabsf( Vector3::dot( d, axis_y ) ) <= extents.y &&
+		::fabsf( Vector3::dot( d, axis_z ) ) <= extents.z;
+}
+
+NAMESPACE_END
\ No newline at end of file
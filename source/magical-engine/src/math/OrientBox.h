@@ -21,3 +21,59 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 *******************************************************************************/
+#ifndef __ORIENT_BOX_H__
+#define __ORIENT_BOX_H__
+
+#include "magical-macros.h"
+
+NAMESPACE_MAGICAL
+
+/*
+三维有向包围盒，axis_x、axis_y、axis_z为单位正交轴，extents为沿三轴的半长
+*/
+struct OrientBox
+{
+	Vector3 center;
+	Vector3 axis_x;
+	Vector3 axis_y;
+	Vector3 axis_z;
+	Vector3 extents;
+
+public:
+	static const OrientBox Invalid;
+
+public:
+	inline OrientBox( const Vector3& center, const Vector3& extents, const Quaternion& rotation );
+	inline explicit OrientBox( const Box& box );
+	inline OrientBox( const OrientBox& box );
+	inline OrientBox( void );
+
+public:
+	inline bool operator==( const OrientBox& box ) const;
+	inline bool operator!=( const OrientBox& box ) const;
+	inline OrientBox& operator=( const OrientBox& box );
+
+public:
+	bool equals( const OrientBox& box ) const;
+	inline bool isValid( void ) const;
+	void set( const Vector3& center, const Vector3& extents, const Quaternion& rotation );
+	void set( const Box& box );
+	inline void set( const OrientBox& box );
+	void getVertices( Vector3* out ) const;
+	void getBounds( Box& out ) const;
+	inline float projectRadius( const Vector3& axis ) const;
+
+public:
+	static void closest( Vector3& out, const OrientBox& box, const Vector3& v );
+	inline Vector3 closest( const Vector3& v ) const;
+
+public:
+	bool intersects( const OrientBox& box ) const;
+	bool intersects( const Box& box ) const;
+	bool intersects( const Sphere& sphere ) const;
+	bool containsPoint( const Vector3& point ) const;
+};
+
+NAMESPACE_END
+
+#endif //__ORIENT_BOX_H__
\ No newline at end of file
@@ -21,3 +21,73 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 *******************************************************************************/
+NAMESPACE_MAGICAL
+
+inline OrientBox::OrientBox( const Vector3& center, const Vector3& extents, const Quaternion& rotation )
+{
+	set( center, extents, rotation );
+}
+
+inline OrientBox::OrientBox( const Box& box )
+{
+	set( box );
+}
+
+inline OrientBox::OrientBox( const OrientBox& box )
+: center( box.center ), axis_x( box.axis_x ), axis_y( box.axis_y ), axis_z( box.axis_z ), extents( box.extents )
+{
+
+}
+
+inline OrientBox::OrientBox( void )
+: center( Vector3::Zero ), axis_x( Vector3::UnitX ), axis_y( Vector3::UnitY ), axis_z( Vector3::UnitZ ), extents( Vector3::Zero )
+{
+
+}
+
+inline bool OrientBox::operator==( const OrientBox& box ) const
+{
+	return equals( box );
+}
+
+inline bool OrientBox::operator!=( const OrientBox& box ) const
+{
+	return equals( box ) == false;
+}
+
+inline OrientBox& OrientBox::operator=( const OrientBox& box )
+{
+	set( box );
+	return *this;
+}
+
+inline bool OrientBox::isValid( void ) const
+{
+	return extents.x > 0.0f && extents.y > 0.0f && extents.z > 0.0f;
+}
+
+inline void OrientBox::set( const OrientBox& box )
+{
+	center = box.center;
+	axis_x = box.axis_x;
+	axis_y = box.axis_y;
+	axis_z = box.axis_z;
+	extents = box.extents;
+}
+
+inline float OrientBox::projectRadius( const Vector3& axis ) const
+{
+	return
+		extents.x * ::fabsf( Vector3::dot( axis_x, axis ) ) +
+		extents.y * ::fabsf( Vector3::dot( axis_y, axis ) ) +
+		extents.z * ::fabsf( Vector3::dot( axis_z, axis ) );
+}
+
+inline Vector3 OrientBox::closest( const Vector3& v ) const
+{
+	Vector3 dst;
+	OrientBox::closest( dst, *this, v );
+	return dst;
+}
+
+NAMESPACE_END
\ No newline at end of file
@@ -21,3 +21,132 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 *******************************************************************************/
+#include "MathUtils.h"
+
+NAMESPACE_MAGICAL
+
+struct Vector2;
+struct Box2;
+struct OrientBox2;
+struct Circle;
+
+NAMESPACE_END
+
+#include "Vector2.h"
+#include "Vector2.inl"
+
+#include "Box2.h"
+#include "OrientBox2.h"
+#include "Circle.h"
+#include "Box2.inl"
+#include "OrientBox2.inl"
+#include "Circle.inl"
+
+NAMESPACE_MAGICAL
+
+const OrientBox2 OrientBox2::Invalid = OrientBox2( Vector2::Zero, -Vector2::One, 0.0f );
+
+bool OrientBox2::equals( const OrientBox2& box ) const
+{
+	return
+		center.equals( box.center ) &&
+		axis_x.equals( box.axis_x ) &&
+		axis_y.equals( box.axis_y ) &&
+		extents.equals( box.extents );
+}
+
+void OrientBox2::set( const Vector2& center, const Vector2& extents, float radian )
+{
+	float s = Math::sin( radian );
+	float c = Math::cos( radian );
+
+	this->center = center;
+	this->extents = extents;
+	axis_x.x = c;  axis_x.y = s;
+	axis_y.x = -s; axis_y.y = c;
+}
+
+void OrientBox2::set( const Box2& box )
+{
+	center = box.center();
+	extents.x = box.width() * 0.5f;
+	extents.y = box.height() * 0.5f;
+	axis_x = Vector2::UnitX;
+	axis_y = Vector2::UnitY;
+}
+
+/*
+按逆时针顺序输出4个顶点
+*/
+void OrientBox2::getVertices( Vector2* out ) const
+{
+	Vector2 ex = axis_x * extents.x;
+	Vector2 ey = axis_y * extents.y;
+
+	out[0] = center - ex - ey;
+	out[1] = center + ex - ey;
+	out[2] = center + ex + ey;
+	out[3] = center - ex + ey;
+}
+
+void OrientBox2::getBounds( Box2& out ) const
+{
+	float hx = ::fabsf( axis_x.x ) * extents.x + ::fabsf( axis_y.x ) * extents.y;
+	float hy = ::fabsf( axis_x.y ) * extents.x + ::fabsf( axis_y.y ) * extents.y;
+
+	out.min.x = center.x - hx;
+	out.min.y = center.y - hy;
+	out.max.x = center.x + hx;
+	out.max.y = center.y + hy;
+}
+
+void OrientBox2::closest( Vector2& out, const OrientBox2& box, const Vector2& v )
+{
+	Vector2 d = v - box.center;
+	float dx = Math::max( -box.extents.x, Math::min( box.extents.x, Vector2::dot( d, box.axis_x ) ) );
+	float dy = Math::max( -box.extents.y, Math::min( box.extents.y, Vector2::dot( d, box.axis_y ) ) );
+
+	out = box.center + box.axis_x * dx + box.axis_y * dy;
+}
+
+/*
+分离轴测试，只需检查两个盒子各自的两条轴
+*/
+bool OrientBox2::intersects( const OrientBox2& box ) const
+{
+	const Vector2* axes[4] = { &axis_x, &axis_y, &box.axis_x, &box.axis_y };
+	Vector2 d = box.center - center;
+
+	for( int i = 0; i < 4; ++i )
+	{
+		const Vector2& axis = *axes[i];
+		float r1 = extents.x * ::fabsf( Vector2::dot( axis_x, axis ) ) + extents.y * ::fabsf( Vector2::dot( axis_y, axis ) );
+		float r2 = box.extents.x * ::fabsf( Vector2::dot( box.axis_x, axis ) ) + box.extents.y * ::fabsf( Vector2::dot( box.axis_y, axis ) );
+
+		if( ::fabsf( Vector2::dot( d, axis ) ) > r1 + r2 )
+			return false;
+	}
+
+	return true;
+}
+
+bool OrientBox2::intersects( const Box2& box ) const
+{
+	return intersects( OrientBox2( box ) );
+}
+
+bool OrientBox2::intersects( const Circle& circle ) const
+{
+	return Vector2::distanceSq( closest( circle.center ), circle.center ) <= circle.r * circle.r;
+}
+
+bool OrientBox2::containsPoint( const Vector2& point ) const
+{
+	Vector2 d = point - center;
+
+	return
+		::fabsf( Vector2::dot( d, axis_x ) ) <= extents.x &&
+		::fabsf( Vector2::dot( d, axis_y ) ) <= extents.y;
+}
+
+NAMESPACE_END
\ No newline at end of file
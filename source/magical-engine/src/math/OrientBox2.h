@@ -21,3 +21,57 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 *******************************************************************************/
+#ifndef __ORIENT_BOX2_H__
+#define __ORIENT_BOX2_H__
+
+#include "magical-macros.h"
+
+NAMESPACE_MAGICAL
+
+/*
+二维有向包围盒，axis_x与axis_y为单位正交轴，extents为沿两轴的半长
+*/
+struct OrientBox2
+{
+	Vector2 center;
+	Vector2 axis_x;
+	Vector2 axis_y;
+	Vector2 extents;
+
+public:
+	static const OrientBox2 Invalid;
+
+public:
+	inline OrientBox2( const Vector2& center, const Vector2& extents, float radian );
+	inline explicit OrientBox2( const Box2& box );
+	inline OrientBox2( const OrientBox2& box );
+	inline OrientBox2( void );
+
+public:
+	inline bool operator==( const OrientBox2& box ) const;
+	inline bool operator!=( const OrientBox2& box ) const;
+	inline OrientBox2& operator=( const OrientBox2& box );
+
+public:
+	bool equals( const OrientBox2& box ) const;
+	inline bool isValid( void ) const;
+	void set( const Vector2& center, const Vector2& extents, float radian );
+	void set( const Box2& box );
+	inline void set( const OrientBox2& box );
+	void getVertices( Vector2* out ) const;
+	void getBounds( Box2& out ) const;
+
+public:
+	static void closest( Vector2& out, const OrientBox2& box, const Vector2& v );
+	inline Vector2 closest( const Vector2& v ) const;
+
+public:
+	bool intersects( const OrientBox2& box ) const;
+	bool intersects( const Box2& box ) const;
+	bool intersects( const Circle& circle ) const;
+	bool containsPoint( const Vector2& point ) const;
+};
+
+NAMESPACE_END
+
+#endif //__ORIENT_BOX2_H__
\ No newline at end of file
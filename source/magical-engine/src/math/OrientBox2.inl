@@ -21,3 +21,67 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 *******************************************************************************/
+NAMESPACE_MAGICAL
+
+inline OrientBox2::OrientBox2( const Vector2& center, const Vector2& extents, float radian )
+{
+	set( center, extents, radian );
+}
+
+inline OrientBox2::OrientBox2( const Box2& box )
+{
+	set( box );
+}
+
+inline OrientBox2::OrientBox2( const OrientBox2& box )
+: center( box.center ), axis_x( box.axis_x ), axis_y( box.axis_y ), extents( box.extents )
+{
+
+}
+
+inline OrientBox2::OrientBox2( void )
+: center( Vector2::Zero ), axis_x( Vector2::UnitX ), axis_y( Vector2::UnitY ), extents( Vector2::Zero )
+{
+
+}
+
+inline bool OrientBox2::operator==( const OrientBox2& box ) const
+{
+	return equals( box );
+}
+
+inline bool OrientBox2::operator!=( const OrientBox2& box ) const
+{
+	return equals( box ) == false;
+}
+
+inline OrientBox2& OrientBox2::operator=( const OrientBox2& box )
+{
+	center = box.center;
+	axis_x = box.axis_x;
+	axis_y = box.axis_y;
+	extents = box.extents;
+	return *this;
+}
+
+inline bool OrientBox2::isValid( void ) const
+{
+	return extents.x > 0.0f && extents.y > 0.0f;
+}
+
+inline void OrientBox2::set( const OrientBox2& box )
+{
+	center = box.center;
+	axis_x = box.axis_x;
+	axis_y = box.axis_y;
+	extents = box.extents;
+}
+
+inline Vector2 OrientBox2::closest( const Vector2& v ) const
+{
+	Vector2 dst;
+	OrientBox2::closest( dst, *this, v );
+	return dst;
+}
+
+NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,512 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "MathUtils.h"
+
+NAMESPACE_MAGICAL
+
+struct Vector2;
+struct Vector3;
+struct Vector4;
+struct Rotater;
+struct Quaternion;
+struct Matrix3x3;
+struct Matrix4x4;
+
+NAMESPACE_END
+
+#include "Vector2.h"
+#include "Vector3.h"
+#include "Vector4.h"
+#include "Rotater.h"
+#include "Quaternion.h"
+#include "Matrix3x3.h"
+#include "Matrix4x4.h"
+#include "Packed.h"
+
+#include "Vector2.inl"
+#include "Vector3.inl"
+#include "Vector4.inl"
+#include "Rotater.inl"
+#include "Quaternion.inl"
+#include "Matrix3x3.inl"
+#include "Matrix4x4.inl"
+#include "Packed.inl"
+
+#ifdef MAGICAL_SSE2
+#include <emmintrin.h>
+#endif
+
+NAMESPACE_MAGICAL
+
+union FloatBits
+{
+	float f;
+	uint32_t u;
+};
+
+#ifdef MAGICAL_SSE2
+/*
+float与half之间的SSE2转换，不依赖F16C指令，舍入规则与标量版本一致
+*/
+static inline __m128i floatToHalf4( __m128 f )
+{
+	const __m128i c_f16max = _mm_set1_epi32( ( 127 + 16 ) << 23 );
+	const __m128i c_nanbit = _mm_set1_epi32( 0x200 );
+	const __m128i c_infty = _mm_set1_epi32( 0x7c00 );
+	const __m128i c_min_normal = _mm_set1_epi32( ( 127 - 14 ) << 23 );
+	const __m128i c_subnorm_magic = _mm_set1_epi32( ( ( 127 - 15 ) + ( 23 - 10 ) + 1 ) << 23 );
+	const __m128i c_normal_bias = _mm_set1_epi32( 0xfff - ( ( 127 - 15 ) << 23 ) );
+
+	__m128 justsign = _mm_and_ps( _mm_castsi128_ps( _mm_set1_epi32( 0x80000000 ) ), f );
+	__m128 absf = _mm_xor_ps( f, justsign );
+	__m128i absf_int = _mm_castps_si128( absf );
+	__m128i is_regular = _mm_cmpgt_epi32( c_f16max, absf_int );
+	__m128i nanbit = _mm_and_si128( _mm_castps_si128( _mm_cmpunord_ps( absf, absf ) ), c_nanbit );
+	__m128i inf_or_nan = _mm_or_si128( nanbit, c_infty );
+	__m128i is_subnormal = _mm_cmpgt_epi32( c_min_normal, absf_int );
+
+	__m128i subnormal = _mm_sub_epi32( _mm_castps_si128( _mm_add_ps( absf, _mm_castsi128_ps( c_subnorm_magic ) ) ), c_subnorm_magic );
+	__m128i mant_odd = _mm_srai_epi32( _mm_slli_epi32( absf_int, 31 - 13 ), 31 );
+	__m128i normal = _mm_srli_epi32( _mm_sub_epi32( _mm_add_epi32( absf_int, c_normal_bias ), mant_odd ), 13 );
+
+	__m128i finite = _mm_or_si128( _mm_and_si128( is_subnormal, subnormal ), _mm_andnot_si128( is_subnormal, normal ) );
+	__m128i joined = _mm_or_si128( _mm_and_si128( is_regular, finite ), _mm_andnot_si128( is_regular, inf_or_nan ) );
+	return _mm_or_si128( joined, _mm_srai_epi32( _mm_castps_si128( justsign ), 16 ) );
+}
+
+static inline __m128 halfToFloat4( __m128i h )
+{
+	const __m128i c_nosign = _mm_set1_epi32( 0x7fff );
+	const __m128 c_magic = _mm_castsi128_ps( _mm_set1_epi32( ( 254 - 15 ) << 23 ) );
+	const __m128i c_was_infnan = _mm_set1_epi32( 0x7bff );
+	const __m128 c_exp_infnan = _mm_castsi128_ps( _mm_set1_epi32( 255 << 23 ) );
+
+	__m128i expmant = _mm_and_si128( c_nosign, h );
+	__m128i justsign = _mm_xor_si128( h, expmant );
+	__m128 scaled = _mm_mul_ps( _mm_castsi128_ps( _mm_slli_epi32( expmant, 13 ) ), c_magic );
+	__m128 infnan = _mm_and_ps( _mm_castsi128_ps( _mm_cmpgt_epi32( expmant, c_was_infnan ) ), c_exp_infnan );
+	__m128 sign = _mm_castsi128_ps( _mm_slli_epi32( justsign, 16 ) );
+	return _mm_or_ps( scaled, _mm_or_ps( sign, infnan ) );
+}
+#endif
+
+uint16_t Half::fromFloat( float f )
+{
+	const uint32_t f32infty = 255 << 23;
+	const uint32_t f16max = ( 127 + 16 ) << 23;
+	FloatBits denorm_magic; denorm_magic.u = ( ( 127 - 15 ) + ( 23 - 10 ) + 1 ) << 23;
+
+	FloatBits v; v.f = f;
+	uint32_t sign = v.u & 0x80000000;
+	uint32_t ret;
+	v.u ^= sign;
+
+	if( v.u >= f16max )
+	{
+		ret = v.u > f32infty ? 0x7e00 : 0x7c00;
+	}
+	else if( v.u < ( 113 << 23 ) )
+	{
+		v.f += denorm_magic.f;
+		ret = v.u - denorm_magic.u;
+	}
+	else
+	{
+		uint32_t mant_odd = ( v.u >> 13 ) & 1;
+		v.u += ( (uint32_t)( 15 - 127 ) << 23 ) + 0xfff + mant_odd;
+		ret = v.u >> 13;
+	}
+	return (uint16_t)( ret | ( sign >> 16 ) );
+}
+
+float Half::toFloat( uint16_t h )
+{
+	FloatBits magic; magic.u = ( 254 - 15 ) << 23;
+	FloatBits was_infnan; was_infnan.u = ( 127 + 16 ) << 23;
+
+	FloatBits ret;
+	ret.u = ( h & 0x7fff ) << 13;
+	ret.f *= magic.f;
+	if( ret.f >= was_infnan.f )
+		ret.u |= 255 << 23;
+	ret.u |= (uint32_t)( h & 0x8000 ) << 16;
+	return ret.f;
+}
+
+void Half::fromFloat( uint16_t* out, const float* in, size_t count )
+{
+	size_t i = 0;
+#ifdef MAGICAL_SSE2
+	for( ; i + 8 <= count; i += 8 )
+	{
+		__m128i lo = floatToHalf4( _mm_loadu_ps( in + i ) );
+		__m128i hi = floatToHalf4( _mm_loadu_ps( in + i + 4 ) );
+		_mm_storeu_si128( (__m128i*)( out + i ), _mm_packs_epi32( lo, hi ) );
+	}
+#endif
+	for( ; i < count; ++i )
+	{
+		out[i] = fromFloat( in[i] );
+	}
+}
+
+void Half::toFloat( float* out, const uint16_t* in, size_t count )
+{
+	size_t i = 0;
+#ifdef MAGICAL_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	for( ; i + 8 <= count; i += 8 )
+	{
+		__m128i h = _mm_loadu_si128( (const __m128i*)( in + i ) );
+		_mm_storeu_ps( out + i, halfToFloat4( _mm_unpacklo_epi16( h, zero ) ) );
+		_mm_storeu_ps( out + i + 4, halfToFloat4( _mm_unpackhi_epi16( h, zero ) ) );
+	}
+#endif
+	for( ; i < count; ++i )
+	{
+		out[i] = toFloat( in[i] );
+	}
+}
+
+void HalfVector2::pack( HalfVector2& out, const Vector2& v )
+{
+	out.x = Half::fromFloat( v.x );
+	out.y = Half::fromFloat( v.y );
+}
+
+void HalfVector2::unpack( Vector2& out, const HalfVector2& h )
+{
+	out.x = Half::toFloat( h.x );
+	out.y = Half::toFloat( h.y );
+}
+
+void HalfVector2::pack( HalfVector2* out, const Vector2* in, size_t count )
+{
+	Half::fromFloat( &out->x, &in->x, count * 2 );
+}
+
+void HalfVector2::unpack( Vector2* out, const HalfVector2* in, size_t count )
+{
+	Half::toFloat( &out->x, &in->x, count * 2 );
+}
+
+void HalfVector3::pack( HalfVector3& out, const Vector3& v )
+{
+	out.x = Half::fromFloat( v.x );
+	out.y = Half::fromFloat( v.y );
+	out.z = Half::fromFloat( v.z );
+}
+
+void HalfVector3::unpack( Vector3& out, const HalfVector3& h )
+{
+	out.x = Half::toFloat( h.x );
+	out.y = Half::toFloat( h.y );
+	out.z = Half::toFloat( h.z );
+}
+
+void HalfVector3::pack( HalfVector3* out, const Vector3* in, size_t count )
+{
+	Half::fromFloat( &out->x, &in->x, count * 3 );
+}
+
+void HalfVector3::unpack( Vector3* out, const HalfVector3* in, size_t count )
+{
+	Half::toFloat( &out->x, &in->x, count * 3 );
+}
+
+void HalfVector4::pack( HalfVector4& out, const Vector4& v )
+{
+	out.x = Half::fromFloat( v.x );
+	out.y = Half::fromFloat( v.y );
+	out.z = Half::fromFloat( v.z );
+	out.w = Half::fromFloat( v.w );
+}
+
+void HalfVector4::unpack( Vector4& out, const HalfVector4& h )
+{
+	out.x = Half::toFloat( h.x );
+	out.y = Half::toFloat( h.y );
+	out.z = Half::toFloat( h.z );
+	out.w = Half::toFloat( h.w );
+}
+
+void HalfVector4::pack( HalfVector4* out, const Vector4* in, size_t count )
+{
+	Half::fromFloat( &out->x, &in->x, count * 4 );
+}
+
+void HalfVector4::unpack( Vector4* out, const HalfVector4* in, size_t count )
+{
+	Half::toFloat( &out->x, &in->x, count * 4 );
+}
+
+int16_t Snorm16::fromFloat( float v )
+{
+	// 与_mm_cvtps_epi32相同按就近偶数舍入，保证批量转换的尾部与SIMD部分结果一致
+	return (int16_t) ::lrintf( Math::max( -1.0f, Math::min( 1.0f, v ) ) * 32767.0f );
+}
+
+void Snorm16::fromFloat( int16_t* out, const float* in, size_t count )
+{
+	size_t i = 0;
+#ifdef MAGICAL_SSE2
+	const __m128 one = _mm_set1_ps( 1.0f );
+	const __m128 neg_one = _mm_set1_ps( -1.0f );
+	const __m128 scale = _mm_set1_ps( 32767.0f );
+	for( ; i + 8 <= count; i += 8 )
+	{
+		__m128 lo = _mm_mul_ps( _mm_max_ps( neg_one, _mm_min_ps( one, _mm_loadu_ps( in + i ) ) ), scale );
+		__m128 hi = _mm_mul_ps( _mm_max_ps( neg_one, _mm_min_ps( one, _mm_loadu_ps( in + i + 4 ) ) ), scale );
+		_mm_storeu_si128( (__m128i*)( out + i ), _mm_packs_epi32( _mm_cvtps_epi32( lo ), _mm_cvtps_epi32( hi ) ) );
+	}
+#endif
+	for( ; i < count; ++i )
+	{
+		out[i] = fromFloat( in[i] );
+	}
+}
+
+float Snorm16::toFloat( int16_t s )
+{
+	return s * ( 1.0f / 32767.0f );
+}
+
+void Snorm16::toFloat( float* out, const int16_t* in, size_t count )
+{
+	const float inv_scale = 1.0f / 32767.0f;
+	size_t i = 0;
+#ifdef MAGICAL_SSE2
+	const __m128 scale = _mm_set1_ps( inv_scale );
+	for( ; i + 8 <= count; i += 8 )
+	{
+		__m128i s = _mm_loadu_si128( (const __m128i*)( in + i ) );
+		__m128i lo = _mm_srai_epi32( _mm_unpacklo_epi16( s, s ), 16 );
+		__m128i hi = _mm_srai_epi32( _mm_unpackhi_epi16( s, s ), 16 );
+		_mm_storeu_ps( out + i, _mm_mul_ps( _mm_cvtepi32_ps( lo ), scale ) );
+		_mm_storeu_ps( out + i + 4, _mm_mul_ps( _mm_cvtepi32_ps( hi ), scale ) );
+	}
+#endif
+	for( ; i < count; ++i )
+	{
+		out[i] = in[i] * inv_scale;
+	}
+}
+
+void Snorm16Vector3::pack( Snorm16Vector3& out, const Vector3& v )
+{
+	out.x = Snorm16::fromFloat( v.x );
+	out.y = Snorm16::fromFloat( v.y );
+	out.z = Snorm16::fromFloat( v.z );
+}
+
+void Snorm16Vector3::unpack( Vector3& out, const Snorm16Vector3& s )
+{
+	out.x = Snorm16::toFloat( s.x );
+	out.y = Snorm16::toFloat( s.y );
+	out.z = Snorm16::toFloat( s.z );
+}
+
+void Snorm16Vector3::pack( Snorm16Vector3* out, const Vector3* in, size_t count )
+{
+	Snorm16::fromFloat( &out->x, &in->x, count * 3 );
+}
+
+void Snorm16Vector3::unpack( Vector3* out, const Snorm16Vector3* in, size_t count )
+{
+	Snorm16::toFloat( &out->x, &in->x, count * 3 );
+}
+
+/*
+smallest-three编码，bits为每个分量的位数，返回的低3*bits位依次为三个较小分量，
+其上2位为最大分量的索引
+*/
+static inline uint64_t packSmallestThree( const Quaternion& q, int bits )
+{
+	const float* c = &q.x;
+	int largest = 0;
+	for( int i = 1; i < 4; ++i )
+	{
+		if( ::fabsf( c[i] ) > ::fabsf( c[largest] ) )
+			largest = i;
+	}
+
+	// q与-q表示相同的旋转，翻转符号使最大分量为正，解压时就无需保存它的符号
+	const float sqrt2 = 1.41421356f;
+	float sign = c[largest] < 0.0f ? -1.0f : 1.0f;
+	float inv_len = sign * sqrt2 / Math::sqrt( c[0] * c[0] + c[1] * c[1] + c[2] * c[2] + c[3] * c[3] );
+	// 量化级数取偶数，0可以精确表示，单位四元数的三个较小分量解压后仍为0
+	float max_value = (float)( ( 1 << bits ) - 2 );
+	uint64_t ret = (uint64_t) largest;
+
+	for( int i = 0; i < 4; ++i )
+	{
+		if( i == largest )
+			continue;
+
+		float v = c[i] * inv_len;
+		v = Math::max( 0.0f, Math::min( 1.0f, v * 0.5f + 0.5f ) );
+		ret = ( ret << bits ) | (uint64_t)( v * max_value + 0.5f );
+	}
+	return ret;
+}
+
+static inline void unpackSmallestThree( Quaternion& out, uint64_t packed, int bits )
+{
+	const float inv_sqrt2 = 0.70710678f;
+	float* c = &out.x;
+	int largest = (int)( ( packed >> ( bits * 3 ) ) & 3 );
+	uint64_t mask = ( 1 << bits ) - 1;
+	float inv_max = 1.0f / (float)( mask - 1 );
+	float sum = 0.0f;
+
+	for( int i = 3; i >= 0; --i )
+	{
+		if( i == largest )
+			continue;
+
+		float v = ( ( packed & mask ) * inv_max * 2.0f - 1.0f ) * inv_sqrt2;
+		packed >>= bits;
+		c[i] = v;
+		sum += v * v;
+	}
+	c[largest] = Math::sqrt( Math::max( 0.0f, 1.0f - sum ) );
+}
+
+void PackedQuaternion32::pack( PackedQuaternion32& out, const Quaternion& q )
+{
+	out.bits = (uint32_t) packSmallestThree( q, 10 );
+}
+
+void PackedQuaternion32::unpack( Quaternion& out, const PackedQuaternion32& p )
+{
+	unpackSmallestThree( out, p.bits, 10 );
+}
+
+void PackedQuaternion32::pack( PackedQuaternion32* out, const Quaternion* in, size_t count )
+{
+	for( size_t i = 0; i < count; ++i )
+	{
+		out[i].bits = (uint32_t) packSmallestThree( in[i], 10 );
+	}
+}
+
+void PackedQuaternion32::unpack( Quaternion* out, const PackedQuaternion32* in, size_t count )
+{
+	for( size_t i = 0; i < count; ++i )
+	{
+		unpackSmallestThree( out[i], in[i].bits, 10 );
+	}
+}
+
+void PackedQuaternion48::pack( PackedQuaternion48& out, const Quaternion& q )
+{
+	uint64_t packed = packSmallestThree( q, 15 );
+	out.bits[0] = (uint16_t)( packed );
+	out.bits[1] = (uint16_t)( packed >> 16 );
+	out.bits[2] = (uint16_t)( packed >> 32 );
+}
+
+void PackedQuaternion48::unpack( Quaternion& out, const PackedQuaternion48& p )
+{
+	uint64_t packed = (uint64_t) p.bits[0] | ( (uint64_t) p.bits[1] << 16 ) | ( (uint64_t) p.bits[2] << 32 );
+	unpackSmallestThree( out, packed, 15 );
+}
+
+void PackedQuaternion48::pack( PackedQuaternion48* out, const Quaternion* in, size_t count )
+{
+	for( size_t i = 0; i < count; ++i )
+	{
+		pack( out[i], in[i] );
+	}
+}
+
+void PackedQuaternion48::unpack( Quaternion* out, const PackedQuaternion48* in, size_t count )
+{
+	for( size_t i = 0; i < count; ++i )
+	{
+		unpack( out[i], in[i] );
+	}
+}
+
+void Affine3x4::pack( Affine3x4& out, const Matrix4x4& m )
+{
+	out.m[0] = m.m11; out.m[1] = m.m21; out.m[2]  = m.m31; out.m[3]  = m.m41;
+	out.m[4] = m.m12; out.m[5] = m.m22; out.m[6]  = m.m32; out.m[7]  = m.m42;
+	out.m[8] = m.m13; out.m[9] = m.m23; out.m[10] = m.m33; out.m[11] = m.m43;
+}
+
+void Affine3x4::unpack( Matrix4x4& out, const Affine3x4& a )
+{
+	out.m11 = a.m[0]; out.m12 = a.m[4]; out.m13 = a.m[8];  out.m14 = 0.0f;
+	out.m21 = a.m[1]; out.m22 = a.m[5]; out.m23 = a.m[9];  out.m24 = 0.0f;
+	out.m31 = a.m[2]; out.m32 = a.m[6]; out.m33 = a.m[10]; out.m34 = 0.0f;
+	out.m41 = a.m[3]; out.m42 = a.m[7]; out.m43 = a.m[11]; out.m44 = 1.0f;
+}
+
+void Affine3x4::pack( Affine3x4* out, const Matrix4x4* in, size_t count )
+{
+#ifdef MAGICAL_SSE2
+	for( size_t i = 0; i < count; ++i )
+	{
+		__m128 r0 = _mm_loadu_ps( in[i].m );
+		__m128 r1 = _mm_loadu_ps( in[i].m + 4 );
+		__m128 r2 = _mm_loadu_ps( in[i].m + 8 );
+		__m128 r3 = _mm_loadu_ps( in[i].m + 12 );
+		_MM_TRANSPOSE4_PS( r0, r1, r2, r3 );
+		_mm_storeu_ps( out[i].m, r0 );
+		_mm_storeu_ps( out[i].m + 4, r1 );
+		_mm_storeu_ps( out[i].m + 8, r2 );
+	}
+#else
+	for( size_t i = 0; i < count; ++i )
+	{
+		pack( out[i], in[i] );
+	}
+#endif
+}
+
+void Affine3x4::unpack( Matrix4x4* out, const Affine3x4* in, size_t count )
+{
+#ifdef MAGICAL_SSE2
+	for( size_t i = 0; i < count; ++i )
+	{
+		__m128 r0 = _mm_loadu_ps( in[i].m );
+		__m128 r1 = _mm_loadu_ps( in[i].m + 4 );
+		__m128 r2 = _mm_loadu_ps( in[i].m + 8 );
+		__m128 r3 = _mm_set_ps( 1.0f, 0.0f, 0.0f, 0.0f );
+		_MM_TRANSPOSE4_PS( r0, r1, r2, r3 );
+		_mm_storeu_ps( out[i].m, r0 );
+		_mm_storeu_ps( out[i].m + 4, r1 );
+		_mm_storeu_ps( out[i].m + 8, r2 );
+		_mm_storeu_ps( out[i].m + 12, r3 );
+	}
+#else
+	for( size_t i = 0; i < count; ++i )
+	{
+		unpack( out[i], in[i] );
+	}
+#endif
+}
+
+NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,205 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __PACKED_H__
+#define __PACKED_H__
+
+#include "magical-macros.h"
+#include <stdint.h>
+
+NAMESPACE_MAGICAL
+
+/*
+压缩格式，用于顶点数据、动画关键帧以及快照序列化
+批量转换接口在支持SSE2的平台上使用SIMD实现
+*/
+
+/*
+半精度浮点数(IEEE 754 binary16)，转换时按就近偶数舍入
+*/
+struct Half
+{
+	uint16_t bits;
+
+public:
+	inline explicit Half( float f );
+	inline Half( void );
+
+public:
+	inline operator float( void ) const;
+
+public:
+	static uint16_t fromFloat( float f );
+	static float toFloat( uint16_t h );
+	static void fromFloat( uint16_t* out, const float* in, size_t count );
+	static void toFloat( float* out, const uint16_t* in, size_t count );
+};
+
+struct HalfVector2
+{
+	uint16_t x;
+	uint16_t y;
+
+public:
+	inline explicit HalfVector2( const Vector2& v );
+	inline HalfVector2( void );
+
+public:
+	static void pack( HalfVector2& out, const Vector2& v );
+	static void unpack( Vector2& out, const HalfVector2& h );
+	static void pack( HalfVector2* out, const Vector2* in, size_t count );
+	static void unpack( Vector2* out, const HalfVector2* in, size_t count );
+	inline Vector2 unpack( void ) const;
+};
+
+struct HalfVector3
+{
+	uint16_t x;
+	uint16_t y;
+	uint16_t z;
+
+public:
+	inline explicit HalfVector3( const Vector3& v );
+	inline HalfVector3( void );
+
+public:
+	static void pack( HalfVector3& out, const Vector3& v );
+	static void unpack( Vector3& out, const HalfVector3& h );
+	static void pack( HalfVector3* out, const Vector3* in, size_t count );
+	static void unpack( Vector3* out, const HalfVector3* in, size_t count );
+	inline Vector3 unpack( void ) const;
+};
+
+struct HalfVector4
+{
+	uint16_t x;
+	uint16_t y;
+	uint16_t z;
+	uint16_t w;
+
+public:
+	inline explicit HalfVector4( const Vector4& v );
+	inline HalfVector4( void );
+
+public:
+	static void pack( HalfVector4& out, const Vector4& v );
+	static void unpack( Vector4& out, const HalfVector4& h );
+	static void pack( HalfVector4* out, const Vector4* in, size_t count );
+	static void unpack( Vector4* out, const HalfVector4* in, size_t count );
+	inline Vector4 unpack( void ) const;
+};
+
+/*
+有符号归一化16位定点数，限制在-1.0到+1.0之间，精度为1/32767，转换时按就近偶数舍入
+*/
+struct Snorm16
+{
+	static int16_t fromFloat( float f );
+	static float toFloat( int16_t s );
+	static void fromFloat( int16_t* out, const float* in, size_t count );
+	static void toFloat( float* out, const int16_t* in, size_t count );
+};
+
+/*
+有符号归一化16位定点向量，适用于法线、切线等单位向量
+*/
+struct Snorm16Vector3
+{
+	int16_t x;
+	int16_t y;
+	int16_t z;
+
+public:
+	inline explicit Snorm16Vector3( const Vector3& v );
+	inline Snorm16Vector3( void );
+
+public:
+	static void pack( Snorm16Vector3& out, const Vector3& v );
+	static void unpack( Vector3& out, const Snorm16Vector3& s );
+	static void pack( Snorm16Vector3* out, const Vector3* in, size_t count );
+	static void unpack( Vector3* out, const Snorm16Vector3* in, size_t count );
+	inline Vector3 unpack( void ) const;
+};
+
+/*
+smallest-three压缩四元数，只保存绝对值最大分量的索引以及其余三个分量，
+最大分量在解压时由单位长度约束求出，其余分量的取值范围为-1/sqrt(2)到+1/sqrt(2)
+
+PackedQuaternion32: 2位索引 + 3 x 10位分量，分量误差小于2e-3
+PackedQuaternion48: 2位索引 + 3 x 15位分量，分量误差小于1e-4
+*/
+struct PackedQuaternion32
+{
+	uint32_t bits;
+
+public:
+	inline explicit PackedQuaternion32( const Quaternion& q );
+	inline PackedQuaternion32( void );
+
+public:
+	static void pack( PackedQuaternion32& out, const Quaternion& q );
+	static void unpack( Quaternion& out, const PackedQuaternion32& p );
+	static void pack( PackedQuaternion32* out, const Quaternion* in, size_t count );
+	static void unpack( Quaternion* out, const PackedQuaternion32* in, size_t count );
+	inline Quaternion unpack( void ) const;
+};
+
+struct PackedQuaternion48
+{
+	uint16_t bits[3];
+
+public:
+	inline explicit PackedQuaternion48( const Quaternion& q );
+	inline PackedQuaternion48( void );
+
+public:
+	static void pack( PackedQuaternion48& out, const Quaternion& q );
+	static void unpack( Quaternion& out, const PackedQuaternion48& p );
+	static void pack( PackedQuaternion48* out, const Quaternion* in, size_t count );
+	static void unpack( Quaternion* out, const PackedQuaternion48* in, size_t count );
+	inline Quaternion unpack( void ) const;
+};
+
+/*
+仿射矩阵，省略Matrix4x4恒为(0,0,0,1)的第四列，按列转置保存为3行4列，
+每一行可直接作为着色器中的vec4使用
+*/
+struct Affine3x4
+{
+	float m[12];
+
+public:
+	inline explicit Affine3x4( const Matrix4x4& m );
+	inline Affine3x4( void );
+
+public:
+	static void pack( Affine3x4& out, const Matrix4x4& m );
+	static void unpack( Matrix4x4& out, const Affine3x4& a );
+	static void pack( Affine3x4* out, const Matrix4x4* in, size_t count );
+	static void unpack( Matrix4x4* out, const Affine3x4* in, size_t count );
+	inline Matrix4x4 unpack( void ) const;
+};
+
+NAMESPACE_END
+
+#endif //__PACKED_H__
\ No newline at end of file
@@ -0,0 +1,166 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+NAMESPACE_MAGICAL
+
+inline Half::Half( float f )
+: bits( fromFloat( f ) )
+{
+
+}
+
+inline Half::Half( void )
+: bits( 0 )
+{
+
+}
+
+inline Half::operator float( void ) const
+{
+	return toFloat( bits );
+}
+
+inline HalfVector2::HalfVector2( const Vector2& v )
+{
+	pack( *this, v );
+}
+
+inline HalfVector2::HalfVector2( void )
+: x( 0 ), y( 0 )
+{
+
+}
+
+inline Vector2 HalfVector2::unpack( void ) const
+{
+	Vector2 ret;
+	unpack( ret, *this );
+	return ret;
+}
+
+inline HalfVector3::HalfVector3( const Vector3& v )
+{
+	pack( *this, v );
+}
+
+inline HalfVector3::HalfVector3( void )
+: x( 0 ), y( 0 ), z( 0 )
+{
+
+}
+
+inline Vector3 HalfVector3::unpack( void ) const
+{
+	Vector3 ret;
+	unpack( ret, *this );
+	return ret;
+}
+
+inline HalfVector4::HalfVector4( const Vector4& v )
+{
+	pack( *this, v );
+}
+
+inline HalfVector4::HalfVector4( void )
+: x( 0 ), y( 0 ), z( 0 ), w( 0 )
+{
+
+}
+
+inline Vector4 HalfVector4::unpack( void ) const
+{
+	Vector4 ret;
+	unpack( ret, *this );
+	return ret;
+}
+
+inline Snorm16Vector3::Snorm16Vector3( const Vector3& v )
+{
+	pack( *this, v );
+}
+
+inline Snorm16Vector3::Snorm16Vector3( void )
+: x( 0 ), y( 0 ), z( 0 )
+{
+
+}
+
+inline Vector3 Snorm16Vector3::unpack( void ) const
+{
+	Vector3 ret;
+	unpack( ret, *this );
+	return ret;
+}
+
+inline PackedQuaternion32::PackedQuaternion32( const Quaternion& q )
+{
+	pack( *this, q );
+}
+
+inline PackedQuaternion32::PackedQuaternion32( void )
+{
+	pack( *this, Quaternion::Identity );
+}
+
+inline Quaternion PackedQuaternion32::unpack( void ) const
+{
+	Quaternion ret;
+	unpack( ret, *this );
+	return ret;
+}
+
+inline PackedQuaternion48::PackedQuaternion48( const Quaternion& q )
+{
+	pack( *this, q );
+}
+
+inline PackedQuaternion48::PackedQuaternion48( void )
+{
+	pack( *this, Quaternion::Identity );
+}
+
+inline Quaternion PackedQuaternion48::unpack( void ) const
+{
+	Quaternion ret;
+	unpack( ret, *this );
+	return ret;
+}
+
+inline Affine3x4::Affine3x4( const Matrix4x4& m )
+{
+	pack( *this, m );
+}
+
+inline Affine3x4::Affine3x4( void )
+{
+	pack( *this, Matrix4x4::Identity );
+}
+
+inline Matrix4x4 Affine3x4::unpack( void ) const
+{
+	Matrix4x4 ret;
+	unpack( ret, *this );
+	return ret;
+}
+
+NAMESPACE_END
\ No newline at end of file
@@ -38,7 +38,7 @@ struct Plane
 			float z;
 			float d;
 		};
-		struct { Vector3 normal; float d; };
+		Vector3 normal;
 	};
 
 	enum class Classification : int
@@ -21,3 +21,222 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 *******************************************************************************/
+#include "MathUtils.h"
+
+NAMESPACE_MAGICAL
+
+struct Vector2;
+struct Vector3;
+struct Vector4;
+struct Rotater;
+struct Quaternion;
+struct Matrix3x3;
+struct Matrix4x4;
+
+struct Ray;
+struct Box;
+struct OrientBox;
+struct Plane;
+struct Sphere;
+struct Polygon;
+
+NAMESPACE_END
+
+#include "Vector2.h"
+#include "Vector3.h"
+#include "Vector4.h"
+#include "Rotater.h"
+#include "Quaternion.h"
+#include "Matrix3x3.h"
+#include "Matrix4x4.h"
+
+#include "Vector2.inl"
+#include "Vector3.inl"
+#include "Vector4.inl"
+#include "Rotater.inl"
+#include "Quaternion.inl"
+#include "Matrix3x3.inl"
+#include "Matrix4x4.inl"
+
+#include "Ray.h"
+#include "Box.h"
+#include "OrientBox.h"
+#include "Plane.h"
+#include "Sphere.h"
+#include "Polygon.h"
+
+#include "Ray.inl"
+#include "Box.inl"
+#include "OrientBox.inl"
+#include "Plane.inl"
+#include "Sphere.inl"
+#include "Polygon.inl"
+
+NAMESPACE_MAGICAL
+
+/*
+检查一条分离轴，轴长度接近0时(两条边平行)视为不分离
+*/
+static inline bool separatedOn( const Polygon& polygon, const OrientBox& box, const Vector3& axis )
+{
+	if( axis.lengthSq() < Math::VectorEpsilon )
+		return false;
+
+	float min, max;
+	polygon.project( min, max, axis );
+	float c = Vector3::dot( box.center, axis );
+	float r = box.projectRadius( axis );
+	return min > c + r || max < c - r;
+}
+
+static inline bool separatedOn( const Polygon& polygon1, const Polygon& polygon2, const Vector3& axis )
+{
+	if( axis.lengthSq() < Math::VectorEpsilon )
+		return false;
+
+	float min1, max1, min2, max2;
+	polygon1.project( min1, max1, axis );
+	polygon2.project( min2, max2, axis );
+	return min1 > max2 || min2 > max1;
+}
+
+void Polygon::set( const Vector3* points, int count )
+{
+	debugassert( 3 <= count && count <= MaxVertices, "Invalid vertex count!" );
+
+	this->count = count;
+	for( int i = 0; i < count; ++i )
+	{
+		vertices[i] = points[i];
+	}
+
+	// Newell法求法线，对轻微不共面的输入也较稳定
+	normal = Vector3::Zero;
+	for( int i = 0; i < count; ++i )
+	{
+		const Vector3& v1 = vertices[i];
+		const Vector3& v2 = vertices[ i + 1 < count ? i + 1 : 0 ];
+		normal.x += ( v1.y - v2.y ) * ( v1.z + v2.z );
+		normal.y += ( v1.z - v2.z ) * ( v1.x + v2.x );
+		normal.z += ( v1.x - v2.x ) * ( v1.y + v2.y );
+	}
+	normal.normalize();
+}
+
+void Polygon::set( const Polygon& polygon )
+{
+	count = polygon.count;
+	normal = polygon.normal;
+	for( int i = 0; i < count; ++i )
+	{
+		vertices[i] = polygon.vertices[i];
+	}
+}
+
+void Polygon::getBounds( Box& out ) const
+{
+	out.set( vertices[0], vertices[0] );
+	for( int i = 1; i < count; ++i )
+	{
+		out.expandBy( vertices[i] );
+	}
+}
+
+Vector3 Polygon::centroid( void ) const
+{
+	Vector3 dst = Vector3::Zero;
+	for( int i = 0; i < count; ++i )
+	{
+		dst += vertices[i];
+	}
+	return dst * ( 1.0f / count );
+}
+
+void Polygon::transform( Polygon& out, const Polygon& polygon, const Matrix4x4& m )
+{
+	Vector3 points[ MaxVertices ];
+	for( int i = 0; i < polygon.count; ++i )
+	{
+		Vector3::mul4x4( points[i], polygon.vertices[i], m );
+	}
+
+	// 非均匀缩放下法线不能直接变换，重新计算
+	out.set( points, polygon.count );
+}
+
+bool Polygon::intersects( const Polygon& polygon ) const
+{
+	if( separatedOn( *this, polygon, normal ) || separatedOn( *this, polygon, polygon.normal ) )
+		return false;
+
+	// 两多边形共面时边叉积都平行于法线，还需检查平面内各边的外法线
+	for( int i = 0; i < count; ++i )
+	{
+		Vector3 e = vertices[ i + 1 < count ? i + 1 : 0 ] - vertices[i];
+		if( separatedOn( *this, polygon, Vector3::cross( e, normal ) ) )
+			return false;
+	}
+
+	for( int i = 0; i < polygon.count; ++i )
+	{
+		Vector3 e = polygon.vertices[ i + 1 < polygon.count ? i + 1 : 0 ] - polygon.vertices[i];
+		if( separatedOn( *this, polygon, Vector3::cross( e, polygon.normal ) ) )
+			return false;
+	}
+
+	for( int i = 0; i < count; ++i )
+	{
+		Vector3 e1 = vertices[ i + 1 < count ? i + 1 : 0 ] - vertices[i];
+		for( int j = 0; j < polygon.count; ++j )
+		{
+			Vector3 e2 = polygon.vertices[ j + 1 < polygon.count ? j + 1 : 0 ] - polygon.vertices[j];
+			if( separatedOn( *this, polygon, Vector3::cross( e1, e2 ) ) )
+				return false;
+		}
+	}
+
+	return true;
+}
+
+bool Polygon::intersects( const OrientBox& box ) const
+{
+	if( separatedOn( *this, box, normal ) ||
+		separatedOn( *this, box, box.axis_x ) ||
+		separatedOn( *this, box, box.axis_y ) ||
+		separatedOn( *this, box, box.axis_z ) )
+		return false;
+
+	for( int i = 0; i < count; ++i )
+	{
+		Vector3 e = vertices[ i + 1 < count ? i + 1 : 0 ] - vertices[i];
+		if( separatedOn( *this, box, Vector3::cross( e, normal ) ) ||
+			separatedOn( *this, box, Vector3::cross( e, box.axis_x ) ) ||
+			separatedOn( *this, box, Vector3::cross( e, box.axis_y ) ) ||
+			separatedOn( *this, box, Vector3::cross( e, box.axis_z ) ) )
+			return false;
+	}
+
+	return true;
+}
+
+bool Polygon::intersects( const Box& box ) const
+{
+	return intersects( OrientBox( box ) );
+}
+
+bool Polygon::containsPoint( const Vector3& point ) const
+{
+	if( !Math::isAlmostZero( Vector3::dot( point - vertices[0], normal ), Math::VectorEpsilon ) )
+		return false;
+
+	for( int i = 0; i < count; ++i )
+	{
+		Vector3 e = vertices[ i + 1 < count ? i + 1 : 0 ] - vertices[i];
+		if( Vector3::dot( Vector3::cross( e, point - vertices[i] ), normal ) < 0.0f )
+			return false;
+	}
+
+	return true;
+}
+
+NAMESPACE_END
\ No newline at end of file
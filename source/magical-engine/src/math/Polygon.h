@@ -20,4 +20,52 @@ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
-*******************************************************************************/
\ No newline at end of file
+*******************************************************************************/
+#ifndef __POLYGON_H__
+#define __POLYGON_H__
+
+#include "magical-macros.h"
+
+NAMESPACE_MAGICAL
+
+/*
+三维平面凸多边形，顶点绕法线逆时针排列，顶点数上限固定
+*/
+struct Polygon
+{
+	enum : int { MaxVertices = 8 };
+
+	Vector3 vertices[ MaxVertices ];
+	Vector3 normal;
+	int count;
+
+public:
+	inline Polygon( const Vector3* points, int count );
+	inline Polygon( const Polygon& polygon );
+	inline Polygon( void );
+
+public:
+	inline Polygon& operator=( const Polygon& polygon );
+
+public:
+	inline bool isValid( void ) const;
+	void set( const Vector3* points, int count );
+	void set( const Polygon& polygon );
+	void getBounds( Box& out ) const;
+	Vector3 centroid( void ) const;
+	inline void project( float& min, float& max, const Vector3& axis ) const;
+
+public:
+	static void transform( Polygon& out, const Polygon& polygon, const Matrix4x4& m );
+	inline void transform( const Matrix4x4& m );
+
+public:
+	bool intersects( const Polygon& polygon ) const;
+	bool intersects( const OrientBox& box ) const;
+	bool intersects( const Box& box ) const;
+	bool containsPoint( const Vector3& point ) const;
+};
+
+NAMESPACE_END
+
+#endif //__POLYGON_H__
\ No newline at end of file
@@ -21,3 +21,49 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 *******************************************************************************/
+NAMESPACE_MAGICAL
+
+inline Polygon::Polygon( const Vector3* points, int count )
+{
+	set( points, count );
+}
+
+inline Polygon::Polygon( const Polygon& polygon )
+{
+	set( polygon );
+}
+
+inline Polygon::Polygon( void )
+: normal( Vector3::Zero ), count( 0 )
+{
+
+}
+
+inline Polygon& Polygon::operator=( const Polygon& polygon )
+{
+	set( polygon );
+	return *this;
+}
+
+inline bool Polygon::isValid( void ) const
+{
+	return count >= 3;
+}
+
+inline void Polygon::project( float& min, float& max, const Vector3& axis ) const
+{
+	min = max = Vector3::dot( vertices[0], axis );
+	for( int i = 1; i < count; ++i )
+	{
+		float d = Vector3::dot( vertices[i], axis );
+		min = Math::min( min, d );
+		max = Math::max( max, d );
+	}
+}
+
+inline void Polygon::transform( const Matrix4x4& m )
+{
+	Polygon::transform( *this, *this, m );
+}
+
+NAMESPACE_END
\ No newline at end of file
@@ -21,3 +21,244 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 *******************************************************************************/
+#include "MathUtils.h"
+
+NAMESPACE_MAGICAL
+
+struct Vector2;
+struct Box2;
+struct OrientBox2;
+struct Circle;
+struct Polygon2;
+
+NAMESPACE_END
+
+#include "Vector2.h"
+#include "Vector2.inl"
+
+#include "Box2.h"
+#include "OrientBox2.h"
+#include "Circle.h"
+#include "Polygon2.h"
+#include "Box2.inl"
+#include "OrientBox2.inl"
+#include "Circle.inl"
+#include "Polygon2.inl"
+
+NAMESPACE_MAGICAL
+
+/*
+多边形在轴上投影区间的最小值与最大值
+*/
+static inline void project( float& min, float& max, const Polygon2& polygon, const Vector2& axis )
+{
+	min = max = Vector2::dot( polygon.vertices[0], axis );
+	for( int i = 1; i < polygon.count; ++i )
+	{
+		float d = Vector2::dot( polygon.vertices[i], axis );
+		min = Math::min( min, d );
+		max = Math::max( max, d );
+	}
+}
+
+/*
+有向面积的两倍，逆时针为正
+*/
+static inline float signedArea2( const Vector2* points, int count )
+{
+	float area = 0.0f;
+	for( int i = 0; i < count; ++i )
+	{
+		area += Vector2::cross( points[i], points[ i + 1 < count ? i + 1 : 0 ] );
+	}
+	return area;
+}
+
+/*
+每个顶点处相邻两条边都向左转（允许共线）即为凸多边形
+*/
+static inline bool isConvex( const Vector2* points, int count )
+{
+	for( int i = 0; i < count; ++i )
+	{
+		const Vector2& v0 = points[i];
+		const Vector2& v1 = points[ ( i + 1 ) % count ];
+		const Vector2& v2 = points[ ( i + 2 ) % count ];
+		Vector2 e1 = v1 - v0;
+		Vector2 e2 = v2 - v1;
+		if( Vector2::cross( e1, e2 ) < -Math::VectorEpsilon * e1.length() * e2.length() )
+			return false;
+	}
+	return true;
+}
+
+/*
+SAT依赖外法线，顺时针传入的顶点反转为逆时针保存；凹多边形或退化的多边形无法修正，只在调试版断言
+*/
+void Polygon2::set( const Vector2* points, int count )
+{
+	debugassert( 3 <= count && count <= MaxVertices, "Invalid vertex count!" );
+
+	float area = signedArea2( points, count );
+	debugassert( area != 0.0f, "Invalid polygon! zero area" );
+
+	this->count = count;
+	if( area < 0.0f )
+	{
+		for( int i = 0; i < count; ++i )
+		{
+			vertices[i] = points[ count - 1 - i ];
+		}
+	}
+	else
+	{
+		for( int i = 0; i < count; ++i )
+		{
+			vertices[i] = points[i];
+		}
+	}
+	debugassert( isConvex( vertices, count ), "Invalid polygon! should be convex" );
+
+	for( int i = 0; i < count; ++i )
+	{
+		const Vector2& v1 = vertices[i];
+		const Vector2& v2 = vertices[ i + 1 < count ? i + 1 : 0 ];
+		Vector2 n( v2.y - v1.y, v1.x - v2.x );
+		n.normalize();
+		normals[i] = n;
+	}
+}
+
+void Polygon2::set( const Box2& box )
+{
+	Vector2 points[4] = {
+		Vector2( box.min.x, box.min.y ),
+		Vector2( box.max.x, box.min.y ),
+		Vector2( box.max.x, box.max.y ),
+		Vector2( box.min.x, box.max.y ),
+	};
+	set( points, 4 );
+}
+
+void Polygon2::set( const OrientBox2& box )
+{
+	Vector2 points[4];
+	box.getVertices( points );
+	set( points, 4 );
+}
+
+void Polygon2::set( const Polygon2& polygon )
+{
+	count = polygon.count;
+	for( int i = 0; i < count; ++i )
+	{
+		vertices[i] = polygon.vertices[i];
+		normals[i] = polygon.normals[i];
+	}
+}
+
+void Polygon2::getBounds( Box2& out ) const
+{
+	out.min = out.max = vertices[0];
+	for( int i = 1; i < count; ++i )
+	{
+		out.min.x = Math::min( out.min.x, vertices[i].x );
+		out.min.y = Math::min( out.min.y, vertices[i].y );
+		out.max.x = Math::max( out.max.x, vertices[i].x );
+		out.max.y = Math::max( out.max.y, vertices[i].y );
+	}
+}
+
+Vector2 Polygon2::centroid( void ) const
+{
+	Vector2 dst = Vector2::Zero;
+	for( int i = 0; i < count; ++i )
+	{
+		dst += vertices[i];
+	}
+	return dst * ( 1.0f / count );
+}
+
+void Polygon2::transform( Polygon2& out, const Polygon2& polygon, const Vector2& t, float radian )
+{
+	float s = Math::sin( radian );
+	float c = Math::cos( radian );
+
+	out.count = polygon.count;
+	for( int i = 0; i < polygon.count; ++i )
+	{
+		const Vector2 v = polygon.vertices[i];
+		const Vector2 n = polygon.normals[i];
+		out.vertices[i].x = c * v.x - s * v.y + t.x;
+		out.vertices[i].y = s * v.x + c * v.y + t.y;
+		out.normals[i].x = c * n.x - s * n.y;
+		out.normals[i].y = s * n.x + c * n.y;
+	}
+}
+
+bool Polygon2::intersects( const Polygon2& polygon ) const
+{
+	float min1, max1, min2, max2;
+
+	for( int i = 0; i < count; ++i )
+	{
+		project( min1, max1, *this, normals[i] );
+		project( min2, max2, polygon, normals[i] );
+		if( min1 > max2 || min2 > max1 )
+			return false;
+	}
+
+	for( int i = 0; i < polygon.count; ++i )
+	{
+		project( min1, max1, *this, polygon.normals[i] );
+		project( min2, max2, polygon, polygon.normals[i] );
+		if( min1 > max2 || min2 > max1 )
+			return false;
+	}
+
+	return true;
+}
+
+bool Polygon2::intersects( const Box2& box ) const
+{
+	return intersects( Polygon2( box ) );
+}
+
+bool Polygon2::intersects( const OrientBox2& box ) const
+{
+	return intersects( Polygon2( box ) );
+}
+
+bool Polygon2::intersects( const Circle& circle ) const
+{
+	if( containsPoint( circle.center ) )
+		return true;
+
+	float rr = circle.r * circle.r;
+	for( int i = 0; i < count; ++i )
+	{
+		const Vector2& v1 = vertices[i];
+		const Vector2& v2 = vertices[ i + 1 < count ? i + 1 : 0 ];
+		Vector2 e = v2 - v1;
+		float t = Vector2::dot( circle.center - v1, e ) / Vector2::dot( e, e );
+		t = Math::max( 0.0f, Math::min( 1.0f, t ) );
+
+		if( Vector2::distanceSq( v1 + e * t, circle.center ) <= rr )
+			return true;
+	}
+
+	return false;
+}
+
+bool Polygon2::containsPoint( const Vector2& point ) const
+{
+	for( int i = 0; i < count; ++i )
+	{
+		if( Vector2::dot( point - vertices[i], normals[i] ) > 0.0f )
+			return false;
+	}
+
+	return true;
+}
+
+NAMESPACE_END
\ No newline at end of file
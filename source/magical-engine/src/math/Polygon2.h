@@ -21,3 +21,56 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 *******************************************************************************/
+#ifndef __POLYGON2_H__
+#define __POLYGON2_H__
+
+#include "magical-macros.h"
+
+NAMESPACE_MAGICAL
+
+/*
+二维凸多边形，顶点按逆时针顺序保存（set时顺时针的输入会被反转），normals[i]为边vertices[i]->vertices[i+1]的外法线
+顶点数上限固定，便于按值存放和复制
+*/
+struct Polygon2
+{
+	enum : int { MaxVertices = 8 };
+
+	Vector2 vertices[ MaxVertices ];
+	Vector2 normals[ MaxVertices ];
+	int count;
+
+public:
+	inline Polygon2( const Vector2* points, int count );
+	inline explicit Polygon2( const Box2& box );
+	inline explicit Polygon2( const OrientBox2& box );
+	inline Polygon2( const Polygon2& polygon );
+	inline Polygon2( void );
+
+public:
+	inline Polygon2& operator=( const Polygon2& polygon );
+
+public:
+	inline bool isValid( void ) const;
+	void set( const Vector2* points, int count );
+	void set( const Box2& box );
+	void set( const OrientBox2& box );
+	void set( const Polygon2& polygon );
+	void getBounds( Box2& out ) const;
+	Vector2 centroid( void ) const;
+
+public:
+	static void transform( Polygon2& out, const Polygon2& polygon, const Vector2& t, float radian );
+	inline void transform( const Vector2& t, float radian );
+
+public:
+	bool intersects( const Polygon2& polygon ) const;
+	bool intersects( const Box2& box ) const;
+	bool intersects( const OrientBox2& box ) const;
+	bool intersects( const Circle& circle ) const;
+	bool containsPoint( const Vector2& point ) const;
+};
+
+NAMESPACE_END
+
+#endif //__POLYGON2_H__
\ No newline at end of file
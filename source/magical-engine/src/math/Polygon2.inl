@@ -21,3 +21,48 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 *******************************************************************************/
+NAMESPACE_MAGICAL
+
+inline Polygon2::Polygon2( const Vector2* points, int count )
+{
+	set( points, count );
+}
+
+inline Polygon2::Polygon2( const Box2& box )
+{
+	set( box );
+}
+
+inline Polygon2::Polygon2( const OrientBox2& box )
+{
+	set( box );
+}
+
+inline Polygon2::Polygon2( const Polygon2& polygon )
+{
+	set( polygon );
+}
+
+inline Polygon2::Polygon2( void )
+: count( 0 )
+{
+
+}
+
+inline Polygon2& Polygon2::operator=( const Polygon2& polygon )
+{
+	set( polygon );
+	return *this;
+}
+
+inline bool Polygon2::isValid( void ) const
+{
+	return count >= 3;
+}
+
+inline void Polygon2::transform( const Vector2& t, float radian )
+{
+	Polygon2::transform( *this, *this, t, radian );
+}
+
+NAMESPACE_END
\ No newline at end of file
@@ -51,6 +51,10 @@ NAMESPACE_END
 #include "Matrix3x3.inl"
 #include "Matrix4x4.inl"
 
+#ifdef MAGICAL_SSE2
+#include <emmintrin.h>
+#endif
+
 NAMESPACE_MAGICAL
 
 const Quaternion Quaternion::Identity = Quaternion( 0.0f, 0.0f, 0.0f, 1.0f );
@@ -299,4 +303,165 @@ void Quaternion::inverse( Quaternion& out, const Quaternion& q )
 	out.z = - q.z * n;
 }
 
+void Quaternion::lerp( Quaternion& out, const Quaternion& q1, const Quaternion& q2, float t )
+{
+	out.x = q1.x + ( q2.x - q1.x ) * t;
+	out.y = q1.y + ( q2.y - q1.y ) * t;
+	out.z = q1.z + ( q2.z - q1.z ) * t;
+	out.w = q1.w + ( q2.w - q1.w ) * t;
+}
+
+void Quaternion::nlerp( Quaternion& out, const Quaternion& q1, const Quaternion& q2, float t )
+{
+	// 沿最短弧插值，点积为负时翻转q2
+	float s = Quaternion::dot( q1, q2 ) < 0.0f ? -t : t;
+	float r = 1.0f - t;
+
+	out.x = q1.x * r + q2.x * s;
+	out.y = q1.y * r + q2.y * s;
+	out.z = q1.z * r + q2.z * s;
+	out.w = q1.w * r + q2.w * s;
+
+	Quaternion::normalize( out, out );
+}
+
+void Quaternion::slerp( Quaternion& out, const Quaternion& q1, const Quaternion& q2, float t )
+{
+	if( t <= 0.0f )
+	{
+		out = q1;
+		return;
+	}
+
+	if( t >= 1.0f )
+	{
+		out = q2;
+		return;
+	}
+
+	float c = Quaternion::dot( q1, q2 );
+	float sign = 1.0f;
+	if( c < 0.0f )
+	{
+		c = -c;
+		sign = -1.0f;
+	}
+
+	// 夹角过小时sin趋近于0，退化为nlerp
+	if( c > 1.0f - Math::QuaternionEpsilon )
+	{
+		Quaternion::nlerp( out, q1, q2, t );
+		return;
+	}
+
+	float a = acosf( c );
+	float inv_sin = 1.0f / sinf( a );
+	float s1 = sinf( ( 1.0f - t ) * a ) * inv_sin;
+	float s2 = sinf( t * a ) * inv_sin * sign;
+
+	out.x = q1.x * s1 + q2.x * s2;
+	out.y = q1.y * s1 + q2.y * s2;
+	out.z = q1.z * s1 + q2.z * s2;
+	out.w = q1.w * s1 + q2.w * s2;
+}
+
+void Quaternion::nlerp( Quaternion* out, const Quaternion* q1, const Quaternion* q2, float t, size_t count )
+{
+	debugassert( out && q1 && q2, "should not be nullptr" );
+
+#ifdef MAGICAL_SSE2
+	const __m128 vt = _mm_set1_ps( t );
+	const __m128 vr = _mm_set1_ps( 1.0f - t );
+	const __m128 vsign = _mm_set1_ps( -0.0f );
+
+	for( size_t i = 0; i < count; ++i )
+	{
+		__m128 a = _mm_loadu_ps( &q1[i].x );
+		__m128 b = _mm_loadu_ps( &q2[i].x );
+
+		__m128 d = _mm_mul_ps( a, b );
+		d = _mm_add_ps( d, _mm_shuffle_ps( d, d, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		d = _mm_add_ps( d, _mm_shuffle_ps( d, d, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+		b = _mm_xor_ps( b, _mm_and_ps( d, vsign ) );
+
+		__m128 q = _mm_add_ps( _mm_mul_ps( a, vr ), _mm_mul_ps( b, vt ) );
+		__m128 l = _mm_mul_ps( q, q );
+		l = _mm_add_ps( l, _mm_shuffle_ps( l, l, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		l = _mm_add_ps( l, _mm_shuffle_ps( l, l, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+		_mm_storeu_ps( &out[i].x, _mm_div_ps( q, _mm_sqrt_ps( l ) ) );
+	}
+#else
+	for( size_t i = 0; i < count; ++i )
+	{
+		const Quaternion& a = q1[i];
+		const Quaternion& b = q2[i];
+
+		float s = ( a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w ) < 0.0f ? -t : t;
+		float r = 1.0f - t;
+
+		float x = a.x * r + b.x * s;
+		float y = a.y * r + b.y * s;
+		float z = a.z * r + b.z * s;
+		float w = a.w * r + b.w * s;
+		float n = 1.0f / sqrtf( x * x + y * y + z * z + w * w );
+
+		out[i].x = x * n;
+		out[i].y = y * n;
+		out[i].z = z * n;
+		out[i].w = w * n;
+	}
+#endif
+}
+
+void Quaternion::slerp( Quaternion* out, const Quaternion* q1, const Quaternion* q2, float t, size_t count )
+{
+	debugassert( out && q1 && q2, "should not be nullptr" );
+
+	// Eberly的无三角函数slerp近似，多项式系数只与t有关，可在整批数据上复用
+	// 参考 "A Fast and Accurate Algorithm for Computing SLERP"，单精度下误差在1e-4以内
+	static const float mu = 1.85298109240830f;
+	static const float u[8] = {
+		1.0f / ( 1 * 3 ), 1.0f / ( 2 * 5 ), 1.0f / ( 3 * 7 ), 1.0f / ( 4 * 9 ),
+		1.0f / ( 5 * 11 ), 1.0f / ( 6 * 13 ), 1.0f / ( 7 * 15 ), mu / ( 8 * 17 )
+	};
+	static const float v[8] = {
+		1.0f / 3, 2.0f / 5, 3.0f / 7, 4.0f / 9,
+		5.0f / 11, 6.0f / 13, 7.0f / 15, mu * 8 / 17
+	};
+
+	float d = 1.0f - t;
+	float ut[8], ud[8];
+	for( int k = 0; k < 8; ++k )
+	{
+		ut[k] = u[k] * t * t - v[k];
+		ud[k] = u[k] * d * d - v[k];
+	}
+
+	for( size_t i = 0; i < count; ++i )
+	{
+		const Quaternion& a = q1[i];
+		const Quaternion& b = q2[i];
+
+		float x = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+		float sign = x < 0.0f ? -1.0f : 1.0f;
+		float xm1 = x * sign - 1.0f;
+
+		float ct = 1.0f + ut[7] * xm1;
+		float cd = 1.0f + ud[7] * xm1;
+		for( int k = 6; k >= 0; --k )
+		{
+			ct = 1.0f + ut[k] * xm1 * ct;
+			cd = 1.0f + ud[k] * xm1 * cd;
+		}
+		ct *= t * sign;
+		cd *= d;
+
+		out[i].x = a.x * cd + b.x * ct;
+		out[i].y = a.y * cd + b.y * ct;
+		out[i].z = a.z * cd + b.z * ct;
+		out[i].w = a.w * cd + b.w * ct;
+	}
+}
+
 NAMESPACE_END
\ No newline at end of file
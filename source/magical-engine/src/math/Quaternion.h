@@ -128,6 +128,21 @@ public:
 	inline void negate( void );
 	inline void inverse( void );
 
+public:
+	static void lerp( Quaternion& out, const Quaternion& q1, const Quaternion& q2, float t );
+	static void nlerp( Quaternion& out, const Quaternion& q1, const Quaternion& q2, float t );
+	static void slerp( Quaternion& out, const Quaternion& q1, const Quaternion& q2, float t );
+	static inline Quaternion lerp( const Quaternion& q1, const Quaternion& q2, float t );
+	static inline Quaternion nlerp( const Quaternion& q1, const Quaternion& q2, float t );
+	static inline Quaternion slerp( const Quaternion& q1, const Quaternion& q2, float t );
+	inline Quaternion lerp( const Quaternion& q, float t ) const;
+	inline Quaternion nlerp( const Quaternion& q, float t ) const;
+	inline Quaternion slerp( const Quaternion& q, float t ) const;
+
+public:
+	static void nlerp( Quaternion* out, const Quaternion* q1, const Quaternion* q2, float t, size_t count );
+	static void slerp( Quaternion* out, const Quaternion* q1, const Quaternion* q2, float t, size_t count );
+
 public:
 	static inline float dot( const Quaternion& q1, const Quaternion& q2 );
 	static inline float length( const Quaternion& q );
@@ -384,6 +384,42 @@ inline void Quaternion::inverse( void )
 	Quaternion::inverse( *this, *this );
 }
 
+inline Quaternion Quaternion::lerp( const Quaternion& q1, const Quaternion& q2, float t )
+{
+	Quaternion dst;
+	Quaternion::lerp( dst, q1, q2, t );
+	return dst;
+}
+
+inline Quaternion Quaternion::nlerp( const Quaternion& q1, const Quaternion& q2, float t )
+{
+	Quaternion dst;
+	Quaternion::nlerp( dst, q1, q2, t );
+	return dst;
+}
+
+inline Quaternion Quaternion::slerp( const Quaternion& q1, const Quaternion& q2, float t )
+{
+	Quaternion dst;
+	Quaternion::slerp( dst, q1, q2, t );
+	return dst;
+}
+
+inline Quaternion Quaternion::lerp( const Quaternion& q, float t ) const
+{
+	return Quaternion::lerp( *this, q, t );
+}
+
+inline Quaternion Quaternion::nlerp( const Quaternion& q, float t ) const
+{
+	return Quaternion::nlerp( *this, q, t );
+}
+
+inline Quaternion Quaternion::slerp( const Quaternion& q, float t ) const
+{
+	return Quaternion::slerp( *this, q, t );
+}
+
 inline float Quaternion::dot( const Quaternion& q1, const Quaternion& q2 )
 {
 	return q1.w * q2.w + q1.x * q2.x + q1.y * q2.y + q1.z * q2.z;
@@ -36,14 +36,17 @@ struct Ray
 			float ox;
 			float oy;
 			float oz;
+		};
+		Vector3 origin;
+	};
+	union
+	{
+		struct {
 			float dx;
 			float dy;
 			float dz;
 		};
-		struct {
-			Vector3 origin;
-			Vector3 direction;
-		};
+		Vector3 direction;
 	};
 
 public:
@@ -35,13 +35,16 @@ struct Ray2
 		struct {
 			float ox;
 			float oy;
-			float dx;
-			float dy;
 		};
+		Vector2 origin;
+	};
+	union
+	{
 		struct {
-			Vector2 origin;
-			Vector2 direction;
+			float dx;
+			float dy;
 		};
+		Vector2 direction;
 	};
 
 public:
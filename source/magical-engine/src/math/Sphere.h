@@ -38,7 +38,7 @@ struct Sphere
 			float z;
 			float r;
 		};
-		struct { Vector3 center; float r; };
+		Vector3 center;
 	};
 
 public:
@@ -30,13 +30,13 @@ inline Sphere::Sphere( float x, float y, float z, float r )
 }
 
 inline Sphere::Sphere( const Vector3& center, float r ) 
-: center( center ), r( r )
+: x( center.x ), y( center.y ), z( center.z ), r( r )
 {
 	
 }
 
 inline Sphere::Sphere( const Sphere& sphere ) 
-: x( sphere.x ), y( sphere.y ), z( sphere.z ), r( r )
+: x( sphere.x ), y( sphere.y ), z( sphere.z ), r( sphere.r )
 {
 	
 }
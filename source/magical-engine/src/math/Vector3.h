@@ -37,7 +37,7 @@ struct Vector3
 			float y;
 			float z;
 		};
-		struct { Vector2 xy; float z; };
+		Vector2 xy;
 	};
 
 public:
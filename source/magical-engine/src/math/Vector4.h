@@ -36,11 +36,11 @@ struct Vector4
 			float x;
 			float y;
 			float z;
-			float w;
+			union { float w; float a; };
 		};
-		struct { Vector2 xy;  float z; float w; };
-		struct { Vector3 xyz; float w; };
-		struct { Vector3 axis; float a; };
+		Vector2 xy;
+		Vector3 xyz;
+		Vector3 axis;
 	};
 	
 public:
@@ -61,6 +61,7 @@ NAMESPACE_END
 #include "Quaternion.h"
 #include "Matrix3x3.h"
 #include "Matrix4x4.h"
+#include "Packed.h"
 
 #include "Vector2.inl"
 #include "Vector3.inl"
@@ -69,6 +70,7 @@ NAMESPACE_END
 #include "Quaternion.inl"
 #include "Matrix3x3.inl"
 #include "Matrix4x4.inl"
+#include "Packed.inl"
 
 #include "Ray2.h"
 #include "Box2.h"
@@ -36,6 +36,13 @@ SOFTWARE.
 #elif defined( MAC )
 #define MAGICAL_MACOS
 #define MAGICAL_PLATFORM "MAC-OS"
+#elif defined( __linux__ )
+#define MAGICAL_LINUX
+#define MAGICAL_PLATFORM "LINUX"
+#endif
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define MAGICAL_SSE2
 #endif
 
 #if !defined( MAGICALAPI )
@@ -55,6 +62,12 @@ SOFTWARE.
 	using namespace magical
 #endif
 
+#if defined( MAGICAL_WIN32 )
+#define MAGICAL_THREAD_LOCAL __declspec( thread )
+#else
+#define MAGICAL_THREAD_LOCAL __thread
+#endif
+
 #if defined( MAGICAL_WIN32 )
 #pragma execution_character_set( "utf-8" )
 #endif
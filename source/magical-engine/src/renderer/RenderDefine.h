@@ -28,7 +28,9 @@ SOFTWARE.
 #include "Common.h"
 
 #ifdef MAGICAL_USING_GL
-#ifdef MAGICAL_WIN32
+#if defined( MAGICAL_USING_NULL_GL )
+#include "null/NullGL.h"
+#elif defined( MAGICAL_WIN32 )
 #include "win32/gl/glew/glew.h"
 #endif
 
@@ -25,6 +25,8 @@ SOFTWARE.
 #include "Director.h"
 #include "Application.h"
 #include "Set.h"
+#include "Profiler.h"
+#include "Stats.h"
 
 #include "ShaderProgram.h"
 
@@ -34,6 +36,9 @@ static unsigned int _last_channel_index = ViewChannel::None;
 static Vector<RenderCommand*> _render_commands;
 static UnorderedSet<VertexBufferObject*> _vertex_buffer_objects;
 
+static Stat _stat_draw_calls( "renderer.draw_calls", Stat::Counter );
+static Stat _stat_vertices( "renderer.vertices", Stat::Counter );
+
 void Renderer::init( void )
 {
 	setDefault();
@@ -71,6 +76,8 @@ void Renderer::setDefault( void )
 
 void Renderer::render( unsigned int index, ViewChannel* channel )
 {
+	MAGICAL_PROFILE_SCOPE( "Renderer::render" );
+
 	if( index != _last_channel_index )
 	{
 		_last_channel_index = index;
@@ -122,6 +129,8 @@ void Renderer::deleteVertexBufferObject( VertexBufferObject* vbo )
 
 void Renderer::processCommands( void )
 {
+	MAGICAL_PROFILE_SCOPE( "Renderer::processCommands" );
+
 	for( auto& itr : _render_commands )
 	{
 		switch( itr->getFeature() )
@@ -137,6 +146,8 @@ void Renderer::processCommands( void )
 					program->use();
 					command->callPreDrawProcess();
 					glDrawArrays( (GLenum) shape, 0, (GLsizei) vbo->count() );
+					_stat_draw_calls.add();
+					_stat_vertices.add( vbo->count() );
 					vbo->unuse();
 
 					command->release();
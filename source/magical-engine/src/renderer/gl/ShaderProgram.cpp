@@ -22,9 +22,13 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 *******************************************************************************/
 #include "ShaderProgram.h"
+#include "Stats.h"
 
 NAMESPACE_MAGICAL
 
+static Stat _stat_program_binds( "renderer.program_binds", Stat::Counter );
+static Stat _stat_uniform_uploads( "renderer.uniform_uploads", Stat::Counter );
+
 ShaderProgram::ShaderProgram( void )
 : m_program( GL_ZERO )
 {
@@ -216,116 +220,139 @@ void ShaderProgram::use( void ) const
 	MAGICAL_ASSERT( isDone(), "Invalid!" );
 
 	glUseProgram( m_program );
+	_stat_program_binds.add();
 }
 
 void ShaderProgram::uniform1i( int location, Shader::int_t x )
 {
 	glUniform1i( location, x );
+	_stat_uniform_uploads.add();
 }
 
 void ShaderProgram::uniform2i( int location, Shader::int_t x, Shader::int_t y )
 {
 	glUniform2i( location, x, y );
+	_stat_uniform_uploads.add();
 }
 
 void ShaderProgram::uniform3i( int location, Shader::int_t x, Shader::int_t y, Shader::int_t z )
 {
 	glUniform3i( location, x, y, z );
+	_stat_uniform_uploads.add();
 }
 
 void ShaderProgram::uniform4i( int location, Shader::int_t x, Shader::int_t y, Shader::int_t z, Shader::int_t w )
 {
 	glUniform4i( location, x, y, z, w );
+	_stat_uniform_uploads.add();
 }
 
 void ShaderProgram::uniform1iv( int location, size_t count, const Shader::int_t* v )
 {
 	glUniform1iv( location, count, v );
+	_stat_uniform_uploads.add();
 }
 
 void ShaderProgram::uniform2iv( int location, size_t count, const Shader::int_t* v )
 {
 	glUniform2iv( location, count, v );
+	_stat_uniform_uploads.add();
 }
 
 void ShaderProgram::uniform3iv( int location, size_t count, const Shader::int_t* v )
 {
 	glUniform3iv( location, count, v );
+	_stat_uniform_uploads.add();
 }
 
 void ShaderProgram::uniform4iv( int location, size_t count, const Shader::int_t* v )
 {
 	glUniform4iv( location, count, v );
+	_stat_uniform_uploads.add();
 }
 
 void ShaderProgram::uniform1f( int location, Shader::float_t x )
 {
 	glUniform1f( location, x );
+	_stat_uniform_uploads.add();
 }
 
 void ShaderProgram::uniform2f( int location, Shader::float_t x, Shader::float_t y )
 {
 	glUniform2f( location, x, y );
+	_stat_uniform_uploads.add();
 }
 
 void ShaderProgram::uniform3f( int location, Shader::float_t x, Shader::float_t y, Shader::float_t z )
 {
 	glUniform3f( location, x, y, z );
+	_stat_uniform_uploads.add();
 }
 
 void ShaderProgram::uniform4f( int location, Shader::float_t x, Shader::float_t y, Shader::float_t z, Shader::float_t w )
 {
 	glUniform4f( location, x, y, z, w );
+	_stat_uniform_uploads.add();
 }
 
 void ShaderProgram::uniform1fv( int location, size_t count, const Shader::float_t* v )
 {
 	glUniform1fv( location, count, v );
+	_stat_uniform_uploads.add();
 }
 
 void ShaderProgram::uniform2fv( int location, size_t count, const Shader::float_t* v )
 {
 	glUniform2fv( location, count, v );
+	_stat_uniform_uploads.add();
 }
 
 void ShaderProgram::uniform3fv( int location, size_t count, const Shader::float_t* v )
 {
 	glUniform3fv( location, count, v );
+	_stat_uniform_uploads.add();
 }
 
 void ShaderProgram::uniform4fv( int location, size_t count, const Shader::float_t* v )
 { 
 	glUniform4fv( location, count, v );
+	_stat_uniform_uploads.add();
 }
 
 void ShaderProgram::uniform2x2f( int location, size_t count, bool transpose, const Shader::float_t* v )
 {
 	glUniformMatrix2fv( location, count, transpose, v );
+	_stat_uniform_uploads.add();
 }
 
 void ShaderProgram::uniform2x3f( int location, size_t count, bool transpose, const Shader::float_t* v )
 {
 	glUniformMatrix2x3fv( location, count, transpose, v );
+	_stat_uniform_uploads.add();
 }
 
 void ShaderProgram::uniform3x3f( int location, size_t count, bool transpose, const Shader::float_t* v )
 {
 	glUniformMatrix3fv( location, count, transpose, v );
+	_stat_uniform_uploads.add();
 }
 
 void ShaderProgram::uniform3x4f( int location, size_t count, bool transpose, const Shader::float_t* v )
 {
 	glUniformMatrix3x4fv( location, count, transpose, v );
+	_stat_uniform_uploads.add();
 }
 
 void ShaderProgram::uniform4x3f( int location, size_t count, bool transpose, const Shader::float_t* v )
 {
 	glUniformMatrix4x3fv( location, count, transpose, v );
+	_stat_uniform_uploads.add();
 }
 
 void ShaderProgram::uniform4x4f( int location, size_t count, bool transpose, const Shader::float_t* v )
 {
 	glUniformMatrix4fv( location, count, transpose, v );
+	_stat_uniform_uploads.add();
 }
 
 NAMESPACE_END
\ No newline at end of file
@@ -22,7 +22,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 *******************************************************************************/
 #include "ShaderProgramManager.h"
-#include "Assets.h"
+#include "AssetsCache.h"
 
 NAMESPACE_MAGICAL
 
@@ -113,8 +113,8 @@ static ShaderProgram* createProgram( ShaderProgramIndex index )
 	case kShaderProgram_Color:
 		{
 			program = new ShaderProgram();
-			vertex_data = Assets::loadFile( "standard/shaders/test_vertex.glsl" );
-			pixel_data = Assets::loadFile( "standard/shaders/test_fragment.glsl" );
+			vertex_data = AssetsCache::loadFile( "standard/shaders/test_vertex.glsl" );
+			pixel_data = AssetsCache::loadFile( "standard/shaders/test_fragment.glsl" );
 		}
 		break;
 	default:
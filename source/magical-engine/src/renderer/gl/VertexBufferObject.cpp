@@ -22,9 +22,12 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 *******************************************************************************/
 #include "VertexBufferObject.h"
+#include "Stats.h"
 
 NAMESPACE_MAGICAL
 
+static Stat _stat_vbo_binds( "renderer.vbo_binds", Stat::Counter );
+
 VertexBufferObject::VertexBufferObject( void )
 {
 	/*
@@ -485,6 +488,7 @@ void VertexBufferObject::use( void )
 				{
 					MAGICAL_ASSERT( itr.second->finish, "Invalid! not finish" );
 					glBindBuffer( GL_ARRAY_BUFFER, itr.second->vbo );
+					_stat_vbo_binds.add();
 					glEnableVertexAttribArray( itr.second->index );
 					glVertexAttribPointer( (GLuint)itr.second->index, (GLint)itr.second->size, (GLenum)itr.second->type, (GLboolean)itr.second->normalized, 0, 0 );
 				}
@@ -497,6 +501,7 @@ void VertexBufferObject::use( void )
 				MAGICAL_ASSERT( m_combine_vertex_buf->finish, "Invalid! not finish" );
 
 				glBindBuffer( GL_ARRAY_BUFFER, m_combine_vertex_buf->vbo );
+				_stat_vbo_binds.add();
 				for( auto& itr : m_vertex_bufs )
 				{
 					glEnableVertexAttribArray( itr.second->index );
@@ -0,0 +1,165 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "NullGL.h"
+#include <string.h>
+#include <vector>
+#include <unordered_map>
+
+static std::unordered_map<GLuint, std::vector<char>> _buffers;
+static GLuint _bound_array_buffer = 0;
+static GLuint _next_id = 1;
+
+static std::vector<char>* boundBuffer( GLenum target )
+{
+	if( target != GL_ARRAY_BUFFER || _bound_array_buffer == 0 )
+		return nullptr;
+
+	auto itr = _buffers.find( _bound_array_buffer );
+	return itr != _buffers.end() ? &itr->second : nullptr;
+}
+
+GLenum glGetError( void ) { return GL_NO_ERROR; }
+void glEnable( GLenum cap ) {}
+void glClearColor( GLclampf r, GLclampf g, GLclampf b, GLclampf a ) {}
+void glClear( GLbitfield mask ) {}
+void glViewport( GLint x, GLint y, GLsizei width, GLsizei height ) {}
+void glDrawArrays( GLenum mode, GLint first, GLsizei count ) {}
+
+void glGenBuffers( GLsizei n, GLuint* buffers )
+{
+	for( GLsizei i = 0; i < n; ++i )
+	{
+		buffers[i] = _next_id ++;
+		_buffers[ buffers[i] ];
+	}
+}
+
+void glDeleteBuffers( GLsizei n, const GLuint* buffers )
+{
+	for( GLsizei i = 0; i < n; ++i )
+	{
+		if( buffers[i] == _bound_array_buffer )
+			_bound_array_buffer = 0;
+		_buffers.erase( buffers[i] );
+	}
+}
+
+void glBindBuffer( GLenum target, GLuint buffer )
+{
+	if( target == GL_ARRAY_BUFFER )
+		_bound_array_buffer = buffer;
+}
+
+void glBufferData( GLenum target, GLsizeiptr size, const GLvoid* data, GLenum usage )
+{
+	std::vector<char>* buffer = boundBuffer( target );
+	if( buffer == nullptr )
+		return;
+
+	buffer->assign( (size_t) size, 0 );
+	if( data && size > 0 )
+		memcpy( buffer->data(), data, (size_t) size );
+}
+
+void glBufferSubData( GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid* data )
+{
+	std::vector<char>* buffer = boundBuffer( target );
+	if( buffer == nullptr || data == nullptr || offset + size > (GLintptr) buffer->size() )
+		return;
+
+	memcpy( buffer->data() + offset, data, (size_t) size );
+}
+
+GLvoid* glMapBuffer( GLenum target, GLenum access )
+{
+	std::vector<char>* buffer = boundBuffer( target );
+	return buffer && !buffer->empty() ? buffer->data() : nullptr;
+}
+
+GLboolean glUnmapBuffer( GLenum target ) { return GL_TRUE; }
+void glEnableVertexAttribArray( GLuint index ) {}
+void glDisableVertexAttribArray( GLuint index ) {}
+void glVertexAttribPointer( GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid* pointer ) {}
+
+GLuint glCreateShader( GLenum type ) { return _next_id ++; }
+void glDeleteShader( GLuint shader ) {}
+void glShaderSource( GLuint shader, GLsizei count, const GLchar** string, const GLint* length ) {}
+void glCompileShader( GLuint shader ) {}
+
+void glGetShaderiv( GLuint shader, GLenum pname, GLint* params )
+{
+	*params = pname == GL_INFO_LOG_LENGTH ? 0 : GL_TRUE;
+}
+
+void glGetShaderInfoLog( GLuint shader, GLsizei size, GLsizei* length, GLchar* log )
+{
+	if( length )
+		*length = 0;
+	if( log && size > 0 )
+		log[0] = 0;
+}
+
+GLuint glCreateProgram( void ) { return _next_id ++; }
+void glDeleteProgram( GLuint program ) {}
+GLboolean glIsProgram( GLuint program ) { return program != 0 ? GL_TRUE : GL_FALSE; }
+void glAttachShader( GLuint program, GLuint shader ) {}
+void glBindAttribLocation( GLuint program, GLuint index, const GLchar* name ) {}
+void glLinkProgram( GLuint program ) {}
+void glValidateProgram( GLuint program ) {}
+
+void glGetProgramiv( GLuint program, GLenum pname, GLint* params )
+{
+	*params = pname == GL_INFO_LOG_LENGTH ? 0 : GL_TRUE;
+}
+
+void glGetProgramInfoLog( GLuint program, GLsizei size, GLsizei* length, GLchar* log )
+{
+	glGetShaderInfoLog( program, size, length, log );
+}
+
+void glUseProgram( GLuint program ) {}
+GLint glGetUniformLocation( GLuint program, const GLchar* name ) { return 0; }
+
+void glUniform1i( GLint location, GLint x ) {}
+void glUniform2i( GLint location, GLint x, GLint y ) {}
+void glUniform3i( GLint location, GLint x, GLint y, GLint z ) {}
+void glUniform4i( GLint location, GLint x, GLint y, GLint z, GLint w ) {}
+void glUniform1iv( GLint location, GLsizei count, const GLint* v ) {}
+void glUniform2iv( GLint location, GLsizei count, const GLint* v ) {}
+void glUniform3iv( GLint location, GLsizei count, const GLint* v ) {}
+void glUniform4iv( GLint location, GLsizei count, const GLint* v ) {}
+void glUniform1f( GLint location, GLfloat x ) {}
+void glUniform2f( GLint location, GLfloat x, GLfloat y ) {}
+void glUniform3f( GLint location, GLfloat x, GLfloat y, GLfloat z ) {}
+void glUniform4f( GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w ) {}
+void glUniform1fv( GLint location, GLsizei count, const GLfloat* v ) {}
+void glUniform2fv( GLint location, GLsizei count, const GLfloat* v ) {}
+void glUniform3fv( GLint location, GLsizei count, const GLfloat* v ) {}
+void glUniform4fv( GLint location, GLsizei count, const GLfloat* v ) {}
+void glUniformMatrix2fv( GLint location, GLsizei count, GLboolean transpose, const GLfloat* v ) {}
+void glUniformMatrix2x3fv( GLint location, GLsizei count, GLboolean transpose, const GLfloat* v ) {}
+void glUniformMatrix3fv( GLint location, GLsizei count, GLboolean transpose, const GLfloat* v ) {}
+void glUniformMatrix3x4fv( GLint location, GLsizei count, GLboolean transpose, const GLfloat* v ) {}
+void glUniformMatrix4x3fv( GLint location, GLsizei count, GLboolean transpose, const GLfloat* v ) {}
+void glUniformMatrix4fv( GLint location, GLsizei count, GLboolean transpose, const GLfloat* v ) {}
\ No newline at end of file
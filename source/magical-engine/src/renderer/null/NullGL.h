@@ -0,0 +1,142 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __NULL_GL_H__
+#define __NULL_GL_H__
+
+#include <stddef.h>
+
+/*
+空的OpenGL实现，定义MAGICAL_USING_NULL_GL时代替glew，用于无窗口的性能测试
+
+只实现引擎用到的函数：缓冲对象的数据保存在内存中以支持glMapBuffer，
+shader和program总是编译链接成功，其余调用直接返回
+*/
+typedef unsigned int GLenum;
+typedef unsigned int GLbitfield;
+typedef unsigned int GLuint;
+typedef int GLint;
+typedef int GLsizei;
+typedef unsigned char GLboolean;
+typedef char GLchar;
+typedef float GLfloat;
+typedef float GLclampf;
+typedef void GLvoid;
+typedef ptrdiff_t GLintptr;
+typedef ptrdiff_t GLsizeiptr;
+
+#define GL_ZERO 0
+#define GL_FALSE 0
+#define GL_TRUE 1
+#define GL_NO_ERROR 0
+
+#define GL_TRIANGLES 0x0004
+#define GL_TRIANGLE_STRIP 0x0005
+#define GL_QUADS 0x0007
+#define GL_POLYGON 0x0009
+
+#define GL_BYTE 0x1400
+#define GL_UNSIGNED_BYTE 0x1401
+#define GL_INT 0x1404
+#define GL_UNSIGNED_INT 0x1405
+#define GL_FLOAT 0x1406
+#define GL_BOOL 0x8B56
+
+#define GL_DEPTH_BUFFER_BIT 0x00000100
+#define GL_COLOR_BUFFER_BIT 0x00004000
+#define GL_CULL_FACE 0x0B44
+#define GL_DEPTH_TEST 0x0B71
+#define GL_VERSION 0x1F02
+
+#define GL_ARRAY_BUFFER 0x8892
+#define GL_WRITE_ONLY 0x88B9
+#define GL_STATIC_DRAW 0x88E4
+#define GL_DYNAMIC_DRAW 0x88E8
+
+#define GL_FRAGMENT_SHADER 0x8B30
+#define GL_VERTEX_SHADER 0x8B31
+#define GL_COMPILE_STATUS 0x8B81
+#define GL_LINK_STATUS 0x8B82
+#define GL_VALIDATE_STATUS 0x8B83
+#define GL_INFO_LOG_LENGTH 0x8B84
+
+GLenum glGetError( void );
+void glEnable( GLenum cap );
+void glClearColor( GLclampf r, GLclampf g, GLclampf b, GLclampf a );
+void glClear( GLbitfield mask );
+void glViewport( GLint x, GLint y, GLsizei width, GLsizei height );
+void glDrawArrays( GLenum mode, GLint first, GLsizei count );
+
+void glGenBuffers( GLsizei n, GLuint* buffers );
+void glDeleteBuffers( GLsizei n, const GLuint* buffers );
+void glBindBuffer( GLenum target, GLuint buffer );
+void glBufferData( GLenum target, GLsizeiptr size, const GLvoid* data, GLenum usage );
+void glBufferSubData( GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid* data );
+GLvoid* glMapBuffer( GLenum target, GLenum access );
+GLboolean glUnmapBuffer( GLenum target );
+void glEnableVertexAttribArray( GLuint index );
+void glDisableVertexAttribArray( GLuint index );
+void glVertexAttribPointer( GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid* pointer );
+
+GLuint glCreateShader( GLenum type );
+void glDeleteShader( GLuint shader );
+void glShaderSource( GLuint shader, GLsizei count, const GLchar** string, const GLint* length );
+void glCompileShader( GLuint shader );
+void glGetShaderiv( GLuint shader, GLenum pname, GLint* params );
+void glGetShaderInfoLog( GLuint shader, GLsizei size, GLsizei* length, GLchar* log );
+GLuint glCreateProgram( void );
+void glDeleteProgram( GLuint program );
+GLboolean glIsProgram( GLuint program );
+void glAttachShader( GLuint program, GLuint shader );
+void glBindAttribLocation( GLuint program, GLuint index, const GLchar* name );
+void glLinkProgram( GLuint program );
+void glValidateProgram( GLuint program );
+void glGetProgramiv( GLuint program, GLenum pname, GLint* params );
+void glGetProgramInfoLog( GLuint program, GLsizei size, GLsizei* length, GLchar* log );
+void glUseProgram( GLuint program );
+GLint glGetUniformLocation( GLuint program, const GLchar* name );
+
+void glUniform1i( GLint location, GLint x );
+void glUniform2i( GLint location, GLint x, GLint y );
+void glUniform3i( GLint location, GLint x, GLint y, GLint z );
+void glUniform4i( GLint location, GLint x, GLint y, GLint z, GLint w );
+void glUniform1iv( GLint location, GLsizei count, const GLint* v );
+void glUniform2iv( GLint location, GLsizei count, const GLint* v );
+void glUniform3iv( GLint location, GLsizei count, const GLint* v );
+void glUniform4iv( GLint location, GLsizei count, const GLint* v );
+void glUniform1f( GLint location, GLfloat x );
+void glUniform2f( GLint location, GLfloat x, GLfloat y );
+void glUniform3f( GLint location, GLfloat x, GLfloat y, GLfloat z );
+void glUniform4f( GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w );
+void glUniform1fv( GLint location, GLsizei count, const GLfloat* v );
+void glUniform2fv( GLint location, GLsizei count, const GLfloat* v );
+void glUniform3fv( GLint location, GLsizei count, const GLfloat* v );
+void glUniform4fv( GLint location, GLsizei count, const GLfloat* v );
+void glUniformMatrix2fv( GLint location, GLsizei count, GLboolean transpose, const GLfloat* v );
+void glUniformMatrix2x3fv( GLint location, GLsizei count, GLboolean transpose, const GLfloat* v );
+void glUniformMatrix3fv( GLint location, GLsizei count, GLboolean transpose, const GLfloat* v );
+void glUniformMatrix3x4fv( GLint location, GLsizei count, GLboolean transpose, const GLfloat* v );
+void glUniformMatrix4x3fv( GLint location, GLsizei count, GLboolean transpose, const GLfloat* v );
+void glUniformMatrix4fv( GLint location, GLsizei count, GLboolean transpose, const GLfloat* v );
+
+#endif //__NULL_GL_H__
\ No newline at end of file
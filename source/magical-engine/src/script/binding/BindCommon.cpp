@@ -16,6 +16,8 @@ TOLUA_API int  tolua_common_open (lua_State* tolua_S);
 #include "BindCommon.h"
 #include "tolua_ext.h"
 #include "magical-engine.h"
+#include "LuaValuePool.h"
+#include "BindMath.h"
 
 /* function to release collected object via destructor */
 #ifdef __cplusplus
@@ -23,7 +25,7 @@ TOLUA_API int  tolua_common_open (lua_State* tolua_S);
 static int tolua_collect_Quaternion (lua_State* tolua_S)
 {
  Quaternion* self = (Quaternion*) tolua_tousertype(tolua_S,1,0);
-	Mtolua_delete(self);
+	Mtolua_pool_delete(self);
 	return 0;
 }
 
@@ -37,28 +39,28 @@ static int tolua_collect_Data (lua_State* tolua_S)
 static int tolua_collect_Vector4 (lua_State* tolua_S)
 {
  Vector4* self = (Vector4*) tolua_tousertype(tolua_S,1,0);
-	Mtolua_delete(self);
+	Mtolua_pool_delete(self);
 	return 0;
 }
 
 static int tolua_collect_EulerAngles (lua_State* tolua_S)
 {
  EulerAngles* self = (EulerAngles*) tolua_tousertype(tolua_S,1,0);
-	Mtolua_delete(self);
+	Mtolua_pool_delete(self);
 	return 0;
 }
 
 static int tolua_collect_Vector2 (lua_State* tolua_S)
 {
  Vector2* self = (Vector2*) tolua_tousertype(tolua_S,1,0);
-	Mtolua_delete(self);
+	Mtolua_pool_delete(self);
 	return 0;
 }
 
 static int tolua_collect_Vector3 (lua_State* tolua_S)
 {
  Vector3* self = (Vector3*) tolua_tousertype(tolua_S,1,0);
-	Mtolua_delete(self);
+	Mtolua_pool_delete(self);
 	return 0;
 }
 
@@ -72,14 +74,14 @@ static int tolua_collect_Transform (lua_State* tolua_S)
 static int tolua_collect_Matrix4 (lua_State* tolua_S)
 {
  Matrix4* self = (Matrix4*) tolua_tousertype(tolua_S,1,0);
-	Mtolua_delete(self);
+	Mtolua_pool_delete(self);
 	return 0;
 }
 
 static int tolua_collect_AxisAngle (lua_State* tolua_S)
 {
  AxisAngle* self = (AxisAngle*) tolua_tousertype(tolua_S,1,0);
-	Mtolua_delete(self);
+	Mtolua_pool_delete(self);
 	return 0;
 }
 #endif
@@ -2644,7 +2646,7 @@ static int tolua_common_AxisAngle_new00(lua_State* tolua_S)
   float z = ((float)  tolua_tonumber(tolua_S,4,0));
   float w = ((float)  tolua_tonumber(tolua_S,5,0));
   {
-   AxisAngle* tolua_ret = (AxisAngle*)  Mtolua_new((AxisAngle)(x,y,z,w));
+   AxisAngle* tolua_ret = (AxisAngle*)  Mtolua_pool_new((AxisAngle)(x,y,z,w));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"AxisAngle");
   }
  }
@@ -2680,7 +2682,7 @@ static int tolua_common_AxisAngle_new00_local(lua_State* tolua_S)
   float z = ((float)  tolua_tonumber(tolua_S,4,0));
   float w = ((float)  tolua_tonumber(tolua_S,5,0));
   {
-   AxisAngle* tolua_ret = (AxisAngle*)  Mtolua_new((AxisAngle)(x,y,z,w));
+   AxisAngle* tolua_ret = (AxisAngle*)  Mtolua_pool_new((AxisAngle)(x,y,z,w));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"AxisAngle");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
   }
@@ -2711,7 +2713,7 @@ static int tolua_common_AxisAngle_new01(lua_State* tolua_S)
   const Vector3* axis = ((const Vector3*)  tolua_tousertype(tolua_S,2,0));
   float angle = ((float)  tolua_tonumber(tolua_S,3,0));
   {
-   AxisAngle* tolua_ret = (AxisAngle*)  Mtolua_new((AxisAngle)(*axis,angle));
+   AxisAngle* tolua_ret = (AxisAngle*)  Mtolua_pool_new((AxisAngle)(*axis,angle));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"AxisAngle");
   }
  }
@@ -2738,7 +2740,7 @@ static int tolua_common_AxisAngle_new01_local(lua_State* tolua_S)
   const Vector3* axis = ((const Vector3*)  tolua_tousertype(tolua_S,2,0));
   float angle = ((float)  tolua_tonumber(tolua_S,3,0));
   {
-   AxisAngle* tolua_ret = (AxisAngle*)  Mtolua_new((AxisAngle)(*axis,angle));
+   AxisAngle* tolua_ret = (AxisAngle*)  Mtolua_pool_new((AxisAngle)(*axis,angle));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"AxisAngle");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
   }
@@ -2764,7 +2766,7 @@ static int tolua_common_AxisAngle_new02(lua_State* tolua_S)
  {
   const AxisAngle* aa = ((const AxisAngle*)  tolua_tousertype(tolua_S,2,0));
   {
-   AxisAngle* tolua_ret = (AxisAngle*)  Mtolua_new((AxisAngle)(*aa));
+   AxisAngle* tolua_ret = (AxisAngle*)  Mtolua_pool_new((AxisAngle)(*aa));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"AxisAngle");
   }
  }
@@ -2789,7 +2791,7 @@ static int tolua_common_AxisAngle_new02_local(lua_State* tolua_S)
  {
   const AxisAngle* aa = ((const AxisAngle*)  tolua_tousertype(tolua_S,2,0));
   {
-   AxisAngle* tolua_ret = (AxisAngle*)  Mtolua_new((AxisAngle)(*aa));
+   AxisAngle* tolua_ret = (AxisAngle*)  Mtolua_pool_new((AxisAngle)(*aa));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"AxisAngle");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
   }
@@ -2813,7 +2815,7 @@ static int tolua_common_AxisAngle_new03(lua_State* tolua_S)
  else
  {
   {
-   AxisAngle* tolua_ret = (AxisAngle*)  Mtolua_new((AxisAngle)());
+   AxisAngle* tolua_ret = (AxisAngle*)  Mtolua_pool_new((AxisAngle)());
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"AxisAngle");
   }
  }
@@ -2836,7 +2838,7 @@ static int tolua_common_AxisAngle_new03_local(lua_State* tolua_S)
  else
  {
   {
-   AxisAngle* tolua_ret = (AxisAngle*)  Mtolua_new((AxisAngle)());
+   AxisAngle* tolua_ret = (AxisAngle*)  Mtolua_pool_new((AxisAngle)());
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"AxisAngle");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
   }
@@ -2865,7 +2867,7 @@ static int tolua_common_AxisAngle_delete00(lua_State* tolua_S)
 #ifdef MAGICAL_DEBUG
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'delete'", NULL);
 #endif
-  Mtolua_delete(self);
+  Mtolua_pool_delete(self);
  }
  return 0;
 #ifdef MAGICAL_DEBUG
@@ -2898,7 +2900,7 @@ static int tolua_common_AxisAngle_create00(lua_State* tolua_S)
    AxisAngle tolua_ret = (AxisAngle)  AxisAngle::create(*axis,angle);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((AxisAngle)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((AxisAngle)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"AxisAngle");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -2936,7 +2938,7 @@ static int tolua_common_AxisAngle_createIdentity00(lua_State* tolua_S)
    AxisAngle tolua_ret = (AxisAngle)  AxisAngle::createIdentity();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((AxisAngle)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((AxisAngle)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"AxisAngle");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -2974,7 +2976,7 @@ static int tolua_common_AxisAngle_createZero00(lua_State* tolua_S)
    AxisAngle tolua_ret = (AxisAngle)  AxisAngle::createZero();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((AxisAngle)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((AxisAngle)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"AxisAngle");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -3014,7 +3016,7 @@ static int tolua_common_AxisAngle_createFromQuaternion00(lua_State* tolua_S)
    AxisAngle tolua_ret = (AxisAngle)  AxisAngle::createFromQuaternion(*q);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((AxisAngle)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((AxisAngle)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"AxisAngle");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -3385,7 +3387,7 @@ static int tolua_common_AxisAngle_toQuaternion00(lua_State* tolua_S)
    Quaternion tolua_ret = (Quaternion)  self->toQuaternion();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Quaternion)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Quaternion)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Quaternion");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -3427,7 +3429,7 @@ static int tolua_common_AxisAngle_axis00(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->axis();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -3591,7 +3593,7 @@ static int tolua_common_EulerAngles_new00(lua_State* tolua_S)
   float pitch = ((float)  tolua_tonumber(tolua_S,3,0));
   float roll = ((float)  tolua_tonumber(tolua_S,4,0));
   {
-   EulerAngles* tolua_ret = (EulerAngles*)  Mtolua_new((EulerAngles)(yaw,pitch,roll));
+   EulerAngles* tolua_ret = (EulerAngles*)  Mtolua_pool_new((EulerAngles)(yaw,pitch,roll));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"EulerAngles");
   }
  }
@@ -3625,7 +3627,7 @@ static int tolua_common_EulerAngles_new00_local(lua_State* tolua_S)
   float pitch = ((float)  tolua_tonumber(tolua_S,3,0));
   float roll = ((float)  tolua_tonumber(tolua_S,4,0));
   {
-   EulerAngles* tolua_ret = (EulerAngles*)  Mtolua_new((EulerAngles)(yaw,pitch,roll));
+   EulerAngles* tolua_ret = (EulerAngles*)  Mtolua_pool_new((EulerAngles)(yaw,pitch,roll));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"EulerAngles");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
   }
@@ -3654,7 +3656,7 @@ static int tolua_common_EulerAngles_new01(lua_State* tolua_S)
  {
   const EulerAngles* ea = ((const EulerAngles*)  tolua_tousertype(tolua_S,2,0));
   {
-   EulerAngles* tolua_ret = (EulerAngles*)  Mtolua_new((EulerAngles)(*ea));
+   EulerAngles* tolua_ret = (EulerAngles*)  Mtolua_pool_new((EulerAngles)(*ea));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"EulerAngles");
   }
  }
@@ -3679,7 +3681,7 @@ static int tolua_common_EulerAngles_new01_local(lua_State* tolua_S)
  {
   const EulerAngles* ea = ((const EulerAngles*)  tolua_tousertype(tolua_S,2,0));
   {
-   EulerAngles* tolua_ret = (EulerAngles*)  Mtolua_new((EulerAngles)(*ea));
+   EulerAngles* tolua_ret = (EulerAngles*)  Mtolua_pool_new((EulerAngles)(*ea));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"EulerAngles");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
   }
@@ -3703,7 +3705,7 @@ static int tolua_common_EulerAngles_new02(lua_State* tolua_S)
  else
  {
   {
-   EulerAngles* tolua_ret = (EulerAngles*)  Mtolua_new((EulerAngles)());
+   EulerAngles* tolua_ret = (EulerAngles*)  Mtolua_pool_new((EulerAngles)());
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"EulerAngles");
   }
  }
@@ -3726,7 +3728,7 @@ static int tolua_common_EulerAngles_new02_local(lua_State* tolua_S)
  else
  {
   {
-   EulerAngles* tolua_ret = (EulerAngles*)  Mtolua_new((EulerAngles)());
+   EulerAngles* tolua_ret = (EulerAngles*)  Mtolua_pool_new((EulerAngles)());
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"EulerAngles");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
   }
@@ -3755,7 +3757,7 @@ static int tolua_common_EulerAngles_delete00(lua_State* tolua_S)
 #ifdef MAGICAL_DEBUG
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'delete'", NULL);
 #endif
-  Mtolua_delete(self);
+  Mtolua_pool_delete(self);
  }
  return 0;
 #ifdef MAGICAL_DEBUG
@@ -3784,7 +3786,7 @@ static int tolua_common_EulerAngles_createZero00(lua_State* tolua_S)
    EulerAngles tolua_ret = (EulerAngles)  EulerAngles::createZero();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((EulerAngles)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((EulerAngles)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"EulerAngles");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -3824,7 +3826,7 @@ static int tolua_common_EulerAngles_createFromQuaternion00(lua_State* tolua_S)
    EulerAngles tolua_ret = (EulerAngles)  EulerAngles::createFromQuaternion(*q);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((EulerAngles)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((EulerAngles)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"EulerAngles");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -4131,7 +4133,7 @@ static int tolua_common_EulerAngles__add00(lua_State* tolua_S)
    EulerAngles tolua_ret = (EulerAngles)  self->operator+(*ea);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((EulerAngles)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((EulerAngles)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"EulerAngles");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -4175,7 +4177,7 @@ static int tolua_common_EulerAngles__sub00(lua_State* tolua_S)
    EulerAngles tolua_ret = (EulerAngles)  self->operator-(*ea);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((EulerAngles)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((EulerAngles)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"EulerAngles");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -4219,7 +4221,7 @@ static int tolua_common_EulerAngles__mul00(lua_State* tolua_S)
    EulerAngles tolua_ret = (EulerAngles)  self->operator*(*ea);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((EulerAngles)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((EulerAngles)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"EulerAngles");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -4261,7 +4263,7 @@ static int tolua_common_EulerAngles__mul01(lua_State* tolua_S)
    EulerAngles tolua_ret = (EulerAngles)  self->operator*(a);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((EulerAngles)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((EulerAngles)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"EulerAngles");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -4434,7 +4436,7 @@ static int tolua_common_EulerAngles_toQuaternion00(lua_State* tolua_S)
    Quaternion tolua_ret = (Quaternion)  self->toQuaternion();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Quaternion)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Quaternion)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Quaternion");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -4502,7 +4504,7 @@ static int tolua_common_EulerAngles_getLimited00(lua_State* tolua_S)
    EulerAngles tolua_ret = (EulerAngles)  self->getLimited();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((EulerAngles)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((EulerAngles)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"EulerAngles");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -5091,7 +5093,7 @@ static int tolua_common_Matrix4_new00(lua_State* tolua_S)
   float m43 = ((float)  tolua_tonumber(tolua_S,16,0));
   float m44 = ((float)  tolua_tonumber(tolua_S,17,0));
   {
-   Matrix4* tolua_ret = (Matrix4*)  Mtolua_new((Matrix4)(m11,m12,m13,m14,m21,m22,m23,m24,m31,m32,m33,m34,m41,m42,m43,m44));
+   Matrix4* tolua_ret = (Matrix4*)  Mtolua_pool_new((Matrix4)(m11,m12,m13,m14,m21,m22,m23,m24,m31,m32,m33,m34,m41,m42,m43,m44));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Matrix4");
   }
  }
@@ -5151,7 +5153,7 @@ static int tolua_common_Matrix4_new00_local(lua_State* tolua_S)
   float m43 = ((float)  tolua_tonumber(tolua_S,16,0));
   float m44 = ((float)  tolua_tonumber(tolua_S,17,0));
   {
-   Matrix4* tolua_ret = (Matrix4*)  Mtolua_new((Matrix4)(m11,m12,m13,m14,m21,m22,m23,m24,m31,m32,m33,m34,m41,m42,m43,m44));
+   Matrix4* tolua_ret = (Matrix4*)  Mtolua_pool_new((Matrix4)(m11,m12,m13,m14,m21,m22,m23,m24,m31,m32,m33,m34,m41,m42,m43,m44));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Matrix4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
   }
@@ -5180,7 +5182,7 @@ static int tolua_common_Matrix4_new01(lua_State* tolua_S)
  {
   const Matrix4* m = ((const Matrix4*)  tolua_tousertype(tolua_S,2,0));
   {
-   Matrix4* tolua_ret = (Matrix4*)  Mtolua_new((Matrix4)(*m));
+   Matrix4* tolua_ret = (Matrix4*)  Mtolua_pool_new((Matrix4)(*m));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Matrix4");
   }
  }
@@ -5205,7 +5207,7 @@ static int tolua_common_Matrix4_new01_local(lua_State* tolua_S)
  {
   const Matrix4* m = ((const Matrix4*)  tolua_tousertype(tolua_S,2,0));
   {
-   Matrix4* tolua_ret = (Matrix4*)  Mtolua_new((Matrix4)(*m));
+   Matrix4* tolua_ret = (Matrix4*)  Mtolua_pool_new((Matrix4)(*m));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Matrix4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
   }
@@ -5229,7 +5231,7 @@ static int tolua_common_Matrix4_new02(lua_State* tolua_S)
  else
  {
   {
-   Matrix4* tolua_ret = (Matrix4*)  Mtolua_new((Matrix4)());
+   Matrix4* tolua_ret = (Matrix4*)  Mtolua_pool_new((Matrix4)());
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Matrix4");
   }
  }
@@ -5252,7 +5254,7 @@ static int tolua_common_Matrix4_new02_local(lua_State* tolua_S)
  else
  {
   {
-   Matrix4* tolua_ret = (Matrix4*)  Mtolua_new((Matrix4)());
+   Matrix4* tolua_ret = (Matrix4*)  Mtolua_pool_new((Matrix4)());
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Matrix4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
   }
@@ -5281,7 +5283,7 @@ static int tolua_common_Matrix4_delete00(lua_State* tolua_S)
 #ifdef MAGICAL_DEBUG
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'delete'", NULL);
 #endif
-  Mtolua_delete(self);
+  Mtolua_pool_delete(self);
  }
  return 0;
 #ifdef MAGICAL_DEBUG
@@ -5310,7 +5312,7 @@ static int tolua_common_Matrix4_createIdentity00(lua_State* tolua_S)
    Matrix4 tolua_ret = (Matrix4)  Matrix4::createIdentity();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Matrix4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Matrix4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Matrix4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -5348,7 +5350,7 @@ static int tolua_common_Matrix4_createZero00(lua_State* tolua_S)
    Matrix4 tolua_ret = (Matrix4)  Matrix4::createZero();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Matrix4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Matrix4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Matrix4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -5392,7 +5394,7 @@ static int tolua_common_Matrix4_createTRS00(lua_State* tolua_S)
    Matrix4 tolua_ret = (Matrix4)  Matrix4::createTRS(*t,*r,*s);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Matrix4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Matrix4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Matrix4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -6007,7 +6009,7 @@ static int tolua_common_Matrix4__mul00(lua_State* tolua_S)
    Matrix4 tolua_ret = (Matrix4)  self->operator*(a);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Matrix4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Matrix4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Matrix4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -6049,7 +6051,7 @@ static int tolua_common_Matrix4__mul01(lua_State* tolua_S)
    Matrix4 tolua_ret = (Matrix4)  self->operator*(*m);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Matrix4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Matrix4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Matrix4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -6756,7 +6758,7 @@ static int tolua_common_Matrix4_getUpVector01(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->getUpVector();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -6793,7 +6795,7 @@ static int tolua_common_Matrix4_getDownVector01(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->getDownVector();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -6830,7 +6832,7 @@ static int tolua_common_Matrix4_getLeftVector01(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->getLeftVector();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -6867,7 +6869,7 @@ static int tolua_common_Matrix4_getRightVector01(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->getRightVector();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -6904,7 +6906,7 @@ static int tolua_common_Matrix4_getForwardVector01(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->getForwardVector();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -6941,7 +6943,7 @@ static int tolua_common_Matrix4_getBackVector01(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->getBackVector();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -7043,7 +7045,7 @@ static int tolua_common_Matrix4_getTranslation01(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->getTranslation();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -7080,7 +7082,7 @@ static int tolua_common_Matrix4_getScale01(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->getScale();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -7117,7 +7119,7 @@ static int tolua_common_Matrix4_getRotationQuaternion01(lua_State* tolua_S)
    Quaternion tolua_ret = (Quaternion)  self->getRotationQuaternion();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Quaternion)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Quaternion)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Quaternion");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -7269,7 +7271,7 @@ static int tolua_common_Matrix4_getTransposed00(lua_State* tolua_S)
    Matrix4 tolua_ret = (Matrix4)  self->getTransposed();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Matrix4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Matrix4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Matrix4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -7311,7 +7313,7 @@ static int tolua_common_Matrix4_getNegated00(lua_State* tolua_S)
    Matrix4 tolua_ret = (Matrix4)  self->getNegated();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Matrix4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Matrix4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Matrix4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -7363,6 +7365,72 @@ static int tolua_common_Matrix4_determinant00(lua_State* tolua_S)
 }
 #endif //#ifndef TOLUA_DISABLE
 
+/* method: Matrix4_mulInPlace of class  Matrix4 */
+#ifndef TOLUA_DISABLE_tolua_common_Matrix4_mulInPlace00
+static int tolua_common_Matrix4_mulInPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Matrix4",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Matrix4",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Matrix4* self = (Matrix4*)  tolua_tousertype(tolua_S,1,0);
+  const Matrix4* m = ((const Matrix4*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Matrix4_mulInPlace'", NULL);
+#endif
+  {
+   Matrix4_mulInPlace(self,*m);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'mulInPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+/* method: Matrix4_mulScalarInPlace of class  Matrix4 */
+#ifndef TOLUA_DISABLE_tolua_common_Matrix4_mulScalarInPlace00
+static int tolua_common_Matrix4_mulScalarInPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Matrix4",0,&tolua_err) ||
+     !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Matrix4* self = (Matrix4*)  tolua_tousertype(tolua_S,1,0);
+  float a = ((float)  tolua_tonumber(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Matrix4_mulScalarInPlace'", NULL);
+#endif
+  {
+   Matrix4_mulScalarInPlace(self,a);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'mulScalarInPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
 /* get function: x of class  Quaternion */
 #ifndef TOLUA_DISABLE_tolua_get_Quaternion_x
 static int tolua_get_Quaternion_x(lua_State* tolua_S)
@@ -7548,7 +7616,7 @@ static int tolua_common_Quaternion_new00(lua_State* tolua_S)
   float z = ((float)  tolua_tonumber(tolua_S,4,0));
   float w = ((float)  tolua_tonumber(tolua_S,5,0));
   {
-   Quaternion* tolua_ret = (Quaternion*)  Mtolua_new((Quaternion)(x,y,z,w));
+   Quaternion* tolua_ret = (Quaternion*)  Mtolua_pool_new((Quaternion)(x,y,z,w));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Quaternion");
   }
  }
@@ -7584,7 +7652,7 @@ static int tolua_common_Quaternion_new00_local(lua_State* tolua_S)
   float z = ((float)  tolua_tonumber(tolua_S,4,0));
   float w = ((float)  tolua_tonumber(tolua_S,5,0));
   {
-   Quaternion* tolua_ret = (Quaternion*)  Mtolua_new((Quaternion)(x,y,z,w));
+   Quaternion* tolua_ret = (Quaternion*)  Mtolua_pool_new((Quaternion)(x,y,z,w));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Quaternion");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
   }
@@ -7613,7 +7681,7 @@ static int tolua_common_Quaternion_new01(lua_State* tolua_S)
  {
   const Quaternion* q = ((const Quaternion*)  tolua_tousertype(tolua_S,2,0));
   {
-   Quaternion* tolua_ret = (Quaternion*)  Mtolua_new((Quaternion)(*q));
+   Quaternion* tolua_ret = (Quaternion*)  Mtolua_pool_new((Quaternion)(*q));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Quaternion");
   }
  }
@@ -7638,7 +7706,7 @@ static int tolua_common_Quaternion_new01_local(lua_State* tolua_S)
  {
   const Quaternion* q = ((const Quaternion*)  tolua_tousertype(tolua_S,2,0));
   {
-   Quaternion* tolua_ret = (Quaternion*)  Mtolua_new((Quaternion)(*q));
+   Quaternion* tolua_ret = (Quaternion*)  Mtolua_pool_new((Quaternion)(*q));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Quaternion");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
   }
@@ -7662,7 +7730,7 @@ static int tolua_common_Quaternion_new02(lua_State* tolua_S)
  else
  {
   {
-   Quaternion* tolua_ret = (Quaternion*)  Mtolua_new((Quaternion)());
+   Quaternion* tolua_ret = (Quaternion*)  Mtolua_pool_new((Quaternion)());
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Quaternion");
   }
  }
@@ -7685,7 +7753,7 @@ static int tolua_common_Quaternion_new02_local(lua_State* tolua_S)
  else
  {
   {
-   Quaternion* tolua_ret = (Quaternion*)  Mtolua_new((Quaternion)());
+   Quaternion* tolua_ret = (Quaternion*)  Mtolua_pool_new((Quaternion)());
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Quaternion");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
   }
@@ -7714,7 +7782,7 @@ static int tolua_common_Quaternion_delete00(lua_State* tolua_S)
 #ifdef MAGICAL_DEBUG
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'delete'", NULL);
 #endif
-  Mtolua_delete(self);
+  Mtolua_pool_delete(self);
  }
  return 0;
 #ifdef MAGICAL_DEBUG
@@ -7743,7 +7811,7 @@ static int tolua_common_Quaternion_createIdentity00(lua_State* tolua_S)
    Quaternion tolua_ret = (Quaternion)  Quaternion::createIdentity();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Quaternion)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Quaternion)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Quaternion");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -7781,7 +7849,7 @@ static int tolua_common_Quaternion_createZero00(lua_State* tolua_S)
    Quaternion tolua_ret = (Quaternion)  Quaternion::createZero();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Quaternion)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Quaternion)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Quaternion");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -7821,7 +7889,7 @@ static int tolua_common_Quaternion_createRotationX00(lua_State* tolua_S)
    Quaternion tolua_ret = (Quaternion)  Quaternion::createRotationX(angle);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Quaternion)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Quaternion)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Quaternion");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -7861,7 +7929,7 @@ static int tolua_common_Quaternion_createRotationY00(lua_State* tolua_S)
    Quaternion tolua_ret = (Quaternion)  Quaternion::createRotationY(angle);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Quaternion)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Quaternion)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Quaternion");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -7901,7 +7969,7 @@ static int tolua_common_Quaternion_createRotationZ00(lua_State* tolua_S)
    Quaternion tolua_ret = (Quaternion)  Quaternion::createRotationZ(angle);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Quaternion)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Quaternion)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Quaternion");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -7941,7 +8009,7 @@ static int tolua_common_Quaternion_createFromAxisAngle00(lua_State* tolua_S)
    Quaternion tolua_ret = (Quaternion)  Quaternion::createFromAxisAngle(*aa);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Quaternion)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Quaternion)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Quaternion");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -7981,7 +8049,7 @@ static int tolua_common_Quaternion_createFromAxisAngle01(lua_State* tolua_S)
    Quaternion tolua_ret = (Quaternion)  Quaternion::createFromAxisAngle(*axis,angle);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Quaternion)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Quaternion)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Quaternion");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -8018,7 +8086,7 @@ static int tolua_common_Quaternion_createFromEulerAngles00(lua_State* tolua_S)
    Quaternion tolua_ret = (Quaternion)  Quaternion::createFromEulerAngles(*ea);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Quaternion)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Quaternion)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Quaternion");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -8060,7 +8128,7 @@ static int tolua_common_Quaternion_createFromEulerAngles01(lua_State* tolua_S)
    Quaternion tolua_ret = (Quaternion)  Quaternion::createFromEulerAngles(yaw,pitch,roll);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Quaternion)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Quaternion)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Quaternion");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -8554,7 +8622,7 @@ static int tolua_common_Quaternion__add00(lua_State* tolua_S)
    Quaternion tolua_ret = (Quaternion)  self->operator+(*q);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Quaternion)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Quaternion)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Quaternion");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -8598,7 +8666,7 @@ static int tolua_common_Quaternion__sub00(lua_State* tolua_S)
    Quaternion tolua_ret = (Quaternion)  self->operator-(*q);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Quaternion)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Quaternion)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Quaternion");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -8642,7 +8710,7 @@ static int tolua_common_Quaternion__mul00(lua_State* tolua_S)
    Quaternion tolua_ret = (Quaternion)  self->operator*(a);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Quaternion)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Quaternion)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Quaternion");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -8684,7 +8752,7 @@ static int tolua_common_Quaternion__mul01(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->operator*(*v);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -8723,7 +8791,7 @@ static int tolua_common_Quaternion__mul02(lua_State* tolua_S)
    Quaternion tolua_ret = (Quaternion)  self->operator*(*q);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Quaternion)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Quaternion)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Quaternion");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -9058,7 +9126,7 @@ static int tolua_common_Quaternion_toAxisAngle00(lua_State* tolua_S)
    AxisAngle tolua_ret = (AxisAngle)  self->toAxisAngle();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((AxisAngle)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((AxisAngle)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"AxisAngle");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -9165,7 +9233,7 @@ static int tolua_common_Quaternion_toEulerAngles00(lua_State* tolua_S)
    EulerAngles tolua_ret = (EulerAngles)  self->toEulerAngles();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((EulerAngles)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((EulerAngles)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"EulerAngles");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -9311,7 +9379,7 @@ static int tolua_common_Quaternion_getNormalized00(lua_State* tolua_S)
    Quaternion tolua_ret = (Quaternion)  self->getNormalized();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Quaternion)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Quaternion)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Quaternion");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -9353,7 +9421,7 @@ static int tolua_common_Quaternion_getConjugated00(lua_State* tolua_S)
    Quaternion tolua_ret = (Quaternion)  self->getConjugated();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Quaternion)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Quaternion)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Quaternion");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -9395,7 +9463,7 @@ static int tolua_common_Quaternion_getNegated00(lua_State* tolua_S)
    Quaternion tolua_ret = (Quaternion)  self->getNegated();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Quaternion)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Quaternion)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Quaternion");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -9437,7 +9505,7 @@ static int tolua_common_Quaternion_getInversed00(lua_State* tolua_S)
    Quaternion tolua_ret = (Quaternion)  self->getInversed();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Quaternion)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Quaternion)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Quaternion");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -9555,6 +9623,138 @@ static int tolua_common_Quaternion_lengthSq00(lua_State* tolua_S)
 }
 #endif //#ifndef TOLUA_DISABLE
 
+/* method: Quaternion_addInPlace of class  Quaternion */
+#ifndef TOLUA_DISABLE_tolua_common_Quaternion_addInPlace00
+static int tolua_common_Quaternion_addInPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Quaternion",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Quaternion",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Quaternion* self = (Quaternion*)  tolua_tousertype(tolua_S,1,0);
+  const Quaternion* q = ((const Quaternion*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Quaternion_addInPlace'", NULL);
+#endif
+  {
+   Quaternion_addInPlace(self,*q);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'addInPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+/* method: Quaternion_subInPlace of class  Quaternion */
+#ifndef TOLUA_DISABLE_tolua_common_Quaternion_subInPlace00
+static int tolua_common_Quaternion_subInPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Quaternion",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Quaternion",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Quaternion* self = (Quaternion*)  tolua_tousertype(tolua_S,1,0);
+  const Quaternion* q = ((const Quaternion*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Quaternion_subInPlace'", NULL);
+#endif
+  {
+   Quaternion_subInPlace(self,*q);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'subInPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+/* method: Quaternion_mulInPlace of class  Quaternion */
+#ifndef TOLUA_DISABLE_tolua_common_Quaternion_mulInPlace00
+static int tolua_common_Quaternion_mulInPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Quaternion",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Quaternion",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Quaternion* self = (Quaternion*)  tolua_tousertype(tolua_S,1,0);
+  const Quaternion* q = ((const Quaternion*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Quaternion_mulInPlace'", NULL);
+#endif
+  {
+   Quaternion_mulInPlace(self,*q);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'mulInPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+/* method: Quaternion_mulScalarInPlace of class  Quaternion */
+#ifndef TOLUA_DISABLE_tolua_common_Quaternion_mulScalarInPlace00
+static int tolua_common_Quaternion_mulScalarInPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Quaternion",0,&tolua_err) ||
+     !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Quaternion* self = (Quaternion*)  tolua_tousertype(tolua_S,1,0);
+  float a = ((float)  tolua_tonumber(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Quaternion_mulScalarInPlace'", NULL);
+#endif
+  {
+   Quaternion_mulScalarInPlace(self,a);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'mulScalarInPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
 /* get function: x of class  Vector2 */
 #ifndef TOLUA_DISABLE_tolua_get_Vector2_x
 static int tolua_get_Vector2_x(lua_State* tolua_S)
@@ -9712,7 +9912,7 @@ static int tolua_common_Vector2_new00(lua_State* tolua_S)
   float x = ((float)  tolua_tonumber(tolua_S,2,0));
   float y = ((float)  tolua_tonumber(tolua_S,3,0));
   {
-   Vector2* tolua_ret = (Vector2*)  Mtolua_new((Vector2)(x,y));
+   Vector2* tolua_ret = (Vector2*)  Mtolua_pool_new((Vector2)(x,y));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Vector2");
   }
  }
@@ -9744,7 +9944,7 @@ static int tolua_common_Vector2_new00_local(lua_State* tolua_S)
   float x = ((float)  tolua_tonumber(tolua_S,2,0));
   float y = ((float)  tolua_tonumber(tolua_S,3,0));
   {
-   Vector2* tolua_ret = (Vector2*)  Mtolua_new((Vector2)(x,y));
+   Vector2* tolua_ret = (Vector2*)  Mtolua_pool_new((Vector2)(x,y));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Vector2");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
   }
@@ -9773,7 +9973,7 @@ static int tolua_common_Vector2_new01(lua_State* tolua_S)
  {
   const Vector2* v = ((const Vector2*)  tolua_tousertype(tolua_S,2,0));
   {
-   Vector2* tolua_ret = (Vector2*)  Mtolua_new((Vector2)(*v));
+   Vector2* tolua_ret = (Vector2*)  Mtolua_pool_new((Vector2)(*v));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Vector2");
   }
  }
@@ -9798,7 +9998,7 @@ static int tolua_common_Vector2_new01_local(lua_State* tolua_S)
  {
   const Vector2* v = ((const Vector2*)  tolua_tousertype(tolua_S,2,0));
   {
-   Vector2* tolua_ret = (Vector2*)  Mtolua_new((Vector2)(*v));
+   Vector2* tolua_ret = (Vector2*)  Mtolua_pool_new((Vector2)(*v));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Vector2");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
   }
@@ -9822,7 +10022,7 @@ static int tolua_common_Vector2_new02(lua_State* tolua_S)
  else
  {
   {
-   Vector2* tolua_ret = (Vector2*)  Mtolua_new((Vector2)());
+   Vector2* tolua_ret = (Vector2*)  Mtolua_pool_new((Vector2)());
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Vector2");
   }
  }
@@ -9845,7 +10045,7 @@ static int tolua_common_Vector2_new02_local(lua_State* tolua_S)
  else
  {
   {
-   Vector2* tolua_ret = (Vector2*)  Mtolua_new((Vector2)());
+   Vector2* tolua_ret = (Vector2*)  Mtolua_pool_new((Vector2)());
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Vector2");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
   }
@@ -9874,7 +10074,7 @@ static int tolua_common_Vector2_delete00(lua_State* tolua_S)
 #ifdef MAGICAL_DEBUG
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'delete'", NULL);
 #endif
-  Mtolua_delete(self);
+  Mtolua_pool_delete(self);
  }
  return 0;
 #ifdef MAGICAL_DEBUG
@@ -9903,7 +10103,7 @@ static int tolua_common_Vector2_createZero00(lua_State* tolua_S)
    Vector2 tolua_ret = (Vector2)  Vector2::createZero();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector2)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector2)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector2");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -9941,7 +10141,7 @@ static int tolua_common_Vector2_createOne00(lua_State* tolua_S)
    Vector2 tolua_ret = (Vector2)  Vector2::createOne();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector2)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector2)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector2");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -9981,7 +10181,7 @@ static int tolua_common_Vector2_createFromVector300(lua_State* tolua_S)
    Vector2 tolua_ret = (Vector2)  Vector2::createFromVector3(*v);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector2)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector2)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector2");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -10021,7 +10221,7 @@ static int tolua_common_Vector2_createFromVector400(lua_State* tolua_S)
    Vector2 tolua_ret = (Vector2)  Vector2::createFromVector4(*v);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector2)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector2)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector2");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -10720,7 +10920,7 @@ static int tolua_common_Vector2__add00(lua_State* tolua_S)
    Vector2 tolua_ret = (Vector2)  self->operator+();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector2)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector2)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector2");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -10762,7 +10962,7 @@ static int tolua_common_Vector2__add01(lua_State* tolua_S)
    Vector2 tolua_ret = (Vector2)  self->operator+(a);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector2)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector2)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector2");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -10801,7 +11001,7 @@ static int tolua_common_Vector2__add02(lua_State* tolua_S)
    Vector2 tolua_ret = (Vector2)  self->operator+(*v);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector2)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector2)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector2");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -10840,7 +11040,7 @@ static int tolua_common_Vector2__sub00(lua_State* tolua_S)
    Vector2 tolua_ret = (Vector2)  self->operator-();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector2)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector2)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector2");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -10882,7 +11082,7 @@ static int tolua_common_Vector2__sub01(lua_State* tolua_S)
    Vector2 tolua_ret = (Vector2)  self->operator-(a);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector2)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector2)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector2");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -10921,7 +11121,7 @@ static int tolua_common_Vector2__sub02(lua_State* tolua_S)
    Vector2 tolua_ret = (Vector2)  self->operator-(*v);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector2)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector2)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector2");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -10962,7 +11162,7 @@ static int tolua_common_Vector2__mul00(lua_State* tolua_S)
    Vector2 tolua_ret = (Vector2)  self->operator*(a);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector2)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector2)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector2");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -11004,7 +11204,7 @@ static int tolua_common_Vector2__mul01(lua_State* tolua_S)
    Vector2 tolua_ret = (Vector2)  self->operator*(*v);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector2)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector2)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector2");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -11045,7 +11245,7 @@ static int tolua_common_Vector2__div00(lua_State* tolua_S)
    Vector2 tolua_ret = (Vector2)  self->operator/(a);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector2)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector2)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector2");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -11087,7 +11287,7 @@ static int tolua_common_Vector2__div01(lua_State* tolua_S)
    Vector2 tolua_ret = (Vector2)  self->operator/(*v);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector2)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector2)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector2");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -11464,7 +11664,7 @@ static int tolua_common_Vector2_getClamped00(lua_State* tolua_S)
    Vector2 tolua_ret = (Vector2)  self->getClamped(*min,*max);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector2)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector2)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector2");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -11506,7 +11706,7 @@ static int tolua_common_Vector2_getNegated00(lua_State* tolua_S)
    Vector2 tolua_ret = (Vector2)  self->getNegated();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector2)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector2)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector2");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -11548,7 +11748,7 @@ static int tolua_common_Vector2_getNormalized00(lua_State* tolua_S)
    Vector2 tolua_ret = (Vector2)  self->getNormalized();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector2)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector2)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector2");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -11592,7 +11792,7 @@ static int tolua_common_Vector2_getRotated00(lua_State* tolua_S)
    Vector2 tolua_ret = (Vector2)  self->getRotated(angle);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector2)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector2)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector2");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -11636,7 +11836,7 @@ static int tolua_common_Vector2_getScaled00(lua_State* tolua_S)
    Vector2 tolua_ret = (Vector2)  self->getScaled(s);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector2)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector2)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector2");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -11912,7 +12112,7 @@ static int tolua_common_Vector2_midPointBetween01(lua_State* tolua_S)
    Vector2 tolua_ret = (Vector2)  self->midPointBetween(*v);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector2)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector2)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector2");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -11951,7 +12151,7 @@ static int tolua_common_Vector2_project01(lua_State* tolua_S)
    Vector2 tolua_ret = (Vector2)  self->project(*n);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector2)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector2)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector2");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -12175,7 +12375,7 @@ static int tolua_common_Vector3_new00(lua_State* tolua_S)
   float y = ((float)  tolua_tonumber(tolua_S,3,0));
   float z = ((float)  tolua_tonumber(tolua_S,4,0));
   {
-   Vector3* tolua_ret = (Vector3*)  Mtolua_new((Vector3)(x,y,z));
+   Vector3* tolua_ret = (Vector3*)  Mtolua_pool_new((Vector3)(x,y,z));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Vector3");
   }
  }
@@ -12209,7 +12409,7 @@ static int tolua_common_Vector3_new00_local(lua_State* tolua_S)
   float y = ((float)  tolua_tonumber(tolua_S,3,0));
   float z = ((float)  tolua_tonumber(tolua_S,4,0));
   {
-   Vector3* tolua_ret = (Vector3*)  Mtolua_new((Vector3)(x,y,z));
+   Vector3* tolua_ret = (Vector3*)  Mtolua_pool_new((Vector3)(x,y,z));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
   }
@@ -12238,7 +12438,7 @@ static int tolua_common_Vector3_new01(lua_State* tolua_S)
  {
   const Vector3* v = ((const Vector3*)  tolua_tousertype(tolua_S,2,0));
   {
-   Vector3* tolua_ret = (Vector3*)  Mtolua_new((Vector3)(*v));
+   Vector3* tolua_ret = (Vector3*)  Mtolua_pool_new((Vector3)(*v));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Vector3");
   }
  }
@@ -12263,7 +12463,7 @@ static int tolua_common_Vector3_new01_local(lua_State* tolua_S)
  {
   const Vector3* v = ((const Vector3*)  tolua_tousertype(tolua_S,2,0));
   {
-   Vector3* tolua_ret = (Vector3*)  Mtolua_new((Vector3)(*v));
+   Vector3* tolua_ret = (Vector3*)  Mtolua_pool_new((Vector3)(*v));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
   }
@@ -12287,7 +12487,7 @@ static int tolua_common_Vector3_new02(lua_State* tolua_S)
  else
  {
   {
-   Vector3* tolua_ret = (Vector3*)  Mtolua_new((Vector3)());
+   Vector3* tolua_ret = (Vector3*)  Mtolua_pool_new((Vector3)());
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Vector3");
   }
  }
@@ -12310,7 +12510,7 @@ static int tolua_common_Vector3_new02_local(lua_State* tolua_S)
  else
  {
   {
-   Vector3* tolua_ret = (Vector3*)  Mtolua_new((Vector3)());
+   Vector3* tolua_ret = (Vector3*)  Mtolua_pool_new((Vector3)());
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
   }
@@ -12339,7 +12539,7 @@ static int tolua_common_Vector3_delete00(lua_State* tolua_S)
 #ifdef MAGICAL_DEBUG
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'delete'", NULL);
 #endif
-  Mtolua_delete(self);
+  Mtolua_pool_delete(self);
  }
  return 0;
 #ifdef MAGICAL_DEBUG
@@ -12368,7 +12568,7 @@ static int tolua_common_Vector3_createZero00(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  Vector3::createZero();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -12406,7 +12606,7 @@ static int tolua_common_Vector3_createOne00(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  Vector3::createOne();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -12446,7 +12646,7 @@ static int tolua_common_Vector3_createFromVector200(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  Vector3::createFromVector2(*v);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -12486,7 +12686,7 @@ static int tolua_common_Vector3_createFromVector400(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  Vector3::createFromVector4(*v);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -13218,7 +13418,7 @@ static int tolua_common_Vector3__add00(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->operator+();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -13260,7 +13460,7 @@ static int tolua_common_Vector3__add01(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->operator+(a);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -13299,7 +13499,7 @@ static int tolua_common_Vector3__add02(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->operator+(*v);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -13338,7 +13538,7 @@ static int tolua_common_Vector3__sub00(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->operator-();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -13380,7 +13580,7 @@ static int tolua_common_Vector3__sub01(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->operator-(a);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -13419,7 +13619,7 @@ static int tolua_common_Vector3__sub02(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->operator-(*v);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -13460,7 +13660,7 @@ static int tolua_common_Vector3__mul00(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->operator*(*m);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -13502,7 +13702,7 @@ static int tolua_common_Vector3__mul01(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->operator*(a);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -13541,7 +13741,7 @@ static int tolua_common_Vector3__mul02(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->operator*(*v);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -13582,7 +13782,7 @@ static int tolua_common_Vector3__div00(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->operator/(a);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -13624,7 +13824,7 @@ static int tolua_common_Vector3__div01(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->operator/(*v);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -13975,7 +14175,7 @@ static int tolua_common_Vector3_getClamped00(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->getClamped(*min,*max);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -14017,7 +14217,7 @@ static int tolua_common_Vector3_getNegated00(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->getNegated();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -14059,7 +14259,7 @@ static int tolua_common_Vector3_getNormalized00(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->getNormalized();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -14103,7 +14303,7 @@ static int tolua_common_Vector3_getScaled00(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->getScaled(s);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -14345,7 +14545,7 @@ static int tolua_common_Vector3_cross01(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->cross(*v);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -14384,7 +14584,7 @@ static int tolua_common_Vector3_midPointBetween01(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->midPointBetween(*v);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -14423,7 +14623,7 @@ static int tolua_common_Vector3_project01(lua_State* tolua_S)
    Vector3 tolua_ret = (Vector3)  self->project(*n);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector3)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -14440,6 +14640,237 @@ tolua_lerror:
 }
 #endif //#ifndef TOLUA_DISABLE
 
+/* method: Vector3_addInPlace of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_common_Vector3_addInPlace00
+static int tolua_common_Vector3_addInPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Vector3",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Vector3",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Vector3* self = (Vector3*)  tolua_tousertype(tolua_S,1,0);
+  const Vector3* v = ((const Vector3*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Vector3_addInPlace'", NULL);
+#endif
+  {
+   Vector3_addInPlace(self,*v);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'addInPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+/* method: Vector3_subInPlace of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_common_Vector3_subInPlace00
+static int tolua_common_Vector3_subInPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Vector3",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Vector3",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Vector3* self = (Vector3*)  tolua_tousertype(tolua_S,1,0);
+  const Vector3* v = ((const Vector3*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Vector3_subInPlace'", NULL);
+#endif
+  {
+   Vector3_subInPlace(self,*v);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'subInPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+/* method: Vector3_mulInPlace of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_common_Vector3_mulInPlace00
+static int tolua_common_Vector3_mulInPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Vector3",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Vector3",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Vector3* self = (Vector3*)  tolua_tousertype(tolua_S,1,0);
+  const Vector3* v = ((const Vector3*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Vector3_mulInPlace'", NULL);
+#endif
+  {
+   Vector3_mulInPlace(self,*v);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'mulInPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+/* method: Vector3_mulScalarInPlace of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_common_Vector3_mulScalarInPlace00
+static int tolua_common_Vector3_mulScalarInPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Vector3",0,&tolua_err) ||
+     !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Vector3* self = (Vector3*)  tolua_tousertype(tolua_S,1,0);
+  float a = ((float)  tolua_tonumber(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Vector3_mulScalarInPlace'", NULL);
+#endif
+  {
+   Vector3_mulScalarInPlace(self,a);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'mulScalarInPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+/* method: Vector3_mulMatrix4InPlace of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_common_Vector3_mulMatrix4InPlace00
+static int tolua_common_Vector3_mulMatrix4InPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Vector3",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Matrix4",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Vector3* self = (Vector3*)  tolua_tousertype(tolua_S,1,0);
+  const Matrix4* m = ((const Matrix4*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Vector3_mulMatrix4InPlace'", NULL);
+#endif
+  {
+   Vector3_mulMatrix4InPlace(self,*m);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'mulMatrix4InPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+/* method: Vector3_rotateInPlace of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_common_Vector3_rotateInPlace00
+static int tolua_common_Vector3_rotateInPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Vector3",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Quaternion",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Vector3* self = (Vector3*)  tolua_tousertype(tolua_S,1,0);
+  const Quaternion* q = ((const Quaternion*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Vector3_rotateInPlace'", NULL);
+#endif
+  {
+   Vector3_rotateInPlace(self,*q);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'rotateInPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+/* method: Vector3_crossInPlace of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_common_Vector3_crossInPlace00
+static int tolua_common_Vector3_crossInPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Vector3",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Vector3",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Vector3* self = (Vector3*)  tolua_tousertype(tolua_S,1,0);
+  const Vector3* v = ((const Vector3*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Vector3_crossInPlace'", NULL);
+#endif
+  {
+   Vector3_crossInPlace(self,*v);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'crossInPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
 /* get function: x of class  Vector4 */
 #ifndef TOLUA_DISABLE_tolua_get_Vector4_x
 static int tolua_get_Vector4_x(lua_State* tolua_S)
@@ -14706,7 +15137,7 @@ static int tolua_common_Vector4_new00(lua_State* tolua_S)
   float z = ((float)  tolua_tonumber(tolua_S,4,0));
   float w = ((float)  tolua_tonumber(tolua_S,5,0));
   {
-   Vector4* tolua_ret = (Vector4*)  Mtolua_new((Vector4)(x,y,z,w));
+   Vector4* tolua_ret = (Vector4*)  Mtolua_pool_new((Vector4)(x,y,z,w));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Vector4");
   }
  }
@@ -14742,7 +15173,7 @@ static int tolua_common_Vector4_new00_local(lua_State* tolua_S)
   float z = ((float)  tolua_tonumber(tolua_S,4,0));
   float w = ((float)  tolua_tonumber(tolua_S,5,0));
   {
-   Vector4* tolua_ret = (Vector4*)  Mtolua_new((Vector4)(x,y,z,w));
+   Vector4* tolua_ret = (Vector4*)  Mtolua_pool_new((Vector4)(x,y,z,w));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Vector4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
   }
@@ -14771,7 +15202,7 @@ static int tolua_common_Vector4_new01(lua_State* tolua_S)
  {
   const Vector4* v = ((const Vector4*)  tolua_tousertype(tolua_S,2,0));
   {
-   Vector4* tolua_ret = (Vector4*)  Mtolua_new((Vector4)(*v));
+   Vector4* tolua_ret = (Vector4*)  Mtolua_pool_new((Vector4)(*v));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Vector4");
   }
  }
@@ -14796,7 +15227,7 @@ static int tolua_common_Vector4_new01_local(lua_State* tolua_S)
  {
   const Vector4* v = ((const Vector4*)  tolua_tousertype(tolua_S,2,0));
   {
-   Vector4* tolua_ret = (Vector4*)  Mtolua_new((Vector4)(*v));
+   Vector4* tolua_ret = (Vector4*)  Mtolua_pool_new((Vector4)(*v));
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Vector4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
   }
@@ -14820,7 +15251,7 @@ static int tolua_common_Vector4_new02(lua_State* tolua_S)
  else
  {
   {
-   Vector4* tolua_ret = (Vector4*)  Mtolua_new((Vector4)());
+   Vector4* tolua_ret = (Vector4*)  Mtolua_pool_new((Vector4)());
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Vector4");
   }
  }
@@ -14843,7 +15274,7 @@ static int tolua_common_Vector4_new02_local(lua_State* tolua_S)
  else
  {
   {
-   Vector4* tolua_ret = (Vector4*)  Mtolua_new((Vector4)());
+   Vector4* tolua_ret = (Vector4*)  Mtolua_pool_new((Vector4)());
     tolua_pushusertype(tolua_S,(void*)tolua_ret,"Vector4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
   }
@@ -14872,7 +15303,7 @@ static int tolua_common_Vector4_delete00(lua_State* tolua_S)
 #ifdef MAGICAL_DEBUG
   if (!self) tolua_error(tolua_S,"invalid 'self' in function 'delete'", NULL);
 #endif
-  Mtolua_delete(self);
+  Mtolua_pool_delete(self);
  }
  return 0;
 #ifdef MAGICAL_DEBUG
@@ -14901,7 +15332,7 @@ static int tolua_common_Vector4_createZero00(lua_State* tolua_S)
    Vector4 tolua_ret = (Vector4)  Vector4::createZero();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -14939,7 +15370,7 @@ static int tolua_common_Vector4_createOne00(lua_State* tolua_S)
    Vector4 tolua_ret = (Vector4)  Vector4::createOne();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -14979,7 +15410,7 @@ static int tolua_common_Vector4_createFromVector200(lua_State* tolua_S)
    Vector4 tolua_ret = (Vector4)  Vector4::createFromVector2(*v);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -15019,7 +15450,7 @@ static int tolua_common_Vector4_createFromVector300(lua_State* tolua_S)
    Vector4 tolua_ret = (Vector4)  Vector4::createFromVector3(*v);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -15718,7 +16149,7 @@ static int tolua_common_Vector4__add00(lua_State* tolua_S)
    Vector4 tolua_ret = (Vector4)  self->operator+();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -15760,7 +16191,7 @@ static int tolua_common_Vector4__add01(lua_State* tolua_S)
    Vector4 tolua_ret = (Vector4)  self->operator+(a);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -15799,7 +16230,7 @@ static int tolua_common_Vector4__add02(lua_State* tolua_S)
    Vector4 tolua_ret = (Vector4)  self->operator+(*v);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -15838,7 +16269,7 @@ static int tolua_common_Vector4__sub00(lua_State* tolua_S)
    Vector4 tolua_ret = (Vector4)  self->operator-();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -15880,7 +16311,7 @@ static int tolua_common_Vector4__sub01(lua_State* tolua_S)
    Vector4 tolua_ret = (Vector4)  self->operator-(a);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -15919,7 +16350,7 @@ static int tolua_common_Vector4__sub02(lua_State* tolua_S)
    Vector4 tolua_ret = (Vector4)  self->operator-(*v);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -15960,7 +16391,7 @@ static int tolua_common_Vector4__mul00(lua_State* tolua_S)
    Vector4 tolua_ret = (Vector4)  self->operator*(*m);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -16002,7 +16433,7 @@ static int tolua_common_Vector4__mul01(lua_State* tolua_S)
    Vector4 tolua_ret = (Vector4)  self->operator*(a);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -16041,7 +16472,7 @@ static int tolua_common_Vector4__mul02(lua_State* tolua_S)
    Vector4 tolua_ret = (Vector4)  self->operator*(*v);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -16082,7 +16513,7 @@ static int tolua_common_Vector4__div00(lua_State* tolua_S)
    Vector4 tolua_ret = (Vector4)  self->operator/(a);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -16124,7 +16555,7 @@ static int tolua_common_Vector4__div01(lua_State* tolua_S)
    Vector4 tolua_ret = (Vector4)  self->operator/(*v);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -16477,7 +16908,7 @@ static int tolua_common_Vector4_getClamped00(lua_State* tolua_S)
    Vector4 tolua_ret = (Vector4)  self->getClamped(*min,*max);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -16519,7 +16950,7 @@ static int tolua_common_Vector4_getNegated00(lua_State* tolua_S)
    Vector4 tolua_ret = (Vector4)  self->getNegated();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -16561,7 +16992,7 @@ static int tolua_common_Vector4_getNormalized00(lua_State* tolua_S)
    Vector4 tolua_ret = (Vector4)  self->getNormalized();
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -16605,7 +17036,7 @@ static int tolua_common_Vector4_getScaled00(lua_State* tolua_S)
    Vector4 tolua_ret = (Vector4)  self->getScaled(s);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -16847,7 +17278,7 @@ static int tolua_common_Vector4_midPointBetween01(lua_State* tolua_S)
    Vector4 tolua_ret = (Vector4)  self->midPointBetween(*v);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -16886,7 +17317,7 @@ static int tolua_common_Vector4_project01(lua_State* tolua_S)
    Vector4 tolua_ret = (Vector4)  self->project(*n);
    {
 #ifdef __cplusplus
-    void* tolua_obj = Mtolua_new((Vector4)(tolua_ret));
+    void* tolua_obj = Mtolua_pool_new((Vector4)(tolua_ret));
      tolua_pushusertype(tolua_S,tolua_obj,"Vector4");
     tolua_register_gc(tolua_S,lua_gettop(tolua_S));
 #else
@@ -17198,6 +17629,8 @@ TOLUA_API int tolua_common_open (lua_State* tolua_S)
    tolua_function(tolua_S,"getTransposed",tolua_common_Matrix4_getTransposed00);
    tolua_function(tolua_S,"getNegated",tolua_common_Matrix4_getNegated00);
    tolua_function(tolua_S,"determinant",tolua_common_Matrix4_determinant00);
+   tolua_function(tolua_S,"mulInPlace",tolua_common_Matrix4_mulInPlace00);
+   tolua_function(tolua_S,"mulScalarInPlace",tolua_common_Matrix4_mulScalarInPlace00);
   tolua_endmodule(tolua_S);
   #ifdef __cplusplus
   tolua_cclass(tolua_S,"Quaternion","Quaternion","",tolua_collect_Quaternion);
@@ -17274,6 +17707,10 @@ TOLUA_API int tolua_common_open (lua_State* tolua_S)
    tolua_function(tolua_S,"dot",tolua_common_Quaternion_dot00);
    tolua_function(tolua_S,"length",tolua_common_Quaternion_length00);
    tolua_function(tolua_S,"lengthSq",tolua_common_Quaternion_lengthSq00);
+   tolua_function(tolua_S,"addInPlace",tolua_common_Quaternion_addInPlace00);
+   tolua_function(tolua_S,"subInPlace",tolua_common_Quaternion_subInPlace00);
+   tolua_function(tolua_S,"mulInPlace",tolua_common_Quaternion_mulInPlace00);
+   tolua_function(tolua_S,"mulScalarInPlace",tolua_common_Quaternion_mulScalarInPlace00);
   tolua_endmodule(tolua_S);
   #ifdef __cplusplus
   tolua_cclass(tolua_S,"Vector2","Vector2","",tolua_collect_Vector2);
@@ -17447,6 +17884,13 @@ TOLUA_API int tolua_common_open (lua_State* tolua_S)
    tolua_function(tolua_S,"cross",tolua_common_Vector3_cross01);
    tolua_function(tolua_S,"midPointBetween",tolua_common_Vector3_midPointBetween01);
    tolua_function(tolua_S,"project",tolua_common_Vector3_project01);
+   tolua_function(tolua_S,"addInPlace",tolua_common_Vector3_addInPlace00);
+   tolua_function(tolua_S,"subInPlace",tolua_common_Vector3_subInPlace00);
+   tolua_function(tolua_S,"mulInPlace",tolua_common_Vector3_mulInPlace00);
+   tolua_function(tolua_S,"mulScalarInPlace",tolua_common_Vector3_mulScalarInPlace00);
+   tolua_function(tolua_S,"mulMatrix4InPlace",tolua_common_Vector3_mulMatrix4InPlace00);
+   tolua_function(tolua_S,"rotateInPlace",tolua_common_Vector3_rotateInPlace00);
+   tolua_function(tolua_S,"crossInPlace",tolua_common_Vector3_crossInPlace00);
   tolua_endmodule(tolua_S);
   #ifdef __cplusplus
   tolua_cclass(tolua_S,"Vector4","Vector4","",tolua_collect_Vector4);
@@ -24,7 +24,7 @@ SOFTWARE.
 #ifndef __BIND_COMMON_H__
 #define __BIND_COMMON_H__
 
-#include "PlatformMacros.h"
+#include "magical-macros.h"
 #include "tolua++.h"
 
 /* Exported function */
@@ -0,0 +1,1500 @@
+/*
+** Lua binding: magical_math
+** 按tolua++生成代码的形式手写，绑定引擎当前的Vector3、Quaternion、Matrix4x4（注册名Matrix4与BindCommon一致），
+** 包括api/magical-common/math/cpp中声明的原地运算；值类型经过LuaValuePool分配。
+** BindCommon按旧的数学接口生成、不参与构建时，由Lua::openBindings注册这些类型
+*/
+
+#include "string.h"
+
+#include "tolua++.h"
+
+#include "BindMath.h"
+#include "magical-engine.h"
+#include "LuaValuePool.h"
+
+/* 原地运算，见BindMath.h */
+void Vector3_addInPlace( Vector3* self, const Vector3& v ) { Vector3::add( *self, *self, v ); }
+void Vector3_subInPlace( Vector3* self, const Vector3& v ) { Vector3::sub( *self, *self, v ); }
+void Vector3_mulInPlace( Vector3* self, const Vector3& v ) { Vector3::mul( *self, *self, v ); }
+void Vector3_mulScalarInPlace( Vector3* self, float a ) { Vector3::mulScalar( *self, *self, a ); }
+void Vector3_mulMatrix4InPlace( Vector3* self, const Matrix4& m ) { Vector3::mul4x4( *self, *self, m ); }
+void Vector3_rotateInPlace( Vector3* self, const Quaternion& q ) { Quaternion::mulVector3( *self, q, *self ); }
+void Vector3_crossInPlace( Vector3* self, const Vector3& v ) { Vector3::cross( *self, *self, v ); }
+
+void Quaternion_addInPlace( Quaternion* self, const Quaternion& q ) { Quaternion::add( *self, *self, q ); }
+void Quaternion_subInPlace( Quaternion* self, const Quaternion& q ) { Quaternion::sub( *self, *self, q ); }
+void Quaternion_mulInPlace( Quaternion* self, const Quaternion& q ) { Quaternion::mul( *self, *self, q ); }
+void Quaternion_mulScalarInPlace( Quaternion* self, float a ) { Quaternion::mulScalar( *self, *self, a ); }
+
+void Matrix4_mulInPlace( Matrix4* self, const Matrix4& m ) { Matrix4::mul( *self, *self, m ); }
+void Matrix4_mulScalarInPlace( Matrix4* self, float a ) { Matrix4::mulScalar( *self, *self, a ); }
+
+/* function to release collected object via destructor */
+#ifdef __cplusplus
+
+static int tolua_collect_Vector3 (lua_State* tolua_S)
+{
+ Vector3* self = (Vector3*) tolua_tousertype(tolua_S,1,0);
+	Mtolua_pool_delete(self);
+	return 0;
+}
+
+static int tolua_collect_Quaternion (lua_State* tolua_S)
+{
+ Quaternion* self = (Quaternion*) tolua_tousertype(tolua_S,1,0);
+	Mtolua_pool_delete(self);
+	return 0;
+}
+
+static int tolua_collect_Matrix4 (lua_State* tolua_S)
+{
+ Matrix4* self = (Matrix4*) tolua_tousertype(tolua_S,1,0);
+	Mtolua_pool_delete(self);
+	return 0;
+}
+#endif
+
+
+/* function to register type */
+static void tolua_reg_types (lua_State* tolua_S)
+{
+ tolua_usertype(tolua_S,"Vector3");
+ tolua_usertype(tolua_S,"Quaternion");
+ tolua_usertype(tolua_S,"Matrix4");
+}
+
+
+/* get function: x of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_get_Vector3_x
+static int tolua_get_Vector3_x(lua_State* tolua_S)
+{
+  Vector3* self = (Vector3*)  tolua_tousertype(tolua_S,1,0);
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in accessing variable 'x'",NULL);
+#endif
+  tolua_pushnumber(tolua_S,(lua_Number)self->x);
+ return 1;
+}
+#endif //#ifndef TOLUA_DISABLE
+
+/* set function: x of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_set_Vector3_x
+static int tolua_set_Vector3_x(lua_State* tolua_S)
+{
+  Vector3* self = (Vector3*)  tolua_tousertype(tolua_S,1,0);
+#ifdef MAGICAL_DEBUG
+  tolua_Error tolua_err;
+  if (!self) tolua_error(tolua_S,"invalid 'self' in accessing variable 'x'",NULL);
+  if (!tolua_isnumber(tolua_S,2,0,&tolua_err))
+   tolua_error(tolua_S,"#vinvalid type in variable assignment.",&tolua_err);
+#endif
+  self->x = ((float)  tolua_tonumber(tolua_S,2,0))
+;
+ return 0;
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* get function: y of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_get_Vector3_y
+static int tolua_get_Vector3_y(lua_State* tolua_S)
+{
+  Vector3* self = (Vector3*)  tolua_tousertype(tolua_S,1,0);
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in accessing variable 'y'",NULL);
+#endif
+  tolua_pushnumber(tolua_S,(lua_Number)self->y);
+ return 1;
+}
+#endif //#ifndef TOLUA_DISABLE
+
+/* set function: y of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_set_Vector3_y
+static int tolua_set_Vector3_y(lua_State* tolua_S)
+{
+  Vector3* self = (Vector3*)  tolua_tousertype(tolua_S,1,0);
+#ifdef MAGICAL_DEBUG
+  tolua_Error tolua_err;
+  if (!self) tolua_error(tolua_S,"invalid 'self' in accessing variable 'y'",NULL);
+  if (!tolua_isnumber(tolua_S,2,0,&tolua_err))
+   tolua_error(tolua_S,"#vinvalid type in variable assignment.",&tolua_err);
+#endif
+  self->y = ((float)  tolua_tonumber(tolua_S,2,0))
+;
+ return 0;
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* get function: z of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_get_Vector3_z
+static int tolua_get_Vector3_z(lua_State* tolua_S)
+{
+  Vector3* self = (Vector3*)  tolua_tousertype(tolua_S,1,0);
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in accessing variable 'z'",NULL);
+#endif
+  tolua_pushnumber(tolua_S,(lua_Number)self->z);
+ return 1;
+}
+#endif //#ifndef TOLUA_DISABLE
+
+/* set function: z of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_set_Vector3_z
+static int tolua_set_Vector3_z(lua_State* tolua_S)
+{
+  Vector3* self = (Vector3*)  tolua_tousertype(tolua_S,1,0);
+#ifdef MAGICAL_DEBUG
+  tolua_Error tolua_err;
+  if (!self) tolua_error(tolua_S,"invalid 'self' in accessing variable 'z'",NULL);
+  if (!tolua_isnumber(tolua_S,2,0,&tolua_err))
+   tolua_error(tolua_S,"#vinvalid type in variable assignment.",&tolua_err);
+#endif
+  self->z = ((float)  tolua_tonumber(tolua_S,2,0))
+;
+ return 0;
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: new_local of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Vector3_new00_local
+static int tolua_magical_math_Vector3_new00_local(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertable(tolua_S,1,"Vector3",0,&tolua_err) ||
+     !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
+     !tolua_isnumber(tolua_S,3,0,&tolua_err) ||
+     !tolua_isnumber(tolua_S,4,0,&tolua_err) ||
+     !tolua_isnoobj(tolua_S,5,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  float x = ((float)  tolua_tonumber(tolua_S,2,0));
+  float y = ((float)  tolua_tonumber(tolua_S,3,0));
+  float z = ((float)  tolua_tonumber(tolua_S,4,0));
+  {
+   Vector3* tolua_ret = (Vector3*)  Mtolua_pool_new((Vector3)(x,y,z));
+    tolua_pushusertype(tolua_S,(void*)tolua_ret,"Vector3");
+    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
+  }
+ }
+ return 1;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'new'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: new_local of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Vector3_new01_local
+static int tolua_magical_math_Vector3_new01_local(lua_State* tolua_S)
+{
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertable(tolua_S,1,"Vector3",0,&tolua_err) ||
+     !tolua_isnoobj(tolua_S,2,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+ {
+  {
+   Vector3* tolua_ret = (Vector3*)  Mtolua_pool_new((Vector3)());
+    tolua_pushusertype(tolua_S,(void*)tolua_ret,"Vector3");
+    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
+  }
+ }
+ return 1;
+tolua_lerror:
+ return tolua_magical_math_Vector3_new00_local(tolua_S);
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: cross of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Vector3_cross00
+static int tolua_magical_math_Vector3_cross00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"const Vector3",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Vector3",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  const Vector3* self = (const Vector3*)  tolua_tousertype(tolua_S,1,0);
+  const Vector3* v = ((const Vector3*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'cross'", NULL);
+#endif
+  {
+   Vector3 tolua_ret = (Vector3)  Vector3::cross(*self,*v);
+   {
+#ifdef __cplusplus
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
+     tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
+    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
+#else
+    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(Vector3));
+     tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
+    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
+#endif
+   }
+  }
+ }
+ return 1;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'cross'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: normalize of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Vector3_normalize00
+static int tolua_magical_math_Vector3_normalize00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Vector3",0,&tolua_err) ||
+     !tolua_isnoobj(tolua_S,2,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Vector3* self = (Vector3*)  tolua_tousertype(tolua_S,1,0);
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'normalize'", NULL);
+#endif
+  {
+   self->normalize();
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'normalize'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: dot of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Vector3_dot00
+static int tolua_magical_math_Vector3_dot00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"const Vector3",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Vector3",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  const Vector3* self = (const Vector3*)  tolua_tousertype(tolua_S,1,0);
+  const Vector3* v = ((const Vector3*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'dot'", NULL);
+#endif
+  {
+   float tolua_ret = (float)  self->dot(*v);
+   tolua_pushnumber(tolua_S,(lua_Number)tolua_ret);
+  }
+ }
+ return 1;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'dot'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: length of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Vector3_length00
+static int tolua_magical_math_Vector3_length00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"const Vector3",0,&tolua_err) ||
+     !tolua_isnoobj(tolua_S,2,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  const Vector3* self = (const Vector3*)  tolua_tousertype(tolua_S,1,0);
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'length'", NULL);
+#endif
+  {
+   float tolua_ret = (float)  self->length();
+   tolua_pushnumber(tolua_S,(lua_Number)tolua_ret);
+  }
+ }
+ return 1;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'length'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: lerp of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Vector3_lerp00
+static int tolua_magical_math_Vector3_lerp00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"const Vector3",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Vector3",0,&tolua_err)) ||
+     !tolua_isnumber(tolua_S,3,0,&tolua_err) ||
+     !tolua_isnoobj(tolua_S,4,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  const Vector3* self = (const Vector3*)  tolua_tousertype(tolua_S,1,0);
+  const Vector3* v = ((const Vector3*)  tolua_tousertype(tolua_S,2,0));
+  float t = ((float)  tolua_tonumber(tolua_S,3,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'lerp'", NULL);
+#endif
+  {
+   Vector3 tolua_ret = (Vector3)  self->lerp(*v,t);
+   {
+#ifdef __cplusplus
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
+     tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
+    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
+#else
+    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(Vector3));
+     tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
+    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
+#endif
+   }
+  }
+ }
+ return 1;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'lerp'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: operator+ of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Vector3__add00
+static int tolua_magical_math_Vector3__add00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"const Vector3",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Vector3",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  const Vector3* self = (const Vector3*)  tolua_tousertype(tolua_S,1,0);
+  const Vector3* v = ((const Vector3*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function '.add'", NULL);
+#endif
+  {
+   Vector3 tolua_ret = (Vector3)  Vector3::add(*self,*v);
+   {
+#ifdef __cplusplus
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
+     tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
+    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
+#else
+    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(Vector3));
+     tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
+    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
+#endif
+   }
+  }
+ }
+ return 1;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function '.add'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: operator* of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Vector3__mul00
+static int tolua_magical_math_Vector3__mul00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"const Vector3",0,&tolua_err) ||
+     !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  const Vector3* self = (const Vector3*)  tolua_tousertype(tolua_S,1,0);
+  float a = ((float)  tolua_tonumber(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function '.mul'", NULL);
+#endif
+  {
+   Vector3 tolua_ret = (Vector3)  Vector3::mulScalar(*self,a);
+   {
+#ifdef __cplusplus
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
+     tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
+    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
+#else
+    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(Vector3));
+     tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
+    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
+#endif
+   }
+  }
+ }
+ return 1;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function '.mul'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: operator* of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Vector3__mul01
+static int tolua_magical_math_Vector3__mul01(lua_State* tolua_S)
+{
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"const Vector3",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Matrix4",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+ {
+  const Vector3* self = (const Vector3*)  tolua_tousertype(tolua_S,1,0);
+  const Matrix4* m = ((const Matrix4*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function '.mul'", NULL);
+#endif
+  {
+   Vector3 tolua_ret = (Vector3)  Vector3::mul4x4(*self,*m);
+   {
+#ifdef __cplusplus
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
+     tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
+    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
+#else
+    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(Vector3));
+     tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
+    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
+#endif
+   }
+  }
+ }
+ return 1;
+tolua_lerror:
+ return tolua_magical_math_Vector3__mul00(tolua_S);
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: Vector3_addInPlace of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Vector3_addInPlace00
+static int tolua_magical_math_Vector3_addInPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Vector3",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Vector3",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Vector3* self = (Vector3*)  tolua_tousertype(tolua_S,1,0);
+  const Vector3* v = ((const Vector3*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Vector3_addInPlace'", NULL);
+#endif
+  {
+   Vector3_addInPlace(self,*v);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'addInPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: Vector3_subInPlace of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Vector3_subInPlace00
+static int tolua_magical_math_Vector3_subInPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Vector3",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Vector3",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Vector3* self = (Vector3*)  tolua_tousertype(tolua_S,1,0);
+  const Vector3* v = ((const Vector3*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Vector3_subInPlace'", NULL);
+#endif
+  {
+   Vector3_subInPlace(self,*v);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'subInPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: Vector3_mulInPlace of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Vector3_mulInPlace00
+static int tolua_magical_math_Vector3_mulInPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Vector3",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Vector3",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Vector3* self = (Vector3*)  tolua_tousertype(tolua_S,1,0);
+  const Vector3* v = ((const Vector3*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Vector3_mulInPlace'", NULL);
+#endif
+  {
+   Vector3_mulInPlace(self,*v);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'mulInPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: Vector3_mulScalarInPlace of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Vector3_mulScalarInPlace00
+static int tolua_magical_math_Vector3_mulScalarInPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Vector3",0,&tolua_err) ||
+     !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Vector3* self = (Vector3*)  tolua_tousertype(tolua_S,1,0);
+  float a = ((float)  tolua_tonumber(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Vector3_mulScalarInPlace'", NULL);
+#endif
+  {
+   Vector3_mulScalarInPlace(self,a);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'mulScalarInPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: Vector3_mulMatrix4InPlace of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Vector3_mulMatrix4InPlace00
+static int tolua_magical_math_Vector3_mulMatrix4InPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Vector3",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Matrix4",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Vector3* self = (Vector3*)  tolua_tousertype(tolua_S,1,0);
+  const Matrix4* m = ((const Matrix4*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Vector3_mulMatrix4InPlace'", NULL);
+#endif
+  {
+   Vector3_mulMatrix4InPlace(self,*m);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'mulMatrix4InPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: Vector3_rotateInPlace of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Vector3_rotateInPlace00
+static int tolua_magical_math_Vector3_rotateInPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Vector3",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Quaternion",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Vector3* self = (Vector3*)  tolua_tousertype(tolua_S,1,0);
+  const Quaternion* q = ((const Quaternion*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Vector3_rotateInPlace'", NULL);
+#endif
+  {
+   Vector3_rotateInPlace(self,*q);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'rotateInPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: Vector3_crossInPlace of class  Vector3 */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Vector3_crossInPlace00
+static int tolua_magical_math_Vector3_crossInPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Vector3",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Vector3",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Vector3* self = (Vector3*)  tolua_tousertype(tolua_S,1,0);
+  const Vector3* v = ((const Vector3*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Vector3_crossInPlace'", NULL);
+#endif
+  {
+   Vector3_crossInPlace(self,*v);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'crossInPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* get function: x of class  Quaternion */
+#ifndef TOLUA_DISABLE_tolua_get_Quaternion_x
+static int tolua_get_Quaternion_x(lua_State* tolua_S)
+{
+  Quaternion* self = (Quaternion*)  tolua_tousertype(tolua_S,1,0);
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in accessing variable 'x'",NULL);
+#endif
+  tolua_pushnumber(tolua_S,(lua_Number)self->x);
+ return 1;
+}
+#endif //#ifndef TOLUA_DISABLE
+
+/* set function: x of class  Quaternion */
+#ifndef TOLUA_DISABLE_tolua_set_Quaternion_x
+static int tolua_set_Quaternion_x(lua_State* tolua_S)
+{
+  Quaternion* self = (Quaternion*)  tolua_tousertype(tolua_S,1,0);
+#ifdef MAGICAL_DEBUG
+  tolua_Error tolua_err;
+  if (!self) tolua_error(tolua_S,"invalid 'self' in accessing variable 'x'",NULL);
+  if (!tolua_isnumber(tolua_S,2,0,&tolua_err))
+   tolua_error(tolua_S,"#vinvalid type in variable assignment.",&tolua_err);
+#endif
+  self->x = ((float)  tolua_tonumber(tolua_S,2,0))
+;
+ return 0;
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* get function: y of class  Quaternion */
+#ifndef TOLUA_DISABLE_tolua_get_Quaternion_y
+static int tolua_get_Quaternion_y(lua_State* tolua_S)
+{
+  Quaternion* self = (Quaternion*)  tolua_tousertype(tolua_S,1,0);
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in accessing variable 'y'",NULL);
+#endif
+  tolua_pushnumber(tolua_S,(lua_Number)self->y);
+ return 1;
+}
+#endif //#ifndef TOLUA_DISABLE
+
+/* set function: y of class  Quaternion */
+#ifndef TOLUA_DISABLE_tolua_set_Quaternion_y
+static int tolua_set_Quaternion_y(lua_State* tolua_S)
+{
+  Quaternion* self = (Quaternion*)  tolua_tousertype(tolua_S,1,0);
+#ifdef MAGICAL_DEBUG
+  tolua_Error tolua_err;
+  if (!self) tolua_error(tolua_S,"invalid 'self' in accessing variable 'y'",NULL);
+  if (!tolua_isnumber(tolua_S,2,0,&tolua_err))
+   tolua_error(tolua_S,"#vinvalid type in variable assignment.",&tolua_err);
+#endif
+  self->y = ((float)  tolua_tonumber(tolua_S,2,0))
+;
+ return 0;
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* get function: z of class  Quaternion */
+#ifndef TOLUA_DISABLE_tolua_get_Quaternion_z
+static int tolua_get_Quaternion_z(lua_State* tolua_S)
+{
+  Quaternion* self = (Quaternion*)  tolua_tousertype(tolua_S,1,0);
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in accessing variable 'z'",NULL);
+#endif
+  tolua_pushnumber(tolua_S,(lua_Number)self->z);
+ return 1;
+}
+#endif //#ifndef TOLUA_DISABLE
+
+/* set function: z of class  Quaternion */
+#ifndef TOLUA_DISABLE_tolua_set_Quaternion_z
+static int tolua_set_Quaternion_z(lua_State* tolua_S)
+{
+  Quaternion* self = (Quaternion*)  tolua_tousertype(tolua_S,1,0);
+#ifdef MAGICAL_DEBUG
+  tolua_Error tolua_err;
+  if (!self) tolua_error(tolua_S,"invalid 'self' in accessing variable 'z'",NULL);
+  if (!tolua_isnumber(tolua_S,2,0,&tolua_err))
+   tolua_error(tolua_S,"#vinvalid type in variable assignment.",&tolua_err);
+#endif
+  self->z = ((float)  tolua_tonumber(tolua_S,2,0))
+;
+ return 0;
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* get function: w of class  Quaternion */
+#ifndef TOLUA_DISABLE_tolua_get_Quaternion_w
+static int tolua_get_Quaternion_w(lua_State* tolua_S)
+{
+  Quaternion* self = (Quaternion*)  tolua_tousertype(tolua_S,1,0);
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in accessing variable 'w'",NULL);
+#endif
+  tolua_pushnumber(tolua_S,(lua_Number)self->w);
+ return 1;
+}
+#endif //#ifndef TOLUA_DISABLE
+
+/* set function: w of class  Quaternion */
+#ifndef TOLUA_DISABLE_tolua_set_Quaternion_w
+static int tolua_set_Quaternion_w(lua_State* tolua_S)
+{
+  Quaternion* self = (Quaternion*)  tolua_tousertype(tolua_S,1,0);
+#ifdef MAGICAL_DEBUG
+  tolua_Error tolua_err;
+  if (!self) tolua_error(tolua_S,"invalid 'self' in accessing variable 'w'",NULL);
+  if (!tolua_isnumber(tolua_S,2,0,&tolua_err))
+   tolua_error(tolua_S,"#vinvalid type in variable assignment.",&tolua_err);
+#endif
+  self->w = ((float)  tolua_tonumber(tolua_S,2,0))
+;
+ return 0;
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: new_local of class  Quaternion */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Quaternion_new00_local
+static int tolua_magical_math_Quaternion_new00_local(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertable(tolua_S,1,"Quaternion",0,&tolua_err) ||
+     !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
+     !tolua_isnumber(tolua_S,3,0,&tolua_err) ||
+     !tolua_isnumber(tolua_S,4,0,&tolua_err) ||
+     !tolua_isnumber(tolua_S,5,0,&tolua_err) ||
+     !tolua_isnoobj(tolua_S,6,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  float x = ((float)  tolua_tonumber(tolua_S,2,0));
+  float y = ((float)  tolua_tonumber(tolua_S,3,0));
+  float z = ((float)  tolua_tonumber(tolua_S,4,0));
+  float w = ((float)  tolua_tonumber(tolua_S,5,0));
+  {
+   Quaternion* tolua_ret = (Quaternion*)  Mtolua_pool_new((Quaternion)(x,y,z,w));
+    tolua_pushusertype(tolua_S,(void*)tolua_ret,"Quaternion");
+    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
+  }
+ }
+ return 1;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'new'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: new_local of class  Quaternion */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Quaternion_new01_local
+static int tolua_magical_math_Quaternion_new01_local(lua_State* tolua_S)
+{
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertable(tolua_S,1,"Quaternion",0,&tolua_err) ||
+     !tolua_isnoobj(tolua_S,2,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+ {
+  {
+   Quaternion* tolua_ret = (Quaternion*)  Mtolua_pool_new((Quaternion)());
+    tolua_pushusertype(tolua_S,(void*)tolua_ret,"Quaternion");
+    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
+  }
+ }
+ return 1;
+tolua_lerror:
+ return tolua_magical_math_Quaternion_new00_local(tolua_S);
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: identity of class  Quaternion */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Quaternion_identity00
+static int tolua_magical_math_Quaternion_identity00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Quaternion",0,&tolua_err) ||
+     !tolua_isnoobj(tolua_S,2,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Quaternion* self = (Quaternion*)  tolua_tousertype(tolua_S,1,0);
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'identity'", NULL);
+#endif
+  {
+   *self = Quaternion::Identity;
+   tolua_pushusertype(tolua_S,(void*)self,"Quaternion");
+  }
+ }
+ return 1;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'identity'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: normalize of class  Quaternion */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Quaternion_normalize00
+static int tolua_magical_math_Quaternion_normalize00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Quaternion",0,&tolua_err) ||
+     !tolua_isnoobj(tolua_S,2,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Quaternion* self = (Quaternion*)  tolua_tousertype(tolua_S,1,0);
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'normalize'", NULL);
+#endif
+  {
+   Quaternion::normalize(*self,*self);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'normalize'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: operator* of class  Quaternion */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Quaternion__mul00
+static int tolua_magical_math_Quaternion__mul00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"const Quaternion",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Quaternion",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  const Quaternion* self = (const Quaternion*)  tolua_tousertype(tolua_S,1,0);
+  const Quaternion* q = ((const Quaternion*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function '.mul'", NULL);
+#endif
+  {
+   Quaternion tolua_ret = (Quaternion)  Quaternion::mul(*self,*q);
+   {
+#ifdef __cplusplus
+    void* tolua_obj = Mtolua_pool_new((Quaternion)(tolua_ret));
+     tolua_pushusertype(tolua_S,tolua_obj,"Quaternion");
+    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
+#else
+    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(Quaternion));
+     tolua_pushusertype(tolua_S,tolua_obj,"Quaternion");
+    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
+#endif
+   }
+  }
+ }
+ return 1;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function '.mul'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: operator* of class  Quaternion */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Quaternion__mul01
+static int tolua_magical_math_Quaternion__mul01(lua_State* tolua_S)
+{
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"const Quaternion",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Vector3",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+ {
+  const Quaternion* self = (const Quaternion*)  tolua_tousertype(tolua_S,1,0);
+  const Vector3* v = ((const Vector3*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function '.mul'", NULL);
+#endif
+  {
+   Vector3 tolua_ret = (Vector3)  Quaternion::mulVector3(*self,*v);
+   {
+#ifdef __cplusplus
+    void* tolua_obj = Mtolua_pool_new((Vector3)(tolua_ret));
+     tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
+    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
+#else
+    void* tolua_obj = tolua_copy(tolua_S,(void*)&tolua_ret,sizeof(Vector3));
+     tolua_pushusertype(tolua_S,tolua_obj,"Vector3");
+    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
+#endif
+   }
+  }
+ }
+ return 1;
+tolua_lerror:
+ return tolua_magical_math_Quaternion__mul00(tolua_S);
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: Quaternion_addInPlace of class  Quaternion */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Quaternion_addInPlace00
+static int tolua_magical_math_Quaternion_addInPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Quaternion",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Quaternion",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Quaternion* self = (Quaternion*)  tolua_tousertype(tolua_S,1,0);
+  const Quaternion* q = ((const Quaternion*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Quaternion_addInPlace'", NULL);
+#endif
+  {
+   Quaternion_addInPlace(self,*q);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'addInPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: Quaternion_subInPlace of class  Quaternion */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Quaternion_subInPlace00
+static int tolua_magical_math_Quaternion_subInPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Quaternion",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Quaternion",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Quaternion* self = (Quaternion*)  tolua_tousertype(tolua_S,1,0);
+  const Quaternion* q = ((const Quaternion*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Quaternion_subInPlace'", NULL);
+#endif
+  {
+   Quaternion_subInPlace(self,*q);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'subInPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: Quaternion_mulInPlace of class  Quaternion */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Quaternion_mulInPlace00
+static int tolua_magical_math_Quaternion_mulInPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Quaternion",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Quaternion",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Quaternion* self = (Quaternion*)  tolua_tousertype(tolua_S,1,0);
+  const Quaternion* q = ((const Quaternion*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Quaternion_mulInPlace'", NULL);
+#endif
+  {
+   Quaternion_mulInPlace(self,*q);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'mulInPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: Quaternion_mulScalarInPlace of class  Quaternion */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Quaternion_mulScalarInPlace00
+static int tolua_magical_math_Quaternion_mulScalarInPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Quaternion",0,&tolua_err) ||
+     !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Quaternion* self = (Quaternion*)  tolua_tousertype(tolua_S,1,0);
+  float a = ((float)  tolua_tonumber(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Quaternion_mulScalarInPlace'", NULL);
+#endif
+  {
+   Quaternion_mulScalarInPlace(self,a);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'mulScalarInPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: new_local of class  Matrix4 */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Matrix4_new00_local
+static int tolua_magical_math_Matrix4_new00_local(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertable(tolua_S,1,"Matrix4",0,&tolua_err) ||
+     !tolua_isnoobj(tolua_S,2,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  {
+   Matrix4* tolua_ret = (Matrix4*)  Mtolua_pool_new((Matrix4)());
+    tolua_pushusertype(tolua_S,(void*)tolua_ret,"Matrix4");
+    tolua_register_gc(tolua_S,lua_gettop(tolua_S));
+  }
+ }
+ return 1;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'new'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: identity of class  Matrix4 */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Matrix4_identity00
+static int tolua_magical_math_Matrix4_identity00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Matrix4",0,&tolua_err) ||
+     !tolua_isnoobj(tolua_S,2,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Matrix4* self = (Matrix4*)  tolua_tousertype(tolua_S,1,0);
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'identity'", NULL);
+#endif
+  {
+   *self = Matrix4::Identity;
+   tolua_pushusertype(tolua_S,(void*)self,"Matrix4");
+  }
+ }
+ return 1;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'identity'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: setTranslation of class  Matrix4 */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Matrix4_setTranslation00
+static int tolua_magical_math_Matrix4_setTranslation00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Matrix4",0,&tolua_err) ||
+     !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
+     !tolua_isnumber(tolua_S,3,0,&tolua_err) ||
+     !tolua_isnumber(tolua_S,4,0,&tolua_err) ||
+     !tolua_isnoobj(tolua_S,5,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Matrix4* self = (Matrix4*)  tolua_tousertype(tolua_S,1,0);
+  float x = ((float)  tolua_tonumber(tolua_S,2,0));
+  float y = ((float)  tolua_tonumber(tolua_S,3,0));
+  float z = ((float)  tolua_tonumber(tolua_S,4,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'setTranslation'", NULL);
+#endif
+  {
+   self->setTranslation(Vector3(x,y,z));
+   tolua_pushusertype(tolua_S,(void*)self,"Matrix4");
+  }
+ }
+ return 1;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'setTranslation'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: Matrix4_mulInPlace of class  Matrix4 */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Matrix4_mulInPlace00
+static int tolua_magical_math_Matrix4_mulInPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Matrix4",0,&tolua_err) ||
+     (tolua_isvaluenil(tolua_S,2,&tolua_err) || !tolua_isusertype(tolua_S,2,"const Matrix4",0,&tolua_err)) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Matrix4* self = (Matrix4*)  tolua_tousertype(tolua_S,1,0);
+  const Matrix4* m = ((const Matrix4*)  tolua_tousertype(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Matrix4_mulInPlace'", NULL);
+#endif
+  {
+   Matrix4_mulInPlace(self,*m);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'mulInPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* method: Matrix4_mulScalarInPlace of class  Matrix4 */
+#ifndef TOLUA_DISABLE_tolua_magical_math_Matrix4_mulScalarInPlace00
+static int tolua_magical_math_Matrix4_mulScalarInPlace00(lua_State* tolua_S)
+{
+#ifdef MAGICAL_DEBUG
+ tolua_Error tolua_err;
+ if (
+     !tolua_isusertype(tolua_S,1,"Matrix4",0,&tolua_err) ||
+     !tolua_isnumber(tolua_S,2,0,&tolua_err) ||
+     !tolua_isnoobj(tolua_S,3,&tolua_err)
+ )
+  goto tolua_lerror;
+ else
+#endif
+ {
+  Matrix4* self = (Matrix4*)  tolua_tousertype(tolua_S,1,0);
+  float a = ((float)  tolua_tonumber(tolua_S,2,0));
+#ifdef MAGICAL_DEBUG
+  if (!self) tolua_error(tolua_S,"invalid 'self' in function 'Matrix4_mulScalarInPlace'", NULL);
+#endif
+  {
+   Matrix4_mulScalarInPlace(self,a);
+  }
+ }
+ return 0;
+#ifdef MAGICAL_DEBUG
+ tolua_lerror:
+ tolua_error(tolua_S,"#ferror in function 'mulScalarInPlace'.",&tolua_err);
+ return 0;
+#endif
+}
+#endif //#ifndef TOLUA_DISABLE
+
+
+/* Open function */
+TOLUA_API int tolua_magical_math_open (lua_State* tolua_S)
+{
+ tolua_open(tolua_S);
+ tolua_reg_types(tolua_S);
+ tolua_module(tolua_S,NULL,0);
+ tolua_beginmodule(tolua_S,NULL);
+  #ifdef __cplusplus
+  tolua_cclass(tolua_S,"Vector3","Vector3","",tolua_collect_Vector3);
+  #else
+  tolua_cclass(tolua_S,"Vector3","Vector3","",NULL);
+  #endif
+  tolua_beginmodule(tolua_S,"Vector3");
+   tolua_variable(tolua_S,"x",tolua_get_Vector3_x,tolua_set_Vector3_x);
+   tolua_variable(tolua_S,"y",tolua_get_Vector3_y,tolua_set_Vector3_y);
+   tolua_variable(tolua_S,"z",tolua_get_Vector3_z,tolua_set_Vector3_z);
+   tolua_function(tolua_S,"new_local",tolua_magical_math_Vector3_new01_local);
+   tolua_function(tolua_S,".call",tolua_magical_math_Vector3_new01_local);
+   tolua_function(tolua_S,"cross",tolua_magical_math_Vector3_cross00);
+   tolua_function(tolua_S,"normalize",tolua_magical_math_Vector3_normalize00);
+   tolua_function(tolua_S,"dot",tolua_magical_math_Vector3_dot00);
+   tolua_function(tolua_S,"length",tolua_magical_math_Vector3_length00);
+   tolua_function(tolua_S,"lerp",tolua_magical_math_Vector3_lerp00);
+   tolua_function(tolua_S,".add",tolua_magical_math_Vector3__add00);
+   tolua_function(tolua_S,".mul",tolua_magical_math_Vector3__mul01);
+   tolua_function(tolua_S,"addInPlace",tolua_magical_math_Vector3_addInPlace00);
+   tolua_function(tolua_S,"subInPlace",tolua_magical_math_Vector3_subInPlace00);
+   tolua_function(tolua_S,"mulInPlace",tolua_magical_math_Vector3_mulInPlace00);
+   tolua_function(tolua_S,"mulScalarInPlace",tolua_magical_math_Vector3_mulScalarInPlace00);
+   tolua_function(tolua_S,"mulMatrix4InPlace",tolua_magical_math_Vector3_mulMatrix4InPlace00);
+   tolua_function(tolua_S,"rotateInPlace",tolua_magical_math_Vector3_rotateInPlace00);
+   tolua_function(tolua_S,"crossInPlace",tolua_magical_math_Vector3_crossInPlace00);
+  tolua_endmodule(tolua_S);
+  #ifdef __cplusplus
+  tolua_cclass(tolua_S,"Quaternion","Quaternion","",tolua_collect_Quaternion);
+  #else
+  tolua_cclass(tolua_S,"Quaternion","Quaternion","",NULL);
+  #endif
+  tolua_beginmodule(tolua_S,"Quaternion");
+   tolua_variable(tolua_S,"x",tolua_get_Quaternion_x,tolua_set_Quaternion_x);
+   tolua_variable(tolua_S,"y",tolua_get_Quaternion_y,tolua_set_Quaternion_y);
+   tolua_variable(tolua_S,"z",tolua_get_Quaternion_z,tolua_set_Quaternion_z);
+   tolua_variable(tolua_S,"w",tolua_get_Quaternion_w,tolua_set_Quaternion_w);
+   tolua_function(tolua_S,"new_local",tolua_magical_math_Quaternion_new01_local);
+   tolua_function(tolua_S,".call",tolua_magical_math_Quaternion_new01_local);
+   tolua_function(tolua_S,"identity",tolua_magical_math_Quaternion_identity00);
+   tolua_function(tolua_S,"normalize",tolua_magical_math_Quaternion_normalize00);
+   tolua_function(tolua_S,".mul",tolua_magical_math_Quaternion__mul01);
+   tolua_function(tolua_S,"addInPlace",tolua_magical_math_Quaternion_addInPlace00);
+   tolua_function(tolua_S,"subInPlace",tolua_magical_math_Quaternion_subInPlace00);
+   tolua_function(tolua_S,"mulInPlace",tolua_magical_math_Quaternion_mulInPlace00);
+   tolua_function(tolua_S,"mulScalarInPlace",tolua_magical_math_Quaternion_mulScalarInPlace00);
+  tolua_endmodule(tolua_S);
+  #ifdef __cplusplus
+  tolua_cclass(tolua_S,"Matrix4","Matrix4","",tolua_collect_Matrix4);
+  #else
+  tolua_cclass(tolua_S,"Matrix4","Matrix4","",NULL);
+  #endif
+  tolua_beginmodule(tolua_S,"Matrix4");
+   tolua_function(tolua_S,"new_local",tolua_magical_math_Matrix4_new00_local);
+   tolua_function(tolua_S,".call",tolua_magical_math_Matrix4_new00_local);
+   tolua_function(tolua_S,"identity",tolua_magical_math_Matrix4_identity00);
+   tolua_function(tolua_S,"setTranslation",tolua_magical_math_Matrix4_setTranslation00);
+   tolua_function(tolua_S,"mulInPlace",tolua_magical_math_Matrix4_mulInPlace00);
+   tolua_function(tolua_S,"mulScalarInPlace",tolua_magical_math_Matrix4_mulScalarInPlace00);
+  tolua_endmodule(tolua_S);
+ tolua_endmodule(tolua_S);
+ return 1;
+}
+
+
+#if defined(LUA_VERSION_NUM) && LUA_VERSION_NUM >= 501
+ TOLUA_API int luaopen_magical_math (lua_State* tolua_S) {
+ return tolua_magical_math_open(tolua_S);
+};
+#endif
@@ -0,0 +1,63 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __BIND_MATH_H__
+#define __BIND_MATH_H__
+
+#include "magical-macros.h"
+#include "magical-engine.h"
+#include "tolua++.h"
+
+USING_NS_MAGICAL;
+
+/*
+绑定中的Matrix4是引擎的Matrix4x4，注册名与api/magical-common/math/cpp/Matrix4.pkg一致
+*/
+typedef Matrix4x4 Matrix4;
+
+/*
+数学类型的原地运算，通过tolua_outside绑定为成员函数（见api/magical-common/math/cpp）
+
+v:addInPlace( w )直接修改v，不像v + w那样为结果分配新的userdata，
+脚本的热点循环中用来避免每次运算的分配和GC
+*/
+void Vector3_addInPlace( Vector3* self, const Vector3& v );
+void Vector3_subInPlace( Vector3* self, const Vector3& v );
+void Vector3_mulInPlace( Vector3* self, const Vector3& v );
+void Vector3_mulScalarInPlace( Vector3* self, float a );
+void Vector3_mulMatrix4InPlace( Vector3* self, const Matrix4& m );
+void Vector3_rotateInPlace( Vector3* self, const Quaternion& q );
+void Vector3_crossInPlace( Vector3* self, const Vector3& v );
+
+void Quaternion_addInPlace( Quaternion* self, const Quaternion& q );
+void Quaternion_subInPlace( Quaternion* self, const Quaternion& q );
+void Quaternion_mulInPlace( Quaternion* self, const Quaternion& q );
+void Quaternion_mulScalarInPlace( Quaternion* self, float a );
+
+void Matrix4_mulInPlace( Matrix4* self, const Matrix4& m );
+void Matrix4_mulScalarInPlace( Matrix4* self, float a );
+
+/* Exported function */
+TOLUA_API int luaopen_magical_math (lua_State* tolua_S);
+
+#endif //__BIND_MATH_H__
\ No newline at end of file
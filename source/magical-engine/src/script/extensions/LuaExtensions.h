@@ -24,7 +24,7 @@ SOFTWARE.
 #ifndef __LUA_EXTENSION_H__
 #define __LUA_EXTENSION_H__
 
-#include "PlatformMacros.h"
+#include "magical-macros.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -0,0 +1,359 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "LuaBytecodeCache.h"
+#include "Stats.h"
+#include "Assets.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <mutex>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+
+struct LuaBytecode
+{
+	size_t source_size;
+	std::string code;
+};
+
+// 磁盘缓存文件的文件头，之后是bytecode_size字节的字节码，checksum为字节码的哈希
+struct LuaBytecodeHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t key;
+	uint64_t source_size;
+	uint64_t bytecode_size;
+	uint64_t checksum;
+};
+
+static const uint32_t _s_magic = 0x4342554c; // "LUBC"
+static const uint32_t _s_version = 2;
+static const uint64_t _s_hash_basis = 14695981039346656037ULL;
+
+// 不同的Lua实现生成的字节码不通用，实现的版本也计入键
+#ifdef LUAJIT_VERSION
+static const char* _s_runtime = LUAJIT_VERSION;
+#else
+static const char* _s_runtime = LUA_RELEASE;
+#endif
+
+static std::mutex _s_mutex;
+static std::unordered_map<uint64_t, std::shared_ptr<const LuaBytecode>> _s_cache;
+static std::string _s_directory;
+static std::atomic<uint32_t> _s_temp_id( 0 );
+
+static magical::Stat _stat_bytecode_hits( "lua.bytecode.hits", magical::Stat::Counter );
+static magical::Stat _stat_bytecode_disk_hits( "lua.bytecode.disk_hits", magical::Stat::Counter );
+static magical::Stat _stat_bytecode_compiles( "lua.bytecode.compiles", magical::Stat::Counter );
+
+static uint64_t hashBytes( uint64_t h, const char* data, size_t size )
+{
+	for( size_t i = 0; i < size; ++i )
+	{
+		h ^= (uint8_t) data[i];
+		h *= 1099511628211ULL;
+	}
+	return h;
+}
+
+static bool readFile( const char* file, std::string& content )
+{
+	FILE* fp = fopen( file, "rb" );
+	if( fp == nullptr )
+		return false;
+
+	fseek( fp, 0, SEEK_END );
+	long size = ftell( fp );
+	fseek( fp, 0, SEEK_SET );
+
+	content.resize( size > 0 ? (size_t) size : 0 );
+	bool ok = size >= 0 && fread( &content[0], 1, content.size(), fp ) == content.size();
+	fclose( fp );
+	return ok;
+}
+
+static std::string cacheFile( const std::string& directory, uint64_t key )
+{
+	char name[32];
+	sprintf( name, "/%016llx.luac", (unsigned long long) key );
+	return directory + name;
+}
+
+static std::shared_ptr<const LuaBytecode> readCacheFile( const std::string& directory, uint64_t key, size_t source_size )
+{
+	std::string content;
+	if( !readFile( cacheFile( directory, key ).c_str(), content ) || content.size() < sizeof( LuaBytecodeHeader ) )
+		return nullptr;
+
+	LuaBytecodeHeader header;
+	memcpy( &header, content.data(), sizeof( header ) );
+	if( header.magic != _s_magic || header.version != _s_version || header.key != key ||
+		header.source_size != source_size || header.bytecode_size != content.size() - sizeof( header ) ||
+		header.checksum != hashBytes( _s_hash_basis, content.data() + sizeof( header ), content.size() - sizeof( header ) ) )
+		return nullptr;
+
+	std::shared_ptr<LuaBytecode> bytecode( new LuaBytecode() );
+	bytecode->source_size = source_size;
+	bytecode->code.assign( content, sizeof( header ), std::string::npos );
+	return bytecode;
+}
+
+/*
+先写入同目录下的临时文件再改名，其它线程或进程不会读到写了一半的文件；
+临时文件名包含线程和序号，同时编译同一脚本的线程各写各的，最后一个改名的生效
+*/
+static void writeCacheFile( const std::string& directory, uint64_t key, const LuaBytecode& bytecode )
+{
+	std::string file = cacheFile( directory, key );
+	char suffix[48];
+	sprintf( suffix, ".%llx.%x.tmp", (unsigned long long) std::hash<std::thread::id>()( std::this_thread::get_id() ),
+		_s_temp_id.fetch_add( 1 ) );
+	std::string temp = file + suffix;
+
+	FILE* fp = fopen( temp.c_str(), "wb" );
+	if( fp == nullptr )
+		return;
+
+	LuaBytecodeHeader header = { _s_magic, _s_version, key, bytecode.source_size, bytecode.code.size(),
+		hashBytes( _s_hash_basis, bytecode.code.data(), bytecode.code.size() ) };
+	bool ok = fwrite( &header, sizeof( header ), 1, fp ) == 1 &&
+		fwrite( bytecode.code.data(), 1, bytecode.code.size(), fp ) == bytecode.code.size();
+	ok = fclose( fp ) == 0 && ok;
+
+	// Windows上目标已存在时rename失败，先删除旧文件
+	if( ok && rename( temp.c_str(), file.c_str() ) != 0 )
+	{
+		remove( file.c_str() );
+		ok = rename( temp.c_str(), file.c_str() ) == 0;
+	}
+	if( !ok )
+		remove( temp.c_str() );
+}
+
+static int dumpWriter( lua_State* L, const void* p, size_t size, void* ud )
+{
+	( (std::string*) ud )->append( (const char*) p, size );
+	return 0;
+}
+
+/*
+按package.path查找并编译模块，返回1时栈顶为编译好的函数，返回0时栈顶为尝试过的文件列表，
+返回-1时栈顶依次为编译的错误信息和文件名；
+Lua以C编译，lua_error通过longjmp返回，会跳过这里C++局部对象的析构，
+因此这里不抛出错误，由lua_bytecode_loader在这些对象析构之后抛出
+*/
+static int searchModule( lua_State* L, const char* name, const char* path )
+{
+	std::string module = name;
+	for( auto& c : module )
+	{
+		if( c == '.' )
+			c = LUA_DIRSEP[0];
+	}
+
+	std::string tried;
+	const char* begin = path;
+	while( *begin )
+	{
+		const char* end = strchr( begin, LUA_PATHSEP[0] );
+		if( end == nullptr )
+			end = begin + strlen( begin );
+
+		std::string file( begin, end );
+		begin = *end ? end + 1 : end;
+		if( file.empty() )
+			continue;
+
+		for( size_t mark = file.find( LUA_PATH_MARK ); mark != std::string::npos; mark = file.find( LUA_PATH_MARK, mark + module.size() ) )
+			file.replace( mark, 1, module );
+
+		// 与runScriptFile相同经过Assets读取，相对路径先查找已挂载的资源包
+		int ret = LuaBytecodeCache::loadFile( L, file.c_str() );
+		if( ret == LUA_ERRFILE )
+		{
+			lua_pop( L, 1 );
+			tried += "\n\tno file '" + file + "'";
+			continue;
+		}
+
+		if( ret != 0 )
+		{
+			lua_pushlstring( L, file.data(), file.size() );
+			return -1;
+		}
+		return 1;
+	}
+
+	lua_pushlstring( L, tried.data(), tried.size() );
+	return 0;
+}
+
+/*
+require的Lua文件加载器，与Lua自带的按package.path查找的加载器相同，
+只是文件经过Assets读取（相对路径相对于资源目录，并查找已挂载的资源包），编译经过缓存
+*/
+static int lua_bytecode_loader( lua_State* L )
+{
+	const char* name = luaL_checkstring( L, 1 );
+	lua_getglobal( L, LUA_LOADLIBNAME );
+	lua_getfield( L, -1, "path" );
+	const char* path = lua_tostring( L, -1 );
+	if( path == nullptr )
+		return luaL_error( L, LUA_QL("package.path") " must be a string" );
+
+	if( searchModule( L, name, path ) < 0 )
+	{
+		return luaL_error( L, "error loading module " LUA_QS " from file " LUA_QS ":\n\t%s",
+			name, lua_tostring( L, -1 ), lua_tostring( L, -2 ) );
+	}
+	return 1;
+}
+
+int LuaBytecodeCache::load( lua_State* L, const char* source, size_t size, const char* chunkname )
+{
+	MAGICAL_ASSERT( source && chunkname, "source and chunkname should not be nullptr" );
+
+	// 已经是字节码的文件不再缓存
+	if( size > 0 && source[0] == LUA_SIGNATURE[0] )
+		return luaL_loadbuffer( L, source, size, chunkname );
+
+	uint64_t key = hashBytes( _s_hash_basis, _s_runtime, strlen( _s_runtime ) );
+	key = hashBytes( key, chunkname, strlen( chunkname ) + 1 );
+	key = hashBytes( key, source, size );
+
+	std::shared_ptr<const LuaBytecode> bytecode;
+	std::string directory;
+	{
+		std::lock_guard<std::mutex> lock( _s_mutex );
+		auto itr = _s_cache.find( key );
+		if( itr != _s_cache.end() && itr->second->source_size == size )
+			bytecode = itr->second;
+		directory = _s_directory;
+	}
+
+	bool from_disk = false;
+	if( bytecode == nullptr && !directory.empty() )
+	{
+		bytecode = readCacheFile( directory, key, size );
+		from_disk = bytecode != nullptr;
+	}
+
+	if( bytecode && luaL_loadbuffer( L, bytecode->code.data(), bytecode->code.size(), chunkname ) == 0 )
+	{
+		if( from_disk )
+		{
+			std::lock_guard<std::mutex> lock( _s_mutex );
+			_s_cache[ key ] = bytecode;
+			_stat_bytecode_disk_hits.add();
+		}
+		_stat_bytecode_hits.add();
+		return 0;
+	}
+	else if( bytecode )
+	{
+		// 字节码不能加载时丢弃，重新编译
+		lua_pop( L, 1 );
+	}
+
+	int ret = luaL_loadbuffer( L, source, size, chunkname );
+	if( ret != 0 )
+		return ret;
+
+	std::shared_ptr<LuaBytecode> compiled( new LuaBytecode() );
+	compiled->source_size = size;
+	if( lua_dump( L, dumpWriter, &compiled->code ) != 0 || compiled->code.empty() )
+		return 0;
+
+	_stat_bytecode_compiles.add();
+	{
+		std::lock_guard<std::mutex> lock( _s_mutex );
+		_s_cache[ key ] = compiled;
+		directory = _s_directory;
+	}
+
+	// 磁盘写入在锁外进行，不阻塞其它线程的查找
+	if( !directory.empty() )
+		writeCacheFile( directory, key, *compiled );
+	return 0;
+}
+
+int LuaBytecodeCache::loadFile( lua_State* L, const char* lfile )
+{
+	MAGICAL_ASSERT( lfile, "lfile should not be nullptr" );
+
+	// 经过Assets加载，相对路径先查找已挂载的资源包，数据结尾多出的0不属于源码
+	magical::Ptr<magical::Data> data = magical::Assets::tryLoadFile( lfile );
+	if( !data )
+	{
+		lua_pushfstring( L, "cannot open %s", lfile );
+		return LUA_ERRFILE;
+	}
+
+	const char* content = data->cPtr();
+	size_t size = data->size() - 1;
+
+	// 与luaL_loadfile相同跳过第一行的#，保留换行使行号不变
+	size_t skip = 0;
+	if( size > 0 && content[0] == '#' )
+	{
+		const char* newline = (const char*) memchr( content, '\n', size );
+		skip = newline ? newline - content : size;
+	}
+
+	std::string chunkname = std::string( "@" ) + lfile;
+	return load( L, content + skip, size - skip, chunkname.c_str() );
+}
+
+void LuaBytecodeCache::installLoader( lua_State* L )
+{
+	lua_getglobal( L, LUA_LOADLIBNAME );
+	lua_getfield( L, -1, "loaders" );
+	MAGICAL_ASSERT( lua_istable( L, -1 ), "package.loaders should be a table" );
+
+	// 第2个是package.path的加载器，第1个是package.preload
+	lua_pushcfunction( L, lua_bytecode_loader );
+	lua_rawseti( L, -2, 2 );
+	lua_pop( L, 2 );
+}
+
+void LuaBytecodeCache::setDirectory( const char* path )
+{
+	std::lock_guard<std::mutex> lock( _s_mutex );
+	_s_directory = path ? path : "";
+}
+
+std::string LuaBytecodeCache::getDirectory( void )
+{
+	std::lock_guard<std::mutex> lock( _s_mutex );
+	return _s_directory;
+}
+
+void LuaBytecodeCache::clear( void )
+{
+	std::lock_guard<std::mutex> lock( _s_mutex );
+	_s_cache.clear();
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __LUA_BYTECODE_CACHE_H__
+#define __LUA_BYTECODE_CACHE_H__
+
+#include "magical-macros.h"
+#include "Common.h"
+
+#include "LuaMacros.h"
+
+/*
+脚本编译结果的缓存
+
+以源码内容和chunkname的哈希为键保存lua_dump输出的字节码，命中时直接加载字节码，不经过语法分析；
+字节码保存在内存中供同一进程内的其它状态（如LuaWorkers的各线程）复用，
+设置了缓存目录时同时写入磁盘（在锁外先写临时文件再改名），下次启动时从磁盘读取；
+缓存文件损坏（字节码与文件头中的哈希不符）或与当前的Lua版本不兼容时重新编译并覆盖
+LuaState::runScriptFile和require查找package.path中的Lua文件时都经过这里，两者都由loadFile通过Assets::tryLoadFile读取，
+可以在多个线程同时使用；源码不经过只能在主线程使用的AssetsCache
+
+统计项：lua.bytecode.hits、lua.bytecode.disk_hits、lua.bytecode.compiles
+*/
+class LuaBytecodeCache
+{
+public:
+	// 与luaL_loadbuffer相同，成功时编译得到的函数留在栈顶
+	static int load( lua_State* L, const char* source, size_t size, const char* chunkname );
+	// 与luaL_loadfile相同，chunkname为"@"加文件名
+	static int loadFile( lua_State* L, const char* lfile );
+	// 替换package.loaders中查找package.path的加载器，由LuaState::openLibs调用
+	static void installLoader( lua_State* L );
+
+public:
+	// 磁盘缓存目录，目录需要已经存在，为nullptr时只缓存在内存中；
+	// 目录中的文件会直接作为字节码加载，应使用只有本程序写入的目录
+	static void setDirectory( const char* path );
+	static std::string getDirectory( void );
+	// 清空内存中的缓存，不删除磁盘上的文件
+	static void clear( void );
+};
+
+#endif //__LUA_BYTECODE_CACHE_H__
\ No newline at end of file
@@ -0,0 +1,156 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "LuaFFI.h"
+
+#ifdef MAGICAL_USING_LUAJIT
+
+#include <string.h>
+#include <stddef.h>
+
+#include "LuaState.h"
+#include "LuaValuePool.h"
+#include "tolua++.h"
+
+static_assert( sizeof( magical::Vector3 ) == sizeof( float ) * 3, "Vector3 layout mismatch with ffimath.lua" );
+static_assert( sizeof( magical::Quaternion ) == sizeof( float ) * 4, "Quaternion layout mismatch with ffimath.lua" );
+static_assert( offsetof( magical::Quaternion, w ) == sizeof( float ) * 3, "Quaternion layout mismatch with ffimath.lua" );
+static_assert( sizeof( magical::Matrix4x4 ) == sizeof( float ) * 16, "Matrix4x4 layout mismatch with ffimath.lua" );
+
+static const char* _s_ffi_module = "ffimath";
+static const char* _s_ffi_engine_module = "ffimath.engine";
+// 脚本中的类型名与tolua绑定一致
+static const char* _s_ffi_types[] = { "Vector3", "Quaternion", "Matrix4" };
+static const char* _s_ffi_ctypes[] = { "magical.ffi.Vector3", "magical.ffi.Quaternion", "magical.ffi.Matrix4" };
+
+template< class T >
+static int pushEngineValue( lua_State* L, const char* type )
+{
+	const T* value = LuaFFI::to<T>( L, 1 );
+	luaL_argcheck( L, value != nullptr, 1, "cdata expected" );
+
+	tolua_pushusertype( L, Mtolua_pool_new( (T)( *value ) ), type );
+	tolua_register_gc( L, lua_gettop( L ) );
+	return 1;
+}
+
+// cdata转换为tolua userdata，由ffimath.lua中各类型的toEngine()调用
+static int lua_ffi_vector3( lua_State* L )
+{
+	return pushEngineValue<magical::Vector3>( L, "Vector3" );
+}
+
+static int lua_ffi_quaternion( lua_State* L )
+{
+	return pushEngineValue<magical::Quaternion>( L, "Quaternion" );
+}
+
+static int lua_ffi_matrix4( lua_State* L )
+{
+	return pushEngineValue<magical::Matrix4x4>( L, "Matrix4" );
+}
+
+// ffimath.fromEngine( value )，tolua userdata转换为cdata
+static int lua_ffi_from_engine( lua_State* L )
+{
+	tolua_Error tolua_err;
+	if( tolua_isusertype( L, 1, "const Vector3", 0, &tolua_err ) )
+		LuaFFI::push( L, *(const magical::Vector3*) tolua_tousertype( L, 1, 0 ) );
+	else if( tolua_isusertype( L, 1, "const Quaternion", 0, &tolua_err ) )
+		LuaFFI::push( L, *(const magical::Quaternion*) tolua_tousertype( L, 1, 0 ) );
+	else if( tolua_isusertype( L, 1, "const Matrix4", 0, &tolua_err ) )
+		LuaFFI::push( L, *(const magical::Matrix4x4*) tolua_tousertype( L, 1, 0 ) );
+	else
+		return luaL_argerror( L, 1, "Vector3, Quaternion or Matrix4 expected" );
+	return 1;
+}
+
+static const luaL_Reg lua_ffi_functions[] = {
+	{ "vector3", lua_ffi_vector3 },
+	{ "quaternion", lua_ffi_quaternion },
+	{ "matrix4", lua_ffi_matrix4 },
+	{ "fromEngine", lua_ffi_from_engine },
+	{ nullptr, nullptr }
+};
+
+bool LuaFFI::open( LuaState* L )
+{
+	MAGICAL_ASSERT( L, "L should not be nullptr" );
+
+	lua_State* ls = L->cPtr();
+	int top = lua_gettop( ls );
+
+	// 转换函数先放入package.loaded，ffimath.lua加载时取用
+	lua_getglobal( ls, "package" );
+	lua_getfield( ls, -1, "loaded" );
+	lua_newtable( ls );
+	luaL_register( ls, nullptr, lua_ffi_functions );
+	lua_setfield( ls, -2, _s_ffi_engine_module );
+	lua_settop( ls, top );
+
+	lua_getglobal( ls, "require" );
+	lua_pushstring( ls, _s_ffi_module );
+	if( lua_pcall( ls, 1, 1, 0 ) != 0 )
+	{
+		magicalHandleLuaError( ls );
+		lua_settop( ls, top );
+		return false;
+	}
+
+	// ctype保存在注册表中供push使用；不设置同名全局变量，tolua绑定只接受userdata
+	for( int i = 0; i < 3; ++i )
+	{
+		lua_getfield( ls, -1, _s_ffi_types[i] );
+		lua_setfield( ls, LUA_REGISTRYINDEX, _s_ffi_ctypes[i] );
+	}
+
+	lua_settop( ls, top );
+	return true;
+}
+
+void LuaFFI::push( lua_State* L, const magical::Vector3& v )
+{
+	memcpy( newCData( L, _s_ffi_ctypes[0] ), &v, sizeof( v ) );
+}
+
+void LuaFFI::push( lua_State* L, const magical::Quaternion& q )
+{
+	memcpy( newCData( L, _s_ffi_ctypes[1] ), &q, sizeof( q ) );
+}
+
+void LuaFFI::push( lua_State* L, const magical::Matrix4x4& m )
+{
+	memcpy( newCData( L, _s_ffi_ctypes[2] ), &m, sizeof( m ) );
+}
+
+void* LuaFFI::newCData( lua_State* L, const char* ctype )
+{
+	// 不带参数调用ctype得到清零的cdata，随后整体拷贝，不逐个字段压栈
+	lua_getfield( L, LUA_REGISTRYINDEX, ctype );
+	MAGICAL_ASSERT( lua_isnil( L, -1 ) == 0, "LuaFFI::open() should be called first" );
+
+	lua_call( L, 0, 1 );
+	return (void*) lua_topointer( L, -1 );
+}
+
+#endif //MAGICAL_USING_LUAJIT
\ No newline at end of file
@@ -0,0 +1,83 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __LUA_FFI_H__
+#define __LUA_FFI_H__
+
+#include "magical-macros.h"
+#include "Common.h"
+
+#include "LuaMacros.h"
+
+#ifdef MAGICAL_USING_LUAJIT
+
+#include "magical-math.h"
+
+class LuaState;
+
+/*
+LuaJIT下的数学类型绑定，定义MAGICAL_USING_LUAJIT并链接LuaJIT 2.x代替script/lua时启用
+
+Vector3、Quaternion、Matrix4以FFI cdata结构体提供给脚本（require( "ffimath" )），内存布局与引擎类型一致，
+脚本中的运算和字段访问由JIT直接编译，不经过tolua的栈操作；
+tolua注册的全局Vector3、Quaternion、Matrix4保持不变，绑定的函数只接受userdata：
+cdata传入之前用toEngine()转换，userdata用ffimath.fromEngine()转换为cdata，各一次内存拷贝
+C++一侧只有显式调用push时才产生cdata，to()直接返回cdata的数据地址
+*/
+class LuaFFI
+{
+public:
+	// 在Lua::openBindings注册tolua绑定之后调用，不修改全局变量
+	static bool open( LuaState* L );
+
+public:
+	static void push( lua_State* L, const magical::Vector3& v );
+	static void push( lua_State* L, const magical::Quaternion& q );
+	static void push( lua_State* L, const magical::Matrix4x4& m );
+
+	/*
+	返回cdata的数据地址，不是cdata时返回nullptr
+	不检查具体的ctype，调用者需要保证类型一致
+	*/
+	template< class T >
+	static T* to( lua_State* L, int idx );
+
+private:
+	static void* newCData( lua_State* L, const char* ctype );
+};
+
+// LuaJIT的lua.h没有导出cdata的类型值
+#define MAGICAL_LUA_TCDATA 10
+
+template< class T >
+T* LuaFFI::to( lua_State* L, int idx )
+{
+	if( lua_type( L, idx ) != MAGICAL_LUA_TCDATA )
+		return nullptr;
+
+	return (T*) lua_topointer( L, idx );
+}
+
+#endif //MAGICAL_USING_LUAJIT
+
+#endif //__LUA_FFI_H__
\ No newline at end of file
@@ -0,0 +1,154 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "LuaField.h"
+#include "LuaState.h"
+#include "LuaObject.h"
+
+LuaField::LuaField( void )
+{
+
+}
+
+LuaField::LuaField( LuaState* L, const char* key )
+: _key( L, key )
+{
+
+}
+
+LuaField::LuaField( const LuaTable& lt, const char* key )
+: _table( lt )
+{
+	MAGICAL_ASSERT( lt != nullptr, "lt should not be nullptr" );
+	_key.bind( lt._ref->getState(), key );
+}
+
+LuaField::~LuaField( void )
+{
+
+}
+
+bool LuaField::operator==( std::nullptr_t nt ) const
+{
+	return _key == nullptr;
+}
+
+bool LuaField::operator!=( std::nullptr_t nt ) const
+{
+	return _key != nullptr;
+}
+
+bool LuaField::operator==( LuaT t ) const
+{
+	if( _key == nullptr )
+		return t == LuaT::Nil;
+
+	lua_State* L = _key.getState()->cPtr();
+	push();
+	bool ret = lua_type( L, -1 ) == (int) t;
+	lua_pop( L, 1 );
+	return ret;
+}
+
+void LuaField::release( void )
+{
+	_table.release();
+	_key.release();
+}
+
+void LuaField::push( void ) const
+{
+	MAGICAL_ASSERT( _key != nullptr, "field should not be empty!" );
+	lua_State* L = _key.getState()->cPtr();
+	if( _table == nullptr )
+	{
+		_key.push( L );
+		lua_gettable( L, LUA_GLOBALSINDEX );
+		return;
+	}
+
+	pushTable( L );
+	_key.push( L );
+	lua_gettable( L, -2 );
+	lua_remove( L, -2 );
+}
+
+LuaFunction LuaField::toLuaFunction( void ) const
+{
+	LuaFunction lf;
+	if( _key == nullptr )
+		return lf;
+
+	LuaState* state = _key.getState();
+	lua_State* L = state->cPtr();
+	push();
+
+	int handler = tolua_ext_tofunction( L, lua_gettop( L ), 0 );
+	if( handler != 0 )
+	{
+		lf.bind( state, handler );
+	}
+	lua_pop( L, 1 );
+	return lf;
+}
+
+LuaTable LuaField::toLuaTable( void ) const
+{
+	LuaTable lt;
+	if( _key == nullptr )
+		return lt;
+
+	LuaState* state = _key.getState();
+	lua_State* L = state->cPtr();
+	push();
+
+	int handler = tolua_ext_totable( L, lua_gettop( L ), 0 );
+	if( handler != 0 )
+	{
+		lt.bind( state, handler );
+	}
+	lua_pop( L, 1 );
+	return lt;
+}
+
+LuaObject LuaField::toLuaObject( void ) const
+{
+	LuaObject lobj;
+	if( _key == nullptr )
+		return lobj;
+
+	LuaState* state = _key.getState();
+	push();
+
+	lobj.set( state, -1 );
+	lua_pop( state->cPtr(), 1 );
+	return lobj;
+}
+
+void LuaField::pushTable( lua_State* L ) const
+{
+	if( _table == nullptr )
+		lua_pushvalue( L, LUA_GLOBALSINDEX );
+	else
+		tolua_ext_get_table_by_handler( L, _table._ref->getHandler() );
+}
\ No newline at end of file
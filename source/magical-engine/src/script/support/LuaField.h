@@ -0,0 +1,121 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __LUA_FIELD_H__
+#define __LUA_FIELD_H__
+
+#include "magical-macros.h"
+#include "Common.h"
+
+#include "LuaMacros.h"
+#include "LuaState.h"
+#include "LuaKey.h"
+#include "LuaTable.h"
+#include "LuaFunction.h"
+
+class LuaObject;
+
+/*
+缓存的字段访问，适合每帧都要访问的全局变量或table的字段
+
+所在的table和驻留的键在构造时解析一次，之后每次访问只有两次按整数索引的取值和一次不需要哈希的查找；
+缓存的是位置而不是值，脚本重新赋值（如热更新）后下一次访问得到新的值
+
+LuaField update( L["Game"].toLuaTable(), "update" );
+update.call<void>( dt );
+*/
+class LuaField
+{
+public:
+	LuaField( void );
+	// 全局变量
+	LuaField( LuaState* L, const char* key );
+	// table的字段
+	LuaField( const LuaTable& lt, const char* key );
+	~LuaField( void );
+
+public:
+	bool operator==( std::nullptr_t nt ) const;
+	bool operator!=( std::nullptr_t nt ) const;
+	bool operator==( LuaT t ) const;
+	void release( void );
+
+public:
+	// 字段的值压栈
+	void push( void ) const;
+	LuaFunction toLuaFunction( void ) const;
+	LuaTable toLuaTable( void ) const;
+	LuaObject toLuaObject( void ) const;
+
+	template< typename T >
+	void set( const T& value ) const
+	{
+		if( _key == nullptr )
+			return;
+
+		LuaState* state = _key.getState();
+		lua_State* L = state->cPtr();
+		pushTable( L );
+		_key.push( L );
+		state->push( value );
+		lua_settable( L, -3 );
+		lua_pop( L, 1 );
+	}
+
+	/*
+	调用字段中的函数，与LuaFunction::call相同，字段不是函数时记录错误并返回none()
+	*/
+	template< typename R, typename... Args >
+	R call( const Args&... args ) const
+	{
+		if( _key == nullptr )
+			return LuaReturn< R >::none();
+
+		LuaFunction::countCall();
+		LuaState* state = _key.getState();
+		lua_State* L = state->cPtr();
+		push();
+		pushArgs( state, args... );
+
+		if( lua_pcall( L, sizeof...( args ), LuaReturn< R >::Count, 0 ) == 0 )
+			return LuaReturn< R >::pop( L );
+
+		MAGICAL_SET_LAST_ERROR( lua_tostring( L, -1 ) );
+		MAGICAL_LOG_LAST_ERROR();
+		lua_pop( L, 1 );
+		return LuaReturn< R >::none();
+	}
+
+private:
+	void pushTable( lua_State* L ) const;
+	static inline void pushArgs( LuaState* state ) { }
+	template< typename T, typename... Args >
+	static void pushArgs( LuaState* state, const T& t, const Args&... args ) { state->push( t ); pushArgs( state, args... ); }
+
+private:
+	// 为nullptr时是全局变量
+	LuaTable _table;
+	LuaKey _key;
+};
+
+#endif //__LUA_FIELD_H__
\ No newline at end of file
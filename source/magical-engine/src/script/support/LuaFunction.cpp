@@ -24,6 +24,9 @@ SOFTWARE.
 #include "LuaFunction.h"
 #include "LuaState.h"
 #include "LuaObject.h"
+#include "Stats.h"
+
+static magical::Stat _stat_lua_calls( "lua.calls", magical::Stat::Counter );
 
 LuaFunction::LuaFunction( void )
 {
@@ -37,22 +40,15 @@ LuaFunction::LuaFunction( std::nullptr_t nt )
 
 LuaFunction::LuaFunction( LuaFunction&& lf )
 {
-	_L = lf._L;
-	_handler = lf._handler;
-	_reference_count = lf._reference_count;
-	
-	lf._L = nullptr;
-	lf._handler = 0;
-	lf._reference_count = nullptr;
+	_ref = lf._ref;
+	lf._ref = nullptr;
 }
 
 LuaFunction::LuaFunction( const LuaFunction& lf )
 {
-	_L = lf._L;
-	_handler = lf._handler;
-	_reference_count = lf._reference_count;
-
-	++( *_reference_count );
+	_ref = lf._ref;
+	if( _ref )
+		_ref->retain();
 }
 
 LuaFunction::~LuaFunction( void )
@@ -62,25 +58,22 @@ LuaFunction::~LuaFunction( void )
 
 LuaFunction& LuaFunction::operator=( LuaFunction&& lf )
 {
-	release();
-	_L = lf._L;
-	_handler = lf._handler;
-	_reference_count = lf._reference_count;
-
-	lf._handler = 0;
-	lf._L = nullptr;
-	lf._reference_count = nullptr;
+	if( this != &lf )
+	{
+		release();
+		_ref = lf._ref;
+		lf._ref = nullptr;
+	}
 	return *this;
 }
 
 LuaFunction& LuaFunction::operator=( const LuaFunction& lf )
 {
-	release();
-	_L = lf._L;
-	_handler = lf._handler;
-	_reference_count = lf._reference_count;
+	if( lf._ref )
+		lf._ref->retain();
 
-	++( *_reference_count );
+	release();
+	_ref = lf._ref;
 	return *this;
 }
 
@@ -92,100 +85,64 @@ LuaFunction& LuaFunction::operator=( std::nullptr_t nt )
 
 bool LuaFunction::operator==( std::nullptr_t nt ) const
 {
-	return !( _L && _handler );
+	return _ref == nullptr;
 }
 
 bool LuaFunction::operator!=( std::nullptr_t nt ) const
 {
-	return _L && _handler;
+	return _ref != nullptr;
 }
 
 void LuaFunction::bind( LuaState* L, LuaFunctionHandler handler )
 {
-	magicalAssert( L && handler, "invalid lua state or lua function handler" );
+	MAGICAL_ASSERT( L && handler, "invalid lua state or lua function handler" );
 	release();
 
-	_L = L;
-	_L->retain();
-	_handler = handler;
-	_reference_count = new int( 1 );
+	_ref = LuaReference::create( L, handler, LuaReference::Function );
 }
 
 void LuaFunction::release( void )
 {
-	if( !_reference_count )
+	if( !_ref )
 		return;
 
-	magicalAssert( *_reference_count > 0, "invalid lua function _reference_count." );
-	--( *_reference_count );
-
-	if( *_reference_count == 0 )
-	{
-		magicalAssert( _L && _handler, "invaild lua state or lua function handler" );
-		tolua_ext_remove_function_by_handler( _L->cPtr(), _handler );
-
-		_L->release();
-		delete _reference_count;
-	}
-
-	_L = nullptr;
-	_handler = 0;
-	_reference_count = nullptr;
+	_ref->release();
+	_ref = nullptr;
 }
 
 LuaObject LuaFunction::returnCall( void ) const
 {
 	LuaObject lobj;
-	lua_State* L = _L->cPtr();
-	switch( lua_type( L, -1 ) )
-	{
-	case LUA_TNIL:
-		lobj = nullptr;
-		break;
-	case LUA_TBOOLEAN:
-		lobj = (bool) lua_toboolean( L, -1 );
-		break;
-	case LUA_TNUMBER:
-		lobj = (double) lua_tonumber( L, -1 );
-		break;
-	case LUA_TSTRING:
-		lobj = lua_tostring( L, -1 );
-		break;
-	case LUA_TUSERDATA:
-		{
-			int top = lua_gettop( L );
-			std::string type = tolua_typename( L, top );
-			lua_pop( L, 1 );
-			void* userdata = tolua_tousertype( L, top, 0 );
-			lobj.set( userdata, type.c_str() );
-		}
-		break;
-	case LUA_TFUNCTION:
-		{
-			LuaFunction lf;
-			int handler = tolua_ext_tofunction( L, lua_gettop( L ), 0 );
-			if( handler != 0 )
-			{
-				lf.bind( _L, handler );
-			}
-			lobj = lf;
-		}
-		break;
-	case LUA_TTABLE:
-		{
-			LuaTable lt;
-			int handler = tolua_ext_totable( L, lua_gettop( L ), 0 );
-			if( handler != 0 )
-			{
-				lt.bind( _L, handler );
-			}
-			lobj = lt;
-		}
-		break;
-	default:
-		lobj = nullptr;
-		break;
-	}
+	LuaState* state = _ref->getState();
+	lua_State* L = state->cPtr();
+	lobj.set( state, -1 );
 	lua_pop( L, 1 );
 	return lobj;
+}
+
+void LuaFunction::countCall( void )
+{
+	_stat_lua_calls.add();
+}
+
+LuaFunction::Pinned::Pinned( const LuaFunction& lf )
+{
+	if( !lf._ref )
+		return;
+
+	_state = lf._ref->getState();
+	lua_State* L = _state->cPtr();
+	tolua_ext_get_function_by_handler( L, lf._ref->getHandler() );
+	_slot = lua_gettop( L );
+}
+
+LuaFunction::Pinned::~Pinned( void )
+{
+	if( _slot == 0 )
+		return;
+
+	// 槽位之上可能还有调用者压入的值，按位置移除而不是弹出栈顶
+	lua_State* L = _state->cPtr();
+	MAGICAL_ASSERT( lua_gettop( L ) >= _slot && lua_isfunction( L, _slot ), "pinned slot was popped" );
+	lua_remove( L, _slot );
 }
\ No newline at end of file
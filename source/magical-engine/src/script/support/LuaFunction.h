@@ -24,15 +24,70 @@ SOFTWARE.
 #ifndef __LUA_FUNCTION_H__
 #define __LUA_FUNCTION_H__
 
-#include "PlatformMacros.h"
+#include "magical-macros.h"
 #include "Common.h"
 
 #include "LuaMacros.h"
+#include "LuaReference.h"
+#include "LuaState.h"
 //#include "LuaObject.h"
 
-class LuaState;
 class LuaObject;
 
+/*
+call<R>的返回值转换，直接读取栈顶的值并弹出，类型不匹配或调用失败时返回none()
+*/
+template< typename R > struct LuaReturn;
+
+template<> struct LuaReturn< void >
+{
+	enum { Count = 0 };
+	static inline void pop( lua_State* L ) {}
+	static inline void none( void ) {}
+};
+
+template<> struct LuaReturn< bool >
+{
+	enum { Count = 1 };
+	static inline bool pop( lua_State* L ) { bool ret = lua_toboolean( L, -1 ) != 0; lua_pop( L, 1 ); return ret; }
+	static inline bool none( void ) { return false; }
+};
+
+template<> struct LuaReturn< int >
+{
+	enum { Count = 1 };
+	static inline int pop( lua_State* L ) { int ret = (int) lua_tointeger( L, -1 ); lua_pop( L, 1 ); return ret; }
+	static inline int none( void ) { return 0; }
+};
+
+template<> struct LuaReturn< float >
+{
+	enum { Count = 1 };
+	static inline float pop( lua_State* L ) { float ret = (float) lua_tonumber( L, -1 ); lua_pop( L, 1 ); return ret; }
+	static inline float none( void ) { return 0.0f; }
+};
+
+template<> struct LuaReturn< double >
+{
+	enum { Count = 1 };
+	static inline double pop( lua_State* L ) { double ret = (double) lua_tonumber( L, -1 ); lua_pop( L, 1 ); return ret; }
+	static inline double none( void ) { return 0.0; }
+};
+
+template<> struct LuaReturn< std::string >
+{
+	enum { Count = 1 };
+	static inline std::string pop( lua_State* L )
+	{
+		size_t len = 0;
+		const char* str = lua_tolstring( L, -1, &len );
+		std::string ret = str ? std::string( str, len ) : std::string();
+		lua_pop( L, 1 );
+		return ret;
+	}
+	static inline std::string none( void ) { return std::string(); }
+};
+
 class LuaFunction
 {
 public:
@@ -52,39 +107,87 @@ public:
 	void release( void );
 
 public:
+	// 返回LuaObject，定义在LuaObject.h中
 	template< typename... Args >
-	auto operator()( const Args&... args ) const -> decltype( returnCall() )
+	LuaObject operator()( const Args&... args ) const;
+
+	/*
+	按类型取返回值的调用，不构造LuaObject，参数和返回值都是数值时不会分配内存
+
+	lf.call<void>( entity, dt );
+	float speed = lf.call<float>( "speed" );
+	*/
+	template< typename R, typename... Args >
+	R call( const Args&... args ) const
 	{
-		if( !_L || !_handler ) 
-			return nullptr;
+		if( !_ref )
+			return LuaReturn< R >::none();
 
-		lua_State* L = _L->cPtr();
-		tolua_ext_get_function_by_handler( L, _handler );
-		pushArgs( args... );
+		tolua_ext_get_function_by_handler( _ref->getState()->cPtr(), _ref->getHandler() );
+		return invoke< R >( _ref->getState(), args... );
+	}
+
+	/*
+	同一个函数连续调用多次时，构造时把函数压在栈上的一个槽位中，每次调用只lua_pushvalue，
+	不再按handler从注册表取出；析构时移除该槽位，期间可以正常使用栈，但不能弹出该槽位
+
+	LuaFunction::Pinned pinned( lf );
+	for( auto entity : entities )
+		pinned.call<void>( entity, dt );
+	*/
+	class Pinned
+	{
+	public:
+		explicit Pinned( const LuaFunction& lf );
+		~Pinned( void );
+		Pinned( const Pinned& pinned ) = delete;
+		Pinned& operator=( const Pinned& pinned ) = delete;
+
+	public:
+		template< typename R, typename... Args >
+		R call( const Args&... args ) const
+		{
+			if( _slot == 0 )
+				return LuaReturn< R >::none();
+
+			lua_pushvalue( _state->cPtr(), _slot );
+			return invoke< R >( _state, args... );
+		}
+
+	private:
+		LuaState* _state = nullptr;
+		int _slot = 0;
+	};
 
-		int ret = lua_pcall( L, sizeof...( args ), 1, 0 );
-		if( ret == 0 )
-			return returnCall();
+private:
+	// 函数已在栈顶，压入参数调用并转换返回值
+	template< typename R, typename... Args >
+	static R invoke( LuaState* state, const Args&... args )
+	{
+		countCall();
+		lua_State* L = state->cPtr();
+		pushArgs( state, args... );
 
-		magicalSetLastErrorInfoB( lua_tostring( L, -1 ) );
-		magicalLogLastError();
+		if( lua_pcall( L, sizeof...( args ), LuaReturn< R >::Count, 0 ) == 0 )
+			return LuaReturn< R >::pop( L );
+
+		MAGICAL_SET_LAST_ERROR( lua_tostring( L, -1 ) );
+		MAGICAL_LOG_LAST_ERROR();
 		lua_pop( L, 1 );
-		return nullptr;
+		return LuaReturn< R >::none();
 	}
 
-private:
-	inline void pushArgs( void ) const { };
-	template< typename T >
-	void pushArgs( const T& t ) const { _L->push( t ); }
+	static inline void pushArgs( LuaState* state ) { }
 	template< typename T, typename... Args >
-	void pushArgs( const T& t, const Args&... args ) const { _L->push( t ); pushArgs( args... ); }
+	static void pushArgs( LuaState* state, const T& t, const Args&... args ) { state->push( t ); pushArgs( state, args... ); }
 	LuaObject returnCall( void ) const;
+	static void countCall( void );
 
 private:
 	friend class LuaState;
-	LuaState* _L = nullptr;
-	LuaFunctionHandler _handler = 0;
-	int* _reference_count = nullptr;
+	friend class LuaObject;
+	friend class LuaField;
+	LuaReference* _ref = nullptr;
 };
 
 #endif //__LUA_FUNCTION_H__
\ No newline at end of file
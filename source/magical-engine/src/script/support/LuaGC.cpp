@@ -0,0 +1,182 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "LuaGC.h"
+#include "Director.h"
+#include "Utils.h"
+#include "Profiler.h"
+#include "Stats.h"
+
+#include "lua.hpp"
+
+// 单次步进的范围，KB
+static const int _s_min_step_kb = 4;
+static const int _s_max_step_kb = 1024;
+// 回收速度相对分配速度的倍数，与Lua默认的stepmul一致
+static const int _s_pace = 2;
+
+static LuaState* _s_L = nullptr;
+static int64_t _s_budget = LuaGC::DefaultBudget;
+static int64_t _s_last_full_collect_time = 0;
+static int _s_last_heap_kb = 0;
+static int _s_debt_kb = 0;
+static int _s_step_kb = 64;
+// 平滑后的每KB步进耗时，纳秒
+static int64_t _s_ns_per_kb = 0;
+
+static magical::Stat _stat_gc_step_us( "lua.gc.step_us", magical::Stat::Gauge );
+static magical::Stat _stat_gc_steps( "lua.gc.steps", magical::Stat::Counter );
+static magical::Stat _stat_gc_cycles( "lua.gc.cycles", magical::Stat::Counter );
+static magical::Stat _stat_gc_debt_kb( "lua.gc.debt_kb", magical::Stat::Gauge );
+static magical::Stat _stat_gc_alloc_kb( "lua.gc.alloc_kb", magical::Stat::Gauge );
+static magical::Stat _stat_gc_full_us( "lua.gc.full_us", magical::Stat::Gauge );
+
+// 手动步进和完整回收之后Lua会重新设置自动回收的阈值，需要再次关闭
+static void stopAutoCollect( lua_State* L )
+{
+	lua_gc( L, LUA_GCSTOP, 0 );
+	_s_last_heap_kb = lua_gc( L, LUA_GCCOUNT, 0 );
+}
+
+void LuaGC::init( LuaState* L )
+{
+	MAGICAL_ASSERT( L, "L should not be nullptr" );
+
+	_s_L = L;
+	_s_L->retain();
+	_s_debt_kb = 0;
+	stopAutoCollect( _s_L->cPtr() );
+
+	magical::Director::addHook( magical::Director::FrameEnd, LuaGC::step );
+	magical::Director::addHook( magical::Director::SceneChanged, LuaGC::fullCollect );
+}
+
+void LuaGC::delc( void )
+{
+	if( _s_L == nullptr )
+		return;
+
+	magical::Director::removeHook( magical::Director::FrameEnd, LuaGC::step );
+	magical::Director::removeHook( magical::Director::SceneChanged, LuaGC::fullCollect );
+
+	lua_gc( _s_L->cPtr(), LUA_GCRESTART, 0 );
+	_s_L->release();
+	_s_L = nullptr;
+}
+
+void LuaGC::step( void )
+{
+	if( _s_L == nullptr )
+		return;
+
+	MAGICAL_PROFILE_SCOPE( "LuaGC::step" );
+
+	lua_State* L = _s_L->cPtr();
+	int64_t begin = magical::Time::currentMicroseconds();
+	int heap_kb = lua_gc( L, LUA_GCCOUNT, 0 );
+	int allocated_kb = heap_kb > _s_last_heap_kb ? heap_kb - _s_last_heap_kb : 0;
+	int new_debt_kb = allocated_kb * _s_pace;
+	_s_debt_kb += new_debt_kb;
+
+	// 欠账多于本帧新增的部分说明回收没有跟上分配，按比例放宽这一帧的预算
+	int64_t budget = _s_budget;
+	if( _s_debt_kb > new_debt_kb )
+	{
+		int64_t scale = new_debt_kb > 0 ? _s_debt_kb / new_debt_kb : MaxBudgetScale;
+		budget *= scale < MaxBudgetScale ? scale : MaxBudgetScale;
+	}
+
+	int64_t now = begin;
+	while( _s_debt_kb > 0 && now - begin < budget )
+	{
+		int step_kb = _s_step_kb;
+		bool cycle_end = lua_gc( L, LUA_GCSTEP, step_kb ) != 0;
+		int64_t end = magical::Time::currentMicroseconds();
+		_stat_gc_steps.add();
+
+		// 按实测耗时调整步长，使一次步进约占预算的四分之一
+		int64_t ns_per_kb = ( end - now ) * 1000 / step_kb;
+		_s_ns_per_kb = _s_ns_per_kb == 0 ? ns_per_kb : ( _s_ns_per_kb * 3 + ns_per_kb ) / 4;
+		if( _s_ns_per_kb > 0 )
+		{
+			int64_t target = _s_budget * 1000 / 4 / _s_ns_per_kb;
+			_s_step_kb = (int) ( target < _s_min_step_kb ? _s_min_step_kb : target > _s_max_step_kb ? _s_max_step_kb : target );
+		}
+		else
+		{
+			_s_step_kb = _s_max_step_kb;
+		}
+
+		now = end;
+		_s_debt_kb -= step_kb;
+		if( cycle_end )
+		{
+			// 一轮回收结束，之前的欠账已经全部回收
+			_stat_gc_cycles.add();
+			_s_debt_kb = 0;
+			break;
+		}
+	}
+
+	if( _s_debt_kb < 0 )
+		_s_debt_kb = 0;
+
+	stopAutoCollect( L );
+	_stat_gc_step_us.set( now - begin );
+	_stat_gc_debt_kb.set( _s_debt_kb );
+	_stat_gc_alloc_kb.set( allocated_kb );
+}
+
+void LuaGC::fullCollect( void )
+{
+	if( _s_L == nullptr )
+		return;
+
+	MAGICAL_PROFILE_SCOPE( "LuaGC::fullCollect" );
+
+	lua_State* L = _s_L->cPtr();
+	int64_t begin = magical::Time::currentMicroseconds();
+	lua_gc( L, LUA_GCCOLLECT, 0 );
+	_s_last_full_collect_time = magical::Time::currentMicroseconds() - begin;
+	_s_debt_kb = 0;
+
+	stopAutoCollect( L );
+	_stat_gc_cycles.add();
+	_stat_gc_full_us.set( _s_last_full_collect_time );
+}
+
+void LuaGC::setBudget( int64_t microseconds )
+{
+	MAGICAL_ASSERT( microseconds > 0, "budget should be positive" );
+	_s_budget = microseconds;
+}
+
+int64_t LuaGC::getBudget( void )
+{
+	return _s_budget;
+}
+
+int64_t LuaGC::getLastFullCollectTime( void )
+{
+	return _s_last_full_collect_time;
+}
\ No newline at end of file
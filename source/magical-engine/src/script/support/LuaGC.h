@@ -0,0 +1,66 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __LUA_GC_H__
+#define __LUA_GC_H__
+
+#include "magical-macros.h"
+#include "Common.h"
+#include "LuaState.h"
+
+/*
+按帧调度的Lua垃圾回收
+
+关闭Lua自带的自动步进，改为每帧结束时在时间预算内调用lua_gc( LUA_GCSTEP )，
+避免回收在一帧中间的任意位置触发造成卡顿；切换场景时做一次完整回收
+每帧的回收量按上一帧的分配量计算，未完成的部分累计到下一帧，积累过多时临时放宽预算；
+单次步进的大小根据实测的耗时调整，使预算不被一次步进用完
+
+统计项：lua.gc.step_us、lua.gc.steps、lua.gc.cycles、lua.gc.debt_kb、lua.gc.alloc_kb、lua.gc.full_us
+*/
+class LuaGC
+{
+public:
+	static const int64_t DefaultBudget = 1000;
+	// 回收落后于分配时，一帧的预算最多放宽到的倍数
+	static const int64_t MaxBudgetScale = 4;
+
+public:
+	static void init( LuaState* L );
+	static void delc( void );
+
+public:
+	// 每帧调用一次，由Director::FrameEnd触发
+	static void step( void );
+	// 完整回收，由Director::SceneChanged触发，也可以在加载画面等时机主动调用
+	static void fullCollect( void );
+
+public:
+	// 每帧回收的时间预算，微秒
+	static void setBudget( int64_t microseconds );
+	static int64_t getBudget( void );
+	// 上一次完整回收的耗时，微秒
+	static int64_t getLastFullCollectTime( void );
+};
+
+#endif //__LUA_GC_H__
\ No newline at end of file
@@ -0,0 +1,120 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "LuaKey.h"
+#include "LuaState.h"
+
+LuaKey::LuaKey( void )
+{
+
+}
+
+LuaKey::LuaKey( LuaState* L, const char* key )
+{
+	bind( L, key );
+}
+
+LuaKey::LuaKey( LuaKey&& lk )
+: _slot( lk._slot )
+{
+	lk._slot = nullptr;
+}
+
+LuaKey::LuaKey( const LuaKey& lk )
+{
+	*this = lk;
+}
+
+LuaKey::~LuaKey( void )
+{
+	release();
+}
+
+LuaKey& LuaKey::operator=( LuaKey&& lk )
+{
+	if( this != &lk )
+	{
+		release();
+		_slot = lk._slot;
+		lk._slot = nullptr;
+	}
+	return *this;
+}
+
+LuaKey& LuaKey::operator=( const LuaKey& lk )
+{
+	if( _slot == lk._slot )
+		return *this;
+
+	// 共享槽位，不再占用新的注册表索引
+	release();
+	_slot = lk._slot;
+	if( _slot )
+		++ _slot->count;
+	return *this;
+}
+
+bool LuaKey::operator==( std::nullptr_t nt ) const
+{
+	return _slot == nullptr;
+}
+
+bool LuaKey::operator!=( std::nullptr_t nt ) const
+{
+	return _slot != nullptr;
+}
+
+const std::string& LuaKey::getName( void ) const
+{
+	static const std::string empty;
+	return _slot ? _slot->name : empty;
+}
+
+void LuaKey::bind( LuaState* L, const char* key )
+{
+	MAGICAL_ASSERT( L && key && *key, "invalid lua state or key" );
+	release();
+
+	lua_State* ls = L->cPtr();
+	lua_pushstring( ls, key );
+	_slot = new Slot();
+	_slot->L = L;
+	_slot->ref = luaL_ref( ls, LUA_REGISTRYINDEX );
+	_slot->count = 1;
+	_slot->name = key;
+	L->retain();
+}
+
+void LuaKey::release( void )
+{
+	if( _slot == nullptr )
+		return;
+
+	if( -- _slot->count == 0 )
+	{
+		luaL_unref( _slot->L->cPtr(), LUA_REGISTRYINDEX, _slot->ref );
+		_slot->L->release();
+		delete _slot;
+	}
+	_slot = nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __LUA_KEY_H__
+#define __LUA_KEY_H__
+
+#include "magical-macros.h"
+#include "Common.h"
+
+#include "LuaMacros.h"
+
+class LuaState;
+
+/*
+预先驻留的字符串键
+
+构造时把键压入一次并保存在注册表中，之后按整数索引取出同一个Lua字符串，
+查找时直接使用字符串中已经算好的哈希，不再经过lua_pushstring的哈希和比较；
+键只能用于创建它的LuaState，复制的键共享同一个注册表槽位，最后一个副本释放时才移除
+
+键持有LuaState的引用，应作为与脚本对象同生命周期的成员，在Lua::delc之前全部释放；
+静态的LuaKey会让共享状态一直存活到进程退出
+
+_key_update.bind( L, "update" ); // 成员变量，随脚本对象一起释放
+lt[ _key_update ].toLuaFunction();
+*/
+class LuaKey
+{
+public:
+	LuaKey( void );
+	LuaKey( LuaState* L, const char* key );
+	LuaKey( LuaKey&& lk );
+	LuaKey( const LuaKey& lk );
+	~LuaKey( void );
+
+public:
+	LuaKey& operator=( LuaKey&& lk );
+	LuaKey& operator=( const LuaKey& lk );
+	bool operator==( std::nullptr_t nt ) const;
+	bool operator!=( std::nullptr_t nt ) const;
+	void bind( LuaState* L, const char* key );
+	void release( void );
+
+public:
+	inline LuaState* getState( void ) const { return _slot ? _slot->L : nullptr; }
+	inline int getRef( void ) const { return _slot ? _slot->ref : LUA_NOREF; }
+	const std::string& getName( void ) const;
+	// 键的字符串压栈
+	inline void push( lua_State* L ) const { lua_rawgeti( L, LUA_REGISTRYINDEX, _slot->ref ); }
+
+private:
+	// 只在所属LuaState的线程中使用，引用计数不需要原子操作
+	struct Slot
+	{
+		LuaState* L;
+		int ref;
+		int count;
+		std::string name;
+	};
+	Slot* _slot = nullptr;
+};
+
+#endif //__LUA_KEY_H__
\ No newline at end of file
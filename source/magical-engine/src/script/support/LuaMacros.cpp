@@ -24,7 +24,7 @@ SOFTWARE.
 #include "LuaMacros.h"
 #include "tolua++.h"
 #include "tolua_ext.h"
-#include "LogSystem.h"
+#include "Log.h"
 
 #ifdef MAGICAL_DEBUG
 
@@ -32,9 +32,10 @@ void magicalLuaStateDump( lua_State* L )
 {
 	int i = 0;
 	int top = lua_gettop( L );
+	char buffer[ 256 ];
 
-	magicalFormat( "Total [%d] in lua stack: ", top );
-	magicalLog( magicalBuffer );
+	snprintf( buffer, sizeof( buffer ), "Total [%d] in lua stack: ", top );
+	MAGICAL_LOGD( buffer );
 
 	for( i = -1; i >= -top; i-- )
 	{
@@ -42,24 +43,24 @@ void magicalLuaStateDump( lua_State* L )
 		switch( t )
 		{
 		case LUA_TNIL:
-			magicalFormat( "[%02d] nil", i );
+			snprintf( buffer, sizeof( buffer ), "[%02d] nil", i );
 			break;
 		case LUA_TSTRING:
-			magicalFormat( "[%02d] string %s", i, lua_tostring( L, i ) );
+			snprintf( buffer, sizeof( buffer ), "[%02d] string %s", i, lua_tostring( L, i ) );
 			break;
 		case LUA_TBOOLEAN:
-			magicalFormat( "[%02d] boolean %s", i, lua_toboolean( L, i ) ? "true" : "false" );
+			snprintf( buffer, sizeof( buffer ), "[%02d] boolean %s", i, lua_toboolean( L, i ) ? "true" : "false" );
 			break;
 		case LUA_TNUMBER:
-			magicalFormat( "[%02d] number %g", i, lua_tonumber( L, i ) );
+			snprintf( buffer, sizeof( buffer ), "[%02d] number %g", i, lua_tonumber( L, i ) );
 			break;
 		default:
-			magicalFormat( "[%02d] %s", i, lua_typename( L, t ) );
+			snprintf( buffer, sizeof( buffer ), "[%02d] %s", i, lua_typename( L, t ) );
 		}
-		magicalLog( magicalBuffer );
+		MAGICAL_LOGD( buffer );
 	}
 
-	magicalLog( "-----------------------" );
+	MAGICAL_LOGD( "-----------------------" );
 }
 
 #endif
@@ -69,8 +70,7 @@ void magicalHandleLuaError( lua_State* L )
 	if( lua_type( L, -1 ) == LUA_TSTRING )
 	{
 		const char* info = lua_tostring( L, -1 );
-		magicalSetLastErrorInfo( info );
-		magicalLogLastError();
-		lua_pop( L, -1 );
+		MAGICAL_SET_LAST_ERROR( info );
+		MAGICAL_LOG_LAST_ERROR();
 	}
 }
\ No newline at end of file
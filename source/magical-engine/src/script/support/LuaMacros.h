@@ -24,12 +24,14 @@ SOFTWARE.
 #ifndef __LUA_MACROS_H__
 #define __LUA_MACROS_H__
 
-#include "PlatformMacros.h"
+#include "magical-macros.h"
 #include "Common.h"
 #include "lua.hpp"
 #include "tolua++.h"
 #include "tolua_ext.h"
 
+USING_NS_MAGICAL;
+
 #define kLuaOnCreate  "onCreate"
 #define kLuaOnUpdate  "onUpdate";
 #define kLuaOnDestroy "onDestroy"
@@ -48,7 +50,7 @@ enum class LuaT
 #ifndef MAGICAL_DEBUG
 #define magicalLuaStateDump( __L )
 #else
-MAGICALAPI_USER void magicalLuaStateDump( lua_State* L );
+MAGICALAPI void magicalLuaStateDump( lua_State* L );
 #endif
 
 MAGICALAPI void magicalHandleLuaError( lua_State* L );
@@ -0,0 +1,343 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "LuaMessage.h"
+#include <string.h>
+#include <math.h>
+
+/*
+每个值以一个字节的标记开头：
+number之后是8字节的double，string之后是4字节的长度、内容和结尾的0，
+table之后是数组部分和哈希部分的大小各4字节，然后是成对的键和值，以TagEnd结束
+*/
+enum : char
+{
+	TagNil,
+	TagFalse,
+	TagTrue,
+	TagNumber,
+	TagString,
+	TagTable,
+	TagEnd,
+};
+
+void LuaMessage::clear( void )
+{
+	_buffer.clear();
+	_tables.clear();
+}
+
+void LuaMessage::append( const LuaMessage& msg )
+{
+	MAGICAL_ASSERT( msg._tables.empty(), "append an incomplete message" );
+	_buffer.append( msg._buffer );
+}
+
+/*
+记录当前table中写入的值，偶数位置是键，正整数的键计入数组部分，
+push时据此预先分配table的大小
+*/
+void LuaMessage::count( bool array_key )
+{
+	if( _tables.empty() )
+		return;
+
+	OpenTable& table = _tables.back();
+	if( ( table.values ++ & 1 ) == 0 && array_key )
+		++ table.narray;
+}
+
+void LuaMessage::writeNil( void )
+{
+	count( false );
+	_buffer.push_back( TagNil );
+}
+
+void LuaMessage::writeBoolean( bool b )
+{
+	count( false );
+	_buffer.push_back( b ? TagTrue : TagFalse );
+}
+
+void LuaMessage::writeNumber( double num )
+{
+	count( num >= 1 && floor( num ) == num );
+	_buffer.push_back( TagNumber );
+	_buffer.append( (const char*) &num, sizeof( num ) );
+}
+
+void LuaMessage::writeString( const char* str )
+{
+	MAGICAL_ASSERT( str, "str should not be nullptr" );
+	writeString( str, strlen( str ) );
+}
+
+void LuaMessage::writeString( const char* str, size_t len )
+{
+	count( false );
+
+	uint32_t length = (uint32_t) len;
+	_buffer.push_back( TagString );
+	_buffer.append( (const char*) &length, sizeof( length ) );
+	_buffer.append( str, len );
+	_buffer.push_back( 0 );
+}
+
+void LuaMessage::beginTable( void )
+{
+	count( false );
+	MAGICAL_ASSERT( _tables.size() < MaxDepth, "table nested too deep" );
+
+	OpenTable table = { _buffer.size(), 0, 0 };
+	_tables.push_back( table );
+
+	uint32_t sizes[2] = { 0, 0 };
+	_buffer.push_back( TagTable );
+	_buffer.append( (const char*) sizes, sizeof( sizes ) );
+}
+
+void LuaMessage::endTable( void )
+{
+	MAGICAL_ASSERT( !_tables.empty(), "endTable() without beginTable()" );
+
+	const OpenTable& table = _tables.back();
+	MAGICAL_ASSERT( ( table.values & 1 ) == 0, "table key without value" );
+
+	uint32_t sizes[2] = { table.narray, table.values / 2 - table.narray };
+	memcpy( &_buffer[ table.offset + 1 ], sizes, sizeof( sizes ) );
+	_buffer.push_back( TagEnd );
+	_tables.pop_back();
+}
+
+bool LuaMessage::write( lua_State* L, int idx )
+{
+	if( idx < 0 && idx > LUA_REGISTRYINDEX )
+		idx = lua_gettop( L ) + idx + 1;
+
+	// 失败时只有调用前最内层的table的计数可能被修改过
+	size_t size = _buffer.size();
+	size_t depth = _tables.size();
+	OpenTable saved = depth > 0 ? _tables.back() : OpenTable();
+
+	if( writeValue( L, idx, (int) depth ) )
+		return true;
+
+	_buffer.resize( size );
+	_tables.resize( depth );
+	if( depth > 0 )
+		_tables.back() = saved;
+	return false;
+}
+
+bool LuaMessage::writeValue( lua_State* L, int idx, int depth )
+{
+	switch( lua_type( L, idx ) )
+	{
+	case LUA_TNIL:
+		writeNil();
+		return true;
+	case LUA_TBOOLEAN:
+		writeBoolean( lua_toboolean( L, idx ) != 0 );
+		return true;
+	case LUA_TNUMBER:
+		writeNumber( (double) lua_tonumber( L, idx ) );
+		return true;
+	case LUA_TSTRING:
+		{
+			size_t len = 0;
+			const char* str = lua_tolstring( L, idx, &len );
+			writeString( str, len );
+		}
+		return true;
+	case LUA_TTABLE:
+		break;
+	default:
+		return false;
+	}
+
+	if( depth >= MaxDepth || !lua_checkstack( L, 2 ) )
+		return false;
+
+	beginTable();
+	lua_pushnil( L );
+	while( lua_next( L, idx ) != 0 )
+	{
+		int top = lua_gettop( L );
+		if( !writeValue( L, top - 1, depth + 1 ) || !writeValue( L, top, depth + 1 ) )
+		{
+			lua_pop( L, 2 );
+			return false;
+		}
+		lua_pop( L, 1 );
+	}
+	endTable();
+	return true;
+}
+
+LuaMessageReader::LuaMessageReader( const char* data, size_t size )
+: _cur( data )
+, _end( data + size )
+{
+
+}
+
+LuaMessageReader::LuaMessageReader( const LuaMessage& msg )
+: _cur( msg.data() )
+, _end( msg.data() + msg.size() )
+{
+
+}
+
+LuaT LuaMessageReader::peekType( void ) const
+{
+	MAGICAL_ASSERT( !atEnd(), "read past the end of message" );
+
+	switch( *_cur )
+	{
+	case TagFalse:
+	case TagTrue:
+		return LuaT::Boolean;
+	case TagNumber:
+		return LuaT::Number;
+	case TagString:
+		return LuaT::String;
+	case TagTable:
+		return LuaT::Table;
+	default:
+		return LuaT::Nil;
+	}
+}
+
+bool LuaMessageReader::readBoolean( void )
+{
+	MAGICAL_ASSERT( peekType() == LuaT::Boolean, "not a boolean" );
+	return *_cur ++ == TagTrue;
+}
+
+double LuaMessageReader::readNumber( void )
+{
+	MAGICAL_ASSERT( peekType() == LuaT::Number, "not a number" );
+
+	double num;
+	memcpy( &num, _cur + 1, sizeof( num ) );
+	_cur += 1 + sizeof( num );
+	return num;
+}
+
+const char* LuaMessageReader::readString( size_t* len )
+{
+	MAGICAL_ASSERT( peekType() == LuaT::String, "not a string" );
+
+	uint32_t length;
+	memcpy( &length, _cur + 1, sizeof( length ) );
+	const char* str = _cur + 1 + sizeof( length );
+	_cur = str + length + 1;
+
+	if( len )
+		*len = length;
+	return str;
+}
+
+void LuaMessageReader::beginTable( void )
+{
+	MAGICAL_ASSERT( peekType() == LuaT::Table, "not a table" );
+	_cur += 1 + sizeof( uint32_t ) * 2;
+}
+
+bool LuaMessageReader::endTable( void )
+{
+	if( atEnd() || *_cur != TagEnd )
+		return false;
+
+	++ _cur;
+	return true;
+}
+
+void LuaMessageReader::skip( void )
+{
+	switch( peekType() )
+	{
+	case LuaT::Boolean:
+		readBoolean();
+		break;
+	case LuaT::Number:
+		readNumber();
+		break;
+	case LuaT::String:
+		readString();
+		break;
+	case LuaT::Table:
+		beginTable();
+		while( !endTable() )
+		{
+			skip();
+			skip();
+		}
+		break;
+	default:
+		MAGICAL_ASSERT( *_cur == TagNil, "unexpected end of table" );
+		++ _cur;
+		break;
+	}
+}
+
+void LuaMessageReader::push( lua_State* L )
+{
+	switch( peekType() )
+	{
+	case LuaT::Boolean:
+		lua_pushboolean( L, readBoolean() ? 1 : 0 );
+		break;
+	case LuaT::Number:
+		lua_pushnumber( L, (lua_Number) readNumber() );
+		break;
+	case LuaT::String:
+		{
+			size_t len = 0;
+			const char* str = readString( &len );
+			lua_pushlstring( L, str, len );
+		}
+		break;
+	case LuaT::Table:
+		{
+			uint32_t sizes[2];
+			memcpy( sizes, _cur + 1, sizeof( sizes ) );
+			beginTable();
+
+			luaL_checkstack( L, 3, "message nested too deep" );
+			lua_createtable( L, (int) sizes[0], (int) sizes[1] );
+			while( !endTable() )
+			{
+				push( L );
+				push( L );
+				lua_rawset( L, -3 );
+			}
+		}
+		break;
+	default:
+		MAGICAL_ASSERT( *_cur == TagNil, "unexpected end of table" );
+		++ _cur;
+		lua_pushnil( L );
+		break;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __LUA_MESSAGE_H__
+#define __LUA_MESSAGE_H__
+
+#include "magical-macros.h"
+#include "Common.h"
+#include <vector>
+
+#include "LuaMacros.h"
+
+/*
+在不同的lua_State之间传递的值，序列化为连续的字节，不引用任何Lua对象
+
+支持nil、boolean、number、string以及由这些值组成的table，
+function、userdata、coroutine和嵌套超过MaxDepth层的table（包括循环引用）不能序列化；
+一条消息可以依次写入多个值，由LuaMessageReader按写入的顺序读出
+消息写完之后只读，可以同时被多个线程读取
+*/
+class LuaMessage
+{
+public:
+	static const int MaxDepth = 16;
+
+public:
+	void clear( void );
+	// 追加另一条完整的消息
+	void append( const LuaMessage& msg );
+	inline bool empty( void ) const { return _buffer.empty(); }
+	inline size_t size( void ) const { return _buffer.size(); }
+	inline const char* data( void ) const { return _buffer.data(); }
+
+public:
+	void writeNil( void );
+	void writeBoolean( bool b );
+	void writeNumber( double num );
+	void writeString( const char* str );
+	void writeString( const char* str, size_t len );
+	// beginTable与endTable之间写入的值依次作为键和值
+	void beginTable( void );
+	void endTable( void );
+
+	// 序列化栈上idx处的值，失败时消息恢复到调用之前的状态
+	bool write( lua_State* L, int idx );
+
+private:
+	struct OpenTable
+	{
+		size_t offset;
+		uint32_t values;
+		uint32_t narray;
+	};
+
+	void count( bool array_key );
+	bool writeValue( lua_State* L, int idx, int depth );
+
+private:
+	std::string _buffer;
+	std::vector<OpenTable> _tables;
+};
+
+/*
+按顺序读取LuaMessage中的值，只保存数据的地址，消息在读取期间不能修改
+*/
+class LuaMessageReader
+{
+public:
+	LuaMessageReader( const char* data, size_t size );
+	LuaMessageReader( const LuaMessage& msg );
+
+public:
+	inline bool atEnd( void ) const { return _cur >= _end; }
+	// 下一个值的类型，读到table的结尾时返回LuaT::Nil并且endTable()为true
+	LuaT peekType( void ) const;
+	bool readBoolean( void );
+	double readNumber( void );
+	// 返回以0结尾的字符串，指向消息内部
+	const char* readString( size_t* len = nullptr );
+	void beginTable( void );
+	// 读到当前table的结尾时跳过结束标记并返回true
+	bool endTable( void );
+	void skip( void );
+
+	// 把下一个值解码到栈顶
+	void push( lua_State* L );
+
+private:
+	const char* _cur;
+	const char* _end;
+};
+
+#endif //__LUA_MESSAGE_H__
\ No newline at end of file
@@ -23,6 +23,51 @@ SOFTWARE.
 *******************************************************************************/
 #include "LuaObject.h"
 #include "LuaState.h"
+#include <string.h>
+#include <stdlib.h>
+#include <mutex>
+#include <unordered_set>
+
+struct LuaCStringHash
+{
+	size_t operator()( const char* str ) const
+	{
+		size_t hash = 2166136261u;
+		for( ; *str; ++ str )
+			hash = ( hash ^ (unsigned char) *str ) * 16777619u;
+		return hash;
+	}
+};
+
+struct LuaCStringEqual
+{
+	bool operator()( const char* lhs, const char* rhs ) const
+	{
+		return strcmp( lhs, rhs ) == 0;
+	}
+};
+
+// 类型名数量有限，登记后不再释放
+static std::mutex _s_usertypes_mutex;
+static std::unordered_set<const char*, LuaCStringHash, LuaCStringEqual> _s_usertypes;
+
+const char* LuaObject::internType( const char* type )
+{
+	MAGICAL_ASSERT( type, "type should not be nullptr" );
+
+	std::lock_guard<std::mutex> lock( _s_usertypes_mutex );
+	auto itr = _s_usertypes.find( type );
+	if( itr != _s_usertypes.end() )
+		return *itr;
+
+	size_t size = strlen( type ) + 1;
+	char* interned = (char*) malloc( size );
+	MAGICAL_ASSERT( interned, "malloc failed" );
+	memcpy( interned, type, size );
+
+	_s_usertypes.insert( interned );
+	return interned;
+}
 
 LuaObject::LuaObject( void )
 {
@@ -31,99 +76,17 @@ LuaObject::LuaObject( void )
 
 LuaObject::LuaObject( LuaObject&& lobj )
 {
-	switch( lobj._type )
-	{
-	case LuaT::Nil:
-		_type = LuaT::Nil;
-		break;
-	case LuaT::Boolean:
-		_type = LuaT::Boolean;
-		_boolean = lobj._boolean;
-		lobj._type = LuaT::Nil;
-		lobj._boolean = false;
-		break;
-	case LuaT::Number:
-		_type = LuaT::Number;
-		_number = lobj._number;
-		lobj._type = LuaT::Nil;
-		lobj._number = 0.0;
-		break;
-	case LuaT::String:
-		_type = LuaT::String;
-		_string = lobj._string;
-		lobj._type = LuaT::Nil;
-		lobj._string.clear();
-		break;
-	case LuaT::UserData:
-		_type = LuaT::UserData;
-		_userdata = lobj._userdata;
-		_usertype = lobj._usertype;
-		_is_gc = lobj._is_gc;
-		lobj._type = LuaT::Nil;
-		lobj._userdata = nullptr;
-		lobj._usertype.clear();
-		lobj._is_gc = false;
-		break;
-	case LuaT::Function:
-		_type = LuaT::Function;
-		_function = std::move( lobj._function );
-		lobj._type = LuaT::Nil;
-		lobj._function = nullptr;
-		break;
-	case LuaT::Table:
-		_type = LuaT::Table;
-		_table = std::move( lobj._table );
-		lobj._type = LuaT::Nil;
-		lobj._table = nullptr;
-		break;
-	default:
-		_type = LuaT::Nil;
-		break;
-	}
+	move( lobj );
 }
 
 LuaObject::LuaObject( const LuaObject& lobj )
 {
-	switch( lobj._type )
-	{
-	case LuaT::Nil:
-		_type = LuaT::Nil;
-		break;
-	case LuaT::Boolean:
-		_type = LuaT::Boolean;
-		_boolean = lobj._boolean;
-		break;
-	case LuaT::Number:
-		_type = LuaT::Number;
-		_number = lobj._number;
-		break;
-	case LuaT::String:
-		_type = LuaT::String;
-		_string = lobj._string;
-		break;
-	case LuaT::UserData:
-		_type = LuaT::UserData;
-		_userdata = lobj._userdata;
-		_usertype = lobj._usertype;
-		_is_gc = lobj._is_gc;
-		break;
-	case LuaT::Function:
-		_type = LuaT::Function;
-		_function = lobj._function;
-		break;
-	case LuaT::Table:
-		_type = LuaT::Table;
-		_table = lobj._table;
-		break;
-	default:
-		_type = LuaT::Nil;
-		break;
-	}
+	copy( lobj );
 }
 
 LuaObject::~LuaObject( void )
 {
-	
+	clear();
 }
 
 LuaObject::LuaObject( std::nullptr_t nt )
@@ -133,276 +96,249 @@ LuaObject::LuaObject( std::nullptr_t nt )
 
 LuaObject::LuaObject( bool b )
 {
-	_boolean = b;
-	_type = LuaT::Boolean;
+	*this = b;
 }
 
 LuaObject::LuaObject( int number )
 {
-	_number = (double) number;
-	_type = LuaT::Number;
+	*this = number;
 }
 
 LuaObject::LuaObject( float number )
 {
-	_number = (double) number;
-	_type = LuaT::Number;
+	*this = number;
 }
 
 LuaObject::LuaObject( double number )
 {
-	_number = number;
-	_type = LuaT::Number;
+	*this = number;
 }
 
 LuaObject::LuaObject( const char* str )
 {
-	_string = str;
-	_type = LuaT::String;
+	*this = str;
 }
 
 LuaObject::LuaObject( const std::string& str )
 {
-	_string = str;
-	_type = LuaT::String;
+	set( str.c_str(), str.size() );
 }
 
 LuaObject::LuaObject( void* userdata, const char* type )
 {
-	magicalAssert( userdata, "userdata should not be nullptr" );
-	magicalAssert( type && strlen( type ) > 0, "userdata type string should not be empty" );
-	_userdata = userdata;
-	_usertype = type;
-	_type = LuaT::UserData;
-}
-
-LuaObject::LuaObject( LuaFunction&& lf )
-{
-	_function = std::forward<LuaFunction>( lf );
-	_type = LuaT::Function;
+	set( userdata, type );
 }
 
 LuaObject::LuaObject( const LuaFunction& lf )
 {
-	_function = lf;
-	_type = LuaT::Function;
-}
-
-LuaObject::LuaObject( LuaTable&& lt )
-{
-	_table = std::forward<LuaTable>( lt );
-	_type = LuaT::Table;
+	*this = lf;
 }
 
 LuaObject::LuaObject( const LuaTable& lt )
 {
-	_table = lt;
-	_type = LuaT::Table;
+	*this = lt;
 }
 
 bool LuaObject::operator==( std::nullptr_t nt ) const
 {
-	return _type == LuaT::Nil;
+	return _type == (unsigned char) LuaT::Nil;
 }
 
 bool LuaObject::operator==( LuaT t ) const
 {
-	return _type == t;
+	return _type == (unsigned char) t;
 }
 
 bool LuaObject::operator!=( std::nullptr_t nt ) const
 {
-	return _type != LuaT::Nil;
+	return _type != (unsigned char) LuaT::Nil;
 }
 
 bool LuaObject::operator!=( LuaT t ) const
 {
-	return _type != t;
+	return _type != (unsigned char) t;
 }
 
 LuaObject& LuaObject::operator=( LuaObject&& lobj )
 {
-	switch( lobj._type )
+	if( this != &lobj )
 	{
-	case LuaT::Nil:
-		_type = LuaT::Nil;
-		break;
-	case LuaT::Boolean:
-		_type = LuaT::Boolean;
-		_boolean = lobj._boolean;
-		lobj._type = LuaT::Nil;
-		lobj._boolean = false;
-		break;
-	case LuaT::Number:
-		_type = LuaT::Number;
-		_number = lobj._number;
-		lobj._type = LuaT::Nil;
-		lobj._number = 0.0;
-		break;
-	case LuaT::String:
-		_type = LuaT::String;
-		_string = lobj._string;
-		lobj._type = LuaT::Nil;
-		lobj._string.clear();
-		break;
-	case LuaT::UserData:
-		_type = LuaT::UserData;
-		_userdata = lobj._userdata;
-		_usertype = lobj._usertype;
-		lobj._type = LuaT::Nil;
-		lobj._userdata = nullptr;
-		lobj._usertype.clear();
-		break;
-	case LuaT::Function:
-		_type = LuaT::Function;
-		_function = std::move( lobj._function );
-		lobj._type = LuaT::Nil;
-		lobj._function = nullptr;
-		break;
-	case LuaT::Table:
-		_type = LuaT::Table;
-		_table = std::move( lobj._table );
-		lobj._type = LuaT::Nil;
-		lobj._table = nullptr;
-		break;
-	default:
-		_type = LuaT::Nil;
-		break;
+		clear();
+		move( lobj );
 	}
 	return *this;
 }
 
 LuaObject& LuaObject::operator=( const LuaObject& lobj )
 {
-	switch( lobj._type )
+	if( this != &lobj )
 	{
-	case LuaT::Nil:
-		_type = LuaT::Nil;
-		break;
-	case LuaT::Boolean:
-		_type = LuaT::Boolean;
-		_boolean = lobj._boolean;
-		break;
-	case LuaT::Number:
-		_type = LuaT::Number;
-		_number = lobj._number;
-		break;
-	case LuaT::String:
-		_type = LuaT::String;
-		_string = lobj._string;
-		break;
-	case LuaT::UserData:
-		_type = LuaT::UserData;
-		_userdata = lobj._userdata;
-		_usertype = lobj._usertype;
-		break;
-	case LuaT::Function:
-		_type = LuaT::Function;
-		_function = lobj._function;
-		break;
-	case LuaT::Table:
-		_type = LuaT::Table;
-		_table = lobj._table;
-		break;
-	default:
-		_type = LuaT::Nil;
-		break;
+		clear();
+		copy( lobj );
 	}
 	return *this;
 }
 
-//void LuaObject::clean( void )
-//{
-//	if( _type != LuaT::Function )
-//		_function.release();
-//
-//	if( _type != LuaT::Table )
-//		_table.release();
-//}
-
 LuaObject& LuaObject::operator=( std::nullptr_t nt )
 {
-	_type = LuaT::Nil;
+	clear();
 	return *this;
 }
 
 LuaObject& LuaObject::operator=( bool b )
 {
+	clear();
 	_boolean = b;
-	_type = LuaT::Boolean;
+	_type = (unsigned char) LuaT::Boolean;
 	return *this;
 }
 
 LuaObject& LuaObject::operator=( int number )
 {
-	_number = (double) number;
-	_type = LuaT::Number;
-	return *this;
+	return *this = (double) number;
 }
 
 LuaObject& LuaObject::operator=( float number )
 {
-	_number = (double) number;
-	_type = LuaT::Number;
-	return *this;
+	return *this = (double) number;
 }
 
 LuaObject& LuaObject::operator=( double number )
 {
+	clear();
 	_number = number;
-	_type = LuaT::Number;
+	_type = (unsigned char) LuaT::Number;
 	return *this;
 }
 
 LuaObject& LuaObject::operator=( const char* str )
 {
-	_string = str;
-	_type = LuaT::String;
+	MAGICAL_ASSERT( str, "str should not be nullptr" );
+	set( str, strlen( str ) );
 	return *this;
 }
 
 LuaObject& LuaObject::operator=( const std::string& str )
 {
-	_string = str;
-	_type = LuaT::String;
+	set( str.c_str(), str.size() );
 	return *this;
 }
 
-LuaObject& LuaObject::operator=( LuaFunction&& lf )
+LuaObject& LuaObject::operator=( const LuaFunction& lf )
 {
-	_function = std::forward<LuaFunction>( lf );
-	_type = LuaT::Function;
+	LuaReference* ref = lf._ref;
+	if( ref )
+		ref->retain();
+
+	clear();
+	if( ref )
+	{
+		_ref = ref;
+		_type = (unsigned char) LuaT::Function;
+	}
 	return *this;
 }
 
-LuaObject& LuaObject::operator=( const LuaFunction& lf )
+LuaObject& LuaObject::operator=( const LuaTable& lt )
 {
-	_function = lf;
-	_type = LuaT::Function;
+	LuaReference* ref = lt._ref;
+	if( ref )
+		ref->retain();
+
+	clear();
+	if( ref )
+	{
+		_ref = ref;
+		_type = (unsigned char) LuaT::Table;
+	}
 	return *this;
 }
 
-LuaObject& LuaObject::operator=( LuaTable&& lt )
+void LuaObject::set( void* userdata, const char* type )
 {
-	_table = std::forward<LuaTable>( lt );
-	_type = LuaT::Table;
-	return *this;
+	MAGICAL_ASSERT( userdata, "userdata should not be nullptr" );
+	MAGICAL_ASSERT( type && strlen( type ) > 0, "userdata type string should not be empty" );
+	clear();
+	_userdata.ptr = userdata;
+	_userdata.type = internType( type );
+	_type = (unsigned char) LuaT::UserData;
 }
 
-LuaObject& LuaObject::operator=( const LuaTable& lt )
+void LuaObject::set( const char* str, size_t length )
 {
-	_table = lt;
-	_type = LuaT::Table;
-	return *this;
+	clear();
+	if( length <= SsoCapacity )
+	{
+		memcpy( _sso, str, length );
+		_sso[ length ] = 0;
+		_sso_length = (unsigned char) length;
+	}
+	else
+	{
+		_heap.data = (char*) malloc( length + 1 );
+		MAGICAL_ASSERT( _heap.data, "malloc failed" );
+		memcpy( _heap.data, str, length );
+		_heap.data[ length ] = 0;
+		_heap.length = length;
+		_sso_length = SsoCapacity + 1;
+	}
+	_type = (unsigned char) LuaT::String;
 }
 
-void LuaObject::set( void* userdata, const char* type )
+void LuaObject::set( LuaState* L, int index )
 {
-	magicalAssert( userdata, "userdata should not be nullptr" );
-	magicalAssert( type && strlen( type ) > 0, "userdata type string should not be empty" );
-	_userdata = userdata;
-	_usertype = type;
-	_type = LuaT::UserData;
+	lua_State* l = L->cPtr();
+	if( index < 0 && index > LUA_REGISTRYINDEX )
+		index = lua_gettop( l ) + index + 1;
+
+	switch( lua_type( l, index ) )
+	{
+	case LUA_TBOOLEAN:
+		*this = lua_toboolean( l, index ) != 0;
+		break;
+	case LUA_TNUMBER:
+		*this = (double) lua_tonumber( l, index );
+		break;
+	case LUA_TSTRING:
+		{
+			size_t length = 0;
+			const char* str = lua_tolstring( l, index, &length );
+			set( str, length );
+		}
+		break;
+	case LUA_TUSERDATA:
+		{
+			const char* type = internType( tolua_typename( l, index ) );
+			lua_pop( l, 1 );
+			set( tolua_tousertype( l, index, 0 ), type );
+		}
+		break;
+	case LUA_TFUNCTION:
+		{
+			clear();
+			int handler = tolua_ext_tofunction( l, index, 0 );
+			if( handler != 0 )
+			{
+				_ref = LuaReference::create( L, handler, LuaReference::Function );
+				_type = (unsigned char) LuaT::Function;
+			}
+		}
+		break;
+	case LUA_TTABLE:
+		{
+			clear();
+			int handler = tolua_ext_totable( l, index, 0 );
+			if( handler != 0 )
+			{
+				_ref = LuaReference::create( L, handler, LuaReference::Table );
+				_type = (unsigned char) LuaT::Table;
+			}
+		}
+		break;
+	default:
+		clear();
+		break;
+	}
 }
 
 LuaObject& LuaObject::toGcObject( void )
@@ -413,45 +349,153 @@ LuaObject& LuaObject::toGcObject( void )
 
 bool LuaObject::toBoolean( void ) const
 {
-	return _type == LuaT::Boolean ? _boolean : false;
+	return _type == (unsigned char) LuaT::Boolean ? _boolean : false;
 }
 
 int LuaObject::toInt( void ) const
 {
-	return _type == LuaT::Number ? (int) _number : 0.0;
+	return _type == (unsigned char) LuaT::Number ? (int) _number : 0;
 }
 
 float LuaObject::toFloat( void ) const
 {
-	return _type == LuaT::Number ? (float) _number : 0.0;
+	return _type == (unsigned char) LuaT::Number ? (float) _number : 0.0f;
 }
 
 double LuaObject::toDouble( void ) const
 {
-	return _type == LuaT::Number ? _number : 0.0;
+	return _type == (unsigned char) LuaT::Number ? _number : 0.0;
 }
 
 std::string LuaObject::toString( void ) const
 {
-	return _type == LuaT::String ? _string : "";
+	return _type == (unsigned char) LuaT::String ? std::string( toCString(), length() ) : "";
+}
+
+const char* LuaObject::toCString( void ) const
+{
+	if( _type != (unsigned char) LuaT::String )
+		return nullptr;
+
+	return isHeapString() ? _heap.data : _sso;
+}
+
+size_t LuaObject::length( void ) const
+{
+	if( _type != (unsigned char) LuaT::String )
+		return 0;
+
+	return isHeapString() ? _heap.length : _sso_length;
 }
 
 void* LuaObject::toUserData( void ) const
 {
-	return _type == LuaT::UserData ? _userdata : nullptr;
+	return _type == (unsigned char) LuaT::UserData ? _userdata.ptr : nullptr;
 }
 
 LuaFunction LuaObject::toLuaFunction( void ) const
 {
-	return _type == LuaT::Function ? _function : nullptr;
+	LuaFunction lf;
+	if( _type == (unsigned char) LuaT::Function )
+	{
+		_ref->retain();
+		lf._ref = _ref;
+	}
+	return lf;
 }
 
 LuaTable LuaObject::toLuaTable( void ) const
 {
-	return _type == LuaT::Table ? _table : nullptr;
+	LuaTable lt;
+	if( _type == (unsigned char) LuaT::Table )
+	{
+		_ref->retain();
+		lt._ref = _ref;
+	}
+	return lt;
 }
 
 const char* LuaObject::userdataType( void ) const
 {
-	return _type == LuaT::UserData ? _usertype.c_str() : nullptr;
+	return _type == (unsigned char) LuaT::UserData ? _userdata.type : nullptr;
+}
+
+void LuaObject::clear( void )
+{
+	switch( (LuaT) _type )
+	{
+	case LuaT::String:
+		if( isHeapString() )
+			free( _heap.data );
+		break;
+	case LuaT::Function:
+	case LuaT::Table:
+		_ref->release();
+		break;
+	default:
+		break;
+	}
+
+	_type = (unsigned char) LuaT::Nil;
+	_is_gc = false;
+	_sso_length = 0;
+}
+
+void LuaObject::copy( const LuaObject& lobj )
+{
+	switch( (LuaT) lobj._type )
+	{
+	case LuaT::Boolean:
+		_boolean = lobj._boolean;
+		break;
+	case LuaT::Number:
+		_number = lobj._number;
+		break;
+	case LuaT::String:
+		set( lobj.toCString(), lobj.length() );
+		break;
+	case LuaT::UserData:
+		_userdata = lobj._userdata;
+		break;
+	case LuaT::Function:
+	case LuaT::Table:
+		_ref = lobj._ref;
+		_ref->retain();
+		break;
+	default:
+		break;
+	}
+
+	_type = lobj._type;
+	_is_gc = lobj._is_gc;
+	_sso_length = lobj._sso_length;
+}
+
+void LuaObject::move( LuaObject& lobj )
+{
+	switch( (LuaT) lobj._type )
+	{
+	case LuaT::String:
+		if( lobj.isHeapString() )
+			_heap = lobj._heap;
+		else
+			memcpy( _sso, lobj._sso, lobj._sso_length + 1 );
+		break;
+	case LuaT::Function:
+	case LuaT::Table:
+		_ref = lobj._ref;
+		break;
+	default:
+		copy( lobj );
+		break;
+	}
+
+	_type = lobj._type;
+	_is_gc = lobj._is_gc;
+	_sso_length = lobj._sso_length;
+
+	// 资源已经转移，直接置空，不能调用clear
+	lobj._type = (unsigned char) LuaT::Nil;
+	lobj._is_gc = false;
+	lobj._sso_length = 0;
 }
\ No newline at end of file
@@ -24,11 +24,12 @@ SOFTWARE.
 #ifndef __LUA_OBJECT_H__
 #define __LUA_OBJECT_H__
 
-#include "PlatformMacros.h"
+#include "magical-macros.h"
 #include "Common.h"
 #include "Reference.h"
 
 #include "LuaMacros.h"
+#include "LuaState.h"
 #include "LuaTable.h"
 #include "LuaFunction.h"
 
@@ -36,8 +37,17 @@ class LuaState;
 class LuaTable;
 class LuaFunction;
 
+/*
+Lua值在C++中的表示，按类型保存在同一块联合体中
+
+短字符串（不超过SsoCapacity个字节）直接保存在对象内，userdata的类型名使用全局唯一的字符串，
+函数和表共享LuaReference，数值、布尔、短字符串和userdata在复制和传递时都不会分配内存
+*/
 class LuaObject
 {
+public:
+	enum : size_t { SsoCapacity = 15 };
+
 public:
 	LuaObject( void );
 	LuaObject( LuaObject&& lobj );
@@ -52,9 +62,7 @@ public:
 	LuaObject( double number );
 	LuaObject( const char* str );
 	LuaObject( const std::string& str );
-	LuaObject( LuaFunction&& lf );
 	LuaObject( const LuaFunction& lf );
-	LuaObject( LuaTable&& lt );
 	LuaObject( const LuaTable& lt );
 	LuaObject( void* userdata, const char* type );
 
@@ -65,7 +73,6 @@ public:
 	bool operator!=( LuaT t ) const;
 	LuaObject& operator=( LuaObject&& lobj );
 	LuaObject& operator=( const LuaObject& lobj );
-	//void clean( void );
 	
 public:
 	LuaObject& operator=( std::nullptr_t nt );
@@ -75,38 +82,77 @@ public:
 	LuaObject& operator=( double number );
 	LuaObject& operator=( const char* str );
 	LuaObject& operator=( const std::string& str );
-	LuaObject& operator=( LuaFunction&& lf );
 	LuaObject& operator=( const LuaFunction& lf );
-	LuaObject& operator=( LuaTable&& lt );
 	LuaObject& operator=( const LuaTable& lt );
 	void set( void* userdata, const char* type );
+	void set( const char* str, size_t length );
+	// 读取栈上index处的值，不弹出，函数和表会登记到tolua_ext
+	void set( LuaState* L, int index );
 	LuaObject& toGcObject( void );
 	
 public:
+	inline LuaT getType( void ) const { return (LuaT) _type; }
 	bool toBoolean( void ) const;
 	int toInt( void ) const;
 	float toFloat( void ) const;
 	double toDouble( void ) const;
 	std::string toString( void ) const;
+	// 对象有效期间一直有效，不是字符串时返回nullptr
+	const char* toCString( void ) const;
+	size_t length( void ) const;
 	void* toUserData( void ) const;
 	LuaFunction toLuaFunction( void ) const;
 	LuaTable toLuaTable( void ) const;
 	const char* userdataType( void ) const;
 
+public:
+	// 返回全局唯一的类型名，相同内容的字符串返回同一个指针
+	static const char* internType( const char* type );
+
+private:
+	void clear( void );
+	void copy( const LuaObject& lobj );
+	void move( LuaObject& lobj );
+	inline bool isHeapString( void ) const { return _type == (unsigned char) LuaT::String && _sso_length > SsoCapacity; }
+
 private:
 	friend class LuaState;
-	friend class LuaFunction;
-	friend class LuaGlobalSelector;
-	friend class LuaTableSelector;
-	LuaT _type = LuaT::Nil;
-	std::string _string;
-	bool _boolean = false;
-	double _number = 0.0;
-	void* _userdata = nullptr;
-	std::string _usertype;
+	unsigned char _type = (unsigned char) LuaT::Nil;
 	bool _is_gc = false;
-	LuaFunction _function;
-	LuaTable _table;
+	// 短字符串的长度，大于SsoCapacity表示字符串在堆上
+	unsigned char _sso_length = 0;
+	union
+	{
+		bool _boolean;
+		double _number;
+		char _sso[ SsoCapacity + 1 ];
+		struct { char* data; size_t length; } _heap;
+		struct { void* ptr; const char* type; } _userdata;
+		LuaReference* _ref;
+	};
 };
 
+static_assert( sizeof( LuaObject ) <= 24, "LuaObject should stay within 24 bytes" );
+
+template< typename... Args >
+LuaObject LuaFunction::operator()( const Args&... args ) const
+{
+	if( !_ref ) 
+		return nullptr;
+
+	countCall();
+	lua_State* L = _ref->getState()->cPtr();
+	tolua_ext_get_function_by_handler( L, _ref->getHandler() );
+	pushArgs( _ref->getState(), args... );
+
+	int ret = lua_pcall( L, sizeof...( args ), 1, 0 );
+	if( ret == 0 )
+		return returnCall();
+
+	MAGICAL_SET_LAST_ERROR( lua_tostring( L, -1 ) );
+	MAGICAL_LOG_LAST_ERROR();
+	lua_pop( L, 1 );
+	return nullptr;
+}
+
 #endif //__LUA_OBJECT_H__
\ No newline at end of file
@@ -0,0 +1,81 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "LuaReference.h"
+#include "LuaState.h"
+
+// 每个线程的LuaState各自创建和释放引用，空闲链表按线程缓存，不需要加锁
+static MAGICAL_THREAD_LOCAL LuaReference* _s_free_list = nullptr;
+
+LuaReference* LuaReference::create( LuaState* L, int handler, Kind kind )
+{
+	MAGICAL_ASSERT( L && handler, "invalid lua state or handler" );
+
+	LuaReference* ref = _s_free_list;
+	if( ref )
+	{
+		_s_free_list = ref->_next_free;
+		ref->_next_free = nullptr;
+	}
+	else
+	{
+		ref = new LuaReference();
+		MAGICAL_ASSERT( ref, "new LuaReference() failed" );
+	}
+
+	ref->_L = L;
+	ref->_L->retain();
+	ref->_handler = handler;
+	ref->_kind = kind;
+	ref->_reference_count = 1;
+	return ref;
+}
+
+void LuaReference::purge( void )
+{
+	while( _s_free_list )
+	{
+		LuaReference* ref = _s_free_list;
+		_s_free_list = ref->_next_free;
+		delete ref;
+	}
+}
+
+void LuaReference::release( void )
+{
+	MAGICAL_ASSERT( _reference_count > 0, "invalid lua reference count." );
+	if( -- _reference_count > 0 )
+		return;
+
+	if( _kind == Function )
+		tolua_ext_remove_function_by_handler( _L->cPtr(), _handler );
+	else
+		tolua_ext_remove_table_by_handler( _L->cPtr(), _handler );
+
+	_L->release();
+	_L = nullptr;
+	_handler = 0;
+
+	_next_free = _s_free_list;
+	_s_free_list = this;
+}
\ No newline at end of file
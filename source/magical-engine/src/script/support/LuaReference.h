@@ -0,0 +1,74 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __LUA_REFERENCE_H__
+#define __LUA_REFERENCE_H__
+
+#include "magical-macros.h"
+#include "Common.h"
+
+#include "LuaMacros.h"
+
+class LuaState;
+
+/*
+LuaFunction和LuaTable共享的引用记录，计数保存在记录本身
+
+handler是tolua_ext用luaL_ref在注册表中分配的槽位，按handler取值只需一次lua_rawgeti；
+最后一个持有者释放时立即luaL_unref归还槽位，记录放回空闲链表，
+反复注册回调时注册表和记录都不会增长（test-luareference）
+*/
+class LuaReference
+{
+public:
+	enum Kind
+	{
+		Function,
+		Table,
+	};
+
+public:
+	static LuaReference* create( LuaState* L, int handler, Kind kind );
+	// 释放当前线程的空闲链表中缓存的记录
+	static void purge( void );
+
+public:
+	inline void retain( void ) { ++ _reference_count; }
+	void release( void );
+	inline LuaState* getState( void ) const { return _L; }
+	inline int getHandler( void ) const { return _handler; }
+
+private:
+	LuaReference( void ) {}
+	LuaReference( const LuaReference& ) = delete;
+	LuaReference& operator=( const LuaReference& ) = delete;
+
+private:
+	LuaState* _L = nullptr;
+	int _handler = 0;
+	int _reference_count = 0;
+	Kind _kind = Function;
+	LuaReference* _next_free = nullptr;
+};
+
+#endif //__LUA_REFERENCE_H__
\ No newline at end of file
@@ -0,0 +1,365 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "LuaScheduler.h"
+#include "Director.h"
+#include "Utils.h"
+#include "Profiler.h"
+#include "Stats.h"
+
+#include "lua.hpp"
+
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+
+struct LuaTask
+{
+	lua_State* co;
+	int ref;
+	int nargs;
+	bool waiting;
+	bool killed;
+};
+
+/*
+唤醒记录，key是时间或帧号，key相同时先挂起的先恢复
+结束的协程不从堆中删除，到期时按id查不到即跳过
+*/
+struct LuaWakeup
+{
+	double key;
+	uint64_t sequence;
+	uint32_t id;
+};
+
+static LuaState* _s_L = nullptr;
+static int64_t _s_budget = LuaScheduler::DefaultBudget;
+static std::unordered_map<uint32_t, LuaTask> _s_tasks;
+static std::vector<LuaWakeup> _s_timers;
+static std::vector<LuaWakeup> _s_frames;
+static uint32_t _s_next_id = 0;
+static uint64_t _s_next_sequence = 0;
+static double _s_time = 0.0;
+static uint64_t _s_frame = 0;
+static LuaTask* _s_current = nullptr;
+static uint32_t _s_current_id = 0;
+
+static int64_t taskCount( void )
+{
+	return (int64_t) _s_tasks.size();
+}
+
+static magical::Stat _stat_sched_tasks( "lua.sched.tasks", magical::Stat::Gauge, taskCount );
+static magical::Stat _stat_sched_resumes( "lua.sched.resumes", magical::Stat::Counter );
+static magical::Stat _stat_sched_errors( "lua.sched.errors", magical::Stat::Counter );
+static magical::Stat _stat_sched_overruns( "lua.sched.overruns", magical::Stat::Counter );
+static magical::Stat _stat_sched_update_us( "lua.sched.update_us", magical::Stat::Gauge );
+
+static bool laterWakeup( const LuaWakeup& a, const LuaWakeup& b )
+{
+	return a.key != b.key ? a.key > b.key : a.sequence > b.sequence;
+}
+
+static void pushWakeup( std::vector<LuaWakeup>& heap, double key, uint32_t id )
+{
+	LuaWakeup wakeup = { key, _s_next_sequence ++, id };
+	heap.push_back( wakeup );
+	std::push_heap( heap.begin(), heap.end(), laterWakeup );
+}
+
+static uint32_t popWakeup( std::vector<LuaWakeup>& heap )
+{
+	std::pop_heap( heap.begin(), heap.end(), laterWakeup );
+	uint32_t id = heap.back().id;
+	heap.pop_back();
+	return id;
+}
+
+// 帧号在update开始时递增，key为下一帧的记录不会在本次update中恢复
+static void waitFrames( uint32_t id, uint64_t frames )
+{
+	pushWakeup( _s_frames, (double) ( _s_frame + ( frames > 0 ? frames : 1 ) ), id );
+}
+
+static void removeTask( uint32_t id )
+{
+	auto itr = _s_tasks.find( id );
+	if( itr == _s_tasks.end() )
+		return;
+
+	luaL_unref( _s_L->cPtr(), LUA_REGISTRYINDEX, itr->second.ref );
+	_s_tasks.erase( itr );
+}
+
+static void handleError( LuaTask* task )
+{
+	lua_State* L = _s_L->cPtr();
+	int top = lua_gettop( L );
+
+	// 错误信息附上协程的调用栈
+	lua_getglobal( L, "debug" );
+	lua_getfield( L, -1, "traceback" );
+	lua_rawgeti( L, LUA_REGISTRYINDEX, task->ref );
+	lua_xmove( task->co, L, 1 );
+	bool traced = lua_pcall( L, 2, 1, 0 ) == 0 && lua_type( L, -1 ) == LUA_TSTRING;
+
+	MAGICAL_SET_LAST_ERROR( traced ? lua_tostring( L, -1 ) : "error in coroutine" );
+	MAGICAL_LOG_LAST_ERROR();
+	lua_settop( L, top );
+	_stat_sched_errors.add();
+}
+
+static void resume( uint32_t id, LuaTask* task )
+{
+	int nargs = task->nargs;
+	task->nargs = 0;
+	task->waiting = false;
+
+	_s_current = task;
+	_s_current_id = id;
+	int status = lua_resume( task->co, nargs );
+	_s_current = nullptr;
+	_s_current_id = 0;
+	_stat_sched_resumes.add();
+
+	if( status == LUA_YIELD && !task->killed )
+	{
+		// 不是由wait挂起的，下一帧继续
+		if( !task->waiting )
+			waitFrames( id, 1 );
+
+		lua_settop( task->co, 0 );
+		return;
+	}
+
+	if( status != 0 && status != LUA_YIELD )
+		handleError( task );
+
+	removeTask( id );
+}
+
+static LuaTask* currentTask( lua_State* L, const char* name )
+{
+	if( _s_current == nullptr || _s_current->co != L )
+		luaL_error( L, "%s() should be called in a coroutine created by Scheduler.spawn()", name );
+
+	return _s_current;
+}
+
+// wait( seconds )
+static int lua_scheduler_wait( lua_State* L )
+{
+	double seconds = (double) luaL_checknumber( L, 1 );
+	LuaTask* task = currentTask( L, "wait" );
+
+	double key = _s_time + seconds;
+	if( key > _s_time )
+		pushWakeup( _s_timers, key, _s_current_id );
+	else
+		waitFrames( _s_current_id, 1 );
+
+	task->waiting = true;
+	return lua_yield( L, 0 );
+}
+
+// waitFrames( n )
+static int lua_scheduler_wait_frames( lua_State* L )
+{
+	int frames = (int) luaL_optinteger( L, 1, 1 );
+	LuaTask* task = currentTask( L, "waitFrames" );
+
+	waitFrames( _s_current_id, frames > 0 ? (uint64_t) frames : 1 );
+	task->waiting = true;
+	return lua_yield( L, 0 );
+}
+
+// Scheduler.spawn( fn, ... )，返回协程的id
+static int lua_scheduler_spawn( lua_State* L )
+{
+	luaL_checktype( L, 1, LUA_TFUNCTION );
+	int top = lua_gettop( L );
+
+	lua_State* co = lua_newthread( L );
+	int ref = luaL_ref( L, LUA_REGISTRYINDEX );
+
+	// 函数和参数移到协程的栈上，第一次resume时作为参数传入
+	lua_checkstack( co, top );
+	lua_xmove( L, co, top );
+
+	// 0保留为无效id
+	if( ++ _s_next_id == 0 )
+		++ _s_next_id;
+
+	LuaTask& task = _s_tasks[ _s_next_id ];
+	task.co = co;
+	task.ref = ref;
+	task.nargs = top - 1;
+	task.waiting = false;
+	task.killed = false;
+	waitFrames( _s_next_id, 1 );
+
+	lua_pushnumber( L, (lua_Number) _s_next_id );
+	return 1;
+}
+
+// Scheduler.kill( id )
+static int lua_scheduler_kill( lua_State* L )
+{
+	uint32_t id = (uint32_t) luaL_checknumber( L, 1 );
+	auto itr = _s_tasks.find( id );
+	if( itr == _s_tasks.end() )
+	{
+		lua_pushboolean( L, 0 );
+		return 1;
+	}
+
+	// 正在执行的协程不能立即释放，在返回后结束
+	if( &itr->second == _s_current )
+		_s_current->killed = true;
+	else
+		removeTask( id );
+
+	lua_pushboolean( L, 1 );
+	return 1;
+}
+
+// Scheduler.count()
+static int lua_scheduler_count( lua_State* L )
+{
+	lua_pushnumber( L, (lua_Number) _s_tasks.size() );
+	return 1;
+}
+
+static const luaL_Reg lua_scheduler_functions[] = {
+	{ "spawn", lua_scheduler_spawn },
+	{ "kill", lua_scheduler_kill },
+	{ "count", lua_scheduler_count },
+	{ nullptr, nullptr }
+};
+
+void LuaScheduler::init( LuaState* L )
+{
+	MAGICAL_ASSERT( L, "L should not be nullptr" );
+
+	_s_L = L;
+	_s_L->retain();
+	_s_time = 0.0;
+	_s_frame = 0;
+
+	lua_State* ls = _s_L->cPtr();
+	luaL_register( ls, "Scheduler", lua_scheduler_functions );
+	lua_pop( ls, 1 );
+	lua_register( ls, "wait", lua_scheduler_wait );
+	lua_register( ls, "waitFrames", lua_scheduler_wait_frames );
+
+	magical::Director::addHook( magical::Director::FrameEnd, LuaScheduler::update );
+}
+
+void LuaScheduler::delc( void )
+{
+	if( _s_L == nullptr )
+		return;
+
+	magical::Director::removeHook( magical::Director::FrameEnd, LuaScheduler::update );
+
+	killAll();
+	_s_timers.clear();
+	_s_frames.clear();
+
+	_s_L->release();
+	_s_L = nullptr;
+}
+
+void LuaScheduler::update( void )
+{
+	if( _s_L == nullptr )
+		return;
+
+	MAGICAL_PROFILE_SCOPE( "LuaScheduler::update" );
+
+	int64_t begin = magical::Time::currentMicroseconds();
+	_s_time += magical::Director::getDeltaTime();
+	++ _s_frame;
+
+	int64_t now = begin;
+	while( true )
+	{
+		// 先恢复按帧等待的协程，再恢复按时间等待的协程
+		std::vector<LuaWakeup>* heap = nullptr;
+		if( !_s_frames.empty() && _s_frames.front().key <= (double) _s_frame )
+			heap = &_s_frames;
+		else if( !_s_timers.empty() && _s_timers.front().key <= _s_time )
+			heap = &_s_timers;
+		else
+			break;
+
+		if( now - begin >= _s_budget )
+		{
+			_stat_sched_overruns.add();
+			break;
+		}
+
+		uint32_t id = popWakeup( *heap );
+		auto itr = _s_tasks.find( id );
+		if( itr == _s_tasks.end() )
+			continue;
+
+		resume( id, &itr->second );
+		now = magical::Time::currentMicroseconds();
+	}
+
+	_stat_sched_update_us.set( now - begin );
+}
+
+void LuaScheduler::killAll( void )
+{
+	for( auto itr = _s_tasks.begin(); itr != _s_tasks.end(); )
+	{
+		if( &itr->second == _s_current )
+		{
+			_s_current->killed = true;
+			++ itr;
+			continue;
+		}
+
+		luaL_unref( _s_L->cPtr(), LUA_REGISTRYINDEX, itr->second.ref );
+		itr = _s_tasks.erase( itr );
+	}
+}
+
+void LuaScheduler::setBudget( int64_t microseconds )
+{
+	MAGICAL_ASSERT( microseconds > 0, "budget should be positive" );
+	_s_budget = microseconds;
+}
+
+int64_t LuaScheduler::getBudget( void )
+{
+	return _s_budget;
+}
+
+size_t LuaScheduler::getTaskCount( void )
+{
+	return _s_tasks.size();
+}
\ No newline at end of file
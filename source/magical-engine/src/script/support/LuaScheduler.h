@@ -0,0 +1,68 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __LUA_SCHEDULER_H__
+#define __LUA_SCHEDULER_H__
+
+#include "magical-macros.h"
+#include "Common.h"
+#include "LuaState.h"
+
+/*
+基于协程的脚本调度
+
+脚本中用Scheduler.spawn( fn, ... )创建协程，在下一次update中开始执行，协程中可以调用：
+	wait( seconds )      挂起，时间按Director::getDeltaTime累计
+	waitFrames( n )      挂起n帧
+	coroutine.yield()    等同于waitFrames( 1 )
+Scheduler.kill( id )结束协程，Scheduler.count()返回协程的数量
+
+挂起的协程按唤醒的时间和帧保存在最小堆中，每帧只弹出到期的部分，休眠中的协程没有每帧的开销；
+每帧恢复协程的时间有预算，用完时剩下的到期协程推迟到下一帧，它们的唤醒时间更早，下一帧会先被恢复
+协程中的错误只结束这个协程并记录日志，不影响其它协程
+
+统计项：lua.sched.tasks、lua.sched.resumes、lua.sched.errors、lua.sched.overruns、lua.sched.update_us
+*/
+class LuaScheduler
+{
+public:
+	static const int64_t DefaultBudget = 2000;
+
+public:
+	static void init( LuaState* L );
+	static void delc( void );
+
+public:
+	// 每帧调用一次，由Director::FrameEnd触发
+	static void update( void );
+	// 结束所有协程，正在执行的协程在返回后结束
+	static void killAll( void );
+
+public:
+	// 每帧恢复协程的时间预算，微秒
+	static void setBudget( int64_t microseconds );
+	static int64_t getBudget( void );
+	static size_t getTaskCount( void );
+};
+
+#endif //__LUA_SCHEDULER_H__
\ No newline at end of file
@@ -27,6 +27,7 @@ SOFTWARE.
 #include "LuaFunction.h"
 #include "LuaMacros.h"
 #include "LuaObject.h"
+#include "LuaKey.h"
 
 LuaGlobalSelector::LuaGlobalSelector( void )
 {
@@ -40,10 +41,10 @@ LuaGlobalSelector::~LuaGlobalSelector( void )
 
 bool LuaGlobalSelector::isNil( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	lua_State* L = _L->cPtr();
 	bool ret = false;
-	lua_getglobal( L, _key.c_str() );
+	getGlobal( L );
 	if( lua_isnil( L, -1 ) )
 	{
 		ret = true;
@@ -54,10 +55,10 @@ bool LuaGlobalSelector::isNil( void ) const
 
 bool LuaGlobalSelector::isNumber( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	lua_State* L = _L->cPtr();
 	bool ret = false;
-	lua_getglobal( L, _key.c_str() );
+	getGlobal( L );
 	if( lua_isnumber( L, -1 ) )
 	{
 		ret = true;
@@ -68,10 +69,10 @@ bool LuaGlobalSelector::isNumber( void ) const
 
 bool LuaGlobalSelector::isString( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	lua_State* L = _L->cPtr();
 	bool ret = false;
-	lua_getglobal( L, _key.c_str() );
+	getGlobal( L );
 	if( lua_isstring( L, -1 ) )
 	{
 		ret = true;
@@ -82,10 +83,10 @@ bool LuaGlobalSelector::isString( void ) const
 
 bool LuaGlobalSelector::isUserData( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	lua_State* L = _L->cPtr();
 	bool ret = false;
-	lua_getglobal( L, _key.c_str() );
+	getGlobal( L );
 	if( lua_isuserdata( L, -1 ) )
 	{
 		ret = true;
@@ -96,10 +97,10 @@ bool LuaGlobalSelector::isUserData( void ) const
 
 bool LuaGlobalSelector::isTable( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	lua_State* L = _L->cPtr();
 	bool ret = false;
-	lua_getglobal( L, _key.c_str() );
+	getGlobal( L );
 	if( lua_istable( L, -1 ) )
 	{
 		ret = true;
@@ -110,10 +111,10 @@ bool LuaGlobalSelector::isTable( void ) const
 
 bool LuaGlobalSelector::isFunction( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	lua_State* L = _L->cPtr();
 	bool ret = false;
-	lua_getglobal( L, _key.c_str() );
+	getGlobal( L );
 	if( lua_isfunction( L, -1 ) )
 	{
 		ret = true;
@@ -124,10 +125,10 @@ bool LuaGlobalSelector::isFunction( void ) const
 
 bool LuaGlobalSelector::operator==( LuaT t ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	lua_State* L = _L->cPtr();
 	bool ret = false;
-	lua_getglobal( L, _key.c_str() );
+	getGlobal( L );
 	switch( t )
 	{
 	case LuaT::Nil:
@@ -161,10 +162,10 @@ bool LuaGlobalSelector::operator==( LuaT t ) const
 
 int LuaGlobalSelector::toInt( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	lua_State* L = _L->cPtr();
 	int ret = 0;
-	lua_getglobal( L, _key.c_str() );
+	getGlobal( L );
 	if( lua_isnumber( L, -1 ) )
 	{
 		ret = (int) lua_tointeger( L, -1 );
@@ -175,10 +176,10 @@ int LuaGlobalSelector::toInt( void ) const
 
 float LuaGlobalSelector::toFloat( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	lua_State* L = _L->cPtr();
 	float ret = 0.0f;
-	lua_getglobal( L, _key.c_str() );
+	getGlobal( L );
 	if( lua_isnumber( L, -1 ) )
 	{
 		ret = (float) lua_tonumber( L, -1 );
@@ -189,10 +190,10 @@ float LuaGlobalSelector::toFloat( void ) const
 
 double LuaGlobalSelector::toDouble( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	lua_State* L = _L->cPtr();
 	double ret = 0.0;
-	lua_getglobal( L, _key.c_str() );
+	getGlobal( L );
 	if( lua_isnumber( L, -1 ) )
 	{
 		ret = (double) lua_tonumber( L, -1 );
@@ -203,10 +204,10 @@ double LuaGlobalSelector::toDouble( void ) const
 
 std::string LuaGlobalSelector::toString( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	lua_State* L = _L->cPtr();
 	std::string ret;
-	lua_getglobal( L, _key.c_str() );
+	getGlobal( L );
 	if( lua_isstring( L, -1 ) )
 	{
 		ret = lua_tostring( L, -1 );
@@ -217,10 +218,10 @@ std::string LuaGlobalSelector::toString( void ) const
 
 void* LuaGlobalSelector::toUserData( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	lua_State* L = _L->cPtr();
 	void* ret = nullptr;
-	lua_getglobal( L, _key.c_str() );
+	getGlobal( L );
 	if( lua_isuserdata( L, -1 ) )
 	{
 		ret = lua_touserdata( L, -1 );
@@ -231,10 +232,10 @@ void* LuaGlobalSelector::toUserData( void ) const
 
 LuaFunction LuaGlobalSelector::toLuaFunction( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	lua_State* L = _L->cPtr();
 	LuaFunction lf;
-	lua_getglobal( L, _key.c_str() );
+	getGlobal( L );
 
 	int handler = tolua_ext_tofunction( L, lua_gettop( L ), 0 );
 	if( handler != 0 )
@@ -247,10 +248,10 @@ LuaFunction LuaGlobalSelector::toLuaFunction( void ) const
 
 LuaTable LuaGlobalSelector::toLuaTable( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	lua_State* L = _L->cPtr();
 	LuaTable lt;
-	lua_getglobal( L, _key.c_str() );
+	getGlobal( L );
 
 	int handler = tolua_ext_totable( L, lua_gettop( L ), 0 );
 	if( handler != 0 )
@@ -263,138 +264,132 @@ LuaTable LuaGlobalSelector::toLuaTable( void ) const
 
 LuaObject LuaGlobalSelector::toLuaObject( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	lua_State* L = _L->cPtr();
 	LuaObject lobj;
-	lua_getglobal( L, _key.c_str() );
+	getGlobal( L );
 
-	switch( lua_type( L, -1 ) )
-	{
-	case LUA_TNIL:
-		lobj = nullptr;
-		break;
-	case LUA_TBOOLEAN:
-		lobj = (bool) lua_toboolean( L, -1 );
-		break;
-	case LUA_TNUMBER:
-		lobj = (double) lua_tonumber( L, -1 );
-		break;
-	case LUA_TSTRING:
-		lobj = lua_tostring( L, -1 );
-		break;
-	case LUA_TUSERDATA:
-		{
-			int top = lua_gettop( L );
-			std::string type = tolua_typename( L, top );
-			lua_pop( L, 1 );
-			void* userdata = tolua_tousertype( L, top, 0 );
-			lobj.set( userdata, type.c_str() );
-		}
-		break;
-	case LUA_TFUNCTION:
-		{
-			LuaFunction lf;
-			int handler = tolua_ext_tofunction( L, lua_gettop( L ), 0 );
-			if( handler != 0 )
-			{
-				lf.bind( _L, handler );
-			}
-			lobj = lf;
-		}
-		break;
-	case LUA_TTABLE:
-		{
-			LuaTable lt;
-			int handler = tolua_ext_totable( L, lua_gettop( L ), 0 );
-			if( handler != 0 )
-			{
-				lt.bind( _L, handler );
-			}
-			lobj = lt;
-		}
-		break;
-	default:
-		lobj = nullptr;
-		break;
-	}
+	lobj.set( _L, -1 );
 	lua_pop( L, 1 );
 	return lobj;
 }
 
 void LuaGlobalSelector::operator=( int num )
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	_L->push( num );
-	lua_setglobal( _L->cPtr(), _key.c_str() );
+	setGlobal( _L->cPtr() );
 }
 
 void LuaGlobalSelector::operator=( float num )
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	_L->push( num );
-	lua_setglobal( _L->cPtr(), _key.c_str() );
+	setGlobal( _L->cPtr() );
 }
 
 void LuaGlobalSelector::operator=( double num )
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	_L->push( num );
-	lua_setglobal( _L->cPtr(), _key.c_str() );
+	setGlobal( _L->cPtr() );
 }
 
 void LuaGlobalSelector::operator=( const char* str )
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	_L->push( str );
-	lua_setglobal( _L->cPtr(), _key.c_str() );
+	setGlobal( _L->cPtr() );
 }
 
 void LuaGlobalSelector::operator=( const std::string& str )
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	_L->push( str );
-	lua_setglobal( _L->cPtr(), _key.c_str() );
+	setGlobal( _L->cPtr() );
 }
 
 void LuaGlobalSelector::operator=( std::nullptr_t nil )
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	_L->push( nil );
-	lua_setglobal( _L->cPtr(), _key.c_str() );
+	setGlobal( _L->cPtr() );
 }
 
 void LuaGlobalSelector::operator=( const LuaTable& lt )
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	_L->push( lt );
-	lua_setglobal( _L->cPtr(), _key.c_str() );
+	setGlobal( _L->cPtr() );
 }
 
 void LuaGlobalSelector::operator=( const LuaFunction& lf )
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	_L->push( lf );
-	lua_setglobal( _L->cPtr(), _key.c_str() );
+	setGlobal( _L->cPtr() );
 }
 
 void LuaGlobalSelector::operator=( const LuaObject& lobj )
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	_L->push( lobj );
-	lua_setglobal( _L->cPtr(), _key.c_str() );
+	setGlobal( _L->cPtr() );
 }
 
 void LuaGlobalSelector::set( void* userdata, const char* type, bool gc )
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
-	magicalAssert( userdata && type && strlen( type ) > 0, "userdata and type should not be nullptr" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
+	MAGICAL_ASSERT( userdata && type && strlen( type ) > 0, "userdata and type should not be nullptr" );
 	_L->push( userdata, type, gc );
-	lua_setglobal( _L->cPtr(), _key.c_str() );
+	setGlobal( _L->cPtr() );
 }
 
 void LuaGlobalSelector::select( const char* key )
 {
 	_key = key;
+	_lkey.release();
+}
+
+void LuaGlobalSelector::select( const LuaKey& key )
+{
+	MAGICAL_ASSERT( key.getState() == _L, "key belongs to another lua state" );
+	_key.clear();
+	_lkey = key;
+}
+
+void LuaGlobalSelector::getGlobal( lua_State* L ) const
+{
+	if( _lkey == nullptr )
+	{
+		lua_getglobal( L, _key.c_str() );
+		return;
+	}
+
+	_lkey.push( L );
+	lua_gettable( L, LUA_GLOBALSINDEX );
+	demoteKey();
+}
+
+void LuaGlobalSelector::setGlobal( lua_State* L ) const
+{
+	if( _lkey == nullptr )
+	{
+		lua_setglobal( L, _key.c_str() );
+		return;
+	}
+
+	_lkey.push( L );
+	lua_insert( L, -2 );
+	lua_settable( L, LUA_GLOBALSINDEX );
+	demoteKey();
+}
+
+// 再次使用同一个选择结果时按名字查找，结果不变
+void LuaGlobalSelector::demoteKey( void ) const
+{
+	_key = _lkey.getName();
+	_lkey.release();
 }
 
 LuaTableSelector::LuaTableSelector( void )
@@ -409,7 +404,7 @@ LuaTableSelector::~LuaTableSelector( void )
 
 bool LuaTableSelector::isNil( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	if( !_L || !_handler ) 
 		return false;
 
@@ -417,7 +412,7 @@ bool LuaTableSelector::isNil( void ) const
 	lua_State* L = _L->cPtr();
 	tolua_ext_get_table_by_handler( L, _handler );
 
-	lua_getfield( L, -1, _key.c_str() );
+	getField( L );
 	if( lua_isnil( L, -1 ) )
 	{
 		ret = true;
@@ -428,7 +423,7 @@ bool LuaTableSelector::isNil( void ) const
 
 bool LuaTableSelector::isNumber( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	if( !_L || !_handler ) 
 		return false;
 
@@ -436,7 +431,7 @@ bool LuaTableSelector::isNumber( void ) const
 	lua_State* L = _L->cPtr();
 	tolua_ext_get_table_by_handler( L, _handler );
 
-	lua_getfield( L, -1, _key.c_str() );
+	getField( L );
 	if( lua_isnumber( L, -1 ) )
 	{
 		ret = true;
@@ -447,7 +442,7 @@ bool LuaTableSelector::isNumber( void ) const
 
 bool LuaTableSelector::isString( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	if( !_L || !_handler ) 
 		return false;
 
@@ -455,7 +450,7 @@ bool LuaTableSelector::isString( void ) const
 	lua_State* L = _L->cPtr();
 	tolua_ext_get_table_by_handler( L, _handler );
 
-	lua_getfield( L, -1, _key.c_str() );
+	getField( L );
 	if( lua_isstring( L, -1 ) )
 	{
 		ret = true;
@@ -466,7 +461,7 @@ bool LuaTableSelector::isString( void ) const
 
 bool LuaTableSelector::isUserData( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	if( !_L || !_handler ) 
 		return false;
 
@@ -474,7 +469,7 @@ bool LuaTableSelector::isUserData( void ) const
 	lua_State* L = _L->cPtr();
 	tolua_ext_get_table_by_handler( L, _handler );
 
-	lua_getfield( L, -1, _key.c_str() );
+	getField( L );
 	if( lua_isuserdata( L, -1 ) )
 	{
 		ret = true;
@@ -485,7 +480,7 @@ bool LuaTableSelector::isUserData( void ) const
 
 bool LuaTableSelector::isTable( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	if( !_L || !_handler ) 
 		return false;
 
@@ -493,7 +488,7 @@ bool LuaTableSelector::isTable( void ) const
 	lua_State* L = _L->cPtr();
 	tolua_ext_get_table_by_handler( L, _handler );
 
-	lua_getfield( L, -1, _key.c_str() );
+	getField( L );
 	if( lua_istable( L, -1 ) )
 	{
 		ret = true;
@@ -504,7 +499,7 @@ bool LuaTableSelector::isTable( void ) const
 
 bool LuaTableSelector::isFunction( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	if( !_L || !_handler ) 
 		return false;
 
@@ -512,7 +507,7 @@ bool LuaTableSelector::isFunction( void ) const
 	lua_State* L = _L->cPtr();
 	tolua_ext_get_table_by_handler( L, _handler );
 
-	lua_getfield( L, -1, _key.c_str() );
+	getField( L );
 	if( lua_isfunction( L, -1 ) )
 	{
 		ret = true;
@@ -523,7 +518,7 @@ bool LuaTableSelector::isFunction( void ) const
 
 bool LuaTableSelector::operator==( LuaT t ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	if( !_L || !_handler ) 
 		return false;
 
@@ -531,7 +526,7 @@ bool LuaTableSelector::operator==( LuaT t ) const
 	lua_State* L = _L->cPtr();
 	tolua_ext_get_table_by_handler( L, _handler );
 
-	lua_getfield( L, -1, _key.c_str() );
+	getField( L );
 	switch( t )
 	{
 	case LuaT::Nil:
@@ -565,7 +560,7 @@ bool LuaTableSelector::operator==( LuaT t ) const
 
 int LuaTableSelector::toInt( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	if( !_L || !_handler ) 
 		return 0;
 
@@ -573,7 +568,7 @@ int LuaTableSelector::toInt( void ) const
 	lua_State* L = _L->cPtr();
 	tolua_ext_get_table_by_handler( L, _handler );
 
-	lua_getfield( L, -1, _key.c_str() );
+	getField( L );
 	if( lua_isnumber( L, -1 ) )
 	{
 		ret = (int) lua_tointeger( L, -1 );
@@ -584,7 +579,7 @@ int LuaTableSelector::toInt( void ) const
 
 float LuaTableSelector::toFloat( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	if( !_L || !_handler ) 
 		return 0.0f;
 
@@ -592,7 +587,7 @@ float LuaTableSelector::toFloat( void ) const
 	lua_State* L = _L->cPtr();
 	tolua_ext_get_table_by_handler( L, _handler );
 
-	lua_getfield( L, -1, _key.c_str() );
+	getField( L );
 	if( lua_isnumber( L, -1 ) )
 	{
 		ret = (float) lua_tonumber( L, -1 );
@@ -603,7 +598,7 @@ float LuaTableSelector::toFloat( void ) const
 
 double LuaTableSelector::toDouble( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	if( !_L || !_handler ) 
 		return 0.0;
 
@@ -611,7 +606,7 @@ double LuaTableSelector::toDouble( void ) const
 	lua_State* L = _L->cPtr();
 	tolua_ext_get_table_by_handler( L, _handler );
 
-	lua_getfield( L, -1, _key.c_str() );
+	getField( L );
 	if( lua_isnumber( L, -1 ) )
 	{
 		ret = (double) lua_tonumber( L, -1 );
@@ -622,7 +617,7 @@ double LuaTableSelector::toDouble( void ) const
 
 std::string LuaTableSelector::toString( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	if( !_L || !_handler ) 
 		return "";
 
@@ -630,7 +625,7 @@ std::string LuaTableSelector::toString( void ) const
 	lua_State* L = _L->cPtr();
 	tolua_ext_get_table_by_handler( L, _handler );
 
-	lua_getfield( L, -1, _key.c_str() );
+	getField( L );
 	if( lua_isstring( L, -1 ) )
 	{
 		ret = lua_tostring( L, -1 );
@@ -641,7 +636,7 @@ std::string LuaTableSelector::toString( void ) const
 
 void* LuaTableSelector::toUserData( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	if( !_L || !_handler ) 
 		return nullptr;
 
@@ -649,7 +644,7 @@ void* LuaTableSelector::toUserData( void ) const
 	lua_State* L = _L->cPtr();
 	tolua_ext_get_table_by_handler( L, _handler );
 
-	lua_getfield( L, -1, _key.c_str() );
+	getField( L );
 	if( lua_isuserdata( L, -1 ) )
 	{
 		ret = lua_touserdata( L, -1 );
@@ -660,7 +655,7 @@ void* LuaTableSelector::toUserData( void ) const
 
 LuaFunction LuaTableSelector::toLuaFunction( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	if( !_L || !_handler ) 
 		return nullptr;
 
@@ -668,7 +663,7 @@ LuaFunction LuaTableSelector::toLuaFunction( void ) const
 	lua_State* L = _L->cPtr();
 	tolua_ext_get_table_by_handler( L, _handler );
 
-	lua_getfield( L, -1, _key.c_str() );
+	getField( L );
 	int handler = tolua_ext_tofunction( L, lua_gettop( L ), 0 );
 	if( handler != 0 )
 	{
@@ -680,7 +675,7 @@ LuaFunction LuaTableSelector::toLuaFunction( void ) const
 
 LuaTable LuaTableSelector::toLuaTable( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	if( !_L || !_handler ) 
 		return nullptr;
 
@@ -688,7 +683,7 @@ LuaTable LuaTableSelector::toLuaTable( void ) const
 	lua_State* L = _L->cPtr();
 	tolua_ext_get_table_by_handler( L, _handler );
 
-	lua_getfield( L, -1, _key.c_str() );
+	getField( L );
 	int handler = tolua_ext_totable( L, lua_gettop( L ), 0 );
 	if( handler != 0 )
 	{
@@ -700,71 +695,23 @@ LuaTable LuaTableSelector::toLuaTable( void ) const
 
 LuaObject LuaTableSelector::toLuaObject( void ) const
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	if( !_L || !_handler ) 
 		return nullptr;
 
 	lua_State* L = _L->cPtr();
 	LuaObject lobj;
 	tolua_ext_get_table_by_handler( L, _handler );
-	lua_getfield( L, -1, _key.c_str() );
+	getField( L );
 
-	switch( lua_type( L, -1 ) )
-	{
-	case LUA_TNIL:
-		lobj = nullptr;
-		break;
-	case LUA_TBOOLEAN:
-		lobj = (bool) lua_toboolean( L, -1 );
-		break;
-	case LUA_TNUMBER:
-		lobj = (double) lua_tonumber( L, -1 );
-		break;
-	case LUA_TSTRING:
-		lobj = lua_tostring( L, -1 );
-		break;
-	case LUA_TUSERDATA:
-		{
-			int top = lua_gettop( L );
-			std::string type = tolua_typename( L, top );
-			lua_pop( L, 1 );
-			void* userdata = tolua_tousertype( L, top, 0 );
-			lobj.set( userdata, type.c_str() );
-		}
-		break;
-	case LUA_TFUNCTION:
-		{
-			LuaFunction lf;
-			int handler = tolua_ext_tofunction( L, lua_gettop( L ), 0 );
-			if( handler != 0 )
-			{
-				lf.bind( _L, handler );
-			}
-			lobj = lf;
-		}
-		break;
-	case LUA_TTABLE:
-		{
-			LuaTable lt;
-			int handler = tolua_ext_totable( L, lua_gettop( L ), 0 );
-			if( handler != 0 )
-			{
-				lt.bind( _L, handler );
-			}
-			lobj = lt;
-		}
-		break;
-	default:
-		lobj = nullptr;
-		break;
-	}
-	lua_pop( L, 1 );
+	lobj.set( _L, -1 );
+	lua_pop( L, 2 );
 	return lobj;
 }
 
 void LuaTableSelector::operator=( int num )
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	if( !_L || !_handler ) 
 		return;
 
@@ -772,13 +719,13 @@ void LuaTableSelector::operator=( int num )
 	tolua_ext_get_table_by_handler( L, _handler );
 
 	_L->push( num );
-	lua_setfield( L, -2, _key.c_str() );
+	setField( L );
 	lua_pop( L, 1 );
 }
 
 void LuaTableSelector::operator=( float num )
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	if( !_L || !_handler ) 
 		return;
 
@@ -786,13 +733,13 @@ void LuaTableSelector::operator=( float num )
 	tolua_ext_get_table_by_handler( L, _handler );
 
 	_L->push( num );
-	lua_setfield( L, -2, _key.c_str() );
+	setField( L );
 	lua_pop( L, 1 );
 }
 
 void LuaTableSelector::operator=( double num )
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	if( !_L || !_handler ) 
 		return;
 
@@ -800,13 +747,13 @@ void LuaTableSelector::operator=( double num )
 	tolua_ext_get_table_by_handler( L, _handler );
 
 	_L->push( num );
-	lua_setfield( L, -2, _key.c_str() );
+	setField( L );
 	lua_pop( L, 1 );
 }
 
 void LuaTableSelector::operator=( const char* str )
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	if( !_L || !_handler ) 
 		return;
 
@@ -814,13 +761,13 @@ void LuaTableSelector::operator=( const char* str )
 	tolua_ext_get_table_by_handler( L, _handler );
 
 	_L->push( str );
-	lua_setfield( L, -2, _key.c_str() );
+	setField( L );
 	lua_pop( L, 1 );
 }
 
 void LuaTableSelector::operator=( const std::string& str )
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	if( !_L || !_handler ) 
 		return;
 
@@ -828,13 +775,13 @@ void LuaTableSelector::operator=( const std::string& str )
 	tolua_ext_get_table_by_handler( L, _handler );
 
 	_L->push( str );
-	lua_setfield( L, -2, _key.c_str() );
+	setField( L );
 	lua_pop( L, 1 );
 }
 
 void LuaTableSelector::operator=( std::nullptr_t nil )
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	if( !_L || !_handler ) 
 		return;
 
@@ -842,13 +789,13 @@ void LuaTableSelector::operator=( std::nullptr_t nil )
 	tolua_ext_get_table_by_handler( L, _handler );
 
 	_L->push( nil );
-	lua_setfield( L, -2, _key.c_str() );
+	setField( L );
 	lua_pop( L, 1 );
 }
 
 void LuaTableSelector::operator=( const LuaTable& lt )
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	if( !_L || !_handler ) 
 		return;
 
@@ -856,13 +803,13 @@ void LuaTableSelector::operator=( const LuaTable& lt )
 	tolua_ext_get_table_by_handler( L, _handler );
 
 	_L->push( lt );
-	lua_setfield( L, -2, _key.c_str() );
+	setField( L );
 	lua_pop( L, 1 );
 }
 
 void LuaTableSelector::operator=( const LuaFunction& lf )
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	if( !_L || !_handler ) 
 		return;
 
@@ -870,13 +817,13 @@ void LuaTableSelector::operator=( const LuaFunction& lf )
 	tolua_ext_get_table_by_handler( L, _handler );
 
 	_L->push( lf );
-	lua_setfield( L, -2, _key.c_str() );
+	setField( L );
 	lua_pop( L, 1 );
 }
 
 void LuaTableSelector::operator=( const LuaObject& lobj )
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
 	if( !_L || !_handler ) 
 		return;
 
@@ -884,14 +831,14 @@ void LuaTableSelector::operator=( const LuaObject& lobj )
 	tolua_ext_get_table_by_handler( L, _handler );
 
 	_L->push( lobj );
-	lua_setfield( L, -2, _key.c_str() );
+	setField( L );
 	lua_pop( L, 1 );
 }
 
 void LuaTableSelector::set( void* userdata, const char* type, bool gc )
 {
-	magicalAssert( !_key.empty(), "key should not be empty!" );
-	magicalAssert( userdata && type && strlen( type ) > 0, "userdata and type should not be nullptr" );
+	MAGICAL_ASSERT( hasKey(), "key should not be empty!" );
+	MAGICAL_ASSERT( userdata && type && strlen( type ) > 0, "userdata and type should not be nullptr" );
 	if( !_L || !_handler ) 
 		return;
 
@@ -899,13 +846,50 @@ void LuaTableSelector::set( void* userdata, const char* type, bool gc )
 	tolua_ext_get_table_by_handler( L, _handler );
 
 	_L->push( userdata, type, gc );
-	lua_setfield( L, -2, _key.c_str() );
+	setField( L );
 	lua_pop( L, 1 );
 }
 
 void LuaTableSelector::select( const char* key, LuaState* L, LuaTableHandler handler )
 {
 	_key = key;
+	_lkey.release();
 	_L = L;
 	_handler = handler;
+}
+
+void LuaTableSelector::select( const LuaKey& key, LuaState* L, LuaTableHandler handler )
+{
+	MAGICAL_ASSERT( L == nullptr || key.getState() == L, "key belongs to another lua state" );
+	_key.clear();
+	_lkey = key;
+	_L = L;
+	_handler = handler;
+}
+
+// 栈顶是table，取出的值压在table之上
+void LuaTableSelector::getField( lua_State* L ) const
+{
+	if( _lkey == nullptr )
+	{
+		lua_getfield( L, -1, _key.c_str() );
+		return;
+	}
+
+	_lkey.push( L );
+	lua_gettable( L, -2 );
+}
+
+// 栈顶是要设置的值，其下是table，值被弹出
+void LuaTableSelector::setField( lua_State* L ) const
+{
+	if( _lkey == nullptr )
+	{
+		lua_setfield( L, -2, _key.c_str() );
+		return;
+	}
+
+	_lkey.push( L );
+	lua_insert( L, -2 );
+	lua_settable( L, -3 );
 }
\ No newline at end of file
@@ -24,9 +24,10 @@ SOFTWARE.
 #ifndef __LUA_SELECTOR_H__
 #define __LUA_SELECTOR_H__
 
-#include "PlatformMacros.h"
+#include "magical-macros.h"
 #include "Common.h"
 #include "LuaMacros.h"
+#include "LuaKey.h"
 
 class LuaState;
 class LuaTable;
@@ -76,10 +77,18 @@ public:
 
 private:
 	void select( const char* key );
+	void select( const LuaKey& key );
+	inline bool hasKey( void ) const { return _lkey != nullptr || !_key.empty(); }
+	void getGlobal( lua_State* L ) const;
+	void setGlobal( lua_State* L ) const;
+	void demoteKey( void ) const;
 
 private:
 	friend class LuaState;
-	std::string _key;
+	mutable std::string _key;
+	// 由LuaKey选择时共享键的槽位，不复制字符串；选择器是LuaState的成员，
+	// 持有的键又引用LuaState，所以每次取值或赋值之后就改为按名字选择并释放键，不形成循环
+	mutable LuaKey _lkey;
 	LuaState* _L = nullptr;
 };
 
@@ -126,10 +135,16 @@ public:
 
 private:
 	void select( const char* key, LuaState* L, LuaTableHandler handler );
+	void select( const LuaKey& key, LuaState* L, LuaTableHandler handler );
+	inline bool hasKey( void ) const { return _lkey != nullptr || !_key.empty(); }
+	void getField( lua_State* L ) const;
+	void setField( lua_State* L ) const;
 
 private:
 	friend class LuaTable;
 	std::string _key;
+	// 持有键的副本，键的原对象先释放时槽位仍然有效，不会被复用
+	LuaKey _lkey;
 	LuaState* _L = nullptr;
 	LuaTableHandler _handler = 0;
 };
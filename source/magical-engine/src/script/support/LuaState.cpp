@@ -22,7 +22,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 *******************************************************************************/
 #include "LuaState.h"
-#include "AssetsSystem.h"
+#include "Assets.h"
 
 #include "lua.hpp"
 #include "tolua++.h"
@@ -31,15 +31,23 @@ SOFTWARE.
 #include "LuaObject.h"
 #include "LuaTable.h"
 #include "LuaFunction.h"
+#include "LuaKey.h"
+#include "LuaBytecodeCache.h"
 
 #include "BindCommon.h"
 
+#include <atomic>
+
+// 工作线程各自创建LuaState
+static std::atomic<int> _s_live_count( 0 );
+
 LuaState::LuaState( void )
 {
 	_L = luaL_newstate();
-	magicalAssert( _L, "luaL_newstate() failed" );
+	MAGICAL_ASSERT( _L, "luaL_newstate() failed" );
 
 	_selector._L = this;
+	++ _s_live_count;
 }
 
 LuaState::~LuaState( void )
@@ -48,11 +56,18 @@ LuaState::~LuaState( void )
 	{
 		lua_close( _L );
 	}
+	-- _s_live_count;
+}
+
+int LuaState::getLiveCount( void )
+{
+	return _s_live_count.load();
 }
 
 void LuaState::openLibs( void )
 {
 	luaL_openlibs( _L );
+	LuaBytecodeCache::installLoader( _L );
 }
 
 void LuaState::attachPath( const char* path )
@@ -78,7 +93,10 @@ LuaCode LuaState::runScript( const char* lscript )
 
 LuaCode LuaState::runScriptFile( const char* lfile )
 {
-	int ret = luaL_dofile( _L, lfile );
+	// 编译经过字节码缓存，相当于luaL_dofile
+	int ret = LuaBytecodeCache::loadFile( _L, lfile );
+	if( ret == 0 )
+		ret = lua_pcall( _L, 0, LUA_MULTRET, 0 );
 	if( ret == 0 )
 		return (LuaCode) 0;
 
@@ -93,6 +111,27 @@ LuaGlobalSelector& LuaState::operator[]( const char* key )
 	return _selector;
 }
 
+LuaGlobalSelector& LuaState::operator[]( const LuaKey& key )
+{
+	_selector.select( key );
+	return _selector;
+}
+
+LuaTable LuaState::newTable( int narr, int nrec )
+{
+	LuaTable lt;
+	pushTable( narr, nrec );
+	lt.bind( this, tolua_ext_totable( _L, -1, 0 ) );
+	lua_pop( _L, 1 );
+	return lt;
+}
+
+void LuaState::pushTable( int narr, int nrec )
+{
+	MAGICAL_ASSERT( narr >= 0 && nrec >= 0, "invalid table size" );
+	lua_createtable( _L, narr, nrec );
+}
+
 void LuaState::push( std::nullptr_t nil )
 {
 	lua_pushnil( _L );
@@ -146,7 +185,7 @@ void LuaState::push( const LuaFunction& lf )
 	}
 	else
 	{
-		tolua_ext_get_function_by_handler( _L, lf._handler );
+		tolua_ext_get_function_by_handler( _L, lf._ref->getHandler() );
 	}
 }
 
@@ -158,13 +197,13 @@ void LuaState::push( const LuaTable& lt )
 	}
 	else
 	{
-		tolua_ext_get_table_by_handler( _L, lt._handler );
+		tolua_ext_get_table_by_handler( _L, lt._ref->getHandler() );
 	}
 }
 
 void LuaState::push( const LuaObject& lobj )
 {
-	switch( lobj._type )
+	switch( lobj.getType() )
 	{
 	case LuaT::Nil:
 		lua_pushnil( _L );
@@ -176,19 +215,32 @@ void LuaState::push( const LuaObject& lobj )
 		lua_pushnumber( _L, (lua_Number) lobj._number );
 		break;
 	case LuaT::String:
-		lua_pushstring( _L, lobj._string.c_str() );
+		lua_pushlstring( _L, lobj.toCString(), lobj.length() );
 		break;
 	case LuaT::UserData:
-		push( lobj._userdata, lobj._usertype.c_str(), lobj._is_gc );
+		push( lobj._userdata.ptr, lobj._userdata.type, lobj._is_gc );
 		break;
 	case LuaT::Function:
-		push( lobj._function );
+		tolua_ext_get_function_by_handler( _L, lobj._ref->getHandler() );
 		break;
 	case LuaT::Table:
-		push( lobj._table );
+		tolua_ext_get_table_by_handler( _L, lobj._ref->getHandler() );
 		break;
 	default:
 		lua_pushnil( _L );
 		break;
 	}
-}
\ No newline at end of file
+}
+
+void LuaState::push( const LuaKey& key )
+{
+	if( key == nullptr )
+	{
+		lua_pushnil( _L );
+	}
+	else
+	{
+		MAGICAL_ASSERT( key.getState() == this, "key belongs to another lua state" );
+		key.push( _L );
+	}
+}
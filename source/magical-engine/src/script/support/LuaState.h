@@ -24,17 +24,20 @@ SOFTWARE.
 #ifndef __LUA_STATE_H__
 #define __LUA_STATE_H__
 
-#include "PlatformMacros.h"
+#include "magical-macros.h"
 #include "Common.h"
 #include "Reference.h"
 
 #include "LuaMacros.h"
 #include "LuaSelector.h"
 
+#include <vector>
+
 class LuaTable;
 class LuaFunction;
 class LuaObject;
 class LuaGlobalSelector;
+class LuaKey;
 
 enum class LuaCode
 {
@@ -51,6 +54,10 @@ public:
 	LuaState& operator=( LuaState&& ls ) = delete;
 	LuaState& operator=( const LuaState& ls ) = delete;
 
+public:
+	// 还未销毁的LuaState个数，为0时才能释放LuaValuePool的内存
+	static int getLiveCount( void );
+
 public:
 	void openLibs( void );
 	void attachPath( const char* path );
@@ -58,6 +65,12 @@ public:
 	LuaCode runScript( const char* lscript );
 	LuaCode runScriptFile( const char* lfile );
 	LuaGlobalSelector& operator[]( const char* key );
+	LuaGlobalSelector& operator[]( const LuaKey& key );
+
+public:
+	// 创建预先分配了narr个数组元素和nrec个哈希元素的table，填充时不再逐步扩容
+	LuaTable newTable( int narr, int nrec = 0 );
+	void pushTable( int narr, int nrec = 0 );
 
 public:
 	void push( std::nullptr_t nil );
@@ -71,6 +84,21 @@ public:
 	void push( const LuaFunction& lf );
 	void push( const LuaTable& lt );
 	void push( const LuaObject& lobj );
+	void push( const LuaKey& key );
+	// 数组按1开始的下标压为table，table按元素个数一次分配
+	template< typename T >
+	void push( const std::vector< T >& values ) { pushArray( values.data(), values.size() ); }
+	template< typename T >
+	void pushArray( const T* values, size_t count )
+	{
+		MAGICAL_ASSERT( values || count == 0, "values should not be nullptr" );
+		lua_createtable( _L, (int) count, 0 );
+		for( size_t i = 0; i < count; ++i )
+		{
+			push( values[i] );
+			lua_rawseti( _L, -2, (int) i + 1 );
+		}
+	}
 	
 private:
 	LuaGlobalSelector _selector;
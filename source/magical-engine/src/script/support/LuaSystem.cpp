@@ -22,35 +22,212 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 *******************************************************************************/
 #include "LuaSystem.h"
-#include "AssetsSystem.h"
+#include "Assets.h"
 
 #include "lua.hpp"
 #include "tolua++.h"
 #include "tolua_ext.h"
 #include "LuaExtensions.h"
+#include "LuaReference.h"
+#include "LuaFFI.h"
+#include "LuaValuePool.h"
+#include "LuaGC.h"
+#include "LuaScheduler.h"
+#include "LuaBytecodeCache.h"
+#include "LuaWorkers.h"
 
+#ifndef MAGICAL_SCRIPT_BINDINGS_DISABLED
 #include "BindCommon.h"
+#else
+#include "BindMath.h"
+#endif
+#include "Stats.h"
+
+#include <string.h>
+#include <vector>
 
 static LuaState* _s_L = nullptr;
 
+#ifndef MAGICAL_SCRIPT_BINDINGS_DISABLED
+// BindCommon注册的类型中工作线程可以使用的，只包含值类型，不访问Director、Assets等主线程对象
+static const char* _s_worker_globals[] = {
+	"AxisAngle",
+	"EulerAngles",
+	"Matrix4",
+	"Quaternion",
+	"Vector2",
+	"Vector3",
+	"Vector4",
+	nullptr
+};
+
+static bool isWorkerGlobal( const char* name )
+{
+	for( const char** itr = _s_worker_globals; *itr; ++itr )
+	{
+		if( strcmp( *itr, name ) == 0 )
+			return true;
+	}
+	return false;
+}
+#endif
+
+static int64_t luaMemory( void )
+{
+	return _s_L ? lua_gc( _s_L->cPtr(), LUA_GCCOUNT, 0 ) : 0;
+}
+
+static magical::Stat _stat_lua_memory( "lua.memory_kb", magical::Stat::Gauge, luaMemory );
+
+// Stats.get( name )，返回上一帧的值
+static int lua_stats_get( lua_State* L )
+{
+	const char* name = luaL_checkstring( L, 1 );
+	lua_pushnumber( L, (lua_Number) magical::Stats::get( name ) );
+	return 1;
+}
+
+// Stats.all()，返回名称到上一帧的值的表
+static int lua_stats_all( lua_State* L )
+{
+	magical::Vector<magical::Stat*> stats;
+	magical::Stats::getAll( stats );
+
+	lua_createtable( L, 0, (int) stats.size() );
+	for( auto stat : stats )
+	{
+		lua_pushnumber( L, (lua_Number) stat->getLastValue() );
+		lua_setfield( L, -2, stat->getName() );
+	}
+	return 1;
+}
+
+static const luaL_Reg lua_stats_functions[] = {
+	{ "get", lua_stats_get },
+	{ "all", lua_stats_all },
+	{ nullptr, nullptr }
+};
+
 void Lua::init( void )
 {
 	_s_L = new LuaState();
-	_s_L->openLibs();
+	openBindings( _s_L );
+
+	luaL_register( _s_L->cPtr(), "Stats", lua_stats_functions );
+	lua_pop( _s_L->cPtr(), 1 );
+
+	// 调度器先于GC挂接，每帧协程产生的垃圾在同一帧回收
+	LuaScheduler::init( _s_L );
+	LuaGC::init( _s_L );
+}
+
+void Lua::delc( void )
+{
+	LuaWorkers::stop();
+	LuaScheduler::delc();
+	LuaGC::delc();
+
+	_s_L->release();
+	_s_L = nullptr;
+
+	LuaReference::purge();
 
-	luaopen_tolua_ext( _s_L->cPtr() );
-	luaopen_extensions( _s_L->cPtr() );
-	luaopen_common( _s_L->cPtr() );
+	// 共享状态可能还被持有（例如静态的LuaKey），它关闭时__gc仍会把userdata归还到池中，
+	// 只有所有LuaState都已关闭才释放池的内存，否则留到进程退出
+	if( LuaState::getLiveCount() == 0 )
+		LuaValuePool::purge();
+	else
+		MAGICAL_LOGW( magical::System::format( "%d lua state(s) still alive after Lua::delc(), value pool kept", LuaState::getLiveCount() ).c_str() );
+	LuaBytecodeCache::clear();
+}
+
+void Lua::openBindings( LuaState* L )
+{
+	MAGICAL_ASSERT( L, "L should not be nullptr" );
+
+	L->openLibs();
+
+	luaopen_tolua_ext( L->cPtr() );
+	luaopen_extensions( L->cPtr() );
+#ifndef MAGICAL_SCRIPT_BINDINGS_DISABLED
+	// BindCommon由tolua++按旧的数学接口生成，重新生成之前Linux构建不包含它，只注册数学类型
+	luaopen_common( L->cPtr() );
+#else
+	luaopen_magical_math( L->cPtr() );
+#endif
 
 #ifdef MAGICAL_WIN32
 	std::string standard_path = Assets::getAssetsPath() + "standard/scripts";
-	_s_L->attachPath( standard_path.c_str() );
+	L->attachPath( standard_path.c_str() );
+#endif
+
+#ifdef MAGICAL_USING_LUAJIT
+	// 脚本通过require( "ffimath" )使用cdata类型，tolua注册的全局类型不变
+	LuaFFI::open( L );
 #endif
 }
 
-void Lua::delc( void )
+/*
+BindCommon是一个整体生成的模块，注册之后把新增的全局变量中不在_s_worker_globals里的移除；
+不加载socket等扩展，工作线程中的脚本只做计算
+*/
+void Lua::openWorkerBindings( LuaState* L )
 {
-	_s_L->release();
+	MAGICAL_ASSERT( L, "L should not be nullptr" );
+
+	L->openLibs();
+
+	lua_State* ls = L->cPtr();
+	luaopen_tolua_ext( ls );
+#ifndef MAGICAL_SCRIPT_BINDINGS_DISABLED
+	int top = lua_gettop( ls );
+	lua_newtable( ls );
+	for( lua_pushnil( ls ); lua_next( ls, LUA_GLOBALSINDEX ) != 0; lua_pop( ls, 1 ) )
+	{
+		lua_pushvalue( ls, -2 );
+		lua_pushboolean( ls, 1 );
+		lua_rawset( ls, top + 1 );
+	}
+
+	luaopen_common( ls );
+	lua_settop( ls, top + 1 );
+
+	std::vector<std::string> removed;
+	for( lua_pushnil( ls ); lua_next( ls, LUA_GLOBALSINDEX ) != 0; lua_pop( ls, 1 ) )
+	{
+		if( lua_type( ls, -2 ) != LUA_TSTRING )
+			continue;
+
+		lua_pushvalue( ls, -2 );
+		lua_rawget( ls, top + 1 );
+		bool existed = lua_toboolean( ls, -1 ) != 0;
+		lua_pop( ls, 1 );
+
+		const char* name = lua_tostring( ls, -2 );
+		if( !existed && !isWorkerGlobal( name ) )
+			removed.push_back( name );
+	}
+	lua_settop( ls, top );
+
+	// 遍历时不能修改表，结束后再移除
+	for( const auto& name : removed )
+	{
+		lua_pushnil( ls );
+		lua_setglobal( ls, name.c_str() );
+	}
+#else
+	// BindMath只注册值类型，不需要过滤
+	luaopen_magical_math( ls );
+#endif
+
+#ifdef MAGICAL_WIN32
+	std::string standard_path = Assets::getAssetsPath() + "standard/scripts";
+	L->attachPath( standard_path.c_str() );
+#endif
+
+#ifdef MAGICAL_USING_LUAJIT
+	LuaFFI::open( L );
+#endif
 }
 
 LuaState& Lua::sharedLuaState( void )
@@ -24,7 +24,7 @@ SOFTWARE.
 #ifndef __LUA_SYSTEM_H__
 #define __LUA_SYSTEM_H__
 
-#include "PlatformMacros.h"
+#include "magical-macros.h"
 #include "Common.h"
 #include "LuaState.h"
 
@@ -33,6 +33,10 @@ class Lua
 public:
 	static void init( void );
 	static void delc( void );
+	// 加载标准库和引擎的绑定
+	static void openBindings( LuaState* L );
+	// LuaWorkers的状态只加载标准库和不依赖引擎状态的绑定（数学类型）
+	static void openWorkerBindings( LuaState* L );
 
 public:
 	static LuaState& sharedLuaState( void );
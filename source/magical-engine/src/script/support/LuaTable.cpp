@@ -25,6 +25,7 @@ SOFTWARE.
 #include "LuaObject.h"
 #include "LuaState.h"
 #include "LuaFunction.h"
+#include "LuaKey.h"
 
 LuaTable::LuaTable( void )
 {
@@ -38,22 +39,15 @@ LuaTable::LuaTable( std::nullptr_t nt )
 
 LuaTable::LuaTable( LuaTable&& lt )
 {
-	_L = lt._L;
-	_handler = lt._handler;
-	_reference_count = lt._reference_count;
-
-	lt._handler = 0;
-	lt._L = nullptr;
-	lt._reference_count = nullptr;
+	_ref = lt._ref;
+	lt._ref = nullptr;
 }
 
 LuaTable::LuaTable( const LuaTable& lt )
 {
-	_L = lt._L;
-	_handler = lt._handler;
-	_reference_count = lt._reference_count;
-
-	++( *_reference_count );
+	_ref = lt._ref;
+	if( _ref )
+		_ref->retain();
 }
 
 LuaTable::~LuaTable( void )
@@ -63,25 +57,22 @@ LuaTable::~LuaTable( void )
 
 LuaTable& LuaTable::operator=( LuaTable&& lt )
 {
-	release();
-	_L = lt._L;
-	_handler = lt._handler;
-	_reference_count = lt._reference_count;
-
-	lt._handler = 0;
-	lt._L = nullptr;
-	lt._reference_count = nullptr;
+	if( this != &lt )
+	{
+		release();
+		_ref = lt._ref;
+		lt._ref = nullptr;
+	}
 	return *this;
 }
 
 LuaTable& LuaTable::operator=( const LuaTable& lt )
 {
-	release();
-	_L = lt._L;
-	_handler = lt._handler;
-	_reference_count = lt._reference_count;
+	if( lt._ref )
+		lt._ref->retain();
 
-	++( *_reference_count );
+	release();
+	_ref = lt._ref;
 	return *this;
 }
 
@@ -93,49 +84,45 @@ LuaTable& LuaTable::operator=( std::nullptr_t nt )
 
 bool LuaTable::operator==( std::nullptr_t nt ) const
 {
-	return !( _L && _handler );
+	return _ref == nullptr;
 }
 
 bool LuaTable::operator!=( std::nullptr_t nt ) const
 {
-	return  _L && _handler;
+	return _ref != nullptr;
 }
 
 LuaTableSelector& LuaTable::operator[]( const char* key )
 {
-	_selector.select( key, _L, _handler );
+	if( _ref )
+		_selector.select( key, _ref->getState(), _ref->getHandler() );
+	else
+		_selector.select( key, nullptr, 0 );
+	return _selector;
+}
+
+LuaTableSelector& LuaTable::operator[]( const LuaKey& key )
+{
+	if( _ref )
+		_selector.select( key, _ref->getState(), _ref->getHandler() );
+	else
+		_selector.select( key, nullptr, 0 );
 	return _selector;
 }
 
 void LuaTable::bind( LuaState* L, LuaTableHandler handler )
 {
-	magicalAssert( L && handler, "invalid lua state or lua table handler" );
+	MAGICAL_ASSERT( L && handler, "invalid lua state or lua table handler" );
 	release();
 
-	_L = L;
-	_L->retain();
-	_handler = handler;
-	_reference_count = new int( 1 );
+	_ref = LuaReference::create( L, handler, LuaReference::Table );
 }
 
 void LuaTable::release( void )
 {
-	if( !_reference_count )
+	if( !_ref )
 		return;
 
-	magicalAssert( *_reference_count > 0, "invalid lua table _reference_count." );
-	--( *_reference_count );
-
-	if( *_reference_count == 0 )
-	{
-		magicalAssert( _L && _handler, "invaild lua state or lua table handler" );
-		tolua_ext_remove_table_by_handler( _L->cPtr(), _handler );
-
-		_L->release();
-		delete _reference_count;
-	}
-
-	_L = nullptr;
-	_handler = 0;
-	_reference_count = nullptr;
+	_ref->release();
+	_ref = nullptr;
 }
\ No newline at end of file
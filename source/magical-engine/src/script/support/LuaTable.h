@@ -24,16 +24,18 @@ SOFTWARE.
 #ifndef __LUA_TABLE_H__
 #define __LUA_TABLE_H__
 
-#include "PlatformMacros.h"
+#include "magical-macros.h"
 #include "Common.h"
 
 #include "LuaMacros.h"
 #include "LuaSelector.h"
+#include "LuaReference.h"
 
 class LuaState;
 class LuaTable;
 class LuaFunction;
 class LuaTableSelector;
+class LuaKey;
 
 class LuaTable
 {
@@ -51,15 +53,16 @@ public:
 	bool operator==( std::nullptr_t nt ) const;
 	bool operator!=( std::nullptr_t nt ) const;
 	LuaTableSelector& operator[]( const char* key );
+	LuaTableSelector& operator[]( const LuaKey& key );
 	void bind( LuaState* L, LuaTableHandler handler );
 	void release( void );
 
 private:
 	friend class LuaState;
+	friend class LuaObject;
+	friend class LuaField;
 	LuaTableSelector _selector;
-	LuaState* _L = nullptr;
-	LuaTableHandler _handler = 0;
-	int* _reference_count = nullptr;
+	LuaReference* _ref = nullptr;
 };
 
 #endif //__LUA_TABLE_H__
\ No newline at end of file
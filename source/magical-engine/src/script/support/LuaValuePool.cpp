@@ -0,0 +1,130 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "LuaValuePool.h"
+#include "Stats.h"
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+static const size_t _s_block_align = 16;
+static const size_t _s_classes = LuaValuePool::MaxSize / _s_block_align;
+static const size_t _s_chunk_size = 4096;
+
+struct LuaFreeBlock
+{
+	LuaFreeBlock* next;
+};
+
+// 整块由所有线程共享，只在切分新块和purge时加锁
+static std::mutex _s_chunks_mutex;
+static std::vector<char*> _s_chunks;
+static std::atomic<uint32_t> _s_generation( 0 );
+
+/*
+空闲链表属于各自的线程，回收发生在LuaState所在的线程，热路径上不需要加锁；
+在一个线程分配、另一个线程回收的块会留在回收线程的链表中
+purge之后旧的线程局部链表失效，下次使用时清空
+*/
+static MAGICAL_THREAD_LOCAL LuaFreeBlock* _s_free_lists[_s_classes];
+static MAGICAL_THREAD_LOCAL uint32_t _s_thread_generation = 0;
+
+static magical::Stat _stat_pool_allocs( "lua.pool.allocs", magical::Stat::Counter );
+static magical::Stat _stat_pool_chunks( "lua.pool.chunks", magical::Stat::Gauge );
+
+static LuaFreeBlock** threadFreeLists( void )
+{
+	uint32_t generation = _s_generation.load( std::memory_order_acquire );
+	if( _s_thread_generation != generation )
+	{
+		for( size_t i = 0; i < _s_classes; ++i )
+			_s_free_lists[i] = nullptr;
+
+		_s_thread_generation = generation;
+	}
+	return _s_free_lists;
+}
+
+void* LuaValuePool::alloc( size_t size )
+{
+	if( size == 0 || size > MaxSize )
+		return ::operator new( size );
+
+	size_t index = ( size - 1 ) / _s_block_align;
+	LuaFreeBlock** free_lists = threadFreeLists();
+	_stat_pool_allocs.add();
+
+	LuaFreeBlock* block = free_lists[index];
+	if( block == nullptr )
+	{
+		// 整块切分后挂到当前线程的空闲链表
+		size_t block_size = ( index + 1 ) * _s_block_align;
+		char* chunk = (char*) ::operator new( _s_chunk_size );
+		{
+			std::lock_guard<std::mutex> lock( _s_chunks_mutex );
+			_s_chunks.push_back( chunk );
+			_stat_pool_chunks.set( (int64_t) _s_chunks.size() );
+		}
+
+		for( size_t offset = 0; offset + block_size <= _s_chunk_size; offset += block_size )
+		{
+			LuaFreeBlock* free_block = (LuaFreeBlock*) ( chunk + offset );
+			free_block->next = block;
+			block = free_block;
+		}
+	}
+
+	free_lists[index] = block->next;
+	return block;
+}
+
+void LuaValuePool::free( void* ptr, size_t size )
+{
+	if( ptr == nullptr )
+		return;
+
+	if( size == 0 || size > MaxSize )
+	{
+		::operator delete( ptr );
+		return;
+	}
+
+	size_t index = ( size - 1 ) / _s_block_align;
+	LuaFreeBlock** free_lists = threadFreeLists();
+	LuaFreeBlock* block = (LuaFreeBlock*) ptr;
+
+	block->next = free_lists[index];
+	free_lists[index] = block;
+}
+
+void LuaValuePool::purge( void )
+{
+	std::lock_guard<std::mutex> lock( _s_chunks_mutex );
+	_s_generation.fetch_add( 1, std::memory_order_release );
+
+	for( auto chunk : _s_chunks )
+		::operator delete( chunk );
+
+	_s_chunks.clear();
+	_stat_pool_chunks.set( 0 );
+}
\ No newline at end of file
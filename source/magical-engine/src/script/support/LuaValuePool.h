@@ -0,0 +1,78 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __LUA_VALUE_POOL_H__
+#define __LUA_VALUE_POOL_H__
+
+#include "magical-macros.h"
+#include "Common.h"
+
+/*
+tolua绑定中值类型（Vector3、Quaternion、Matrix4等）的内存池
+
+这些类型返回给脚本时都要在堆上复制一份，由__gc释放，脚本中的每次运算都是一次new和delete；
+这里按16字节分级，每个线程缓存自己的空闲块，块在Lua::delc之前不归还给系统
+只缓存不超过MaxSize的类型，更大的直接使用::operator new
+*/
+class LuaValuePool
+{
+public:
+	static const size_t MaxSize = 64;
+	struct Tag {};
+
+public:
+	static void* alloc( size_t size );
+	static void free( void* ptr, size_t size );
+	// 释放所有块，调用前必须保证没有脚本对象还在使用
+	static void purge( void );
+
+	template< class T >
+	static void destroy( T* ptr );
+};
+
+template< class T >
+void LuaValuePool::destroy( T* ptr )
+{
+	if( ptr == nullptr )
+		return;
+
+	ptr->~T();
+	free( ptr, sizeof( T ) );
+}
+
+inline void* operator new( size_t size, LuaValuePool::Tag )
+{
+	return LuaValuePool::alloc( size );
+}
+
+// 值类型的构造函数不会抛出异常，只为与placement new配对
+inline void operator delete( void* ptr, LuaValuePool::Tag )
+{
+
+}
+
+// 供toluapp-basic.lua替换生成代码中的Mtolua_new和Mtolua_delete
+#define Mtolua_pool_new(EXP) new( LuaValuePool::Tag() ) EXP
+#define Mtolua_pool_delete(EXP) LuaValuePool::destroy( EXP )
+
+#endif //__LUA_VALUE_POOL_H__
\ No newline at end of file
@@ -0,0 +1,295 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "LuaWorkers.h"
+#include "LuaSystem.h"
+#include "LuaReference.h"
+#include "Profiler.h"
+#include "Stats.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#include "lua.hpp"
+
+static std::mutex _s_mutex;
+static std::condition_variable _s_start_condition;
+static std::condition_variable _s_done_condition;
+static std::vector<std::thread> _s_workers;
+static bool _s_stopping = false;
+static size_t _s_ready = 0;
+static size_t _s_start_failed = 0;
+
+// 以下状态在_s_mutex下由run()写入，工作线程看到新的批次号后读取
+static LuaBatch* _s_batch = nullptr;
+static uint32_t _s_batch_id = 0;
+static size_t _s_chunk_count = 0;
+static size_t _s_running = 0;
+static std::atomic<size_t> _s_next_chunk( 0 );
+static std::atomic<size_t> _s_failed( 0 );
+static std::string _s_error;
+
+static magical::Stat _stat_workers_us( "lua.workers.run_us", magical::Stat::Gauge );
+static magical::Stat _stat_workers_calls( "lua.workers.calls", magical::Stat::Counter );
+
+static void setError( const char* error )
+{
+	std::lock_guard<std::mutex> lock( _s_mutex );
+	if( _s_error.empty() )
+		_s_error = error ? error : "unknown error";
+}
+
+/*
+栈上fn是批处理函数，shared是解码后的共享数据，
+领取块直到没有剩余，每个块的结果只由当前线程写入
+*/
+void LuaWorkers::runChunks( lua_State* L, LuaBatch* batch, int fn, int shared )
+{
+	size_t count = batch->size();
+	size_t chunk;
+	while( ( chunk = _s_next_chunk.fetch_add( 1 ) ) < _s_chunk_count )
+	{
+		LuaMessage& results = batch->_chunk_results[ chunk ];
+		size_t begin = chunk * batch->_chunk_size;
+		size_t end = begin + batch->_chunk_size < count ? begin + batch->_chunk_size : count;
+
+		for( size_t i = begin; i < end; ++i )
+		{
+			size_t input_end = i + 1 < count ? batch->_input_offsets[ i + 1 ] : batch->_inputs.size();
+			LuaMessageReader input( batch->_inputs.data() + batch->_input_offsets[i], input_end - batch->_input_offsets[i] );
+
+			size_t offset = results.size();
+			lua_pushvalue( L, fn );
+			input.push( L );
+			lua_pushvalue( L, shared );
+			if( lua_pcall( L, 2, 1, 0 ) != 0 )
+			{
+				setError( lua_tostring( L, -1 ) );
+				++ _s_failed;
+			}
+			else if( results.write( L, -1 ) )
+			{
+				batch->_result_ranges[i] = std::pair<size_t, size_t>( offset, results.size() );
+			}
+			else
+			{
+				setError( "result of LuaBatch can not be serialized" );
+				++ _s_failed;
+			}
+			lua_settop( L, shared );
+		}
+	}
+}
+
+void LuaWorkers::workerLoop( std::string lfile )
+{
+	magical::Profiler::setThreadName( "Lua::worker" );
+
+	LuaState* state = new LuaState();
+	Lua::openWorkerBindings( state );
+
+	// 与主状态相同经过资源包和字节码缓存，各线程加载同一文件时只编译一次
+	lua_State* L = state->cPtr();
+	bool ready = state->runScriptFile( lfile.c_str() ) == LuaCode::OK;
+	if( !ready )
+		setError( magical::System::format( "load lua workers script failed! file(%s).", lfile.c_str() ).c_str() );
+	lua_settop( L, 0 );
+
+	std::unique_lock<std::mutex> lock( _s_mutex );
+	++ _s_ready;
+	if( !ready )
+		++ _s_start_failed;
+	_s_done_condition.notify_all();
+
+	uint32_t batch_id = _s_batch_id;
+	while( ready )
+	{
+		_s_start_condition.wait( lock, [&]{ return _s_stopping || _s_batch_id != batch_id; } );
+		if( _s_stopping )
+			break;
+
+		batch_id = _s_batch_id;
+		LuaBatch* batch = _s_batch;
+		lock.unlock();
+		{
+			MAGICAL_PROFILE_SCOPE( "LuaWorkers::runChunks" );
+			lua_getglobal( L, batch->_function.c_str() );
+			if( batch->_shared.empty() )
+				lua_pushnil( L );
+			else
+				LuaMessageReader( batch->_shared ).push( L );
+			runChunks( L, batch, 1, 2 );
+			lua_settop( L, 0 );
+		}
+		lock.lock();
+
+		if( -- _s_running == 0 )
+			_s_done_condition.notify_all();
+	}
+	lock.unlock();
+
+	// 线程退出前归还当前线程缓存的引用记录
+	state->release();
+	LuaReference::purge();
+}
+
+LuaBatch::LuaBatch( const char* function )
+: _function( function )
+{
+	MAGICAL_ASSERT( function, "function should not be nullptr" );
+}
+
+void LuaBatch::clear( void )
+{
+	_inputs.clear();
+	_shared.clear();
+	_input_offsets.clear();
+	for( auto& results : _chunk_results )
+		results.clear();
+	_result_ranges.clear();
+	_failed = 0;
+}
+
+void LuaBatch::add( const LuaMessage& input )
+{
+	MAGICAL_ASSERT( !input.empty(), "input should not be empty" );
+
+	_input_offsets.push_back( _inputs.size() );
+	_inputs.append( input );
+}
+
+bool LuaBatch::hasResult( size_t i ) const
+{
+	MAGICAL_ASSERT( i < size(), "index out of range" );
+	return i < _result_ranges.size() && _result_ranges[i].second > _result_ranges[i].first;
+}
+
+LuaMessageReader LuaBatch::getResult( size_t i ) const
+{
+	if( !hasResult( i ) )
+		return LuaMessageReader( nullptr, 0 );
+
+	const LuaMessage& results = _chunk_results[ i / _chunk_size ];
+	const std::pair<size_t, size_t>& range = _result_ranges[i];
+	return LuaMessageReader( results.data() + range.first, range.second - range.first );
+}
+
+bool LuaWorkers::start( size_t count, const char* lfile )
+{
+	MAGICAL_ASSERT( count > 0 && lfile, "invalid worker count or file" );
+	MAGICAL_ASSERT( _s_workers.empty(), "LuaWorkers already started" );
+
+	{
+		std::lock_guard<std::mutex> lock( _s_mutex );
+		_s_stopping = false;
+		_s_ready = 0;
+		_s_start_failed = 0;
+		_s_error.clear();
+	}
+
+	for( size_t i = 0; i < count; ++i )
+	{
+		_s_workers.push_back( std::thread( workerLoop, std::string( lfile ) ) );
+	}
+
+	std::unique_lock<std::mutex> lock( _s_mutex );
+	_s_done_condition.wait( lock, [&]{ return _s_ready == count; } );
+	if( _s_start_failed == 0 )
+		return true;
+
+	MAGICAL_SET_LAST_ERROR( _s_error.c_str() );
+	MAGICAL_LOG_LAST_ERROR();
+	lock.unlock();
+
+	stop();
+	return false;
+}
+
+void LuaWorkers::stop( void )
+{
+	{
+		std::lock_guard<std::mutex> lock( _s_mutex );
+		_s_stopping = true;
+	}
+	_s_start_condition.notify_all();
+
+	for( auto& worker : _s_workers )
+	{
+		worker.join();
+	}
+	_s_workers.clear();
+}
+
+size_t LuaWorkers::getWorkerCount( void )
+{
+	return _s_workers.size();
+}
+
+size_t LuaWorkers::run( LuaBatch& batch )
+{
+	MAGICAL_ASSERT( !_s_workers.empty(), "LuaWorkers::start() should be called first" );
+
+	size_t count = batch.size();
+	if( count == 0 )
+		return 0;
+
+	MAGICAL_PROFILE_SCOPE( "LuaWorkers::run" );
+	int64_t begin = magical::Time::currentMicroseconds();
+
+	// 每个线程平均领取约4块，耗时不均时由先完成的线程分担
+	size_t chunk_size = ( count + _s_workers.size() * 4 - 1 ) / ( _s_workers.size() * 4 );
+	batch._chunk_size = chunk_size > MinChunkSize ? chunk_size : MinChunkSize;
+
+	size_t chunk_count = ( count + batch._chunk_size - 1 ) / batch._chunk_size;
+	if( batch._chunk_results.size() < chunk_count )
+		batch._chunk_results.resize( chunk_count );
+	for( auto& results : batch._chunk_results )
+		results.clear();
+	batch._result_ranges.assign( count, std::pair<size_t, size_t>( 0, 0 ) );
+
+	std::unique_lock<std::mutex> lock( _s_mutex );
+	_s_batch = &batch;
+	_s_chunk_count = chunk_count;
+	_s_running = _s_workers.size();
+	_s_next_chunk.store( 0 );
+	_s_failed.store( 0 );
+	_s_error.clear();
+	++ _s_batch_id;
+	_s_start_condition.notify_all();
+
+	_s_done_condition.wait( lock, []{ return _s_running == 0; } );
+	_s_batch = nullptr;
+
+	batch._failed = _s_failed.load();
+	if( batch._failed > 0 )
+	{
+		MAGICAL_SET_LAST_ERROR( _s_error.c_str() );
+		MAGICAL_LOG_LAST_ERROR();
+	}
+
+	_stat_workers_us.set( magical::Time::currentMicroseconds() - begin );
+	_stat_workers_calls.add( (int64_t) count );
+	return count - batch._failed;
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __LUA_WORKERS_H__
+#define __LUA_WORKERS_H__
+
+#include "magical-macros.h"
+#include "Common.h"
+#include <vector>
+
+#include "LuaMessage.h"
+
+/*
+一批互不依赖的脚本调用，如每个实体一次的AI更新
+
+每条输入是一条LuaMessage，与所有调用共享的只读数据一起作为参数传给工作线程中的全局函数：
+function( input, shared )，返回值序列化后按输入的顺序保存，由主线程读取合并
+*/
+class LuaBatch
+{
+public:
+	explicit LuaBatch( const char* function );
+
+public:
+	// 清空输入和结果，保留已分配的内存，每帧可以复用同一个LuaBatch
+	void clear( void );
+	void add( const LuaMessage& input );
+	// 每个线程在一批开始时解码一次，不为每条输入复制
+	inline LuaMessage& shared( void ) { return _shared; }
+	inline size_t size( void ) const { return _input_offsets.size(); }
+
+public:
+	// 执行失败或返回值不能序列化时没有结果
+	bool hasResult( size_t i ) const;
+	LuaMessageReader getResult( size_t i ) const;
+	inline size_t getFailedCount( void ) const { return _failed; }
+
+private:
+	friend class LuaWorkers;
+
+	std::string _function;
+	LuaMessage _inputs;
+	LuaMessage _shared;
+	std::vector<size_t> _input_offsets;
+	// 每块的结果由一个线程写入，_result_ranges按输入的下标记录所在块内的起止位置
+	std::vector<LuaMessage> _chunk_results;
+	std::vector<std::pair<size_t, size_t>> _result_ranges;
+	size_t _chunk_size = 1;
+	size_t _failed = 0;
+};
+
+/*
+在工作线程上运行的独立LuaState，用于并行执行LuaBatch
+
+每个线程拥有自己的LuaState，只加载Lua::openWorkerBindings中的绑定，状态之间不共享任何Lua对象，
+数据只以LuaMessage的形式传入传出；run()把一批输入分块，各线程领取未完成的块直到全部完成，
+调用线程阻塞等待，结果在run()返回后由主线程读取
+工作线程中的脚本只能使用数学类型等不依赖引擎状态的绑定，Director、Assets等主线程对象不会注册到工作线程的状态中
+*/
+class LuaWorkers
+{
+public:
+	// 每块至少包含的调用数，避免过多的领取开销
+	static const size_t MinChunkSize = 16;
+
+public:
+	// 启动count个线程，每个线程的状态通过LuaState::runScriptFile执行lfile定义批处理调用的全局函数，任何一个失败时返回false
+	static bool start( size_t count, const char* lfile );
+	static void stop( void );
+	static size_t getWorkerCount( void );
+
+public:
+	// 阻塞到整批执行完毕，返回成功的条数；失败的调用只记录第一条错误信息
+	static size_t run( LuaBatch& batch );
+
+private:
+	static void workerLoop( std::string lfile );
+	static void runChunks( lua_State* L, LuaBatch* batch, int fn, int shared );
+};
+
+#endif //__LUA_WORKERS_H__
\ No newline at end of file
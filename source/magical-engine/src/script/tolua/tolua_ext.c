@@ -26,18 +26,19 @@ SOFTWARE.
 #include <stdlib.h>
 #include <string.h>
 
-static LuaTableHandler _s_growing_table_handler = 0;
-static LuaFunctionHandler _s_growing_function_handler = 0;
+/*
+handler是注册表中的槽位，由luaL_ref分配，释放后放回注册表的空闲链表中复用，
+取值时只需一次整数索引，不再经过按字符串查找的映射表
+*/
+static int registry_ref( lua_State* L, int lo )
+{
+	lua_pushvalue( L, lo );
+	return luaL_ref( L, LUA_REGISTRYINDEX );
+}
 
 TOLUA_API void luaopen_tolua_ext( lua_State* L )
 {
-	lua_pushstring( L, TOLUA_MAPPING_FUNCTION_KEY );
-	lua_createtable( L, 255, 0 );
-	lua_rawset( L, LUA_REGISTRYINDEX );
 
-	lua_pushstring( L, TOLUA_MAPPING_TABLE_KEY );
-	lua_createtable( L, 255, 0 );
-	lua_rawset( L, LUA_REGISTRYINDEX );
 }
 
 TOLUA_API int tolua_ext_istable( lua_State* L, int lo, const char* type, int def, tolua_Error* err )
@@ -56,16 +57,7 @@ TOLUA_API int tolua_ext_totable( lua_State* L, int lo, int def )
 	if( !lua_istable( L, lo ) )
 		return 0;
 
-	++ _s_growing_table_handler;
-
-	lua_pushstring( L, TOLUA_MAPPING_TABLE_KEY );
-	lua_rawget( L, LUA_REGISTRYINDEX );
-	lua_pushinteger( L, _s_growing_table_handler );
-	lua_pushvalue( L, lo );
-	lua_rawset( L, -3 );
-	lua_pop( L, 1 );
-
-	return _s_growing_table_handler;
+	return registry_ref( L, lo );
 }
 
 TOLUA_API int tolua_ext_isfunction( lua_State* L, int lo, const char* type, int def, tolua_Error* err )
@@ -83,53 +75,26 @@ TOLUA_API int tolua_ext_tofunction( lua_State* L, int lo, int def )
 {
 	if( !lua_isfunction( L, lo ) )
 		return 0;
-    
-	++ _s_growing_function_handler;
-    
-	lua_pushstring( L, TOLUA_MAPPING_FUNCTION_KEY );
-	lua_rawget( L, LUA_REGISTRYINDEX );
-	lua_pushinteger( L, _s_growing_function_handler );
-	lua_pushvalue( L, lo );
-	lua_rawset( L, -3 );
-	lua_pop( L, 1 );
 
-	return _s_growing_function_handler;
+	return registry_ref( L, lo );
 }
 
 TOLUA_API void tolua_ext_get_table_by_handler( lua_State* L, LuaTableHandler handler )
 {
-	lua_pushstring( L, TOLUA_MAPPING_TABLE_KEY );
-	lua_rawget( L, LUA_REGISTRYINDEX );
-	lua_pushinteger( L, handler );
-	lua_rawget( L, -2 );
-	lua_remove( L, -2 );
+	lua_rawgeti( L, LUA_REGISTRYINDEX, handler );
 }
 
 TOLUA_API void tolua_ext_remove_table_by_handler( lua_State* L, LuaTableHandler handler )
 {
-	lua_pushstring( L, TOLUA_MAPPING_TABLE_KEY );
-	lua_rawget( L, LUA_REGISTRYINDEX );
-	lua_pushinteger( L, handler );
-	lua_pushnil( L );
-	lua_rawset( L, -3 );
-	lua_pop( L, 1 );
+	luaL_unref( L, LUA_REGISTRYINDEX, handler );
 }
 
 TOLUA_API void tolua_ext_get_function_by_handler( lua_State* L, LuaFunctionHandler handler )
 {
-	lua_pushstring( L, TOLUA_MAPPING_FUNCTION_KEY );
-	lua_rawget( L, LUA_REGISTRYINDEX );
-	lua_pushinteger( L, handler );
-	lua_rawget( L, -2 );
-	lua_remove( L, -2 );
+	lua_rawgeti( L, LUA_REGISTRYINDEX, handler );
 }
 
 TOLUA_API void tolua_ext_remove_function_by_handler( lua_State* L, LuaFunctionHandler handler )
 {
-	lua_pushstring( L, TOLUA_MAPPING_FUNCTION_KEY );
-	lua_rawget( L, LUA_REGISTRYINDEX );
-	lua_pushinteger( L, handler );
-	lua_pushnil( L );
-	lua_rawset( L, -3 );
-	lua_pop( L, 1 );
+	luaL_unref( L, LUA_REGISTRYINDEX, handler );
 }
@@ -30,9 +30,6 @@ SOFTWARE.
 extern "C" {
 #endif
 
-#define TOLUA_MAPPING_TABLE_KEY "MAPPINGTABLE"
-#define TOLUA_MAPPING_FUNCTION_KEY "MAPPINGFUNCTION"
-
 typedef int LuaTableHandler;
 typedef int LuaFunctionHandler;
 
@@ -126,7 +126,7 @@ public:
 
 	bool empty( void ) const
 	{
-		return m_size == 0
+		return m_size == 0;
 	}
 
 protected:
@@ -22,10 +22,15 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 *******************************************************************************/
 #include "Data.h"
+#include "Stats.h"
 #include <stdlib.h>
+#include <string.h>
 
 NAMESPACE_MAGICAL
 
+static Stat _stat_allocations( "data.allocations", Stat::Counter );
+static Stat _stat_allocated_bytes( "data.allocated_bytes", Stat::Counter );
+
 Data::Data( void )
 {
 	
@@ -33,7 +38,7 @@ Data::Data( void )
 
 Data::~Data( void )
 {
-	SAFE_FREE( m_data );
+	releaseData();
 }
 
 Ptr<Data> Data::create( void )
@@ -59,23 +64,41 @@ Ptr<Data> Data::create( char* data, size_t size )
 	return Ptr<Data>( Ptrctor<Data>( ret ) );
 }
 
+Ptr<Data> Data::create( char* data, size_t size, Deallocator deallocator )
+{
+	Data* ret = new Data();
+	MAGICAL_ASSERT( ret, "new Data() failed" );
+	ret->assign( data, size, deallocator );
+	return Ptr<Data>( Ptrctor<Data>( ret ) );
+}
+
 void Data::assign( char* data, size_t size )
+{
+	assign( data, size, nullptr );
+}
+
+void Data::assign( char* data, size_t size, Deallocator deallocator )
 {
 	MAGICAL_ASSERT( data && size > 0, "data should not be nullptr and size should > 0" );
 
-	SAFE_FREE( m_data );
+	releaseData();
 	m_data = data;
 	m_size = size;
+	m_deallocate_size = size;
+	m_deallocator = deallocator;
 }
 
 void Data::malloc( size_t size )
 {
 	MAGICAL_ASSERT( size > 0, "size should > 0" );
 
-	SAFE_FREE( m_data );
+	releaseData();
 	m_data = (char*) ::malloc( size );
 	MAGICAL_ASSERT( m_data, "(char*) ::malloc( size );" );
 	m_size = size;
+
+	_stat_allocations.add();
+	_stat_allocated_bytes.add( size );
 }
 
 void Data::realloc( size_t size )
@@ -83,20 +106,39 @@ void Data::realloc( size_t size )
 	MAGICAL_ASSERT( size > 0, "size should > 0" );
 	MAGICAL_ASSERT( m_data, "Invalid!" );
 
-	if( size > m_size )
+	if( m_deallocator && size > m_size )
 	{
+		// 外部分配的内存不能直接realloc，先复制到malloc的内存中
+		char* data = (char*) ::malloc( size );
+		MAGICAL_ASSERT( data, "(char*) ::malloc( size );" );
+		memcpy( data, m_data, m_size );
+		releaseData();
+		m_data = data;
+		m_size = size;
+
+		_stat_allocations.add();
+		_stat_allocated_bytes.add( size );
+	}
+	else if( size > m_size )
+	{
+		_stat_allocations.add();
+		_stat_allocated_bytes.add( size - m_size );
+
 		m_data = (char*) ::realloc( m_data, size );
 		MAGICAL_ASSERT( m_data, "::realloc( m_data, size )" );
+		m_size = size;
 	}
 	else
 	{
+		// 只收缩可见的大小，外部分配的内存释放时按m_deallocate_size回收
 		m_size = size;
 	}
 }
 
 void Data::free( void )
 {
-	SAFE_FREE_NULL( m_data );
+	releaseData();
+	m_data = nullptr;
 }
 
 bool Data::empty( void ) const
@@ -114,4 +156,19 @@ char* Data::cPtr( void ) const
 	return m_data;
 }
 
+void Data::releaseData( void )
+{
+	if( m_data && m_deallocator )
+	{
+		m_deallocator( m_data, m_deallocate_size );
+		m_deallocator = nullptr;
+		m_deallocate_size = 0;
+		m_data = nullptr;
+	}
+	else
+	{
+		SAFE_FREE( m_data );
+	}
+}
+
 NAMESPACE_END
\ No newline at end of file
@@ -32,15 +32,23 @@ NAMESPACE_MAGICAL
  
 class Data : public Reference
 {
+public:
+	/*
+	非malloc分配的内存（如文件映射）由创建者提供的释放函数回收
+	*/
+	typedef void ( *Deallocator )( char* data, size_t size );
+
 public:
 	Data( void );
 	virtual ~Data( void );
 	static Ptr<Data> create( void );
 	static Ptr<Data> create( size_t size );
 	static Ptr<Data> create( char* data, size_t size );
+	static Ptr<Data> create( char* data, size_t size, Deallocator deallocator );
 
 public:
 	void assign( char* data, size_t size );
+	void assign( char* data, size_t size, Deallocator deallocator );
 	void malloc( size_t size );
 	void realloc( size_t size );
 	void free( void );
@@ -48,9 +56,16 @@ public:
 	size_t size( void ) const;
 	char* cPtr( void ) const;
 
+private:
+	// 不能命名为release，会隐藏Reference::release
+	void releaseData( void );
+
 private:
 	char* m_data = nullptr;
 	size_t m_size = 0;
+	// 外部分配的内存的原始大小，收缩m_size后释放时仍按它回收
+	size_t m_deallocate_size = 0;
+	Deallocator m_deallocator = nullptr;
 };
 
 NAMESPACE_END
@@ -0,0 +1,249 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "LZ4.h"
+#include <string.h>
+
+NAMESPACE_MAGICAL
+
+enum : size_t
+{
+	MinMatch = 4,
+	LastLiterals = 5,
+	MatchFindLimit = 12,
+	MaxOffset = 65535,
+	HashLog = 12,
+};
+
+static inline uint32_t read32( const uint8_t* p )
+{
+	uint32_t v;
+	memcpy( &v, p, sizeof( v ) );
+	return v;
+}
+
+static inline uint32_t hash32( uint32_t v )
+{
+	return ( v * 2654435761U ) >> ( 32 - HashLog );
+}
+
+/*
+写入长度的扩展字节，长度已减去token中的15
+*/
+static inline bool writeLength( uint8_t*& op, const uint8_t* end, size_t length )
+{
+	while( length >= 255 )
+	{
+		if( op >= end )
+			return false;
+		*op++ = 255;
+		length -= 255;
+	}
+
+	if( op >= end )
+		return false;
+	*op++ = (uint8_t) length;
+	return true;
+}
+
+static inline bool readLength( size_t& length, const uint8_t*& ip, const uint8_t* end )
+{
+	uint8_t b;
+	do
+	{
+		if( ip >= end )
+			return false;
+		b = *ip++;
+		length += b;
+	} while( b == 255 );
+	return true;
+}
+
+static bool writeSequence( uint8_t*& op, const uint8_t* end, const uint8_t* literals, size_t literal_length, size_t offset, size_t match_length )
+{
+	if( op >= end )
+		return false;
+
+	uint8_t* token = op++;
+	*token = (uint8_t) ( ( literal_length >= 15 ? 15 : literal_length ) << 4 );
+	if( literal_length >= 15 && !writeLength( op, end, literal_length - 15 ) )
+		return false;
+
+	if( (size_t) ( end - op ) < literal_length )
+		return false;
+	if( literal_length > 0 )
+		memcpy( op, literals, literal_length );
+	op += literal_length;
+
+	// 最后一个序列只有字面量
+	if( match_length == 0 )
+		return true;
+
+	if( end - op < 2 )
+		return false;
+	*op++ = (uint8_t) ( offset & 0xff );
+	*op++ = (uint8_t) ( offset >> 8 );
+
+	size_t length = match_length - MinMatch;
+	*token |= (uint8_t) ( length >= 15 ? 15 : length );
+	return length < 15 || writeLength( op, end, length - 15 );
+}
+
+size_t LZ4::compressBound( size_t size )
+{
+	return size + size / 255 + 16;
+}
+
+/*
+packed_size字节的压缩数据解压后的最大可能大小，每个长度扩展字节最多表示255个字节
+*/
+uint64_t LZ4::decompressBound( uint64_t packed_size )
+{
+	return packed_size * 255 + 16;
+}
+
+/*
+返回压缩后的大小，dst空间不足时返回0
+*/
+size_t LZ4::compress( char* dst, size_t capacity, const char* src, size_t size )
+{
+	const uint8_t* base = (const uint8_t*) src;
+	const uint8_t* anchor = base;
+	uint8_t* op = (uint8_t*) dst;
+	const uint8_t* end = op + capacity;
+
+	if( size > MatchFindLimit )
+	{
+		uint32_t table[ 1 << HashLog ];
+		memset( table, 0xff, sizeof( table ) );
+
+		const uint8_t* ip = base;
+		const uint8_t* match_limit = base + size - MatchFindLimit;
+		const uint8_t* match_end = base + size - LastLiterals;
+
+		while( ip < match_limit )
+		{
+			uint32_t seq = read32( ip );
+			uint32_t h = hash32( seq );
+			uint32_t ref = table[h];
+			table[h] = (uint32_t) ( ip - base );
+
+			if( ref == 0xffffffff || (size_t) ( ip - base ) - ref > MaxOffset || read32( base + ref ) != seq )
+			{
+				++ip;
+				continue;
+			}
+
+			const uint8_t* match = base + ref;
+			while( ip > anchor && match > base && ip[-1] == match[-1] )
+			{
+				--ip;
+				--match;
+			}
+
+			const uint8_t* p = ip + MinMatch;
+			const uint8_t* m = match + MinMatch;
+			while( p < match_end && *p == *m )
+			{
+				++p;
+				++m;
+			}
+
+			if( !writeSequence( op, end, anchor, ip - anchor, ip - match, p - ip ) )
+				return 0;
+
+			ip = p;
+			anchor = p;
+			if( ip - 2 >= base && ip < match_limit )
+				table[ hash32( read32( ip - 2 ) ) ] = (uint32_t) ( ip - 2 - base );
+		}
+	}
+
+	if( !writeSequence( op, end, anchor, base + size - anchor, 0, 0 ) )
+		return 0;
+
+	return op - (uint8_t*) dst;
+}
+
+/*
+size为解压后的准确大小，数据损坏或大小不符时返回false
+*/
+bool LZ4::decompress( char* dst, size_t size, const char* src, size_t packed_size )
+{
+	const uint8_t* ip = (const uint8_t*) src;
+	const uint8_t* ip_end = ip + packed_size;
+	uint8_t* op = (uint8_t*) dst;
+	uint8_t* op_end = op + size;
+
+	while( ip < ip_end )
+	{
+		uint8_t token = *ip++;
+
+		size_t literal_length = token >> 4;
+		if( literal_length == 15 && !readLength( literal_length, ip, ip_end ) )
+			return false;
+
+		if( (size_t) ( ip_end - ip ) < literal_length || (size_t) ( op_end - op ) < literal_length )
+			return false;
+		memcpy( op, ip, literal_length );
+		ip += literal_length;
+		op += literal_length;
+
+		if( ip >= ip_end )
+			break;
+
+		if( ip_end - ip < 2 )
+			return false;
+		size_t offset = ip[0] | ( ip[1] << 8 );
+		ip += 2;
+		if( offset == 0 || offset > (size_t) ( op - (uint8_t*) dst ) )
+			return false;
+
+		size_t match_length = token & 15;
+		if( match_length == 15 && !readLength( match_length, ip, ip_end ) )
+			return false;
+		match_length += MinMatch;
+
+		if( (size_t) ( op_end - op ) < match_length )
+			return false;
+
+		// 偏移可能小于匹配长度（重复模式），需要逐字节复制
+		const uint8_t* match = op - offset;
+		if( offset >= match_length )
+		{
+			memcpy( op, match, match_length );
+			op += match_length;
+		}
+		else
+		{
+			for( size_t i = 0; i < match_length; ++i )
+			{
+				*op++ = *match++;
+			}
+		}
+	}
+
+	return op == op_end;
+}
+
+NAMESPACE_END
\ No newline at end of file
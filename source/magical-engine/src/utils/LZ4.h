@@ -0,0 +1,47 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __LZ4_H__
+#define __LZ4_H__
+
+#include "magical-macros.h"
+#include "Common.h"
+
+NAMESPACE_MAGICAL
+
+/*
+LZ4块格式的压缩与解压，不含帧头与校验，
+压缩使用单次贪心匹配，速度优先；解压对输入做边界检查，损坏的数据返回失败而不会越界
+*/
+class LZ4
+{
+public:
+	static size_t compressBound( size_t size );
+	static uint64_t decompressBound( uint64_t packed_size );
+	static size_t compress( char* dst, size_t capacity, const char* src, size_t size );
+	static bool decompress( char* dst, size_t size, const char* src, size_t packed_size );
+};
+
+NAMESPACE_END
+
+#endif //__LZ4_H__
\ No newline at end of file
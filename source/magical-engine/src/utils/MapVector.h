@@ -37,8 +37,8 @@ template< class TyKey, class TyValue >
 class MapVector
 {
 public:
-	typedef typename TyKey key_type;
-	typedef typename TyValue mapped_type;
+	typedef TyKey key_type;
+	typedef TyValue mapped_type;
 
 	typedef typename Vector< Pair<TyKey, TyValue> >::value_type value_type;
 	typedef typename Vector< Pair<TyKey, TyValue> >::size_type size_type;
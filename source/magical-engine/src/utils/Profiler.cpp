@@ -0,0 +1,417 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "Profiler.h"
+#include "Log.h"
+#include "Vector.h"
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <thread>
+
+NAMESPACE_MAGICAL
+
+struct ProfileEvent
+{
+	const char* name;
+	int64_t begin;
+	int64_t end;
+	uint32_t tid;
+};
+
+/*
+每个线程第一次记录时创建自己的缓冲，记录时不加锁：
+线程只向active指向的一半追加，busy标记追加正在进行，
+收集时主线程切换active并等待busy清除，之后旧的一半只有主线程访问
+
+线程局部的指针可能在任意时刻被使用，缓冲创建后不再释放，delc只清空记录并释放其内存，
+下一代中同一个线程重新登记原来的缓冲
+*/
+struct ProfileThreadBuffer
+{
+	Vector<ProfileEvent> events[2];
+	std::atomic<int> active;
+	std::atomic<bool> busy;
+	const char* name;
+	uint32_t tid;
+	ProfileThreadBuffer* next;
+
+	ProfileThreadBuffer( void ) : active( 0 ), busy( false ), name( nullptr ), tid( 0 ), next( nullptr ) {}
+};
+
+struct ProfileFrame
+{
+	size_t index;
+	int64_t begin;
+	int64_t end;
+	Vector<ProfileEvent> events;
+};
+
+static std::atomic<bool> _enabled( false );
+static std::atomic<uint32_t> _generation( 0 );
+static std::chrono::steady_clock::time_point _origin = std::chrono::steady_clock::now();
+
+// _buffers为当前一代登记的缓冲，tid即其中的下标；所有创建过的缓冲串在_all_buffers上
+static std::mutex _buffers_mutex;
+static Vector<ProfileThreadBuffer*> _buffers;
+static ProfileThreadBuffer* _all_buffers = nullptr;
+
+static Vector<ProfileFrame> _frames;
+static size_t _frame_capacity = Profiler::DefaultFrameCapacity;
+static size_t _frame_count = 0;
+static size_t _last_dump_frame = 0;
+static int64_t _frame_begin = -1;
+static double _last_frame_time = 0.0;
+static double _spike_threshold = 50.0;
+
+// 登记属于某一代，init和delc之后下次记录时重新登记
+static MAGICAL_THREAD_LOCAL ProfileThreadBuffer* _thread_buffer = nullptr;
+static MAGICAL_THREAD_LOCAL uint32_t _thread_generation = 0;
+
+static ProfileThreadBuffer* threadBuffer( void )
+{
+	if( _thread_buffer != nullptr && _thread_generation == _generation.load( std::memory_order_acquire ) )
+		return _thread_buffer;
+
+	// 代数只在持有锁时改变，同一代中每个线程只登记一次
+	std::lock_guard<std::mutex> lock( _buffers_mutex );
+	ProfileThreadBuffer* buffer = _thread_buffer;
+	if( buffer == nullptr )
+	{
+		buffer = new ProfileThreadBuffer();
+		buffer->next = _all_buffers;
+		_all_buffers = buffer;
+	}
+
+	buffer->name = nullptr;
+	buffer->tid = (uint32_t) _buffers.size();
+	_buffers.push_back( buffer );
+
+	_thread_buffer = buffer;
+	_thread_generation = _generation.load( std::memory_order_relaxed );
+	return buffer;
+}
+
+/*
+切换线程写入的一半，等待已经开始的追加结束，返回旧的一半，调用时持有_buffers_mutex
+*/
+static Vector<ProfileEvent>& swapEvents( ProfileThreadBuffer* buffer )
+{
+	int index = buffer->active.load( std::memory_order_relaxed );
+	buffer->active.store( index ^ 1 );
+	while( buffer->busy.load() )
+		std::this_thread::yield();
+	return buffer->events[ index ];
+}
+
+/*
+清空两半的记录，delc时同时释放内存
+*/
+static void clearEvents( ProfileThreadBuffer* buffer, bool release )
+{
+	for( int i = 0; i < 2; ++i )
+	{
+		Vector<ProfileEvent>& events = swapEvents( buffer );
+		if( release )
+			Vector<ProfileEvent>().swap( events );
+		else
+			events.clear();
+	}
+}
+
+static void clearFrames( void )
+{
+	_frames.clear();
+	_frame_count = 0;
+	_last_dump_frame = 0;
+	_frame_begin = -1;
+}
+
+void Profiler::init( void )
+{
+	{
+		// 没有delc时再次init，已登记的线程在新的一代中重新登记
+		std::lock_guard<std::mutex> lock( _buffers_mutex );
+		_generation.fetch_add( 1 );
+		for( auto buffer : _buffers )
+			clearEvents( buffer, false );
+		_buffers.clear();
+	}
+	setThreadName( "main" );
+}
+
+/*
+其他线程可能仍在记录：递增代数之后才开始追加的记录被丢弃，已经开始的在clearEvents中等待结束
+*/
+void Profiler::delc( void )
+{
+	_enabled.store( false );
+
+	std::lock_guard<std::mutex> lock( _buffers_mutex );
+	_generation.fetch_add( 1 );
+	for( auto buffer : _buffers )
+		clearEvents( buffer, true );
+
+	_buffers.clear();
+	clearFrames();
+}
+
+void Profiler::setEnabled( bool enabled )
+{
+	if( enabled && !_enabled.load() )
+	{
+		std::lock_guard<std::mutex> lock( _buffers_mutex );
+		for( auto buffer : _buffers )
+			clearEvents( buffer, false );
+		clearFrames();
+	}
+
+	_enabled.store( enabled );
+}
+
+bool Profiler::isEnabled( void )
+{
+	return _enabled.load( std::memory_order_relaxed );
+}
+
+void Profiler::setFrameCapacity( size_t capacity )
+{
+	MAGICAL_ASSERT( capacity > 0, "Invalid!" );
+
+	_frame_capacity = capacity;
+	clearFrames();
+}
+
+size_t Profiler::getFrameCapacity( void )
+{
+	return _frame_capacity;
+}
+
+void Profiler::setSpikeThreshold( double ms )
+{
+	_spike_threshold = ms;
+}
+
+double Profiler::getSpikeThreshold( void )
+{
+	return _spike_threshold;
+}
+
+void Profiler::setThreadName( const char* name )
+{
+	ProfileThreadBuffer* buffer = threadBuffer();
+	std::lock_guard<std::mutex> lock( _buffers_mutex );
+	buffer->name = name;
+}
+
+int64_t Profiler::now( void )
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - _origin ).count();
+}
+
+/*
+先标记busy再读取active和代数（都是顺序一致的原子操作），与swapEvents先写active再读busy相对：
+主线程看到busy为false时，本线程之后的追加一定写入新的一半，或者因为代数已变而放弃
+*/
+void Profiler::record( const char* name, int64_t begin, int64_t end )
+{
+	ProfileThreadBuffer* buffer = threadBuffer();
+	ProfileEvent evt = { name, begin, end, buffer->tid };
+
+	buffer->busy.store( true );
+	if( _generation.load() == _thread_generation )
+		buffer->events[ buffer->active.load() ].push_back( evt );
+	buffer->busy.store( false, std::memory_order_release );
+}
+
+/*
+把各线程缓冲中的记录移入环形队列中最旧的一帧，帧耗时超过阈值时导出整个队列，
+导出后至少经过一轮队列长度的帧才会再次导出，避免连续卡顿时反复写文件
+*/
+void Profiler::newFrame( void )
+{
+	if( !_enabled.load() )
+	{
+		_frame_begin = -1;
+		return;
+	}
+
+	int64_t time = now();
+	if( _frame_begin < 0 )
+	{
+		_frame_begin = time;
+		return;
+	}
+
+	if( _frames.size() < _frame_capacity )
+		_frames.resize( _frames.size() + 1 );
+
+	ProfileFrame& frame = _frames[ _frame_count % _frame_capacity ];
+	frame.index = _frame_count;
+	frame.begin = _frame_begin;
+	frame.end = time;
+	frame.events.clear();
+	{
+		std::lock_guard<std::mutex> lock( _buffers_mutex );
+		for( auto buffer : _buffers )
+		{
+			Vector<ProfileEvent>& events = swapEvents( buffer );
+			frame.events.insert( frame.events.end(), events.begin(), events.end() );
+			events.clear();
+		}
+	}
+
+	++ _frame_count;
+	_frame_begin = time;
+	_last_frame_time = ( frame.end - frame.begin ) / 1000000.0;
+
+	if( _spike_threshold > 0.0 && _last_frame_time > _spike_threshold &&
+		( _last_dump_frame == 0 || _frame_count - _last_dump_frame >= _frame_capacity ) )
+	{
+		_last_dump_frame = _frame_count;
+
+		string file = System::format( "magical-profile-%u.json", (unsigned int) frame.index );
+		if( dump( file.c_str() ) )
+		{
+			MAGICAL_LOGW( System::format( "frame %u took %.2fms, profile dumped to %s", (unsigned int) frame.index, _last_frame_time, file.c_str() ).c_str() );
+		}
+	}
+}
+
+size_t Profiler::getFrameCount( void )
+{
+	return _frame_count;
+}
+
+double Profiler::getLastFrameTime( void )
+{
+	return _last_frame_time;
+}
+
+static void writeJsonString( FILE* file, const char* str )
+{
+	fputc( '"', file );
+	for( const char* c = str ? str : ""; *c; ++c )
+	{
+		if( *c == '"' || *c == '\\' )
+			fputc( '\\', file );
+		if( (unsigned char) *c < 0x20 )
+			continue;
+		fputc( *c, file );
+	}
+	fputc( '"', file );
+}
+
+/*
+每个作用域导出为一个完整事件（ph为X），每帧额外导出一个覆盖整帧的事件，时间单位为微秒
+*/
+bool Profiler::dump( const char* file )
+{
+	MAGICAL_ASSERT( file, "should not be nullptr." );
+
+	FILE* fp = fopen( file, "wb" );
+	if( fp == nullptr )
+	{
+		MAGICAL_SET_LAST_ERROR( System::format( "open file(%s) failed!", file ).c_str() );
+		MAGICAL_LOG_LAST_ERROR();
+		return false;
+	}
+
+	fputs( "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", fp );
+
+	bool first = true;
+	// 帧事件单独显示在所有线程之后
+	uint32_t frame_tid;
+	{
+		std::lock_guard<std::mutex> lock( _buffers_mutex );
+		frame_tid = (uint32_t) _buffers.size();
+		for( auto buffer : _buffers )
+		{
+			fprintf( fp, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":", first ? "" : ",\n", buffer->tid );
+			if( buffer->name )
+				writeJsonString( fp, buffer->name );
+			else
+				fprintf( fp, "\"thread %u\"", buffer->tid );
+			fputs( "}}", fp );
+			first = false;
+		}
+	}
+
+	size_t count = _frames.size();
+	for( size_t i = 0; i < count; ++i )
+	{
+		const ProfileFrame& frame = _frames[ ( _frame_count - count + i ) % _frame_capacity ];
+		fprintf( fp, "%s{\"name\":\"Frame %u\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+			first ? "" : ",\n", (unsigned int) frame.index, frame_tid, frame.begin / 1000.0, ( frame.end - frame.begin ) / 1000.0 );
+		first = false;
+
+		for( auto& evt : frame.events )
+		{
+			fputs( ",\n{\"name\":", fp );
+			writeJsonString( fp, evt.name );
+			fprintf( fp, ",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", evt.tid, evt.begin / 1000.0, ( evt.end - evt.begin ) / 1000.0 );
+		}
+	}
+
+	fprintf( fp, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"frames\"}}\n]}\n", first ? "" : ",\n", frame_tid );
+	fclose( fp );
+	return true;
+}
+
+void Profiler::summarize( Vector<ProfileScopeSummary>& summaries )
+{
+	summaries.clear();
+
+	for( auto& frame : _frames )
+	{
+		for( auto& evt : frame.events )
+		{
+			double ms = ( evt.end - evt.begin ) / 1000000.0;
+
+			auto itr = std::find_if( summaries.begin(), summaries.end(), [&evt]( const ProfileScopeSummary& summary ){
+				return summary.name == evt.name || strcmp( summary.name, evt.name ) == 0;
+			} );
+
+			if( itr == summaries.end() )
+			{
+				ProfileScopeSummary summary = { evt.name, 1, ms, ms };
+				summaries.push_back( summary );
+			}
+			else
+			{
+				itr->count ++;
+				itr->total_ms += ms;
+				itr->max_ms = std::max( itr->max_ms, ms );
+			}
+		}
+	}
+
+	std::sort( summaries.begin(), summaries.end(), []( const ProfileScopeSummary& a, const ProfileScopeSummary& b ){
+		return a.total_ms > b.total_ms;
+	} );
+}
+
+NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,121 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#include "magical-macros.h"
+#include "Common.h"
+#include "Vector.h"
+
+#define MAGICAL_PROFILE_CONCAT_IMPL( a, b ) a##b
+#define MAGICAL_PROFILE_CONCAT( a, b ) MAGICAL_PROFILE_CONCAT_IMPL( a, b )
+
+/*
+作用域性能标记，name必须是字符串常量
+*/
+#ifdef MAGICAL_PROFILER_DISABLED
+#define MAGICAL_PROFILE_SCOPE( name )
+#else
+#define MAGICAL_PROFILE_SCOPE( name ) ::magical::ProfileScope MAGICAL_PROFILE_CONCAT( _magical_profile_scope_, __LINE__ )( name )
+#endif
+
+NAMESPACE_MAGICAL
+
+struct ProfileScopeSummary
+{
+	const char* name;
+	size_t count;
+	double total_ms;
+	double max_ms;
+};
+
+/*
+帧性能分析器
+
+每个线程把作用域的起止时间记录到各自的缓冲中，帧结束时由主线程收集到最近N帧的环形队列，
+可以导出为Chrome trace-event格式（chrome://tracing），帧耗时超过阈值时自动导出
+*/
+class Profiler
+{
+public:
+	enum : size_t { DefaultFrameCapacity = 120 };
+
+public:
+	static void init( void );
+	static void delc( void );
+	static void setEnabled( bool enabled );
+	static bool isEnabled( void );
+	static void setFrameCapacity( size_t capacity );
+	static size_t getFrameCapacity( void );
+	// 单位毫秒，0表示不自动导出
+	static void setSpikeThreshold( double ms );
+	static double getSpikeThreshold( void );
+	// 线程在trace中显示的名称，name必须是字符串常量
+	static void setThreadName( const char* name );
+
+public:
+	/*
+	结束上一帧并开始新的一帧，每帧在主线程调用一次，
+	帧耗时为两次调用的间隔，与Director::getDeltaTime一致
+	*/
+	static void newFrame( void );
+	static size_t getFrameCount( void );
+	static double getLastFrameTime( void );
+	static bool dump( const char* file );
+	// 按作用域名称汇总队列中所有帧的记录，按总耗时从大到小排序
+	static void summarize( Vector<ProfileScopeSummary>& summaries );
+
+public:
+	static int64_t now( void );
+	static void record( const char* name, int64_t begin, int64_t end );
+};
+
+class ProfileScope
+{
+public:
+	explicit ProfileScope( const char* name )
+	: m_name( Profiler::isEnabled() ? name : nullptr )
+	{
+		if( m_name )
+			m_begin = Profiler::now();
+	}
+
+	~ProfileScope( void )
+	{
+		if( m_name )
+			Profiler::record( m_name, m_begin, Profiler::now() );
+	}
+
+private:
+	ProfileScope( const ProfileScope& ) = delete;
+	ProfileScope& operator=( const ProfileScope& ) = delete;
+
+private:
+	const char* m_name;
+	int64_t m_begin;
+};
+
+NAMESPACE_END
+
+#endif //__PROFILER_H__
\ No newline at end of file
@@ -67,7 +67,7 @@ public:
 		}
 	}
 
-	inline Ptr( Ptrctor<T>& rhs )
+	inline Ptr( Ptrctor<T>&& rhs )
 	{
 		if( rhs.m_reference )
 		{
@@ -150,7 +150,7 @@ public:
 		}
 	}
 
-	inline void set( Ptrctor<T>& rhs )
+	inline void set( Ptrctor<T>&& rhs )
 	{
 		MAGICAL_ASSERT( m_reference != rhs.m_reference || ( !rhs.m_reference && !m_reference ), "Invalid!" );
 
@@ -44,7 +44,7 @@ public:
 	}
 
 private:
-	template< class T >
+	template< class Tz >
 	friend class Ptr;
 	T* m_reference = nullptr;
 };
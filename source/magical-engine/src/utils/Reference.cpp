@@ -22,11 +22,19 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 *******************************************************************************/
 #include "Reference.h"
+#include "Stats.h"
 
 NAMESPACE_MAGICAL
 
+static Stat _stat_objects_created( "objects.created", Stat::Counter );
+static Stat _stat_objects_destroyed( "objects.destroyed", Stat::Counter );
+static Stat _stat_objects_alive( "objects.alive", Stat::Gauge );
+
 Reference::Reference( void ) 
 {
+	_stat_objects_created.add();
+	_stat_objects_alive.add();
+
 #ifdef MAGICAL_DEBUG
 	//magicalObjectConstruct();
 #endif
@@ -34,6 +42,9 @@ Reference::Reference( void )
 
 Reference::~Reference( void )
 {
+	_stat_objects_destroyed.add();
+	_stat_objects_alive.sub();
+
 #ifdef MAGICAL_DEBUG
 	//magicalObjectDestruct();
 #endif
@@ -0,0 +1,158 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "Stats.h"
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+NAMESPACE_MAGICAL
+
+// 常量初始化，其他编译单元的静态对象构造时可以安全注册
+static Stat* _head = nullptr;
+static size_t _registered = 0;
+
+static Vector<Stat*> _sorted;
+static size_t _frame_count = 0;
+static FILE* _csv = nullptr;
+
+Stat::Stat( const char* name, Kind kind, Sampler sampler )
+: m_name( name )
+, m_kind( kind )
+, m_sampler( sampler )
+, m_value( 0 )
+{
+	MAGICAL_ASSERT( name, "should not be nullptr." );
+
+	m_next = _head;
+	_head = this;
+	++ _registered;
+}
+
+const Vector<Stat*>& Stats::sorted( void )
+{
+	if( _sorted.size() != _registered )
+	{
+		_sorted.clear();
+		for( Stat* stat = _head; stat != nullptr; stat = stat->m_next )
+			_sorted.push_back( stat );
+
+		std::sort( _sorted.begin(), _sorted.end(), []( const Stat* a, const Stat* b ){
+			return strcmp( a->getName(), b->getName() ) < 0;
+		} );
+	}
+	return _sorted;
+}
+
+void Stats::delc( void )
+{
+	closeCsv();
+}
+
+void Stats::newFrame( void )
+{
+	for( Stat* stat = _head; stat != nullptr; stat = stat->m_next )
+	{
+		if( stat->m_sampler )
+			stat->m_value.store( stat->m_sampler(), std::memory_order_relaxed );
+
+		if( stat->m_kind == Stat::Counter )
+			stat->m_last_value = stat->m_value.exchange( 0, std::memory_order_relaxed );
+		else
+			stat->m_last_value = stat->m_value.load( std::memory_order_relaxed );
+	}
+
+	if( _csv )
+	{
+		fprintf( _csv, "%u", (unsigned int) _frame_count );
+		for( auto stat : sorted() )
+			fprintf( _csv, ",%lld", (long long) stat->m_last_value );
+		fputc( '\n', _csv );
+	}
+
+	++ _frame_count;
+}
+
+size_t Stats::getFrameCount( void )
+{
+	return _frame_count;
+}
+
+Stat* Stats::find( const char* name )
+{
+	MAGICAL_ASSERT( name, "should not be nullptr." );
+
+	for( Stat* stat = _head; stat != nullptr; stat = stat->m_next )
+	{
+		if( strcmp( stat->m_name, name ) == 0 )
+			return stat;
+	}
+	return nullptr;
+}
+
+int64_t Stats::get( const char* name )
+{
+	Stat* stat = find( name );
+	return stat ? stat->m_last_value : 0;
+}
+
+void Stats::getAll( Vector<Stat*>& stats )
+{
+	stats = sorted();
+}
+
+bool Stats::openCsv( const char* file )
+{
+	MAGICAL_ASSERT( file, "should not be nullptr." );
+
+	closeCsv();
+	_csv = fopen( file, "wb" );
+	if( _csv == nullptr )
+	{
+		MAGICAL_SET_LAST_ERROR( System::format( "open file(%s) failed!", file ).c_str() );
+		MAGICAL_LOG_LAST_ERROR();
+		return false;
+	}
+
+	fputs( "frame", _csv );
+	for( auto stat : sorted() )
+		fprintf( _csv, ",%s", stat->m_name );
+	fputc( '\n', _csv );
+	return true;
+}
+
+void Stats::closeCsv( void )
+{
+	if( _csv )
+	{
+		fclose( _csv );
+		_csv = nullptr;
+	}
+}
+
+bool Stats::isCsvOpen( void )
+{
+	return _csv != nullptr;
+}
+
+NAMESPACE_END
\ No newline at end of file
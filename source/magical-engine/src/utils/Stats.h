@@ -0,0 +1,113 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __STATS_H__
+#define __STATS_H__
+
+#include "magical-macros.h"
+#include "Common.h"
+#include "Vector.h"
+#include <atomic>
+
+NAMESPACE_MAGICAL
+
+/*
+引擎统计项
+
+Counter每帧开始时清零，记录一帧内的次数；Gauge保持当前值，也可以提供sampler在每帧结束时采样
+统计项必须是静态存储期的对象，构造时注册到Stats，name必须是字符串常量
+*/
+class Stat
+{
+public:
+	enum Kind
+	{
+		Counter,
+		Gauge,
+	};
+
+	typedef int64_t(*Sampler)( void );
+
+public:
+	Stat( const char* name, Kind kind, Sampler sampler = nullptr );
+
+public:
+	void add( int64_t value = 1 ) { m_value.fetch_add( value, std::memory_order_relaxed ); }
+	void sub( int64_t value = 1 ) { m_value.fetch_sub( value, std::memory_order_relaxed ); }
+	void set( int64_t value ) { m_value.store( value, std::memory_order_relaxed ); }
+	// 正在统计的这一帧的值
+	int64_t getValue( void ) const { return m_value.load( std::memory_order_relaxed ); }
+	// 上一帧结束时的值
+	int64_t getLastValue( void ) const { return m_last_value; }
+	const char* getName( void ) const { return m_name; }
+	Kind getKind( void ) const { return m_kind; }
+
+private:
+	Stat( const Stat& ) = delete;
+	Stat& operator=( const Stat& ) = delete;
+
+private:
+	friend class Stats;
+	const char* m_name;
+	Kind m_kind;
+	Sampler m_sampler;
+	std::atomic<int64_t> m_value;
+	int64_t m_last_value = 0;
+	Stat* m_next = nullptr;
+};
+
+class Stats
+{
+public:
+	static void delc( void );
+
+public:
+	/*
+	结束上一帧的统计，每帧在主线程调用一次：
+	保存各项的值，清零Counter，打开了CSV时追加一行
+	*/
+	static void newFrame( void );
+	static size_t getFrameCount( void );
+
+public:
+	static Stat* find( const char* name );
+	// 上一帧的值，不存在时返回0
+	static int64_t get( const char* name );
+	// 按名称排序
+	static void getAll( Vector<Stat*>& stats );
+
+public:
+	/*
+	第一行为统计项名称，之后每帧一行，方便对比不同版本的性能数据
+	*/
+	static bool openCsv( const char* file );
+	static void closeCsv( void );
+	static bool isCsvOpen( void );
+
+private:
+	static const Vector<Stat*>& sorted( void );
+};
+
+NAMESPACE_END
+
+#endif //__STATS_H__
\ No newline at end of file
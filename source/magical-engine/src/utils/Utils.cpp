@@ -24,14 +24,44 @@ SOFTWARE.
 #include "Utils.h"
 #include <chrono>
 
+#ifdef MAGICAL_WIN32
+#include <windows.h>
+#endif
+
 NAMESPACE_MAGICAL
 
+#ifdef MAGICAL_WIN32
+/*
+VS2013的函数内静态变量初始化不是线程安全的，计数器频率在启动时固定不变，
+放在文件作用域中于main之前查询一次，日志等工作线程读取时不再有竞争
+*/
+static int64_t queryPerformanceFrequency( void )
+{
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency( &frequency );
+	return (int64_t) frequency.QuadPart;
+}
+
+static const int64_t _performance_frequency = queryPerformanceFrequency();
+#endif
+
+/*
+单调递增的时间，只用于计算时间间隔
+VS2013的chrono时钟实际精度只有毫秒级，帧内的时间预算需要使用QueryPerformanceCounter
+*/
 int64_t Time::currentMicroseconds( void )
 {
+#ifdef MAGICAL_WIN32
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter( &counter );
+	int64_t ticks = (int64_t) counter.QuadPart;
+	return ticks / _performance_frequency * 1000000 + ticks % _performance_frequency * 1000000 / _performance_frequency;
+#else
 	using namespace ::std::chrono;
-	system_clock::duration scd = system_clock::now().time_since_epoch();
+	steady_clock::duration scd = steady_clock::now().time_since_epoch();
 	microseconds::rep now = duration_cast<microseconds>( scd ).count();
 	return now;
+#endif
 }
 
 int64_t Time::currentSeconds( void )
@@ -54,6 +84,8 @@ bool FileUtils::isAbsPath( const char* path )
 		return true;
 	}
 	return false;
+#else
+	return path[0] == '/';
 #endif
 }
 
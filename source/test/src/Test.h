@@ -0,0 +1,87 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#ifndef __TEST_H__
+#define __TEST_H__
+
+#include "magical-engine.h"
+#include <stdio.h>
+#include <math.h>
+
+USING_NS_MAGICAL;
+
+/*
+单元测试，每个源文件是一个独立的可执行文件，由ctest运行
+检查失败时打印位置并继续，main返回失败的数量
+*/
+static int _test_failures = 0;
+static int _test_checks = 0;
+
+#define TEST_CHECK( exp ) do {                                                     \
+	++_test_checks;                                                                \
+	if( !( exp ) ) {                                                               \
+		++_test_failures;                                                          \
+		fprintf( stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #exp ); \
+	}                                                                              \
+	} while(0)
+
+#define TEST_CHECK_NEAR( a, b, eps ) do {                                          \
+	++_test_checks;                                                                \
+	double _a = (double)( a ), _b = (double)( b );                                 \
+	if( !( fabs( _a - _b ) <= ( eps ) ) ) {                                        \
+		++_test_failures;                                                          \
+		fprintf( stderr, "%s:%d: %s = %g, %s = %g, error %g > %g\n",               \
+			__FILE__, __LINE__, #a, _a, #b, _b, fabs( _a - _b ), (double)( eps ) );\
+	}                                                                              \
+	} while(0)
+
+#define TEST_RUN( func ) do {                                                      \
+	int _before = _test_failures;                                                  \
+	func();                                                                        \
+	printf( "%-40s %s\n", #func, _test_failures == _before ? "ok" : "FAILED" );    \
+	} while(0)
+
+#define TEST_RESULT() ( printf( "%d checks, %d failures\n", _test_checks, _test_failures ), _test_failures )
+
+/*
+确定性的伪随机数，测试结果不依赖平台的rand()
+*/
+class TestRandom
+{
+public:
+	explicit TestRandom( uint32_t seed ) : m_state( seed ? seed : 1 ) {}
+	uint32_t next( void )
+	{
+		m_state ^= m_state << 13;
+		m_state ^= m_state >> 17;
+		m_state ^= m_state << 5;
+		return m_state;
+	}
+	// [lo, hi)
+	float range( float lo, float hi ) { return lo + ( hi - lo ) * ( next() >> 8 ) * ( 1.0f / 16777216.0f ); }
+
+private:
+	uint32_t m_state;
+};
+
+#endif //__TEST_H__
\ No newline at end of file
@@ -0,0 +1,230 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "Test.h"
+#include "AnimationClip.h"
+#include <string.h>
+
+/*
+AnimationClip的逐条添加轨道、采样与保存加载：关键帧上的采样等于原始数据，帧间的旋转与Quaternion::slerp一致，
+保存后加载的片段采样结果相同，再次保存得到相同的字节
+*/
+
+static const size_t Frames = 31;
+static const size_t Tracks = 40;
+
+struct TestTrack
+{
+	Vector<Vector3> translations;
+	Vector<Quaternion> rotations;
+	Vector<Vector3> scales;
+	bool animated_t;
+	bool animated_r;
+	bool animated_s;
+};
+
+/*
+各通道按轨道下标交替为常量或者逐帧变化，轨道数超过初始预留的列数，添加过程中会重新排列几次
+*/
+static void buildTracks( TestRandom& random, Vector<TestTrack>& tracks )
+{
+	tracks.resize( Tracks );
+	for( size_t i = 0; i < Tracks; ++i )
+	{
+		TestTrack& track = tracks[i];
+		track.animated_t = i % 2 == 0;
+		track.animated_r = i % 3 != 0;
+		track.animated_s = i % 5 == 0;
+
+		Vector3 axis( random.range( -1.0f, 1.0f ), random.range( -1.0f, 1.0f ), random.range( 0.1f, 1.0f ) );
+		axis.normalize();
+		Vector3 offset( random.range( -1.0f, 1.0f ), random.range( -1.0f, 1.0f ), random.range( -1.0f, 1.0f ) );
+		float speed = random.range( 0.05f, 0.2f );
+
+		for( size_t f = 0; f < Frames; ++f )
+		{
+			float k = (float) f;
+			track.translations.push_back( track.animated_t ? offset + Vector3( k * 0.1f, sinf( k * 0.3f ), 0.0f ) : offset );
+			track.rotations.push_back( Quaternion::createRotation( axis, track.animated_r ? speed * k : speed ) );
+			track.scales.push_back( track.animated_s ? Vector3( 1.0f + k * 0.01f, 1.0f, 1.0f - k * 0.01f ) : Vector3::One );
+		}
+	}
+}
+
+static Ptr<AnimationClip> buildClip( const Vector<TestTrack>& tracks )
+{
+	Ptr<AnimationClip> clip = AnimationClip::create( AnimationClip::DefaultFrameRate, Frames );
+	for( size_t i = 0; i < tracks.size(); ++i )
+	{
+		const TestTrack& track = tracks[i];
+		size_t index = clip->addTrack( System::format( "track%d", (int) i ).c_str(),
+			track.translations.data(), track.rotations.data(), track.scales.data() );
+		TEST_CHECK( index == i );
+	}
+	return clip;
+}
+
+/*
+q与-q表示同一个旋转
+*/
+static float rotationError( const Quaternion& a, const Quaternion& b )
+{
+	return 1.0f - fabsf( a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w );
+}
+
+static void testSampleKeys( void )
+{
+	TestRandom random( 26 );
+	Vector<TestTrack> tracks;
+	buildTracks( random, tracks );
+	Ptr<AnimationClip> clip = buildClip( tracks );
+
+	TEST_CHECK( clip->trackCount() == Tracks );
+	TEST_CHECK( clip->frameCount() == Frames );
+	TEST_CHECK_NEAR( clip->getDuration(), ( Frames - 1 ) / AnimationClip::DefaultFrameRate, 1.0e-6f );
+	TEST_CHECK( clip->getTrackName( 7 ) == "track7" );
+
+	AnimationPose pose;
+	for( size_t f = 0; f < Frames; ++f )
+	{
+		clip->sample( pose, f / clip->getFrameRate() );
+		TEST_CHECK( pose.translations.size() == Tracks );
+		for( size_t i = 0; i < Tracks; ++i )
+		{
+			const TestTrack& track = tracks[i];
+			TEST_CHECK_NEAR( pose.translations[i].x, track.translations[f].x, 1.0e-5f );
+			TEST_CHECK_NEAR( pose.translations[i].y, track.translations[f].y, 1.0e-5f );
+			TEST_CHECK_NEAR( pose.translations[i].z, track.translations[f].z, 1.0e-5f );
+			TEST_CHECK_NEAR( pose.scales[i].x, track.scales[f].x, 1.0e-5f );
+			TEST_CHECK_NEAR( pose.scales[i].z, track.scales[f].z, 1.0e-5f );
+
+			// 旋转以snorm16保存
+			TEST_CHECK( rotationError( pose.rotations[i], track.rotations[f] ) < 1.0e-6f );
+			TEST_CHECK_NEAR( pose.rotations[i].length(), 1.0f, 1.0e-4f );
+		}
+	}
+
+	// 超出范围的时间取首尾两帧
+	clip->sample( pose, -1.0f );
+	TEST_CHECK_NEAR( pose.translations[0].x, tracks[0].translations[0].x, 1.0e-5f );
+	clip->sample( pose, 100.0f );
+	TEST_CHECK_NEAR( pose.translations[0].x, tracks[0].translations[ Frames - 1 ].x, 1.0e-5f );
+}
+
+static void testSampleSlerp( void )
+{
+	TestRandom random( 27 );
+	Vector<TestTrack> tracks;
+	buildTracks( random, tracks );
+	Ptr<AnimationClip> clip = buildClip( tracks );
+
+	AnimationPose pose;
+	for( int n = 0; n < 200; ++n )
+	{
+		float time = random.range( 0.0f, clip->getDuration() );
+		float frame = time * clip->getFrameRate();
+		size_t f0 = Math::min( (size_t) frame, Frames - 2 );
+		float t = frame - f0;
+
+		clip->sample( pose, time );
+		for( size_t i = 0; i < Tracks; ++i )
+		{
+			const TestTrack& track = tracks[i];
+			Quaternion expected = Quaternion::slerp( track.rotations[ f0 ], track.rotations[ f0 + 1 ], t );
+
+			// 相邻两帧最多相差0.2弧度，nlerp与slerp的差别远小于snorm16的精度
+			TEST_CHECK( rotationError( pose.rotations[i], expected ) < 1.0e-5f );
+
+			Vector3 translation = track.translations[ f0 ] + ( track.translations[ f0 + 1 ] - track.translations[ f0 ] ) * t;
+			TEST_CHECK_NEAR( pose.translations[i].x, translation.x, 1.0e-4f );
+			TEST_CHECK_NEAR( pose.translations[i].y, translation.y, 1.0e-4f );
+		}
+	}
+}
+
+static bool samePose( const AnimationPose& a, const AnimationPose& b )
+{
+	if( a.translations.size() != b.translations.size() )
+		return false;
+	for( size_t i = 0; i < a.translations.size(); ++i )
+	{
+		if( !( a.translations[i] == b.translations[i] ) || !( a.scales[i] == b.scales[i] ) ||
+			memcmp( &a.rotations[i], &b.rotations[i], sizeof( Quaternion ) ) != 0 )
+			return false;
+	}
+	return true;
+}
+
+static void testSaveLoad( void )
+{
+	TestRandom random( 28 );
+	Vector<TestTrack> tracks;
+	buildTracks( random, tracks );
+	Ptr<AnimationClip> clip = buildClip( tracks );
+
+	Ptr<Data> saved = clip->save();
+	Ptr<AnimationClip> loaded = AnimationClip::create();
+	TEST_CHECK( loaded->load( saved.get() ) );
+	TEST_CHECK( loaded->trackCount() == Tracks && loaded->frameCount() == Frames );
+	TEST_CHECK( loaded->getFrameRate() == clip->getFrameRate() );
+	for( size_t i = 0; i < Tracks; ++i )
+		TEST_CHECK( loaded->getTrackName( i ) == clip->getTrackName( i ) );
+
+	// 保存时去掉预留的列，加载后的采样结果与原片段逐位相同
+	AnimationPose a, b;
+	for( int n = 0; n < 100; ++n )
+	{
+		float time = random.range( 0.0f, clip->getDuration() );
+		clip->sample( a, time );
+		loaded->sample( b, time );
+		TEST_CHECK( samePose( a, b ) );
+	}
+
+	Ptr<Data> resaved = loaded->save();
+	TEST_CHECK( resaved->size() == saved->size() && memcmp( resaved->cPtr(), saved->cPtr(), saved->size() ) == 0 );
+
+	// 加载之后继续添加轨道
+	const TestTrack& extra = tracks[0];
+	TEST_CHECK( loaded->addTrack( "extra", extra.translations.data(), extra.rotations.data(), extra.scales.data() ) == Tracks );
+	loaded->sample( b, 0.5f );
+	clip->sample( a, 0.5f );
+	TEST_CHECK( b.translations.size() == Tracks + 1 );
+	TEST_CHECK( b.translations[ Tracks ] == a.translations[0] );
+	TEST_CHECK( memcmp( &b.rotations[ Tracks ], &a.rotations[0], sizeof( Quaternion ) ) == 0 );
+	for( size_t i = 0; i < Tracks; ++i )
+		TEST_CHECK( b.translations[i] == a.translations[i] );
+
+	// 截断的数据加载失败并清空
+	Ptr<Data> truncated = Data::create( saved->size() - 1 );
+	memcpy( truncated->cPtr(), saved->cPtr(), truncated->size() );
+	TEST_CHECK( !loaded->load( truncated.get() ) );
+	TEST_CHECK( loaded->trackCount() == 0 && loaded->frameCount() == 0 );
+}
+
+int main( int argc, char* argv[] )
+{
+	TEST_RUN( testSampleKeys );
+	TEST_RUN( testSampleSlerp );
+	TEST_RUN( testSaveLoad );
+	return TEST_RESULT();
+}
\ No newline at end of file
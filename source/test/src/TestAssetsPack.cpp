@@ -0,0 +1,190 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "Test.h"
+#include "AssetsPack.h"
+#include "AssetsPackBuilder.h"
+#include <string.h>
+#include <thread>
+#include <atomic>
+
+/*
+AssetsPack的打包往返，损坏的目录在open时被拒绝，以及多个线程同时从挂载的包中加载
+*/
+
+static Ptr<Data> buildPack( void )
+{
+	string text( 4096, 'a' );
+	string raw = "0123456789";
+
+	AssetsPackBuilder builder;
+	builder.addData( "scripts/main.lua", text.c_str(), text.length() );
+	builder.addData( "./raw.bin", raw.c_str(), raw.length(), false );
+	builder.addData( "empty.txt", nullptr, 0 );
+	return builder.build();
+}
+
+static Ptr<Data> copyData( const Ptr<Data>& data, size_t extra = 0 )
+{
+	Ptr<Data> ret = Data::create( data->size() + extra );
+	memset( ret->cPtr(), 0, ret->size() );
+	memcpy( ret->cPtr(), data->cPtr(), data->size() );
+	return ret;
+}
+
+static AssetsPackEntry* findEntry( const Ptr<Data>& data, const char* name )
+{
+	AssetsPackHeader* header = (AssetsPackHeader*) data->cPtr();
+	AssetsPackEntry* entries = (AssetsPackEntry*) ( data->cPtr() + header->toc_offset );
+	uint64_t hash = AssetsPack::hash( name );
+	for( uint32_t i = 0; i < header->count; ++i )
+	{
+		if( entries[i].hash == hash )
+			return &entries[i];
+	}
+	return nullptr;
+}
+
+static void testRoundTrip( void )
+{
+	Ptr<AssetsPack> pack = AssetsPack::create();
+	TEST_CHECK( pack->open( buildPack() ) );
+	TEST_CHECK( pack->fileCount() == 3 );
+	TEST_CHECK( pack->contains( "raw.bin" ) );
+	TEST_CHECK( !pack->contains( "missing.txt" ) );
+
+	Ptr<Data> text = pack->loadFile( "./scripts/main.lua" );
+	TEST_CHECK( text && text->size() == 4097 && text->cPtr()[ 4095 ] == 'a' && text->cPtr()[ 4096 ] == 0 );
+
+	Ptr<Data> raw = pack->loadFile( "raw.bin" );
+	TEST_CHECK( raw && raw->size() == 11 && strcmp( raw->cPtr(), "0123456789" ) == 0 );
+
+	Ptr<Data> empty = pack->loadFile( "empty.txt" );
+	TEST_CHECK( empty && empty->size() == 1 && empty->cPtr()[0] == 0 );
+}
+
+static void testTruncated( void )
+{
+	Ptr<Data> data = buildPack();
+	Ptr<AssetsPack> pack = AssetsPack::create();
+
+	// 与Assets::loadFile一样结尾多出一个0，按实际大小打开时少一个字节就必须失败
+	Ptr<Data> loaded = copyData( data, 1 );
+	TEST_CHECK( pack->open( loaded, data->size() ) );
+	TEST_CHECK( !pack->open( loaded, data->size() - 1 ) );
+	TEST_CHECK( !pack->open( loaded, sizeof( AssetsPackHeader ) - 1 ) );
+}
+
+static void testCorruptEntry( void )
+{
+	Ptr<Data> data = buildPack();
+	Ptr<AssetsPack> pack = AssetsPack::create();
+
+	// 数据越过包的结尾
+	Ptr<Data> bad = copyData( data );
+	findEntry( bad, "raw.bin" )->offset = bad->size() - 4;
+	TEST_CHECK( !pack->open( bad ) );
+
+	// 压缩条目声明的大小超过LZ4的最大展开比例，不能据此分配内存
+	bad = copyData( data );
+	AssetsPackEntry* entry = findEntry( bad, "scripts/main.lua" );
+	TEST_CHECK( entry && entry->packed_size < entry->size );
+	entry->size = 0x7fffffffffffULL;
+	TEST_CHECK( !pack->open( bad ) );
+
+	// 名字越过名字表
+	bad = copyData( data );
+	findEntry( bad, "empty.txt" )->name_length = 0x10000;
+	TEST_CHECK( !pack->open( bad ) );
+
+	TEST_CHECK( pack->open( data ) );
+}
+
+/*
+多个线程从挂载的包中加载，主线程同时反复挂载和卸载另一个包，
+需要在ThreadSanitizer下没有报告
+*/
+static void testConcurrentLoad( void )
+{
+	Ptr<AssetsPack> pack = AssetsPack::create();
+	TEST_CHECK( pack->open( buildPack() ) );
+	AssetsPack::mount( pack );
+
+	string extra_text( 1000, 'x' );
+	AssetsPackBuilder builder;
+	builder.addData( "extra.txt", extra_text.c_str(), extra_text.length() );
+	Ptr<AssetsPack> extra = AssetsPack::create();
+	TEST_CHECK( extra->open( builder.build() ) );
+
+	std::atomic<int> bad( 0 );
+	std::vector<std::thread> threads;
+	for( int t = 0; t < 4; ++t )
+	{
+		threads.push_back( std::thread( [ & ](){
+			for( int i = 0; i < 2000; ++i )
+			{
+				Ptr<Data> text = AssetsPack::loadMountedFile( "scripts/main.lua" );
+				Ptr<Data> raw = AssetsPack::loadMountedFile( "raw.bin" );
+				if( !text || text->size() != 4097 || text->cPtr()[ 4095 ] != 'a' )
+					++ bad;
+				if( !raw || strcmp( raw->cPtr(), "0123456789" ) != 0 )
+					++ bad;
+
+				// 卸载期间可能找不到，找到时内容必须完整
+				Ptr<Data> data = AssetsPack::loadMountedFile( "extra.txt" );
+				if( data )
+				{
+					if( data->size() != 1001 || data->cPtr()[ 999 ] != 'x' )
+						++ bad;
+				}
+			}
+		} ) );
+	}
+
+	for( int i = 0; i < 200; ++i )
+	{
+		AssetsPack::mount( extra );
+		std::this_thread::yield();
+		AssetsPack::unmount( extra.get() );
+	}
+
+	for( auto& thread : threads )
+	{
+		thread.join();
+	}
+
+	TEST_CHECK( bad == 0 );
+	TEST_CHECK( extra->retainCount() == 1 && pack->retainCount() == 2 );
+	AssetsPack::unmountAll();
+	TEST_CHECK( pack->retainCount() == 1 );
+	TEST_CHECK( !AssetsPack::loadMountedFile( "raw.bin" ) );
+}
+
+int main( int argc, char* argv[] )
+{
+	TEST_RUN( testRoundTrip );
+	TEST_RUN( testTruncated );
+	TEST_RUN( testCorruptEntry );
+	TEST_RUN( testConcurrentLoad );
+	return TEST_RESULT();
+}
\ No newline at end of file
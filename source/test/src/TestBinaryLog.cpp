@@ -0,0 +1,115 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "Test.h"
+#include "BinaryLog.h"
+#include "BinaryLogDecoder.h"
+#include <stdlib.h>
+#include <unistd.h>
+
+/*
+BinaryLog写出已知的记录，BinaryLogDecoder解码后逐行比较文本（去掉时间戳）：
+各种转换说明、参数类型与转换说明不符、参数不足、缓冲已满时被截断和未记录的参数，
+以及前一条记录的参数不会残留到后一条
+*/
+
+static Vector<string> _s_expected;
+
+#define TEST_BLOG( text, fmt, ... ) do {                                                                 \
+	MAGICAL_BLOGD( fmt, ##__VA_ARGS__ );                                                                 \
+	_s_expected.push_back( System::format( "DEBUG   %s  (%s:%d)", text, __FILE__, __LINE__ ) );           \
+	} while(0)
+
+/*
+按行拆分，去掉每行开头的"[时间戳] "
+*/
+static Vector<string> splitLines( const string& text )
+{
+	Vector<string> lines;
+	size_t begin = 0;
+	while( begin < text.length() )
+	{
+		size_t end = text.find( '\n', begin );
+		if( end == string::npos )
+			end = text.length();
+		string line = text.substr( begin, end - begin );
+		size_t prefix = line.find( "] " );
+		lines.push_back( prefix == string::npos ? line : line.substr( prefix + 2 ) );
+		begin = end + 1;
+	}
+	return lines;
+}
+
+static void testRoundTrip( void )
+{
+	char file[] = "/tmp/test-binarylog.XXXXXX";
+	int fd = mkstemp( file );
+	TEST_CHECK( fd >= 0 );
+	close( fd );
+
+	TEST_CHECK( BinaryLog::open( file ) );
+	TEST_CHECK( BinaryLog::isEnabled() );
+
+	TEST_BLOG( "int -7 unsigned 7 hex ff", "int %d unsigned %u hex %x", -7, 7u, 255u );
+	TEST_BLOG( "abc and def", "%s and %s", "abc", string( "def" ) );
+	TEST_BLOG( " 3.14|42  |%|z", "%5.2f|%-4d|%%|%c", 3.14159, 42, 'z' );
+	TEST_BLOG( "    42", "%*d", 6, 42 );
+	TEST_BLOG( "long long 1099511627776", "long long %lld", 1099511627776ll );
+
+	// 上一条记录的第一个参数是整数，字符串参数不能按残留的整数输出
+	TEST_BLOG( "<?> <?>", "%d %f", "oops", "again" );
+	TEST_BLOG( "<?>", "%f", 5 );
+	TEST_BLOG( "5 2.5", "%s %s", 5, 2.5 );
+	TEST_BLOG( "1 <?>", "%d %d", 1 );
+
+	// 字符串截断到缓冲剩余的空间，之后的参数没有记录
+	string x( 300, 'x' );
+	size_t space = BinaryLogRecord::MaxSize - ( 2 * sizeof( uint64_t ) + 1 + 3 ) - sizeof( uint16_t );
+	TEST_BLOG( ( x.substr( 0, space ) + " <?> <?>" ).c_str(), "%s %d %s", x, 7, "tail" );
+	TEST_BLOG( "after overflow 3", "after overflow %d", 3 );
+
+	BinaryLog::close();
+	TEST_CHECK( BinaryLog::getDroppedCount() == 0 );
+
+	BinaryLogDecoder decoder;
+	string text;
+	TEST_CHECK( decoder.decodeFile( file, text ) );
+	TEST_CHECK( decoder.getError().empty() );
+
+	Vector<string> lines = splitLines( text );
+	TEST_CHECK( lines.size() == _s_expected.size() );
+	for( size_t i = 0; i < lines.size() && i < _s_expected.size(); ++i )
+	{
+		if( lines[i] != _s_expected[i] )
+			printf( "line %d:\n  decoded  %s\n  expected %s\n", (int) i, lines[i].c_str(), _s_expected[i].c_str() );
+		TEST_CHECK( lines[i] == _s_expected[i] );
+	}
+
+	unlink( file );
+}
+
+int main( int argc, char* argv[] )
+{
+	TEST_RUN( testRoundTrip );
+	return TEST_RESULT();
+}
\ No newline at end of file
@@ -0,0 +1,136 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "Test.h"
+#include "LuaState.h"
+#include "BindMath.h"
+#include "Stats.h"
+
+/*
+BindMath的原地运算：结果与返回新值的运算相同，参数就是self时也正确，
+并且不经过LuaValuePool分配新的userdata
+*/
+
+static LuaState* newState( void )
+{
+	LuaState* state = new LuaState();
+	state->openLibs();
+	lua_State* L = state->cPtr();
+	int top = lua_gettop( L );
+	luaopen_magical_math( L );
+	lua_settop( L, top );
+	return state;
+}
+
+/*
+执行chunk，返回错误信息，成功时为空
+*/
+static string run( LuaState* state, const char* chunk )
+{
+	lua_State* L = state->cPtr();
+	if( luaL_loadstring( L, chunk ) == 0 && lua_pcall( L, 0, 0, 0 ) == 0 )
+		return "";
+
+	string message = lua_tostring( L, -1 ) ? lua_tostring( L, -1 ) : "?";
+	lua_pop( L, 1 );
+	return message;
+}
+
+static const char* _s_prelude =
+	"function near( a, b ) return math.abs( a - b ) < 1e-5 end\n"
+	"function same( u, v ) return near( u.x, v.x ) and near( u.y, v.y ) and near( u.z, v.z ) end\n"
+	"a = Vector3( 1, 2, 3 ) b = Vector3( 0.5, -1, 0.25 )\n"
+	"q = Quaternion( 0, 0.3826834, 0, 0.9238795 )\n"
+	"m = Matrix4():identity():setTranslation( 1, 2, 3 )\n";
+
+static void testVector3( void )
+{
+	LuaState* state = newState();
+	TEST_CHECK( run( state, _s_prelude ) == "" );
+
+	TEST_CHECK( run( state, "local v = Vector3( a.x, a.y, a.z ) v:addInPlace( b ) assert( same( v, a + b ) )" ) == "" );
+	TEST_CHECK( run( state, "local v = Vector3( a.x, a.y, a.z ) v:subInPlace( b ) assert( same( v, Vector3( 0.5, 3, 2.75 ) ) )" ) == "" );
+	TEST_CHECK( run( state, "local v = Vector3( a.x, a.y, a.z ) v:mulInPlace( b ) assert( same( v, Vector3( 0.5, -2, 0.75 ) ) )" ) == "" );
+	TEST_CHECK( run( state, "local v = Vector3( a.x, a.y, a.z ) v:mulScalarInPlace( 0.5 ) assert( same( v, a * 0.5 ) )" ) == "" );
+	TEST_CHECK( run( state, "local v = Vector3( a.x, a.y, a.z ) v:mulMatrix4InPlace( m ) assert( same( v, a * m ) )" ) == "" );
+	TEST_CHECK( run( state, "local v = Vector3( a.x, a.y, a.z ) v:rotateInPlace( q ) assert( same( v, q * a ) )" ) == "" );
+	TEST_CHECK( run( state, "local v = Vector3( a.x, a.y, a.z ) v:crossInPlace( b ) assert( same( v, a:cross( b ) ) )" ) == "" );
+
+	// 参数与self是同一个对象
+	TEST_CHECK( run( state, "local v = Vector3( a.x, a.y, a.z ) v:addInPlace( v ) assert( same( v, a * 2 ) )" ) == "" );
+	TEST_CHECK( run( state, "local v = Vector3( a.x, a.y, a.z ) v:crossInPlace( v ) assert( same( v, Vector3( 0, 0, 0 ) ) )" ) == "" );
+	delete state;
+}
+
+static void testQuaternionMatrix4( void )
+{
+	LuaState* state = newState();
+	TEST_CHECK( run( state, _s_prelude ) == "" );
+
+	TEST_CHECK( run( state,
+		"local p = Quaternion( q.x, q.y, q.z, q.w ) p:mulInPlace( q )\n"
+		"assert( same( p * a, q * ( q * a ) ) )" ) == "" );
+	TEST_CHECK( run( state,
+		"local p = Quaternion( 1, 2, 3, 4 ) p:addInPlace( Quaternion( 1, 1, 1, 1 ) ) p:subInPlace( Quaternion( 0, 0, 0, 2 ) )\n"
+		"p:mulScalarInPlace( 0.5 )\n"
+		"assert( near( p.x, 1 ) and near( p.y, 1.5 ) and near( p.z, 2 ) and near( p.w, 1.5 ) )" ) == "" );
+
+	// 两次平移相加；缩放后单位向量得到( 1 + 1, 1 + 2, 1 + 3 ) * 2
+	TEST_CHECK( run( state,
+		"local n = Matrix4():identity():setTranslation( 1, 2, 3 ) n:mulInPlace( Matrix4():identity():setTranslation( 4, 5, 6 ) )\n"
+		"assert( same( Vector3( 0, 0, 0 ) * n, Vector3( 5, 7, 9 ) ) )\n"
+		"local s = Matrix4():identity():setTranslation( 1, 2, 3 ) s:mulScalarInPlace( 2 )\n"
+		"assert( same( Vector3( 1, 1, 1 ) * s, Vector3( 4, 6, 8 ) ) )" ) == "" );
+	delete state;
+}
+
+static void testNoAllocation( void )
+{
+	LuaState* state = newState();
+	TEST_CHECK( run( state, _s_prelude ) == "" );
+
+	Stat* allocs = Stats::find( "lua.pool.allocs" );
+	TEST_CHECK( allocs != nullptr );
+	if( allocs == nullptr )
+	{
+		delete state;
+		return;
+	}
+
+	int64_t start = allocs->getValue();
+	TEST_CHECK( run( state, "for i = 1, 1000 do a:addInPlace( b ) a:rotateInPlace( q ) a:mulMatrix4InPlace( m ) end" ) == "" );
+	TEST_CHECK( allocs->getValue() == start );
+
+	// 对照：每次运算都分配一个结果
+	TEST_CHECK( run( state, "for i = 1, 1000 do local c = a + b end" ) == "" );
+	TEST_CHECK( allocs->getValue() - start >= 1000 );
+	delete state;
+}
+
+int main( int argc, char* argv[] )
+{
+	TEST_RUN( testVector3 );
+	TEST_RUN( testQuaternionMatrix4 );
+	TEST_RUN( testNoAllocation );
+	return TEST_RESULT();
+}
\ No newline at end of file
@@ -0,0 +1,256 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "Test.h"
+#include "BoundingVolumeTree.h"
+#include <algorithm>
+#include <math.h>
+
+/*
+BoundingVolumeTree的随机插入、移动、删除和重建：queryBox和raycast的结果与逐个遍历所有代理的暴力结果相同，
+外扩包围盒始终包含对象，树高保持在对数级别
+*/
+
+struct TestProxy
+{
+	int proxy;
+	Box box;
+};
+
+static Box randomBox( TestRandom& random, float spread )
+{
+	Vector3 center( random.range( -spread, spread ), random.range( -spread, spread ), random.range( -spread, spread ) );
+	Vector3 extents( random.range( 0.1f, 2.0f ), random.range( 0.1f, 2.0f ), random.range( 0.1f, 2.0f ) );
+	return Box( center - extents, center + extents );
+}
+
+static bool overlaps( const Box& a, const Box& b )
+{
+	return
+		a.min.x <= b.max.x && a.max.x >= b.min.x &&
+		a.min.y <= b.max.y && a.max.y >= b.min.y &&
+		a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+static bool contains( const Box& outer, const Box& inner )
+{
+	return
+		outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+		outer.max.x >= inner.max.x && outer.max.y >= inner.max.y && outer.max.z >= inner.max.z;
+}
+
+/*
+射线与盒子的slab测试，方向的各分量都不为0
+*/
+static bool raycastBox( const Ray& ray, const Box& box, float max_distance )
+{
+	float tmin = 0.0f, tmax = max_distance;
+	const float origin[3] = { ray.origin.x, ray.origin.y, ray.origin.z };
+	const float direction[3] = { ray.dx, ray.dy, ray.dz };
+	for( int i = 0; i < 3; ++i )
+	{
+		float t1 = ( box.min[i] - origin[i] ) / direction[i];
+		float t2 = ( box.max[i] - origin[i] ) / direction[i];
+		tmin = Math::max( tmin, Math::min( t1, t2 ) );
+		tmax = Math::min( tmax, Math::max( t1, t2 ) );
+	}
+	return tmin <= tmax;
+}
+
+/*
+平衡的二叉树高度约为log2(n)，旋转只发生在修改路径上，允许到2倍
+*/
+static int heightLimit( size_t count )
+{
+	return (int)( 2.0f * ceilf( log2f( (float) Math::max( count, (size_t) 2 ) ) ) ) + 2;
+}
+
+static void checkQueries( TestRandom& random, const BoundingVolumeTree& tree, const Vector<TestProxy>& proxies )
+{
+	TEST_CHECK( tree.leafCount() == proxies.size() );
+	TEST_CHECK( tree.getHeight() <= heightLimit( proxies.size() ) );
+
+	for( const auto& p : proxies )
+	{
+		TEST_CHECK( contains( tree.getFatBox( p.proxy ), p.box ) );
+		TEST_CHECK( tree.getUserData( p.proxy ) == &p );
+	}
+
+	for( int q = 0; q < 20; ++q )
+	{
+		Box query = randomBox( random, 40.0f );
+		query.max += Vector3( 5.0f, 5.0f, 5.0f );
+
+		Vector<int> found;
+		tree.queryBox( query, [ & ]( int proxy ) { found.push_back( proxy ); return true; } );
+		Vector<int> expected;
+		for( const auto& p : proxies )
+		{
+			if( overlaps( tree.getFatBox( p.proxy ), query ) )
+				expected.push_back( p.proxy );
+		}
+		std::sort( found.begin(), found.end() );
+		std::sort( expected.begin(), expected.end() );
+		TEST_CHECK( found == expected );
+	}
+
+	for( int q = 0; q < 20; ++q )
+	{
+		Vector3 origin( random.range( -60.0f, 60.0f ), random.range( -60.0f, 60.0f ), random.range( -60.0f, 60.0f ) );
+		Vector3 direction( random.range( 0.1f, 1.0f ), random.range( 0.1f, 1.0f ), random.range( 0.1f, 1.0f ) );
+		if( random.next() & 1 ) direction.x = -direction.x;
+		if( random.next() & 1 ) direction.y = -direction.y;
+		if( random.next() & 1 ) direction.z = -direction.z;
+		direction.normalize();
+		Ray ray( origin, direction );
+		float max_distance = random.range( 20.0f, 150.0f );
+
+		Vector<int> found;
+		tree.raycast( ray, max_distance, [ & ]( int proxy, float distance ) { found.push_back( proxy ); return distance; } );
+		Vector<int> expected;
+		for( const auto& p : proxies )
+		{
+			if( raycastBox( ray, tree.getFatBox( p.proxy ), max_distance ) )
+				expected.push_back( p.proxy );
+		}
+		std::sort( found.begin(), found.end() );
+		std::sort( expected.begin(), expected.end() );
+		TEST_CHECK( found == expected );
+	}
+}
+
+static void testRandomOperations( void )
+{
+	TestRandom random( 28 );
+	BoundingVolumeTree tree;
+	tree.setMargin( 0.5f );
+
+	// 预留容量，user_data指向的元素地址保持不变
+	Vector<TestProxy> proxies;
+	proxies.reserve( 4096 );
+
+	for( int round = 0; round < 40; ++round )
+	{
+		int inserts = (int)( random.next() % 100 );
+		for( int i = 0; i < inserts && proxies.size() < 4000; ++i )
+		{
+			proxies.push_back( TestProxy() );
+			TestProxy& p = proxies.back();
+			p.box = randomBox( random, 50.0f );
+			p.proxy = tree.insert( p.box, &p );
+		}
+
+		for( auto& p : proxies )
+		{
+			switch( random.next() % 4 )
+			{
+				case 0:
+					break;
+				case 1:
+				{
+					// 外扩范围内的小位移不修改树
+					Vector3 d( random.range( -0.2f, 0.2f ), random.range( -0.2f, 0.2f ), random.range( -0.2f, 0.2f ) );
+					Box box( p.box.min + d, p.box.max + d );
+					TEST_CHECK( !tree.move( p.proxy, box ) );
+					break;
+				}
+				default:
+					p.box = randomBox( random, 50.0f );
+					tree.move( p.proxy, p.box );
+					break;
+			}
+		}
+
+		int removes = (int)( random.next() % 60 );
+		for( int i = 0; i < removes && !proxies.empty(); ++i )
+		{
+			// 和最后一个交换后删除，被移动的元素更新user_data
+			size_t index = random.next() % proxies.size();
+			tree.remove( proxies[ index ].proxy );
+			if( index + 1 != proxies.size() )
+			{
+				tree.remove( proxies.back().proxy );
+				proxies[ index ] = proxies.back();
+				proxies[ index ].proxy = tree.insert( proxies[ index ].box, &proxies[ index ] );
+			}
+			proxies.pop_back();
+		}
+
+		if( round % 8 == 7 )
+		{
+			tree.rebuild();
+			TEST_CHECK( tree.modifications() == 0 );
+		}
+
+		checkQueries( random, tree, proxies );
+	}
+
+	for( auto& p : proxies )
+		tree.remove( p.proxy );
+	TEST_CHECK( tree.leafCount() == 0 && tree.getHeight() == 0 );
+}
+
+/*
+按顺序插入时SAH选不出更优的兄弟：互相重叠的盒子，以及不断远离已有对象的盒子（兄弟是整棵树，新的父节点本身就不平衡）
+*/
+static void testSequentialInsert( void )
+{
+	for( float step : { 0.01f, 12.0f } )
+	{
+		BoundingVolumeTree tree;
+		Vector<TestProxy> proxies;
+		proxies.reserve( 2048 );
+		for( int i = 0; i < 2048; ++i )
+		{
+			proxies.push_back( TestProxy() );
+			TestProxy& p = proxies.back();
+			p.box = Box( Vector3( i * step, 0.0f, 0.0f ), Vector3( i * step + 10.0f, 1.0f, 1.0f ) );
+			p.proxy = tree.insert( p.box, &p );
+			TEST_CHECK( tree.getHeight() <= heightLimit( proxies.size() ) );
+		}
+
+		TestRandom random( 29 );
+		checkQueries( random, tree, proxies );
+	}
+
+	// 每个盒子到已有对象的距离都比它们之间的距离远，兄弟总是根节点
+	BoundingVolumeTree tree;
+	Vector<TestProxy> proxies;
+	proxies.reserve( 64 );
+	for( int i = 0; i < 64; ++i )
+	{
+		proxies.push_back( TestProxy() );
+		TestProxy& p = proxies.back();
+		float x = ldexpf( 1.0f, i );
+		p.box = Box( Vector3( x, 0.0f, 0.0f ), Vector3( x + 1.0f, 1.0f, 1.0f ) );
+		p.proxy = tree.insert( p.box, &p );
+		TEST_CHECK( tree.getHeight() <= heightLimit( proxies.size() ) );
+	}
+}
+
+int main( int argc, char* argv[] )
+{
+	TEST_RUN( testRandomOperations );
+	TEST_RUN( testSequentialInsert );
+	return TEST_RESULT();
+}
\ No newline at end of file
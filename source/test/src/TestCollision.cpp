@@ -0,0 +1,450 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "Test.h"
+#include "Collision.h"
+#include "Collision2.h"
+
+/*
+Collision与Collision2的窄阶段：已知情形的法线、深度和接触点；随机形状上collide与intersects一致，
+沿法线移开depth后分离、移动不到depth时仍相交，接触点在两形状附近；使用SatCache与不使用的结果完全相同
+*/
+
+static const float Pi = 3.14159265f;
+
+/*
+二维形状的持有者，Shape2只引用形状
+*/
+struct TestShape2
+{
+	Shape2::Type type;
+	Box2 box;
+	Circle circle;
+	OrientBox2 orient;
+	Polygon2 polygon;
+
+	Shape2 ref( void ) const
+	{
+		switch( type )
+		{
+			case Shape2::Type::Box2: return Shape2( box );
+			case Shape2::Type::Circle: return Shape2( circle );
+			case Shape2::Type::OrientBox2: return Shape2( orient );
+			default: return Shape2( polygon );
+		}
+	}
+
+	void move( const Vector2& d )
+	{
+		box.min += d;
+		box.max += d;
+		circle.center += d;
+		orient.center += d;
+		polygon.transform( d, 0.0f );
+	}
+};
+
+static TestShape2 randomShape2( TestRandom& random, float spread )
+{
+	TestShape2 shape;
+	shape.type = (Shape2::Type)( random.next() % (int) Shape2::Type::Count );
+	Vector2 center( random.range( -spread, spread ), random.range( -spread, spread ) );
+	Vector2 extents( random.range( 0.2f, 1.5f ), random.range( 0.2f, 1.5f ) );
+
+	shape.box = Box2( center - extents, center + extents );
+	shape.circle = Circle( center, extents.x );
+	shape.orient = OrientBox2( center, extents, random.range( 0.0f, 2.0f * Pi ) );
+
+	int count = 3 + (int)( random.next() % ( Polygon2::MaxVertices - 2 ) );
+	Vector2 points[ Polygon2::MaxVertices ];
+	float step = 2.0f * Pi / count;
+	float start = random.range( 0.0f, 2.0f * Pi );
+	for( int i = 0; i < count; ++i )
+	{
+		float angle = start + step * i + random.range( 0.0f, step * 0.5f );
+		points[i] = center + Vector2( cosf( angle ), sinf( angle ) ) * extents.x;
+	}
+	shape.polygon = Polygon2( points, count );
+	return shape;
+}
+
+static bool nearBounds( const Box2& box, const Vector2& p, float margin )
+{
+	return p.x >= box.min.x - margin && p.x <= box.max.x + margin && p.y >= box.min.y - margin && p.y <= box.max.y + margin;
+}
+
+static bool sameManifold( const Manifold2& a, const Manifold2& b )
+{
+	if( !( a.normal == b.normal ) || a.depth != b.depth || a.count != b.count )
+		return false;
+	for( int i = 0; i < a.count; ++i )
+	{
+		if( !( a.points[i] == b.points[i] ) )
+			return false;
+	}
+	return true;
+}
+
+static void testCollide2Cases( void )
+{
+	Manifold2 m;
+
+	// 两个轴对齐的盒子沿x重叠0.5，接触点在两个表面中间
+	Box2 a( Vector2( 0.0f, 0.0f ), Vector2( 2.0f, 2.0f ) );
+	Box2 b( Vector2( 1.5f, 0.5f ), Vector2( 3.5f, 1.5f ) );
+	TEST_CHECK( Collision2::collide( m, Shape2( a ), Shape2( b ) ) );
+	TEST_CHECK_NEAR( m.normal.x, 1.0f, 1.0e-6f );
+	TEST_CHECK_NEAR( m.normal.y, 0.0f, 1.0e-6f );
+	TEST_CHECK_NEAR( m.depth, 0.5f, 1.0e-6f );
+	TEST_CHECK( m.count == 2 );
+	for( int i = 0; i < m.count; ++i )
+	{
+		TEST_CHECK_NEAR( m.points[i].x, 1.75f, 1.0e-6f );
+		TEST_CHECK( fabsf( m.points[i].y - 0.5f ) < 1.0e-6f || fabsf( m.points[i].y - 1.5f ) < 1.0e-6f );
+	}
+
+	// 交换参数后法线反向
+	TEST_CHECK( Collision2::collide( m, Shape2( b ), Shape2( a ) ) );
+	TEST_CHECK_NEAR( m.normal.x, -1.0f, 1.0e-6f );
+	TEST_CHECK_NEAR( m.depth, 0.5f, 1.0e-6f );
+
+	Circle c1( 0.0f, 0.0f, 1.0f );
+	Circle c2( 1.5f, 0.0f, 1.0f );
+	TEST_CHECK( Collision2::collide( m, Shape2( c1 ), Shape2( c2 ) ) );
+	TEST_CHECK_NEAR( m.normal.x, 1.0f, 1.0e-6f );
+	TEST_CHECK_NEAR( m.depth, 0.5f, 1.0e-6f );
+	TEST_CHECK( m.count == 1 );
+	TEST_CHECK_NEAR( m.points[0].x, 0.75f, 1.0e-6f );
+	TEST_CHECK( !Collision2::collide( m, Shape2( c1 ), Shape2( Circle( 2.1f, 0.0f, 1.0f ) ) ) );
+
+	// 圆心在边的区域
+	Circle c3( 2.3f, 1.0f, 0.5f );
+	TEST_CHECK( Collision2::collide( m, Shape2( a ), Shape2( c3 ) ) );
+	TEST_CHECK_NEAR( m.normal.x, 1.0f, 1.0e-6f );
+	TEST_CHECK_NEAR( m.depth, 0.2f, 1.0e-5f );
+	TEST_CHECK_NEAR( m.points[0].x, 1.9f, 1.0e-5f );
+	TEST_CHECK_NEAR( m.points[0].y, 1.0f, 1.0e-5f );
+
+	// 圆心在顶点的区域，法线从顶点指向圆心
+	Circle c4( 2.3f, 2.3f, 0.5f );
+	TEST_CHECK( Collision2::collide( m, Shape2( a ), Shape2( c4 ) ) );
+	TEST_CHECK_NEAR( m.normal.x, sqrtf( 0.5f ), 1.0e-5f );
+	TEST_CHECK_NEAR( m.normal.y, sqrtf( 0.5f ), 1.0e-5f );
+	TEST_CHECK_NEAR( m.depth, 0.5f - sqrtf( 0.18f ), 1.0e-5f );
+	TEST_CHECK( !Collision2::collide( m, Shape2( a ), Shape2( Circle( 2.4f, 2.4f, 0.5f ) ) ) );
+
+	// 圆在前时法线同样从a指向b
+	TEST_CHECK( Collision2::collide( m, Shape2( c3 ), Shape2( a ) ) );
+	TEST_CHECK_NEAR( m.normal.x, -1.0f, 1.0e-6f );
+}
+
+static void testCollide2Random( void )
+{
+	TestRandom random( 2 );
+	int hits = 0, misses = 0;
+	for( int i = 0; i < 20000; ++i )
+	{
+		TestShape2 a = randomShape2( random, 2.0f );
+		TestShape2 b = randomShape2( random, 2.0f );
+
+		Manifold2 m;
+		bool hit = Collision2::collide( m, a.ref(), b.ref() );
+		TEST_CHECK( hit == Collision2::intersects( a.ref(), b.ref() ) );
+		if( !hit )
+		{
+			++misses;
+			continue;
+		}
+		++hits;
+
+		TEST_CHECK_NEAR( m.normal.length(), 1.0f, 1.0e-4f );
+		TEST_CHECK( m.depth >= 0.0f );
+		TEST_CHECK( m.count == 1 || m.count == 2 );
+
+		Box2 bounds_a, bounds_b;
+		Collision2::bounds( bounds_a, a.ref() );
+		Collision2::bounds( bounds_b, b.ref() );
+		for( int k = 0; k < m.count; ++k )
+		{
+			TEST_CHECK( nearBounds( bounds_a, m.points[k], m.depth + 1.0e-3f ) );
+			TEST_CHECK( nearBounds( bounds_b, m.points[k], m.depth + 1.0e-3f ) );
+		}
+
+		// depth是沿法线的最小分离距离（参考边选择的容差使其最多偏大约2%）
+		TestShape2 moved = b;
+		moved.move( m.normal * ( m.depth + 1.0e-3f ) );
+		TEST_CHECK( !Collision2::intersects( a.ref(), moved.ref() ) );
+		if( m.depth > 0.01f )
+		{
+			moved = b;
+			moved.move( m.normal * ( m.depth * 0.9f - 2.0e-3f ) );
+			TEST_CHECK( Collision2::intersects( a.ref(), moved.ref() ) );
+		}
+	}
+
+	TEST_CHECK( hits > 2000 && misses > 2000 );
+}
+
+/*
+b沿一条经过a的路径逐帧移动，每对形状使用同一个缓存，与不使用缓存的结果逐位相同
+*/
+static void testSatCache2( void )
+{
+	TestRandom random( 3 );
+	int early = 0;
+	for( int pair = 0; pair < 500; ++pair )
+	{
+		TestShape2 a = randomShape2( random, 0.5f );
+		TestShape2 b = randomShape2( random, 0.5f );
+		Vector2 step( random.range( -0.1f, 0.1f ), random.range( -0.1f, 0.1f ) );
+		b.move( step * -40.0f );
+
+		SatCache2 cache;
+		for( int frame = 0; frame < 80; ++frame )
+		{
+			Manifold2 cached, uncached;
+			int axis = cache.axis;
+			bool hit = Collision2::collide( cached, a.ref(), b.ref(), &cache );
+			TEST_CHECK( hit == Collision2::collide( uncached, a.ref(), b.ref() ) );
+			if( hit )
+				TEST_CHECK( sameManifold( cached, uncached ) );
+			else if( axis == cache.axis && axis >= 0 )
+				++early;
+			b.move( step );
+		}
+	}
+
+	// 大部分分离的帧沿用上一帧的轴
+	TEST_CHECK( early > 1000 );
+}
+
+/*
+三维形状：OrientBox或者平面凸多边形
+*/
+struct TestShape3
+{
+	bool is_box;
+	OrientBox box;
+	Polygon polygon;
+
+	void move( const Vector3& d )
+	{
+		box.center += d;
+		for( int i = 0; i < polygon.count; ++i )
+			polygon.vertices[i] += d;
+	}
+
+	void getBounds( Box& out ) const
+	{
+		is_box ? box.getBounds( out ) : polygon.getBounds( out );
+	}
+};
+
+static Quaternion randomRotation( TestRandom& random )
+{
+	Quaternion q( random.range( -1.0f, 1.0f ), random.range( -1.0f, 1.0f ), random.range( -1.0f, 1.0f ), random.range( -1.0f, 1.0f ) );
+	q.normalize();
+	return q;
+}
+
+static TestShape3 randomShape3( TestRandom& random, float spread )
+{
+	TestShape3 shape;
+	shape.is_box = ( random.next() & 1 ) != 0;
+	Vector3 center( random.range( -spread, spread ), random.range( -spread, spread ), random.range( -spread, spread ) );
+	Quaternion rotation = randomRotation( random );
+	shape.box = OrientBox( center, Vector3( random.range( 0.2f, 1.5f ), random.range( 0.2f, 1.5f ), random.range( 0.2f, 1.5f ) ), rotation );
+
+	int count = 3 + (int)( random.next() % ( Polygon::MaxVertices - 2 ) );
+	Vector3 points[ Polygon::MaxVertices ];
+	float step = 2.0f * Pi / count;
+	float start = random.range( 0.0f, 2.0f * Pi );
+	float radius = random.range( 0.5f, 2.0f );
+	for( int i = 0; i < count; ++i )
+	{
+		float angle = start + step * i + random.range( 0.0f, step * 0.5f );
+		points[i] = center + Quaternion::mulVector3( rotation, Vector3( cosf( angle ), sinf( angle ), 0.0f ) * radius );
+	}
+	shape.polygon = Polygon( points, count );
+	return shape;
+}
+
+static bool collide3( Manifold& out, const TestShape3& a, const TestShape3& b, SatCache* cache = nullptr )
+{
+	if( a.is_box )
+		return b.is_box ? Collision::collide( out, a.box, b.box, cache ) : Collision::collide( out, a.box, b.polygon, cache );
+	return b.is_box ? Collision::collide( out, a.polygon, b.box, cache ) : Collision::collide( out, a.polygon, b.polygon, cache );
+}
+
+static bool intersects3( const TestShape3& a, const TestShape3& b )
+{
+	if( a.is_box )
+		return b.is_box ? a.box.intersects( b.box ) : b.polygon.intersects( a.box );
+	return b.is_box ? a.polygon.intersects( b.box ) : a.polygon.intersects( b.polygon );
+}
+
+static bool nearBounds( const Box& box, const Vector3& p, float margin )
+{
+	return p.x >= box.min.x - margin && p.x <= box.max.x + margin && p.y >= box.min.y - margin && p.y <= box.max.y + margin &&
+		p.z >= box.min.z - margin && p.z <= box.max.z + margin;
+}
+
+static bool sameManifold( const Manifold& a, const Manifold& b )
+{
+	if( !( a.normal == b.normal ) || a.depth != b.depth || a.count != b.count )
+		return false;
+	for( int i = 0; i < a.count; ++i )
+	{
+		if( !( a.points[i] == b.points[i] ) )
+			return false;
+	}
+	return true;
+}
+
+static void testCollideCases( void )
+{
+	Manifold m;
+
+	// 面接触：4个接触点在两个面中间
+	OrientBox a( Vector3::Zero, Vector3::One, Quaternion::Identity );
+	OrientBox b( Vector3( 1.5f, 0.0f, 0.0f ), Vector3::One, Quaternion::Identity );
+	TEST_CHECK( Collision::collide( m, a, b ) );
+	TEST_CHECK_NEAR( m.normal.x, 1.0f, 1.0e-6f );
+	TEST_CHECK_NEAR( m.depth, 0.5f, 1.0e-6f );
+	TEST_CHECK( m.count == 4 );
+	for( int i = 0; i < m.count; ++i )
+	{
+		TEST_CHECK_NEAR( m.points[i].x, 0.75f, 1.0e-6f );
+		TEST_CHECK_NEAR( fabsf( m.points[i].y ), 1.0f, 1.0e-6f );
+		TEST_CHECK_NEAR( fabsf( m.points[i].z ), 1.0f, 1.0e-6f );
+	}
+	TEST_CHECK( Collision::collide( m, b, a ) && m.normal.x < -0.999f );
+	TEST_CHECK( !Collision::collide( m, a, OrientBox( Vector3( 2.1f, 0.0f, 0.0f ), Vector3::One, Quaternion::Identity ) ) );
+
+	// 边接触：b绕y轴转45度，只有一条平行于y轴的边伸入a的+x面
+	OrientBox edge( Vector3( 1.9f, 0.0f, 0.0f ), Vector3( 0.5f, 0.5f, 0.5f ) * sqrtf( 2.0f ),
+		Quaternion::createRotationY( Pi * 0.25f ) );
+	TEST_CHECK( Collision::collide( m, a, edge ) );
+	TEST_CHECK_NEAR( m.normal.x, 1.0f, 1.0e-5f );
+	TEST_CHECK_NEAR( m.depth, 0.1f, 1.0e-5f );
+	for( int i = 0; i < m.count; ++i )
+		TEST_CHECK_NEAR( m.points[i].x, 0.95f, 1.0e-5f );
+
+	// 水平的三角形穿入盒子顶面0.1
+	const Vector3 tri[3] = { Vector3( -0.5f, 0.9f, -0.5f ), Vector3( 0.5f, 0.9f, -0.5f ), Vector3( 0.0f, 0.9f, 0.5f ) };
+	Polygon triangle( tri, 3 );
+	TEST_CHECK( Collision::collide( m, a, triangle ) );
+	TEST_CHECK_NEAR( m.normal.y, 1.0f, 1.0e-5f );
+	TEST_CHECK_NEAR( m.depth, 0.1f, 1.0e-5f );
+	TEST_CHECK( m.count == 3 );
+	for( int i = 0; i < m.count; ++i )
+		TEST_CHECK_NEAR( m.points[i].y, 0.95f, 1.0e-5f );
+	TEST_CHECK( Collision::collide( m, triangle, a ) && m.normal.y < -0.999f );
+}
+
+static void testCollideRandom( void )
+{
+	TestRandom random( 4 );
+	int hits = 0, misses = 0;
+	for( int i = 0; i < 20000; ++i )
+	{
+		TestShape3 a = randomShape3( random, 1.5f );
+		TestShape3 b = randomShape3( random, 1.5f );
+
+		Manifold m;
+		bool hit = collide3( m, a, b );
+		TEST_CHECK( hit == intersects3( a, b ) );
+		if( !hit )
+		{
+			++misses;
+			continue;
+		}
+		++hits;
+
+		TEST_CHECK_NEAR( m.normal.length(), 1.0f, 1.0e-4f );
+		TEST_CHECK( m.depth >= 0.0f );
+		TEST_CHECK( m.count >= 1 && m.count <= Manifold::MaxPoints );
+
+		Box bounds_a, bounds_b;
+		a.getBounds( bounds_a );
+		b.getBounds( bounds_b );
+		for( int k = 0; k < m.count; ++k )
+		{
+			TEST_CHECK( nearBounds( bounds_a, m.points[k], m.depth + 1.0e-3f ) );
+			TEST_CHECK( nearBounds( bounds_b, m.points[k], m.depth + 1.0e-3f ) );
+		}
+
+		// 边轴只在明显更优时采用，depth最多比最小穿透大约5%
+		TestShape3 moved = b;
+		moved.move( m.normal * ( m.depth + 1.0e-3f ) );
+		TEST_CHECK( !intersects3( a, moved ) );
+		if( m.depth > 0.01f )
+		{
+			moved = b;
+			moved.move( m.normal * ( m.depth * 0.9f - 2.0e-3f ) );
+			TEST_CHECK( intersects3( a, moved ) );
+		}
+	}
+
+	TEST_CHECK( hits > 2000 && misses > 2000 );
+}
+
+static void testSatCache( void )
+{
+	TestRandom random( 5 );
+	int early = 0;
+	for( int pair = 0; pair < 500; ++pair )
+	{
+		TestShape3 a = randomShape3( random, 0.5f );
+		TestShape3 b = randomShape3( random, 0.5f );
+		Vector3 step( random.range( -0.1f, 0.1f ), random.range( -0.1f, 0.1f ), random.range( -0.1f, 0.1f ) );
+		b.move( step * -40.0f );
+
+		SatCache cache;
+		for( int frame = 0; frame < 80; ++frame )
+		{
+			Manifold cached, uncached;
+			int axis = cache.axis;
+			bool hit = collide3( cached, a, b, &cache );
+			TEST_CHECK( hit == collide3( uncached, a, b ) );
+			if( hit )
+				TEST_CHECK( sameManifold( cached, uncached ) );
+			else if( axis == cache.axis && axis >= 0 )
+				++early;
+			b.move( step );
+		}
+	}
+
+	TEST_CHECK( early > 1000 );
+}
+
+int main( int argc, char* argv[] )
+{
+	TEST_RUN( testCollide2Cases );
+	TEST_RUN( testCollide2Random );
+	TEST_RUN( testSatCache2 );
+	TEST_RUN( testCollideCases );
+	TEST_RUN( testCollideRandom );
+	TEST_RUN( testSatCache );
+	return TEST_RESULT();
+}
\ No newline at end of file
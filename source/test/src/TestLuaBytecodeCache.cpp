@@ -0,0 +1,142 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "Test.h"
+#include "LuaState.h"
+#include "LuaBytecodeCache.h"
+#include "AssetsPack.h"
+#include "AssetsPackBuilder.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+require经过LuaBytecodeCache的加载器：正常加载、找不到模块、从挂载的资源包中加载，以及语法错误的模块；
+语法错误时require反复失败，在AddressSanitizer下不能有泄漏
+*/
+
+static string _s_directory;
+
+static void writeFile( const char* name, const char* text )
+{
+	string file = _s_directory + "/" + name;
+	FILE* fp = fopen( file.c_str(), "wb" );
+	if( fp == nullptr )
+		return;
+	fwrite( text, 1, strlen( text ), fp );
+	fclose( fp );
+}
+
+static LuaState* newState( void )
+{
+	LuaState* state = new LuaState();
+	state->openLibs();
+	lua_State* L = state->cPtr();
+	lua_getglobal( L, LUA_LOADLIBNAME );
+	lua_pushstring( L, ( _s_directory + "/?.lua;modules/?.lua" ).c_str() );
+	lua_setfield( L, -2, "path" );
+	lua_pop( L, 1 );
+	return state;
+}
+
+/*
+执行chunk，返回错误信息，成功时为空
+*/
+static string run( LuaState* state, const char* chunk )
+{
+	lua_State* L = state->cPtr();
+	if( luaL_loadstring( L, chunk ) == 0 && lua_pcall( L, 0, 0, 0 ) == 0 )
+		return "";
+
+	string message = lua_tostring( L, -1 ) ? lua_tostring( L, -1 ) : "?";
+	lua_pop( L, 1 );
+	return message;
+}
+
+static void testRequire( void )
+{
+	writeFile( "good.lua", "#!/usr/bin/env lua\nlocal M = {}\nfunction M.add( a, b ) return a + b end\nreturn M\n" );
+
+	LuaState* state = newState();
+	TEST_CHECK( run( state, "local good = require( 'good' ) assert( good.add( 1, 2 ) == 3 )" ) == "" );
+	TEST_CHECK( run( state, "assert( require( 'good' ) == package.loaded.good )" ) == "" );
+
+	string missing = run( state, "require( 'missing' )" );
+	TEST_CHECK( missing.find( "missing.lua" ) != string::npos );
+	delete state;
+}
+
+static void testMountedPack( void )
+{
+	const char* source = "return { value = 42 }";
+	AssetsPackBuilder builder;
+	builder.addData( "modules/packed/module.lua", source, strlen( source ) );
+	Ptr<AssetsPack> pack = AssetsPack::create();
+	TEST_CHECK( pack->open( builder.build() ) );
+	AssetsPack::mount( pack );
+
+	// 和runScriptFile一样只存在于资源包中的脚本也能require
+	LuaState* state = newState();
+	TEST_CHECK( run( state, "assert( require( 'packed.module' ).value == 42 )" ) == "" );
+	delete state;
+
+	AssetsPack::unmount( pack.get() );
+	state = newState();
+	TEST_CHECK( run( state, "require( 'packed.module' )" ).find( "modules/packed/module.lua" ) != string::npos );
+	delete state;
+}
+
+static void testSyntaxError( void )
+{
+	writeFile( "broken.lua", "local x = = 1\n" );
+
+	LuaState* state = newState();
+	string message = run( state, "require( 'broken' )" );
+	TEST_CHECK( message.find( "error loading module 'broken'" ) != string::npos );
+	TEST_CHECK( message.find( "broken.lua" ) != string::npos );
+
+	// 失败的模块不会记入package.loaded，每次require都重新编译并抛出错误
+	for( int i = 0; i < 1000; ++i )
+	{
+		TEST_CHECK( run( state, "require( 'broken' )" ) == message );
+	}
+	TEST_CHECK( run( state, "assert( package.loaded.broken == nil )" ) == "" );
+	delete state;
+}
+
+int main( int argc, char* argv[] )
+{
+	char directory[] = "/tmp/test-luabytecodecache.XXXXXX";
+	if( mkdtemp( directory ) == nullptr )
+		return 1;
+	_s_directory = directory;
+
+	TEST_RUN( testRequire );
+	TEST_RUN( testMountedPack );
+	TEST_RUN( testSyntaxError );
+
+	unlink( ( _s_directory + "/good.lua" ).c_str() );
+	unlink( ( _s_directory + "/broken.lua" ).c_str() );
+	rmdir( directory );
+	return TEST_RESULT();
+}
\ No newline at end of file
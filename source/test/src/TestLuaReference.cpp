@@ -0,0 +1,136 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "Test.h"
+#include "LuaState.h"
+#include "LuaFunction.h"
+#include "LuaTable.h"
+#include "tolua_ext.h"
+#include <stdlib.h>
+#include <unistd.h>
+
+/*
+LuaReference的长时间运行测试：反复注册和释放函数、table的引用，
+Lua内存、注册表的槽位和进程的常驻内存都不能随次数增长
+
+test-luareference [cycles]，默认1000万次
+*/
+
+static const int LiveCount = 8;
+
+static size_t readRssKb( void )
+{
+	FILE* fp = fopen( "/proc/self/statm", "r" );
+	if( fp == nullptr )
+		return 0;
+
+	unsigned long size = 0, resident = 0;
+	if( fscanf( fp, "%lu %lu", &size, &resident ) != 2 )
+		resident = 0;
+	fclose( fp );
+	return (size_t) resident * (size_t) sysconf( _SC_PAGESIZE ) / 1024;
+}
+
+static int luaMemoryKb( lua_State* L )
+{
+	lua_gc( L, LUA_GCCOLLECT, 0 );
+	return lua_gc( L, LUA_GCCOUNT, 0 );
+}
+
+static void testSoak( int cycles )
+{
+	LuaState* state = new LuaState();
+	state->openLibs();
+	lua_State* L = state->cPtr();
+	state->runScript( "function callback( x ) return x + 1 end" );
+
+	LuaFunction functions[ LiveCount ];
+	LuaTable tables[ LiveCount ];
+	int max_handler = 0;
+	int warm_memory = 0;
+	size_t warm_rss = 0;
+	int warm_cycle = cycles / 10;
+
+	for( int i = 0; i < cycles; ++i )
+	{
+		// 同一个函数也会得到新的槽位，和脚本每次传入新的闭包一样
+		int slot = i % LiveCount;
+		lua_getglobal( L, "callback" );
+		int handler = tolua_ext_tofunction( L, -1, 0 );
+		LuaFunction lf;
+		lf.bind( state, handler );
+		lua_pop( L, 1 );
+		max_handler = handler > max_handler ? handler : max_handler;
+
+		// 复制的持有者共享同一条记录，最后一个释放时归还槽位
+		functions[ slot ] = lf;
+		lf = nullptr;
+
+		lua_createtable( L, 0, 0 );
+		tables[ slot ].bind( state, tolua_ext_totable( L, -1, 0 ) );
+		lua_pop( L, 1 );
+
+		if( i + 1 == warm_cycle )
+		{
+			warm_memory = luaMemoryKb( L );
+			warm_rss = readRssKb();
+		}
+	}
+
+	TEST_CHECK( functions[0].call<int>( 41 ) == 42 );
+
+	int memory = luaMemoryKb( L );
+	size_t rss = readRssKb();
+	printf( "%d cycles: lua %d KB -> %d KB, rss %u KB -> %u KB, max handler %d\n", cycles, warm_memory, memory,
+		(unsigned int) warm_rss, (unsigned int) rss, max_handler );
+
+	TEST_CHECK( memory <= warm_memory );
+	// 每个持有者最多占两个槽位（新的在旧的释放之前分配），另有luaL_ref自身使用的少量索引
+	TEST_CHECK( max_handler <= LiveCount * 4 + 8 );
+	TEST_CHECK( rss <= warm_rss + 1024 );
+
+	for( int i = 0; i < LiveCount; ++i )
+	{
+		functions[i] = nullptr;
+		tables[i] = nullptr;
+	}
+	state->release();
+	LuaReference::purge();
+	TEST_CHECK( LuaState::getLiveCount() == 0 );
+}
+
+static int _s_cycles = 10000000;
+
+static void testLuaReferenceSoak( void )
+{
+	testSoak( _s_cycles );
+}
+
+int main( int argc, char* argv[] )
+{
+	if( argc > 1 )
+		_s_cycles = atoi( argv[1] );
+
+	TEST_RUN( testLuaReferenceSoak );
+	return TEST_RESULT();
+}
\ No newline at end of file
@@ -0,0 +1,281 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "Test.h"
+#include <float.h>
+
+/*
+Packed中各格式的往返误差，以及批量接口（SSE2加标量尾部）与标量接口的一致性
+*/
+
+static const size_t BatchCount = 37; // 不是8的倍数，覆盖SIMD主循环和尾部
+
+static void testHalfExact( void )
+{
+	const float values[] = { 0.0f, -0.0f, 1.0f, -1.0f, 0.5f, -2.0f, 1024.0f, 65504.0f, -65504.0f, 6.103515625e-5f };
+	for( float v : values )
+	{
+		TEST_CHECK( Half::toFloat( Half::fromFloat( v ) ) == v );
+	}
+
+	TEST_CHECK( Half::fromFloat( 1.0f ) == 0x3c00 );
+	TEST_CHECK( Half::fromFloat( -2.0f ) == 0xc000 );
+	TEST_CHECK( Half::fromFloat( 65504.0f ) == 0x7bff );
+}
+
+static void testHalfRoundTrip( void )
+{
+	TestRandom random( 27 );
+	for( int i = 0; i < 100000; ++i )
+	{
+		// 规格化范围内相对误差不超过半个ulp，即2^-11
+		float v = random.range( -60000.0f, 60000.0f );
+		if( fabsf( v ) < 6.103515625e-5f )
+			continue;
+		float r = Half::toFloat( Half::fromFloat( v ) );
+		TEST_CHECK_NEAR( r, v, fabsf( v ) * ( 1.0f / 2048.0f ) );
+	}
+
+	for( int i = 0; i < 10000; ++i )
+	{
+		// 非规格化数的绝对误差不超过2^-25
+		float v = random.range( -6.0e-5f, 6.0e-5f );
+		float r = Half::toFloat( Half::fromFloat( v ) );
+		TEST_CHECK_NEAR( r, v, 2.98023224e-8 );
+	}
+}
+
+static void testHalfSpecial( void )
+{
+	TEST_CHECK( Half::fromFloat( 65520.0f ) == 0x7c00 );
+	TEST_CHECK( Half::fromFloat( -1.0e10f ) == 0xfc00 );
+	TEST_CHECK( Half::toFloat( 0x7c00 ) == HUGE_VALF );
+	TEST_CHECK( Half::toFloat( 0xfc00 ) == -HUGE_VALF );
+
+	float nan = Half::toFloat( Half::fromFloat( NAN ) );
+	TEST_CHECK( nan != nan );
+
+	// 舍入到偶数：1 + 2^-11正好在1和下一个half之间
+	TEST_CHECK( Half::fromFloat( 1.0f + 1.0f / 2048.0f ) == 0x3c00 );
+	TEST_CHECK( Half::fromFloat( 1.0f + 3.0f / 2048.0f ) == 0x3c02 );
+}
+
+static void testHalfBatch( void )
+{
+	TestRandom random( 1 );
+	float in[ BatchCount ];
+	for( size_t i = 0; i < BatchCount; ++i )
+		in[i] = random.range( -70000.0f, 70000.0f ) * ( i % 3 == 0 ? 1.0e-9f : 1.0f );
+	in[5] = NAN;
+	in[6] = -HUGE_VALF;
+
+	uint16_t batch[ BatchCount ];
+	float out[ BatchCount ];
+	Half::fromFloat( batch, in, BatchCount );
+	Half::toFloat( out, batch, BatchCount );
+	for( size_t i = 0; i < BatchCount; ++i )
+	{
+		TEST_CHECK( batch[i] == Half::fromFloat( in[i] ) );
+		float scalar = Half::toFloat( batch[i] );
+		TEST_CHECK( memcmp( &out[i], &scalar, sizeof( float ) ) == 0 );
+	}
+}
+
+static void testHalfVectors( void )
+{
+	Vector2 v2( 1.5f, -3.25f );
+	Vector3 v3( 0.125f, 100.0f, -7.0f );
+	Vector4 v4( 2.0f, -0.5f, 1000.0f, 0.0f );
+	TEST_CHECK( HalfVector2( v2 ).unpack() == v2 );
+	TEST_CHECK( HalfVector3( v3 ).unpack() == v3 );
+	TEST_CHECK( HalfVector4( v4 ).unpack() == v4 );
+
+	TestRandom random( 3 );
+	Vector3 in[ BatchCount ], out[ BatchCount ];
+	HalfVector3 packed[ BatchCount ];
+	for( size_t i = 0; i < BatchCount; ++i )
+		in[i] = Vector3( random.range( -100.0f, 100.0f ), random.range( -1.0f, 1.0f ), random.range( -0.01f, 0.01f ) );
+	HalfVector3::pack( packed, in, BatchCount );
+	HalfVector3::unpack( out, packed, BatchCount );
+	for( size_t i = 0; i < BatchCount; ++i )
+	{
+		Vector3 scalar = HalfVector3( in[i] ).unpack();
+		TEST_CHECK( out[i] == scalar );
+		TEST_CHECK_NEAR( out[i].x, in[i].x, fabsf( in[i].x ) / 2048.0f );
+		TEST_CHECK_NEAR( out[i].y, in[i].y, fabsf( in[i].y ) / 2048.0f + 3.0e-8 );
+		TEST_CHECK_NEAR( out[i].z, in[i].z, fabsf( in[i].z ) / 2048.0f + 3.0e-8 );
+	}
+}
+
+static void testSnorm16( void )
+{
+	const float half_step = 0.5f / 32767.0f;
+
+	TEST_CHECK( Snorm16::fromFloat( 1.0f ) == 32767 );
+	TEST_CHECK( Snorm16::fromFloat( -1.0f ) == -32767 );
+	TEST_CHECK( Snorm16::fromFloat( 0.0f ) == 0 );
+	TEST_CHECK( Snorm16::fromFloat( 2.0f ) == 32767 );
+	TEST_CHECK( Snorm16::fromFloat( -5.0f ) == -32767 );
+	TEST_CHECK( Snorm16::toFloat( 32767 ) == 1.0f );
+	TEST_CHECK( Snorm16::toFloat( -32767 ) == -1.0f );
+
+	TestRandom random( 16 );
+	for( int i = 0; i < 100000; ++i )
+	{
+		float v = random.range( -1.0f, 1.0f );
+		TEST_CHECK_NEAR( Snorm16::toFloat( Snorm16::fromFloat( v ) ), v, half_step + 1.0e-7 );
+	}
+
+	float in[ BatchCount ], out[ BatchCount ];
+	int16_t batch[ BatchCount ];
+	for( size_t i = 0; i < BatchCount; ++i )
+		in[i] = random.range( -1.5f, 1.5f );
+	Snorm16::fromFloat( batch, in, BatchCount );
+	Snorm16::toFloat( out, batch, BatchCount );
+	for( size_t i = 0; i < BatchCount; ++i )
+	{
+		TEST_CHECK( batch[i] == Snorm16::fromFloat( in[i] ) );
+		TEST_CHECK( out[i] == Snorm16::toFloat( batch[i] ) );
+	}
+}
+
+static void testSnorm16Vector3( void )
+{
+	TestRandom random( 17 );
+	Vector3 in[ BatchCount ], out[ BatchCount ];
+	Snorm16Vector3 packed[ BatchCount ];
+	for( size_t i = 0; i < BatchCount; ++i )
+		in[i] = Vector3::normalize( Vector3( random.range( -1.0f, 1.0f ), random.range( -1.0f, 1.0f ), random.range( 0.1f, 1.0f ) ) );
+
+	Snorm16Vector3::pack( packed, in, BatchCount );
+	Snorm16Vector3::unpack( out, packed, BatchCount );
+	for( size_t i = 0; i < BatchCount; ++i )
+	{
+		Vector3 scalar = Snorm16Vector3( in[i] ).unpack();
+		TEST_CHECK( out[i] == scalar );
+		TEST_CHECK_NEAR( out[i].x, in[i].x, 0.5f / 32767.0f + 1.0e-7 );
+		TEST_CHECK_NEAR( out[i].y, in[i].y, 0.5f / 32767.0f + 1.0e-7 );
+		TEST_CHECK_NEAR( out[i].z, in[i].z, 0.5f / 32767.0f + 1.0e-7 );
+	}
+}
+
+static Quaternion randomRotation( TestRandom& random )
+{
+	Quaternion q( random.range( -1.0f, 1.0f ), random.range( -1.0f, 1.0f ), random.range( -1.0f, 1.0f ), random.range( -1.0f, 1.0f ) );
+	return Quaternion::normalize( q );
+}
+
+/*
+q与-q是同一个旋转，按符号对齐之后逐分量比较
+*/
+template< class TPacked >
+static void checkQuaternionRoundTrip( float tolerance, uint32_t seed )
+{
+	TestRandom random( seed );
+	TPacked packed[ BatchCount ];
+	Quaternion in[ BatchCount ], out[ BatchCount ];
+	for( size_t i = 0; i < BatchCount; ++i )
+		in[i] = randomRotation( random );
+	in[0] = Quaternion::Identity;
+	in[1] = Quaternion( 0.0f, 0.0f, 0.0f, -1.0f );
+	in[2] = Quaternion::normalize( Quaternion( 1.0f, 1.0f, 0.0f, 0.0f ) );
+	in[3] = Quaternion::normalize( Quaternion( 0.5f, -0.5f, 0.5f, -0.5f ) );
+
+	TPacked::pack( packed, in, BatchCount );
+	TPacked::unpack( out, packed, BatchCount );
+	for( size_t i = 0; i < BatchCount; ++i )
+	{
+		Quaternion scalar = TPacked( in[i] ).unpack();
+		TEST_CHECK( memcmp( &scalar, &out[i], sizeof( Quaternion ) ) == 0 );
+
+		float sign = Quaternion::dot( in[i], out[i] ) < 0.0f ? -1.0f : 1.0f;
+		TEST_CHECK_NEAR( out[i].x * sign, in[i].x, tolerance );
+		TEST_CHECK_NEAR( out[i].y * sign, in[i].y, tolerance );
+		TEST_CHECK_NEAR( out[i].z * sign, in[i].z, tolerance );
+		TEST_CHECK_NEAR( out[i].w * sign, in[i].w, tolerance );
+	}
+
+	for( int i = 0; i < 100000; ++i )
+	{
+		Quaternion q = randomRotation( random );
+		Quaternion r = TPacked( q ).unpack();
+		float sign = Quaternion::dot( q, r ) < 0.0f ? -1.0f : 1.0f;
+		TEST_CHECK_NEAR( r.x * sign, q.x, tolerance );
+		TEST_CHECK_NEAR( r.y * sign, q.y, tolerance );
+		TEST_CHECK_NEAR( r.z * sign, q.z, tolerance );
+		TEST_CHECK_NEAR( r.w * sign, q.w, tolerance );
+	}
+}
+
+static void testPackedQuaternion32( void )
+{
+	checkQuaternionRoundTrip< PackedQuaternion32 >( 2.0e-3f, 32 );
+	TEST_CHECK( PackedQuaternion32().unpack() == Quaternion::Identity );
+}
+
+static void testPackedQuaternion48( void )
+{
+	checkQuaternionRoundTrip< PackedQuaternion48 >( 1.0e-4f, 48 );
+	TEST_CHECK( PackedQuaternion48().unpack() == Quaternion::Identity );
+}
+
+static void testAffine3x4( void )
+{
+	TestRandom random( 34 );
+	Matrix4x4 in[ BatchCount ], out[ BatchCount ];
+	Affine3x4 packed[ BatchCount ];
+	for( size_t i = 0; i < BatchCount; ++i )
+	{
+		Vector3 t( random.range( -100.0f, 100.0f ), random.range( -100.0f, 100.0f ), random.range( -100.0f, 100.0f ) );
+		Vector3 s( random.range( 0.1f, 3.0f ), random.range( 0.1f, 3.0f ), random.range( 0.1f, 3.0f ) );
+		in[i] = Matrix4x4::createTrs( t, randomRotation( random ), s );
+	}
+
+	// 仿射矩阵的往返是精确的
+	Affine3x4::pack( packed, in, BatchCount );
+	Affine3x4::unpack( out, packed, BatchCount );
+	for( size_t i = 0; i < BatchCount; ++i )
+	{
+		TEST_CHECK( memcmp( in[i].m, out[i].m, sizeof( in[i].m ) ) == 0 );
+
+		Affine3x4 single( in[i] );
+		TEST_CHECK( memcmp( single.m, packed[i].m, sizeof( single.m ) ) == 0 );
+		Matrix4x4 scalar = single.unpack();
+		TEST_CHECK( memcmp( scalar.m, in[i].m, sizeof( scalar.m ) ) == 0 );
+	}
+}
+
+int main( int argc, char* argv[] )
+{
+	TEST_RUN( testHalfExact );
+	TEST_RUN( testHalfRoundTrip );
+	TEST_RUN( testHalfSpecial );
+	TEST_RUN( testHalfBatch );
+	TEST_RUN( testHalfVectors );
+	TEST_RUN( testSnorm16 );
+	TEST_RUN( testSnorm16Vector3 );
+	TEST_RUN( testPackedQuaternion32 );
+	TEST_RUN( testPackedQuaternion48 );
+	TEST_RUN( testAffine3x4 );
+	return TEST_RESULT();
+}
\ No newline at end of file
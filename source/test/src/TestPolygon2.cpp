@@ -0,0 +1,236 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "Test.h"
+
+/*
+Polygon2::set的绕序归一化，以及SAT相交测试与逐边暴力判定的一致性
+*/
+
+static const float Pi = 3.14159265f;
+
+static float signedArea( const Polygon2& polygon )
+{
+	float area = 0.0f;
+	for( int i = 0; i < polygon.count; ++i )
+	{
+		area += Vector2::cross( polygon.vertices[i], polygon.vertices[ ( i + 1 ) % polygon.count ] );
+	}
+	return area * 0.5f;
+}
+
+/*
+随机凸多边形：顶点在圆上按角度排列，reverse时按顺时针给出
+*/
+static Polygon2 randomPolygon( TestRandom& random, const Vector2& center, float radius, bool reverse )
+{
+	int count = 3 + (int)( random.next() % ( Polygon2::MaxVertices - 2 ) );
+	Vector2 points[ Polygon2::MaxVertices ];
+	float step = 2.0f * Pi / count;
+	float start = random.range( 0.0f, 2.0f * Pi );
+	for( int i = 0; i < count; ++i )
+	{
+		float angle = start + step * i + random.range( 0.0f, step * 0.5f );
+		int index = reverse ? count - 1 - i : i;
+		points[ index ] = center + Vector2( cosf( angle ), sinf( angle ) ) * radius;
+	}
+	return Polygon2( points, count );
+}
+
+static bool insideOrOn( const Polygon2& polygon, const Vector2& point )
+{
+	for( int i = 0; i < polygon.count; ++i )
+	{
+		Vector2 e = polygon.vertices[ ( i + 1 ) % polygon.count ] - polygon.vertices[i];
+		if( Vector2::cross( e, point - polygon.vertices[i] ) < 0.0f )
+			return false;
+	}
+	return true;
+}
+
+static bool segmentsCross( const Vector2& a, const Vector2& b, const Vector2& c, const Vector2& d )
+{
+	float d1 = Vector2::cross( b - a, c - a );
+	float d2 = Vector2::cross( b - a, d - a );
+	float d3 = Vector2::cross( d - c, a - c );
+	float d4 = Vector2::cross( d - c, b - c );
+	return d1 * d2 <= 0.0f && d3 * d4 <= 0.0f;
+}
+
+/*
+暴力判定：一方的顶点在另一方内部，或者有边相交
+*/
+static bool bruteIntersects( const Polygon2& a, const Polygon2& b )
+{
+	for( int i = 0; i < a.count; ++i )
+	{
+		if( insideOrOn( b, a.vertices[i] ) )
+			return true;
+	}
+	for( int i = 0; i < b.count; ++i )
+	{
+		if( insideOrOn( a, b.vertices[i] ) )
+			return true;
+	}
+	for( int i = 0; i < a.count; ++i )
+	{
+		for( int j = 0; j < b.count; ++j )
+		{
+			if( segmentsCross( a.vertices[i], a.vertices[ ( i + 1 ) % a.count ], b.vertices[j], b.vertices[ ( j + 1 ) % b.count ] ) )
+				return true;
+		}
+	}
+	return false;
+}
+
+/*
+两个多边形在所有分离轴上的最大间隔，接近0时浮点误差可能使两种判定不同
+*/
+static float separation( const Polygon2& a, const Polygon2& b )
+{
+	float best = -FLT_MAX;
+	const Polygon2* polygons[2] = { &a, &b };
+	for( const Polygon2* owner : polygons )
+	{
+		for( int i = 0; i < owner->count; ++i )
+		{
+			const Vector2& axis = owner->normals[i];
+			float min1 = FLT_MAX, max1 = -FLT_MAX, min2 = FLT_MAX, max2 = -FLT_MAX;
+			for( int k = 0; k < a.count; ++k )
+			{
+				float d = Vector2::dot( a.vertices[k], axis );
+				min1 = Math::min( min1, d );
+				max1 = Math::max( max1, d );
+			}
+			for( int k = 0; k < b.count; ++k )
+			{
+				float d = Vector2::dot( b.vertices[k], axis );
+				min2 = Math::min( min2, d );
+				max2 = Math::max( max2, d );
+			}
+			best = Math::max( best, Math::max( min1 - max2, min2 - max1 ) );
+		}
+	}
+	return best;
+}
+
+static void testWinding( void )
+{
+	const Vector2 ccw[4] = { Vector2( 0, 0 ), Vector2( 2, 0 ), Vector2( 2, 1 ), Vector2( 0, 1 ) };
+	const Vector2 cw[4] = { Vector2( 0, 0 ), Vector2( 0, 1 ), Vector2( 2, 1 ), Vector2( 2, 0 ) };
+
+	Polygon2 a( ccw, 4 );
+	Polygon2 b( cw, 4 );
+	TEST_CHECK_NEAR( signedArea( a ), 2.0f, 1.0e-6f );
+	TEST_CHECK_NEAR( signedArea( b ), 2.0f, 1.0e-6f );
+
+	// 外法线背离中心
+	for( const Polygon2* polygon : { &a, &b } )
+	{
+		Vector2 center = polygon->centroid();
+		for( int i = 0; i < polygon->count; ++i )
+		{
+			TEST_CHECK( Vector2::dot( polygon->normals[i], polygon->vertices[i] - center ) > 0.0f );
+			TEST_CHECK_NEAR( polygon->normals[i].length(), 1.0f, 1.0e-6f );
+		}
+	}
+
+	TEST_CHECK( b.containsPoint( Vector2( 1.0f, 0.5f ) ) );
+	TEST_CHECK( !b.containsPoint( Vector2( 3.0f, 0.5f ) ) );
+
+	// 绕序相反的同一个多边形与其他形状的结果相同
+	Polygon2 c( Box2( Vector2( 1.5f, 0.5f ), Vector2( 3.0f, 3.0f ) ) );
+	TEST_CHECK( a.intersects( c ) && b.intersects( c ) );
+	TEST_CHECK( a.intersects( Circle( 1.0f, 1.4f, 0.5f ) ) && b.intersects( Circle( 1.0f, 1.4f, 0.5f ) ) );
+	TEST_CHECK( !a.intersects( Circle( 1.0f, 1.6f, 0.5f ) ) && !b.intersects( Circle( 1.0f, 1.6f, 0.5f ) ) );
+
+	// OrientBox2各轴的方向组合可能给出顺时针的顶点
+	OrientBox2 flipped( Vector2( 0.0f, 0.0f ), Vector2( 1.0f, 0.5f ), 0.0f );
+	flipped.axis_y = -flipped.axis_y;
+	Polygon2 d( flipped );
+	TEST_CHECK( signedArea( d ) > 0.0f );
+	TEST_CHECK( d.intersects( a ) );
+	TEST_CHECK( !d.intersects( Polygon2( Box2( Vector2( 1.1f, -1.0f ), Vector2( 2.0f, 1.0f ) ) ) ) );
+}
+
+static void testSatCases( void )
+{
+	const Vector2 tri[3] = { Vector2( 0, 0 ), Vector2( 2, 0 ), Vector2( 0, 2 ) };
+	Polygon2 triangle( tri, 3 );
+
+	// 包围盒重叠，但被三角形的斜边分开
+	TEST_CHECK( !triangle.intersects( Box2( Vector2( 1.2f, 1.2f ), Vector2( 2.0f, 2.0f ) ) ) );
+	TEST_CHECK( triangle.intersects( Box2( Vector2( 0.9f, 0.9f ), Vector2( 2.0f, 2.0f ) ) ) );
+
+	// 边接触算作相交
+	TEST_CHECK( triangle.intersects( Box2( Vector2( 2.0f, -1.0f ), Vector2( 3.0f, 1.0f ) ) ) );
+	TEST_CHECK( !triangle.intersects( Box2( Vector2( 2.01f, -1.0f ), Vector2( 3.0f, 1.0f ) ) ) );
+
+	// 完全包含
+	TEST_CHECK( triangle.intersects( Box2( Vector2( 0.1f, 0.1f ), Vector2( 0.2f, 0.2f ) ) ) );
+	TEST_CHECK( Polygon2( Box2( Vector2( -5.0f, -5.0f ), Vector2( 5.0f, 5.0f ) ) ).intersects( triangle ) );
+
+	// 旋转45度的正方形，只有对角线方向的轴能分开
+	OrientBox2 diamond( Vector2( 2.5f, 2.5f ), Vector2( 0.5f, 0.5f ), Pi * 0.25f );
+	TEST_CHECK( !triangle.intersects( diamond ) );
+	diamond.center = Vector2( 1.2f, 1.2f );
+	TEST_CHECK( triangle.intersects( diamond ) );
+
+	// 平移和旋转后保持凸且逆时针
+	Polygon2 moved;
+	Polygon2::transform( moved, triangle, Vector2( 10.0f, 0.0f ), Pi * 0.5f );
+	TEST_CHECK_NEAR( signedArea( moved ), 2.0f, 1.0e-5f );
+	TEST_CHECK( !moved.intersects( triangle ) );
+	TEST_CHECK( moved.containsPoint( Vector2( 9.5f, 0.5f ) ) );
+}
+
+static void testSatRandom( void )
+{
+	TestRandom random( 30 );
+	int hits = 0, misses = 0;
+	for( int i = 0; i < 20000; ++i )
+	{
+		Polygon2 a = randomPolygon( random, Vector2( random.range( -4.0f, 4.0f ), random.range( -4.0f, 4.0f ) ), random.range( 0.5f, 3.0f ), ( i & 1 ) != 0 );
+		Polygon2 b = randomPolygon( random, Vector2( random.range( -4.0f, 4.0f ), random.range( -4.0f, 4.0f ) ), random.range( 0.5f, 3.0f ), ( i & 2 ) != 0 );
+
+		TEST_CHECK( signedArea( a ) > 0.0f && signedArea( b ) > 0.0f );
+		if( fabsf( separation( a, b ) ) < 1.0e-4f )
+			continue;
+
+		bool expected = bruteIntersects( a, b );
+		TEST_CHECK( a.intersects( b ) == expected );
+		TEST_CHECK( b.intersects( a ) == expected );
+		expected ? ++hits : ++misses;
+	}
+
+	// 两种结果都有足够的样本
+	TEST_CHECK( hits > 1000 && misses > 1000 );
+}
+
+int main( int argc, char* argv[] )
+{
+	TEST_RUN( testWinding );
+	TEST_RUN( testSatCases );
+	TEST_RUN( testSatRandom );
+	return TEST_RESULT();
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "Test.h"
+#include "Profiler.h"
+#include <atomic>
+#include <thread>
+
+/*
+多个线程记录作用域时主线程逐帧收集，收集到的记录一条不少；
+其他线程仍在记录时反复delc和init，在ThreadSanitizer和AddressSanitizer下不能有数据竞争和非法访问
+*/
+
+static const int Threads = 4;
+static const int Scopes = 20000;
+
+static size_t countOf( const Vector<ProfileScopeSummary>& summaries, const char* name )
+{
+	for( auto& summary : summaries )
+	{
+		if( strcmp( summary.name, name ) == 0 )
+			return summary.count;
+	}
+	return 0;
+}
+
+static void testCollect( void )
+{
+	Profiler::init();
+	Profiler::setFrameCapacity( 100000 );
+	Profiler::setSpikeThreshold( 0 );
+	Profiler::setEnabled( true );
+	Profiler::newFrame();
+
+	std::atomic<int> running( Threads );
+	Vector<std::thread> threads;
+	for( int t = 0; t < Threads; ++t )
+	{
+		threads.push_back( std::thread( [ &running ]() {
+			for( int i = 0; i < Scopes; ++i )
+			{
+				MAGICAL_PROFILE_SCOPE( "Test::worker" );
+			}
+			-- running;
+		} ) );
+	}
+
+	// 主线程一边记录一边收集
+	int frames = 0;
+	while( running.load() > 0 )
+	{
+		{
+			MAGICAL_PROFILE_SCOPE( "Test::main" );
+			std::this_thread::yield();
+		}
+		Profiler::newFrame();
+		++ frames;
+	}
+	for( auto& thread : threads )
+		thread.join();
+	Profiler::newFrame();
+
+	Vector<ProfileScopeSummary> summaries;
+	Profiler::summarize( summaries );
+	TEST_CHECK( countOf( summaries, "Test::worker" ) == (size_t) Threads * Scopes );
+	TEST_CHECK( countOf( summaries, "Test::main" ) == (size_t) frames );
+
+	Profiler::delc();
+}
+
+static void testDelcWhileRecording( void )
+{
+	std::atomic<bool> stop( false );
+	Vector<std::thread> threads;
+	for( int t = 0; t < Threads; ++t )
+	{
+		threads.push_back( std::thread( [ &stop ]() {
+			while( !stop.load() )
+			{
+				MAGICAL_PROFILE_SCOPE( "Test::busy" );
+			}
+		} ) );
+	}
+
+	for( int round = 0; round < 50; ++round )
+	{
+		Profiler::init();
+		Profiler::setEnabled( true );
+		for( int i = 0; i < 4; ++i )
+		{
+			Profiler::newFrame();
+			std::this_thread::yield();
+		}
+		Profiler::delc();
+	}
+
+	stop.store( true );
+	for( auto& thread : threads )
+		thread.join();
+
+	// delc之后同一个线程重新登记，记录照常收集
+	Profiler::init();
+	Profiler::setEnabled( true );
+	Profiler::newFrame();
+	{
+		MAGICAL_PROFILE_SCOPE( "Test::after" );
+	}
+	Profiler::newFrame();
+	Vector<ProfileScopeSummary> summaries;
+	Profiler::summarize( summaries );
+	TEST_CHECK( countOf( summaries, "Test::after" ) == 1 );
+	TEST_CHECK( countOf( summaries, "Test::busy" ) == 0 );
+	Profiler::delc();
+}
+
+int main( int argc, char* argv[] )
+{
+	TEST_RUN( testCollect );
+	TEST_RUN( testDelcWhileRecording );
+	return TEST_RESULT();
+}
\ No newline at end of file
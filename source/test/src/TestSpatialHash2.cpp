@@ -0,0 +1,241 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "Test.h"
+#include "SpatialHash2.h"
+#include <algorithm>
+
+/*
+SpatialHash2的findPairs、findContacts和queryBox与逐对暴力判定的结果相同：
+包括跨越多个单元的大盒子、负坐标、恰好落在单元边界上的坐标，以及桶数很少时不同单元映射到同一个桶的情况
+*/
+
+static const int Count = 600;
+
+struct TestWorld
+{
+	// 形状按引用保存在SpatialHash2中，数组大小固定，地址不变
+	Vector<Box2> boxes;
+	Vector<Circle> circles;
+	Vector<int> proxies;
+	Vector<bool> alive;
+
+	TestWorld( void ) : boxes( Count ), circles( Count ), proxies( Count, SpatialHash2::NullProxy ), alive( Count, false ) {}
+
+	Shape2 shape( int i ) const
+	{
+		return i % 2 ? Shape2( circles[i] ) : Shape2( boxes[i] );
+	}
+};
+
+/*
+一半的坐标取单元边长一半的整数倍，min或max恰好在单元边界上
+*/
+static float coord( TestRandom& random, float lo, float hi, float cell_size )
+{
+	float v = random.range( lo, hi );
+	return random.next() % 2 ? floorf( v / ( cell_size * 0.5f ) ) * cell_size * 0.5f : v;
+}
+
+static void randomShape( TestRandom& random, TestWorld& world, int i, float cell_size )
+{
+	float x = coord( random, -30.0f, 20.0f, cell_size );
+	float y = coord( random, -30.0f, 20.0f, cell_size );
+
+	// 少数大对象覆盖几十个单元
+	float size = random.next() % 20 == 0 ? random.range( 5.0f, 12.0f ) : coord( random, 0.2f, 2.5f, cell_size );
+	if( i % 2 )
+		world.circles[i] = Circle( x, y, size * 0.5f );
+	else
+		world.boxes[i] = Box2( Vector2( x, y ), Vector2( x + size, y + coord( random, 0.2f, 2.5f, cell_size ) ) );
+}
+
+static bool overlaps( const Box2& a, const Box2& b )
+{
+	return a.min.x <= b.max.x && a.max.x >= b.min.x && a.min.y <= b.max.y && a.max.y >= b.min.y;
+}
+
+static long long pairKey( int a, int b )
+{
+	return a < b ? (long long) a * Count + b : (long long) b * Count + a;
+}
+
+static void checkHash( TestRandom& random, const SpatialHash2& hash, const TestWorld& world )
+{
+	Vector<int> live;
+	for( int i = 0; i < Count; ++i )
+	{
+		if( world.alive[i] )
+			live.push_back( world.proxies[i] );
+	}
+	TEST_CHECK( hash.proxyCount() == live.size() );
+
+	// 每对只输出一次
+	Vector<SpatialHash2::Pair> pairs;
+	hash.findPairs( pairs );
+	Vector<long long> found;
+	for( auto& pair : pairs )
+		found.push_back( pairKey( pair.proxy1, pair.proxy2 ) );
+	std::sort( found.begin(), found.end() );
+	TEST_CHECK( std::adjacent_find( found.begin(), found.end() ) == found.end() );
+
+	Vector<long long> expected;
+	Vector<long long> expected_contacts;
+	for( size_t i = 0; i < live.size(); ++i )
+	{
+		for( size_t j = i + 1; j < live.size(); ++j )
+		{
+			if( !overlaps( hash.getBounds( live[i] ), hash.getBounds( live[j] ) ) )
+				continue;
+			expected.push_back( pairKey( live[i], live[j] ) );
+			if( Collision2::intersects( hash.getShape( live[i] ), hash.getShape( live[j] ) ) )
+				expected_contacts.push_back( pairKey( live[i], live[j] ) );
+		}
+	}
+	std::sort( expected.begin(), expected.end() );
+	std::sort( expected_contacts.begin(), expected_contacts.end() );
+	TEST_CHECK( found == expected );
+
+	pairs.clear();
+	hash.findContacts( pairs );
+	found.clear();
+	for( auto& pair : pairs )
+		found.push_back( pairKey( pair.proxy1, pair.proxy2 ) );
+	std::sort( found.begin(), found.end() );
+	TEST_CHECK( found == expected_contacts );
+
+	for( int q = 0; q < 30; ++q )
+	{
+		float x = coord( random, -40.0f, 25.0f, hash.getCellSize() );
+		float y = coord( random, -40.0f, 25.0f, hash.getCellSize() );
+		Box2 query( Vector2( x, y ), Vector2( x + coord( random, 0.0f, 15.0f, hash.getCellSize() ), y + coord( random, 0.0f, 15.0f, hash.getCellSize() ) ) );
+
+		Vector<int> result;
+		hash.queryBox( result, query );
+		std::sort( result.begin(), result.end() );
+		TEST_CHECK( std::adjacent_find( result.begin(), result.end() ) == result.end() );
+
+		Vector<int> brute;
+		for( int proxy : live )
+		{
+			if( overlaps( hash.getBounds( proxy ), query ) )
+				brute.push_back( proxy );
+		}
+		std::sort( brute.begin(), brute.end() );
+		TEST_CHECK( result == brute );
+	}
+}
+
+static void testRandom( float cell_size, size_t bucket_count, uint32_t seed )
+{
+	TestRandom random( seed );
+	SpatialHash2 hash( cell_size, bucket_count );
+	TestWorld world;
+
+	for( int round = 0; round < 12; ++round )
+	{
+		for( int i = 0; i < Count; ++i )
+		{
+			switch( random.next() % 6 )
+			{
+				case 0:
+					// 删除或者重新插入
+					if( world.alive[i] )
+					{
+						hash.remove( world.proxies[i] );
+						world.alive[i] = false;
+					}
+					else
+					{
+						randomShape( random, world, i, cell_size );
+						world.proxies[i] = hash.insert( world.shape( i ), &world.boxes[i] );
+						world.alive[i] = true;
+					}
+					break;
+				case 1:
+				case 2:
+					if( world.alive[i] )
+					{
+						randomShape( random, world, i, cell_size );
+						hash.update( world.proxies[i] );
+					}
+					break;
+				default:
+					break;
+			}
+		}
+
+		for( int i = 0; i < Count; ++i )
+		{
+			if( world.alive[i] )
+				TEST_CHECK( hash.getUserData( world.proxies[i] ) == &world.boxes[i] );
+		}
+		checkHash( random, hash, world );
+	}
+}
+
+static void testCellsAndBuckets( void )
+{
+	// 桶足够多，以及只有16个桶、大量单元映射到同一个桶
+	testRandom( 1.5f, 4096, 29 );
+	testRandom( 1.5f, 16, 30 );
+	testRandom( 4.0f, 64, 31 );
+}
+
+/*
+两个都跨越原点、覆盖多个负坐标单元的盒子只输出一次
+*/
+static void testNegativeSpan( void )
+{
+	SpatialHash2 hash( 1.0f, 16 );
+	Box2 a( Vector2( -3.5f, -2.5f ), Vector2( 1.5f, 0.5f ) );
+	Box2 b( Vector2( -1.0f, -4.0f ), Vector2( 3.0f, -1.0f ) );
+	Box2 c( Vector2( -9.0f, -9.0f ), Vector2( -4.0f, -4.0f ) );
+	int pa = hash.insert( a );
+	int pb = hash.insert( b );
+	hash.insert( c );
+
+	Vector<SpatialHash2::Pair> pairs;
+	hash.findPairs( pairs );
+	TEST_CHECK( pairs.size() == 1 );
+	TEST_CHECK( pairs.size() == 1 && pairKey( pairs[0].proxy1, pairs[0].proxy2 ) == pairKey( pa, pb ) );
+
+	Vector<int> result;
+	hash.queryBox( result, Box2( Vector2( -4.0f, -4.0f ), Vector2( -4.0f, -4.0f ) ) );
+	TEST_CHECK( result.size() == 1 );
+
+	// 只在边界上接触也算重叠
+	result.clear();
+	hash.queryBox( result, Box2( Vector2( -20.0f, -20.0f ), Vector2( -9.0f, -9.0f ) ) );
+	TEST_CHECK( result.size() == 1 );
+	result.clear();
+	hash.queryBox( result, Box2( Vector2( -20.0f, -20.0f ), Vector2( -9.01f, -9.01f ) ) );
+	TEST_CHECK( result.empty() );
+}
+
+int main( int argc, char* argv[] )
+{
+	TEST_RUN( testCellsAndBuckets );
+	TEST_RUN( testNegativeSpan );
+	return TEST_RESULT();
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "magical-engine.h"
+#include "Assets.h"
+#include "AssetsPackBuilder.h"
+#include <string.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <algorithm>
+
+/*
+资源包生成工具：
+assets-pack [--store] [--alignment n] <output.pak> <directory>
+
+把directory下的所有文件以相对路径为名字打包，--store时不压缩；
+生成后重新打开包，逐个与源文件比较，任何不一致都返回失败
+*/
+USING_NS_MAGICAL;
+
+static void collectFiles( const string& root, const string& relative, Vector<string>& files )
+{
+	string path = relative.empty() ? root : root + "/" + relative;
+	DIR* dir = opendir( path.c_str() );
+	if( dir == nullptr )
+		return;
+
+	while( struct dirent* ent = readdir( dir ) )
+	{
+		if( strcmp( ent->d_name, "." ) == 0 || strcmp( ent->d_name, ".." ) == 0 )
+			continue;
+
+		string name = relative.empty() ? ent->d_name : relative + "/" + ent->d_name;
+		struct stat st;
+		if( stat( ( root + "/" + name ).c_str(), &st ) != 0 )
+			continue;
+
+		if( S_ISDIR( st.st_mode ) )
+			collectFiles( root, name, files );
+		else if( S_ISREG( st.st_mode ) )
+			files.push_back( name );
+	}
+	closedir( dir );
+}
+
+static bool verify( const char* output, const string& root, const Vector<string>& files )
+{
+	Ptr<AssetsPack> pack = AssetsPack::create();
+	if( !pack->open( output ) || pack->fileCount() != files.size() )
+		return false;
+
+	for( const auto& name : files )
+	{
+		Ptr<Data> packed = pack->loadFile( name.c_str() );
+		Ptr<Data> source = Assets::loadFile( ( root + "/" + name ).c_str() );
+		if( !packed || !source || packed->size() != source->size() ||
+			memcmp( packed->cPtr(), source->cPtr(), source->size() ) != 0 )
+		{
+			printf( "verify failed: %s\n", name.c_str() );
+			return false;
+		}
+	}
+	return true;
+}
+
+int main( int argc, char* argv[] )
+{
+	bool compress = true;
+	uint32_t alignment = 16;
+	int i = 1;
+	for( ; i < argc && argv[i][0] == '-'; ++i )
+	{
+		if( strcmp( argv[i], "--store" ) == 0 )
+			compress = false;
+		else if( strcmp( argv[i], "--alignment" ) == 0 && i + 1 < argc )
+			alignment = (uint32_t) atoi( argv[ ++i ] );
+		else
+			break;
+	}
+
+	if( argc - i != 2 || alignment == 0 || ( alignment & ( alignment - 1 ) ) != 0 )
+	{
+		printf( "usage: assets-pack [--store] [--alignment n] <output.pak> <directory>\n" );
+		return -1;
+	}
+
+	const char* output = argv[i];
+	string root = FileUtils::toUnixPath( argv[ i + 1 ] );
+	while( root.length() > 1 && root.back() == '/' )
+	{
+		root.pop_back();
+	}
+
+	Application::init();
+	MAGICAL_RETURN_EXP_IF_ERROR( -1 );
+
+	Vector<string> files;
+	collectFiles( root, "", files );
+	std::sort( files.begin(), files.end() );
+
+	AssetsPackBuilder builder;
+	builder.setAlignment( alignment );
+	uint64_t raw_size = 0;
+	bool ok = true;
+	for( const auto& name : files )
+	{
+		string file = root + "/" + name;
+		struct stat st;
+		if( stat( file.c_str(), &st ) == 0 )
+			raw_size += (uint64_t) st.st_size;
+		ok = ok && builder.addFile( name.c_str(), file.c_str(), compress );
+	}
+
+	ok = ok && builder.save( output );
+	if( ok )
+	{
+		struct stat st;
+		uint64_t pack_size = stat( output, &st ) == 0 ? (uint64_t) st.st_size : 0;
+		printf( "%s: %zu files, %llu bytes -> %llu bytes\n", output, files.size(),
+			(unsigned long long) raw_size, (unsigned long long) pack_size );
+		ok = verify( output, root, files );
+	}
+
+	Application::delc();
+	return ok ? 0 : -1;
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+﻿/******************************************************************************
+The MIT License (MIT)
+
+Copyright (c) 2014 Jason.lee
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*******************************************************************************/
+#include "BinaryLogDecoder.h"
+#include <stdio.h>
+
+/*
+二进制日志解码工具：
+blog-decode <input.blog> [output.txt]
+
+把BinaryLog写出的文件解码为文本，每条记录一行，未指定output时输出到标准输出；
+文件损坏或被截断时输出已解码的部分并返回失败
+*/
+USING_NS_MAGICAL;
+
+int main( int argc, char* argv[] )
+{
+	if( argc != 2 && argc != 3 )
+	{
+		printf( "usage: blog-decode <input.blog> [output.txt]\n" );
+		return -1;
+	}
+
+	BinaryLogDecoder decoder;
+	std::string text;
+	bool ok = decoder.decodeFile( argv[1], text );
+	if( !ok )
+		fprintf( stderr, "%s: %s\n", argv[1], decoder.getError().c_str() );
+
+	FILE* fp = argc == 3 ? fopen( argv[2], "wb" ) : stdout;
+	if( fp == nullptr )
+	{
+		fprintf( stderr, "open file(%s) failed!\n", argv[2] );
+		return -1;
+	}
+
+	fwrite( text.data(), 1, text.size(), fp );
+	if( fp != stdout )
+		fclose( fp );
+	return ok ? 0 : -1;
+}
\ No newline at end of file